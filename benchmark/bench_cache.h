@@ -0,0 +1,107 @@
+/**
+ * @file bench_cache.h
+ * @brief Reading table throughput benchmarks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ */
+
+#ifndef BENCH_CACHE_H
+#define BENCH_CACHE_H
+
+#include <unity.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "bench_harness.h"
+#include "../src/managers/SensorManager.h"
+#include "../src/managers/SeqlockTable.h"
+
+typedef SeqlockTable<SensorCache, Constants::Sensors::MAX_SENSORS> BenchReadingTable;
+
+/**
+ * @brief State shared with the writer task
+ */
+struct CacheWriterState {
+    BenchReadingTable* table;       ///< Table under test
+    std::atomic<bool> running;      ///< Cleared to stop the writer
+    std::atomic<bool> finished;     ///< Set by the writer on exit
+    std::atomic<uint32_t> writes;   ///< Writes completed
+};
+
+/**
+ * @brief Writer task: publishes into every slot until told to stop
+ */
+void cacheWriterTask(void* parameter) {
+    CacheWriterState* state = static_cast<CacheWriterState*>(parameter);
+    SensorCache cache;
+    cache.set(InterfaceType::HUMIDITY, 50.0f);
+    uint32_t count = 0;
+    while (state->running.load(std::memory_order_relaxed)) {
+        cache.set(InterfaceType::TEMPERATURE, count * 0.01f);
+        cache.timestamp = count;
+        state->table->write(count % BenchReadingTable::capacity(), cache);
+        count++;
+    }
+    state->writes.store(count);
+    state->finished.store(true);
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief Measure seqlock table reads and writes, alone and across cores
+ * @details The contended case runs a writer pinned to the other core
+ *          hammering every slot while this task reads, which is the worst
+ *          case the communication task sees from the acquisition workers.
+ */
+void bench_cache_throughput() {
+    static BenchReadingTable table;
+    const uint32_t iterations = 100000;
+    const size_t slots = BenchReadingTable::capacity();
+
+    SensorCache cache;
+    cache.set(InterfaceType::TEMPERATURE, 21.0f);
+    benchRun("cache_write", slots, iterations, [&](uint32_t i) {
+        table.write(i % slots, cache);
+    });
+
+    volatile uint32_t valid = 0;
+    benchRun("cache_read", slots, iterations, [&](uint32_t i) {
+        SensorCache out;
+        valid += table.read(i % slots, out);
+    });
+
+    static CacheWriterState state;
+    state.table = &table;
+    state.running.store(true);
+    state.finished.store(false);
+    state.writes.store(0);
+    BaseType_t otherCore = xPortGetCoreID() == 0 ? 1 : 0;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(cacheWriterTask, "BenchWriter", 4096, &state,
+                                                      uxTaskPriorityGet(nullptr), nullptr, otherCore));
+
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        SensorCache out;
+        valid += table.read(i % slots, out);
+    }
+    uint32_t elapsed = micros() - start;
+    state.running.store(false);
+    while (!state.finished.load()) {
+        delay(1);
+    }
+    uint32_t writerElapsed = micros() - start;
+
+    benchReport("cache_read_contended", slots, iterations, elapsed);
+    benchReport("cache_write_contended", slots, state.writes.load(), writerElapsed);
+    TEST_ASSERT_TRUE(valid > 0);
+}
+
+/**
+ * @brief Run all cache benchmarks
+ */
+void run_cache_benchmarks() {
+    RUN_TEST(bench_cache_throughput);
+}
+
+#endif // BENCH_CACHE_H
@@ -0,0 +1,71 @@
+/**
+ * @file bench_config.h
+ * @brief Configuration JSON parse and serialize benchmarks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ */
+
+#ifndef BENCH_CONFIG_H
+#define BENCH_CONFIG_H
+
+#include <unity.h>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include "bench_harness.h"
+#include "../src/config/ConfigManager.h"
+
+/**
+ * @brief Measure ConfigManager load, JSON parse/serialize and save
+ * @details Uses the configuration already on the board's filesystem (a
+ *          default one is created if there is none). The update case only
+ *          edits the in-memory document; the save case also flushes, so it
+ *          includes the flash write and leaves the configuration as it was.
+ */
+void bench_config_json() {
+    TEST_ASSERT_TRUE(LittleFS.begin(true, "/litlefs", 10, "ffat"));
+
+    ErrorHandler errorHandler(nullptr);
+    ConfigManager configManager(&errorHandler);
+    TEST_ASSERT_TRUE(configManager.begin());
+
+    String json = configManager.getConfigJson();
+    TEST_ASSERT_TRUE(json.length() > 2);
+
+    benchRun("config_load", json.length(), 20, [&](uint32_t) {
+        configManager.begin();
+    });
+
+    JsonDocument doc;
+    benchRun("config_parse", json.length(), 200, [&](uint32_t) {
+        doc.clear();
+        deserializeJson(doc, json);
+    });
+
+    String output;
+    output.reserve(json.length() + 64);
+    benchRun("config_serialize", json.length(), 200, [&](uint32_t) {
+        output = "";
+        serializeJson(doc, output);
+    });
+    TEST_ASSERT_TRUE(output.length() > 2);
+
+    std::vector<SensorConfig> configs = configManager.getSensorConfigs();
+    benchRun("config_update_sensors", configs.size(), 200, [&](uint32_t) {
+        configManager.updateSensorConfigs(configs);
+    });
+    benchRun("config_save_sensors", configs.size(), 10, [&](uint32_t) {
+        configManager.updateSensorConfigs(configs);
+        configManager.flush();
+    });
+    TEST_ASSERT_FALSE(configManager.isDirty());
+}
+
+/**
+ * @brief Run all configuration benchmarks
+ */
+void run_config_benchmarks() {
+    RUN_TEST(bench_config_json);
+}
+
+#endif // BENCH_CONFIG_H
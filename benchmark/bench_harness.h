@@ -0,0 +1,70 @@
+/**
+ * @file bench_harness.h
+ * @brief Timing and reporting helpers shared by the benchmarks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup benchmarks Benchmarks
+ * @brief On-target performance measurements
+ * @{
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <Arduino.h>
+#include "../src/Constants.h"
+
+/**
+ * @brief Print sink that discards everything
+ * @details Lets output-producing code run at full cost without the time
+ *          spent waiting on the USB link.
+ */
+class NullPrint : public Print {
+public:
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t*, size_t size) override { return size; }
+};
+
+/**
+ * @brief Print one benchmark result as a JSON line
+ * @details Every result is a single line starting with "BENCH " followed by
+ *          a JSON object, so a host script can grep the monitor output and
+ *          track numbers across firmware versions.
+ * @param name Benchmark name
+ * @param param Size parameter (sensor count, payload bytes, 0 if none)
+ * @param iterations Operations timed
+ * @param elapsedUs Total time for all operations in microseconds
+ */
+void benchReport(const char* name, uint32_t param, uint32_t iterations, uint32_t elapsedUs) {
+    float nsPerOp = iterations ? (elapsedUs * 1000.0f) / iterations : 0.0f;
+    char line[192];
+    snprintf(line, sizeof(line),
+             "BENCH {\"name\":\"%s\",\"param\":%lu,\"iterations\":%lu,\"elapsed_us\":%lu,"
+             "\"ns_per_op\":%.1f,\"cpu_mhz\":%lu,\"firmware\":\"%s\"}",
+             name, (unsigned long)param, (unsigned long)iterations, (unsigned long)elapsedUs,
+             nsPerOp, (unsigned long)ESP.getCpuFreqMHz(), Constants::FIRMWARE_VERSION);
+    Serial.println(line);
+}
+
+/**
+ * @brief Time a callable over a number of iterations and report it
+ * @tparam Body Callable taking the iteration index
+ * @param name Benchmark name
+ * @param param Size parameter
+ * @param iterations Number of calls
+ * @param body Operation under test
+ */
+template <typename Body>
+void benchRun(const char* name, uint32_t param, uint32_t iterations, Body body) {
+    // One untimed pass warms the caches and any lazy allocations
+    body(0);
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        body(i);
+    }
+    benchReport(name, param, iterations, micros() - start);
+}
+
+#endif // BENCH_HARNESS_H
+
+/** @} */ // End of benchmarks group
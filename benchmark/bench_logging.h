@@ -0,0 +1,74 @@
+/**
+ * @file bench_logging.h
+ * @brief ErrorHandler logging cost benchmarks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ */
+
+#ifndef BENCH_LOGGING_H
+#define BENCH_LOGGING_H
+
+#include <unity.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "bench_harness.h"
+#include "../src/error/ErrorHandler.h"
+
+/**
+ * @brief Measure a log call filtered out, written synchronously and deferred
+ * @details Output goes to a discarding sink so the numbers are the cost
+ *          paid by the caller, not the USB link. The deferred case queues
+ *          half a ring at a time, times only the enqueue, then drains
+ *          untimed, so no record is ever dropped.
+ */
+void bench_log_error_cost() {
+    NullPrint sink;
+    String name = "MOCK_0";
+    const uint32_t iterations = 2000;
+
+    ErrorHandler quiet(nullptr);
+    benchRun("log_info_filtered", 0, iterations * 10, [&](uint32_t i) {
+        LOG_INFO(&quiet, "Filtered message %u from %s", i, name);
+    });
+
+    ErrorHandler handler(&sink);
+    benchRun("log_error_string", 0, iterations, [&](uint32_t) {
+        handler.logError(WARNING, "Failed to read from sensor: " + name);
+    });
+    benchRun("log_error_format", 0, iterations, [&](uint32_t i) {
+        handler.logFormatted(WARNING, "Failed to read from sensor %s (attempt %u)", name, i);
+    });
+
+    // Pretend this task is the log task so calls only enqueue
+    handler.setLogTask(xTaskGetCurrentTaskHandle());
+    const uint32_t batch = Constants::Logging::QUEUE_DEPTH / 2;
+    uint32_t enqueueUs = 0;
+    uint32_t drainUs = 0;
+    for (uint32_t done = 0; done < iterations; done += batch) {
+        uint32_t start = micros();
+        for (uint32_t i = 0; i < batch; i++) {
+            handler.logFormatted(WARNING, "Failed to read from sensor %s (attempt %u)", name, i);
+        }
+        uint32_t queued = micros();
+        handler.processLogQueue();
+        drainUs += micros() - queued;
+        enqueueUs += queued - start;
+    }
+    handler.setLogTask(nullptr);
+    ulTaskNotifyTake(pdTRUE, 0); // Consume the wake-ups sent to ourselves
+
+    uint32_t deferred = (iterations + batch - 1) / batch * batch;
+    benchReport("log_deferred_enqueue", 0, deferred, enqueueUs);
+    benchReport("log_deferred_drain", 0, deferred, drainUs);
+    TEST_ASSERT_EQUAL(0, handler.getDroppedCount());
+}
+
+/**
+ * @brief Run all logging benchmarks
+ */
+void run_logging_benchmarks() {
+    RUN_TEST(bench_log_error_cost);
+}
+
+#endif // BENCH_LOGGING_H
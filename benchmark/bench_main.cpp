@@ -0,0 +1,85 @@
+/**
+ * @file bench_main.cpp
+ * @brief Entry point for the on-target benchmark suite
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ *
+ * Run with `pio test -e bench`. Each result is one line of the form
+ * `BENCH {"name":...,"param":...,"ns_per_op":...}` in the monitor output;
+ * grep for the prefix to collect them.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "bench_registry.h"
+#include "bench_cache.h"
+#include "bench_measure.h"
+#include "bench_config.h"
+#include "bench_logging.h"
+#include "bench_sim.h"
+
+// Function declarations for the benchmark groups
+void run_registry_benchmarks();
+void run_cache_benchmarks();
+void run_measure_benchmarks();
+void run_config_benchmarks();
+void run_logging_benchmarks();
+#ifdef NATIVE_SIM
+void run_sim_benchmarks();
+#endif
+
+/**
+ * @brief Setup function runs before each benchmark
+ */
+void setUp(void) {
+}
+
+/**
+ * @brief Teardown function runs after each benchmark
+ */
+void tearDown(void) {
+}
+
+/**
+ * @brief Arduino setup function - runs the benchmarks
+ */
+void setup() {
+    // Wait for serial connection
+    delay(2000);
+    Serial.begin(115200);
+
+    UNITY_BEGIN();
+
+    run_registry_benchmarks();
+    run_cache_benchmarks();
+    run_measure_benchmarks();
+    run_config_benchmarks();
+    run_logging_benchmarks();
+#ifdef NATIVE_SIM
+    run_sim_benchmarks();
+#endif
+
+    UNITY_END();
+}
+
+/**
+ * @brief Arduino loop function - empty for benchmarks
+ */
+void loop() {
+}
+
+#ifdef NATIVE_SIM
+#include <ArduinoSim.h>
+
+/**
+ * @brief Host entry point for pio test -e native_load
+ * setup() runs on the main thread, which the simulation treats as the
+ * Arduino loop task.
+ */
+int main(int argc, char** argv) {
+    setup();
+    Sim::shutdown(Unity.TestFailures == 0 ? 0 : 1);
+}
+#endif
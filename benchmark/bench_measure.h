@@ -0,0 +1,67 @@
+/**
+ * @file bench_measure.h
+ * @brief MEAS? response formatting benchmarks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ */
+
+#ifndef BENCH_MEASURE_H
+#define BENCH_MEASURE_H
+
+#include <unity.h>
+#include <vector>
+#include "bench_harness.h"
+#include "../test/test_mock_sensor.h"
+#include "../src/communication/CommunicationManager.h"
+
+/**
+ * @brief Measure building the MEAS? CSV line against sensor count
+ * @details Formats a temperature and humidity value per mock sensor the way
+ *          collectSensorReadings does, joins them with
+ *          CommunicationManager::joinCsv and prints to a discarding sink, so
+ *          the result is formatting cost without USB transfer time.
+ */
+void bench_measure_formatting() {
+    ErrorHandler errorHandler(nullptr);
+    NullPrint sink;
+    const uint32_t iterations = 2000;
+
+    for (size_t count = 1; count <= Constants::Sensors::MAX_SENSORS; count *= 2) {
+        std::vector<MockSensor*> sensors;
+        for (size_t i = 0; i < count; i++) {
+            sensors.push_back(new MockSensor("MOCK_" + String(i), &errorHandler));
+            sensors.back()->initialize();
+            sensors.back()->setMockTemperature(20.0f + i * 0.37f);
+            sensors.back()->setMockHumidity(40.0f + i * 0.53f);
+        }
+
+        std::vector<String> values;
+        values.reserve(count * 2);
+        size_t lineLength = 0;
+        benchRun("meas_format", count, iterations, [&](uint32_t) {
+            values.clear();
+            for (MockSensor* sensor : sensors) {
+                values.push_back(String(sensor->readTemperature()));
+                values.push_back(String(sensor->readHumidity()));
+            }
+            String line = CommunicationManager::joinCsv(values);
+            lineLength = line.length();
+            sink.println(line);
+        });
+        TEST_ASSERT_TRUE(lineLength > 0);
+
+        for (MockSensor* sensor : sensors) {
+            delete sensor;
+        }
+    }
+}
+
+/**
+ * @brief Run all MEAS? benchmarks
+ */
+void run_measure_benchmarks() {
+    RUN_TEST(bench_measure_formatting);
+}
+
+#endif // BENCH_MEASURE_H
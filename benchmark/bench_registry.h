@@ -0,0 +1,65 @@
+/**
+ * @file bench_registry.h
+ * @brief Sensor registry lookup benchmarks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ */
+
+#ifndef BENCH_REGISTRY_H
+#define BENCH_REGISTRY_H
+
+#include <unity.h>
+#include <vector>
+#include "bench_harness.h"
+#include "../test/test_mock_sensor.h"
+#include "../src/managers/SensorRegistry.h"
+
+/**
+ * @brief Measure name lookup and interface views against sensor count
+ * @details Registers 1 to MAX_SENSORS mock sensors and looks up every name
+ *          in turn, which is the access pattern of one acquisition cycle.
+ */
+void bench_registry_lookup() {
+    ErrorHandler errorHandler(nullptr);
+    const uint32_t iterations = 20000;
+
+    for (size_t count = 1; count <= Constants::Sensors::MAX_SENSORS; count *= 2) {
+        SensorRegistry registry(&errorHandler);
+        std::vector<MockSensor*> sensors;
+        std::vector<String> names;
+        for (size_t i = 0; i < count; i++) {
+            names.push_back("MOCK_" + String(i));
+            sensors.push_back(new MockSensor(names.back(), &errorHandler));
+            sensors.back()->initialize();
+            TEST_ASSERT_TRUE(registry.registerSensor(sensors.back()));
+        }
+
+        volatile uint32_t found = 0;
+        benchRun("registry_lookup", count, iterations, [&](uint32_t i) {
+            found += registry.getSensorByName(names[i % count]) != nullptr;
+        });
+        TEST_ASSERT_TRUE(found > 0);
+
+        benchRun("registry_lookup_miss", count, iterations, [&](uint32_t) {
+            found += registry.getSensorByName("MISSING") != nullptr;
+        });
+
+        benchRun("registry_temperature_view", count, iterations / 10, [&](uint32_t) {
+            found += registry.getTemperatureSensors().size();
+        });
+
+        for (MockSensor* sensor : sensors) {
+            delete registry.unregisterSensor(sensor->getName());
+        }
+    }
+}
+
+/**
+ * @brief Run all registry benchmarks
+ */
+void run_registry_benchmarks() {
+    RUN_TEST(bench_registry_lookup);
+}
+
+#endif // BENCH_REGISTRY_H
@@ -0,0 +1,266 @@
+/**
+ * @file bench_sim.h
+ * @brief Whole-firmware load test on the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup benchmarks
+ *
+ * Brings the firmware up the way main.cpp does, against a simulated board
+ * with every sensor slot populated, and measures what the acquisition
+ * workers and the command interface sustain. Native builds only; run with
+ * `pio test -e native_load`.
+ */
+
+#ifndef BENCH_SIM_H
+#define BENCH_SIM_H
+
+#ifdef NATIVE_SIM
+
+#include <unity.h>
+#include <ArduinoSim.h>
+#include <SimDevices.h>
+#include <LittleFS.h>
+#include "bench_harness.h"
+#include "../src/error/ErrorHandler.h"
+#include "../src/config/ConfigManager.h"
+#include "../src/managers/I2CManager.h"
+#include "../src/managers/SPIManager.h"
+#include "../src/managers/SensorManager.h"
+#include "../src/managers/LedManager.h"
+#include "../src/managers/PerfCounters.h"
+#include "../src/managers/TaskManager.h"
+#include "../src/communication/CommunicationManager.h"
+
+/**
+ * @brief Devices of the simulated board
+ * @details One SHT41 and one Si7021 on each of mux channels 0-6 of both
+ *          buses, and a MAX31865 on every chip select: 32 sensors, which
+ *          fills the 32-bit slot masks of a -DMAX_SENSOR_SLOTS=32 build.
+ */
+struct SimBoard {
+    static const int BUSES = 2;           ///< Wire and Wire1
+    static const int CHANNELS = 7;        ///< Mux channels used per bus
+    static const int RTDS = 4;            ///< One per logical SS pin
+    static const int SENSORS = BUSES * CHANNELS * 2 + RTDS;
+
+    Sim::Sht4x sht[BUSES][CHANNELS];      ///< SHT41 per bus and channel
+    Sim::Si7021 si[BUSES][CHANNELS];      ///< Si7021 per bus and channel
+    Sim::Max31865 rtd[RTDS];              ///< PT100 front ends
+
+    /**
+     * @brief Attach every device to its bus
+     */
+    void attach() {
+        for (int bus = 0; bus < BUSES; bus++) {
+            for (int channel = 0; channel < CHANNELS; channel++) {
+                sht[bus][channel].setTemperature(20.0f + channel);
+                sht[bus][channel].setHumidity(40.0f + channel);
+                si[bus][channel].setTemperature(21.0f + channel);
+                si[bus][channel].setHumidity(45.0f + channel);
+                Sim::attachI2C(bus, &sht[bus][channel], channel);
+                Sim::attachI2C(bus, &si[bus][channel], channel);
+            }
+        }
+        for (int i = 0; i < RTDS; i++) {
+            rtd[i].setTemperature(25.0f + i * 10.0f);
+            Sim::attachSpi(Constants::Pins::SPI::SS_PINS[i], &rtd[i]);
+        }
+    }
+
+    /**
+     * @brief Set the NACK probability of every I2C sensor
+     * @param rate Probability per transfer
+     */
+    void setI2CNackRate(float rate) {
+        for (int bus = 0; bus < BUSES; bus++) {
+            for (int channel = 0; channel < CHANNELS; channel++) {
+                sht[bus][channel].setNackRate(rate);
+                si[bus][channel].setNackRate(rate);
+            }
+        }
+    }
+
+    /**
+     * @brief Sum the NACKs of every I2C sensor
+     * @return NACK count since attach
+     */
+    uint32_t i2cNacks() {
+        uint32_t total = 0;
+        for (int bus = 0; bus < BUSES; bus++) {
+            for (int channel = 0; channel < CHANNELS; channel++) {
+                total += sht[bus][channel].stats().nacks.load() + si[bus][channel].stats().nacks.load();
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Build the configuration file for the board
+     * @param pollingRateMs Polling rate of every sensor
+     * @return Configuration JSON as ConfigManager reads it
+     */
+    String config(uint32_t pollingRateMs) const {
+        String json = "{\"" + String(Constants::CONFIG_I2C_SENSORS) + "\":[";
+        int n = 0;
+        for (int bus = 0; bus < BUSES; bus++) {
+            // Simulated bus 1 is Wire1, which the firmware calls I2C0
+            String port = bus == 1 ? "I2C0" : "I2C1";
+            for (int channel = 0; channel < CHANNELS; channel++) {
+                const char* types[2] = {"SHT41", "Adafruit Si7021"};
+                const uint8_t addresses[2] = {Sim::Sht4x::DEFAULT_ADDRESS, Sim::Si7021::DEFAULT_ADDRESS};
+                for (int kind = 0; kind < 2; kind++) {
+                    if (n++) {
+                        json += ",";
+                    }
+                    json += "{\"Peripheral Name\":\"I2C" + String(n) + "\",\"Peripheral Type\":\"" + types[kind] +
+                            "\",\"I2C Port\":\"" + port + "/MUX:" + String(channel) + "\",\"Address (HEX)\":" +
+                            String(addresses[kind]) + ",\"Polling Rate[1000 ms]\":" + String(pollingRateMs) + "}";
+                }
+            }
+        }
+        json += "],\"" + String(Constants::CONFIG_SPI_SENSORS) + "\":[";
+        for (int i = 0; i < RTDS; i++) {
+            if (i) {
+                json += ",";
+            }
+            json += "{\"Peripheral Name\":\"PT100_" + String(i) + "\",\"Peripheral Type\":\"Adafruit PT100 RTD\","
+                    "\"SS Pin\":" + String(i) + ",\"Polling Rate[1000 ms]\":" + String(pollingRateMs) +
+                    ",\"Additional\":\"Wire mode: 2-wire\"}";
+        }
+        json += "],\"Board ID\":\"SimLoad\",\"Telemetry\":{\"Enabled\":false}}";
+        return json;
+    }
+};
+
+/**
+ * @brief Count completed sensor reads since the last PerfCounters::resetAll()
+ * @return Reads over every sensor type
+ */
+uint32_t simReadsCompleted() {
+    return PerfCounters::histogram(PerfSite::SHT41_READ).summarize().count +
+           PerfCounters::histogram(PerfSite::SI7021_READ).summarize().count +
+           PerfCounters::histogram(PerfSite::PT100_READ).summarize().count;
+}
+
+/**
+ * @brief Sustained acquisition rate and command latency of a full board
+ * @details Every sensor polls at a rate chosen so the board does as many
+ *          reads per second as 100 sensors at 1 s would. The test measures
+ *          over simulated time, so ns_per_op of the read results is the
+ *          simulated interval between reads and the target is 10 ms; the
+ *          command results are simulated round trips of *IDN? and of
+ *          MEAS:FRES? over the console while acquisition runs. The second
+ *          pass repeats the load with 2 % of I2C transfers NACKed.
+ */
+void bench_sim_full_board() {
+    const uint32_t equivalentSensors = 100;
+    const uint32_t pollingRateMs = SimBoard::SENSORS * 1000 / equivalentSensors;
+    const uint32_t measureMs = 30000;
+    const uint32_t expectedReads = SimBoard::SENSORS * (measureMs / pollingRateMs);
+
+    static SimBoard board;
+    static NullPrint discard;
+    Sim::setSeed(1);
+    Sim::resetStorage();
+    board.attach();
+    Sim::writeFile(Constants::CONFIG_FILE_PATH, board.config(pollingRateMs).c_str());
+
+    // Same bring-up as main.cpp, with log output discarded
+    ErrorHandler* errorHandler = new ErrorHandler(&discard, &discard);
+    LedManager* ledManager = new LedManager(errorHandler);
+    ledManager->begin();
+    TEST_ASSERT_TRUE(LittleFS.begin(true, "/litlefs", 10, "ffat"));
+    ConfigManager* configManager = new ConfigManager(errorHandler);
+    TEST_ASSERT_TRUE(configManager->begin());
+    I2CManager* i2cManager = new I2CManager(errorHandler);
+    TEST_ASSERT_TRUE(i2cManager->begin());
+    SPIManager* spiManager = new SPIManager(errorHandler);
+    TEST_ASSERT_TRUE(spiManager->begin());
+    for (size_t i = 0; i < SimBoard::RTDS; i++) {
+        spiManager->registerSSPin(i);
+    }
+    SensorManager* sensorManager = new SensorManager(configManager, i2cManager, errorHandler, spiManager);
+    TEST_ASSERT_TRUE(sensorManager->initializeSensors());
+    sensorManager->setMaxCacheAge(pollingRateMs);
+    CommunicationManager* commManager = new CommunicationManager(sensorManager, configManager, errorHandler,
+                                                                 ledManager);
+    commManager->begin(115200);
+    TaskManager* taskManager = new TaskManager(sensorManager, commManager, ledManager, errorHandler);
+    taskManager->setPlacement(configManager->getTaskConfig());
+    TEST_ASSERT_TRUE(taskManager->begin());
+    TEST_ASSERT_TRUE(taskManager->startLogTask());
+    commManager->setTaskManager(taskManager);
+    TEST_ASSERT_TRUE(taskManager->startSupervisorTask());
+    TEST_ASSERT_TRUE(taskManager->startCommTask());
+    TEST_ASSERT_TRUE(taskManager->startSensorTask());
+    TEST_ASSERT_TRUE(taskManager->startRecoveryTask());
+
+    // Settle, then measure acquisition alone
+    delay(2 * pollingRateMs);
+    PerfCounters::resetAll();
+    uint64_t start = Sim::nowUs();
+    delay(measureMs);
+    uint32_t reads = simReadsCompleted();
+    benchReport("sim_board_reads", equivalentSensors, reads, static_cast<uint32_t>(Sim::nowUs() - start));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expectedReads * 9 / 10, reads);
+
+    // Commands while acquisition runs; results are printed after the console is switched back
+    const uint32_t commands = 20;
+    uint32_t commandUs = 0;
+    uint32_t answered = 0;
+    Serial.setSink(HardwareSerial::Sink::CAPTURE);
+    for (uint32_t i = 0; i < commands; i++) {
+        Serial.takeOutput();
+        uint64_t sent = Sim::nowUs();
+        Serial.inject("*IDN?\n");
+        if (Serial.waitForOutput(Constants::FIRMWARE_VERSION, 1000)) {
+            commandUs += static_cast<uint32_t>(Sim::nowUs() - sent);
+            answered++;
+        }
+        delay(pollingRateMs / 3);
+    }
+    
+    // On-demand reads: each answer waits for a read made after the query
+    uint32_t freshUs = 0;
+    uint32_t freshAnswered = 0;
+    for (uint32_t i = 0; i < commands; i++) {
+        Serial.takeOutput();
+        uint64_t sent = Sim::nowUs();
+        Serial.inject("MEAS:FRES? I2C" + std::to_string(i % (SimBoard::BUSES * SimBoard::CHANNELS * 2) + 1) + "\n");
+        if (Serial.waitForOutput("\n", 1000) && Serial.takeOutput().find("ERROR") == std::string::npos) {
+            freshUs += static_cast<uint32_t>(Sim::nowUs() - sent);
+            freshAnswered++;
+        }
+        delay(pollingRateMs / 3);
+    }
+    Serial.takeOutput();
+    Serial.setSink(HardwareSerial::Sink::STDOUT);
+    benchReport("sim_idn_round_trip", equivalentSensors, answered, commandUs);
+    benchReport("sim_meas_fresh_round_trip", equivalentSensors, freshAnswered, freshUs);
+    TEST_ASSERT_EQUAL_UINT32(commands, answered);
+    TEST_ASSERT_EQUAL_UINT32(commands, freshAnswered);
+
+    // Same load with a flaky bus
+    board.setI2CNackRate(0.02f);
+    uint32_t nacksBefore = board.i2cNacks();
+    PerfCounters::resetAll();
+    start = Sim::nowUs();
+    delay(measureMs);
+    reads = simReadsCompleted();
+    benchReport("sim_board_reads_nack2pct", equivalentSensors, reads, static_cast<uint32_t>(Sim::nowUs() - start));
+    benchReport("sim_board_nacks", equivalentSensors, board.i2cNacks() - nacksBefore, measureMs * 1000);
+    board.setI2CNackRate(0.0f);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expectedReads / 2, reads);
+}
+
+/**
+ * @brief Run the host load test
+ */
+void run_sim_benchmarks() {
+    Sim::setTimeScale(10.0);
+    RUN_TEST(bench_sim_full_board);
+}
+
+#endif // NATIVE_SIM
+
+#endif // BENCH_SIM_H
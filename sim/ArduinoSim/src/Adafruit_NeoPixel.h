@@ -0,0 +1,41 @@
+/**
+ * @file Adafruit_NeoPixel.h
+ * @brief NeoPixel driver of the host simulation; remembers the last colour shown
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include "Arduino.h"
+
+ #define NEO_GRB ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+ #define NEO_KHZ800 0x0000
+
+ class Adafruit_NeoPixel {
+ public:
+     Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type) {}
+
+     void begin() {}
+     void show() { shown = pixel; shownBrightness = brightness; }
+     void clear() { pixel = 0; }
+     void setBrightness(uint8_t value) { brightness = value; }
+     void setPixelColor(uint16_t index, uint32_t color) { if (index == 0) pixel = color; }
+     uint32_t getPixelColor(uint16_t index) const { return index == 0 ? pixel : 0; }
+     static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+         return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+     }
+
+     /**
+      * @brief Colour and brightness of the last show(), for tests
+      */
+     uint32_t getShownColor() const { return shown; }
+     uint8_t getShownBrightness() const { return shownBrightness; }
+
+ private:
+     uint32_t pixel = 0;
+     uint32_t shown = 0;
+     uint8_t brightness = 255;
+     uint8_t shownBrightness = 0;
+ };
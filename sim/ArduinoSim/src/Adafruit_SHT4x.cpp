@@ -0,0 +1,106 @@
+#include "Adafruit_SHT4x.h"
+#include "SimDevices.h"
+
+namespace {
+    struct Measurement {
+        uint8_t command;
+        uint32_t waitMs;
+    };
+
+    Measurement measurementFor(sht4x_precision_t precision, sht4x_heater_t heater) {
+        switch (heater) {
+            case SHT4X_HIGH_HEATER_1S: return {0x39, 1100};
+            case SHT4X_HIGH_HEATER_100MS: return {0x32, 110};
+            case SHT4X_MED_HEATER_1S: return {0x2F, 1100};
+            case SHT4X_MED_HEATER_100MS: return {0x24, 110};
+            case SHT4X_LOW_HEATER_1S: return {0x1E, 1100};
+            case SHT4X_LOW_HEATER_100MS: return {0x15, 110};
+            case SHT4X_NO_HEATER: break;
+        }
+        switch (precision) {
+            case SHT4X_MED_PRECISION: return {0xF6, 5};
+            case SHT4X_LOW_PRECISION: return {0xE0, 2};
+            case SHT4X_HIGH_PRECISION: break;
+        }
+        return {0xFD, 10};
+    }
+}
+
+bool Adafruit_SHT4x::begin(TwoWire* theWire) {
+    wire = theWire;
+    wire->beginTransmission(SHT4x_DEFAULT_ADDR);
+    if (wire->endTransmission() != 0) {
+        return false;
+    }
+    return reset();
+}
+
+bool Adafruit_SHT4x::command(uint8_t cmd) {
+    wire->beginTransmission(SHT4x_DEFAULT_ADDR);
+    wire->write(cmd);
+    return wire->endTransmission() == 0;
+}
+
+bool Adafruit_SHT4x::readWords(uint8_t* buffer) {
+    if (wire->requestFrom(SHT4x_DEFAULT_ADDR, 6) != 6) {
+        return false;
+    }
+    for (int i = 0; i < 6; i++) {
+        buffer[i] = static_cast<uint8_t>(wire->read());
+    }
+    return Sim::Sht4x::crc8(buffer, 2) == buffer[2] && Sim::Sht4x::crc8(buffer + 3, 2) == buffer[5];
+}
+
+uint32_t Adafruit_SHT4x::readSerial() {
+    uint8_t buffer[6];
+    if (!command(0x89)) {
+        return 0;
+    }
+    delay(10);
+    if (!readWords(buffer)) {
+        return 0;
+    }
+    return static_cast<uint32_t>(buffer[0]) << 24 | static_cast<uint32_t>(buffer[1]) << 16 |
+           static_cast<uint32_t>(buffer[3]) << 8 | buffer[4];
+}
+
+bool Adafruit_SHT4x::reset() {
+    if (!command(0x94)) {
+        return false;
+    }
+    delay(1);
+    return true;
+}
+
+bool Adafruit_SHT4x::getEvent(sensors_event_t* humidity, sensors_event_t* temp) {
+    Measurement measurement = measurementFor(precision, heater);
+    uint8_t buffer[6];
+    if (!command(measurement.command)) {
+        return false;
+    }
+    delay(measurement.waitMs);
+    if (!readWords(buffer)) {
+        return false;
+    }
+
+    float ticksT = static_cast<float>(buffer[0] << 8 | buffer[1]);
+    float ticksRH = static_cast<float>(buffer[3] << 8 | buffer[4]);
+    float celsius = -45.0f + 175.0f * ticksT / 65535.0f;
+    float percent = std::min(100.0f, std::max(0.0f, -6.0f + 125.0f * ticksRH / 65535.0f));
+    int32_t now = static_cast<int32_t>(millis());
+    if (humidity) {
+        *humidity = {};
+        humidity->version = sizeof(sensors_event_t);
+        humidity->type = SENSOR_TYPE_RELATIVE_HUMIDITY;
+        humidity->timestamp = now;
+        humidity->relative_humidity = percent;
+    }
+    if (temp) {
+        *temp = {};
+        temp->version = sizeof(sensors_event_t);
+        temp->type = SENSOR_TYPE_AMBIENT_TEMPERATURE;
+        temp->timestamp = now;
+        temp->temperature = celsius;
+    }
+    return true;
+}
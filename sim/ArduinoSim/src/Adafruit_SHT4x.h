@@ -0,0 +1,49 @@
+/**
+ * @file Adafruit_SHT4x.h
+ * @brief Adafruit SHT4x library for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Speaks the same I2C protocol as the real library, at its fixed address
+ * 0x44, so it works against a Sim::Sht4x or any other device there.
+ */
+
+ #pragma once
+
+ #include "Adafruit_Sensor.h"
+ #include "Wire.h"
+
+ #define SHT4x_DEFAULT_ADDR 0x44
+
+ typedef enum { SHT4X_HIGH_PRECISION, SHT4X_MED_PRECISION, SHT4X_LOW_PRECISION } sht4x_precision_t;
+
+ typedef enum {
+     SHT4X_NO_HEATER,
+     SHT4X_HIGH_HEATER_1S,
+     SHT4X_HIGH_HEATER_100MS,
+     SHT4X_MED_HEATER_1S,
+     SHT4X_MED_HEATER_100MS,
+     SHT4X_LOW_HEATER_1S,
+     SHT4X_LOW_HEATER_100MS,
+ } sht4x_heater_t;
+
+ class Adafruit_SHT4x {
+ public:
+     bool begin(TwoWire* theWire = &Wire);
+     uint32_t readSerial();
+     bool reset();
+     void setPrecision(sht4x_precision_t value) { precision = value; }
+     sht4x_precision_t getPrecision() { return precision; }
+     void setHeater(sht4x_heater_t value) { heater = value; }
+     sht4x_heater_t getHeater() { return heater; }
+     bool getEvent(sensors_event_t* humidity, sensors_event_t* temp);
+
+ private:
+     bool command(uint8_t cmd);
+     bool readWords(uint8_t* buffer);
+
+     TwoWire* wire = nullptr;
+     sht4x_precision_t precision = SHT4X_HIGH_PRECISION;
+     sht4x_heater_t heater = SHT4X_NO_HEATER;
+ };
@@ -0,0 +1,29 @@
+/**
+ * @file Adafruit_Sensor.h
+ * @brief Adafruit unified sensor event for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include <cstdint>
+
+ typedef enum {
+     SENSOR_TYPE_AMBIENT_TEMPERATURE = 13,
+     SENSOR_TYPE_RELATIVE_HUMIDITY = 12,
+ } sensors_type_t;
+
+ typedef struct {
+     int32_t version;
+     int32_t sensor_id;
+     int32_t type;
+     int32_t reserved0;
+     int32_t timestamp;
+     union {
+         float data[4];
+         float temperature;
+         float relative_humidity;
+     };
+ } sensors_event_t;
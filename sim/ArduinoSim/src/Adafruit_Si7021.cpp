@@ -0,0 +1,99 @@
+#include "Adafruit_Si7021.h"
+#include "SimDevices.h"
+
+namespace {
+    constexpr uint32_t MEASUREMENT_TIMEOUT_MS = 100;
+}
+
+bool Adafruit_Si7021::begin() {
+    wire->beginTransmission(SI7021_DEFAULT_ADDRESS);
+    if (wire->endTransmission() != 0) {
+        return false;
+    }
+    reset();
+
+    // The library trusts the part only if the user register holds its reset value
+    uint8_t readRegister = 0xE7;
+    uint8_t userRegister = 0;
+    if (!command(&readRegister, 1) || !readResponse(&userRegister, 1, 0) || userRegister != 0x3A) {
+        return false;
+    }
+
+    readSerialNumber();
+    uint8_t readRevision[2] = {0x84, 0xB8};
+    if (!command(readRevision, 2) || !readResponse(&revision, 1, 0)) {
+        revision = 0;
+    }
+    return true;
+}
+
+bool Adafruit_Si7021::command(const uint8_t* cmd, size_t length) {
+    wire->beginTransmission(SI7021_DEFAULT_ADDRESS);
+    wire->write(cmd, length);
+    return wire->endTransmission() == 0;
+}
+
+bool Adafruit_Si7021::readResponse(uint8_t* buffer, size_t length, uint32_t waitMs) {
+    // No-hold conversions NACK reads until done; poll like the library does
+    uint32_t start = millis();
+    while (wire->requestFrom(SI7021_DEFAULT_ADDRESS, static_cast<int>(length)) != length) {
+        if (millis() - start >= waitMs) {
+            return false;
+        }
+        delay(6);
+    }
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = static_cast<uint8_t>(wire->read());
+    }
+    return true;
+}
+
+uint16_t Adafruit_Si7021::readMeasurement(uint8_t cmd) {
+    uint8_t buffer[3];
+    if (!command(&cmd, 1)) {
+        return 0xFFFF;
+    }
+    delay(20);
+    if (!readResponse(buffer, sizeof(buffer), MEASUREMENT_TIMEOUT_MS)) {
+        return 0xFFFF;
+    }
+    return static_cast<uint16_t>(buffer[0] << 8 | buffer[1]);
+}
+
+float Adafruit_Si7021::readTemperature() {
+    uint16_t code = readMeasurement(0xF3);
+    if (code == 0xFFFF) {
+        return NAN;
+    }
+    return code * 175.72f / 65536.0f - 46.85f;
+}
+
+float Adafruit_Si7021::readHumidity() {
+    uint16_t code = readMeasurement(0xF5);
+    if (code == 0xFFFF) {
+        return NAN;
+    }
+    float humidity = code * 125.0f / 65536.0f - 6.0f;
+    return humidity > 100.0f ? 100.0f : humidity;
+}
+
+void Adafruit_Si7021::reset() {
+    uint8_t cmd = 0xFE;
+    command(&cmd, 1);
+    delay(50);
+}
+
+void Adafruit_Si7021::readSerialNumber() {
+    uint8_t serialA[2] = {0xFA, 0x0F};
+    uint8_t bufferA[8];
+    if (command(serialA, 2) && readResponse(bufferA, sizeof(bufferA), 0)) {
+        sernum_a = static_cast<uint32_t>(bufferA[0]) << 24 | static_cast<uint32_t>(bufferA[2]) << 16 |
+                   static_cast<uint32_t>(bufferA[4]) << 8 | bufferA[6];
+    }
+    uint8_t serialB[2] = {0xFC, 0xC9};
+    uint8_t bufferB[6];
+    if (command(serialB, 2) && readResponse(bufferB, sizeof(bufferB), 0)) {
+        sernum_b = static_cast<uint32_t>(bufferB[0]) << 24 | static_cast<uint32_t>(bufferB[1]) << 16 |
+                   static_cast<uint32_t>(bufferB[3]) << 8 | bufferB[4];
+    }
+}
@@ -0,0 +1,40 @@
+/**
+ * @file Adafruit_Si7021.h
+ * @brief Adafruit Si7021 library for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Speaks the same I2C protocol as the real library, at its fixed address
+ * 0x40: begin() resets the chip, checks the user register and reads the
+ * serial number and firmware revision.
+ */
+
+ #pragma once
+
+ #include "Wire.h"
+
+ #define SI7021_DEFAULT_ADDRESS 0x40
+
+ class Adafruit_Si7021 {
+ public:
+     explicit Adafruit_Si7021(TwoWire* theWire = &Wire) : wire(theWire) {}
+
+     bool begin();
+     float readTemperature();
+     float readHumidity();
+     void reset();
+     void readSerialNumber();
+     uint8_t getRevision() { return revision; }
+
+     uint32_t sernum_a = 0;   ///< High word of the serial number
+     uint32_t sernum_b = 0;   ///< Low word of the serial number
+
+ private:
+     bool command(const uint8_t* cmd, size_t length);
+     bool readResponse(uint8_t* buffer, size_t length, uint32_t waitMs);
+     uint16_t readMeasurement(uint8_t cmd);
+
+     TwoWire* wire = nullptr;
+     uint8_t revision = 0;
+ };
@@ -0,0 +1,508 @@
+#include "Arduino.h"
+#include "ArduinoSim.h"
+#include "WiFi.h"
+#include "esp_err.h"
+#include "esp_pm.h"
+#include "esp_task_wdt.h"
+#include <malloc.h>
+#include <unistd.h>
+#include <map>
+#include <mutex>
+#include <random>
+
+EspClass ESP;
+WiFiClass WiFi;
+
+namespace {
+    constexpr size_t INTERNAL_RAM_BYTES = 320 * 1024;
+    constexpr size_t PSRAM_BYTES = 2 * 1024 * 1024;
+    constexpr uint8_t GPIO_COUNT = 49;
+
+    std::atomic<uint8_t> gpioLevels[GPIO_COUNT];
+
+    struct Interrupt {
+        void (*handler)(void*) = nullptr;
+        void (*plainHandler)() = nullptr;
+        void* arg = nullptr;
+        int mode = 0;
+    };
+
+    std::mutex interruptMutex;
+    Interrupt interrupts[GPIO_COUNT];
+    std::atomic<uint32_t> restarts{0};
+
+    std::mutex randomMutex;
+    std::mt19937& generator() {
+        static std::mt19937 instance(Sim::getSeed());
+        return instance;
+    }
+
+    /**
+     * @brief PSRAM allocations, which come from the host heap but are counted apart
+     */
+    struct Psram {
+        std::mutex mutex;
+        std::map<void*, size_t> blocks;
+        size_t used = 0;
+        size_t peak = 0;
+    };
+
+    Psram& psram() {
+        static Psram instance;
+        return instance;
+    }
+
+    size_t hostHeapUsed() {
+#ifdef __GLIBC__
+        return mallinfo2().uordblks;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Internal heap left, counting host allocations since the first query
+     * The host process starts with far more than 320 KB in use; only growth
+     * after start-up is charged to the firmware.
+     */
+    size_t internalFree() {
+        static const size_t baseline = hostHeapUsed();
+        size_t current = hostHeapUsed();
+        size_t used = current > baseline ? current - baseline : 0;
+        size_t psramUsed;
+        {
+            std::lock_guard<std::mutex> lock(psram().mutex);
+            psramUsed = psram().used;
+        }
+        used = used > psramUsed ? used - psramUsed : 0;
+        return used < INTERNAL_RAM_BYTES ? INTERNAL_RAM_BYTES - used : 0;
+    }
+
+    size_t minimumInternalFree() {
+        static std::atomic<size_t> minimum{INTERNAL_RAM_BYTES};
+        size_t now = internalFree();
+        size_t seen = minimum.load();
+        while (now < seen && !minimum.compare_exchange_weak(seen, now)) {
+        }
+        return std::min(now, seen);
+    }
+
+    void* psramAllocate(size_t size) {
+        Psram& p = psram();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.used + size > PSRAM_BYTES) {
+            return nullptr;
+        }
+        void* block = malloc(size);
+        if (block) {
+            p.blocks[block] = size;
+            p.used += size;
+            p.peak = std::max(p.peak, p.used);
+        }
+        return block;
+    }
+
+    struct Watchdog {
+        std::mutex mutex;
+        uint32_t timeoutMs = 5000;
+        std::map<TaskHandle_t, uint64_t> lastResetUs;
+        std::map<TaskHandle_t, bool> reported;
+    };
+
+    Watchdog& watchdog() {
+        static Watchdog instance;
+        return instance;
+    }
+}
+
+namespace Sim {
+    void setPinLevel(uint8_t pin, uint8_t level) {
+        if (pin >= GPIO_COUNT) {
+            return;
+        }
+        int before = digitalRead(pin);
+        digitalWrite(pin, level);
+        int after = digitalRead(pin);
+        if (before == after) {
+            return;
+        }
+        Interrupt handler;
+        {
+            std::lock_guard<std::mutex> lock(interruptMutex);
+            handler = interrupts[pin];
+        }
+        int edge = after == HIGH ? RISING : FALLING;
+        if (handler.mode == CHANGE || handler.mode == edge) {
+            if (handler.handler) {
+                handler.handler(handler.arg);
+            } else if (handler.plainHandler) {
+                handler.plainHandler();
+            }
+        }
+    }
+
+    uint32_t restartRequests() {
+        return restarts;
+    }
+
+    void shutdown(int exitCode) {
+        fflush(stdout);
+        fflush(stderr);
+        _exit(exitCode);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// GPIO and helpers
+// ---------------------------------------------------------------------------
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < GPIO_COUNT && (mode & PULLDOWN)) {
+        gpioLevels[pin] = LOW;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin < GPIO_COUNT) {
+        // Stored inverted so that zero-initialised pins read HIGH
+        gpioLevels[pin] = level ? LOW : HIGH;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < GPIO_COUNT && gpioLevels[pin] ? LOW : HIGH;
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+    if (pin < GPIO_COUNT) {
+        std::lock_guard<std::mutex> lock(interruptMutex);
+        interrupts[pin] = {handler, nullptr, arg, mode};
+    }
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode) {
+    if (pin < GPIO_COUNT) {
+        std::lock_guard<std::mutex> lock(interruptMutex);
+        interrupts[pin] = {nullptr, handler, nullptr, mode};
+    }
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin < GPIO_COUNT) {
+        std::lock_guard<std::mutex> lock(interruptMutex);
+        interrupts[pin] = {};
+    }
+}
+
+long random(long max) {
+    return max <= 0 ? 0 : random(0, max);
+}
+
+long random(long min, long max) {
+    if (min >= max) {
+        return min;
+    }
+    std::lock_guard<std::mutex> lock(randomMutex);
+    return std::uniform_int_distribution<long>(min, max - 1)(generator());
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        std::lock_guard<std::mutex> lock(randomMutex);
+        generator().seed(static_cast<uint32_t>(seed));
+    }
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    if (inMax == inMin) {
+        return outMin;
+    }
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+void* ps_malloc(size_t size) {
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+bool psramFound() {
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Chip
+// ---------------------------------------------------------------------------
+
+uint32_t EspClass::getHeapSize() {
+    return INTERNAL_RAM_BYTES;
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return static_cast<uint32_t>(internalFree());
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return static_cast<uint32_t>(minimumInternalFree());
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    // The internal heap fragments; the largest block is rarely all of it
+    return static_cast<uint32_t>(internalFree() * 3 / 4);
+}
+
+uint32_t EspClass::getPsramSize() {
+    return PSRAM_BYTES;
+}
+
+uint32_t EspClass::getFreePsram() {
+    std::lock_guard<std::mutex> lock(psram().mutex);
+    return static_cast<uint32_t>(PSRAM_BYTES - psram().used);
+}
+
+uint32_t EspClass::getCycleCount() {
+    return static_cast<uint32_t>(Sim::nowUs() * getCpuFreqMHz());
+}
+
+void EspClass::restart() {
+    restarts++;
+    fprintf(stderr, "[sim] ESP.restart() requested by %s\n", pcTaskGetName(nullptr));
+    // The chip would reset here; park the caller and let the harness decide
+    for (;;) {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        default: return "UNKNOWN ERROR";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Heap capabilities
+// ---------------------------------------------------------------------------
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        return psramAllocate(size);
+    }
+    return malloc(size);
+}
+
+void* heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return nullptr;
+    }
+    void* block = heap_caps_malloc(count * size, caps);
+    if (block) {
+        memset(block, 0, count * size);
+    }
+    return block;
+}
+
+void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return nullptr;
+    }
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    if (caps & MALLOC_CAP_SPIRAM) {
+        Psram& p = psram();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.used + rounded > PSRAM_BYTES) {
+            return nullptr;
+        }
+        void* block = aligned_alloc(alignment, rounded);
+        if (block) {
+            p.blocks[block] = rounded;
+            p.used += rounded;
+            p.peak = std::max(p.peak, p.used);
+        }
+        return block;
+    }
+    return aligned_alloc(alignment, rounded);
+}
+
+void heap_caps_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    {
+        Psram& p = psram();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        auto block = p.blocks.find(ptr);
+        if (block != p.blocks.end()) {
+            p.used -= block->second;
+            p.blocks.erase(block);
+        }
+    }
+    free(ptr);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? PSRAM_BYTES : INTERNAL_RAM_BYTES;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        return ESP.getFreePsram();
+    }
+    return internalFree();
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        std::lock_guard<std::mutex> lock(psram().mutex);
+        return PSRAM_BYTES - psram().peak;
+    }
+    return minimumInternalFree();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        return ESP.getFreePsram();
+    }
+    return ESP.getMaxAllocHeap();
+}
+
+// ---------------------------------------------------------------------------
+// Task watchdog
+// ---------------------------------------------------------------------------
+
+esp_err_t esp_task_wdt_init(uint32_t timeoutSeconds, bool panic) {
+    std::lock_guard<std::mutex> lock(watchdog().mutex);
+    watchdog().timeoutMs = timeoutSeconds * 1000;
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_add(TaskHandle_t task) {
+    if (!task) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    std::lock_guard<std::mutex> lock(watchdog().mutex);
+    if (watchdog().lastResetUs.count(task)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    watchdog().lastResetUs[task] = Sim::nowUs();
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_delete(TaskHandle_t task) {
+    if (!task) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    std::lock_guard<std::mutex> lock(watchdog().mutex);
+    watchdog().reported.erase(task);
+    return watchdog().lastResetUs.erase(task) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t esp_task_wdt_reset() {
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    uint64_t now = Sim::nowUs();
+    Watchdog& w = watchdog();
+    std::lock_guard<std::mutex> lock(w.mutex);
+    auto entry = w.lastResetUs.find(task);
+    if (entry == w.lastResetUs.end()) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    entry->second = now;
+    w.reported[task] = false;
+
+    // No timer interrupt here: each reset checks on the other subscribers instead
+    for (const auto& other : w.lastResetUs) {
+        uint64_t silentMs = (now - std::min(now, other.second)) / 1000;
+        if (silentMs > w.timeoutMs && !w.reported[other.first]) {
+            w.reported[other.first] = true;
+            fprintf(stderr, "[sim] task watchdog: %s silent for %llu ms\n", pcTaskGetName(other.first),
+                    static_cast<unsigned long long>(silentMs));
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_status(TaskHandle_t task) {
+    if (!task) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+    std::lock_guard<std::mutex> lock(watchdog().mutex);
+    return watchdog().lastResetUs.count(task) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+// ---------------------------------------------------------------------------
+// Power management
+// ---------------------------------------------------------------------------
+
+struct esp_pm_lock {
+    esp_pm_lock_type_t type;
+    const char* name;
+    uint32_t count;
+};
+
+esp_err_t esp_pm_configure(const void* config) {
+    const auto* pm = static_cast<const esp_pm_config_esp32s3_t*>(config);
+    if (!pm) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // Builds without CONFIG_FREERTOS_USE_TICKLESS_IDLE refuse light sleep the same way
+    return pm->light_sleep_enable ? ESP_ERR_NOT_SUPPORTED : ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name, esp_pm_lock_handle_t* handle) {
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *handle = new esp_pm_lock{type, name, 0};
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle) {
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->count != 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    delete handle;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle) {
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    handle->count++;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle) {
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->count == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    handle->count--;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_dump_locks(FILE* stream) {
+    fprintf(stream, "Lock stats: (simulated, no tracking)\n");
+    return ESP_OK;
+}
+
+// ---------------------------------------------------------------------------
+// Network
+// ---------------------------------------------------------------------------
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(text);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Arduino.h
+ * @brief Arduino core API for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * The subset of the arduino-esp32 core the firmware uses. Time functions
+ * run on the simulated clock of ArduinoSim.h; GPIOs keep their last
+ * written level and read HIGH otherwise, as a pulled-up idle bus does.
+ */
+
+ #pragma once
+
+ #include <algorithm>
+ #include <cmath>
+ #include <cstdint>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <cstring>
+ #include <ctype.h>
+ #include "freertos/FreeRTOS.h"
+ #include "freertos/task.h"
+ #include "freertos/semphr.h"
+ #include "WString.h"
+ #include "Print.h"
+ #include "HardwareSerial.h"
+ #include "esp_heap_caps.h"
+
+ using std::isinf;
+ using std::isnan;
+ using std::max;
+ using std::min;
+
+ typedef uint8_t byte;
+ typedef bool boolean;
+
+ #define LOW 0x0
+ #define HIGH 0x1
+ #define INPUT 0x01
+ #define OUTPUT 0x03
+ #define PULLUP 0x04
+ #define INPUT_PULLUP 0x05
+ #define PULLDOWN 0x08
+ #define INPUT_PULLDOWN 0x09
+ #define OPEN_DRAIN 0x10
+ #define OUTPUT_OPEN_DRAIN 0x13
+ #define RISING 0x01
+ #define FALLING 0x02
+ #define CHANGE 0x03
+
+ #define IRAM_ATTR
+ #define F(text) (text)
+ #define PROGMEM
+
+ #define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+ #define isDigit(c) (isdigit(static_cast<unsigned char>(c)) != 0)
+ #define isAlpha(c) (isalpha(static_cast<unsigned char>(c)) != 0)
+ #define isSpace(c) (isspace(static_cast<unsigned char>(c)) != 0)
+ #define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+
+ unsigned long millis();
+ unsigned long micros();
+ void delay(uint32_t ms);
+ void delayMicroseconds(uint32_t us);
+ void yield();
+
+ void pinMode(uint8_t pin, uint8_t mode);
+ void digitalWrite(uint8_t pin, uint8_t level);
+ int digitalRead(uint8_t pin);
+
+ #define digitalPinToInterrupt(pin) (pin)
+
+ /**
+  * @brief Run a handler on an edge of an input pin
+  * Edges come from Sim::setPinLevel(); the handler runs on the thread that
+  * drives the pin, standing in for the GPIO interrupt.
+  */
+ void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode);
+ void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+ void detachInterrupt(uint8_t pin);
+
+ long random(long max);
+ long random(long min, long max);
+ void randomSeed(unsigned long seed);
+ long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+ void* ps_malloc(size_t size);
+ bool psramFound();
+
+ /**
+  * @brief Chip information and control
+  * Heap figures are those of 320 KB of internal RAM and 2 MB of PSRAM,
+  * the QT Py ESP32-S3 N4R2, less what the process has allocated.
+  */
+ class EspClass {
+ public:
+     uint32_t getHeapSize();
+     uint32_t getFreeHeap();
+     uint32_t getMinFreeHeap();
+     uint32_t getMaxAllocHeap();
+     uint32_t getPsramSize();
+     uint32_t getFreePsram();
+     uint32_t getCpuFreqMHz() { return 240; }
+     uint32_t getCycleCount();
+     uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+     const char* getChipModel() { return "ESP32-S3 (simulated)"; }
+
+     /**
+      * @brief Record a restart request and stop the calling task
+      * See Sim::restartRequests().
+      */
+     [[noreturn]] void restart();
+ };
+
+ extern EspClass ESP;
+
+ /**
+  * @brief Start SNTP; the simulation has no network, so it never syncs
+  */
+ inline void configTime(long gmtOffset, int daylightOffset, const char* server1, const char* server2 = nullptr,
+                        const char* server3 = nullptr) {}
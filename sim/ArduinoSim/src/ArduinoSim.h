@@ -0,0 +1,124 @@
+/**
+ * @file ArduinoSim.h
+ * @brief Control interface of the host simulation: clock, randomness and storage
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup simulation Host Simulation
+ * @brief Arduino, FreeRTOS and ESP-IDF on a PC, with simulated buses and sensors
+ * @{
+ *
+ * The native environments build the firmware sources against this library
+ * instead of the ESP32 framework. Everything the firmware sees as time —
+ * millis(), micros(), esp_timer_get_time(), ticks, delays and timeouts — is
+ * simulated time, which runs at a configurable multiple of wall-clock
+ * time. At a scale of 10 an hour of acquisition takes six minutes.
+ *
+ * The scale is a rate, not a virtual clock: tasks still run on host
+ * threads and their CPU time is not scaled. Pick a scale at which the
+ * host keeps up with the simulated load; past that the firmware sees its
+ * own code as 'scale' times slower than on the chip and acquisition falls
+ * behind, which is the point at which a load test stops meaning anything.
+ */
+
+ #pragma once
+
+ #include <chrono>
+ #include <cstdint>
+ #include <string>
+
+ namespace Sim {
+
+     /**
+      * @brief Set how fast simulated time runs
+      * Takes effect immediately; simulated time stays continuous.
+      * @param scale Simulated seconds per wall-clock second, > 0
+      */
+     void setTimeScale(double scale);
+
+     /**
+      * @brief Get the current time scale
+      * @return Simulated seconds per wall-clock second
+      */
+     double getTimeScale();
+
+     /**
+      * @brief Simulated time since start
+      * @return Microseconds
+      */
+     uint64_t nowUs();
+
+     /**
+      * @brief Block the calling thread for a span of simulated time
+      * @param us Simulated microseconds
+      */
+     void sleepUs(uint64_t us);
+
+     /**
+      * @brief Convert a span of simulated time to wall-clock time
+      * @param us Simulated microseconds
+      * @return Host duration to wait
+      */
+     std::chrono::steady_clock::duration toHostDuration(uint64_t us);
+
+     /**
+      * @brief Seed the noise of every simulated device
+      * Devices attached after the call draw from streams derived from the
+      * seed, so a run with the same seed and topology is repeatable.
+      * @param seed Seed value
+      */
+     void setSeed(uint32_t seed);
+
+     /**
+      * @brief Get the seed in use
+      * @return Seed value
+      */
+     uint32_t getSeed();
+
+     /**
+      * @brief Erase the simulated flash file system and NVS
+      * Use between tests that must not see each other's configuration.
+      */
+     void resetStorage();
+
+     /**
+      * @brief Create or replace a file in the simulated LittleFS
+      * @param path Absolute path, e.g. "/config.json"
+      * @param contents File contents
+      */
+     void writeFile(const char* path, const std::string& contents);
+
+     /**
+      * @brief Read a file from the simulated LittleFS
+      * @param path Absolute path
+      * @param contents [out] File contents
+      * @return true if the file exists
+      */
+     bool readFile(const char* path, std::string& contents);
+
+     /**
+      * @brief Drive an input pin from outside the firmware
+      * Runs the interrupt handler attached to the pin if the change is an
+      * edge it asked for.
+      * @param pin GPIO number
+      * @param level LOW or HIGH
+      */
+     void setPinLevel(uint8_t pin, uint8_t level);
+
+     /**
+      * @brief Whether ESP.restart() has been called
+      * The simulation cannot reboot; it records the request and the caller
+      * decides whether to tear down and start again.
+      * @return Number of restart requests so far
+      */
+     uint32_t restartRequests();
+
+     /**
+      * @brief End the process without running static destructors
+      * Firmware tasks never return, so they would still be using globals
+      * while exit() tore them down.
+      * @param exitCode Process exit status
+      */
+     [[noreturn]] void shutdown(int exitCode);
+ }
+
+/** @} */
@@ -0,0 +1,95 @@
+#include "HardwareSerial.h"
+#include "ArduinoSim.h"
+
+HardwareSerial Serial(0, HardwareSerial::Sink::STDOUT);
+HardwareSerial Serial2(2, HardwareSerial::Sink::DISCARD);
+
+HardwareSerial::HardwareSerial(int uartNumber, Sink sink) : uart(uartNumber), outputSink(sink) {}
+
+void HardwareSerial::onReceive(std::function<void(void)> callback, bool onlyOnTimeout) {
+    std::lock_guard<std::mutex> lock(mutex);
+    receiveCallback = callback;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    written += size;
+    switch (outputSink) {
+        case Sink::STDOUT:
+            fwrite(buffer, 1, size, stdout);
+            break;
+        case Sink::CAPTURE:
+            captured.append(reinterpret_cast<const char*>(buffer), size);
+            outputChanged.notify_all();
+            break;
+        case Sink::DISCARD:
+            break;
+    }
+    return size;
+}
+
+void HardwareSerial::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (outputSink == Sink::STDOUT) {
+        fflush(stdout);
+    }
+}
+
+int HardwareSerial::available() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(input.size());
+}
+
+int HardwareSerial::read() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (input.empty()) {
+        return -1;
+    }
+    uint8_t c = input.front();
+    input.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return input.empty() ? -1 : input.front();
+}
+
+void HardwareSerial::setSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (outputSink == Sink::STDOUT) {
+        fflush(stdout);
+    }
+    outputSink = sink;
+}
+
+void HardwareSerial::inject(const char* data, size_t length) {
+    std::function<void(void)> callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        input.insert(input.end(), data, data + length);
+        callback = receiveCallback;
+    }
+    // The UART driver calls back from its own task, never with the port locked
+    if (callback) {
+        callback();
+    }
+}
+
+std::string HardwareSerial::takeOutput() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string out;
+    out.swap(captured);
+    return out;
+}
+
+bool HardwareSerial::waitForOutput(const std::string& text, uint32_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto deadline = std::chrono::steady_clock::now() + Sim::toHostDuration(static_cast<uint64_t>(timeoutMs) * 1000);
+    return outputChanged.wait_until(lock, deadline, [&] { return captured.find(text) != std::string::npos; });
+}
+
+uint64_t HardwareSerial::bytesWritten() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return written;
+}
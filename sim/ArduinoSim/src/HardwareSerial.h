@@ -0,0 +1,106 @@
+/**
+ * @file HardwareSerial.h
+ * @brief Serial ports of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Serial is the command port and writes to stdout by default; Serial2,
+ * the UART debug log, is discarded unless routed. A test drives the SCPI
+ * interface by injecting input and capturing the replies:
+ *
+ *     Serial.setSink(HardwareSerial::Sink::CAPTURE);
+ *     Serial.inject("*IDN?\n");
+ *     ...
+ *     std::string reply = Serial.takeOutput();
+ *
+ * Injected input raises the onReceive() callback like the UART driver.
+ */
+
+ #pragma once
+
+ #include <condition_variable>
+ #include <cstdio>
+ #include <deque>
+ #include <functional>
+ #include <mutex>
+ #include <string>
+ #include "Print.h"
+
+ #define SERIAL_8N1 0x800001c
+
+ class HardwareSerial : public Stream {
+ public:
+     /**
+      * @brief Where written bytes go
+      */
+     enum class Sink {
+         STDOUT,    ///< Host standard output
+         DISCARD,   ///< Dropped, counted in bytesWritten()
+         CAPTURE    ///< Kept for takeOutput()
+     };
+
+     HardwareSerial(int uartNumber, Sink sink);
+
+     void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {}
+     void end() {}
+     void setRxBufferSize(size_t size) {}
+     void onReceive(std::function<void(void)> callback, bool onlyOnTimeout = false);
+     operator bool() const { return true; }
+
+     size_t write(uint8_t c) override { return write(&c, 1); }
+     size_t write(const uint8_t* buffer, size_t size) override;
+     using Print::write;
+     int availableForWrite() override { return 1024; }
+     void flush() override;
+
+     int available() override;
+     int read() override;
+     int peek() override;
+
+     /**
+      * @brief Route the output of this port
+      * @param sink New destination
+      */
+     void setSink(Sink sink);
+
+     /**
+      * @brief Deliver bytes as if the host had sent them
+      * @param data Bytes to receive
+      * @param length Number of bytes
+      */
+     void inject(const char* data, size_t length);
+     void inject(const std::string& data) { inject(data.data(), data.size()); }
+
+     /**
+      * @brief Take everything captured since the last call
+      * @return Captured output
+      */
+     std::string takeOutput();
+
+     /**
+      * @brief Wait until captured output contains a text
+      * @param text Text to look for
+      * @param timeoutMs Simulated milliseconds to wait
+      * @return true if it arrived in time; the output is kept either way
+      */
+     bool waitForOutput(const std::string& text, uint32_t timeoutMs);
+
+     /**
+      * @brief Bytes written since start, whatever the sink
+      */
+     uint64_t bytesWritten() const;
+
+ private:
+     int uart;
+     Sink outputSink;
+     std::string captured;
+     uint64_t written = 0;
+     std::deque<uint8_t> input;
+     std::function<void(void)> receiveCallback;
+     mutable std::mutex mutex;
+     std::condition_variable outputChanged;
+ };
+
+ extern HardwareSerial Serial;
+ extern HardwareSerial Serial2;
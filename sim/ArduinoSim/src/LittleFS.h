@@ -0,0 +1,78 @@
+/**
+ * @file LittleFS.h
+ * @brief Flash file system of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Files are kept in process memory. Sim::writeFile() seeds a config.json
+ * before the firmware starts; rename() replaces its target like LittleFS.
+ */
+
+ #pragma once
+
+ #include <memory>
+ #include <string>
+ #include "Arduino.h"
+
+ namespace fs {
+     struct FileData;
+ }
+
+ class File : public Stream {
+ public:
+     File() = default;
+
+     operator bool() const { return data != nullptr; }
+     void close();
+     size_t size() const;
+     size_t position() const { return offset; }
+     bool seek(uint32_t position);
+     const char* name() const;
+
+     size_t write(uint8_t c) override { return write(&c, 1); }
+     size_t write(const uint8_t* buffer, size_t size) override;
+     using Print::write;
+     int available() override;
+     int read() override;
+     int peek() override;
+     size_t read(uint8_t* buffer, size_t size);
+
+     /**
+      * @brief Read what is left, up to a length, without waiting at the end
+      */
+     size_t readBytes(char* buffer, size_t length) override { return read(reinterpret_cast<uint8_t*>(buffer), length); }
+     using Stream::readBytes;
+     void flush() override {}
+
+ private:
+     friend class LittleFSFS;
+     File(std::shared_ptr<fs::FileData> file, bool writable) : data(std::move(file)), canWrite(writable) {}
+
+     std::shared_ptr<fs::FileData> data;
+     size_t offset = 0;
+     bool canWrite = false;
+ };
+
+ class LittleFSFS {
+ public:
+     bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+                const char* partitionLabel = "spiffs");
+     void end() {}
+     bool format();
+
+     File open(const char* path, const char* mode = "r", bool create = false);
+     File open(const String& path, const char* mode = "r", bool create = false) {
+         return open(path.c_str(), mode, create);
+     }
+     bool exists(const char* path);
+     bool exists(const String& path) { return exists(path.c_str()); }
+     bool remove(const char* path);
+     bool remove(const String& path) { return remove(path.c_str()); }
+     bool rename(const char* from, const char* to);
+     bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
+     size_t totalBytes() { return 1024 * 1024; }
+     size_t usedBytes();
+ };
+
+ extern LittleFSFS LittleFS;
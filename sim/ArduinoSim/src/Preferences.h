@@ -0,0 +1,38 @@
+/**
+ * @file Preferences.h
+ * @brief NVS key-value storage of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Namespaces live in process memory and survive end()/begin(), like NVS
+ * across a reboot; Sim::resetStorage() erases them.
+ */
+
+ #pragma once
+
+ #include "Arduino.h"
+
+ class Preferences {
+ public:
+     bool begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+     void end();
+
+     bool clear();
+     bool remove(const char* key);
+     bool isKey(const char* key);
+
+     size_t putBytes(const char* key, const void* value, size_t length);
+     size_t getBytesLength(const char* key);
+     size_t getBytes(const char* key, void* buffer, size_t maxLength);
+
+     size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+     uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+     size_t putString(const char* key, const String& value) { return putBytes(key, value.c_str(), value.length()); }
+     String getString(const char* key, const String& defaultValue = String());
+
+ private:
+     String space;
+     bool opened = false;
+     bool readOnlyMode = false;
+ };
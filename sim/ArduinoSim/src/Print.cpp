@@ -0,0 +1,123 @@
+#include "Print.h"
+#include "ArduinoSim.h"
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <vector>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (write(*buffer++) == 0) {
+            break;
+        }
+        n++;
+    }
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char stackBuffer[128];
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(stackBuffer, sizeof(stackBuffer), format, copy);
+    va_end(copy);
+    if (length < 0) {
+        va_end(args);
+        return 0;
+    }
+    if (static_cast<size_t>(length) < sizeof(stackBuffer)) {
+        va_end(args);
+        return write(stackBuffer, length);
+    }
+    std::vector<char> heapBuffer(length + 1);
+    vsnprintf(heapBuffer.data(), heapBuffer.size(), format, args);
+    va_end(args);
+    return write(heapBuffer.data(), length);
+}
+
+size_t Print::print(long number, int base) {
+    return print(String(number, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(unsigned long number, int base) {
+    return print(String(number, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(long long number, int base) {
+    return print(String(number, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(unsigned long long number, int base) {
+    return print(String(number, static_cast<unsigned char>(base)));
+}
+
+size_t Print::print(double number, int decimals) {
+    // Same special cases as the core's printFloat
+    if (std::isnan(number)) {
+        return print("nan");
+    }
+    if (std::isinf(number)) {
+        return print("inf");
+    }
+    if (number > 4294967040.0 || number < -4294967040.0) {
+        return print("ovf");
+    }
+    return print(String(number, static_cast<unsigned int>(decimals)));
+}
+
+int Stream::timedRead() {
+    uint64_t deadline = Sim::nowUs() + static_cast<uint64_t>(timeoutMs) * 1000;
+    do {
+        int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        Sim::sleepUs(1000);
+    } while (Sim::nowUs() < deadline);
+    return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0 || c == terminator) {
+            break;
+        }
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+String Stream::readString() {
+    String text;
+    int c;
+    while ((c = timedRead()) >= 0) {
+        text += static_cast<char>(c);
+    }
+    return text;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String text;
+    int c;
+    while ((c = timedRead()) >= 0 && c != terminator) {
+        text += static_cast<char>(c);
+    }
+    return text;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file Print.h
+ * @brief Arduino Print and Stream for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <cstring>
+ #include "WString.h"
+
+ class Print {
+ public:
+     virtual ~Print() = default;
+
+     virtual size_t write(uint8_t c) = 0;
+     virtual size_t write(const uint8_t* buffer, size_t size);
+     size_t write(const char* text) { return text ? write(reinterpret_cast<const uint8_t*>(text), strlen(text)) : 0; }
+     size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+     virtual int availableForWrite() { return 0; }
+     virtual void flush() {}
+
+     size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+     size_t print(const String& text) { return write(text.c_str(), text.length()); }
+     size_t print(const char* text) { return write(text); }
+     size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+     size_t print(unsigned char number, int base = DEC) { return print(static_cast<unsigned long>(number), base); }
+     size_t print(int number, int base = DEC) { return print(static_cast<long>(number), base); }
+     size_t print(unsigned int number, int base = DEC) { return print(static_cast<unsigned long>(number), base); }
+     size_t print(long number, int base = DEC);
+     size_t print(unsigned long number, int base = DEC);
+     size_t print(long long number, int base = DEC);
+     size_t print(unsigned long long number, int base = DEC);
+     size_t print(double number, int decimals = 2);
+
+     template <typename T>
+     size_t println(const T& value) {
+         size_t n = print(value);
+         return n + println();
+     }
+     template <typename T>
+     size_t println(const T& value, int format) {
+         size_t n = print(value, format);
+         return n + println();
+     }
+     size_t println() { return write("\r\n"); }
+ };
+
+ class Stream : public Print {
+ public:
+     virtual int available() = 0;
+     virtual int read() = 0;
+     virtual int peek() = 0;
+
+     /**
+      * @brief Set how long blocking reads wait, in simulated milliseconds
+      */
+     void setTimeout(unsigned long ms) { timeoutMs = ms; }
+     unsigned long getTimeout() const { return timeoutMs; }
+
+     virtual size_t readBytes(char* buffer, size_t length);
+     size_t readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); }
+     size_t readBytesUntil(char terminator, char* buffer, size_t length);
+     String readString();
+     String readStringUntil(char terminator);
+
+ protected:
+     /**
+      * @brief Read one byte, waiting up to the timeout
+      * @return The byte, or -1 on timeout
+      */
+     int timedRead();
+
+     unsigned long timeoutMs = 1000;
+ };
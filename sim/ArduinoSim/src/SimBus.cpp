@@ -0,0 +1,387 @@
+#include "SimDevices.h"
+#include "ArduinoSim.h"
+#include "Wire.h"
+#include "driver/spi_master.h"
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <vector>
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+namespace {
+    constexpr int BUS_COUNT = 2;
+    constexpr int MUX_CHANNELS = 8;
+    constexpr uint32_t BITS_PER_BYTE = 9;   ///< Eight data bits and the acknowledge
+
+    /**
+     * @brief What is wired to one I2C bus
+     */
+    struct Bus {
+        std::mutex mutex;                                   ///< Held for a whole transfer
+        std::vector<Sim::I2CDevice*> direct;                ///< Devices on the bus itself
+        Sim::Tca9548a* mux = nullptr;
+        bool ownsMux = false;
+        std::vector<Sim::I2CDevice*> channels[MUX_CHANNELS];
+    };
+
+    Bus buses[BUS_COUNT];
+
+    std::mutex spiMutex;
+    std::map<int, Sim::SpiDevice*> spiDevices;              ///< By chip select pin
+
+    /**
+     * @brief The device answering an address, with the mux channels as selected now
+     * Caller holds the bus mutex.
+     */
+    Sim::I2CDevice* findDevice(Bus& bus, uint16_t address) {
+        for (Sim::I2CDevice* device : bus.direct) {
+            if (device->getAddress() == address) {
+                return device;
+            }
+        }
+        if (!bus.mux || !bus.mux->isOnline()) {
+            return nullptr;
+        }
+        uint8_t mask = bus.mux->getChannelMask();
+        for (int channel = 0; channel < MUX_CHANNELS; channel++) {
+            if (!(mask & (1 << channel))) {
+                continue;
+            }
+            for (Sim::I2CDevice* device : bus.channels[channel]) {
+                if (device->getAddress() == address) {
+                    return device;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void chargeI2C(uint32_t clockHz, size_t bytes, uint32_t latencyUs) {
+        uint64_t wireUs = static_cast<uint64_t>(bytes) * BITS_PER_BYTE * 1000000ULL / std::max<uint32_t>(clockHz, 1);
+        Sim::sleepUs(wireUs + latencyUs);
+    }
+
+    void eraseFrom(std::vector<Sim::I2CDevice*>& list, Sim::Device* device) {
+        list.erase(std::remove(list.begin(), list.end(), device), list.end());
+    }
+}
+
+namespace Sim {
+    void attachI2C(int bus, I2CDevice* device, int muxChannel) {
+        if (bus < 0 || bus >= BUS_COUNT || !device || muxChannel >= MUX_CHANNELS) {
+            return;
+        }
+        Bus& b = buses[bus];
+        std::lock_guard<std::mutex> lock(b.mutex);
+        if (muxChannel < 0) {
+            b.direct.push_back(device);
+            if (auto* mux = dynamic_cast<Tca9548a*>(device)) {
+                if (b.ownsMux) {
+                    eraseFrom(b.direct, b.mux);
+                    delete b.mux;
+                }
+                b.mux = mux;
+                b.ownsMux = false;
+            }
+            return;
+        }
+        if (!b.mux) {
+            b.mux = new Tca9548a();
+            b.ownsMux = true;
+            b.direct.push_back(b.mux);
+        }
+        b.channels[muxChannel].push_back(device);
+    }
+
+    void attachSpi(int csPin, SpiDevice* device) {
+        std::lock_guard<std::mutex> lock(spiMutex);
+        spiDevices[csPin] = device;
+    }
+
+    void detach(Device* device) {
+        for (Bus& b : buses) {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            eraseFrom(b.direct, device);
+            for (auto& channel : b.channels) {
+                eraseFrom(channel, device);
+            }
+            if (b.mux == device) {
+                b.mux = nullptr;
+                b.ownsMux = false;
+            }
+        }
+        std::lock_guard<std::mutex> lock(spiMutex);
+        for (auto it = spiDevices.begin(); it != spiDevices.end();) {
+            it = it->second == device ? spiDevices.erase(it) : std::next(it);
+        }
+    }
+
+    void detachAll() {
+        for (Bus& b : buses) {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            if (b.ownsMux) {
+                delete b.mux;
+            }
+            b.mux = nullptr;
+            b.ownsMux = false;
+            b.direct.clear();
+            for (auto& channel : b.channels) {
+                channel.clear();
+            }
+        }
+        std::lock_guard<std::mutex> lock(spiMutex);
+        spiDevices.clear();
+    }
+
+    Tca9548a* getMux(int bus) {
+        if (bus < 0 || bus >= BUS_COUNT) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(buses[bus].mutex);
+        return buses[bus].mux;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// TwoWire
+// ---------------------------------------------------------------------------
+
+TwoWire::TwoWire(uint8_t busNum) : bus(busNum) {}
+
+bool TwoWire::begin(int sdaPin, int sclPin, uint32_t frequency) {
+    if (frequency != 0) {
+        clockHz = frequency;
+    }
+    started = true;
+    return true;
+}
+
+bool TwoWire::end() {
+    started = false;
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+    if (frequency == 0) {
+        return false;
+    }
+    clockHz = frequency;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint16_t address) {
+    txAddress = address;
+    txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+    if (txLength >= I2C_BUFFER_LENGTH) {
+        return 0;
+    }
+    txBuffer[txLength++] = c;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written])) {
+        written++;
+    }
+    return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    if (!started || bus >= BUS_COUNT) {
+        return 4;
+    }
+    Bus& b = buses[bus];
+    std::lock_guard<std::mutex> lock(b.mutex);
+    Sim::I2CDevice* device = findDevice(b, txAddress);
+    if (!device || !device->isOnline()) {
+        chargeI2C(clockHz, 1, 0);
+        return 2;
+    }
+    Sim::DeviceStats& stats = device->stats();
+    stats.transactions++;
+    if (device->rollNack()) {
+        stats.nacks++;
+        chargeI2C(clockHz, 1, 0);
+        return 2;
+    }
+    chargeI2C(clockHz, 1 + txLength, device->getLatencyUs());
+    if (!device->onWrite(txBuffer, txLength)) {
+        stats.nacks++;
+        return 3;
+    }
+    stats.bytesWritten += static_cast<uint32_t>(txLength);
+    return 0;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop) {
+    rxLength = 0;
+    rxIndex = 0;
+    if (!started || bus >= BUS_COUNT || size == 0) {
+        return 0;
+    }
+    size = std::min<size_t>(size, I2C_BUFFER_LENGTH);
+    Bus& b = buses[bus];
+    std::lock_guard<std::mutex> lock(b.mutex);
+    Sim::I2CDevice* device = findDevice(b, address);
+    if (!device || !device->isOnline()) {
+        chargeI2C(clockHz, 1, 0);
+        return 0;
+    }
+    Sim::DeviceStats& stats = device->stats();
+    stats.transactions++;
+    if (device->rollNack() || !device->onRead(rxBuffer, size)) {
+        stats.nacks++;
+        chargeI2C(clockHz, 1, 0);
+        return 0;
+    }
+    chargeI2C(clockHz, 1 + size, device->getLatencyUs());
+    stats.bytesRead += static_cast<uint32_t>(size);
+    rxLength = size;
+    return size;
+}
+
+// ---------------------------------------------------------------------------
+// SPI master driver
+// ---------------------------------------------------------------------------
+
+struct spi_device_t {
+    spi_host_device_t host;
+    int csPin;
+    uint32_t clockHz;
+    std::deque<spi_transaction_t*> pending;   ///< Queued, run when collected
+};
+
+namespace {
+    bool hostInitialized[3] = {};
+
+    void runTransaction(spi_device_t* handle, spi_transaction_t* transaction) {
+        size_t bytes = (transaction->length + 7) / 8;
+        const uint8_t* tx = (transaction->flags & SPI_TRANS_USE_TXDATA)
+                                ? transaction->tx_data
+                                : static_cast<const uint8_t*>(transaction->tx_buffer);
+        uint8_t* rx = (transaction->flags & SPI_TRANS_USE_RXDATA)
+                          ? transaction->rx_data
+                          : static_cast<uint8_t*>(transaction->rx_buffer);
+        std::vector<uint8_t> scratch;
+        if (!tx) {
+            scratch.assign(bytes, 0);
+            tx = scratch.data();
+        }
+        std::vector<uint8_t> discard;
+        if (!rx) {
+            discard.resize(bytes);
+            rx = discard.data();
+        }
+
+        Sim::SpiDevice* device = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(spiMutex);
+            auto it = spiDevices.find(handle->csPin);
+            if (it != spiDevices.end()) {
+                device = it->second;
+            }
+        }
+        uint64_t wireUs = static_cast<uint64_t>(bytes) * 8 * 1000000ULL / std::max<uint32_t>(handle->clockHz, 1);
+        if (!device || !device->isOnline()) {
+            // Nothing drives MISO, which floats high
+            memset(rx, 0xFF, bytes);
+            Sim::sleepUs(wireUs);
+            return;
+        }
+        Sim::DeviceStats& stats = device->stats();
+        stats.transactions++;
+        Sim::sleepUs(wireUs + device->getLatencyUs());
+        if (device->rollNack()) {
+            // SPI has no acknowledge; a glitched chip select reads as an idle bus
+            stats.nacks++;
+            memset(rx, 0xFF, bytes);
+            return;
+        }
+        device->transfer(tx, rx, bytes);
+        stats.bytesWritten += static_cast<uint32_t>(bytes);
+        stats.bytesRead += static_cast<uint32_t>(bytes);
+    }
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dmaChannel) {
+    if (host < SPI1_HOST || host > SPI3_HOST || !config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (hostInitialized[host]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    hostInitialized[host] = true;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host) {
+    if (host < SPI1_HOST || host > SPI3_HOST || !hostInitialized[host]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    hostInitialized[host] = false;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config,
+                             spi_device_handle_t* handle) {
+    if (host < SPI1_HOST || host > SPI3_HOST || !config || !handle || config->clock_speed_hz <= 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!hostInitialized[host]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *handle = new spi_device_t{host, config->spics_io_num, static_cast<uint32_t>(config->clock_speed_hz), {}};
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!handle->pending.empty()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    delete handle;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* transaction, TickType_t ticks) {
+    if (!handle || !transaction) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    handle->pending.push_back(transaction);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** transaction, TickType_t ticks) {
+    if (!handle || !transaction) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->pending.empty()) {
+        return ESP_ERR_TIMEOUT;
+    }
+    spi_transaction_t* done = handle->pending.front();
+    handle->pending.pop_front();
+    runTransaction(handle, done);
+    *transaction = done;
+    return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* transaction) {
+    esp_err_t result = spi_device_queue_trans(handle, transaction, portMAX_DELAY);
+    if (result != ESP_OK) {
+        return result;
+    }
+    spi_transaction_t* done = nullptr;
+    return spi_device_get_trans_result(handle, &done, portMAX_DELAY);
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* transaction) {
+    return spi_device_transmit(handle, transaction);
+}
@@ -0,0 +1,108 @@
+#include "ArduinoSim.h"
+#include "Arduino.h"
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include <mutex>
+#include <thread>
+
+namespace {
+    /**
+     * @brief Simulated time as a piecewise-linear function of host time
+     * Each scale change starts a new segment at the current simulated time.
+     */
+    struct Clock {
+        std::mutex mutex;
+        std::chrono::steady_clock::time_point hostAnchor = std::chrono::steady_clock::now();
+        uint64_t simAnchorUs = 0;
+        double scale = 1.0;
+    };
+
+    Clock& simClock() {
+        static Clock instance;
+        return instance;
+    }
+
+    uint64_t simulatedAt(const Clock& c, std::chrono::steady_clock::time_point host) {
+        double elapsedUs = std::chrono::duration<double, std::micro>(host - c.hostAnchor).count();
+        return c.simAnchorUs + static_cast<uint64_t>(elapsedUs * c.scale);
+    }
+
+    std::atomic<uint32_t> seed{1};
+}
+
+namespace Sim {
+    void setTimeScale(double scale) {
+        if (!(scale > 0.0)) {
+            return;
+        }
+        Clock& c = simClock();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        auto host = std::chrono::steady_clock::now();
+        c.simAnchorUs = simulatedAt(c, host);
+        c.hostAnchor = host;
+        c.scale = scale;
+    }
+
+    double getTimeScale() {
+        Clock& c = simClock();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return c.scale;
+    }
+
+    uint64_t nowUs() {
+        Clock& c = simClock();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return simulatedAt(c, std::chrono::steady_clock::now());
+    }
+
+    std::chrono::steady_clock::duration toHostDuration(uint64_t us) {
+        double hostUs = static_cast<double>(us) / getTimeScale();
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::micro>(hostUs));
+    }
+
+    void sleepUs(uint64_t us) {
+        if (us == 0) {
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(toHostDuration(us));
+    }
+
+    void setSeed(uint32_t value) {
+        seed = value;
+    }
+
+    uint32_t getSeed() {
+        return seed;
+    }
+}
+
+// unsigned long is 64 bits on the host, so these do not wrap like on the chip
+unsigned long millis() {
+    return static_cast<unsigned long>(Sim::nowUs() / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(Sim::nowUs());
+}
+
+void delay(uint32_t ms) {
+    Sim::sleepUs(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+    Sim::sleepUs(us);
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+int64_t esp_timer_get_time() {
+    return static_cast<int64_t>(Sim::nowUs());
+}
+
+uint32_t esp_cpu_get_cycle_count() {
+    return static_cast<uint32_t>(Sim::nowUs() * ESP.getCpuFreqMHz());
+}
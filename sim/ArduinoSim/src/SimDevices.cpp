@@ -0,0 +1,383 @@
+#include "SimDevices.h"
+#include "ArduinoSim.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    std::atomic<uint32_t> deviceCount{0};
+
+    uint8_t crc8(const uint8_t* data, size_t length, uint8_t init) {
+        uint8_t crc = init;
+        for (size_t i = 0; i < length; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x31) : static_cast<uint8_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    uint16_t clampCode(double code) {
+        return static_cast<uint16_t>(std::min(65535.0, std::max(0.0, code)));
+    }
+}
+
+namespace Sim {
+
+    // -----------------------------------------------------------------------
+    // Device
+    // -----------------------------------------------------------------------
+
+    Device::Device() : rng(getSeed() * 7919u + deviceCount.fetch_add(1)) {}
+
+    bool Device::rollNack() {
+        float rate = nackRate;
+        if (rate <= 0.0f) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return std::uniform_real_distribution<float>(0.0f, 1.0f)(rng) < rate;
+    }
+
+    float Device::noise(float sigma) {
+        // Caller holds stateMutex
+        if (sigma <= 0.0f) {
+            return 0.0f;
+        }
+        return std::normal_distribution<float>(0.0f, sigma)(rng);
+    }
+
+    uint64_t Device::now() {
+        return nowUs();
+    }
+
+    // -----------------------------------------------------------------------
+    // TCA9548A
+    // -----------------------------------------------------------------------
+
+    bool Tca9548a::onWrite(const uint8_t* data, size_t length) {
+        // The control register takes the last byte of a write
+        if (length > 0) {
+            channelMask = data[length - 1];
+        }
+        return true;
+    }
+
+    bool Tca9548a::onRead(uint8_t* data, size_t length) {
+        memset(data, channelMask, length);
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    // Climate sensors
+    // -----------------------------------------------------------------------
+
+    ClimateDevice::ClimateDevice(uint8_t i2cAddress) : I2CDevice(i2cAddress) {}
+
+    void ClimateDevice::setTemperature(float celsius) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        temperature = celsius;
+    }
+
+    void ClimateDevice::setHumidity(float percent) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        humidity = percent;
+    }
+
+    void ClimateDevice::setNoise(float temperatureSigma, float humiditySigma) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        temperatureNoise = temperatureSigma;
+        humidityNoise = humiditySigma;
+    }
+
+    void ClimateDevice::sample(float& celsius, float& percent) {
+        // Caller holds stateMutex
+        celsius = temperature + noise(temperatureNoise);
+        percent = std::min(100.0f, std::max(0.0f, humidity + noise(humidityNoise)));
+    }
+
+    uint8_t Sht4x::crc8(const uint8_t* data, size_t length) {
+        return ::crc8(data, length, 0xFF);
+    }
+
+    bool Sht4x::onWrite(const uint8_t* data, size_t length) {
+        if (length == 0) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(stateMutex);
+        uint64_t at = now();
+        if (at < readyAtUs) {
+            return false;   // Busy measuring: address NACKed
+        }
+
+        uint32_t durationUs;
+        switch (data[0]) {
+            case 0xFD: durationUs = 8300; break;      // High precision
+            case 0xF6: durationUs = 4500; break;      // Medium precision
+            case 0xE0: durationUs = 1700; break;      // Low precision
+            case 0x39: case 0x2F: case 0x1E:          // Heater 1 s, then a high precision measurement
+                durationUs = 1100000; break;
+            case 0x32: case 0x24: case 0x15:          // Heater 0.1 s
+                durationUs = 110000; break;
+            case 0x94:                                // Soft reset
+                responseLength = 0;
+                readyAtUs = at + 1000;
+                return true;
+            case 0x89: {                              // Serial number
+                uint16_t words[2] = {static_cast<uint16_t>(0x0F00 | getAddress()), 0x4171};
+                for (int i = 0; i < 2; i++) {
+                    response[i * 3] = words[i] >> 8;
+                    response[i * 3 + 1] = words[i] & 0xFF;
+                    response[i * 3 + 2] = crc8(&response[i * 3], 2);
+                }
+                responseLength = 6;
+                readyAtUs = at + 200;
+                return true;
+            }
+            default:
+                return false;
+        }
+
+        float celsius;
+        float percent;
+        sample(celsius, percent);
+        uint16_t words[2] = {clampCode((celsius + 45.0) * 65535.0 / 175.0),
+                             clampCode((percent + 6.0) * 65535.0 / 125.0)};
+        for (int i = 0; i < 2; i++) {
+            response[i * 3] = words[i] >> 8;
+            response[i * 3 + 1] = words[i] & 0xFF;
+            response[i * 3 + 2] = crc8(&response[i * 3], 2);
+        }
+        responseLength = 6;
+        readyAtUs = at + durationUs;
+        return true;
+    }
+
+    bool Sht4x::onRead(uint8_t* data, size_t length) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (now() < readyAtUs || responseLength == 0) {
+            return false;
+        }
+        size_t n = std::min(length, responseLength);
+        memcpy(data, response, n);
+        memset(data + n, 0xFF, length - n);
+        responseLength = 0;
+        return true;
+    }
+
+    uint8_t Si7021::crc8(const uint8_t* data, size_t length) {
+        return ::crc8(data, length, 0x00);
+    }
+
+    void Si7021::respondWord(uint16_t word, bool withCrc) {
+        response[responseLength] = word >> 8;
+        response[responseLength + 1] = word & 0xFF;
+        responseLength += 2;
+        if (withCrc) {
+            response[responseLength] = crc8(&response[responseLength - 2], 2);
+            responseLength++;
+        }
+    }
+
+    bool Si7021::onWrite(const uint8_t* data, size_t length) {
+        if (length == 0) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(stateMutex);
+        uint64_t at = now();
+        if (at < readyAtUs) {
+            return false;
+        }
+        responseLength = 0;
+
+        float celsius;
+        float percent;
+        switch (data[0]) {
+            case 0xF5:          // RH, no hold; also converts temperature
+            case 0xE5: {        // RH, hold master, served the same way
+                sample(celsius, percent);
+                lastTemperatureCode = clampCode((celsius + 46.85) * 65536.0 / 175.72) & 0xFFFC;
+                respondWord(clampCode((percent + 6.0) * 65536.0 / 125.0) & 0xFFFC, true);
+                readyAtUs = at + 20000;
+                return true;
+            }
+            case 0xF3:
+            case 0xE3:
+                sample(celsius, percent);
+                lastTemperatureCode = clampCode((celsius + 46.85) * 65536.0 / 175.72) & 0xFFFC;
+                respondWord(lastTemperatureCode, true);
+                readyAtUs = at + 7000;
+                return true;
+            case 0xE0:          // Temperature of the last RH conversion, no CRC
+                respondWord(lastTemperatureCode, false);
+                return true;
+            case 0xFE:
+                userRegister = 0x3A;
+                readyAtUs = at + 15000;
+                return true;
+            case 0xE7:
+                response[0] = userRegister;
+                responseLength = 1;
+                return true;
+            case 0xE6:
+                if (length > 1) {
+                    userRegister = data[1];
+                }
+                return true;
+            case 0xFA:          // Serial A, 0x0F: SNA bytes, each with its own CRC
+                if (length < 2 || data[1] != 0x0F) {
+                    return false;
+                }
+                for (int i = 0; i < 4; i++) {
+                    uint8_t byte = static_cast<uint8_t>(0x10 + i);
+                    response[i * 2] = byte;
+                    response[i * 2 + 1] = crc8(&byte, 1);
+                }
+                responseLength = 8;
+                return true;
+            case 0xFC:          // Serial B, 0xC9: SNB3 identifies the part
+                if (length < 2 || data[1] != 0xC9) {
+                    return false;
+                }
+                respondWord(0x1500, true);
+                respondWord(static_cast<uint16_t>(0x0100 | getAddress()), true);
+                return true;
+            case 0x84:          // Firmware revision, 0xB8
+                if (length < 2 || data[1] != 0xB8) {
+                    return false;
+                }
+                response[0] = 0x20;
+                responseLength = 1;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool Si7021::onRead(uint8_t* data, size_t length) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (now() < readyAtUs || responseLength == 0) {
+            return false;   // No-hold reads are NACKed until the conversion is done
+        }
+        size_t n = std::min(length, responseLength);
+        memcpy(data, response, n);
+        memset(data + n, 0xFF, length - n);
+        responseLength = 0;
+        return true;
+    }
+
+    // -----------------------------------------------------------------------
+    // MAX31865
+    // -----------------------------------------------------------------------
+
+    Max31865::Max31865(float nominal, float reference) : nominalOhms(nominal), referenceOhms(reference) {}
+
+    void Max31865::setTemperature(float celsius) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        temperature = celsius;
+    }
+
+    void Max31865::setNoise(float sigma) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        temperatureNoise = sigma;
+    }
+
+    void Max31865::injectFault(uint8_t faultBits) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pendingFault = faultBits;
+        registers[7] |= faultBits;
+    }
+
+    float Max31865::resistanceAt(float celsius, float nominal) {
+        // Callendar-Van Dusen, IEC 60751 coefficients
+        const double a = 3.9083e-3;
+        const double b = -5.775e-7;
+        const double c = -4.183e-12;
+        double t = celsius;
+        double ratio = 1.0 + a * t + b * t * t;
+        if (t < 0.0) {
+            ratio += c * (t - 100.0) * t * t * t;
+        }
+        return static_cast<float>(nominal * ratio);
+    }
+
+    void Max31865::latchConversion() {
+        // Caller holds stateMutex
+        float ohms = resistanceAt(temperature + noise(temperatureNoise), nominalOhms);
+        uint16_t code = static_cast<uint16_t>(std::min(32767.0f, std::max(0.0f, ohms / referenceOhms * 32768.0f)));
+
+        uint16_t high = static_cast<uint16_t>((registers[3] << 8 | registers[4]) >> 1);
+        uint16_t low = static_cast<uint16_t>((registers[5] << 8 | registers[6]) >> 1);
+        uint8_t fault = pendingFault;
+        if (code >= high) {
+            fault |= 0x80;
+        }
+        if (code < low) {
+            fault |= 0x40;
+        }
+        registers[7] |= fault;
+        registers[1] = static_cast<uint8_t>(code >> 7);
+        registers[2] = static_cast<uint8_t>(((code << 1) & 0xFF) | (registers[7] ? 0x01 : 0x00));
+    }
+
+    void Max31865::startConversion() {
+        // Caller holds stateMutex
+        bool filter50Hz = registers[0] & 0x01;
+        if (registers[0] & 0x40) {
+            readyAtUs = now() + (filter50Hz ? 20000 : 16700);
+        } else {
+            readyAtUs = now() + (filter50Hz ? 62500 : 52000);
+        }
+        converting = true;
+    }
+
+    void Max31865::transfer(const uint8_t* tx, uint8_t* rx, size_t length) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (length == 0) {
+            return;
+        }
+
+        // Conversions finish in the background; catch up before serving the frame
+        uint64_t at = now();
+        bool bias = registers[0] & 0x80;
+        if (converting && at >= readyAtUs) {
+            if (bias) {
+                latchConversion();
+            }
+            converting = false;
+            registers[0] &= ~0x20;
+            if ((registers[0] & 0x40) && bias) {
+                startConversion();
+            }
+        }
+
+        rx[0] = 0xFF;
+        bool write = tx[0] & 0x80;
+        uint8_t address = tx[0] & 0x07;
+        for (size_t i = 1; i < length; i++, address = (address + 1) & 0x07) {
+            if (!write) {
+                rx[i] = registers[address];
+                continue;
+            }
+            rx[i] = 0xFF;
+            if (address == 0) {
+                uint8_t config = tx[i];
+                if (config & 0x02) {
+                    registers[7] = 0;     // Fault status clear
+                    pendingFault = 0;
+                }
+                bool wasAuto = registers[0] & 0x40;
+                registers[0] = config & ~0x02;
+                if ((config & 0x20) || ((config & 0x40) && (config & 0x80) && !wasAuto)) {
+                    startConversion();
+                }
+                if (!(config & 0x40) && !(config & 0x20)) {
+                    converting = false;
+                }
+            } else if (address >= 3 && address <= 6) {
+                registers[address] = tx[i];
+            }
+        }
+    }
+}
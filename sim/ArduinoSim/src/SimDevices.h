@@ -0,0 +1,351 @@
+/**
+ * @file SimDevices.h
+ * @brief Simulated I2C and SPI buses and the sensor chips the firmware drives
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Devices are plain objects owned by the test. Attach them to a bus and
+ * the firmware's TwoWire and spi_master calls reach them exactly as they
+ * would reach the hardware: the same command bytes, conversion times,
+ * CRCs and NACKs. Each device can add a fixed latency per transaction, a
+ * probability of NACKing and Gaussian noise on its measurements.
+ *
+ *     Sim::Sht4x probe(0x44);
+ *     probe.setTemperature(21.5f);
+ *     probe.setNackRate(0.01f);
+ *     Sim::attachI2C(1, &probe, 3);   // Wire1, port I2C0, behind mux channel 3
+ *
+ * Bus time is charged too: a transfer blocks its caller for the bits on
+ * the wire at the configured clock plus the device latency, so one slow
+ * device holds up everything else on its bus, as on the board.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <atomic>
+ #include <mutex>
+ #include <random>
+
+ namespace Sim {
+
+     /**
+      * @brief Transaction counters of one device
+      */
+     struct DeviceStats {
+         std::atomic<uint32_t> transactions{0};   ///< Addressed transfers, ACKed or not
+         std::atomic<uint32_t> nacks{0};          ///< Transfers the device refused
+         std::atomic<uint32_t> bytesWritten{0};   ///< Bytes from the controller
+         std::atomic<uint32_t> bytesRead{0};      ///< Bytes to the controller
+     };
+
+     /**
+      * @brief Timing, noise and fault injection shared by every simulated device
+      */
+     class Device {
+     public:
+         Device();
+         virtual ~Device() = default;
+
+         Device(const Device&) = delete;
+         Device& operator=(const Device&) = delete;
+
+         /**
+          * @brief Add a fixed cost to every transaction
+          * @param us Simulated microseconds per transaction
+          */
+         void setLatencyUs(uint32_t us) { latencyUs = us; }
+         uint32_t getLatencyUs() const { return latencyUs; }
+
+         /**
+          * @brief Refuse a share of transactions at random
+          * @param rate Probability from 0 (never) to 1 (always)
+          */
+         void setNackRate(float rate) { nackRate = rate; }
+
+         /**
+          * @brief Take the device off the bus, as if unplugged
+          * @param online false to NACK everything
+          */
+         void setOnline(bool online) { present = online; }
+         bool isOnline() const { return present; }
+
+         /**
+          * @brief Counters since the device was created
+          */
+         const DeviceStats& stats() const { return counters; }
+         DeviceStats& stats() { return counters; }
+
+         /**
+          * @brief Decide whether the next transaction is refused
+          * Called by the bus for every transaction; counts it.
+          * @return true to NACK
+          */
+         bool rollNack();
+
+     protected:
+         /**
+          * @brief Draw normally distributed noise
+          * @param sigma Standard deviation, 0 for none
+          * @return Noise sample
+          */
+         float noise(float sigma);
+
+         /**
+          * @brief Simulated time, for conversion timing
+          */
+         static uint64_t now();
+
+         std::mutex stateMutex;         ///< Guards the measured values against the test thread
+         DeviceStats counters;          ///< Transaction counters
+
+     private:
+         std::atomic<uint32_t> latencyUs{0};
+         std::atomic<float> nackRate{0.0f};
+         std::atomic<bool> present{true};
+         std::mt19937 rng;              ///< Per-device stream derived from the seed
+     };
+
+     /**
+      * @brief A device on an I2C bus
+      * The bus calls onWrite() for a controller write and onRead() for a
+      * read, with the bus lock held and after the device ACKed its address.
+      */
+     class I2CDevice : public Device {
+     public:
+         explicit I2CDevice(uint8_t i2cAddress) : address(i2cAddress) {}
+
+         uint8_t getAddress() const { return address; }
+
+         /**
+          * @brief Receive a write transfer
+          * @param data Bytes after the address, none for a presence probe
+          * @param length Number of bytes
+          * @return false to NACK
+          */
+         virtual bool onWrite(const uint8_t* data, size_t length) = 0;
+
+         /**
+          * @brief Serve a read transfer
+          * @param data [out] Bytes for the controller
+          * @param length Number of bytes requested
+          * @return false to NACK the read header, e.g. while converting
+          */
+         virtual bool onRead(uint8_t* data, size_t length) = 0;
+
+     private:
+         uint8_t address;
+     };
+
+     /**
+      * @brief A device on the SPI bus, selected by its chip-select pin
+      */
+     class SpiDevice : public Device {
+     public:
+         SpiDevice() = default;
+
+         /**
+          * @brief Exchange one chip-select frame
+          * @param tx Bytes from the controller
+          * @param rx [out] Bytes to the controller, same length
+          * @param length Frame length in bytes
+          */
+         virtual void transfer(const uint8_t* tx, uint8_t* rx, size_t length) = 0;
+     };
+
+     /**
+      * @brief TCA9548A I2C multiplexer
+      * The control register is a bit mask of open downstream channels.
+      * attachI2C() with a channel adds one at 0x70 if the bus has none.
+      */
+     class Tca9548a : public I2CDevice {
+     public:
+         static const uint8_t DEFAULT_ADDRESS = 0x70;   ///< A0-A2 low
+
+         explicit Tca9548a(uint8_t i2cAddress = DEFAULT_ADDRESS) : I2CDevice(i2cAddress) {}
+
+         /**
+          * @brief Currently open channels
+          * @return Channel bit mask
+          */
+         uint8_t getChannelMask() const { return channelMask; }
+
+         bool onWrite(const uint8_t* data, size_t length) override;
+         bool onRead(uint8_t* data, size_t length) override;
+
+     private:
+         std::atomic<uint8_t> channelMask{0};
+     };
+
+     /**
+      * @brief Temperature and humidity environment of a climate sensor
+      */
+     class ClimateDevice : public I2CDevice {
+     public:
+         explicit ClimateDevice(uint8_t i2cAddress);
+
+         void setTemperature(float celsius);
+         void setHumidity(float percent);
+
+         /**
+          * @brief Standard deviation of the noise on each conversion
+          * @param temperatureSigma Noise in °C
+          * @param humiditySigma Noise in %RH
+          */
+         void setNoise(float temperatureSigma, float humiditySigma);
+
+     protected:
+         /**
+          * @brief Draw one noisy conversion of the environment
+          * @param celsius [out] Temperature
+          * @param percent [out] Relative humidity, clamped to 0..100
+          */
+         void sample(float& celsius, float& percent);
+
+     private:
+         float temperature = 22.0f;
+         float humidity = 45.0f;
+         float temperatureNoise = 0.02f;
+         float humidityNoise = 0.1f;
+     };
+
+     /**
+      * @brief Sensirion SHT4x (SHT40/41/45)
+      * Measures on 0xFD/0xF6/0xE0 and returns two CRC-protected words once
+      * the conversion time has passed; reads before that are NACKed, as
+      * on the chip. Answers soft reset (0x94) and serial number (0x89).
+      */
+     class Sht4x : public ClimateDevice {
+     public:
+         static const uint8_t DEFAULT_ADDRESS = 0x44;
+
+         explicit Sht4x(uint8_t i2cAddress = DEFAULT_ADDRESS) : ClimateDevice(i2cAddress) {}
+
+         /**
+          * @brief Sensirion CRC-8, polynomial 0x31, init 0xFF
+          */
+         static uint8_t crc8(const uint8_t* data, size_t length);
+
+         bool onWrite(const uint8_t* data, size_t length) override;
+         bool onRead(uint8_t* data, size_t length) override;
+
+     private:
+         uint8_t response[6] = {};
+         size_t responseLength = 0;
+         uint64_t readyAtUs = 0;
+     };
+
+     /**
+      * @brief Silicon Labs Si7021
+      * Supports measure RH in hold and no-hold mode, read the temperature
+      * of the last RH conversion, measure temperature, user register,
+      * reset, electronic serial number and firmware revision.
+      */
+     class Si7021 : public ClimateDevice {
+     public:
+         static const uint8_t DEFAULT_ADDRESS = 0x40;
+
+         explicit Si7021(uint8_t i2cAddress = DEFAULT_ADDRESS) : ClimateDevice(i2cAddress) {}
+
+         /**
+          * @brief Si7021 CRC-8, polynomial 0x31, init 0x00
+          */
+         static uint8_t crc8(const uint8_t* data, size_t length);
+
+         bool onWrite(const uint8_t* data, size_t length) override;
+         bool onRead(uint8_t* data, size_t length) override;
+
+     private:
+         void respondWord(uint16_t word, bool withCrc);
+
+         uint8_t response[8] = {};
+         size_t responseLength = 0;
+         uint64_t readyAtUs = 0;
+         uint16_t lastTemperatureCode = 0;
+         uint8_t userRegister = 0x3A;
+     };
+
+     /**
+      * @brief Maxim MAX31865 RTD-to-digital converter with a PT100
+      * Register file with auto-increment, one-shot and automatic
+      * conversion, fault thresholds and the fault status register. RTD
+      * resistance follows Callendar-Van Dusen for the set temperature.
+      */
+     class Max31865 : public SpiDevice {
+     public:
+         /**
+          * @brief Constructor
+          * @param nominal RTD resistance at 0 °C
+          * @param reference Reference resistor on the board
+          */
+         explicit Max31865(float nominal = 100.0f, float reference = 430.0f);
+
+         void setTemperature(float celsius);
+         void setNoise(float sigma);
+
+         /**
+          * @brief Force fault status bits, e.g. 0x04 for over/under voltage
+          * Cleared by the firmware's fault clear like a real fault.
+          * @param faultBits Bits of the fault status register
+          */
+         void injectFault(uint8_t faultBits);
+
+         /**
+          * @brief Resistance of the RTD at a temperature
+          * @param celsius Temperature
+          * @param nominal Resistance at 0 °C
+          * @return Ohms
+          */
+         static float resistanceAt(float celsius, float nominal);
+
+         void transfer(const uint8_t* tx, uint8_t* rx, size_t length) override;
+
+     private:
+         void latchConversion();
+         void startConversion();
+
+         float nominalOhms;
+         float referenceOhms;
+         float temperature = 22.0f;
+         float temperatureNoise = 0.01f;
+         uint8_t registers[8] = {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00};
+         uint64_t readyAtUs = 0;
+         bool converting = false;
+         uint8_t pendingFault = 0;
+     };
+
+     /**
+      * @brief Put a device on an I2C bus
+      * @param bus 0 for Wire, 1 for Wire1; the firmware's port I2C0 is Wire1
+      * @param device Device, owned by the caller, outliving its attachment
+      * @param muxChannel Channel behind the bus multiplexer, -1 for direct
+      */
+     void attachI2C(int bus, I2CDevice* device, int muxChannel = -1);
+
+     /**
+      * @brief Put a device on the SPI bus
+      * @param csPin Physical chip-select GPIO, as in Constants::Pins::SPI::SS_PINS
+      * @param device Device, owned by the caller
+      */
+     void attachSpi(int csPin, SpiDevice* device);
+
+     /**
+      * @brief Remove a device from whichever bus it is on
+      * @param device Device passed to attachI2C() or attachSpi()
+      */
+     void detach(Device* device);
+
+     /**
+      * @brief Remove every device, including multiplexers added implicitly
+      */
+     void detachAll();
+
+     /**
+      * @brief Get the multiplexer of a bus
+      * @param bus Bus index
+      * @return The multiplexer, or nullptr if none is attached
+      */
+     Tca9548a* getMux(int bus);
+ }
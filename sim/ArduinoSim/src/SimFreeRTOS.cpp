@@ -0,0 +1,820 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "ArduinoSim.h"
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A task: a host thread plus the FreeRTOS state the firmware can see
+ * Control blocks are never freed, so a stale handle stays safe to query.
+ */
+struct tskTaskControlBlock {
+    char name[configMAX_TASK_NAME_LEN] = {};
+    UBaseType_t number = 0;
+    std::atomic<UBaseType_t> priority{0};
+    BaseType_t core = tskNO_AFFINITY;
+    uint32_t stackDepth = 0;
+    TaskFunction_t code = nullptr;
+    void* parameters = nullptr;
+
+    std::mutex mutex;                  ///< Guards the fields below
+    std::condition_variable wake;      ///< Signalled on notify, resume and delete
+    uint32_t notifyValue = 0;
+    bool notifyPending = false;
+    bool suspended = false;
+    bool deleted = false;
+
+    std::atomic<eTaskState> state{eReady};
+    bool isIdle = false;               ///< Synthesized idle task, has no thread
+    bool hasThread = false;
+    pthread_t thread{};
+    uint32_t idleCounter = 0;          ///< Last reported run time of an idle task
+};
+
+namespace {
+    struct Kernel {
+        std::mutex mutex;
+        std::vector<TaskHandle_t> tasks;
+        UBaseType_t nextNumber = 1;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        TaskHandle_t idle[portNUM_PROCESSORS] = {};
+        bool adoptedMain = false;
+    };
+
+    Kernel& kernel() {
+        static Kernel instance;
+        return instance;
+    }
+
+    thread_local TaskHandle_t currentTask = nullptr;
+
+    uint32_t threadToken() {
+        static std::atomic<uint32_t> nextToken{1};
+        thread_local const uint32_t token = nextToken.fetch_add(1);
+        return token;
+    }
+
+    TaskHandle_t newControlBlock(const char* name, UBaseType_t priority, BaseType_t core, uint32_t stackDepth) {
+        TaskHandle_t task = new tskTaskControlBlock();
+        strncpy(task->name, name ? name : "", sizeof(task->name) - 1);
+        task->priority = priority;
+        task->core = core;
+        task->stackDepth = stackDepth;
+        Kernel& k = kernel();
+        std::lock_guard<std::mutex> lock(k.mutex);
+        task->number = k.nextNumber++;
+        k.tasks.push_back(task);
+        return task;
+    }
+
+    void ensureIdleTasks() {
+        Kernel& k = kernel();
+        {
+            std::lock_guard<std::mutex> lock(k.mutex);
+            if (k.idle[0]) {
+                return;
+            }
+        }
+        TaskHandle_t idle[portNUM_PROCESSORS];
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+            char name[configMAX_TASK_NAME_LEN];
+            snprintf(name, sizeof(name), "IDLE%d", static_cast<int>(core));
+            idle[core] = newControlBlock(name, tskIDLE_PRIORITY, core, 1536);
+            idle[core]->isIdle = true;
+        }
+        std::lock_guard<std::mutex> lock(k.mutex);
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+            k.idle[core] = idle[core];
+        }
+    }
+
+    /**
+     * @brief The calling thread's task; threads the simulation did not start are adopted
+     * The first is the Arduino loop task, as the firmware's setup() runs on it.
+     */
+    TaskHandle_t self() {
+        if (!currentTask) {
+            ensureIdleTasks();
+            Kernel& k = kernel();
+            bool first;
+            {
+                std::lock_guard<std::mutex> lock(k.mutex);
+                first = !k.adoptedMain;
+                k.adoptedMain = true;
+            }
+            char name[configMAX_TASK_NAME_LEN];
+            snprintf(name, sizeof(name), first ? "loopTask" : "host%u", threadToken());
+            TaskHandle_t task = newControlBlock(name, 1, 1, 8192);
+            std::lock_guard<std::mutex> lock(k.mutex);
+            task->hasThread = true;
+            task->thread = pthread_self();
+            task->state = eRunning;
+            currentTask = task;
+        }
+        return currentTask;
+    }
+
+    /**
+     * @brief Block a deleted task for good; FreeRTOS never returns to it
+     */
+    [[noreturn]] void park(TaskHandle_t task) {
+        std::unique_lock<std::mutex> lock(task->mutex);
+        task->state = eDeleted;
+        for (;;) {
+            task->wake.wait(lock);
+        }
+    }
+
+    /**
+     * @brief Wait on a task's condition for up to a number of simulated ticks
+     * Parks the task if it is deleted while waiting.
+     */
+    template <typename Predicate>
+    bool waitTicks(TaskHandle_t task, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate ready) {
+        auto done = [&] { return task->deleted || ready(); };
+        bool result = true;
+        if (!done()) {
+            task->state = eBlocked;
+            if (ticks == portMAX_DELAY) {
+                task->wake.wait(lock, done);
+            } else if (ticks > 0) {
+                auto deadline = std::chrono::steady_clock::now() + Sim::toHostDuration(pdTICKS_TO_MS(ticks) * 1000ULL);
+                result = task->wake.wait_until(lock, deadline, done);
+            } else {
+                result = false;
+            }
+            task->state = eRunning;
+        }
+        if (task->deleted) {
+            lock.unlock();
+            park(task);
+        }
+        return result && ready();
+    }
+
+    void checkDeleted(TaskHandle_t task) {
+        std::unique_lock<std::mutex> lock(task->mutex);
+        if (task->deleted) {
+            lock.unlock();
+            park(task);
+        }
+    }
+
+    uint64_t threadCpuUs(const tskTaskControlBlock* task) {
+        if (!task->hasThread) {
+            return 0;
+        }
+        clockid_t clock;
+        timespec ts;
+        if (pthread_getcpuclockid(task->thread, &clock) != 0 || clock_gettime(clock, &ts) != 0) {
+            return 0;
+        }
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + ts.tv_nsec / 1000;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Port
+// ---------------------------------------------------------------------------
+
+void vPortEnterCritical(portMUX_TYPE* mux) {
+    uint32_t token = threadToken();
+    if (mux->owner.load(std::memory_order_acquire) == token) {
+        mux->count++;
+        return;
+    }
+    uint32_t expected = 0;
+    while (!mux->owner.compare_exchange_weak(expected, token, std::memory_order_acquire)) {
+        expected = 0;
+        std::this_thread::yield();
+    }
+    mux->count = 1;
+}
+
+void vPortExitCritical(portMUX_TYPE* mux) {
+    if (--mux->count == 0) {
+        mux->owner.store(0, std::memory_order_release);
+    }
+}
+
+BaseType_t xPortGetCoreID() {
+    BaseType_t core = self()->core;
+    return core == tskNO_AFFINITY ? 0 : core;
+}
+
+BaseType_t xPortInIsrContext() {
+    return pdFALSE;
+}
+
+void vPortYield() {
+    std::this_thread::yield();
+}
+
+// ---------------------------------------------------------------------------
+// Tasks
+// ---------------------------------------------------------------------------
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameters,
+                                   UBaseType_t priority, TaskHandle_t* created, BaseType_t core) {
+    if (!code || (core != tskNO_AFFINITY && (core < 0 || core >= portNUM_PROCESSORS))) {
+        return pdFAIL;
+    }
+    ensureIdleTasks();
+    TaskHandle_t task = newControlBlock(name, priority, core, stackDepth);
+    task->code = code;
+    task->parameters = parameters;
+    if (created) {
+        *created = task;
+    }
+
+    // The handle is published before the task runs, as with FreeRTOS
+    Kernel& k = kernel();
+    std::lock_guard<std::mutex> lock(k.mutex);
+    std::thread thread([task] {
+        currentTask = task;
+        task->state = eRunning;
+        task->code(task->parameters);
+        // Returning from a task function is a bug on the chip; here it just ends the task
+        fprintf(stderr, "[sim] task %s returned from its function\n", task->name);
+        std::lock_guard<std::mutex> kernelLock(kernel().mutex);
+        std::lock_guard<std::mutex> taskLock(task->mutex);
+        task->deleted = true;
+        task->hasThread = false;
+        task->state = eDeleted;
+    });
+    task->thread = thread.native_handle();
+    task->hasThread = true;
+    thread.detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameters,
+                       UBaseType_t priority, TaskHandle_t* created) {
+    return xTaskCreatePinnedToCore(code, name, stackDepth, parameters, priority, created, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    TaskHandle_t current = self();
+    if (!task) {
+        task = current;
+    }
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->deleted = true;
+        task->wake.notify_all();
+    }
+    // Another task stops at its next blocking call; the host cannot stop a thread in between
+    if (task == current) {
+        park(task);
+    }
+}
+
+void vTaskDelay(TickType_t ticks) {
+    TaskHandle_t task = self();
+    checkDeleted(task);
+    task->state = eBlocked;
+    Sim::sleepUs(static_cast<uint64_t>(pdTICKS_TO_MS(ticks)) * 1000);
+    task->state = eRunning;
+    checkDeleted(task);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+    TickType_t target = *previousWake + increment;
+    int32_t wait = static_cast<int32_t>(target - xTaskGetTickCount());
+    *previousWake = target;
+    if (wait <= 0) {
+        checkDeleted(self());
+        return pdFALSE;
+    }
+    vTaskDelay(static_cast<TickType_t>(wait));
+    return pdTRUE;
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+    xTaskDelayUntil(previousWake, increment);
+}
+
+void vTaskSuspend(TaskHandle_t task) {
+    TaskHandle_t current = self();
+    if (!task) {
+        task = current;
+    }
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->suspended = true;
+    task->state = eSuspended;
+    if (task == current) {
+        task->wake.wait(lock, [&] { return !task->suspended || task->deleted; });
+        task->state = eRunning;
+        if (task->deleted) {
+            lock.unlock();
+            park(task);
+        }
+    }
+}
+
+void vTaskResume(TaskHandle_t task) {
+    if (!task) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->suspended = false;
+    task->state = eReady;
+    task->wake.notify_all();
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(Sim::nowUs() / (1000000ULL / configTICK_RATE_HZ));
+}
+
+TickType_t xTaskGetTickCountFromISR() {
+    return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return self();
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t core) {
+    ensureIdleTasks();
+    if (core >= portNUM_PROCESSORS) {
+        return nullptr;
+    }
+    Kernel& k = kernel();
+    std::lock_guard<std::mutex> lock(k.mutex);
+    return k.idle[core];
+}
+
+const char* pcTaskGetName(TaskHandle_t task) {
+    return (task ? task : self())->name;
+}
+
+eTaskState eTaskGetState(TaskHandle_t task) {
+    if (!task) {
+        return eInvalid;
+    }
+    if (task == currentTask) {
+        return eRunning;
+    }
+    return task->isIdle ? eReady : task->state.load();
+}
+
+BaseType_t xTaskGetAffinity(TaskHandle_t task) {
+    return (task ? task : self())->core;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    // Host threads have megabytes of stack; report the configured stack as unused
+    return (task ? task : self())->stackDepth;
+}
+
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority) {
+    (task ? task : self())->priority = std::min<UBaseType_t>(priority, configMAX_PRIORITIES - 1);
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    return (task ? task : self())->priority;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks() {
+    ensureIdleTasks();
+    Kernel& k = kernel();
+    std::lock_guard<std::mutex> lock(k.mutex);
+    return static_cast<UBaseType_t>(std::count_if(k.tasks.begin(), k.tasks.end(), [](TaskHandle_t task) {
+        std::lock_guard<std::mutex> taskLock(task->mutex);
+        return !task->deleted;
+    }));
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* statuses, UBaseType_t max, uint32_t* totalRunTime) {
+    ensureIdleTasks();
+    Kernel& k = kernel();
+    std::lock_guard<std::mutex> lock(k.mutex);
+
+    std::vector<TaskHandle_t> live;
+    for (TaskHandle_t task : k.tasks) {
+        std::lock_guard<std::mutex> taskLock(task->mutex);
+        if (!task->deleted) {
+            live.push_back(task);
+        }
+    }
+    if (live.size() > max) {
+        return 0;
+    }
+
+    // Run time is host CPU time in microseconds against elapsed host time, so
+    // shares are of one host core. Idle time is what the pinned tasks left over.
+    uint64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - k.start).count();
+    uint64_t busyUs[portNUM_PROCESSORS] = {};
+    UBaseType_t count = 0;
+    for (TaskHandle_t task : live) {
+        TaskStatus_t& status = statuses[count++];
+        status.xHandle = task;
+        status.pcTaskName = task->name;
+        status.xTaskNumber = task->number;
+        status.eCurrentState = eTaskGetState(task);
+        status.uxCurrentPriority = task->priority;
+        status.uxBasePriority = task->priority;
+        status.pxStackBase = nullptr;
+        status.usStackHighWaterMark = task->stackDepth;
+        status.xCoreID = task->core;
+        if (task->isIdle) {
+            continue;
+        }
+        uint64_t cpuUs = threadCpuUs(task);
+        status.ulRunTimeCounter = static_cast<uint32_t>(cpuUs);
+        if (task->core == tskNO_AFFINITY) {
+            for (uint64_t& busy : busyUs) {
+                busy += cpuUs / portNUM_PROCESSORS;
+            }
+        } else {
+            busyUs[task->core] += cpuUs;
+        }
+    }
+    for (UBaseType_t i = 0; i < count; i++) {
+        TaskHandle_t task = statuses[i].xHandle;
+        if (task->isIdle) {
+            uint64_t idleUs = elapsedUs > busyUs[task->core] ? elapsedUs - busyUs[task->core] : 0;
+            // Never run backwards, whatever the host scheduler did
+            task->idleCounter = std::max(task->idleCounter, static_cast<uint32_t>(idleUs));
+            statuses[i].ulRunTimeCounter = task->idleCounter;
+        }
+    }
+    if (totalRunTime) {
+        *totalRunTime = static_cast<uint32_t>(elapsedUs);
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// Notifications
+// ---------------------------------------------------------------------------
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+    xTaskNotify(task, 0, eIncrement);
+    if (woken) {
+        *woken = pdTRUE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    TaskHandle_t task = self();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitTicks(task, lock, ticks, [&] { return task->notifyValue != 0; });
+    uint32_t value = task->notifyValue;
+    if (value != 0) {
+        task->notifyValue = clearOnExit ? 0 : value - 1;
+    }
+    task->notifyPending = false;
+    return value;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    if (!task) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(task->mutex);
+    switch (action) {
+        case eSetBits: task->notifyValue |= value; break;
+        case eIncrement: task->notifyValue++; break;
+        case eSetValueWithOverwrite: task->notifyValue = value; break;
+        case eSetValueWithoutOverwrite:
+            if (task->notifyPending) {
+                return pdFAIL;
+            }
+            task->notifyValue = value;
+            break;
+        case eNoAction: break;
+    }
+    task->notifyPending = true;
+    task->wake.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t* woken) {
+    if (woken) {
+        *woken = pdTRUE;
+    }
+    return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value, TickType_t ticks) {
+    TaskHandle_t task = self();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (!task->notifyPending) {
+        task->notifyValue &= ~clearOnEntry;
+    }
+    bool notified = waitTicks(task, lock, ticks, [&] { return task->notifyPending; });
+    if (value) {
+        *value = task->notifyValue;
+    }
+    if (notified) {
+        task->notifyValue &= ~clearOnExit;
+        task->notifyPending = false;
+    }
+    return notified ? pdTRUE : pdFALSE;
+}
+
+// ---------------------------------------------------------------------------
+// Queues and semaphores
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Queue, or semaphore when itemSize is 0
+ */
+struct QueueDefinition {
+    enum class Kind { QUEUE, MUTEX, RECURSIVE_MUTEX, BINARY, COUNTING };
+
+    Kind kind = Kind::QUEUE;
+    size_t itemSize = 0;
+    size_t capacity = 0;
+    std::vector<uint8_t> storage;      ///< Ring of capacity items
+    size_t head = 0;
+    size_t count = 0;                  ///< Items, or the semaphore count
+    TaskHandle_t holder = nullptr;     ///< Mutex owner
+    UBaseType_t recursion = 0;
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+namespace {
+    template <typename Predicate>
+    bool waitQueue(QueueHandle_t queue, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate ready) {
+        if (ready()) {
+            return true;
+        }
+        if (ticks == 0) {
+            return false;
+        }
+        if (ticks == portMAX_DELAY) {
+            queue->changed.wait(lock, ready);
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() + Sim::toHostDuration(pdTICKS_TO_MS(ticks) * 1000ULL);
+        return queue->changed.wait_until(lock, deadline, ready);
+    }
+
+    QueueHandle_t newQueue(QueueDefinition::Kind kind, size_t capacity, size_t itemSize, size_t initial) {
+        QueueHandle_t queue = new QueueDefinition();
+        queue->kind = kind;
+        queue->capacity = capacity;
+        queue->itemSize = itemSize;
+        queue->storage.resize(capacity * itemSize);
+        queue->count = initial;
+        return queue;
+    }
+
+    BaseType_t send(QueueHandle_t queue, const void* item, TickType_t ticks, bool toFront, bool overwrite) {
+        if (!queue) {
+            return errQUEUE_FULL;
+        }
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        if (overwrite && queue->count == queue->capacity && queue->capacity > 0) {
+            queue->count--;
+        }
+        if (!waitQueue(queue, lock, ticks, [&] { return queue->count < queue->capacity; })) {
+            return errQUEUE_FULL;
+        }
+        if (queue->itemSize > 0) {
+            size_t slot = toFront ? (queue->head + queue->capacity - 1) % queue->capacity
+                                  : (queue->head + queue->count) % queue->capacity;
+            memcpy(&queue->storage[slot * queue->itemSize], item, queue->itemSize);
+            if (toFront) {
+                queue->head = slot;
+            }
+        }
+        queue->count++;
+        queue->changed.notify_all();
+        return pdPASS;
+    }
+
+    BaseType_t receive(QueueHandle_t queue, void* item, TickType_t ticks, bool remove) {
+        if (!queue) {
+            return errQUEUE_EMPTY;
+        }
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        if (!waitQueue(queue, lock, ticks, [&] { return queue->count > 0; })) {
+            return errQUEUE_EMPTY;
+        }
+        if (queue->itemSize > 0 && item) {
+            memcpy(item, &queue->storage[queue->head * queue->itemSize], queue->itemSize);
+        }
+        if (remove) {
+            if (queue->itemSize > 0) {
+                queue->head = (queue->head + 1) % queue->capacity;
+            }
+            queue->count--;
+            queue->changed.notify_all();
+        }
+        return pdPASS;
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    if (length == 0) {
+        return nullptr;
+    }
+    return newQueue(QueueDefinition::Kind::QUEUE, length, itemSize, 0);
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return send(queue, item, ticks, false, false);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return send(queue, item, ticks, false, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return send(queue, item, ticks, true, false);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken) {
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    return send(queue, item, 0, false, false);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item) {
+    return send(queue, item, 0, false, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+    return receive(queue, item, ticks, true);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void* item, BaseType_t* woken) {
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    return receive(queue, item, 0, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks) {
+    return receive(queue, item, ticks, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->head = 0;
+    queue->count = 0;
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->count);
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return static_cast<UBaseType_t>(queue->capacity - queue->count);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return newQueue(QueueDefinition::Kind::MUTEX, 1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+    return newQueue(QueueDefinition::Kind::RECURSIVE_MUTEX, 1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return newQueue(QueueDefinition::Kind::BINARY, 1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    if (maxCount == 0 || initialCount > maxCount) {
+        return nullptr;
+    }
+    return newQueue(QueueDefinition::Kind::COUNTING, maxCount, 0, initialCount);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    TaskHandle_t task = self();
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!waitQueue(semaphore, lock, ticks, [&] { return semaphore->count > 0; })) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    semaphore->holder = task;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    bool isMutex = semaphore->kind == QueueDefinition::Kind::MUTEX;
+    // Only the holder may give a mutex, as FreeRTOS enforces
+    if (semaphore->count >= semaphore->capacity || (isMutex && semaphore->holder != currentTask)) {
+        return pdFAIL;
+    }
+    semaphore->count++;
+    semaphore->holder = nullptr;
+    semaphore->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    TaskHandle_t task = self();
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (semaphore->holder == task) {
+        semaphore->recursion++;
+        return pdPASS;
+    }
+    if (!waitQueue(semaphore, lock, ticks, [&] { return semaphore->count > 0; })) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    semaphore->holder = task;
+    semaphore->recursion = 1;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->holder != currentTask || semaphore->recursion == 0) {
+        return pdFAIL;
+    }
+    if (--semaphore->recursion == 0) {
+        semaphore->holder = nullptr;
+        semaphore->count++;
+        semaphore->changed.notify_all();
+    }
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken) {
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->count >= semaphore->capacity) {
+        return pdFAIL;
+    }
+    semaphore->count++;
+    semaphore->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken) {
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    if (!semaphore) {
+        return pdFAIL;
+    }
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->count == 0) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    return pdPASS;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    return static_cast<UBaseType_t>(semaphore->count);
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    return semaphore->holder;
+}
@@ -0,0 +1,307 @@
+#include "ArduinoSim.h"
+#include "LittleFS.h"
+#include "Preferences.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+LittleFSFS LittleFS;
+
+namespace fs {
+    /**
+     * @brief Contents of one file, shared by every handle open on it
+     */
+    struct FileData {
+        std::string path;
+        std::string contents;
+    };
+}
+
+namespace {
+    constexpr size_t NVS_KEY_MAX = 15;
+    constexpr size_t FS_BLOCK_BYTES = 4096;
+
+    std::mutex storageMutex;
+    std::map<std::string, std::map<std::string, std::vector<uint8_t>>> nvs;
+    std::map<std::string, std::shared_ptr<fs::FileData>> files;
+}
+
+namespace Sim {
+    void resetStorage() {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        nvs.clear();
+        files.clear();
+    }
+
+    void writeFile(const char* path, const std::string& contents) {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        auto& file = files[path];
+        if (!file) {
+            file = std::make_shared<fs::FileData>();
+            file->path = path;
+        }
+        file->contents = contents;
+    }
+
+    bool readFile(const char* path, std::string& contents) {
+        std::lock_guard<std::mutex> lock(storageMutex);
+        auto file = files.find(path);
+        if (file == files.end()) {
+            return false;
+        }
+        contents = file->second->contents;
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Preferences
+// ---------------------------------------------------------------------------
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partition) {
+    if (opened || !name || strlen(name) == 0 || strlen(name) > NVS_KEY_MAX) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    // NVS cannot open a namespace read-only before anything created it
+    if (readOnly && nvs.find(name) == nvs.end()) {
+        return false;
+    }
+    nvs[name];
+    space = name;
+    opened = true;
+    readOnlyMode = readOnly;
+    return true;
+}
+
+void Preferences::end() {
+    opened = false;
+}
+
+bool Preferences::clear() {
+    if (!opened || readOnlyMode) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    nvs[space.c_str()].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!opened || readOnlyMode || !key) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return nvs[space.c_str()].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    if (!opened || !key) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return nvs[space.c_str()].count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (!opened || readOnlyMode || !key || strlen(key) > NVS_KEY_MAX || (!value && length > 0)) {
+        return 0;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(value);
+    std::lock_guard<std::mutex> lock(storageMutex);
+    nvs[space.c_str()][key].assign(bytes, bytes + length);
+    return length;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (!opened || !key) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    auto& entries = nvs[space.c_str()];
+    auto entry = entries.find(key);
+    return entry == entries.end() ? 0 : entry->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    if (!opened || !key || !buffer) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    auto& entries = nvs[space.c_str()];
+    auto entry = entries.find(key);
+    // Like the NVS blob API, a short buffer gets nothing rather than a truncated value
+    if (entry == entries.end() || entry->second.size() > maxLength) {
+        return 0;
+    }
+    memcpy(buffer, entry->second.data(), entry->second.size());
+    return entry->second.size();
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+    uint32_t value;
+    return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    size_t length = getBytesLength(key);
+    if (!isKey(key)) {
+        return defaultValue;
+    }
+    std::string value(length, '\0');
+    getBytes(key, &value[0], length);
+    return String(value);
+}
+
+// ---------------------------------------------------------------------------
+// LittleFS
+// ---------------------------------------------------------------------------
+
+void File::close() {
+    data.reset();
+    offset = 0;
+}
+
+size_t File::size() const {
+    if (!data) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return data->contents.size();
+}
+
+bool File::seek(uint32_t position) {
+    if (!data || position > size()) {
+        return false;
+    }
+    offset = position;
+    return true;
+}
+
+const char* File::name() const {
+    if (!data) {
+        return "";
+    }
+    size_t slash = data->path.rfind('/');
+    return data->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!data || !canWrite) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    std::string& contents = data->contents;
+    if (offset > contents.size()) {
+        contents.resize(offset);
+    }
+    contents.replace(offset, std::min(size, contents.size() - offset), reinterpret_cast<const char*>(buffer), size);
+    offset += size;
+    return size;
+}
+
+int File::available() {
+    size_t length = size();
+    return offset < length ? static_cast<int>(length - offset) : 0;
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+    if (!data) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return offset < data->contents.size() ? static_cast<uint8_t>(data->contents[offset]) : -1;
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (!data) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    const std::string& contents = data->contents;
+    if (offset >= contents.size()) {
+        return 0;
+    }
+    size_t n = std::min(size, contents.size() - offset);
+    memcpy(buffer, contents.data() + offset, n);
+    offset += n;
+    return n;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel) {
+    return true;
+}
+
+bool LittleFSFS::format() {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    files.clear();
+    return true;
+}
+
+File LittleFSFS::open(const char* path, const char* mode, bool create) {
+    if (!path || path[0] != '/' || !mode) {
+        return File();
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    auto existing = files.find(path);
+    bool writing = mode[0] == 'w' || mode[0] == 'a' || strchr(mode, '+');
+    if (existing == files.end()) {
+        if (mode[0] == 'r') {
+            return File();
+        }
+        auto file = std::make_shared<fs::FileData>();
+        file->path = path;
+        existing = files.emplace(path, file).first;
+    }
+    std::shared_ptr<fs::FileData> file = existing->second;
+    if (mode[0] == 'w') {
+        file->contents.clear();
+    }
+    File handle(file, writing);
+    if (mode[0] == 'a') {
+        handle.offset = file->contents.size();
+    }
+    return handle;
+}
+
+bool LittleFSFS::exists(const char* path) {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return path && files.count(path) > 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    return path && files.erase(path) > 0;
+}
+
+bool LittleFSFS::rename(const char* from, const char* to) {
+    if (!from || !to || to[0] != '/') {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(storageMutex);
+    auto source = files.find(from);
+    if (source == files.end()) {
+        return false;
+    }
+    // Open handles keep the old contents, as littlefs keeps the file they opened
+    auto moved = std::make_shared<fs::FileData>();
+    moved->path = to;
+    moved->contents = source->second->contents;
+    files.erase(source);
+    files[to] = moved;
+    return true;
+}
+
+size_t LittleFSFS::usedBytes() {
+    std::lock_guard<std::mutex> lock(storageMutex);
+    size_t used = 0;
+    for (const auto& file : files) {
+        used += (file.second->contents.size() / FS_BLOCK_BYTES + 1) * FS_BLOCK_BYTES;
+    }
+    return used;
+}
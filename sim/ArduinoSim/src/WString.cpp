@@ -0,0 +1,196 @@
+#include "WString.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace {
+    std::string formatUnsigned(unsigned long long number, unsigned char base) {
+        if (base < 2 || base > 36) {
+            base = 10;
+        }
+        char digits[66];
+        size_t n = 0;
+        do {
+            unsigned digit = static_cast<unsigned>(number % base);
+            digits[n++] = static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+            number /= base;
+        } while (number != 0);
+        std::reverse(digits, digits + n);
+        return std::string(digits, n);
+    }
+
+    std::string formatSigned(long long number, unsigned char base, unsigned long long unsignedValue) {
+        // Like itoa in the core, only decimal gets a sign; other bases show the bits
+        if (base == 10 && number < 0) {
+            return "-" + formatUnsigned(0ULL - static_cast<unsigned long long>(number), 10);
+        }
+        return formatUnsigned(base == 10 ? static_cast<unsigned long long>(number) : unsignedValue, base);
+    }
+
+    std::string formatFloat(double number, unsigned int decimals) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), number);
+        return buffer;
+    }
+}
+
+String::String(unsigned char number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(int number, unsigned char base)
+    : value(formatSigned(number, base, static_cast<unsigned int>(number))) {}
+String::String(unsigned int number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(long number, unsigned char base)
+    : value(formatSigned(number, base, static_cast<unsigned long>(number))) {}
+String::String(unsigned long number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(long long number, unsigned char base)
+    : value(formatSigned(number, base, static_cast<unsigned long long>(number))) {}
+String::String(unsigned long long number, unsigned char base) : value(formatUnsigned(number, base)) {}
+String::String(float number, unsigned int decimals) : value(formatFloat(number, decimals)) {}
+String::String(double number, unsigned int decimals) : value(formatFloat(number, decimals)) {}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    return value.size() == other.value.size() && strcasecmp(value.c_str(), other.value.c_str()) == 0;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    return offset + prefix.value.size() <= value.size() &&
+           value.compare(offset, prefix.value.size(), prefix.value) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return suffix.value.size() <= value.size() &&
+           value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= value.size()) {
+        dummy = '\0';
+        return dummy;
+    }
+    return value[index];
+}
+
+void String::getBytes(unsigned char* buffer, unsigned int size, unsigned int index) const {
+    if (!buffer || size == 0) {
+        return;
+    }
+    if (index >= value.size()) {
+        buffer[0] = '\0';
+        return;
+    }
+    size_t n = std::min<size_t>(size - 1, value.size() - index);
+    memcpy(buffer, value.data() + index, n);
+    buffer[n] = '\0';
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t found = value.find(c, from);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::indexOf(const String& text, unsigned int from) const {
+    size_t found = value.find(text.value, from);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::lastIndexOf(char c) const {
+    size_t found = value.rfind(c);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::lastIndexOf(char c, unsigned int from) const {
+    size_t found = value.rfind(c, from);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::lastIndexOf(const String& text) const {
+    size_t found = value.rfind(text.value);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::lastIndexOf(const String& text, unsigned int from) const {
+    size_t found = value.rfind(text.value, from);
+    return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        std::swap(from, to);
+    }
+    if (from >= value.size()) {
+        return String();
+    }
+    to = std::min<unsigned int>(to, length());
+    return String(value.substr(from, to - from));
+}
+
+void String::replace(char find, char with) {
+    for (char& c : value) {
+        if (c == find) {
+            c = with;
+        }
+    }
+}
+
+void String::replace(const String& find, const String& with) {
+    if (find.value.empty()) {
+        return;
+    }
+    size_t at = 0;
+    while ((at = value.find(find.value, at)) != std::string::npos) {
+        value.replace(at, find.value.size(), with.value);
+        at += with.value.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < value.size()) {
+        value.erase(index);
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < value.size()) {
+        value.erase(index, count);
+    }
+}
+
+void String::toLowerCase() {
+    for (char& c : value) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::toUpperCase() {
+    for (char& c : value) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+}
+
+void String::trim() {
+    size_t first = 0;
+    while (first < value.size() && isspace(static_cast<unsigned char>(value[first]))) {
+        first++;
+    }
+    size_t last = value.size();
+    while (last > first && isspace(static_cast<unsigned char>(value[last - 1]))) {
+        last--;
+    }
+    value = value.substr(first, last - first);
+}
+
+long String::toInt() const {
+    return atol(value.c_str());
+}
+
+float String::toFloat() const {
+    return static_cast<float>(atof(value.c_str()));
+}
+
+double String::toDouble() const {
+    return atof(value.c_str());
+}
@@ -0,0 +1,151 @@
+/**
+ * @file WString.h
+ * @brief Arduino String for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Behaves like the ESP32 core's String for everything the firmware uses,
+ * including the number formatting, on top of std::string.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <string>
+
+ #ifndef DEC
+ #define DEC 10
+ #define HEX 16
+ #define OCT 8
+ #define BIN 2
+ #endif
+
+ class __FlashStringHelper;
+
+ class String {
+ public:
+     String() = default;
+     String(const char* text) : value(text ? text : "") {}
+     String(const char* text, unsigned int length) : value(text ? std::string(text, length) : std::string()) {}
+     String(const std::string& text) : value(text) {}
+     String(const String&) = default;
+     String(String&&) = default;
+     explicit String(char c) : value(1, c) {}
+     explicit String(unsigned char number, unsigned char base = DEC);
+     explicit String(int number, unsigned char base = DEC);
+     explicit String(unsigned int number, unsigned char base = DEC);
+     explicit String(long number, unsigned char base = DEC);
+     explicit String(unsigned long number, unsigned char base = DEC);
+     explicit String(long long number, unsigned char base = DEC);
+     explicit String(unsigned long long number, unsigned char base = DEC);
+     explicit String(float number, unsigned int decimals = 2);
+     explicit String(double number, unsigned int decimals = 2);
+
+     String& operator=(const String&) = default;
+     String& operator=(String&&) = default;
+     String& operator=(const char* text) {
+         value = text ? text : "";
+         return *this;
+     }
+
+     unsigned int length() const { return static_cast<unsigned int>(value.size()); }
+     bool isEmpty() const { return value.empty(); }
+     bool reserve(unsigned int size) {
+         value.reserve(size);
+         return true;
+     }
+     const char* c_str() const { return value.c_str(); }
+     const char* begin() const { return value.c_str(); }
+     const char* end() const { return value.c_str() + value.size(); }
+
+     bool concat(const String& other) { value += other.value; return true; }
+     bool concat(const char* text) { if (!text) return false; value += text; return true; }
+     bool concat(const char* text, unsigned int length) { if (!text) return false; value.append(text, length); return true; }
+     bool concat(char c) { value += c; return true; }
+     bool concat(unsigned char number) { return concat(String(number)); }
+     bool concat(int number) { return concat(String(number)); }
+     bool concat(unsigned int number) { return concat(String(number)); }
+     bool concat(long number) { return concat(String(number)); }
+     bool concat(unsigned long number) { return concat(String(number)); }
+     bool concat(long long number) { return concat(String(number)); }
+     bool concat(unsigned long long number) { return concat(String(number)); }
+     bool concat(float number) { return concat(String(number)); }
+     bool concat(double number) { return concat(String(number)); }
+
+     template <typename T>
+     String& operator+=(const T& other) {
+         concat(other);
+         return *this;
+     }
+
+     int compareTo(const String& other) const { return value.compare(other.value); }
+     bool equals(const String& other) const { return value == other.value; }
+     bool equals(const char* other) const { return value == (other ? other : ""); }
+     bool equalsIgnoreCase(const String& other) const;
+     bool startsWith(const String& prefix) const { return startsWith(prefix, 0); }
+     bool startsWith(const String& prefix, unsigned int offset) const;
+     bool endsWith(const String& suffix) const;
+
+     bool operator==(const String& other) const { return equals(other); }
+     bool operator==(const char* other) const { return equals(other); }
+     bool operator!=(const String& other) const { return !equals(other); }
+     bool operator!=(const char* other) const { return !equals(other); }
+     bool operator<(const String& other) const { return value < other.value; }
+     bool operator>(const String& other) const { return value > other.value; }
+     bool operator<=(const String& other) const { return value <= other.value; }
+     bool operator>=(const String& other) const { return value >= other.value; }
+
+     char charAt(unsigned int index) const { return index < value.size() ? value[index] : '\0'; }
+     void setCharAt(unsigned int index, char c) { if (index < value.size()) value[index] = c; }
+     char operator[](unsigned int index) const { return charAt(index); }
+     char& operator[](unsigned int index);
+     void getBytes(unsigned char* buffer, unsigned int size, unsigned int index = 0) const;
+     void toCharArray(char* buffer, unsigned int size, unsigned int index = 0) const {
+         getBytes(reinterpret_cast<unsigned char*>(buffer), size, index);
+     }
+
+     int indexOf(char c, unsigned int from = 0) const;
+     int indexOf(const String& text, unsigned int from = 0) const;
+     int lastIndexOf(char c) const;
+     int lastIndexOf(char c, unsigned int from) const;
+     int lastIndexOf(const String& text) const;
+     int lastIndexOf(const String& text, unsigned int from) const;
+     String substring(unsigned int from) const { return substring(from, length()); }
+     String substring(unsigned int from, unsigned int to) const;
+
+     void replace(char find, char with);
+     void replace(const String& find, const String& with);
+     void remove(unsigned int index);
+     void remove(unsigned int index, unsigned int count);
+     void toLowerCase();
+     void toUpperCase();
+     void trim();
+
+     long toInt() const;
+     float toFloat() const;
+     double toDouble() const;
+
+     friend String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, char b) { String r(a); r.concat(b); return r; }
+     friend String operator+(char a, const String& b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, int b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, unsigned int b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, long b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, unsigned long b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, float b) { String r(a); r.concat(b); return r; }
+     friend String operator+(const String& a, double b) { String r(a); r.concat(b); return r; }
+
+ private:
+     std::string value;
+ };
+
+ inline bool operator==(const char* a, const String& b) { return b.equals(a); }
+ inline bool operator!=(const char* a, const String& b) { return !b.equals(a); }
+
+ // Found by ordinary lookup, as the core's StringSumHelper operators are, so
+ // "literal" + anything convertible to const char* still builds a String
+ String operator+(const String& a, const char* b);
@@ -0,0 +1,54 @@
+/**
+ * @file WiFi.h
+ * @brief Wi-Fi station of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * The simulation has no network: association never completes, so the
+ * telemetry publisher exercises its retry and back-off path.
+ */
+
+ #pragma once
+
+ #include "Arduino.h"
+ #include "WiFiClient.h"
+ #include "WiFiUdp.h"
+
+ typedef enum {
+     WL_IDLE_STATUS = 0,
+     WL_NO_SSID_AVAIL = 1,
+     WL_SCAN_COMPLETED = 2,
+     WL_CONNECTED = 3,
+     WL_CONNECT_FAILED = 4,
+     WL_CONNECTION_LOST = 5,
+     WL_DISCONNECTED = 6
+ } wl_status_t;
+
+ typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+
+ class IPAddress {
+ public:
+     IPAddress() = default;
+     IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+     String toString() const;
+
+ private:
+     uint8_t octets[4] = {};
+ };
+
+ class WiFiClass {
+ public:
+     bool mode(wifi_mode_t mode) { return true; }
+     bool setHostname(const char* name) { return true; }
+     bool setAutoReconnect(bool enable) { return true; }
+     bool setSleep(bool enable) { return true; }
+     wl_status_t begin(const char* ssid, const char* password = nullptr) { return WL_DISCONNECTED; }
+     bool disconnect(bool wifiOff = false, bool eraseAp = false) { return true; }
+     bool reconnect() { return false; }
+     wl_status_t status() { return WL_DISCONNECTED; }
+     IPAddress localIP() { return IPAddress(); }
+     int8_t RSSI() { return 0; }
+ };
+
+ extern WiFiClass WiFi;
@@ -0,0 +1,29 @@
+/**
+ * @file WiFiClient.h
+ * @brief TCP client of the host simulation; never connects
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include "Arduino.h"
+
+ class WiFiClient : public Stream {
+ public:
+     int connect(const char* host, uint16_t port) { return 0; }
+     int connect(const char* host, uint16_t port, int32_t timeoutMs) { return 0; }
+     uint8_t connected() { return 0; }
+     void stop() {}
+     void setNoDelay(bool noDelay) {}
+
+     size_t write(uint8_t c) override { return 0; }
+     size_t write(const uint8_t* buffer, size_t size) override { return 0; }
+     using Print::write;
+     int available() override { return 0; }
+     int read() override { return -1; }
+     int read(uint8_t* buffer, size_t size) { return -1; }
+     int peek() override { return -1; }
+     void flush() override {}
+ };
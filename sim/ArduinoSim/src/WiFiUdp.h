@@ -0,0 +1,27 @@
+/**
+ * @file WiFiUdp.h
+ * @brief UDP socket of the host simulation; packets go nowhere
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include "Arduino.h"
+
+ class WiFiUDP : public Stream {
+ public:
+     uint8_t begin(uint16_t port) { return 0; }
+     void stop() {}
+     int beginPacket(const char* host, uint16_t port) { return 0; }
+     int endPacket() { return 0; }
+
+     size_t write(uint8_t c) override { return 0; }
+     size_t write(const uint8_t* buffer, size_t size) override { return 0; }
+     using Print::write;
+     int available() override { return 0; }
+     int read() override { return -1; }
+     int peek() override { return -1; }
+     void flush() override {}
+ };
@@ -0,0 +1,61 @@
+/**
+ * @file Wire.h
+ * @brief Arduino TwoWire for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Transfers go to the Sim::I2CDevice objects attached to the bus, through
+ * its TCA9548A when one is attached. endTransmission() returns 2 for an
+ * address NACK and 3 for a data NACK, like the ESP32 core; a NACKed read
+ * returns 0 bytes.
+ */
+
+ #pragma once
+
+ #include "Arduino.h"
+
+ #define I2C_BUFFER_LENGTH 128
+
+ class TwoWire : public Stream {
+ public:
+     explicit TwoWire(uint8_t busNum);
+
+     bool begin(int sdaPin = -1, int sclPin = -1, uint32_t frequency = 0);
+     bool end();
+     bool setClock(uint32_t frequency);
+     uint32_t getClock() { return clockHz; }
+     void setTimeOut(uint16_t timeoutMs) { timeout = timeoutMs; }
+     uint16_t getTimeOut() { return timeout; }
+
+     void beginTransmission(uint16_t address);
+     void beginTransmission(int address) { beginTransmission(static_cast<uint16_t>(address)); }
+     uint8_t endTransmission(bool sendStop = true);
+     size_t requestFrom(uint16_t address, size_t size, bool sendStop = true);
+     uint8_t requestFrom(int address, int size) {
+         return static_cast<uint8_t>(requestFrom(static_cast<uint16_t>(address), static_cast<size_t>(size), true));
+     }
+
+     size_t write(uint8_t c) override;
+     size_t write(const uint8_t* buffer, size_t size) override;
+     using Print::write;
+     int available() override { return static_cast<int>(rxLength - rxIndex); }
+     int read() override { return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1; }
+     int peek() override { return rxIndex < rxLength ? rxBuffer[rxIndex] : -1; }
+     void flush() override {}
+
+ private:
+     uint8_t bus;
+     uint32_t clockHz = 100000;
+     uint16_t timeout = 50;
+     bool started = false;
+     uint16_t txAddress = 0;
+     uint8_t txBuffer[I2C_BUFFER_LENGTH] = {};
+     size_t txLength = 0;
+     uint8_t rxBuffer[I2C_BUFFER_LENGTH] = {};
+     size_t rxLength = 0;
+     size_t rxIndex = 0;
+ };
+
+ extern TwoWire Wire;
+ extern TwoWire Wire1;
@@ -0,0 +1,82 @@
+/**
+ * @file spi_master.h
+ * @brief ESP-IDF SPI master driver of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Devices are matched to Sim::SpiDevice objects by spics_io_num. Queued
+ * transactions are carried out in order when their result is collected,
+ * each charged its bits at the device clock plus the device latency.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ #include "../esp_err.h"
+ #include "../freertos/FreeRTOS.h"
+
+ typedef enum { SPI1_HOST = 0, SPI2_HOST = 1, SPI3_HOST = 2 } spi_host_device_t;
+
+ #define SPI_DMA_DISABLED 0
+ #define SPI_DMA_CH_AUTO 3
+ #define SPI_TRANS_USE_RXDATA (1 << 2)
+ #define SPI_TRANS_USE_TXDATA (1 << 3)
+
+ typedef struct spi_device_t* spi_device_handle_t;
+
+ typedef struct {
+     int mosi_io_num;
+     int miso_io_num;
+     int sclk_io_num;
+     int quadwp_io_num;
+     int quadhd_io_num;
+     int max_transfer_sz;
+     uint32_t flags;
+     int intr_flags;
+ } spi_bus_config_t;
+
+ typedef struct {
+     uint8_t command_bits;
+     uint8_t address_bits;
+     uint8_t dummy_bits;
+     uint8_t mode;
+     uint16_t duty_cycle_pos;
+     uint16_t cs_ena_pretrans;
+     uint8_t cs_ena_posttrans;
+     int clock_speed_hz;
+     int input_delay_ns;
+     int spics_io_num;
+     uint32_t flags;
+     int queue_size;
+     void (*pre_cb)(void*);
+     void (*post_cb)(void*);
+ } spi_device_interface_config_t;
+
+ typedef struct spi_transaction_t {
+     uint32_t flags;
+     uint16_t cmd;
+     uint64_t addr;
+     size_t length;       ///< Total length in bits
+     size_t rxlength;     ///< Receive length in bits, 0 for length
+     void* user;
+     union {
+         const void* tx_buffer;
+         uint8_t tx_data[4];
+     };
+     union {
+         void* rx_buffer;
+         uint8_t rx_data[4];
+     };
+ } spi_transaction_t;
+
+ esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dmaChannel);
+ esp_err_t spi_bus_free(spi_host_device_t host);
+ esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config,
+                              spi_device_handle_t* handle);
+ esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+ esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* transaction, TickType_t ticks);
+ esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** transaction, TickType_t ticks);
+ esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* transaction);
+ esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* transaction);
@@ -0,0 +1,16 @@
+/**
+ * @file esp_cpu.h
+ * @brief CPU cycle counter of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include <cstdint>
+
+ /**
+  * @brief Simulated cycles at 240 MHz; wraps like CCOUNT
+  */
+ uint32_t esp_cpu_get_cycle_count();
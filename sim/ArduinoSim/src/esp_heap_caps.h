@@ -0,0 +1,33 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Capability-based allocation of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * PSRAM allocations are served from the host heap and accounted against
+ * a simulated 2 MB, so code that sizes buffers from the free PSRAM, or
+ * falls back when it runs out, behaves as on the N4R2 module.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+
+ #define MALLOC_CAP_EXEC (1 << 0)
+ #define MALLOC_CAP_32BIT (1 << 1)
+ #define MALLOC_CAP_8BIT (1 << 2)
+ #define MALLOC_CAP_DMA (1 << 3)
+ #define MALLOC_CAP_SPIRAM (1 << 10)
+ #define MALLOC_CAP_INTERNAL (1 << 11)
+ #define MALLOC_CAP_DEFAULT (1 << 12)
+
+ void* heap_caps_malloc(size_t size, uint32_t caps);
+ void* heap_caps_calloc(size_t count, size_t size, uint32_t caps);
+ void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps);
+ void heap_caps_free(void* ptr);
+ size_t heap_caps_get_total_size(uint32_t caps);
+ size_t heap_caps_get_free_size(uint32_t caps);
+ size_t heap_caps_get_minimum_free_size(uint32_t caps);
+ size_t heap_caps_get_largest_free_block(uint32_t caps);
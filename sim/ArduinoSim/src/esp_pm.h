@@ -0,0 +1,37 @@
+/**
+ * @file esp_pm.h
+ * @brief Power management of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Configuration is accepted and locks are counted; there is no frequency
+ * to scale. Light sleep is refused like a build without tickless idle,
+ * so the firmware takes its frequency-scaling-only path.
+ */
+
+ #pragma once
+
+ #include <cstdio>
+ #include "esp_err.h"
+
+ typedef struct esp_pm_lock* esp_pm_lock_handle_t;
+
+ typedef enum {
+     ESP_PM_CPU_FREQ_MAX,
+     ESP_PM_APB_FREQ_MAX,
+     ESP_PM_NO_LIGHT_SLEEP,
+ } esp_pm_lock_type_t;
+
+ typedef struct {
+     int max_freq_mhz;
+     int min_freq_mhz;
+     bool light_sleep_enable;
+ } esp_pm_config_esp32s3_t;
+
+ esp_err_t esp_pm_configure(const void* config);
+ esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name, esp_pm_lock_handle_t* handle);
+ esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle);
+ esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle);
+ esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle);
+ esp_err_t esp_pm_dump_locks(FILE* stream);
@@ -0,0 +1,18 @@
+/**
+ * @file esp_sntp.h
+ * @brief SNTP client of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include <sys/time.h>
+
+ typedef void (*sntp_sync_time_cb_t)(struct timeval* tv);
+
+ /**
+  * @brief Register the sync callback; never called, the simulation is offline
+  */
+ inline void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {}
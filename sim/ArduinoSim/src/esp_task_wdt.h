@@ -0,0 +1,23 @@
+/**
+ * @file esp_task_wdt.h
+ * @brief Task watchdog of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Subscriptions are tracked and checked on every reset; a subscribed task
+ * silent for longer than the timeout is reported on stderr instead of
+ * resetting the process.
+ */
+
+ #pragma once
+
+ #include "esp_err.h"
+ #include "freertos/FreeRTOS.h"
+ #include "freertos/task.h"
+
+ esp_err_t esp_task_wdt_init(uint32_t timeoutSeconds, bool panic);
+ esp_err_t esp_task_wdt_add(TaskHandle_t task);
+ esp_err_t esp_task_wdt_delete(TaskHandle_t task);
+ esp_err_t esp_task_wdt_reset();
+ esp_err_t esp_task_wdt_status(TaskHandle_t task);
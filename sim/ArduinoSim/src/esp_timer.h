@@ -0,0 +1,16 @@
+/**
+ * @file esp_timer.h
+ * @brief High-resolution timer of the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include <cstdint>
+
+ /**
+  * @brief Simulated microseconds since start
+  */
+ int64_t esp_timer_get_time();
@@ -0,0 +1,73 @@
+/**
+ * @file FreeRTOS.h
+ * @brief FreeRTOS types and port macros for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Mirrors the ESP-IDF 4.4 dual-core port closely enough for the firmware
+ * to compile unchanged. Tasks run as host threads, one tick is one
+ * simulated millisecond, and critical sections are per-mux recursive
+ * spinlocks instead of interrupt masking.
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+
+ typedef int BaseType_t;
+ typedef unsigned int UBaseType_t;
+ typedef uint32_t TickType_t;
+ typedef uint8_t StackType_t;
+
+ #define pdTRUE 1
+ #define pdFALSE 0
+ #define pdPASS pdTRUE
+ #define pdFAIL pdFALSE
+ #define errQUEUE_EMPTY pdFALSE
+ #define errQUEUE_FULL pdFALSE
+
+ #define configTICK_RATE_HZ 1000
+ #define configMAX_PRIORITIES 25
+ #define configMAX_TASK_NAME_LEN 16
+ #define configUSE_TRACE_FACILITY 1
+ #define configGENERATE_RUN_TIME_STATS 1
+
+ #define portMAX_DELAY ((TickType_t)0xffffffffUL)
+ #define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+ #define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+ #define pdTICKS_TO_MS(ticks) ((uint32_t)(((uint64_t)(ticks) * 1000) / configTICK_RATE_HZ))
+
+ #define portNUM_PROCESSORS 2
+ #define tskNO_AFFINITY ((BaseType_t)0x7FFFFFFF)
+ #define tskIDLE_PRIORITY 0
+
+ /**
+  * @brief Critical section lock
+  * Recursive for the owning thread, like the ESP-IDF spinlock, so nested
+  * sections on the same mux work.
+  */
+ typedef struct {
+     std::atomic<uint32_t> owner;   ///< Owning thread token, 0 when free
+     uint32_t count;                ///< Recursion depth of the owner
+ } portMUX_TYPE;
+
+ #define portMUX_INITIALIZER_UNLOCKED {0, 0}
+
+ void vPortEnterCritical(portMUX_TYPE* mux);
+ void vPortExitCritical(portMUX_TYPE* mux);
+ BaseType_t xPortGetCoreID();
+ BaseType_t xPortInIsrContext();
+
+ #define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+ #define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+ #define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+ #define portEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+ #define taskENTER_CRITICAL(mux) vPortEnterCritical(mux)
+ #define taskEXIT_CRITICAL(mux) vPortExitCritical(mux)
+ #define portYIELD_FROM_ISR(woken) (void)(woken)
+ #define portYIELD() vPortYield()
+
+ void vPortYield();
@@ -0,0 +1,27 @@
+/**
+ * @file queue.h
+ * @brief FreeRTOS queue API for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ */
+
+ #pragma once
+
+ #include "FreeRTOS.h"
+
+ typedef struct QueueDefinition* QueueHandle_t;
+
+ QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+ void vQueueDelete(QueueHandle_t queue);
+ BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks);
+ BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticks);
+ BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks);
+ BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken);
+ BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item);
+ BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks);
+ BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void* item, BaseType_t* woken);
+ BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks);
+ BaseType_t xQueueReset(QueueHandle_t queue);
+ UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+ UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
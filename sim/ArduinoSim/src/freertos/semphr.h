@@ -0,0 +1,31 @@
+/**
+ * @file semphr.h
+ * @brief FreeRTOS semaphore and mutex API for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Semaphores are queues of zero-size items, as in FreeRTOS, so the same
+ * handle type and vSemaphoreDelete() work for both.
+ */
+
+ #pragma once
+
+ #include "queue.h"
+ #include "task.h"
+
+ typedef QueueHandle_t SemaphoreHandle_t;
+
+ SemaphoreHandle_t xSemaphoreCreateMutex();
+ SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+ SemaphoreHandle_t xSemaphoreCreateBinary();
+ SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount);
+ void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+ BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+ BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+ BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks);
+ BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore);
+ BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken);
+ BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken);
+ UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore);
+ TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t semaphore);
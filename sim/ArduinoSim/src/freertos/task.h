@@ -0,0 +1,69 @@
+/**
+ * @file task.h
+ * @brief FreeRTOS task API for the host simulation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup simulation
+ *
+ * Every task is a host thread. Priorities and core affinity are recorded
+ * and reported but scheduling is left to the host, so the simulation
+ * finds ordering bugs and throughput limits, not priority inversions.
+ * Delays and timeouts are in simulated time (see Sim::setTimeScale()).
+ */
+
+ #pragma once
+
+ #include "FreeRTOS.h"
+
+ typedef struct tskTaskControlBlock* TaskHandle_t;
+ typedef void (*TaskFunction_t)(void*);
+
+ typedef enum { eRunning = 0, eReady, eBlocked, eSuspended, eDeleted, eInvalid } eTaskState;
+ typedef enum { eNoAction = 0, eSetBits, eIncrement, eSetValueWithOverwrite, eSetValueWithoutOverwrite } eNotifyAction;
+
+ /**
+  * @brief One task in a uxTaskGetSystemState() snapshot
+  */
+ typedef struct xTASK_STATUS {
+     TaskHandle_t xHandle;
+     const char* pcTaskName;
+     UBaseType_t xTaskNumber;
+     eTaskState eCurrentState;
+     UBaseType_t uxCurrentPriority;
+     UBaseType_t uxBasePriority;
+     uint32_t ulRunTimeCounter;       ///< Thread CPU time in microseconds
+     StackType_t* pxStackBase;
+     uint32_t usStackHighWaterMark;
+     BaseType_t xCoreID;
+ } TaskStatus_t;
+
+ BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameters,
+                                    UBaseType_t priority, TaskHandle_t* created, BaseType_t core);
+ BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth, void* parameters,
+                        UBaseType_t priority, TaskHandle_t* created);
+ void vTaskDelete(TaskHandle_t task);
+ void vTaskDelay(TickType_t ticks);
+ BaseType_t xTaskDelayUntil(TickType_t* previousWake, TickType_t increment);
+ void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment);
+ void vTaskSuspend(TaskHandle_t task);
+ void vTaskResume(TaskHandle_t task);
+
+ TickType_t xTaskGetTickCount();
+ TickType_t xTaskGetTickCountFromISR();
+ TaskHandle_t xTaskGetCurrentTaskHandle();
+ TaskHandle_t xTaskGetIdleTaskHandleForCPU(UBaseType_t core);
+ const char* pcTaskGetName(TaskHandle_t task);
+ eTaskState eTaskGetState(TaskHandle_t task);
+ BaseType_t xTaskGetAffinity(TaskHandle_t task);
+ UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+ void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority);
+ UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+ UBaseType_t uxTaskGetNumberOfTasks();
+ UBaseType_t uxTaskGetSystemState(TaskStatus_t* statuses, UBaseType_t max, uint32_t* totalRunTime);
+
+ BaseType_t xTaskNotifyGive(TaskHandle_t task);
+ void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken);
+ uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+ BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+ BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action, BaseType_t* woken);
+ BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value, TickType_t ticks);
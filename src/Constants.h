@@ -11,6 +11,18 @@
 
  #pragma once
 
+ #include <cstddef>
+
+ /**
+  * @brief Number of sensor slots compiled into the image
+  * The board carries 16; the native load-test build raises it with
+  * -DMAX_SENSOR_SLOTS. History and SCPI slot masks are 32 bits wide.
+  */
+ #ifndef MAX_SENSOR_SLOTS
+ #define MAX_SENSOR_SLOTS 16
+ #endif
+ static_assert(MAX_SENSOR_SLOTS > 0 && MAX_SENSOR_SLOTS <= 32, "Slot masks are 32 bits wide");
+
  namespace Constants {
      /** 
       * @name Product identification
@@ -25,6 +37,7 @@
       * @{
       */
      static const char* CONFIG_FILE_PATH = "/config.json";
+     static const char* CONFIG_TEMP_FILE_PATH = "/config.json.tmp";   ///< Written first, then renamed over the config
      /** @} */
      
      /** 
@@ -34,64 +47,104 @@
      static const char* CONFIG_MONITOR_ID = "Environment Monitor ID";
      static const char* CONFIG_I2C_SENSORS = "I2C Peripherals";
      static const char* CONFIG_SPI_SENSORS = "SPI Peripherals";
+     static const char* CONFIG_I2C_CLOCK_LIMITS = "I2C Clock Limits";
+     static const char* CONFIG_TELEMETRY = "Telemetry";
+     static const char* CONFIG_TASKS = "Tasks";
      /** @} */
      
      /**
       * @brief SCPI command tokens used in communication
+      * Written in SCPI notation: the upper-case part of each node is its
+      * short form, the whole node its long form, and either is accepted.
       */
      namespace SCPI {
          /** 
           * @name System identification
           * @{
           */
-         static const char* IDN = "*IDN?";
+         static constexpr const char* IDN = "*IDN?";
          /** @} */
          
          /** 
           * @name Measurement commands
           * @{
           */
-         static const char* MEASURE_QUERY = "MEAS?";
+         static constexpr const char* MEASURE_QUERY = "MEASure?";
+         static constexpr const char* MEASURE_FRESH = "MEASure:FRESh?";              ///< Format: MEAS:FRES? [sensor[:measurements] ...]
+         static constexpr const char* MEASURE_AGE = "MEASure:AGE?";                  ///< Format: MEAS:AGE? [sensor[:measurements] ...]
+         static constexpr const char* MEASURE_QUALITY = "MEASure:QUALity?";          ///< Format: MEAS:QUAL? [sensor[:measurements] ...]
+         static constexpr const char* MEASURE_HISTORY = "MEASure:HISTory?";            ///< Format: MEAS:HIST? <after sequence> [sensor ...]
+         static constexpr const char* MEASURE_HISTORY_TIME = "MEASure:HISTory:TIME?";  ///< Format: MEAS:HIST:TIME? <from ms> [sensor ...]
+         static constexpr const char* MEASURE_STREAM = "MEASure:STReam";            ///< Format: MEAS:STREAM ON[,<period ms>] | OFF
+         static constexpr const char* MEASURE_STREAM_QUERY = "MEASure:STReam?";     ///< Get streaming state and period
+         static constexpr const char* MEASURE_STREAM_MAP = "MEASure:STReam:MAP?";   ///< List channel ids used in stream frames
          /** @} */
          
          /** 
           * @name System commands
           * @{
           */
-         static const char* LIST_SENSORS = "SYST:SENS:LIST?";
-         static const char* GET_CONFIG = "SYST:CONF?";
-         static const char* SET_BOARD_ID = "SYST:CONF:BOARD:ID";
-         static const char* UPDATE_CONFIG = "SYST:CONF:UPDATE";
-         static const char* UPDATE_SENSOR_CONFIG = "SYST:CONF:SENS:UPDATE";
-         static const char* UPDATE_ADDITIONAL_CONFIG = "SYST:CONF:ADD:UPDATE";
+         static constexpr const char* LIST_SENSORS = "SYSTem:SENSor:LIST?";
+         static constexpr const char* SENSOR_HEALTH = "SYSTem:SENSor:HEALth?";  ///< One line per sensor: name,state,failed attempts,retry in ms,for ms
+         static constexpr const char* GET_CONFIG = "SYSTem:CONFigure?";
+         static constexpr const char* SET_BOARD_ID = "SYSTem:CONFigure:BOARD:ID";
+         static constexpr const char* UPDATE_CONFIG = "SYSTem:CONFigure:UPDate";
+         static constexpr const char* UPDATE_SENSOR_CONFIG = "SYSTem:CONFigure:SENSor:UPDate";
+         static constexpr const char* UPDATE_ADDITIONAL_CONFIG = "SYSTem:CONFigure:ADDitional:UPDate";
+         static constexpr const char* I2C_SCAN = "SYSTem:I2C:SCAN?";   ///< One line per bus and mux channel in use: bus,count,addresses...
+         static constexpr const char* I2C_CLOCK = "SYSTem:I2C:CLOCk";  ///< Format: SYST:I2C:CLOC <bus>,<limit Hz>
+         static constexpr const char* I2C_CLOCK_QUERY = "SYSTem:I2C:CLOCk?";  ///< One line per bus: bus,clock,limit,transactions,errors,fallbacks,mux switches,mux skips
          /** @} */
          
          /** 
           * @name Message routing commands - simplified
           * @{
           */
-         static const char* LOG_ROUTE = "SYST:LOG";        ///< Format: SYST:LOG <destination>,<severity>
-         static const char* LOG_STATUS = "SYST:LOG?";      ///< Get current log routing settings
+         static constexpr const char* LOG_ROUTE = "SYSTem:LOG";        ///< Format: SYST:LOG <destination>,<severity>
+         static constexpr const char* LOG_STATUS = "SYSTem:LOG?";      ///< Get current log routing settings
+         static constexpr const char* LOG_HISTORY = "SYSTem:LOG:HISTory?";  ///< Format: SYST:LOG:HIST? <after sequence> [max entries]
+         /** @} */
+         
+         /** 
+          * @name Performance counter commands
+          * @{
+          */
+         static constexpr const char* PERF_QUERY = "SYSTem:PERFormance?";        ///< One line per site: site,count,min_us,p50_us,p99_us,max_us
+         static constexpr const char* PERF_RESET = "SYSTem:PERFormance:RESet";   ///< Clear all histograms
+         static constexpr const char* MEMORY_QUERY = "SYSTem:MEMory?";          ///< Heap state and per-subsystem use, one line each
+         static constexpr const char* TASK_QUERY = "SYSTem:TASK?";              ///< Per-task CPU, stack and supervision state, then per-core load
+         static constexpr const char* TASK_CONFIG_QUERY = "SYSTem:TASK:CONFig?";  ///< role,core,priority,stack per task role
+         static constexpr const char* TASK_PRIORITY = "SYSTem:TASK:PRIority";    ///< Format: SYST:TASK:PRI <role>,<priority>
+         static constexpr const char* TASK_CORE = "SYSTem:TASK:CORE";           ///< Format: SYST:TASK:CORE <role>,<core|ANY>
+         static constexpr const char* BENCHMARK = "SYSTem:BENCHmark";           ///< Format: SYST:BENCH [ms per phase]
+         /** @} */
+         
+         /** 
+          * @name Time synchronization commands
+          * @{
+          */
+         static constexpr const char* TIME_SET = "SYSTem:TIME";       ///< Format: SYST:TIME <epoch us>
+         static constexpr const char* TIME_QUERY = "SYSTem:TIME?";    ///< epoch us,device us,source,drift ppb,syncs
          /** @} */
          
          /** 
           * @name Test commands
           * @{
           */
-         static const char* TEST = "TEST";
-         static const char* ECHO = "ECHO";
-         static const char* RESET = "RESET";
-         static const char* TEST_INFO = "TEST:INFO";
-         static const char* TEST_WARNING = "TEST:WARNING";
-         static const char* TEST_ERROR = "TEST:ERROR";
-         static const char* TEST_FATAL = "TEST:FATAL";
+         static constexpr const char* TEST = "TEST";
+         static constexpr const char* ECHO = "ECHO";
+         static constexpr const char* RESET = "RESet";
+         static constexpr const char* TEST_INFO = "TEST:INFO";
+         static constexpr const char* TEST_WARNING = "TEST:WARNing";
+         static constexpr const char* TEST_ERROR = "TEST:ERRor";
+         static constexpr const char* TEST_FATAL = "TEST:FATal";
          /** @} */
          
          /** 
           * @name LED control commands
           * @{
           */
-         static const char* LED_IDENTIFY = "SYST:LED:IDENT";
+         static constexpr const char* LED_IDENTIFY = "SYSTem:LED:IDENTify";
          /** @} */
      }
      
@@ -106,6 +159,24 @@
          static const size_t MAX_COMMAND_BUFFER_SIZE = 4096;      ///< Maximum size of command buffers
      }
      
+     /**
+      * @brief Device-to-wall-clock time mapping
+      */
+     namespace Time {
+         static const uint64_t MIN_DRIFT_INTERVAL_US = 60000000ULL;   ///< Shortest gap between syncs used to estimate drift
+         static const int32_t MAX_DRIFT_PPB = 200000;                 ///< Larger apparent rates are clock steps, not drift
+         static const int32_t DRIFT_SMOOTHING = 4;                    ///< Each estimate moves 1/DRIFT_SMOOTHING of the way
+         static const char* DEFAULT_NTP_SERVER = "pool.ntp.org";
+     }
+     
+     /**
+      * @brief Configuration write-back timing
+      */
+     namespace Config {
+         static const uint32_t WRITE_DEBOUNCE_MS = 2000;    ///< Write once changes stop arriving for this long
+         static const uint32_t WRITE_MAX_DELAY_MS = 10000;  ///< Never hold unsaved changes longer than this
+     }
+     
      /**
       * @brief FreeRTOS task configuration constants
       */
@@ -117,6 +188,11 @@
          static const uint32_t STACK_SIZE_SENSOR = 6144;
          static const uint32_t STACK_SIZE_COMM = 6144;
          static const uint32_t STACK_SIZE_LED = 3072;
+         static const uint32_t STACK_SIZE_LOG = 4096;
+         static const uint32_t STACK_SIZE_PROBE = 3072;
+         static const uint32_t STACK_SIZE_RECOVERY = 4096;
+         static const uint32_t STACK_SIZE_TELEMETRY = 6144;
+         static const uint32_t STACK_SIZE_SUPERVISOR = 4096;
          /** @} */
          
          /** 
@@ -126,6 +202,11 @@
          static const UBaseType_t PRIORITY_SENSOR = 2;
          static const UBaseType_t PRIORITY_COMM = 3;
          static const UBaseType_t PRIORITY_LED = 1;
+         static const UBaseType_t PRIORITY_LOG = 1;
+         static const UBaseType_t PRIORITY_PROBE = 2;
+         static const UBaseType_t PRIORITY_RECOVERY = 1;   ///< Below the acquisition workers so retries never delay a poll
+         static const UBaseType_t PRIORITY_TELEMETRY = 1;  ///< Below the comm task so network stalls never delay a command
+         static const UBaseType_t PRIORITY_SUPERVISOR = 4; ///< Above every supervised task so a busy core cannot hide a stall
          /** @} */
          
          /** 
@@ -135,9 +216,53 @@
          static const BaseType_t CORE_SENSOR = 0;
          static const BaseType_t CORE_COMM = 1;
          static const BaseType_t CORE_LED = 0;
+         static const BaseType_t CORE_LOG = 0;
+         static const BaseType_t CORE_RECOVERY = 0;
+         static const BaseType_t CORE_TELEMETRY = 1;       ///< With the comm task, away from acquisition
+         static const BaseType_t CORE_SUPERVISOR = 1;      ///< Away from acquisition
+         /** @} */
+         
+         /** 
+          * @name Supervision and task watchdog
+          * Supervised tasks never block longer than WATCHDOG_FEED_MS, and are
+          * reported stalled once they are STALL_GRACE_MS past the time they
+          * said they would check in again.
+          * @{
+          */
+         static const uint32_t SUPERVISOR_PERIOD_MS = 1000;   ///< Stall check and CPU accounting window
+         static const uint32_t WATCHDOG_TIMEOUT_S = 10;       ///< Task watchdog timeout; a task silent this long resets the chip
+         static const uint32_t WATCHDOG_FEED_MS = 2000;       ///< Longest block between check-ins
+         static const uint32_t STALL_GRACE_MS = 1000;         ///< Work allowed between waking and the next check-in
+         static const uint32_t STALL_GRACE_SLOW_MS = 7000;    ///< Grace for tasks doing blocking network or bus I/O
+         static const size_t MAX_SUPERVISED_TASKS = 12;       ///< Tasks that can check in with the supervisor
+         static const size_t MAX_SYSTEM_TASKS = 32;           ///< Tasks covered by CPU accounting, including the system's
+         /** @} */
+         
+         /** 
+          * @name Limits for configured placement
+          * @{
+          */
+         static const uint32_t MIN_STACK_SIZE = 2048;
+         static const uint32_t MAX_STACK_SIZE = 32768;
+         static const UBaseType_t MAX_TASK_PRIORITY = 20;     ///< Below the IDF system tasks (esp_timer, ipc)
          /** @} */
      }
      
+     /**
+      * @brief Deferred logging configuration constants
+      */
+     namespace Logging {
+         static const size_t QUEUE_DEPTH = 32;              ///< Records buffered for the log task (power of two)
+         static const size_t MAX_RECORD_ARGS = 4;           ///< Format arguments stored per record
+         static const size_t RECORD_TEXT_SIZE = 128;        ///< Bytes for string arguments or a preformatted message
+         static const size_t LINE_BUFFER_SIZE = 192;        ///< Longest formatted log line
+         static const uint32_t DRAIN_INTERVAL_MS = 100;     ///< Log task wake-up interval when idle
+         static const size_t HISTORY_DEPTH = 1024;          ///< Log history entries kept in PSRAM
+         static const size_t HISTORY_DEPTH_INTERNAL = 20;   ///< Log history entries when PSRAM is unavailable
+         static const size_t HISTORY_MESSAGE_SIZE = 116;    ///< Message bytes stored per history entry
+         static const size_t HISTORY_MAX_FETCH = 256;       ///< Entries returned by one SYST:LOG:HIST? query
+     }
+     
      /**
       * @brief LED-related configuration constants
       */
@@ -171,6 +296,35 @@
          static const unsigned long WARNING_ERROR_DURATION_MS = 2000;
          static const unsigned long PULSE_DURATION_MS = 100;
          /** @} */
+         
+         /** 
+          * @name Command queue
+          * @{
+          */
+         static const UBaseType_t COMMAND_QUEUE_DEPTH = 16;   ///< Pending commands; reading pulses coalesce to one
+         /** @} */
+     }
+     
+     /**
+      * @brief Power management constants
+      */
+     namespace Power {
+         /** 
+          * @name Dynamic frequency scaling
+          * The minimum keeps APB at 80 MHz, so bus and UART clocks are
+          * unaffected by frequency changes.
+          * @{
+          */
+         static const int MAX_CPU_FREQ_MHZ = 240;          ///< CPU clock while any task is busy
+         static const int MIN_CPU_FREQ_MHZ = 80;           ///< CPU clock when every task is blocked
+         /** @} */
+         
+         /** 
+          * @name Idle wake-ups in low-power mode
+          * @{
+          */
+         static const uint32_t IDLE_WAKE_MS = 5000;        ///< Longest backstop sleep of the log and recovery tasks
+         /** @} */
      }
      
      /**
@@ -186,12 +340,84 @@
          static const int MAX_I2C_RECOVERY_ATTEMPTS = 5;
          /** @} */
          
+         /** 
+          * @name Recovery of disconnected sensors
+          * @{
+          */
+         static const uint32_t RECOVERY_BACKOFF_MIN_MS = 1000;     ///< Wait after the first failed attempt
+         static const uint32_t RECOVERY_BACKOFF_MAX_MS = 300000;   ///< Longest wait between attempts (5 minutes)
+         static const uint32_t RECOVERY_CHECK_MS = 1000;           ///< How often the recovery worker looks for dropouts
+         static const int I2C_RECOVERY_CLOCKS = 9;                 ///< SCL pulses to release a device holding SDA low
+         static const size_t RECOVERY_QUEUE_DEPTH = 8;             ///< Recovery attempts each bus worker can have queued
+         static const uint32_t RECOVERY_REPLY_TIMEOUT_MS = 2000;   ///< Longest the recovery worker waits for a bus worker's attempt
+         /** @} */
+         
+         /** 
+          * @name Conversion timing
+          * @{
+          */
+         static const uint32_t CONVERSION_TIMEOUT_MS = 500;   ///< Give up on a conversion after this long
+         static const uint32_t SHT41_CONVERSION_MS = 10;      ///< High-precision measurement (8.2 ms max)
+         static const uint32_t SI7021_CONVERSION_MS = 25;     ///< 12-bit RH plus 14-bit temperature (22.8 ms max)
+         static const uint32_t MAX31865_BIAS_SETTLE_MS = 10;  ///< Bias voltage settling before a one-shot
+         static const uint32_t MAX31865_CONVERSION_MS = 65;   ///< One-shot conversion with 50 Hz filter (62.5 ms)
+         static const uint32_t MAX31865_AUTO_PERIOD_50HZ_MS = 20;  ///< Continuous conversion period, 50 Hz filter
+         static const uint32_t MAX31865_AUTO_PERIOD_60HZ_MS = 17;  ///< Continuous conversion period, 60 Hz filter (16.7 ms)
+         static const uint32_t MAX31865_DRDY_MISSED_PERIODS = 3;   ///< Read the registers anyway after this many silent periods
+         /** @} */
+         
          /** 
           * @name Caching
           * @{
           */
          static const unsigned long DEFAULT_MAX_CACHE_AGE_MS = 5000;
          static const unsigned long MIN_CACHE_AGE_MS = 50;
+         static const size_t MAX_READ_WAITERS = 4;      ///< Tasks that may wait for on-demand reads at once
+         /** @} */
+         
+         /** 
+          * @name Registry capacity
+          * @{
+          */
+         static const size_t MAX_SENSORS = MAX_SENSOR_SLOTS;     ///< Number of reading slots / registered sensors
+         static const size_t MAX_REGISTRY_READERS = 5; ///< Tasks that may read the registry lock-free
+         static const uint32_t RECLAIM_WAIT_MS = 1000;  ///< How long a reconfiguration waits to free old sensors
+         /** @} */
+         
+         /** 
+          * @name Sensor storage
+          * @{
+          */
+         static const size_t MAX_NAME_LENGTH = 31;      ///< Longest sensor name, stored inline in each sensor
+         static const size_t POOL_SPARE_BLOCKS = 4;     ///< Pool blocks beyond the configured sensors, for reconfiguration
+         /** @} */
+         
+         /** 
+          * @name Reading history
+          * @{
+          */
+         static const size_t HISTORY_DEPTH = 2048;            ///< Records per sensor in PSRAM (1 MB total)
+         static const size_t HISTORY_CHANNELS = 4;            ///< Channels stored per record; no driver provides more
+         static const size_t HISTORY_DEPTH_INTERNAL = 64;     ///< Records per sensor if PSRAM is unavailable
+         static const size_t HISTORY_MAX_FETCH_RECORDS = 1024; ///< Records returned by one history query
+         /** @} */
+         
+         /** 
+          * @name Sample filtering
+          * @{
+          */
+         static const size_t FILTER_MAX_WINDOW = 16;          ///< Longest boxcar or median window
+         static const uint16_t FILTER_MAX_DECIMATION = 1000;  ///< Largest input-to-output sample ratio
+         /** @} */
+         
+         /** 
+          * @name Sample quality checks
+          * @{
+          */
+         static const uint16_t QUALITY_WINDOW = 32;           ///< Samples the running mean and variance remember
+         static const uint16_t QUALITY_WARMUP = 8;            ///< Samples before the outlier check applies
+         static const uint8_t QUALITY_RELOCK_SAMPLES = 3;     ///< Rate or outlier rejections in a row taken as a real step
+         static const float QUALITY_SIGMA_FLOOR = 0.001f;     ///< Smallest standard deviation, as a fraction of the channel's range
          /** @} */
          
          /** 
@@ -199,7 +425,30 @@
           * @{
           */
          static const uint32_t DEFAULT_I2C_CLOCK_FREQ = 100000;
-         static const uint32_t I2C_RECOVERY_INTERVAL_MS = 5000;
+         static const uint32_t DEFAULT_I2C_CLOCK_LIMIT = 400000;  ///< Fastest clock negotiated unless config.json says otherwise
+         static const uint32_t MIN_I2C_CLOCK_FREQ = 10000;        ///< Slowest clock accepted from config or SCPI
+         static const uint32_t MAX_I2C_CLOCK_FREQ = 1000000;      ///< Fastest clock accepted from config or SCPI
+         static const uint32_t I2C_CLOCK_WINDOW = 50;             ///< Transactions per error-rate evaluation
+         static const uint32_t I2C_CLOCK_FALLBACK_ERRORS = 5;     ///< Failures per window that force a slower clock
+         static const uint8_t I2C_MUX_ADDRESS = 0x70;             ///< TCA9548A address (A0-A2 low), one multiplexer per bus
+         static const uint8_t I2C_MUX_CHANNELS = 8;               ///< Downstream channels of a TCA9548A
+         static const uint32_t I2C_MUX_MAX_CLOCK = 400000;        ///< Fastest clock the TCA9548A is specified for
+         /** @} */
+         
+         /** 
+          * @name Bus arbitration
+          * @{
+          */
+         static const uint32_t BUS_LOCK_TIMEOUT_MS = 1000;   ///< Longest wait for another task to release a bus
+         /** @} */
+         
+         /** 
+          * @name SPI transport
+          * @{
+          */
+         static const uint32_t SPI_DEFAULT_CLOCK_HZ = 1000000;   ///< Clock of devices attached without one
+         static const size_t SPI_MAX_BATCH = 8;                  ///< Transfers queued at once, two per RTD channel
+         static const size_t SPI_MAX_TRANSFER_BYTES = 16;        ///< Longest single transfer; the MAX31865 needs 9
          /** @} */
      }
      
@@ -220,15 +469,79 @@
           */
          static const size_t MAX_BUFFER_SIZE = 4096;
          static const size_t MAX_RESPONSE_SIZE = 1024;
+         static const size_t STREAM_BUFFER_SIZE = 352;    ///< Binary stream buffer (16 frames)
+         /** @} */
+         
+         /** 
+          * @name Binary streaming
+          * @{
+          */
+         static const uint32_t STREAM_DEFAULT_PERIOD_MS = 100;
+         static const uint32_t STREAM_MIN_PERIOD_MS = 10;
+         static const uint32_t STREAM_MAX_PERIOD_MS = 60000;
+         /** @} */
+         
+         /** 
+          * @name Communication task wakeups
+          * @{
+          */
+         static const uint32_t IDLE_WAKE_MS = 1000;       ///< Longest sleep without input, as a backstop for missed RX events
+         /** @} */
+         
+         /** 
+          * @name On-demand reads
+          * @{
+          */
+         static const uint32_t MEASURE_READ_TIMEOUT_MS = 250;   ///< Longest a query waits for the reads it requested
+         /** @} */
+         
+         /** 
+          * @name Self-benchmark (SYST:BENCH)
+          * @{
+          */
+         static const uint32_t BENCH_DEFAULT_PHASE_MS = 2000;   ///< Length of each load phase
+         static const uint32_t BENCH_MIN_PHASE_MS = 200;
+         static const uint32_t BENCH_MAX_PHASE_MS = 10000;
+         static const uint32_t BENCH_KEEPALIVE_MS = 100;        ///< Check-in and heap sampling interval during a phase
+         /** @} */
+     }
+     
+     /**
+      * @brief Network telemetry constants
+      */
+     namespace Telemetry {
+         /** 
+          * @name Publishing
+          * @{
+          */
+         static const uint32_t DEFAULT_INTERVAL_MS = 10000;
+         static const uint32_t MIN_INTERVAL_MS = 100;
+         static const uint32_t MAX_INTERVAL_MS = 3600000;
+         static const uint16_t DEFAULT_UDP_PORT = 8089;     ///< InfluxDB/Telegraf UDP listener
+         static const uint16_t DEFAULT_MQTT_PORT = 1883;
+         /** @} */
+         
+         /** 
+          * @name Batching and offline queue
+          * Unsent readings stay in the reading history, so the queue costs
+          * no extra memory; MAX_BACKLOG_RECORDS bounds how far back a
+          * reconnect catches up.
+          * @{
+          */
+         static const size_t PAYLOAD_BUFFER_SIZE = 1400;     ///< One batch; fits an unfragmented UDP datagram
+         static const size_t MAX_BATCH_RECORDS = 32;         ///< Readings considered for one batch
+         static const size_t MAX_BATCHES_PER_PUBLISH = 16;   ///< Batches sent per interval while catching up
+         static const uint32_t MAX_BACKLOG_RECORDS = 4096;   ///< Older unsent readings are dropped
          /** @} */
          
          /** 
-          * @name Reading retry constants
+          * @name Reconnection
           * @{
           */
-         static const int MAX_READING_RETRIES = 4;
-         static const int READING_RETRY_DELAY_MS = 5;
-         static const int COMMAND_TIMEOUT_MS = 200;
+         static const uint32_t RECONNECT_BACKOFF_MIN_MS = 1000;
+         static const uint32_t RECONNECT_BACKOFF_MAX_MS = 60000;
+         static const uint32_t CONNECT_TIMEOUT_MS = 3000;    ///< Broker TCP connect and CONNACK wait
+         static const uint16_t MQTT_KEEPALIVE_S = 60;
          /** @} */
      }
      
@@ -0,0 +1,158 @@
+#include "BinaryStreamer.h"
+#include <cstring>
+
+namespace {
+    void putUint32(uint8_t* dest, uint32_t value) {
+        dest[0] = value & 0xFF;
+        dest[1] = (value >> 8) & 0xFF;
+        dest[2] = (value >> 16) & 0xFF;
+        dest[3] = (value >> 24) & 0xFF;
+    }
+
+    void putUint64(uint8_t* dest, uint64_t value) {
+        putUint32(dest, static_cast<uint32_t>(value));
+        putUint32(dest + 4, static_cast<uint32_t>(value >> 32));
+    }
+}
+
+BinaryStreamer::BinaryStreamer(SensorManager* sensorMgr, Print* out)
+    : sensorManager(sensorMgr),
+      output(out),
+      active(false),
+      periodMs(Constants::Communication::STREAM_DEFAULT_PERIOD_MS),
+      lastPushTime(0),
+      lastSequence(0),
+      reportGeneration(0),
+      bytesSent(0),
+      used(0) {
+}
+
+void BinaryStreamer::start(uint32_t period) {
+    periodMs = constrain(period, Constants::Communication::STREAM_MIN_PERIOD_MS,
+                         Constants::Communication::STREAM_MAX_PERIOD_MS);
+    lastSequence = sensorManager->getHistory().getLatestSequence();
+    lastPushTime = millis();
+    used = 0;
+    resetReports();
+    active = true;
+}
+
+void BinaryStreamer::stop() {
+    active = false;
+    used = 0;
+}
+
+uint32_t BinaryStreamer::msUntilDue() const {
+    if (!active) {
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = millis() - lastPushTime;
+    return elapsed >= periodMs ? 0 : periodMs - elapsed;
+}
+
+void BinaryStreamer::service() {
+    if (!active || millis() - lastPushTime < periodMs) {
+        return;
+    }
+    lastPushTime = millis();
+
+    // Slots may have changed owner; start every channel afresh
+    if (sensorManager->getTopologyGeneration() != reportGeneration) {
+        resetReports();
+    }
+
+    const SensorRegistry& registry = sensorManager->getRegistry();
+    const TimeSync& timeSync = sensorManager->getTimeSync();
+    sensorManager->getHistory().fetch(lastSequence, 0, 0xFFFFFFFFUL,
+        Constants::Sensors::HISTORY_MAX_FETCH_RECORDS,
+        [&](const HistoryRecord& record) {
+            lastSequence = record.sequence;
+            ISensor* sensor = registry.getSensorBySlot(record.slot);
+            if (!sensor) {
+                return;
+            }
+
+            const ReportSettings& report = sensorManager->getReportSettings(record.slot);
+            uint64_t timeUs = timeSync.reportTimeUs(record.timeUs);
+            record.forEachValue([&](InterfaceType type, float value, bool valid) {
+                uint8_t channel = channelId(record.slot, type);
+                // An invalid value is sent as stored, with its quality code in the NaN
+                float reported = valid ? value * channelDescriptor(type).scale : value;
+                if (shouldReport(channel, valid, reported, record.timestampMs(), report.deadbandFor(type),
+                                 report.heartbeatMs)) {
+                    queueFrame(record.sequence, timeUs, channel, reported);
+                }
+            });
+        });
+
+    flushBuffer();
+}
+
+bool BinaryStreamer::shouldReport(uint8_t channel, bool valid, float value, uint32_t timestamp,
+                                  float deadband, uint32_t heartbeatMs) {
+    if (channel >= sizeof(reports) / sizeof(reports[0])) {
+        return true;
+    }
+
+    ChannelReport& last = reports[channel];
+    bool report = deadband <= 0.0f || !last.sent || valid != last.valid ||
+                  (valid && fabsf(value - last.value) > deadband) ||
+                  (heartbeatMs > 0 && timestamp - last.timestamp >= heartbeatMs);
+    if (report) {
+        last.sent = true;
+        last.valid = valid;
+        last.value = value;
+        last.timestamp = timestamp;
+    }
+    return report;
+}
+
+void BinaryStreamer::resetReports() {
+    for (auto& report : reports) {
+        report = ChannelReport();
+    }
+    reportGeneration = sensorManager ? sensorManager->getTopologyGeneration() : 0;
+}
+
+void BinaryStreamer::queueFrame(uint32_t sequence, uint64_t timeUs, uint8_t channel, float value) {
+    if (used + FRAME_SIZE > sizeof(buffer)) {
+        flushBuffer();
+    }
+    used += encodeFrame(buffer + used, sequence, timeUs, channel, value);
+}
+
+void BinaryStreamer::flushBuffer() {
+    if (used > 0 && output) {
+        bytesSent += output->write(buffer, used);
+    }
+    used = 0;
+}
+
+size_t BinaryStreamer::encodeFrame(uint8_t* frame, uint32_t sequence, uint64_t timeUs, uint8_t channel, float value) {
+    frame[0] = SYNC_0;
+    frame[1] = SYNC_1;
+    frame[2] = PAYLOAD_SIZE;
+    putUint32(frame + 3, sequence);
+    putUint64(frame + 7, timeUs);
+    frame[15] = channel;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    putUint32(frame + 16, bits);
+
+    uint16_t crc = crc16(frame + 2, 1 + PAYLOAD_SIZE);
+    frame[20] = crc & 0xFF;
+    frame[21] = crc >> 8;
+    return FRAME_SIZE;
+}
+
+uint16_t BinaryStreamer::crc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file BinaryStreamer.h
+ * @brief Framed binary measurement streaming over the command port
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup communication
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include "Constants.h"
+ #include "../managers/SensorManager.h"
+
+ /**
+  * @brief Pushes new readings to the host as CRC-protected binary frames
+  * While streaming is enabled, every period the readings recorded since the
+  * last push are taken from the reading history and written as frames from a
+  * fixed buffer, so no samples are dropped and nothing is allocated per sample.
+  *
+  * Frame layout (multi-byte fields little-endian):
+  * | Offset | Size | Field                                         |
+  * |--------|------|-----------------------------------------------|
+  * | 0      | 2    | Sync bytes 0xA5 0x5A                          |
+  * | 2      | 1    | Payload length (17)                           |
+  * | 3      | 4    | Sequence number                               |
+  * | 7      | 8    | Timestamp in microseconds                     |
+  * | 15     | 1    | Channel id (slot * CHANNEL_COUNT + quantity)  |
+  * | 16     | 4    | IEEE-754 float value (NaN if invalid)         |
+  * | 20     | 2    | CRC-16/CCITT-FALSE over length and payload    |
+  *
+  * Values are in the channel's reported unit (see SensorChannel.h), and
+  * MEAS:STR:MAP? lists the channel ids in use. An invalid value is a NaN
+  * whose lowest byte is the QualityCode, so the host learns why a value
+  * was rejected without ever receiving it. Timestamps are Unix epoch
+  * microseconds once SYST:TIME or SNTP has set the clock, and
+  * microseconds since boot before that (see TimeSync).
+  *
+  * SCPI responses are plain ASCII, so the 0xA5 sync byte never appears in
+  * them and the host can interleave text replies and frames on one port.
+  *
+  * Channels with a deadband (see ReportSettings) are reported by exception:
+  * a reading is only framed if it moved beyond the deadband from the value
+  * last framed, changed validity, or the channel's heartbeat expired.
+  */
+ class BinaryStreamer {
+ public:
+     static const uint8_t SYNC_0 = 0xA5;        ///< First sync byte
+     static const uint8_t SYNC_1 = 0x5A;        ///< Second sync byte
+     static const uint8_t PAYLOAD_SIZE = 17;    ///< Bytes of payload per frame
+     static const size_t FRAME_SIZE = 2 + 1 + PAYLOAD_SIZE + 2;  ///< Bytes per complete frame
+
+     /**
+      * @brief Constructor
+      * @param sensorMgr Sensor manager providing the reading history
+      * @param output Port the frames are written to
+      */
+     BinaryStreamer(SensorManager* sensorMgr, Print* output);
+
+     /**
+      * @brief Start streaming readings recorded from now on
+      * @param periodMs Interval between pushes in milliseconds
+      */
+     void start(uint32_t periodMs);
+
+     /**
+      * @brief Stop streaming
+      */
+     void stop();
+
+     /**
+      * @brief Check whether streaming is enabled
+      * @return true if streaming
+      */
+     bool isActive() const { return active; }
+
+     /**
+      * @brief Get the push interval
+      * @return Interval in milliseconds
+      */
+     uint32_t getPeriodMs() const { return periodMs; }
+
+     /**
+      * @brief Get the number of frame bytes the port has accepted
+      * @return Bytes since boot, wrapping at 2^32
+      */
+     uint32_t getBytesSent() const { return bytesSent; }
+
+     /**
+      * @brief Get the time until service() next has work to do
+      * @return Milliseconds until the next push, or UINT32_MAX if not streaming
+      */
+     uint32_t msUntilDue() const;
+
+     /**
+      * @brief Push any new readings if the period has elapsed
+      * Called from the communication task between commands.
+      */
+     void service();
+
+     /**
+      * @brief Get the channel id used in frames for a sensor channel
+      * @param slot Reading slot of the sensor
+      * @param type Measured quantity
+      * @return Channel id
+      */
+     static uint8_t channelId(size_t slot, InterfaceType type) {
+         return static_cast<uint8_t>(slot * CHANNEL_COUNT + static_cast<size_t>(type));
+     }
+
+     /**
+      * @brief Encode one measurement frame
+      * @param buffer [out] Destination of at least FRAME_SIZE bytes
+      * @param sequence Sequence number of the reading
+      * @param timeUs Reading timestamp in microseconds
+      * @param channel Channel id
+      * @param value Measured value
+      * @return Number of bytes written (FRAME_SIZE)
+      */
+     static size_t encodeFrame(uint8_t* buffer, uint32_t sequence, uint64_t timeUs, uint8_t channel, float value);
+
+     /**
+      * @brief Compute CRC-16/CCITT-FALSE (polynomial 0x1021, init 0xFFFF)
+      * @param data Bytes to checksum
+      * @param length Number of bytes
+      * @return CRC value
+      */
+     static uint16_t crc16(const uint8_t* data, size_t length);
+
+ private:
+     SensorManager* sensorManager;   ///< Source of readings
+     Print* output;                  ///< Destination port
+     bool active;                    ///< Streaming enabled
+     uint32_t periodMs;              ///< Push interval
+     unsigned long lastPushTime;     ///< When the last push happened
+     uint32_t lastSequence;          ///< Last history sequence sent
+     uint32_t reportGeneration;      ///< Sensor topology the report states belong to
+     uint32_t bytesSent;             ///< Frame bytes accepted by the port
+
+     /**
+      * @brief What was last framed on one channel
+      */
+     struct ChannelReport {
+         bool sent = false;         ///< Anything framed since streaming started
+         bool valid = false;        ///< Validity of the last framed value
+         float value = NAN;         ///< Last framed value
+         uint32_t timestamp = 0;    ///< Reading timestamp of the last framed value
+     };
+     ChannelReport reports[Constants::Sensors::MAX_SENSORS * CHANNEL_COUNT];   ///< Indexed by channel id
+
+     uint8_t buffer[Constants::Communication::STREAM_BUFFER_SIZE];  ///< Pre-allocated frame buffer
+     size_t used;                                                   ///< Bytes pending in the buffer
+
+     /**
+      * @brief Decide whether a reading goes out, and remember it if so
+      * @param channel Channel id
+      * @param valid Whether the reading is valid
+      * @param value Reading value
+      * @param timestamp Reading timestamp in milliseconds
+      * @param deadband Smallest change reported, 0 to report every reading
+      * @param heartbeatMs Longest silence, 0 for none
+      * @return true if the reading should be framed
+      */
+     bool shouldReport(uint8_t channel, bool valid, float value, uint32_t timestamp,
+                       float deadband, uint32_t heartbeatMs);
+
+     /**
+      * @brief Forget what was framed, so the next reading of every channel goes out
+      */
+     void resetReports();
+
+     /**
+      * @brief Append a frame, writing the buffer out first if it is full
+      */
+     void queueFrame(uint32_t sequence, uint64_t timeUs, uint8_t channel, float value);
+
+     /**
+      * @brief Write any pending bytes to the port
+      */
+     void flushBuffer();
+ };
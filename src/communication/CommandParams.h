@@ -0,0 +1,226 @@
+/**
+ * @file CommandParams.h
+ * @brief Non-owning tokenizer for command line parameters
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup communication
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <string_view>
+ #include <cstdlib>
+
+ /**
+  * @brief Space-separated parameters of a command, as views into the line buffer
+  * Nothing is copied or allocated: every token is a std::string_view into
+  * the caller's line, which must outlive the CommandParams. Handlers that
+  * take free-form payloads (JSON, board IDs) use rest() to get the
+  * remainder of the line with its original spacing intact.
+  */
+ class CommandParams {
+ public:
+     static const size_t MAX_PARAMS = 32;   ///< Tokens beyond this are only reachable through rest()
+
+     CommandParams() = default;
+
+     /**
+      * @brief Split an argument string into tokens
+      * @param args Text after the command mnemonic
+      */
+     explicit CommandParams(std::string_view args) {
+         line = args;
+         size_t pos = 0;
+         while (count < MAX_PARAMS) {
+             pos = args.find_first_not_of(" \t", pos);
+             if (pos == std::string_view::npos) {
+                 break;
+             }
+             size_t end = args.find_first_of(" \t", pos);
+             if (end == std::string_view::npos) {
+                 end = args.size();
+             }
+             tokens[count++] = args.substr(pos, end - pos);
+             pos = end;
+         }
+     }
+
+     /**
+      * @brief Get the number of tokens
+      * @return Token count
+      */
+     size_t size() const { return count; }
+
+     /**
+      * @brief Check whether there are no tokens
+      * @return true if empty
+      */
+     bool empty() const { return count == 0; }
+
+     /**
+      * @brief Get a token
+      * @param index Token index
+      * @return View of the token (empty if out of range)
+      */
+     std::string_view operator[](size_t index) const {
+         return index < count ? tokens[index] : std::string_view();
+     }
+
+     /**
+      * @brief Get the remainder of the line starting at a token
+      * If the line buffer is null-terminated, so is the returned view, so
+      * its data() can be handed to C-string APIs directly.
+      * @param index First token to include
+      * @return View from the start of the token to the end of the line
+      */
+     std::string_view rest(size_t index = 0) const {
+         if (index >= count) {
+             return std::string_view();
+         }
+         return line.substr(tokens[index].data() - line.data());
+     }
+
+     /**
+      * @brief Get the remainder of the line as a C string
+      * Only valid when the line buffer is null-terminated.
+      * @param index First token to include
+      * @return Pointer to the remainder, or "" if there is none
+      */
+     const char* restCStr(size_t index = 0) const {
+         return index < count ? tokens[index].data() : "";
+     }
+
+     /**
+      * @brief Copy a token into a String
+      * For the few callers that need an owning string (logging, lookups).
+      * @param index Token index
+      * @return Token contents
+      */
+     String toString(size_t index) const {
+         return viewToString((*this)[index]);
+     }
+
+     /**
+      * @brief Copy a view into a String
+      * @param view Characters to copy
+      * @return Owning copy
+      */
+     static String viewToString(std::string_view view) {
+         String result;
+         result.reserve(view.size());
+         for (char c : view) {
+             result += c;
+         }
+         return result;
+     }
+
+     /**
+      * @brief Find the end of the first command in a compound command line
+      * Separators inside double quotes and JSON objects or arrays belong
+      * to a parameter and are skipped.
+      * @param line Line to search
+      * @return Offset of the separating ';', or line.size() if there is none
+      */
+     static size_t findCommandSeparator(std::string_view line) {
+         bool quoted = false;
+         int depth = 0;
+         for (size_t i = 0; i < line.size(); i++) {
+             char c = line[i];
+             if (quoted) {
+                 if (c == '\\') {
+                     i++; // Skip the escaped character
+                 } else if (c == '"') {
+                     quoted = false;
+                 }
+             } else if (c == '"') {
+                 quoted = true;
+             } else if (c == '{' || c == '[') {
+                 depth++;
+             } else if ((c == '}' || c == ']') && depth > 0) {
+                 depth--;
+             } else if (c == ';' && depth == 0) {
+                 return i;
+             }
+         }
+         return line.size();
+     }
+
+     /**
+      * @brief Case-insensitive comparison of a view with a C string
+      * @param view View to compare
+      * @param text Null-terminated text
+      * @return true if equal ignoring case
+      */
+     static bool equalsIgnoreCase(std::string_view view, const char* text) {
+         size_t i = 0;
+         for (; i < view.size(); i++) {
+             if (text[i] == '\0' || toupper(static_cast<unsigned char>(view[i])) != toupper(static_cast<unsigned char>(text[i]))) {
+                 return false;
+             }
+         }
+         return text[i] == '\0';
+     }
+
+     /**
+      * @brief Parse a decimal integer from a view
+      * @param view Digits, optionally signed
+      * @param value [out] Parsed value
+      * @return true if the whole view was a valid integer
+      */
+     static bool parseInt(std::string_view view, long& value) {
+         char digits[16];
+         if (view.empty() || view.size() >= sizeof(digits)) {
+             return false;
+         }
+         memcpy(digits, view.data(), view.size());
+         digits[view.size()] = '\0';
+
+         char* end = nullptr;
+         value = strtol(digits, &end, 10);
+         return end == digits + view.size();
+     }
+
+     /**
+      * @brief Parse an unsigned decimal integer from a view
+      * @param view Digits
+      * @param value [out] Parsed value
+      * @return true if the whole view was a valid unsigned integer
+      */
+     static bool parseUnsigned(std::string_view view, uint32_t& value) {
+         char digits[16];
+         if (view.empty() || view.size() >= sizeof(digits) || view[0] == '-') {
+             return false;
+         }
+         memcpy(digits, view.data(), view.size());
+         digits[view.size()] = '\0';
+
+         char* end = nullptr;
+         value = strtoul(digits, &end, 10);
+         return end == digits + view.size();
+     }
+
+     /**
+      * @brief Parse a 64-bit unsigned decimal integer from a view
+      * @param view Digits
+      * @param value [out] Parsed value
+      * @return true if the whole view was a valid unsigned integer
+      */
+     static bool parseUnsigned(std::string_view view, uint64_t& value) {
+         char digits[24];
+         if (view.empty() || view.size() >= sizeof(digits) || view[0] == '-') {
+             return false;
+         }
+         memcpy(digits, view.data(), view.size());
+         digits[view.size()] = '\0';
+
+         char* end = nullptr;
+         value = strtoull(digits, &end, 10);
+         return end == digits + view.size();
+     }
+
+ private:
+     std::string_view line;                 ///< Whole argument string
+     std::string_view tokens[MAX_PARAMS];   ///< Token views into line
+     size_t count = 0;                      ///< Number of tokens
+ };
@@ -1,8 +1,12 @@
 #include "CommunicationManager.h"
-#include "VrekerSCPIWrapper.h" 
 #include "../Constants.h"
-#include "../sensors/readings/TemperatureReading.h"
-#include "../sensors/readings/HumidityReading.h"
+#include "../managers/PerfCounters.h"
+#include "../managers/TaskManager.h"
+#include <algorithm>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <atomic>
+#include "../sensors/readings/ChannelReading.h"
 #include "../sensors/interfaces/InterfaceTypes.h"
 
 // Initialize the singleton instance
@@ -10,441 +14,699 @@ CommunicationManager* CommunicationManager::instance = nullptr;
 // Initialize the UART debug serial
 Print* CommunicationManager::uartDebugSerial = nullptr;
 
+namespace {
+    /**
+     * @brief Task woken by serial receive events
+     */
+    std::atomic<TaskHandle_t> inputTask(nullptr);
+    
+    /**
+     * @brief Whether the receive callback is installed on Serial
+     */
+    bool inputCallbackRegistered = false;
+    
+    void notifyInputTask() {
+        TaskHandle_t task = inputTask.load();
+        if (task) {
+            xTaskNotifyGive(task);
+        }
+    }
+    
+    /**
+     * @brief Print sink that only counts what it is given, for SYST:BENCH
+     */
+    class ByteCounter : public Print {
+    public:
+        size_t write(uint8_t) override {
+            bytes++;
+            return 1;
+        }
+        
+        size_t write(const uint8_t*, size_t size) override {
+            bytes += size;
+            return size;
+        }
+        
+        uint32_t bytes = 0;   ///< Bytes written so far
+    };
+    
+#if ARDUINO_USB_CDC_ON_BOOT
+    /**
+     * @brief USB CDC event handler; runs on the Arduino event loop task, not in the ISR
+     */
+    void onSerialEvent(void*, esp_event_base_t, int32_t, void*) {
+        notifyInputTask();
+    }
+#endif
+}
+
 CommunicationManager::CommunicationManager(SensorManager* sensorMgr, ConfigManager* configMgr, ErrorHandler* err, LedManager* led) :
     sensorManager(sensorMgr),
     configManager(configMgr),
     errorHandler(err),
-    ledManager(led) {
+    ledManager(led),
+    streamer(sensorMgr, &Serial),
+    response(&Serial) {
     instance = this;
-    scpiParser = new SCPI_Parser();
 }
 
+namespace {
+    /**
+     * @brief Every command and its handler, keyed by the Constants::SCPI patterns
+     */
+    constexpr ScpiCommand<CommandHandler> COMMANDS[] = {
+        {Constants::SCPI::IDN, &CommunicationManager::handleIdentify},
+        {Constants::SCPI::MEASURE_QUERY, &CommunicationManager::handleMeasure},
+        {Constants::SCPI::MEASURE_FRESH, &CommunicationManager::handleMeasureFresh},
+        {Constants::SCPI::MEASURE_AGE, &CommunicationManager::handleMeasureAge},
+        {Constants::SCPI::MEASURE_QUALITY, &CommunicationManager::handleMeasureQuality},
+        {Constants::SCPI::MEASURE_HISTORY, &CommunicationManager::handleMeasureHistory},
+        {Constants::SCPI::MEASURE_HISTORY_TIME, &CommunicationManager::handleMeasureHistoryTime},
+        {Constants::SCPI::MEASURE_STREAM, &CommunicationManager::handleStreamControl},
+        {Constants::SCPI::MEASURE_STREAM_QUERY, &CommunicationManager::handleStreamStatus},
+        {Constants::SCPI::MEASURE_STREAM_MAP, &CommunicationManager::handleStreamMap},
+        {Constants::SCPI::LIST_SENSORS, &CommunicationManager::handleListSensors},
+        {Constants::SCPI::SENSOR_HEALTH, &CommunicationManager::handleSensorHealth},
+        {Constants::SCPI::GET_CONFIG, &CommunicationManager::handleGetConfig},
+        {Constants::SCPI::SET_BOARD_ID, &CommunicationManager::handleSetBoardId},
+        {Constants::SCPI::UPDATE_CONFIG, &CommunicationManager::handleUpdateConfig},
+        {Constants::SCPI::UPDATE_SENSOR_CONFIG, &CommunicationManager::handleUpdateSensorConfig},
+        {Constants::SCPI::UPDATE_ADDITIONAL_CONFIG, &CommunicationManager::handleUpdateAdditionalConfig},
+        {Constants::SCPI::I2C_SCAN, &CommunicationManager::handleI2CScan},
+        {Constants::SCPI::I2C_CLOCK, &CommunicationManager::handleI2CClock},
+        {Constants::SCPI::I2C_CLOCK_QUERY, &CommunicationManager::handleI2CClockQuery},
+        {Constants::SCPI::TEST, &CommunicationManager::handleEcho},
+        {Constants::SCPI::ECHO, &CommunicationManager::handleEcho},
+        {Constants::SCPI::RESET, &CommunicationManager::handleReset},
+        {Constants::SCPI::LOG_STATUS, &CommunicationManager::handleLogStatus},
+        {Constants::SCPI::LOG_ROUTE, &CommunicationManager::handleLogRouting},
+        {Constants::SCPI::LOG_HISTORY, &CommunicationManager::handleLogHistory},
+        {Constants::SCPI::PERF_QUERY, &CommunicationManager::handlePerfQuery},
+        {Constants::SCPI::PERF_RESET, &CommunicationManager::handlePerfReset},
+        {Constants::SCPI::MEMORY_QUERY, &CommunicationManager::handleMemoryQuery},
+        {Constants::SCPI::TASK_QUERY, &CommunicationManager::handleTaskQuery},
+        {Constants::SCPI::TASK_CONFIG_QUERY, &CommunicationManager::handleTaskConfigQuery},
+        {Constants::SCPI::TASK_PRIORITY, &CommunicationManager::handleTaskPriority},
+        {Constants::SCPI::TASK_CORE, &CommunicationManager::handleTaskCore},
+        {Constants::SCPI::BENCHMARK, &CommunicationManager::handleBenchmark},
+        {Constants::SCPI::TIME_SET, &CommunicationManager::handleTimeSet},
+        {Constants::SCPI::TIME_QUERY, &CommunicationManager::handleTimeQuery},
+        {Constants::SCPI::LED_IDENTIFY, &CommunicationManager::handleLedIdentify},
+        {Constants::SCPI::TEST_INFO, &CommunicationManager::handleTestInfoLevel},
+        {Constants::SCPI::TEST_WARNING, &CommunicationManager::handleTestWarningLevel},
+        {Constants::SCPI::TEST_ERROR, &CommunicationManager::handleTestErrorLevel},
+        {Constants::SCPI::TEST_FATAL, &CommunicationManager::handleTestFatalLevel},
+    };
 
-CommunicationManager::~CommunicationManager() {
-    delete scpiParser;
+    /**
+     * @brief Perfect-hash lookup table, generated by the compiler
+     */
+    constexpr ScpiCommandTable<CommandHandler, sizeof(COMMANDS) / sizeof(COMMANDS[0])> COMMAND_TABLE(COMMANDS);
+    static_assert(COMMAND_TABLE.isValid(), "SCPI command table has a malformed or duplicate command");
 }
 
-void CommunicationManager::registerCommands() {
-    // Clear existing command registrations
-    commandHandlers.clear();
-    
-    // Define a macro that registers a command both in our map and with the SCPI parser
-    #define REGISTER_COMMAND(cmdConst, handlerFunc) \
-        commandHandlers[cmdConst] = [this](const std::vector<String>& params) { \
-            return this->handlerFunc(params); \
-        }; \
-        scpiParser->RegisterCommand(F(cmdConst), \
-            [](SCPI_Commands cmds, SCPI_Parameters parameters, Stream& interface) { \
-                CommunicationManager* instance = CommunicationManager::getInstance(); \
-                if (instance) { \
-                    std::vector<String> params; \
-                    for (size_t i = 0; i < parameters.Size(); i++) { \
-                        params.push_back(String(parameters[i])); \
-                    } \
-                    instance->handlerFunc(params); \
-                } \
-            });
+void CommunicationManager::begin(long baudRate) {
+    LOG_INFO(errorHandler, "Communication manager initialized with " + String(COMMAND_TABLE.size()) + " SCPI commands");
+}
 
-    // Register all commands using Constants::SCPI namespace
-    REGISTER_COMMAND(Constants::SCPI::IDN, handleIdentify)
-    REGISTER_COMMAND(Constants::SCPI::MEASURE_QUERY, handleMeasure)
-    REGISTER_COMMAND(Constants::SCPI::LIST_SENSORS, handleListSensors)
-    REGISTER_COMMAND(Constants::SCPI::GET_CONFIG, handleGetConfig)
-    REGISTER_COMMAND(Constants::SCPI::SET_BOARD_ID, handleSetBoardId)
-    REGISTER_COMMAND(Constants::SCPI::UPDATE_CONFIG, handleUpdateConfig)
-    REGISTER_COMMAND(Constants::SCPI::UPDATE_SENSOR_CONFIG, handleUpdateSensorConfig)
-    REGISTER_COMMAND(Constants::SCPI::UPDATE_ADDITIONAL_CONFIG, handleUpdateAdditionalConfig)
-    REGISTER_COMMAND(Constants::SCPI::TEST, handleEcho)
-    REGISTER_COMMAND(Constants::SCPI::ECHO, handleEcho)
-    REGISTER_COMMAND(Constants::SCPI::RESET, handleReset)
-    REGISTER_COMMAND(Constants::SCPI::LOG_STATUS, handleLogStatus)
-    REGISTER_COMMAND(Constants::SCPI::LOG_ROUTE, handleLogRouting)
-    REGISTER_COMMAND(Constants::SCPI::LED_IDENTIFY, handleLedIdentify)
-    REGISTER_COMMAND(Constants::SCPI::TEST_INFO, handleTestInfoLevel)
-    REGISTER_COMMAND(Constants::SCPI::TEST_WARNING, handleTestWarningLevel)
-    REGISTER_COMMAND(Constants::SCPI::TEST_ERROR, handleTestErrorLevel)
-    REGISTER_COMMAND(Constants::SCPI::TEST_FATAL, handleTestFatalLevel)
-    
-    #undef REGISTER_COMMAND
-    
-    errorHandler->logError(INFO, "SCPI commands registered");
+void CommunicationManager::setInputTask(TaskHandle_t task) {
+    inputTask.store(task);
+    if (inputCallbackRegistered || !task) {
+        return;
+    }
+    
+#if ARDUINO_USB_CDC_ON_BOOT && ARDUINO_USB_MODE
+    Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, onSerialEvent);
+#elif ARDUINO_USB_CDC_ON_BOOT
+    Serial.onEvent(ARDUINO_USB_CDC_RX_EVENT, onSerialEvent);
+#else
+    Serial.onReceive(notifyInputTask);
+#endif
+    inputCallbackRegistered = true;
 }
 
-void CommunicationManager::begin(long baudRate) {
-    errorHandler->logError(INFO, "Communication manager initialized");
-    registerCommands();  // Replace both previous command registration methods
+uint32_t CommunicationManager::msUntilServiceDue() const {
+    return std::min({streamer.msUntilDue(), configManager->msUntilFlushDue(),
+                     Constants::Communication::IDLE_WAKE_MS});
 }
 
 void CommunicationManager::processCommandLine() {
-    // Increased timeout and buffer size - keep within function as requested
-    static constexpr unsigned long COMMAND_TIMEOUT_MS = Constants::Communication::COMMAND_TIMEOUT_MS;
     static constexpr size_t MAX_BUFFER_SIZE = Constants::Communication::MAX_BUFFER_SIZE;
     
-    // Read a complete command with timeout
-    String rawCommand = "";
-    unsigned long startTime = millis();
-    
-    // Read until newline, timeout, or buffer full
-    while ((millis() - startTime < COMMAND_TIMEOUT_MS) && (rawCommand.length() < MAX_BUFFER_SIZE)) {
-        if (Serial.available()) {
-            char c = Serial.read();
-            if (c == '\n' || c == '\r') {
-                if (rawCommand.length() > 0) {
-                    break; // Complete command found
-                }
-                // Else ignore empty lines
-            } else {
-                rawCommand += c;
+    // Pull everything that has arrived in one go; never wait for the rest of a line
+    int available = Serial.available();
+    if (available <= 0) {
+        return;
+    }
+    PerfScope timing(PerfSite::COMMAND_LINE);
+    
+    while (available > 0) {
+        size_t space = MAX_BUFFER_SIZE - 1 - lineLength;
+        size_t chunk = std::min(static_cast<size_t>(available), space);
+        size_t scanFrom = lineLength;
+        lineLength += Serial.readBytes(lineBuffer + lineLength, chunk);
+        
+        // Execute every complete line in the buffer
+        size_t lineStart = 0;
+        for (size_t i = scanFrom; i < lineLength; i++) {
+            if (lineBuffer[i] != '\n' && lineBuffer[i] != '\r') {
+                continue;
+            }
+            
+            lineBuffer[i] = '\0';
+            if (discardingLine) {
+                discardingLine = false; // Tail of an oversized line
+            } else if (i > lineStart) {
+                executeLine(lineBuffer + lineStart, i - lineStart);
             }
+            lineStart = i + 1;
         }
-        yield(); // Allow other tasks to run
+        
+        // Keep any partial line for the next call
+        if (lineStart > 0) {
+            memmove(lineBuffer, lineBuffer + lineStart, lineLength - lineStart);
+            lineLength -= lineStart;
+        }
+        
+        if (lineLength >= MAX_BUFFER_SIZE - 1) {
+            if (!discardingLine) {
+                errorHandler->logError(ERROR, "Command exceeds buffer size limit of " + String(MAX_BUFFER_SIZE) + " characters");
+            }
+            discardingLine = true;
+            lineLength = 0;
+        }
+        
+        available = Serial.available();
     }
     
-    // Check for errors or empty command
-    if (rawCommand.length() >= MAX_BUFFER_SIZE) {
-        errorHandler->logError(ERROR, "Command exceeds buffer size limit of " + String(MAX_BUFFER_SIZE) + " characters");
+    // Everything answered in this pass goes out in one write
+    response.send();
+}
+
+void CommunicationManager::executeLine(char* line, size_t length) {
+    // Run each command of a compound line in order; ';' is replaced in place
+    while (true) {
+        size_t end = CommandParams::findCommandSeparator(std::string_view(line, length));
+        if (end == length) {
+            executeCommand(line, length);
+            return;
+        }
+        
+        line[end] = '\0';
+        executeCommand(line, end);
+        line += end + 1;
+        length -= end + 1;
     }
-    
-    if (rawCommand.length() == 0) {
+}
+
+void CommunicationManager::executeCommand(char* line, size_t length) {
+    // Trim whitespace in place; the line stays null-terminated
+    while (length > 0 && isspace(static_cast<unsigned char>(line[length - 1]))) {
+        line[--length] = '\0';
+    }
+    while (length > 0 && isspace(static_cast<unsigned char>(*line))) {
+        line++;
+        length--;
+    }
+    if (length > 0 && *line == ':') {
+        line++; // SCPI root specifier; every command here starts at the root
+        length--;
+    }
+    if (length == 0) {
         return; // No command to process
     }
     
-    // Trim whitespace and process command
-    rawCommand.trim();
-    errorHandler->logError(INFO, "Processing command: '" + 
-                         (rawCommand.length() > 50 ? 
-                            rawCommand.substring(0, 50) + "..." : 
-                            rawCommand) + 
-                         "' (" + String(rawCommand.length()) + " bytes)");
+    LOG_INFO(errorHandler, "Processing command: '%s%s' (%u bytes)",
+                               std::string_view(line, std::min<size_t>(length, 50)),
+                               length > 50 ? "..." : "", length);
 
     // Parse and process command
-    String command;
-    std::vector<String> params;
-    parseCommand(rawCommand, command, params);
+    std::string_view command;
+    CommandParams params;
+    parseCommand(std::string_view(line, length), command, params);
     
     // Track if the command was recognized
     bool commandRecognized = false;
     
     // Handle HELP or ? commands specially
-    if (command.equalsIgnoreCase("HELP") || command.equalsIgnoreCase("?")) {
+    if (CommandParams::equalsIgnoreCase(command, "HELP") || command == "?") {
         // Provide basic help information
-        Serial.println("Available commands:");
-        Serial.println("*IDN? - Get device identification");
-        Serial.println("MEAS? - Get measurements from all peripherals");
-        Serial.println("MEAS? <sensor>[:measurement] - Get specific measurements");
-        Serial.println("SYST:SENS:LIST? - List all available peripherals");
-        Serial.println("SYST:CONF? - Get device configuration");
-        Serial.println("RESET - Reset the device");
-        Serial.println();
+        response.println("Available commands:");
+        response.println("*IDN? - Get device identification");
+        response.println("MEAS? - Get measurements from all peripherals");
+        response.println("MEAS? <sensor>[:measurement] - Get specific measurements");
+        response.println("MEAS:HIST? <sequence> [sensor ...] - Get readings recorded after a sequence number: seq,ms,sensor,channel,value,time_us");
+        response.println("MEAS:HIST:TIME? <ms> [sensor ...] - Get readings recorded since a timestamp");
+        response.println("MEAS:STREAM ON[,<ms>]|OFF - Push binary measurement frames");
+        response.println("SYST:SENS:LIST? - List all available peripherals");
+        response.println("SYST:SENS:HEAL? - Get recovery state: name,HEALTHY|RECOVERING,failed_attempts,retry_in_ms,for_ms");
+        response.println("SYST:CONF? - Get device configuration");
+        response.println("SYST:LOG:HIST? <sequence> [max] - Get log messages recorded after a sequence number");
+        response.println("SYST:I2C:SCAN? - Scan all I2C buses and mux channels in use: bus,count,addresses...");
+        response.println("SYST:I2C:CLOC? - Get bus clocks: bus,clock_hz,limit_hz,transactions,errors,fallbacks,mux_switches,mux_skips");
+        response.println("SYST:I2C:CLOC <bus>,<Hz> - Set the fastest clock a bus may use");
+        response.println("SYST:PERF? - Get latency histograms: site,count,min_us,p50_us,p99_us,max_us");
+        response.println("SYST:PERF:RES - Clear latency histograms");
+        response.println("SYST:MEM? - Get heap state (heap,region,free,largest,min_free,total,frag_pct) and per-subsystem use");
+        response.println("SYST:TASK? - Get task,name,core,state,prio,cpu_pct,stack_free,health,checkin_ms,missed,stalls and core,n,busy_pct");
+        response.println("SYST:TASK:CONF? - Get role,core,priority,stack for each task role");
+        response.println("SYST:TASK:PRI <role>,<priority> - Change a task's priority until restart");
+        response.println("SYST:TASK:CORE <role>,<core|ANY> - Move a task to another core until restart");
+        response.println("SYST:BENCH [ms] - Load-test reads, MEAS? and streaming for ms each, then report rates and headroom");
+        response.println("SYST:TIME <epoch_us> - Set the clock used for reading timestamps");
+        response.println("SYST:TIME? - Get clock state: epoch_us,device_us,source,drift_ppb,syncs");
+        response.println("RESET - Reset the device");
+        response.println("Join commands with ';' to send several on one line, e.g. *IDN?;MEAS?");
+        response.println();
         commandRecognized = true;
     }
-    // Try our command handlers
-    else if (processCommand(command, params)) {
-        commandRecognized = true;
-    }
-    // Fall back to SCPI parser for compatibility with shortened commands
+    // Short and long forms both resolve through the command table
     else {
-        char buff[rawCommand.length() + 1];
-        rawCommand.toCharArray(buff, rawCommand.length() + 1);
-        
-        // Capture output status to detect if SCPI parser handled the command
-        size_t beforeSerialPos = Serial.availableForWrite();
-        scpiParser->ProcessInput(Serial, buff);
-        size_t afterSerialPos = Serial.availableForWrite();
-        
-        commandRecognized = (afterSerialPos != beforeSerialPos);
+        commandRecognized = processCommand(command, params);
     }
     
     // Log unrecognized commands
     if (!commandRecognized) {
-        errorHandler->logError(ERROR, "Unrecognized command: '" + 
-                            (command.length() > 50 ? 
-                               command.substring(0, 50) + "..." : 
-                               command) + "'");
+        errorHandler->logFormatted(ERROR, "Unrecognized command: '%s%s'",
+                                   command.substr(0, 50), command.length() > 50 ? "..." : "");
+    }
+}
+
+void CommunicationManager::parseCommand(std::string_view line, std::string_view& command, CommandParams& params) {
+    // Extract command (up to first space), the rest are parameters
+    size_t spacePos = line.find(' ');
+    if (spacePos == std::string_view::npos) {
+        command = line;
+        params = CommandParams();
+        return;
     }
     
-    // Ensure all responses are sent
-    Serial.flush();
+    command = line.substr(0, spacePos);
+    params = CommandParams(line.substr(spacePos + 1));
 }
 
-void CommunicationManager::parseCommand(const String& rawCommand, String& command, std::vector<String>& params) {
-    params.clear();
+String CommunicationManager::joinCsv(const std::vector<String>& values) {
+    size_t length = values.size();
+    for (const String& value : values) {
+        length += value.length();
+    }
     
-    // Extract command (up to first space)
-    int spacePos = rawCommand.indexOf(' ');
-    if (spacePos > 0) {
-        command = rawCommand.substring(0, spacePos);
-        
-        // Extract space-separated parameters
-        String paramsStr = rawCommand.substring(spacePos + 1);
-        paramsStr.trim();
-        
-        // Split parameters
-        while (paramsStr.length() > 0) {
-            int nextSpace = paramsStr.indexOf(' ');
-            if (nextSpace > 0) {
-                params.push_back(paramsStr.substring(0, nextSpace));
-                paramsStr = paramsStr.substring(nextSpace + 1);
-                paramsStr.trim();
-            } else {
-                // Last parameter
-                params.push_back(paramsStr);
-                break;
-            }
+    String csvLine;
+    csvLine.reserve(length);
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i > 0) {
+            csvLine += ',';
         }
-    } else {
-        command = rawCommand;
+        csvLine += values[i];
     }
+    return csvLine;
 }
 
-bool CommunicationManager::processCommand(const String& command, const std::vector<String>& params) {
-    auto it = commandHandlers.find(command);
-    if (it != commandHandlers.end()) {
-        return it->second(params);
+bool CommunicationManager::processCommand(std::string_view command, const CommandParams& params) {
+    const ScpiCommand<CommandHandler>* entry = COMMAND_TABLE.find(command);
+    if (!entry) {
+        return false;
     }
-    return false;
+    (this->*(entry->handler))(params);
+    return true;
 }
 
 // Command handler implementations
-bool CommunicationManager::handleIdentify(const std::vector<String>& params) {
-    String response = String(Constants::PRODUCT_NAME) + "," + 
+bool CommunicationManager::handleIdentify(const CommandParams& params) {
+    String identity = String(Constants::PRODUCT_NAME) + "," + 
                       configManager->getBoardIdentifier() + "," +
                       String(Constants::FIRMWARE_VERSION);
-    Serial.println(response);
-    Serial.flush();
+    response.println(identity);
     return true;
 }
 
-bool CommunicationManager::handleMeasure(const std::vector<String>& params) {
+bool CommunicationManager::handleMeasureQuery(const CommandParams& params, MeasureMode mode) {
+    PerfScope timing(PerfSite::MEASURE);
+    std::vector<MeasureTarget> targets;
     std::vector<String> values;
     
+    // Taken before collecting, so a reading recorded meanwhile invalidates the result
+    uint32_t sequence = sensorManager->getHistory().getLatestSequence();
+    uint32_t topology = sensorManager->getTopologyGeneration();
+    bool reusable = mode == MeasureMode::CACHED && params.empty();
+    
     try {
-        if (params.empty()) {
-            // No sensors specified, use all available
-            auto registry = sensorManager->getRegistry();
-            auto allSensors = registry.getAllSensors();
-            
-            errorHandler->logError(INFO, "MEAS: Collecting data from all " + String(allSensors.size()) + " available peripherals");
-            
-            for (auto sensor : allSensors) {
-                collectSensorReadings(sensor->getName(), "", values);
-            }
-        } else {
-            std::map<String, String> sensorRequests;
-            
-            // Parse parameters and group by sensor name
-            for (const auto& param : params) {
-                // Check if parameter contains a colon (sensor:measurements format)
-                int colonPos = param.indexOf(':');
-                String sensorName, measurements;
-                
-                if (colonPos > 0) {
-                    sensorName = param.substring(0, colonPos);
-                    measurements = param.substring(colonPos + 1);
-                    errorHandler->logError(INFO, "MEAS: Reading " + sensorName + " with measurements: " + measurements);
-                } else {
-                    sensorName = param;
-                    measurements = "";
-                    errorHandler->logError(INFO, "MEAS: Reading " + sensorName + " with all available measurements");
-                }
-                
-                // FIXED: Combine multiple measurement requests for the same sensor
-                if (sensorRequests.find(sensorName) == sensorRequests.end()) {
-                    // First measurement request for this sensor
-                    sensorRequests[sensorName] = measurements;
-                } else {
-                    // Additional measurement request for existing sensor
-                    if (measurements.length() > 0) {
-                        if (sensorRequests[sensorName].length() > 0) {
-                            // Combine with existing measurements (comma-separated)
-                            sensorRequests[sensorName] += "," + measurements;
-                        } else {
-                            // Replace empty string (all measurements) with specific measurement
-                            sensorRequests[sensorName] = measurements;
-                        }
-                    }
-                    // If measurements is empty (meaning all measurements), keep existing value
-                }
-            }
-            
-            // Collect data for each unique sensor
-            for (const auto& [sensorName, measurements] : sensorRequests) {
-                collectSensorReadings(sensorName, measurements, values);
-            }
+        // Nothing new since the last full query: answer with the line built then
+        if (reusable && measureCache.valid && measureCache.sequence == sequence && measureCache.topology == topology) {
+            response.println(measureCache.line);
+            return true;
         }
         
+        collectMeasureTargets(params, targets);
+        collectSensorReadings(targets, mode, values);
+        
         // Output a single CSV line with all collected values
         if (!values.empty()) {
-            String csvLine = values[0];
-            for (size_t i = 1; i < values.size(); i++) {
-                csvLine += "," + values[i];
+            String line = joinCsv(values);
+            response.println(line);
+            LOG_INFO(errorHandler, "MEAS: CSV response sent with %u values", values.size());
+            
+            // Failed reads are retried on every query, so only complete lines are reused
+            if (reusable) {
+                bool complete = std::none_of(values.begin(), values.end(),
+                                             [](const String& value) { return value == "ERROR"; });
+                measureCache.valid = complete;
+                measureCache.sequence = sequence;
+                measureCache.topology = topology;
+                measureCache.line = complete ? line : String();
             }
-            Serial.println(csvLine);
-            Serial.flush(); // Ensure the response is sent immediately
-            errorHandler->logError(INFO, "MEAS: CSV response sent with " + String(values.size()) + " values");
         } else {
             errorHandler->logError(WARNING, "MEAS: No measurement values were collected!");
-            Serial.println("ERROR");
-            Serial.flush();
+            response.println("ERROR");
         }
         
     } catch (...) {
         // Catch any other unforeseen errors
         errorHandler->logError(WARNING, "MEAS: Unexpected exception during measurement");
-        Serial.println("ERROR");
-        Serial.flush();
+        response.println("ERROR");
         return false;
     }
     
     return true;
 }
 
-void CommunicationManager::collectSensorReadings(const String& sensorName, const String& measurements, std::vector<String>& values) {
-    // Constants for retry logic
-    const int MAX_RETRIES = Constants::Communication::MAX_READING_RETRIES;
-    const int RETRY_DELAY_MS = Constants::Communication::READING_RETRY_DELAY_MS;
-    
-    // Find the sensor
-    ISensor* sensor = sensorManager->findSensor(sensorName);
-    bool sensorOk = (sensor != nullptr && sensor->isConnected());
-    
-    if (!sensorOk) {
-        errorHandler->logError(WARNING, "Peripheral " + sensorName + " not found or not connected");
+void CommunicationManager::collectMeasureTargets(const CommandParams& params, std::vector<MeasureTarget>& targets) {
+    if (params.empty()) {
+        // No sensors specified, use all available
+        const SensorRegistry& registry = sensorManager->getRegistry();
+        
+        LOG_INFO(errorHandler, "MEAS: Collecting data from all %u available peripherals", registry.count());
+        
+        registry.forEachSensor([&](ISensor* sensor) {
+            targets.push_back({sensor->getName(), String()});
+        });
         return;
     }
     
-    // Determine which measurements to take
-    bool useAllMeasurements = measurements.length() == 0;
-    String upperMeasurements = measurements;
-    upperMeasurements.toUpperCase();
-    
-    bool readTemp = useAllMeasurements || upperMeasurements.indexOf("TEMP") >= 0;
-    bool readHum = useAllMeasurements || upperMeasurements.indexOf("HUM") >= 0;
+    std::map<String, String> sensorRequests;
     
-    if (readTemp && sensorOk && sensor->supportsInterface(InterfaceType::TEMPERATURE)) {
-        TemperatureReading tempReading = sensorManager->getTemperatureSafe(sensorName);
+    // Parse parameters and group by sensor name
+    for (size_t p = 0; p < params.size(); p++) {
+        std::string_view param = params[p];
         
-        if (tempReading.valid) {
-            values.push_back(String(tempReading.value));
+        // Check if parameter contains a colon (sensor:measurements format)
+        size_t colonPos = param.find(':');
+        String sensorName, measurements;
+        
+        if (colonPos != std::string_view::npos && colonPos > 0) {
+            sensorName = CommandParams::viewToString(param.substr(0, colonPos));
+            measurements = CommandParams::viewToString(param.substr(colonPos + 1));
+            measurements.toUpperCase();
+            LOG_INFO(errorHandler, "MEAS: Reading %s with measurements: %s", sensorName, measurements);
         } else {
-            // Only if first read failed, apply retry logic with delays
-            bool success = false;
-            String tempValue = "ERROR";
-            
-            for (int attempt = 1; attempt < MAX_RETRIES && !success; attempt++) {
-                // Log retry information at INFO level
-                errorHandler->logError(INFO, "Retry #" + String(attempt) + " for temperature reading from " + sensorName);
-                delay(RETRY_DELAY_MS); // Only delay during retries when needed
-                
-                try {
-                    tempReading = sensorManager->getTemperatureSafe(sensorName);
-                    
-                    if (tempReading.valid) {
-                        tempValue = String(tempReading.value);
-                        success = true;
-                        errorHandler->logError(INFO, "Successfully read temperature from " + sensorName + " after " + String(attempt+1) + " attempts");
-                        break;
-                    }
-                } catch (...) {
-                    // Continue to next retry attempt
+            sensorName = CommandParams::viewToString(param);
+            measurements = "";
+            LOG_INFO(errorHandler, "MEAS: Reading %s with all available measurements", sensorName);
+        }
+        
+        // FIXED: Combine multiple measurement requests for the same sensor
+        if (sensorRequests.find(sensorName) == sensorRequests.end()) {
+            // First measurement request for this sensor
+            sensorRequests[sensorName] = measurements;
+        } else {
+            // Additional measurement request for existing sensor
+            if (measurements.length() > 0) {
+                if (sensorRequests[sensorName].length() > 0) {
+                    // Combine with existing measurements (comma-separated)
+                    sensorRequests[sensorName] += "," + measurements;
+                } else {
+                    // Replace empty string (all measurements) with specific measurement
+                    sensorRequests[sensorName] = measurements;
                 }
             }
-            
-            values.push_back(success ? tempValue : "ERROR");
+            // If measurements is empty (meaning all measurements), keep existing value
         }
     }
     
-    // Read humidity if requested and supported
-    if (readHum && sensorOk && sensor->supportsInterface(InterfaceType::HUMIDITY)) {
-        // Try first reading without any delay
-        HumidityReading humReading = sensorManager->getHumiditySafe(sensorName);
-        
-        if (humReading.valid) {
-            // Fast path - reading succeeded on first try (most common case)
-            values.push_back(String(humReading.value));
-        } else {
-            // Only if first read failed, apply retry logic with delays
-            bool success = false;
-            String humValue = "ERROR";
-            
-            for (int attempt = 1; attempt < MAX_RETRIES && !success; attempt++) {
-                // Log retry information at INFO level
-                errorHandler->logError(INFO, "Retry #" + String(attempt) + " for humidity reading from " + sensorName);
-                delay(RETRY_DELAY_MS); // Only delay during retries when needed
-                
-                try {
-                    humReading = sensorManager->getHumiditySafe(sensorName);
-                    
-                    if (humReading.valid) {
-                        humValue = String(humReading.value);
-                        success = true;
-                        errorHandler->logError(INFO, "Successfully read humidity from " + sensorName + " after " + String(attempt+1) + " attempts");
-                        break;
-                    }
-                } catch (...) {
-                    // Continue to next retry attempt
-                }
+    for (const auto& [sensorName, measurements] : sensorRequests) {
+        targets.push_back({sensorName, measurements});
+    }
+}
+
+void CommunicationManager::collectSensorReadings(const std::vector<MeasureTarget>& targets, MeasureMode mode,
+                                                 std::vector<String>& values) {
+    const SensorRegistry& registry = sensorManager->getRegistry();
+    
+    // One value per supported channel, in InterfaceType order
+    auto forEachChannel = [](ISensor* sensor, const String& measurements, auto&& visit) {
+        for (const ChannelDescriptor& channel : CHANNEL_DESCRIPTORS) {
+            if (sensor->supportsInterface(channel.quantity) &&
+                (measurements.length() == 0 || measurements.indexOf(channel.keyword) >= 0)) {
+                visit(channel);
             }
+        }
+    };
+    
+    // Post every read the answer depends on before waiting for any, so each
+    // bus worker serves them in one pass and the query waits only once
+    SensorReadRequest waiting[Constants::Sensors::MAX_SENSORS];
+    size_t waitCount = 0;
+    if (mode == MeasureMode::CACHED || mode == MeasureMode::FRESH) {
+        unsigned long maxAge = sensorManager->getMaxCacheAge();
+        for (const MeasureTarget& target : targets) {
+            int slot = registry.getSlot(target.sensorName);
+            ISensor* sensor = registry.getSensorBySlot(slot);
+            if (!sensor || !sensor->isConnected()) {
+                continue;
+            }
+            
+            bool missing = mode == MeasureMode::FRESH;
+            bool stale = false;
+            forEachChannel(sensor, target.measurements, [&](const ChannelDescriptor& channel) {
+                ChannelReading reading = sensorManager->getReadingSafe(target.sensorName, channel.quantity);
+                missing |= !reading.valid;
+                stale |= reading.valid && millis() - reading.timestamp > maxAge;
+            });
             
-            values.push_back(success ? humValue : "ERROR");
+            // A stale value is answered as it is and refreshed for the next query
+            SensorReadRequest request;
+            if ((missing || stale) && sensorManager->requestRead(slot, request) && missing &&
+                waitCount < Constants::Sensors::MAX_SENSORS) {
+                waiting[waitCount++] = request;
+            }
         }
     }
+    
+    if (waitCount > 0) {
+        size_t served = sensorManager->awaitReads(waiting, waitCount, Constants::Communication::MEASURE_READ_TIMEOUT_MS);
+        if (served < waitCount) {
+            LOG_INFO(errorHandler, "MEAS: %u of %u requested reads not made within %u ms", waitCount - served, waitCount,
+                     Constants::Communication::MEASURE_READ_TIMEOUT_MS);
+        }
+    }
+    
+    for (const MeasureTarget& target : targets) {
+        int slot = registry.getSlot(target.sensorName);
+        ISensor* sensor = registry.getSensorBySlot(slot);
+        if (!sensor || !sensor->isConnected()) {
+            errorHandler->logFormatted(WARNING, "Peripheral %s not found or not connected", target.sensorName);
+            continue;
+        }
+        
+        // A fresh value must come from the read this query asked for
+        bool served = mode != MeasureMode::FRESH ||
+                      std::any_of(waiting, waiting + waitCount, [&](const SensorReadRequest& request) {
+                          return request.slot == slot && sensorManager->isReadServed(request);
+                      });
+        
+        forEachChannel(sensor, target.measurements, [&](const ChannelDescriptor& channel) {
+            ChannelReading reading = sensorManager->getReadingSafe(target.sensorName, channel.quantity);
+            if (mode == MeasureMode::QUALITY) {
+                values.push_back(String(static_cast<unsigned>(reading.quality())));
+            } else if (!reading.valid || !served) {
+                values.push_back("ERROR");
+            } else if (mode == MeasureMode::AGE) {
+                values.push_back(String(millis() - reading.timestamp));
+            } else {
+                values.push_back(String(reading.reported()));
+            }
+        });
+    }
 }
 
-bool CommunicationManager::handleListSensors(const std::vector<String>& params) {
-    auto registry = sensorManager->getRegistry();
-    auto sensors = registry.getAllSensors();
+bool CommunicationManager::handleHistoryQuery(const CommandParams& params, bool byTimestamp) {
+    if (params.empty()) {
+        errorHandler->logError(ERROR, byTimestamp ? "Format is MEAS:HIST:TIME? <ms> [sensor ...]"
+                                                  : "Format is MEAS:HIST? <sequence> [sensor ...]");
+        return false;
+    }
     
-    // Build the complete response string first instead of sending it line by line
-    String response = "";
+    uint32_t since = 0;
+    if (!CommandParams::parseUnsigned(params[0], since)) {
+        errorHandler->logError(ERROR, "Invalid history start: " + params.toString(0));
+        return false;
+    }
+    const SensorRegistry& registry = sensorManager->getRegistry();
+    const TimeSync& timeSync = sensorManager->getTimeSync();
     
-    for (auto sensor : sensors) {
-        // Check each interface type and output a separate entry for each
-        if (sensor->supportsInterface(InterfaceType::TEMPERATURE)) {
-            response += sensor->getName() + ",TEMP," + 
-                      sensor->getTypeString() + "," +
-                      (sensor->isConnected() ? "CONNECTED" : "DISCONNECTED") + "\n";
+    // Restrict to the named sensors, or include every slot
+    uint32_t slotMask = params.size() > 1 ? 0 : 0xFFFFFFFFUL;
+    for (size_t i = 1; i < params.size(); i++) {
+        int slot = registry.getSlot(params.toString(i));
+        if (slot < 0) {
+            errorHandler->logError(WARNING, "Peripheral " + params.toString(i) + " not found");
+            continue;
         }
-        
-        if (sensor->supportsInterface(InterfaceType::HUMIDITY)) {
-            response += sensor->getName() + ",HUM," + 
-                      sensor->getTypeString() + "," +
-                      (sensor->isConnected() ? "CONNECTED" : "DISCONNECTED") + "\n";
+        slotMask |= 1UL << slot;
+    }
+    
+    // Lines go into the response buffer, so the whole response goes out
+    // in a few large writes without building one huge String
+    auto appendLine = [&](const char* format, auto... args) {
+        char line[128];
+        int len = snprintf(line, sizeof(line), format, args...);
+        if (len <= 0) {
+            return;
         }
+        response.write(reinterpret_cast<const uint8_t*>(line), std::min<size_t>(len, sizeof(line) - 1));
+    };
+    
+    uint32_t lastSequence = byTimestamp ? 0 : since;
+    size_t count = sensorManager->getHistory().fetch(
+        byTimestamp ? 0 : since, byTimestamp ? since : 0, slotMask,
+        Constants::Sensors::HISTORY_MAX_FETCH_RECORDS,
+        [&](const HistoryRecord& record) {
+            lastSequence = record.sequence;
+            ISensor* sensor = registry.getSensorBySlot(record.slot);
+            if (!sensor) {
+                return;
+            }
+            
+            // One line per channel: <sequence>,<timestamp>,<sensor>,<channel>,<value>,<time us>
+            // The last column is epoch microseconds once the clock is set
+            String sensorName = sensor->getName();
+            unsigned long long timeUs = timeSync.reportTimeUs(record.timeUs);
+            record.forEachValue([&](InterfaceType type, float value, bool valid) {
+                const ChannelDescriptor& channel = channelDescriptor(type);
+                if (valid) {
+                    appendLine("%lu,%lu,%s,%s,%.2f,%llu\n", (unsigned long)record.sequence,
+                               (unsigned long)record.timestampMs(), sensorName.c_str(), channel.keyword,
+                               value * channel.scale, timeUs);
+                } else {
+                    appendLine("%lu,%lu,%s,%s,ERROR,%llu\n", (unsigned long)record.sequence,
+                               (unsigned long)record.timestampMs(), sensorName.c_str(), channel.keyword, timeUs);
+                }
+            });
+        });
+    
+    // Trailer tells the host where to resume: END,<records>,<last sequence>
+    appendLine("END,%u,%lu\n", (unsigned)count, (unsigned long)lastSequence);
+    
+    return true;
+}
+
+bool CommunicationManager::handleStreamControl(const CommandParams& params) {
+    if (params.empty()) {
+        errorHandler->logError(ERROR, "Format is MEAS:STREAM ON[,<period ms>] or MEAS:STREAM OFF");
+        return false;
+    }
+    
+    // Accept both "ON,100" and "ON 100"
+    std::string_view mode = params[0];
+    std::string_view periodStr = params[1];
+    size_t commaPos = mode.find(',');
+    if (commaPos != std::string_view::npos && commaPos > 0) {
+        periodStr = mode.substr(commaPos + 1);
+        mode = mode.substr(0, commaPos);
+    }
+    
+    if (CommandParams::equalsIgnoreCase(mode, "OFF")) {
+        streamer.stop();
+        LOG_INFO(errorHandler, "Binary streaming stopped");
+        return true;
+    }
+    
+    if (!CommandParams::equalsIgnoreCase(mode, "ON")) {
+        errorHandler->logError(ERROR, "Invalid stream mode. Use ON or OFF");
+        return false;
+    }
+    
+    long period = Constants::Communication::STREAM_DEFAULT_PERIOD_MS;
+    if (!periodStr.empty() && !CommandParams::parseInt(periodStr, period)) {
+        errorHandler->logError(ERROR, "Invalid stream period: " + CommandParams::viewToString(periodStr));
+        return false;
     }
+    streamer.start(period > 0 ? period : Constants::Communication::STREAM_DEFAULT_PERIOD_MS);
+    LOG_INFO(errorHandler, "Binary streaming started every " + String(streamer.getPeriodMs()) + " ms");
+    return true;
+}
+
+bool CommunicationManager::handleStreamStatus(const CommandParams& params) {
+    response.println(streamer.isActive() ? "ON," + String(streamer.getPeriodMs()) : String("OFF"));
+    return true;
+}
+
+bool CommunicationManager::handleStreamMap(const CommandParams& params) {
+    const SensorRegistry& registry = sensorManager->getRegistry();
+    
+    // One line per channel: <channel id>,<sensor>,<keyword>
+    registry.forEachSlot([&](int slot, ISensor* sensor) {
+        forEachChannel(registry.getChannels(slot), [&](InterfaceType type) {
+            response.print(String(BinaryStreamer::channelId(slot, type)) + "," +
+                           sensor->getName() + "," + channelDescriptor(type).keyword + "\n");
+        });
+    });
     
-    // Send the complete response all at once
-    Serial.print(response);
-    // Small delay to ensure all data is sent
-    delay(5);
+    return true;
+}
+
+bool CommunicationManager::handleListSensors(const CommandParams& params) {
+    const SensorRegistry& registry = sensorManager->getRegistry();
     
-    // Flush to ensure all data is transmitted
-    Serial.flush();
+    // Lines collect in the response buffer and go out with the rest of the batch
+    registry.forEachSensor([&](ISensor* sensor) {
+        // Output a separate entry for each channel the sensor provides
+        for (const ChannelDescriptor& channel : CHANNEL_DESCRIPTORS) {
+            if (sensor->supportsInterface(channel.quantity)) {
+                response.print(sensor->getName() + "," + channel.keyword + "," +
+                               sensor->getTypeString() + "," +
+                               (sensor->isConnected() ? "CONNECTED" : "DISCONNECTED") + "\n");
+            }
+        }
+    });
     
     return true;
 }
 
-bool CommunicationManager::handleGetConfig(const std::vector<String>& params) {
+bool CommunicationManager::handleSensorHealth(const CommandParams& params) {
+    uint32_t now = millis();
+    sensorManager->getRegistry().forEachSlot([&](int slot, ISensor* sensor) {
+        SensorHealthStatus status;
+        sensorManager->getSensorHealth(slot, status);
+        
+        uint32_t retryIn = status.msUntilAttempt(now);
+        response.print(sensor->getName());
+        response.print(',');
+        response.print(sensorHealthToString(status.state));
+        response.print(',');
+        response.print(status.attempts);
+        response.print(',');
+        response.print(retryIn == UINT32_MAX ? 0 : retryIn);
+        response.print(',');
+        response.println(status.since ? now - status.since : 0);
+    });
+    return true;
+}
+
+bool CommunicationManager::handleGetConfig(const CommandParams& params) {
     String config = configManager->getConfigJson();
-    Serial.println(config);
+    response.println(config);
     return true;
 }
 
-bool CommunicationManager::handleSetBoardId(const std::vector<String>& params) {
+bool CommunicationManager::handleSetBoardId(const CommandParams& params) {
     if (params.empty()) {
         errorHandler->logError(ERROR, "No board ID specified");
         return false;
     }
     
-    // Join all parameters since the board ID might have spaces
-    String boardId = "";
-    for (const auto& param : params) {
-        if (boardId.length() > 0) boardId += " ";
-        boardId += param;
-    }
-    
-    // Trim any leading/trailing whitespace
-    boardId.trim();
+    // The board ID is the rest of the line since it might have spaces
+    String boardId = params.restCStr();
     
     // Validate that the board ID is not empty after trimming
     if (boardId.length() == 0) {
@@ -458,31 +720,27 @@ bool CommunicationManager::handleSetBoardId(const std::vector<String>& params) {
         return false;
     }
     
-    errorHandler->logError(INFO, "Setting board ID to: '" + boardId + "'");
+    LOG_INFO(errorHandler, "Setting board ID to: '" + boardId + "'");
     
     bool success = configManager->setBoardIdentifier(boardId);
     if (!success) {
         errorHandler->logError(ERROR, "Failed to update Board ID");
     } else {
-        errorHandler->logError(INFO, "Successfully updated board ID to: '" + boardId + "'");
+        LOG_INFO(errorHandler, "Successfully updated board ID to: '" + boardId + "'");
     }
     return success;
 }
 
-bool CommunicationManager::handleUpdateConfig(const std::vector<String>& params) {
+bool CommunicationManager::handleUpdateConfig(const CommandParams& params) {
     if (params.empty()) {
         errorHandler->logError(ERROR, "No configuration JSON provided");
         return false;
     }
 
-    // Join all parameters since the JSON might have spaces
-    String jsonConfig = "";
-    for (const auto& param : params) {
-        if (jsonConfig.length() > 0) jsonConfig += " ";
-        jsonConfig += param;
-    }
+    // The JSON is the rest of the line, spacing intact, parsed where it lies
+    const char* jsonConfig = params.restCStr();
     
-    errorHandler->logError(INFO, "Processing config update: " + jsonConfig.substring(0, 50) + "...");
+    LOG_INFO(errorHandler, "Processing config update: %.50s...", jsonConfig);
     bool success = configManager->updateConfigFromJson(jsonConfig);
     if (!success) {
         errorHandler->logError(ERROR, "Failed to update configuration");
@@ -490,30 +748,26 @@ bool CommunicationManager::handleUpdateConfig(const std::vector<String>& params)
     return success;
 }
 
-bool CommunicationManager::handleUpdateSensorConfig(const std::vector<String>& params) {
+bool CommunicationManager::handleUpdateSensorConfig(const CommandParams& params) {
     if (params.empty()) {
         errorHandler->logError(WARNING, "No sensor configuration provided");
     }
     
-    // Join all parameters since the JSON might have spaces
-    String jsonConfig = "";
-    for (const auto& param : params) {
-        if (jsonConfig.length() > 0) jsonConfig += " ";
-        jsonConfig += param;
-    }
+    // The JSON is the rest of the line, spacing intact, parsed where it lies
+    const char* jsonConfig = params.restCStr();
     
-    errorHandler->logError(INFO, "Processing sensor config update: " + 
-                         jsonConfig.substring(0, std::min(50, (int)jsonConfig.length())) + 
-                         (jsonConfig.length() > 50 ? "..." : ""));
+    LOG_INFO(errorHandler, "Processing sensor config update: %.50s%s", jsonConfig,
+             strlen(jsonConfig) > 50 ? "..." : "");
     
     bool success = configManager->updateSensorConfigFromJson(jsonConfig);
     if (!success) {
         errorHandler->logError(ERROR, "Failed to update sensor configuration");
         return false;
     }
-    errorHandler->logError(INFO, "Reinitializing peripherals with new configuration");
-    if (sensorManager->initializeSensors()) {
-        errorHandler->logError(INFO, "Successfully reinitialized peripherals with new configuration");
+    // Swap in the new sensor set while the acquisition tasks keep sampling
+    LOG_INFO(errorHandler, "Applying new peripheral configuration");
+    if (sensorManager->applySensorConfigs(configManager->getSensorConfigs())) {
+        LOG_INFO(errorHandler, "Successfully applied new peripheral configuration");
     } else {
         errorHandler->logError(ERROR, "Failed to reinitialize some peripherals after configuration update");
     }
@@ -521,21 +775,16 @@ bool CommunicationManager::handleUpdateSensorConfig(const std::vector<String>& p
     return true;
 }
 
-bool CommunicationManager::handleUpdateAdditionalConfig(const std::vector<String>& params) {
+bool CommunicationManager::handleUpdateAdditionalConfig(const CommandParams& params) {
     if (params.empty()) {
         errorHandler->logError(WARNING, "No additional configuration provided");
     }
     
-    // Join all parameters since the JSON might have spaces
-    String jsonConfig = "";
-    for (const auto& param : params) {
-        if (jsonConfig.length() > 0) jsonConfig += " ";
-        jsonConfig += param;
-    }
+    // The JSON is the rest of the line, spacing intact, parsed where it lies
+    const char* jsonConfig = params.restCStr();
     
-    errorHandler->logError(INFO, "Processing additional config update: " + 
-                         jsonConfig.substring(0, std::min(50, (int)jsonConfig.length())) + 
-                         (jsonConfig.length() > 50 ? "..." : ""));
+    LOG_INFO(errorHandler, "Processing additional config update: %.50s%s", jsonConfig,
+             strlen(jsonConfig) > 50 ? "..." : "");
     
     bool success = configManager->updateAdditionalConfigFromJson(jsonConfig);
     if (!success) {
@@ -544,27 +793,477 @@ bool CommunicationManager::handleUpdateAdditionalConfig(const std::vector<String
     return success;
 }
 
-bool CommunicationManager::handleReset(const std::vector<String>& params) {
-    errorHandler->logError(INFO, "Reset command received");
-    Serial.println("Resetting device...");
+bool CommunicationManager::handleReset(const CommandParams& params) {
+    LOG_INFO(errorHandler, "Reset command received");
+    response.println("Resetting device...");
+    response.send();
+    configManager->flush();
     delay(100);  // Give time for the message to be sent
     ESP.restart();
     return true;
 }
 
-bool CommunicationManager::handleEcho(const std::vector<String>& params) {
-    String message = params.empty() ? "ECHO" : params[0];
-    Serial.println("ECHO: " + message);
+bool CommunicationManager::handleEcho(const CommandParams& params) {
+    String message = params.empty() ? String("ECHO") : params.toString(0);
+    response.println("ECHO: " + message);
     return true;
 }
 
-bool CommunicationManager::handleLogStatus(const std::vector<String>& params) {
+bool CommunicationManager::handleLogStatus(const CommandParams& params) {
     String status = errorHandler->getRoutingStatus();
-    Serial.println(status);
+    response.println(status);
+    return true;
+}
+
+bool CommunicationManager::handleLogHistory(const CommandParams& params) {
+    uint32_t since = 0;
+    if (!params.empty() && !CommandParams::parseUnsigned(params[0], since)) {
+        errorHandler->logError(ERROR, "Invalid log history start: " + params.toString(0));
+        return false;
+    }
+    
+    uint32_t maxEntries = Constants::Logging::HISTORY_MAX_FETCH;
+    if (params.size() > 1 && (!CommandParams::parseUnsigned(params[1], maxEntries) || maxEntries == 0)) {
+        errorHandler->logError(ERROR, "Invalid log history count: " + params.toString(1));
+        return false;
+    }
+    maxEntries = std::min<uint32_t>(maxEntries, Constants::Logging::HISTORY_MAX_FETCH);
+    
+    uint32_t lastSequence = since;
+    char line[Constants::Logging::HISTORY_MESSAGE_SIZE + 40];
+    size_t count = errorHandler->fetchHistory(since, maxEntries, [&](const LogHistoryEntry& entry) {
+        lastSequence = entry.sequence;
+        int len = snprintf(line, sizeof(line), "%lu,%lu,%s,%s\n", (unsigned long)entry.sequence,
+                           (unsigned long)entry.timestamp,
+                           ErrorHandler::severityName(static_cast<ErrorSeverity>(entry.severity)), entry.message);
+        if (len > 0) {
+            response.write(reinterpret_cast<const uint8_t*>(line), std::min<size_t>(len, sizeof(line) - 1));
+        }
+    });
+    
+    int len = snprintf(line, sizeof(line), "END,%u,%lu\n", (unsigned)count, (unsigned long)lastSequence);
+    response.write(reinterpret_cast<const uint8_t*>(line), len);
+    
+    return true;
+}
+
+bool CommunicationManager::handleI2CScan(const CommandParams& params) {
+    std::vector<I2CManager::BusProbe> probes;
+    if (!sensorManager->discoverI2CDevices(true, probes)) {
+        errorHandler->logError(ERROR, "No I2C bus initialized to scan");
+        return false;
+    }
+    
+    for (const auto& probe : probes) {
+        String line = I2CManager::portToString(probe.port) + "," + String(probe.found.size());
+        char address[8];
+        for (int found : probe.found) {
+            snprintf(address, sizeof(address), ",0x%02X", found);
+            line += address;
+        }
+        response.println(line);
+    }
+    return true;
+}
+
+bool CommunicationManager::handleI2CClock(const CommandParams& params) {
+    // Accept both "I2C0,400000" and "I2C0 400000"
+    std::string_view bus = params[0];
+    std::string_view clockStr = params[1];
+    size_t commaPos = bus.find(',');
+    if (commaPos != std::string_view::npos) {
+        clockStr = bus.substr(commaPos + 1);
+        bus = bus.substr(0, commaPos);
+    }
+    
+    uint32_t clockFreq = 0;
+    if ((!CommandParams::equalsIgnoreCase(bus, "I2C0") && !CommandParams::equalsIgnoreCase(bus, "I2C1")) ||
+        !CommandParams::parseUnsigned(clockStr, clockFreq)) {
+        errorHandler->logError(ERROR, "Format is SYST:I2C:CLOC <I2C0|I2C1>,<Hz>");
+        return false;
+    }
+    
+    I2CPort port = I2CManager::stringToPort(CommandParams::viewToString(bus));
+    if (!sensorManager->setI2CClockLimit(port, clockFreq)) {
+        return false;
+    }
+    LOG_INFO(errorHandler, I2CManager::portToString(port) + " clock limit now " + 
+                         String(sensorManager->getI2CClockLimit(port)) + " Hz");
+    return true;
+}
+
+bool CommunicationManager::handleI2CClockQuery(const CommandParams& params) {
+    char line[128];
+    for (I2CPort port : {I2CPort::I2C0, I2CPort::I2C1}) {
+        BusClockStatus status = sensorManager->getI2CClockStatus(port);
+        snprintf(line, sizeof(line), "%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu", I2CManager::portToString(port).c_str(),
+                 (unsigned long)status.clockFrequency, (unsigned long)sensorManager->getI2CClockLimit(port),
+                 (unsigned long)status.transactions, (unsigned long)status.errors,
+                 (unsigned long)status.fallbacks, (unsigned long)status.muxSwitches,
+                 (unsigned long)status.muxSkips);
+        response.println(line);
+    }
+    return true;
+}
+
+bool CommunicationManager::handlePerfQuery(const CommandParams& params) {
+    char line[96];
+    for (size_t i = 0; i < static_cast<size_t>(PerfSite::COUNT); i++) {
+        PerfSite site = static_cast<PerfSite>(i);
+        PerfHistogram::Summary summary = PerfCounters::histogram(site).summarize();
+        snprintf(line, sizeof(line), "%s,%lu,%.2f,%.2f,%.2f,%.2f", PerfCounters::siteName(site),
+                 (unsigned long)summary.count,
+                 PerfCounters::cyclesToMicros(summary.min), PerfCounters::cyclesToMicros(summary.p50),
+                 PerfCounters::cyclesToMicros(summary.p99), PerfCounters::cyclesToMicros(summary.max));
+        response.println(line);
+    }
+    return true;
+}
+
+bool CommunicationManager::handleMemoryQuery(const CommandParams& params) {
+    char line[96];
+    const struct { const char* name; uint32_t caps; } regions[] = {
+        {"internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT},
+        {"psram", MALLOC_CAP_SPIRAM},
+    };
+    for (const auto& region : regions) {
+        size_t total = heap_caps_get_total_size(region.caps);
+        if (total == 0) {
+            continue;
+        }
+        size_t freeBytes = heap_caps_get_free_size(region.caps);
+        size_t largest = heap_caps_get_largest_free_block(region.caps);
+        // Share of free memory not usable for the largest request
+        unsigned fragmentation = freeBytes ? 100 - static_cast<unsigned>(uint64_t(largest) * 100 / freeBytes) : 0;
+        snprintf(line, sizeof(line), "heap,%s,%lu,%lu,%lu,%lu,%u", region.name, (unsigned long)freeBytes,
+                 (unsigned long)largest, (unsigned long)heap_caps_get_minimum_free_size(region.caps),
+                 (unsigned long)total, fragmentation);
+        response.println(line);
+    }
+    
+    const SensorPool& pool = sensorManager->getSensorPool();
+    snprintf(line, sizeof(line), "sensor_pool,%u,%u,%u,%lu,%lu", (unsigned)pool.getInUse(),
+             (unsigned)pool.getCapacity(), (unsigned)pool.getHighWater(),
+             (unsigned long)(pool.getCapacity() * pool.getBlockSize()), (unsigned long)pool.getHeapFallbacks());
+    response.println(line);
+    
+    const ReadingHistory& history = sensorManager->getHistory();
+    snprintf(line, sizeof(line), "reading_history,%lu,%s", (unsigned long)history.getMemoryBytes(),
+             history.isInPsram() ? "psram" : "internal");
+    response.println(line);
+    
+    snprintf(line, sizeof(line), "log_history,%lu,%s", (unsigned long)errorHandler->getHistoryBytes(),
+             errorHandler->isHistoryInPsram() ? "psram" : "internal");
+    response.println(line);
     return true;
 }
 
-bool CommunicationManager::handleLogRouting(const std::vector<String>& params) {
+bool CommunicationManager::handleTaskQuery(const CommandParams& params) {
+    if (!taskManager) {
+        errorHandler->logError(ERROR, "Task manager not available");
+        return false;
+    }
+    const TaskSupervisor& supervisor = taskManager->getSupervisor();
+    
+    // Only the comm task runs handlers, so the report buffer stays off its stack
+    static TaskSupervisor::TaskReport reports[Constants::Tasks::MAX_SYSTEM_TASKS];
+    size_t count = supervisor.getReports(reports, Constants::Tasks::MAX_SYSTEM_TASKS);
+    
+    auto formatPercent = [](char* out, size_t size, uint16_t permille) {
+        if (permille == TaskSupervisor::CPU_UNKNOWN) {
+            out[0] = '\0';
+        } else {
+            snprintf(out, size, "%u.%u", permille / 10, permille % 10);
+        }
+    };
+    
+    char line[128];
+    char cpu[8];
+    char core[8];
+    for (size_t i = 0; i < count; i++) {
+        const TaskSupervisor::TaskReport& report = reports[i];
+        formatPercent(cpu, sizeof(cpu), report.cpuPermille);
+        if (report.core == tskNO_AFFINITY) {
+            strcpy(core, "ANY");
+        } else {
+            snprintf(core, sizeof(core), "%d", (int)report.core);
+        }
+        int len = snprintf(line, sizeof(line), "task,%s,%s,%s,%u,%s,%lu", report.name, core,
+                           TaskSupervisor::stateName(report.state), (unsigned)report.priority, cpu,
+                           (unsigned long)report.stackFree);
+        if (report.supervised && len > 0 && len < (int)sizeof(line)) {
+            snprintf(line + len, sizeof(line) - len, ",%s,%lu,%lu,%lu", report.stalled ? "STALLED" : "OK",
+                     (unsigned long)report.sinceCheckInMs, (unsigned long)report.missedDeadlines,
+                     (unsigned long)report.stalls);
+        } else if (len > 0 && len < (int)sizeof(line)) {
+            snprintf(line + len, sizeof(line) - len, ",-,,,");
+        }
+        response.println(line);
+    }
+    
+    for (BaseType_t i = 0; i < portNUM_PROCESSORS; i++) {
+        formatPercent(cpu, sizeof(cpu), supervisor.getCoreLoad(i));
+        snprintf(line, sizeof(line), "core,%d,%s", (int)i, cpu);
+        response.println(line);
+    }
+    return true;
+}
+
+bool CommunicationManager::handleTaskConfigQuery(const CommandParams& params) {
+    if (!taskManager) {
+        errorHandler->logError(ERROR, "Task manager not available");
+        return false;
+    }
+    
+    const TaskPlacementConfig& placement = taskManager->getPlacement();
+    char line[64];
+    for (size_t i = 0; i < static_cast<size_t>(TaskRole::COUNT); i++) {
+        TaskRole role = static_cast<TaskRole>(i);
+        const TaskPlacement& task = placement[role];
+        snprintf(line, sizeof(line), "%s,%s,%u,%lu", taskRoleToString(role), taskCoreToString(task.core).c_str(),
+                 (unsigned)task.priority, (unsigned long)task.stackSize);
+        response.println(line);
+    }
+    return true;
+}
+
+namespace {
+    /**
+     * @brief Split "<role>,<value>" or "<role> <value>" and look up the role
+     * @param params Command parameters
+     * @param role [out] Task role
+     * @param value [out] View of the value
+     * @return true if the role is known and a value is present
+     */
+    bool parseTaskRoleArgument(const CommandParams& params, TaskRole& role, std::string_view& value) {
+        std::string_view name = params[0];
+        value = params[1];
+        size_t commaPos = name.find(',');
+        if (commaPos != std::string_view::npos) {
+            value = name.substr(commaPos + 1);
+            name = name.substr(0, commaPos);
+        }
+        return !value.empty() && taskRoleFromString(CommandParams::viewToString(name).c_str(), role);
+    }
+}
+
+bool CommunicationManager::handleTaskPriority(const CommandParams& params) {
+    TaskRole role;
+    std::string_view value;
+    uint32_t priority = 0;
+    if (!taskManager || !parseTaskRoleArgument(params, role, value) ||
+        !CommandParams::parseUnsigned(value, priority) || !taskManager->setTaskPriority(role, priority)) {
+        errorHandler->logError(ERROR, "Format is SYST:TASK:PRI <role>,<1-" +
+                             String(Constants::Tasks::MAX_TASK_PRIORITY) + ">");
+        return false;
+    }
+    LOG_INFO(errorHandler, String(taskRoleToString(role)) + " task priority now " + String(priority));
+    return true;
+}
+
+bool CommunicationManager::handleTaskCore(const CommandParams& params) {
+    TaskRole role;
+    std::string_view value;
+    uint32_t core = 0;
+    bool valid = taskManager && parseTaskRoleArgument(params, role, value);
+    if (valid && CommandParams::equalsIgnoreCase(value, "ANY")) {
+        core = static_cast<uint32_t>(tskNO_AFFINITY);
+    } else {
+        valid = valid && CommandParams::parseUnsigned(value, core);
+    }
+    if (!valid || !taskManager->setTaskCore(role, static_cast<BaseType_t>(core))) {
+        errorHandler->logError(ERROR, "Format is SYST:TASK:CORE <role>,<0-" + String(portNUM_PROCESSORS - 1) + "|ANY>");
+        return false;
+    }
+    LOG_INFO(errorHandler, String(taskRoleToString(role)) + " task moving to Core " +
+                         taskCoreToString(static_cast<BaseType_t>(core)));
+    return true;
+}
+
+bool CommunicationManager::handleBenchmark(const CommandParams& params) {
+    if (!taskManager) {
+        errorHandler->logError(ERROR, "Task manager not available");
+        return false;
+    }
+    uint32_t phaseMs = Constants::Communication::BENCH_DEFAULT_PHASE_MS;
+    if (!params.empty() && !CommandParams::parseUnsigned(params[0], phaseMs)) {
+        errorHandler->logError(ERROR, "Invalid benchmark phase length: " + CommandParams::viewToString(params[0]));
+        return false;
+    }
+    phaseMs = constrain(phaseMs, Constants::Communication::BENCH_MIN_PHASE_MS,
+                        Constants::Communication::BENCH_MAX_PHASE_MS);
+    LOG_INFO(errorHandler, "Benchmark: three phases of %lu ms", (unsigned long)phaseMs);
+    
+    // Answers of earlier commands on the line go out before any stream frames
+    response.send();
+    
+    // The phases keep the comm task busy on purpose; check in and sample the heap as they run
+    const uint32_t heapCaps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    size_t lowestFree = heap_caps_get_free_size(heapCaps);
+    unsigned long lastKeepAlive = millis();
+    auto keepAlive = [&]() {
+        if (millis() - lastKeepAlive >= Constants::Communication::BENCH_KEEPALIVE_MS) {
+            lastKeepAlive = millis();
+            taskManager->keepAlive();
+            lowestFree = std::min(lowestFree, heap_caps_get_free_size(heapCaps));
+        }
+    };
+    
+    // Each connected sensor is asked again as soon as its last read is served, so
+    // every bus worker runs flat out and a slow bus does not hold back a fast one
+    const SensorRegistry& registry = sensorManager->getRegistry();
+    static SensorReadRequest pending[Constants::Sensors::MAX_SENSORS];
+    static SensorReadRequest waiting[Constants::Sensors::MAX_SENSORS];
+    bool posted[Constants::Sensors::MAX_SENSORS] = {};
+    uint32_t served[Constants::Sensors::MAX_SENSORS] = {};
+    auto driveReads = [&]() {
+        size_t count = 0;
+        registry.forEachSlot([&](int slot, ISensor* sensor) {
+            if (posted[slot] && sensorManager->isReadServed(pending[slot])) {
+                served[slot]++;
+                posted[slot] = false;
+            }
+            if (!posted[slot] && sensor->isConnected()) {
+                posted[slot] = sensorManager->requestRead(slot, pending[slot]);
+            }
+            if (posted[slot]) {
+                waiting[count++] = pending[slot];
+            }
+        });
+        // Wakes on every served pass; the short bound lets finished sensors be asked again
+        sensorManager->awaitReads(waiting, count, 1);
+        return count;
+    };
+    
+    // Phase 1: on-demand reads
+    unsigned long start = millis();
+    while (millis() - start < phaseMs && driveReads() > 0) {
+        keepAlive();
+    }
+    unsigned long readMs = std::max(1UL, millis() - start);
+    
+    // Phase 2: MEAS? through the full command path, answered into a counter
+    ByteCounter sink;
+    Print* port = response.setOutput(&sink);
+    char line[128];
+    uint32_t queries = 0;
+    uint64_t queryUs = 0;
+    uint32_t worstUs = 0;
+    start = millis();
+    while (millis() - start < phaseMs) {
+        strcpy(line, "MEAS?");
+        int64_t began = esp_timer_get_time();
+        executeCommand(line, strlen(line));
+        uint32_t elapsed = static_cast<uint32_t>(esp_timer_get_time() - began);
+        queryUs += elapsed;
+        worstUs = std::max(worstUs, elapsed);
+        queries++;
+        keepAlive();
+    }
+    unsigned long measMs = std::max(1UL, millis() - start);
+    response.send();
+    response.setOutput(port);
+    
+    // Phase 3: streaming at the shortest period while the reads are hammered
+    bool wasStreaming = streamer.isActive();
+    uint32_t previousPeriod = streamer.getPeriodMs();
+    uint32_t readsBefore[Constants::Sensors::MAX_SENSORS];
+    memcpy(readsBefore, served, sizeof(served));
+    streamer.start(Constants::Communication::STREAM_MIN_PERIOD_MS);
+    uint32_t bytesBefore = streamer.getBytesSent();
+    start = millis();
+    while (millis() - start < phaseMs) {
+        driveReads();
+        streamer.service();
+        keepAlive();
+    }
+    unsigned long streamMs = std::max(1UL, millis() - start);
+    uint32_t streamBytes = streamer.getBytesSent() - bytesBefore;
+    if (wasStreaming) {
+        streamer.start(previousPeriod);
+    } else {
+        streamer.stop();
+    }
+    
+    // Report
+    snprintf(line, sizeof(line), "bench,%lu", (unsigned long)phaseMs);
+    response.println(line);
+    uint32_t totalReads = 0;
+    registry.forEachSlot([&](int slot, ISensor* sensor) {
+        uint32_t reads = readsBefore[slot];
+        totalReads += reads;
+        snprintf(line, sizeof(line), "read,%s,%lu,%.1f", sensor->getName().c_str(), (unsigned long)reads,
+                 reads * 1000.0f / readMs);
+        response.println(line);
+    });
+    snprintf(line, sizeof(line), "read_total,%lu,%.1f", (unsigned long)totalReads, totalReads * 1000.0f / readMs);
+    response.println(line);
+    
+    snprintf(line, sizeof(line), "meas,%lu,%.1f,%lu,%lu", (unsigned long)queries, queries * 1000.0f / measMs,
+             (unsigned long)(queries ? queryUs / queries : 0), (unsigned long)worstUs);
+    response.println(line);
+    
+    snprintf(line, sizeof(line), "stream,%lu,%.1f,%.1f", (unsigned long)streamBytes, streamBytes * 1000.0f / streamMs,
+             streamBytes * 1000.0f / streamMs / BinaryStreamer::FRAME_SIZE);
+    response.println(line);
+    
+    snprintf(line, sizeof(line), "heap,internal,%lu,%lu", (unsigned long)lowestFree,
+             (unsigned long)heap_caps_get_minimum_free_size(heapCaps));
+    response.println(line);
+    
+    // Only the comm task runs handlers, so the report buffer stays off its stack
+    static TaskSupervisor::TaskReport reports[Constants::Tasks::MAX_SYSTEM_TASKS];
+    size_t count = taskManager->getSupervisor().getReports(reports, Constants::Tasks::MAX_SYSTEM_TASKS);
+    for (size_t i = 0; i < count; i++) {
+        snprintf(line, sizeof(line), "stack,%s,%lu", reports[i].name, (unsigned long)reports[i].stackFree);
+        response.println(line);
+    }
+    
+    LOG_INFO(errorHandler, "Benchmark: %lu reads, %lu queries, %lu stream bytes", (unsigned long)totalReads,
+             (unsigned long)queries, (unsigned long)streamBytes);
+    return true;
+}
+
+bool CommunicationManager::handleTimeSet(const CommandParams& params) {
+    uint64_t epochUs = 0;
+    if (params.empty() || !CommandParams::parseUnsigned(params[0], epochUs) || epochUs == 0) {
+        errorHandler->logError(ERROR, "Format is SYST:TIME <epoch microseconds>");
+        return false;
+    }
+    
+    sensorManager->getTimeSync().synchronize(epochUs, TimeSource::HOST);
+    TimeSync::Status status = sensorManager->getTimeSync().getStatus();
+    if (status.driftKnown) {
+        LOG_INFO(errorHandler, "Clock set by host, drift %ld ppb", (long)status.driftPpb);
+    } else {
+        LOG_INFO(errorHandler, "Clock set by host");
+    }
+    return true;
+}
+
+bool CommunicationManager::handleTimeQuery(const CommandParams& params) {
+    const TimeSync& timeSync = sensorManager->getTimeSync();
+    uint64_t deviceUs = static_cast<uint64_t>(esp_timer_get_time());
+    TimeSync::Status status = timeSync.getStatus();
+    
+    char line[96];
+    char drift[12] = "";
+    if (status.driftKnown) {
+        snprintf(drift, sizeof(drift), "%ld", (long)status.driftPpb);
+    }
+    snprintf(line, sizeof(line), "%llu,%llu,%s,%s,%lu", (unsigned long long)timeSync.toEpochUs(deviceUs),
+             (unsigned long long)deviceUs, timeSourceToString(status.source), drift, (unsigned long)status.syncs);
+    response.println(line);
+    return true;
+}
+
+bool CommunicationManager::handlePerfReset(const CommandParams& params) {
+    PerfCounters::resetAll();
+    LOG_INFO(errorHandler, "Performance counters reset");
+    return true;
+}
+
+bool CommunicationManager::handleLogRouting(const CommandParams& params) {
     if (params.empty()) {
         errorHandler->logError(ERROR, "Format is SYST:LOG <destination>,<severity>");
         return false;
@@ -573,15 +1272,15 @@ bool CommunicationManager::handleLogRouting(const std::vector<String>& params) {
     // Check if the parameters are in a single comma-separated string or in two separate parameters
     String destination, severityStr;
     
-    if (params.size() == 1 && params[0].indexOf(',') > 0) {
+    size_t commaPos = params[0].find(',');
+    if (params.size() == 1 && commaPos != std::string_view::npos && commaPos > 0) {
         // Format: "USB,INFO" (comma-separated in a single parameter)
-        int commaPos = params[0].indexOf(',');
-        destination = params[0].substring(0, commaPos);
-        severityStr = params[0].substring(commaPos + 1);
+        destination = CommandParams::viewToString(params[0].substr(0, commaPos));
+        severityStr = CommandParams::viewToString(params[0].substr(commaPos + 1));
     } else if (params.size() >= 2) {
         // Format: "USB" "INFO" (two separate parameters)
-        destination = params[0];
-        severityStr = params[1];
+        destination = params.toString(0);
+        severityStr = params.toString(1);
     } else {
         errorHandler->logError(ERROR, "Format is SYST:LOG <destination>,<severity>");
         return false;
@@ -612,16 +1311,16 @@ bool CommunicationManager::handleLogRouting(const std::vector<String>& params) {
     // Set the routing configuration
     errorHandler->setOutputSeverity(targetStream, minSeverity);
     
-    errorHandler->logError(INFO, "Log routing updated: " + destination + " will show " + 
+    LOG_INFO(errorHandler, "Log routing updated: " + destination + " will show " + 
                  ErrorHandler::severityToString(minSeverity) + " and higher");
     
     return true;
 }
 
-bool CommunicationManager::handleLedIdentify(const std::vector<String>& params) {
+bool CommunicationManager::handleLedIdentify(const CommandParams& params) {
     if (ledManager) {
         ledManager->startIdentify();
-        errorHandler->logError(INFO, "identify mode activated");
+        LOG_INFO(errorHandler, "identify mode activated");
     } else {
         errorHandler->logError(ERROR, "LED manager not available");
         return false;
@@ -629,12 +1328,12 @@ bool CommunicationManager::handleLedIdentify(const std::vector<String>& params)
     return true;
 }
 
-bool CommunicationManager::handleTestErrorLevel(const std::vector<String>& params, ErrorSeverity severity) {
+bool CommunicationManager::handleTestErrorLevel(const CommandParams& params, ErrorSeverity severity) {
     String severityStr = ErrorHandler::severityToString(severity);
     
     String message = "Test " + severityStr + " message";
     if (params.size() > 0) {
-        message = params[0];
+        message = params.toString(0);
     }
     bool isFatal = errorHandler->logError(severity, message);
     
@@ -647,24 +1346,33 @@ bool CommunicationManager::handleTestErrorLevel(const std::vector<String>& param
     // For FATAL errors, handle specially
     if (isFatal) {
         // For FATAL, we might want to reset after some delay
-        int resetDelay = -1;
+        long resetDelay = -1;
         if (params.size() > 1) {
-            resetDelay = params[1].toInt();
+            CommandParams::parseInt(params[1], resetDelay);
         }
         
         if (resetDelay > 0) {
             errorHandler->logError(FATAL, "Device will reset after " + String(resetDelay) + "ms");
+            configManager->flush();
+            response.send();
             Serial.flush();
+            // The delay may outlast the task watchdog, which would reset the device first
+            if (taskManager) {
+                taskManager->releaseSupervision();
+            }
             delay(resetDelay);
             ESP.restart();
         } else {
             errorHandler->logError(FATAL, "Fatal error - device halted");
+            response.send();
             Serial.flush();
-            // Enter infinite loop, but keep LED updated
+            // Halted for good, so the task watchdog must not reset the device
+            if (taskManager) {
+                taskManager->releaseSupervision();
+            }
+            
+            // Enter infinite loop; the LED task keeps showing the fatal state
             while (true) {
-                if (ledManager) {
-                    ledManager->update();
-                }
                 delay(100);
                 yield();
             }
@@ -12,41 +12,39 @@
 
  #include <Arduino.h>
  #include <map>
- #include <functional>
  #include <vector>
  #include "Constants.h"
  
- // Forward declarations for SCPI parser classes
- class SCPI_Parser;
- class SCPI_Commands;
- class SCPI_Parameters;
- class Stream;
- 
  #include "../managers/SensorManager.h"
  #include "../config/ConfigManager.h"
  #include "../error/ErrorHandler.h"
  #include "../managers/LedManager.h"
+ #include "../managers/TaskSupervisor.h"
+ #include "BinaryStreamer.h"
+ #include "ResponseBuffer.h"
+ #include "CommandParams.h"
+ #include "ScpiCommandTable.h"
+ 
+ class CommunicationManager;
+ class TaskManager;
  
  /**
   * @brief Command Handler function signature
-  * @param params Vector of string parameters from the command
+  * A plain member function pointer, so the command table is a constant
+  * that needs no heap objects and is placed in flash.
+  * @param params Views of the command parameters into the line buffer
   * @return true if command was successfully processed
   */
- typedef std::function<bool(const std::vector<String>&)> CommandHandler;
+ typedef bool (CommunicationManager::*CommandHandler)(const CommandParams&);
  
  /**
   * @brief Manages communication with external systems using SCPI commands
-  * Processes incoming commands through both a custom command handler and SCPI parser,
-  * providing a unified interface for controlling the device via serial. Supports
-  * custom command processing and SCPI standards compliance.
+  * Incoming lines are matched against a compile-time command table that
+  * accepts SCPI short and long forms in any case, providing a unified
+  * interface for controlling the device via serial.
   */
  class CommunicationManager {
  private:
-     /**
-      * @brief SCPI parser instance
-      */
-     SCPI_Parser* scpiParser;
-     
      /**
       * @brief References to other system managers
       * @{
@@ -55,13 +53,58 @@
      ConfigManager* configManager;
      ErrorHandler* errorHandler;
      LedManager* ledManager = nullptr;
+     TaskManager* taskManager = nullptr;
      /** @} */
      
      /**
-      * @brief Map of command strings to handler functions
+      * @brief Binary measurement stream sharing the command port
       */
-     std::map<String, CommandHandler> commandHandlers;
- 
+     BinaryStreamer streamer;
+     
+     /**
+      * @brief Responses of the commands handled in one processCommandLine() pass
+      */
+     ResponseBuffer response;
+     
+     /**
+      * @brief Last full MEAS? response and the data it was built from
+      * Reused while no reading has been recorded and the sensor set is
+      * unchanged, so repeated queries between acquisitions skip the
+      * collection and formatting.
+      */
+     struct MeasureCache {
+         bool valid = false;       ///< line holds a reusable response
+         uint32_t sequence = 0;    ///< Reading history sequence when built
+         uint32_t topology = 0;    ///< Sensor topology generation when built
+         String line;              ///< Formatted CSV line
+     } measureCache;
+     
+     /**
+      * @brief Fixed buffer the incoming command line is assembled in
+      * Filled with bulk reads as bytes arrive; command parameters are
+      * views into it, so parsing never allocates.
+      */
+     char lineBuffer[Constants::Communication::MAX_BUFFER_SIZE];
+     size_t lineLength = 0;           ///< Bytes of the current partial line
+     bool discardingLine = false;     ///< Skipping the rest of an oversized line
+     
+     /**
+      * @brief Execute one complete line, which may hold several commands
+      * Commands are separated by ';' as in SCPI compound commands; a ';'
+      * inside quotes or a JSON object or array is part of a parameter.
+      * @param line Null-terminated line inside lineBuffer (modified in place)
+      * @param length Line length excluding the terminator
+      */
+     void executeLine(char* line, size_t length);
+     
+     /**
+      * @brief Parse and dispatch one command
+      * @param command Null-terminated command inside lineBuffer (modified in place)
+      * @param length Command length excluding the terminator
+      */
+     void executeCommand(char* command, size_t length);
+
+     
      /**
       * @brief Static reference to UART debug serial
       */
@@ -71,19 +114,63 @@
       * @brief Singleton instance for callback access
       */
      static CommunicationManager* instance;
-
+ 
      /**
-      * @brief Register all commands with their handlers
+      * @brief What a measurement query reports for each value
       */
-     void registerCommandHandlers();
- 
+     enum class MeasureMode : uint8_t {
+         CACHED,   ///< Latest reading; missing ones are read on demand, stale ones refreshed behind the answer
+         FRESH,    ///< Reading from a read started after the query
+         AGE,      ///< Milliseconds since the latest reading was measured
+         QUALITY   ///< QualityCode of the latest reading
+     };
+     
+     /**
+      * @brief One sensor named by a measurement query
+      */
+     struct MeasureTarget {
+         String sensorName;     ///< Sensor to report
+         String measurements;   ///< Channel keywords, upper case and comma-separated, or empty for all
+     };
+     
+     /**
+      * @brief Turn measurement query parameters into one target per sensor
+      * Every registered sensor without parameters; otherwise the named
+      * ones, with repeated names merged into one target.
+      * @param params sensor[:measurements] parameters
+      * @param targets [out] Sensors to report, in the order they are answered
+      */
+     void collectMeasureTargets(const CommandParams& params, std::vector<MeasureTarget>& targets);
+     
      /**
-      * @brief Collect readings from a sensor into a values vector
-      * @param sensorName The name of the sensor to read from
-      * @param measurements The measurements to read (comma-separated or empty for all)
+      * @brief Collect the values of several sensors
+      * Every read the query needs is requested first, so the bus workers
+      * serve them in their next passes, and then awaited once with
+      * Constants::Communication::MEASURE_READ_TIMEOUT_MS as the deadline.
+      * A value that is still missing is reported as ERROR.
+      * @param targets Sensors and channels to report
+      * @param mode What to report for each value
       * @param values Vector to collect the values into
       */
-     void collectSensorReadings(const String& sensorName, const String& measurements, std::vector<String>& values);
+     void collectSensorReadings(const std::vector<MeasureTarget>& targets, MeasureMode mode, std::vector<String>& values);
+     
+     /**
+      * @brief Answer a measurement query with one CSV line
+      * @param params sensor[:measurements] parameters, or none for every sensor
+      * @param mode What to report for each value
+      * @return true if command processed successfully
+      */
+     bool handleMeasureQuery(const CommandParams& params, MeasureMode mode);
+     
+     /**
+      * @brief Send recorded history as one bulk response
+      * Emits one CSV line per channel followed by an END,<records>,<last sequence>
+      * trailer; the host passes the last sequence back to resume.
+      * @param params Starting point followed by optional sensor names
+      * @param byTimestamp true if the starting point is a timestamp, false for a sequence number
+      * @return true if command processed successfully
+      */
+     bool handleHistoryQuery(const CommandParams& params, bool byTimestamp);
  
  public:
      /**
@@ -103,47 +190,74 @@
     void begin(long baudRate);
 
     /**
-     * @brief Register all commands with both the handler map and SCPI parser
+     * @brief Read all available input and execute any complete command lines
+     * Returns immediately if no full line has arrived yet; partial lines
+     * are kept until the rest arrives.
      */
-    void registerCommands();
+    void processCommandLine();
 
     /**
-     * @brief Process a single incoming command line
+     * @brief Push pending binary stream frames if streaming is enabled
      */
-    void processCommandLine();
+    void serviceStream() { streamer.service(); }
+    
+    /**
+     * @brief Write configuration changes back to flash once they have settled
+     */
+    void serviceConfig() { configManager->flushIfDue(); }
 
      /**
-      * @brief Destructor - cleans up allocated resources
-      */
-     ~CommunicationManager();
- 
-     /**
-      * @brief Register all SCPI commands with the parser
-      */
-     void setupCommands();
+     * @brief Wake a task whenever serial input arrives
+     * Registers a receive callback on Serial that notifies the task, so it
+     * can block in ulTaskNotifyTake() instead of polling Serial.available().
+     * @param task Task to notify, or nullptr to stop notifying
+     */
+    void setInputTask(TaskHandle_t task);
+    
+    /**
+     * @brief Get how long the communication task may sleep if no input arrives
+     * @return Milliseconds until streaming or configuration write-back next
+     *         needs servicing, at most Constants::Communication::IDLE_WAKE_MS
+     */
+    uint32_t msUntilServiceDue() const;
 
      /**
       * @brief Set the LED manager
       * @param led Pointer to LED manager
       */
      void setLedManager(LedManager* led);
+     
+     /**
+      * @brief Set the task manager behind the SYST:TASK commands
+      * @param tasks Pointer to the task manager, or nullptr
+      */
+     void setTaskManager(TaskManager* tasks) { taskManager = tasks; }
 
     /**
-     * @brief Parse a raw command string into command and parameters
-     * @param rawCommand The full command string
-     * @param command Output parameter for the extracted command
-     * @param params Output parameter for the extracted parameters
+     * @brief Split a command line into the command and its parameters
+     * @param line The full command line
+     * @param command [out] View of the command mnemonic
+     * @param params [out] Views of the parameters
      */
-    void parseCommand(const String& rawCommand, String& command, std::vector<String>& params);
+    static void parseCommand(std::string_view line, std::string_view& command, CommandParams& params);
+
+    /**
+     * @brief Join measurement values into the single CSV line MEAS? returns
+     * @param values Formatted values in output order
+     * @return Comma-separated line, empty if there are no values
+     */
+    static String joinCsv(const std::vector<String>& values);
 
     
     /**
-     * @brief Process a command using the registered handler
-     * @param command The command to process
+     * @brief Look up a command in the command table and run its handler
+     * Handlers report their own failures, so the result only says whether
+     * the mnemonic named a known command.
+     * @param command The command mnemonic, short or long form in any case
      * @param params The command parameters
-     * @return true if command was found and processed successfully
+     * @return true if the command was recognized
      */
-    bool processCommand(const String& command, const std::vector<String>& params);
+    bool processCommand(std::string_view command, const CommandParams& params);
 
      /**
       * @name Command handlers
@@ -155,91 +269,304 @@
       * @param params Command parameters (not used)
       * @return true if command processed successfully
       */
-     bool handleIdentify(const std::vector<String>& params);
+     bool handleIdentify(const CommandParams& params);
      
      /**
       * @brief Handle measurement query command (MEAS?)
       * @param params Sensor and measurement parameters
       * @return true if command processed successfully
       */
-     bool handleMeasure(const std::vector<String>& params);
+     bool handleMeasure(const CommandParams& params) { return handleMeasureQuery(params, MeasureMode::CACHED); }
+     
+     /**
+      * @brief Handle fresh measurement query command (MEAS:FRES?)
+      * Same parameters and answer as MEAS?, but every value comes from a
+      * read started after the query.
+      * @param params Sensor and measurement parameters
+      * @return true if command processed successfully
+      */
+     bool handleMeasureFresh(const CommandParams& params) { return handleMeasureQuery(params, MeasureMode::FRESH); }
+     
+     /**
+      * @brief Handle measurement age query command (MEAS:AGE?)
+      * Same parameters as MEAS?; answers the age in milliseconds of each
+      * value MEAS? would report, in the same order.
+      * @param params Sensor and measurement parameters
+      * @return true if command processed successfully
+      */
+     bool handleMeasureAge(const CommandParams& params) { return handleMeasureQuery(params, MeasureMode::AGE); }
+     
+     /**
+      * @brief Handle measurement quality query command (MEAS:QUAL?)
+      * Same parameters as MEAS?; answers the QualityCode of each value
+      * MEAS? would report, 0 for a valid one, in the same order.
+      * @param params Sensor and measurement parameters
+      * @return true if command processed successfully
+      */
+     bool handleMeasureQuality(const CommandParams& params) { return handleMeasureQuery(params, MeasureMode::QUALITY); }
+     
+     /**
+      * @brief Handle history query by sequence number (MEAS:HIST?)
+      * @param params Last sequence received followed by optional sensor names
+      * @return true if command processed successfully
+      */
+     bool handleMeasureHistory(const CommandParams& params) { return handleHistoryQuery(params, false); }
+     
+     /**
+      * @brief Handle history query by timestamp (MEAS:HIST:TIME?)
+      * @param params Start time in milliseconds followed by optional sensor names
+      * @return true if command processed successfully
+      */
+     bool handleMeasureHistoryTime(const CommandParams& params) { return handleHistoryQuery(params, true); }
+     
+     /**
+      * @brief Handle stream control command (MEAS:STREAM)
+      * @param params ON with an optional period in milliseconds, or OFF
+      * @return true if command processed successfully
+      */
+     bool handleStreamControl(const CommandParams& params);
+     
+     /**
+      * @brief Handle stream state query (MEAS:STREAM?)
+      * @param params Command parameters (not used)
+      * @return true if command processed successfully
+      */
+     bool handleStreamStatus(const CommandParams& params);
+     
+     /**
+      * @brief Handle stream channel map query (MEAS:STREAM:MAP?)
+      * @param params Command parameters (not used)
+      * @return true if command processed successfully
+      */
+     bool handleStreamMap(const CommandParams& params);
      
      /**
       * @brief Handle sensor listing command (SYST:SENS:LIST?)
       * @param params Command parameters (not used)
       * @return true if command processed successfully
       */
-     bool handleListSensors(const std::vector<String>& params);
+     bool handleListSensors(const CommandParams& params);
+     
+     /**
+      * @brief Handle sensor health query (SYST:SENS:HEAL?)
+      * @param params Command parameters (unused)
+      * @return true if command was processed successfully
+      */
+     bool handleSensorHealth(const CommandParams& params);
      
      /**
       * @brief Handle configuration query command (SYST:CONF?)
       * @param params Command parameters (not used)
       * @return true if command processed successfully
       */
-     bool handleGetConfig(const std::vector<String>& params);
+     bool handleGetConfig(const CommandParams& params);
      
      /**
       * @brief Handle board ID setting command (SYST:CONF:BOARD:ID)
       * @param params Board ID parameter
       * @return true if command processed successfully
       */
-     bool handleSetBoardId(const std::vector<String>& params);
+     bool handleSetBoardId(const CommandParams& params);
      
      /**
       * @brief Handle configuration update command (SYST:CONF:UPDATE)
       * @param params Configuration JSON
       * @return true if command processed successfully
       */
-     bool handleUpdateConfig(const std::vector<String>& params);
+     bool handleUpdateConfig(const CommandParams& params);
      
      /**
       * @brief Handle sensor configuration update command (SYST:CONF:SENS:UPDATE)
       * @param params Sensor configuration JSON
       * @return true if command processed successfully
       */
-     bool handleUpdateSensorConfig(const std::vector<String>& params);
+     bool handleUpdateSensorConfig(const CommandParams& params);
      
      /**
       * @brief Handle additional configuration update command (SYST:CONF:ADD:UPDATE)
       * @param params Additional configuration JSON
       * @return true if command processed successfully
       */
-     bool handleUpdateAdditionalConfig(const std::vector<String>& params);
+     bool handleUpdateAdditionalConfig(const CommandParams& params);
      
      /**
       * @brief Handle reset command (RESET)
       * @param params Command parameters (not used)
       * @return true if command processed successfully
       */
-     bool handleReset(const std::vector<String>& params);
+     bool handleReset(const CommandParams& params);
      
      /**
       * @brief Handle echo command (ECHO)
       * @param params Text to echo
       * @return true if command processed successfully
       */
-     bool handleEcho(const std::vector<String>& params);
+     bool handleEcho(const CommandParams& params);
      
      /**
       * @brief Handle log routing command (SYST:LOG)
       * @param params Destination and severity parameters
       * @return true if command processed successfully
       */
-     bool handleLogRouting(const std::vector<String>& params);
+     bool handleLogRouting(const CommandParams& params);
      
      /**
       * @brief Handle log status query command (SYST:LOG?)
       * @param params Command parameters (not used)
       * @return true if command processed successfully
       */
-     bool handleLogStatus(const std::vector<String>& params);
+     bool handleLogStatus(const CommandParams& params);
+     
+     /**
+      * @brief Handle log history query (SYST:LOG:HIST?)
+      * Emits <sequence>,<timestamp>,<severity>,<message> lines followed by an
+      * END,<entries>,<last sequence> trailer; the host passes the last
+      * sequence back to continue draining.
+      * @param params Last sequence received, optionally followed by a maximum entry count
+      * @return true if command processed successfully
+      */
+     bool handleLogHistory(const CommandParams& params);
+     
+     /**
+      * @brief Handle I2C bus scan (SYST:I2C:SCAN?)
+      * Probes every address on all initialized buses in parallel and
+      * prints one line per bus: name, device count, then the addresses in
+      * hex. The result replaces the cached boot topology.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handleI2CScan(const CommandParams& params);
+     
+     /**
+      * @brief Handle I2C clock limit change (SYST:I2C:CLOC <bus>,<Hz>)
+      * Stores the limit in config.json. The bus runs at the lower of it
+      * and what its sensors support, and still falls back on errors.
+      * @param params Bus name and limit in Hz
+      * @return true if command processed successfully
+      */
+     bool handleI2CClock(const CommandParams& params);
+     
+     /**
+      * @brief Handle I2C clock query (SYST:I2C:CLOC?)
+      * Prints one line per bus: name, clock in use, effective limit,
+      * transactions, failed transactions and error-rate fallbacks.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handleI2CClockQuery(const CommandParams& params);
+     
+     /**
+      * @brief Handle performance counter query (SYST:PERF?)
+      * Prints one line per instrumented site with its sample count and
+      * min, p50, p99 and max latency in microseconds.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handlePerfQuery(const CommandParams& params);
+     
+     /**
+      * @brief Handle performance counter reset (SYST:PERF:RES)
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handlePerfReset(const CommandParams& params);
+     
+     /**
+      * @brief Handle memory query (SYST:MEM?)
+      * Prints one "heap" line per region (free, largest free block,
+      * minimum ever free, total, fragmentation percent), then the blocks
+      * in use, capacity, high water, bytes and heap fallbacks of the
+      * sensor pool and the bytes and location of the reading and log
+      * histories.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handleMemoryQuery(const CommandParams& params);
+     
+     /**
+      * @brief Handle clock set command (SYST:TIME)
+      * Maps the current device time to the given wall-clock time. Repeated
+      * sets a minute or more apart also estimate the crystal drift.
+      * @param params Unix epoch time in microseconds
+      * @return true if command processed successfully
+      */
+     bool handleTimeSet(const CommandParams& params);
+     
+     /**
+      * @brief Handle task query (SYST:TASK?)
+      * Prints one "task" line per FreeRTOS task (name, core, state,
+      * priority, CPU percent of one core, stack high water mark, then for
+      * supervised tasks OK or STALLED, ms since the last check-in, missed
+      * acquisition deadlines and stalls), then one "core" line per core
+      * with its busy percent. CPU figures cover the last supervisor period
+      * and are empty without run-time stats.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handleTaskQuery(const CommandParams& params);
+     
+     /**
+      * @brief Handle task placement query (SYST:TASK:CONF?)
+      * Prints role,core,priority,stack for each task role as the tasks
+      * currently run, including changes made with SYST:TASK:PRI and
+      * SYST:TASK:CORE.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handleTaskConfigQuery(const CommandParams& params);
+     
+     /**
+      * @brief Handle task priority change (SYST:TASK:PRI <role>,<priority>)
+      * Applies at once and lasts until restart; the priority in
+      * config.json is used at boot.
+      * @param params Role name and priority
+      * @return true if command processed successfully
+      */
+     bool handleTaskPriority(const CommandParams& params);
+     
+     /**
+      * @brief Handle task core change (SYST:TASK:CORE <role>,<core|ANY>)
+      * Each task of the role recreates itself on the new core at its next
+      * wake-up. Lasts until restart.
+      * @param params Role name and core
+      * @return true if command processed successfully
+      */
+     bool handleTaskCore(const CommandParams& params);
+     
+     /**
+      * @brief Handle self-benchmark (SYST:BENCH [ms per phase])
+      * Loads the running system in three phases of the given length and
+      * reports what it sustained: every connected sensor re-requested as
+      * soon as its last on-demand read is served ("read" lines with reads
+      * and reads/s per sensor, then "read_total"), back-to-back MEAS?
+      * queries answered into a counting sink ("meas,queries,per_s,avg_us,
+      * max_us"), and binary streaming at the shortest period while the
+      * reads are hammered again ("stream,bytes,bytes_per_s,frames_per_s",
+      * the frames going out on the port). Then the lowest free internal
+      * heap seen under load and the minimum ever ("heap") and the stack
+      * high water mark of every task ("stack"). Streaming is restored as
+      * it was; no other command runs until the report is out.
+      * @param params Optional phase length in milliseconds
+      * @return true if command processed successfully
+      */
+     bool handleBenchmark(const CommandParams& params);
+     
+     /**
+      * @brief Handle clock query (SYST:TIME?)
+      * Prints the current epoch and device time in microseconds, the
+      * source of the last sync, the drift estimate in ppb (empty until
+      * known) and the number of syncs. The epoch time is 0 until set.
+      * @param params Unused
+      * @return true if command processed successfully
+      */
+     bool handleTimeQuery(const CommandParams& params);
      
      /**
       * @brief Handle LED identification command (SYST:LED:IDENT)
       * @param params Command parameters (not used)
       * @return true if command processed successfully
       */
-     bool handleLedIdentify(const std::vector<String>& params);
+     bool handleLedIdentify(const CommandParams& params);
      
      /**
       * @brief Handle test error level commands
@@ -247,35 +574,35 @@
       * @param severity Error severity level
       * @return true if command processed successfully
       */
-     bool handleTestErrorLevel(const std::vector<String>& params, ErrorSeverity severity);
+     bool handleTestErrorLevel(const CommandParams& params, ErrorSeverity severity);
      
      /**
       * @brief Handle test info level command (TEST:INFO)
       * @param params Command parameters
       * @return true if command processed successfully
       */
-     bool handleTestInfoLevel(const std::vector<String>& params) { return handleTestErrorLevel(params, INFO); }
+     bool handleTestInfoLevel(const CommandParams& params) { return handleTestErrorLevel(params, INFO); }
      
      /**
       * @brief Handle test warning level command (TEST:WARNING)
       * @param params Command parameters
       * @return true if command processed successfully
       */
-     bool handleTestWarningLevel(const std::vector<String>& params) { return handleTestErrorLevel(params, WARNING); }
+     bool handleTestWarningLevel(const CommandParams& params) { return handleTestErrorLevel(params, WARNING); }
      
      /**
       * @brief Handle test error level command (TEST:ERROR)
       * @param params Command parameters
       * @return true if command processed successfully
       */
-     bool handleTestErrorLevel(const std::vector<String>& params) { return handleTestErrorLevel(params, ERROR); }
+     bool handleTestErrorLevel(const CommandParams& params) { return handleTestErrorLevel(params, ERROR); }
      
      /**
       * @brief Handle test fatal level command (TEST:FATAL)
       * @param params Command parameters
       * @return true if command processed successfully
       */
-     bool handleTestFatalLevel(const std::vector<String>& params) { return handleTestErrorLevel(params, FATAL); }
+     bool handleTestFatalLevel(const CommandParams& params) { return handleTestErrorLevel(params, FATAL); }
      /** @} */
      
      /**
@@ -307,12 +634,6 @@
       */
      ErrorHandler* getErrorHandler();
      
-     /**
-      * @brief Get the SCPI parser
-      * @return Pointer to the SCPI parser
-      */
-     SCPI_Parser* getScpiParser() { return scpiParser; }
-     
      /**
       * @brief Set the UART debug serial pointer for message routing
       * @param debugSerial Pointer to the debug serial
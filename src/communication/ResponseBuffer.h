@@ -0,0 +1,86 @@
+/**
+ * @file ResponseBuffer.h
+ * @brief Coalesces command responses into few large port writes
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup communication
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <string.h>
+ #include <algorithm>
+ #include "Constants.h"
+
+ /**
+  * @brief Print sink that collects the responses of a batch of commands
+  * Handlers print into the buffer instead of the port. The buffer is
+  * written out when it fills and once by send() after the last command of
+  * a batch, so several queries sent back-to-back are answered with one
+  * write rather than one write and flush each.
+  */
+ class ResponseBuffer : public Print {
+ public:
+     /**
+      * @brief Constructor
+      * @param out Port the responses are written to
+      */
+     explicit ResponseBuffer(Print* out) : output(out), used(0) {}
+
+     ResponseBuffer(const ResponseBuffer&) = delete;
+     ResponseBuffer& operator=(const ResponseBuffer&) = delete;
+
+     size_t write(uint8_t value) override {
+         return write(&value, 1);
+     }
+
+     size_t write(const uint8_t* data, size_t size) override {
+         size_t written = size;
+         while (size > 0) {
+             if (used == sizeof(buffer)) {
+                 send();
+             }
+             size_t chunk = std::min(size, sizeof(buffer) - used);
+             memcpy(buffer + used, data, chunk);
+             used += chunk;
+             data += chunk;
+             size -= chunk;
+         }
+         return written;
+     }
+
+     /**
+      * @brief Write everything buffered so far to the port
+      */
+     void send() {
+         if (used > 0 && output) {
+             output->write(buffer, used);
+         }
+         used = 0;
+     }
+
+     /**
+      * @brief Get the number of bytes waiting for send()
+      * @return Buffered bytes
+      */
+     size_t pending() const { return used; }
+
+     /**
+      * @brief Send later responses to another port
+      * Anything already buffered goes to the new port too; call send()
+      * first to keep it on the old one.
+      * @param out New destination
+      * @return Previous destination
+      */
+     Print* setOutput(Print* out) {
+         Print* previous = output;
+         output = out;
+         return previous;
+     }
+
+ private:
+     Print* output;                                                    ///< Destination port
+     uint8_t buffer[Constants::Communication::MAX_RESPONSE_SIZE];      ///< Responses not yet written
+     size_t used;                                                      ///< Bytes in buffer
+ };
@@ -0,0 +1,305 @@
+/**
+ * @file ScpiCommandTable.h
+ * @brief Compile-time SCPI mnemonic matching and perfect-hash command table
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup communication
+ */
+
+ #pragma once
+
+ #include <stdint.h>
+ #include <stddef.h>
+ #include <string_view>
+
+ /**
+  * @brief SCPI mnemonic helpers usable in constant expressions
+  * Command patterns are written in SCPI notation: each node spells its long
+  * form with the short form in upper case, e.g. "MEASure:HISTory?". An input
+  * node matches if it equals either form, ignoring case.
+  *
+  * The hash of a command is FNV-1a over the short form each node derives to
+  * under the standard SCPI rule (the first four characters, or three if the
+  * fourth is a vowel), so a long or short spelling of the same command hashes
+  * identically without knowing the pattern in advance.
+  */
+ namespace ScpiMnemonic {
+     static constexpr uint32_t FNV_OFFSET = 2166136261UL;   ///< FNV-1a offset basis
+     static constexpr uint32_t FNV_PRIME = 16777619UL;      ///< FNV-1a prime
+
+     constexpr char toUpper(char c) {
+         return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+     }
+
+     constexpr bool isLower(char c) {
+         return c >= 'a' && c <= 'z';
+     }
+
+     constexpr bool isVowel(char c) {
+         c = toUpper(c);
+         return c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U';
+     }
+
+     /**
+      * @brief Length of the short form the SCPI rule derives from a spelling
+      * @param node One mnemonic node without separators or query suffix
+      * @return Number of leading characters in the derived short form
+      */
+     constexpr size_t ruleShortLength(std::string_view node) {
+         if (node.size() <= 4) {
+             return node.size();
+         }
+         return isVowel(node[3]) ? 3 : 4;
+     }
+
+     /**
+      * @brief Length of the upper-case short form declared in a pattern node
+      * @param node One pattern node
+      * @return Number of leading non-lower-case characters
+      */
+     constexpr size_t declaredShortLength(std::string_view node) {
+         size_t i = 0;
+         while (i < node.size() && !isLower(node[i])) {
+             i++;
+         }
+         return i;
+     }
+
+     /**
+      * @brief Case-insensitive comparison of two views
+      */
+     constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+         if (a.size() != b.size()) {
+             return false;
+         }
+         for (size_t i = 0; i < a.size(); i++) {
+             if (toUpper(a[i]) != toUpper(b[i])) {
+                 return false;
+             }
+         }
+         return true;
+     }
+
+     /**
+      * @brief Remove the optional leading colon and the query suffix
+      * @param command [in,out] Command text, reduced to its header nodes
+      * @return true if the command is a query
+      */
+     constexpr bool splitQuery(std::string_view& command) {
+         if (!command.empty() && command.front() == ':') {
+             command.remove_prefix(1);
+         }
+         bool query = !command.empty() && command.back() == '?';
+         if (query) {
+             command.remove_suffix(1);
+         }
+         return query;
+     }
+
+     /**
+      * @brief Take the next node off the front of a command header
+      * @param header [in,out] Remaining header text
+      * @return The node, without its trailing separator
+      */
+     constexpr std::string_view nextNode(std::string_view& header) {
+         size_t colon = header.find(':');
+         std::string_view node = header.substr(0, colon);
+         header = colon == std::string_view::npos ? std::string_view() : header.substr(colon + 1);
+         return node;
+     }
+
+     /**
+      * @brief Hash a command so that all of its accepted spellings collide
+      * @param command Input line mnemonic or pattern
+      * @return 32-bit FNV-1a hash
+      */
+     constexpr uint32_t hash(std::string_view command) {
+         bool query = splitQuery(command);
+         uint32_t h = FNV_OFFSET;
+         bool first = true;
+         while (!command.empty()) {
+             if (!first) {
+                 h = (h ^ static_cast<uint8_t>(':')) * FNV_PRIME;
+             }
+             first = false;
+             std::string_view node = nextNode(command);
+             size_t length = ruleShortLength(node);
+             for (size_t i = 0; i < length; i++) {
+                 h = (h ^ static_cast<uint8_t>(toUpper(node[i]))) * FNV_PRIME;
+             }
+         }
+         if (query) {
+             h = (h ^ static_cast<uint8_t>('?')) * FNV_PRIME;
+         }
+         return h;
+     }
+
+     /**
+      * @brief Check an input mnemonic against a pattern exactly
+      * Every node must be the pattern's short or long form and the query
+      * suffix must agree; prefixes in between are rejected.
+      * @param input Mnemonic as received
+      * @param pattern Pattern in SCPI notation
+      * @return true if the input names the pattern's command
+      */
+     constexpr bool matches(std::string_view input, std::string_view pattern) {
+         if (splitQuery(input) != splitQuery(pattern)) {
+             return false;
+         }
+         while (!input.empty() && !pattern.empty()) {
+             std::string_view in = nextNode(input);
+             std::string_view node = nextNode(pattern);
+             if (!equalsIgnoreCase(in, node) &&
+                 !equalsIgnoreCase(in, node.substr(0, declaredShortLength(node)))) {
+                 return false;
+             }
+         }
+         return input.empty() && pattern.empty();
+     }
+
+     /**
+      * @brief Check that a pattern can be found through its hash
+      * Each node needs a non-empty short form that derives to the same hash
+      * characters as its long form, otherwise the short spelling would hash
+      * to a different bucket.
+      * @param pattern Pattern in SCPI notation
+      * @return true if the pattern is usable in a command table
+      */
+     constexpr bool isWellFormed(std::string_view pattern) {
+         splitQuery(pattern);
+         if (pattern.empty()) {
+             return false;
+         }
+         while (!pattern.empty()) {
+             std::string_view node = nextNode(pattern);
+             size_t declared = declaredShortLength(node);
+             if (declared == 0) {
+                 return false;
+             }
+             for (size_t i = declared; i < node.size(); i++) {
+                 if (!isLower(node[i])) {
+                     return false; // Upper case after the short form
+                 }
+             }
+             if (ruleShortLength(node.substr(0, declared)) != ruleShortLength(node)) {
+                 return false;
+             }
+         }
+         return true;
+     }
+ }
+
+ /**
+  * @brief One entry of a command table
+  * @tparam Handler Handler type, typically a member function pointer
+  */
+ template <typename Handler>
+ struct ScpiCommand {
+     const char* pattern;   ///< Mnemonic in SCPI notation
+     Handler handler;       ///< Handler invoked for the command
+ };
+
+ /**
+  * @brief Collision-free hash table of SCPI commands built at compile time
+  * The constructor searches for a multiplier that maps every command hash to
+  * its own bucket, so a lookup is one hash of the input, one bucket read and
+  * one exact comparison. Declared constexpr, the whole table lives in flash.
+  * @tparam Handler Handler type stored per command
+  * @tparam N Number of commands
+  */
+ template <typename Handler, size_t N>
+ class ScpiCommandTable {
+ public:
+     static_assert(N > 0 && N < 255, "Command table size out of range");
+
+     /**
+      * @brief Bucket index width: at least four buckets per command
+      */
+     static constexpr unsigned BUCKET_BITS = [] {
+         unsigned bits = 1;
+         while ((size_t(1) << bits) < N * 4) {
+             bits++;
+         }
+         return bits;
+     }();
+     static constexpr size_t BUCKET_COUNT = size_t(1) << BUCKET_BITS;   ///< Number of buckets
+     static constexpr uint8_t EMPTY = 0xFF;                             ///< Marker for unused buckets
+     static constexpr uint32_t MAX_SEED_ATTEMPTS = 4096;                ///< Multipliers tried before giving up
+
+     /**
+      * @brief Build the table
+      * @param source Commands to include
+      */
+     constexpr ScpiCommandTable(const ScpiCommand<Handler> (&source)[N])
+         : commands{}, hashes{}, buckets{}, seed(0), valid(false) {
+         bool wellFormed = true;
+         for (size_t i = 0; i < N; i++) {
+             commands[i] = source[i];
+             hashes[i] = ScpiMnemonic::hash(source[i].pattern);
+             wellFormed = wellFormed && ScpiMnemonic::isWellFormed(source[i].pattern);
+         }
+
+         for (uint32_t attempt = 0; wellFormed && attempt < MAX_SEED_ATTEMPTS && !valid; attempt++) {
+             uint32_t candidate = 2 * attempt + 1;
+             for (size_t b = 0; b < BUCKET_COUNT; b++) {
+                 buckets[b] = EMPTY;
+             }
+             bool collision = false;
+             for (size_t i = 0; i < N && !collision; i++) {
+                 size_t b = bucketOf(hashes[i], candidate);
+                 collision = buckets[b] != EMPTY;
+                 buckets[b] = static_cast<uint8_t>(i);
+             }
+             if (!collision) {
+                 seed = candidate;
+                 valid = true;
+             }
+         }
+     }
+
+     /**
+      * @brief Check that every pattern is well formed and got its own bucket
+      * Fails for duplicate commands, so use it in a static_assert.
+      * @return true if the table is usable
+      */
+     constexpr bool isValid() const { return valid; }
+
+     /**
+      * @brief Get the number of commands
+      * @return Command count
+      */
+     constexpr size_t size() const { return N; }
+
+     /**
+      * @brief Look up the command an input mnemonic names
+      * @param mnemonic Mnemonic as received, any case, short or long form
+      * @return The matching entry, or nullptr if the command is unknown
+      */
+     constexpr const ScpiCommand<Handler>* find(std::string_view mnemonic) const {
+         uint32_t h = ScpiMnemonic::hash(mnemonic);
+         uint8_t index = buckets[bucketOf(h, seed)];
+         if (index == EMPTY || hashes[index] != h ||
+             !ScpiMnemonic::matches(mnemonic, commands[index].pattern)) {
+             return nullptr;
+         }
+         return &commands[index];
+     }
+
+     /**
+      * @brief Get an entry by position
+      * @param index Position in the source order
+      * @return The entry
+      */
+     constexpr const ScpiCommand<Handler>& operator[](size_t index) const { return commands[index]; }
+
+ private:
+     ScpiCommand<Handler> commands[N];   ///< Commands in source order
+     uint32_t hashes[N];                 ///< Hash of each command
+     uint8_t buckets[BUCKET_COUNT];      ///< Command index per bucket, or EMPTY
+     uint32_t seed;                      ///< Multiplier giving a collision-free mapping
+     bool valid;                         ///< Table was built successfully
+
+     static constexpr size_t bucketOf(uint32_t h, uint32_t multiplier) {
+         return static_cast<uint32_t>(h * multiplier) >> (32 - BUCKET_BITS);
+     }
+ };
@@ -0,0 +1,408 @@
+#include "TelemetryPublisher.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <esp_sntp.h>
+
+namespace {
+    const char* MEASUREMENT = "environment";
+    const uint8_t MQTT_CONNECT = 0x10;
+    const uint8_t MQTT_CONNACK = 0x20;
+    const uint8_t MQTT_PUBLISH = 0x30;
+    const uint8_t MQTT_PINGREQ = 0xC0;
+    const size_t MQTT_MAX_TOPIC = 128;
+    const size_t MQTT_MAX_HEADER = 5 + 2 + MQTT_MAX_TOPIC;   // Fixed header, topic length, topic
+
+    TimeSync* sntpTarget = nullptr;   ///< Receives SNTP updates; the callback has no context argument
+
+    void onSntpSync(struct timeval* tv) {
+        if (sntpTarget && tv) {
+            sntpTarget->synchronize(static_cast<uint64_t>(tv->tv_sec) * 1000000ULL + tv->tv_usec, TimeSource::SNTP);
+        }
+    }
+
+    /**
+     * @brief Bounded appender for a line-protocol line
+     */
+    class LineWriter {
+    public:
+        LineWriter(char* out, size_t capacity) : out(out), capacity(capacity), used(0), valid(true) {}
+
+        void raw(std::string_view text) {
+            if (used + text.size() > capacity) {
+                valid = false;
+                return;
+            }
+            memcpy(out + used, text.data(), text.size());
+            used += text.size();
+        }
+
+        // Commas, spaces and equals signs are escaped in tag values
+        void tag(std::string_view text) {
+            for (char c : text) {
+                if (c == ',' || c == ' ' || c == '=') {
+                    raw("\\");
+                }
+                raw(std::string_view(&c, 1));
+            }
+        }
+
+        void format(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+            if (!valid) {
+                return;
+            }
+            va_list args;
+            va_start(args, fmt);
+            int written = vsnprintf(out + used, capacity - used, fmt, args);
+            va_end(args);
+            if (written < 0 || used + written >= capacity) {
+                valid = false;
+                return;
+            }
+            used += written;
+        }
+
+        size_t length() const { return valid ? used : 0; }
+
+    private:
+        char* out;
+        size_t capacity;
+        size_t used;
+        bool valid;
+    };
+
+    size_t encodeRemainingLength(uint8_t* out, size_t length) {
+        size_t count = 0;
+        do {
+            uint8_t digit = length % 128;
+            length /= 128;
+            out[count++] = length > 0 ? (digit | 0x80) : digit;
+        } while (length > 0 && count < 4);
+        return count;
+    }
+
+    size_t putString(uint8_t* out, std::string_view text) {
+        out[0] = text.size() >> 8;
+        out[1] = text.size() & 0xFF;
+        memcpy(out + 2, text.data(), text.size());
+        return 2 + text.size();
+    }
+}
+
+TelemetryPublisher::TelemetryPublisher(SensorManager* sensorMgr, ErrorHandler* err, const TelemetryConfig& cfg,
+                                       const String& id)
+    : sensorManager(sensorMgr),
+      errorHandler(err),
+      config(cfg),
+      boardId(id),
+      topic(cfg.topic.length() > 0 ? cfg.topic : id + "/telemetry"),
+      backoffMs(Constants::Telemetry::RECONNECT_BACKOFF_MIN_MS) {
+}
+
+bool TelemetryPublisher::begin() {
+    if (config.ssid.length() == 0 || config.host.length() == 0) {
+        errorHandler->logError(ERROR, "Telemetry needs an SSID and a Host");
+        return false;
+    }
+    if (topic.length() > MQTT_MAX_TOPIC) {
+        errorHandler->logFormatted(ERROR, "Telemetry topic longer than %u characters", static_cast<unsigned>(MQTT_MAX_TOPIC));
+        return false;
+    }
+
+    WiFi.mode(WIFI_STA);
+    WiFi.setHostname(boardId.c_str());
+    WiFi.setAutoReconnect(false);   // Retried here, with backoff
+    WiFi.begin(config.ssid.c_str(), config.password.length() > 0 ? config.password.c_str() : nullptr);
+    startTimeSync();
+
+    uint32_t now = millis();
+    nextAttempt = now + Constants::Telemetry::CONNECT_TIMEOUT_MS;
+    lastPublish = now;
+    lastSequence = sensorManager->getHistory().getLatestSequence();
+    LOG_INFO(errorHandler, "Telemetry: joining %s, publishing over %s to %s:%u every %lu ms", config.ssid.c_str(),
+             config.protocol == TelemetryProtocol::MQTT ? "MQTT" : "UDP", config.host.c_str(),
+             static_cast<unsigned>(config.port), static_cast<unsigned long>(config.intervalMs));
+    return true;
+}
+
+uint32_t TelemetryPublisher::service() {
+    uint32_t now = millis();
+    if (!ensureConnected(now)) {
+        int32_t untilAttempt = static_cast<int32_t>(nextAttempt - now);
+        return untilAttempt > 0 ? std::min(static_cast<uint32_t>(untilAttempt), config.intervalMs) : 1;
+    }
+
+    uint32_t elapsed = now - lastPublish;
+    if (elapsed < config.intervalMs) {
+        serviceBroker(now);
+        return config.intervalMs - elapsed;
+    }
+
+    lastPublish = now;
+    publishPending();
+    return config.intervalMs;
+}
+
+bool TelemetryPublisher::ensureConnected(uint32_t now) {
+    bool associated = WiFi.status() == WL_CONNECTED;
+    if (associated != wifiUp) {
+        wifiUp = associated;
+        if (associated) {
+            backoffMs = Constants::Telemetry::RECONNECT_BACKOFF_MIN_MS;
+            nextAttempt = now;
+            LOG_INFO(errorHandler, "Telemetry: Wi-Fi connected as %s", WiFi.localIP().toString().c_str());
+        } else {
+            transportReady = false;
+            client.stop();
+            errorHandler->logError(WARNING, "Telemetry: Wi-Fi lost, buffering readings in history");
+        }
+    }
+
+    if (transportReady) {
+        return true;
+    }
+    if (static_cast<int32_t>(now - nextAttempt) < 0) {
+        return false;
+    }
+
+    if (!associated) {
+        stats.reconnects++;
+        WiFi.disconnect();
+        WiFi.begin(config.ssid.c_str(), config.password.length() > 0 ? config.password.c_str() : nullptr);
+        scheduleReconnect(now);
+        return false;
+    }
+
+    if (config.protocol == TelemetryProtocol::MQTT && !connectBroker()) {
+        scheduleReconnect(millis());
+        return false;
+    }
+
+    transportReady = true;
+    backoffMs = Constants::Telemetry::RECONNECT_BACKOFF_MIN_MS;
+    return true;
+}
+
+bool TelemetryPublisher::connectBroker() {
+    client.stop();
+    if (!client.connect(config.host.c_str(), config.port, Constants::Telemetry::CONNECT_TIMEOUT_MS)) {
+        errorHandler->logFormatted(WARNING, "Telemetry: broker %s:%u unreachable, retrying in %lu ms",
+                                   config.host.c_str(), static_cast<unsigned>(config.port),
+                                   static_cast<unsigned long>(backoffMs));
+        return false;
+    }
+    client.setNoDelay(true);
+
+    uint8_t packet[MQTT_MAX_HEADER];
+    size_t length = encodeMqttConnect(packet, sizeof(packet), std::string_view(boardId.c_str(), boardId.length()),
+                                      Constants::Telemetry::MQTT_KEEPALIVE_S);
+    if (length == 0 || client.write(packet, length) != length) {
+        client.stop();
+        return false;
+    }
+
+    // CONNACK: type, remaining length 2, session present, return code
+    uint8_t connack[4];
+    size_t received = 0;
+    uint32_t start = millis();
+    while (received < sizeof(connack) && millis() - start < Constants::Telemetry::CONNECT_TIMEOUT_MS) {
+        int c = client.read();
+        if (c < 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        connack[received++] = static_cast<uint8_t>(c);
+    }
+    if (received < sizeof(connack) || connack[0] != MQTT_CONNACK || connack[3] != 0) {
+        errorHandler->logFormatted(WARNING, "Telemetry: broker refused the session (code %d)",
+                                   received == sizeof(connack) ? connack[3] : -1);
+        client.stop();
+        return false;
+    }
+
+    lastSend = millis();
+    LOG_INFO(errorHandler, "Telemetry: connected to broker %s:%u, topic %s", config.host.c_str(),
+             static_cast<unsigned>(config.port), topic.c_str());
+    return true;
+}
+
+void TelemetryPublisher::scheduleReconnect(uint32_t now) {
+    nextAttempt = now + backoffMs;
+    backoffMs = std::min(backoffMs * 2, Constants::Telemetry::RECONNECT_BACKOFF_MAX_MS);
+}
+
+void TelemetryPublisher::publishPending() {
+    const ReadingHistory& history = sensorManager->getHistory();
+
+    // Catching up after an outage is bounded; anything older is given up
+    uint32_t latest = history.getLatestSequence();
+    if (latest - lastSequence > Constants::Telemetry::MAX_BACKLOG_RECORDS) {
+        uint32_t skipTo = latest - Constants::Telemetry::MAX_BACKLOG_RECORDS;
+        stats.dropped += skipTo - lastSequence;
+        lastSequence = skipTo;
+    }
+
+    const SensorRegistry& registry = sensorManager->getRegistry();
+    const TimeSync& timeSync = sensorManager->getTimeSync();
+    std::string_view board(boardId.c_str(), boardId.length());
+    for (size_t batch = 0; batch < Constants::Telemetry::MAX_BATCHES_PER_PUBLISH; batch++) {
+        sensorManager->markTelemetryQuiescent();
+
+        size_t used = 0;
+        size_t records = 0;
+        bool full = false;
+        uint32_t batchEnd = lastSequence;
+        uint32_t expected = lastSequence + 1;
+        size_t visited = history.fetch(lastSequence, 0, 0xFFFFFFFFUL, Constants::Telemetry::MAX_BATCH_RECORDS,
+            [&](const HistoryRecord& record) {
+                if (full) {
+                    return;
+                }
+                ISensor* sensor = registry.getSensorBySlot(record.slot);
+                size_t length = sensor ? formatRecord(payload + used, sizeof(payload) - used, board,
+                                                      sensor->getNameView(), record,
+                                                      timeSync.toEpochUs(record.timeUs)) : 0;
+                if (sensor && length == 0) {
+                    full = true;
+                    return;
+                }
+                // Sequences are global, so a jump means the ring overwrote unsent readings
+                if (record.sequence > expected) {
+                    stats.dropped += record.sequence - expected;
+                }
+                expected = record.sequence + 1;
+                batchEnd = record.sequence;
+                used += length;
+                records += sensor ? 1 : 0;
+            });
+        sensorManager->markTelemetryOffline();
+
+        if (used > 0 && !sendBatch(used)) {
+            transportReady = false;
+            client.stop();
+            errorHandler->logError(WARNING, "Telemetry: send failed, will retry from sequence " + String(lastSequence + 1));
+            scheduleReconnect(millis());
+            return;
+        }
+        if (used > 0) {
+            stats.batches++;
+            stats.records += records;
+        }
+        lastSequence = batchEnd;
+
+        if (!full && visited < Constants::Telemetry::MAX_BATCH_RECORDS) {
+            return;
+        }
+    }
+}
+
+bool TelemetryPublisher::sendBatch(size_t length) {
+    if (config.protocol == TelemetryProtocol::UDP) {
+        return udp.beginPacket(config.host.c_str(), config.port) &&
+               udp.write(reinterpret_cast<const uint8_t*>(payload), length) == length &&
+               udp.endPacket();
+    }
+
+    uint8_t header[MQTT_MAX_HEADER];
+    size_t headerLength = encodeMqttPublishHeader(header, sizeof(header),
+                                                  std::string_view(topic.c_str(), topic.length()), length);
+    if (headerLength == 0 || !client.connected() ||
+        client.write(header, headerLength) != headerLength ||
+        client.write(reinterpret_cast<const uint8_t*>(payload), length) != length) {
+        return false;
+    }
+    lastSend = millis();
+    return true;
+}
+
+void TelemetryPublisher::serviceBroker(uint32_t now) {
+    if (config.protocol != TelemetryProtocol::MQTT) {
+        return;
+    }
+
+    // PINGRESP and anything else the broker sends are not needed for QoS 0
+    while (client.available() > 0) {
+        client.read();
+    }
+
+    if (!client.connected()) {
+        transportReady = false;
+        errorHandler->logError(WARNING, "Telemetry: broker closed the connection");
+        scheduleReconnect(now);
+        return;
+    }
+
+    if (now - lastSend >= Constants::Telemetry::MQTT_KEEPALIVE_S * 1000UL / 2) {
+        const uint8_t ping[2] = {MQTT_PINGREQ, 0x00};
+        client.write(ping, sizeof(ping));
+        lastSend = now;
+    }
+}
+
+size_t TelemetryPublisher::formatRecord(char* out, size_t capacity, std::string_view board, std::string_view sensor,
+                                        const HistoryRecord& record, uint64_t epochUs) {
+    LineWriter line(out, capacity);
+    line.raw(MEASUREMENT);
+    line.raw(",board=");
+    line.tag(board);
+    line.raw(",sensor=");
+    line.tag(sensor);
+
+    char separator = ' ';
+    record.forEachValue([&](InterfaceType type, float value, bool valid) {
+        if (!valid) {
+            return;
+        }
+        const ChannelDescriptor& channel = channelDescriptor(type);
+        line.format("%c%s=%.2f", separator, channel.keyword, value * channel.scale);
+        separator = ',';
+    });
+    line.format("%cseq=%lui,uptime_ms=%lui", separator, static_cast<unsigned long>(record.sequence),
+                static_cast<unsigned long>(record.timestampMs()));
+    if (epochUs != 0) {
+        line.format(" %llu000", static_cast<unsigned long long>(epochUs));
+    }
+    line.raw("\n");
+    return line.length();
+}
+
+void TelemetryPublisher::startTimeSync() {
+    // SNTP polls in the background and retries until Wi-Fi is up; every
+    // update re-anchors the mapping and refines the drift estimate
+    sntpTarget = &sensorManager->getTimeSync();
+    sntp_set_time_sync_notification_cb(onSntpSync);
+    configTime(0, 0, Constants::Time::DEFAULT_NTP_SERVER);
+}
+
+size_t TelemetryPublisher::encodeMqttConnect(uint8_t* out, size_t capacity, std::string_view clientId,
+                                             uint16_t keepAliveS) {
+    size_t remaining = 10 + 2 + clientId.size();
+    if (clientId.size() > 0xFFFF || 5 + remaining > capacity) {
+        return 0;
+    }
+
+    size_t length = 0;
+    out[length++] = MQTT_CONNECT;
+    length += encodeRemainingLength(out + length, remaining);
+    length += putString(out + length, "MQTT");
+    out[length++] = 4;      // Protocol level 3.1.1
+    out[length++] = 0x02;   // Clean session
+    out[length++] = keepAliveS >> 8;
+    out[length++] = keepAliveS & 0xFF;
+    length += putString(out + length, clientId);
+    return length;
+}
+
+size_t TelemetryPublisher::encodeMqttPublishHeader(uint8_t* out, size_t capacity, std::string_view topic,
+                                                   size_t payloadLength) {
+    size_t remaining = 2 + topic.size() + payloadLength;
+    if (remaining > 268435455UL || 5 + 2 + topic.size() > capacity) {
+        return 0;
+    }
+
+    size_t length = 0;
+    out[length++] = MQTT_PUBLISH;   // QoS 0, no retain
+    length += encodeRemainingLength(out + length, remaining);
+    length += putString(out + length, topic);
+    return length;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file TelemetryPublisher.h
+ * @brief Batched measurement publishing over Wi-Fi
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup communication
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <WiFi.h>
+ #include <WiFiClient.h>
+ #include <WiFiUdp.h>
+ #include <string_view>
+ #include "Constants.h"
+ #include "../config/ConfigManager.h"
+ #include "../managers/SensorManager.h"
+
+ /**
+  * @brief Publishes readings to a network collector in batches
+  * Runs in its own task on the communication core. Every interval the
+  * readings recorded since the last successful publish are taken from the
+  * reading history and written as InfluxDB line protocol, one line per
+  * reading, into a fixed buffer:
+  *
+  *     environment,board=Prototype01,sensor=I2C01 TEMP=23.51,HUM=45.20,seq=1042i,uptime_ms=81234i 1747300000123456000
+  *
+  * The trailing timestamp is the reading time in epoch nanoseconds and is
+  * left out, so the collector stamps the line on arrival, until the clock
+  * has been set. Once Wi-Fi is up the clock is kept set from SNTP.
+  *
+  * Each full buffer goes out as one UDP datagram or one MQTT QoS 0
+  * PUBLISH. The history cursor only advances once a batch has been sent,
+  * so readings taken while the network is down are published after it
+  * comes back, up to Constants::Telemetry::MAX_BACKLOG_RECORDS of them;
+  * the reading history is the offline queue and costs nothing extra.
+  *
+  * Wi-Fi and the broker connection are retried with a backoff that
+  * doubles from RECONNECT_BACKOFF_MIN_MS to RECONNECT_BACKOFF_MAX_MS.
+  * The MQTT client is the minimal subset of MQTT 3.1.1 needed for QoS 0
+  * publishing (CONNECT, PUBLISH, PINGREQ).
+  */
+ class TelemetryPublisher {
+ public:
+     /**
+      * @brief Publishing counters
+      */
+     struct Stats {
+         uint32_t batches = 0;      ///< Payloads sent
+         uint32_t records = 0;      ///< Readings sent
+         uint32_t dropped = 0;      ///< Readings lost to the backlog limit or overwritten in the history
+         uint32_t reconnects = 0;   ///< Wi-Fi or broker connection attempts after the first
+     };
+
+     /**
+      * @brief Constructor
+      * @param sensorMgr Sensor manager providing the reading history
+      * @param err Error handler for logging
+      * @param config Network settings
+      * @param boardId Board identifier, used as tag and MQTT client id
+      */
+     TelemetryPublisher(SensorManager* sensorMgr, ErrorHandler* err, const TelemetryConfig& config,
+                        const String& boardId);
+
+     /**
+      * @brief Start Wi-Fi in station mode
+      * Publishing starts with the readings recorded from now on.
+      * @return false if the settings are incomplete
+      */
+     bool begin();
+
+     /**
+      * @brief Keep the connections up and publish when the interval has elapsed
+      * Called from the telemetry task in a loop.
+      * @return Milliseconds until the next call has work to do
+      */
+     uint32_t service();
+
+     /**
+      * @brief Check whether the collector can be reached
+      * @return true if Wi-Fi is up and, for MQTT, the broker connection is open
+      */
+     bool isConnected() const { return transportReady; }
+
+     /**
+      * @brief Get the publishing counters
+      * @return Counters since boot
+      */
+     const Stats& getStats() const { return stats; }
+
+     /**
+      * @brief Format one history record as a line-protocol line
+      * Invalid channels are left out; tag values are escaped.
+      * @param out Destination
+      * @param capacity Bytes available at out
+      * @param board Board identifier tag
+      * @param sensor Sensor name tag
+      * @param record Reading to format
+      * @param epochUs Wall-clock time of the reading in microseconds, 0 to leave it out
+      * @return Bytes written including the newline, or 0 if it does not fit
+      */
+     static size_t formatRecord(char* out, size_t capacity, std::string_view board, std::string_view sensor,
+                                const HistoryRecord& record, uint64_t epochUs = 0);
+
+     /**
+      * @brief Encode an MQTT 3.1.1 CONNECT packet with a clean session and no credentials
+      * @param out Destination
+      * @param capacity Bytes available at out
+      * @param clientId Client identifier
+      * @param keepAliveS Keep-alive interval in seconds
+      * @return Packet length, or 0 if it does not fit
+      */
+     static size_t encodeMqttConnect(uint8_t* out, size_t capacity, std::string_view clientId, uint16_t keepAliveS);
+
+     /**
+      * @brief Encode the fixed and variable header of an MQTT QoS 0 PUBLISH
+      * The payload follows the header on the wire.
+      * @param out Destination
+      * @param capacity Bytes available at out
+      * @param topic Topic name
+      * @param payloadLength Bytes of payload that will follow
+      * @return Header length, or 0 if it does not fit
+      */
+     static size_t encodeMqttPublishHeader(uint8_t* out, size_t capacity, std::string_view topic,
+                                           size_t payloadLength);
+
+ private:
+     SensorManager* sensorManager;   ///< Source of readings
+     ErrorHandler* errorHandler;     ///< Error handler for logging
+     TelemetryConfig config;         ///< Network settings
+     String boardId;                 ///< Board identifier tag and client id
+     String topic;                   ///< MQTT topic in use
+
+     WiFiUDP udp;                    ///< UDP transport
+     WiFiClient client;              ///< MQTT broker connection
+
+     bool wifiUp = false;            ///< Wi-Fi was associated at the last check
+     bool transportReady = false;    ///< A batch can be sent right now
+     uint32_t backoffMs;             ///< Wait after the next failed connection attempt
+     uint32_t nextAttempt = 0;       ///< millis() at which the next connection attempt is due
+     uint32_t lastPublish = 0;       ///< millis() of the last publish pass
+     uint32_t lastSend = 0;          ///< millis() of the last packet to the broker
+     uint32_t lastSequence = 0;      ///< Last history sequence published
+     Stats stats;                    ///< Publishing counters
+
+     char payload[Constants::Telemetry::PAYLOAD_BUFFER_SIZE];   ///< Pre-allocated batch buffer
+
+     /**
+      * @brief Bring Wi-Fi and the transport up, with backoff
+      * @param now Current millis()
+      * @return true if a batch can be sent
+      */
+     bool ensureConnected(uint32_t now);
+
+     /**
+      * @brief Open the broker connection and wait for its CONNACK
+      * @return true if the broker accepted the session
+      */
+     bool connectBroker();
+
+     /**
+      * @brief Note a failed attempt and schedule the next one
+      * @param now Current millis()
+      */
+     void scheduleReconnect(uint32_t now);
+
+     /**
+      * @brief Send the readings recorded since the last publish
+      * Stops at the first batch that cannot be sent; it is retried later.
+      */
+     void publishPending();
+
+     /**
+      * @brief Send one batch
+      * @param length Bytes of payload
+      * @return true if the transport accepted it
+      */
+     bool sendBatch(size_t length);
+
+     /**
+      * @brief Keep an idle broker connection alive and drain its replies
+      * @param now Current millis()
+      */
+     void serviceBroker(uint32_t now);
+
+     /**
+      * @brief Start SNTP and forward its time to the sensor manager's TimeSync
+      */
+     void startTimeSync();
+ };
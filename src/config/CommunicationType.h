@@ -0,0 +1,44 @@
+/**
+ * @file CommunicationType.h
+ * @brief Sensor communication protocols
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup configuration
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+
+ /**
+  * @brief Sensor communication protocols
+  * Defines the supported communication protocols for sensors
+  */
+ enum class CommunicationType { 
+     I2C,  ///< I2C protocol
+     SPI   ///< SPI protocol
+     // Future protocols can be added here
+ };
+
+ /**
+  * @brief Convert communication type to string
+  * @param type The communication type
+  * @return String representation of the communication type
+  */
+ inline String communicationTypeToString(CommunicationType type) {
+     switch (type) {
+         case CommunicationType::I2C: return "I2C";
+         case CommunicationType::SPI: return "SPI";
+         default: return "UNKNOWN";
+     }
+ }
+
+ /**
+  * @brief Convert string to communication type
+  * @param str The string representation
+  * @return The corresponding communication type
+  */
+ inline CommunicationType stringToCommunicationType(const String& str) {
+     if (str.equalsIgnoreCase("SPI")) return CommunicationType::SPI;
+     return CommunicationType::I2C; // Default to I2C
+ }
@@ -0,0 +1,312 @@
+#include "ConfigCache.h"
+#include "ConfigManager.h"
+#include <string.h>
+
+namespace {
+    const char* NVS_NAMESPACE = "emcache";
+    const char* CONFIG_KEY = "config";
+
+    /**
+     * @brief Appends little-endian fields to a record payload
+     */
+    class RecordWriter {
+    public:
+        explicit RecordWriter(std::vector<uint8_t>& out) : buffer(out) {}
+
+        void u8(uint8_t value) { buffer.push_back(value); }
+        void u16(uint16_t value) { u8(value & 0xFF); u8(value >> 8); }
+        void u32(uint32_t value) { u16(value & 0xFFFF); u16(value >> 16); }
+        void str(const String& value) {
+            u16(value.length());
+            buffer.insert(buffer.end(), value.c_str(), value.c_str() + value.length());
+        }
+
+    private:
+        std::vector<uint8_t>& buffer;
+    };
+
+    /**
+     * @brief Reads fields written by RecordWriter, failing on truncation
+     */
+    class RecordReader {
+    public:
+        RecordReader(const std::vector<uint8_t>& in) : buffer(in), offset(0), valid(true) {}
+
+        uint8_t u8() {
+            if (offset >= buffer.size()) {
+                valid = false;
+                return 0;
+            }
+            return buffer[offset++];
+        }
+        uint16_t u16() { uint16_t low = u8(); return low | (static_cast<uint16_t>(u8()) << 8); }
+        uint32_t u32() { uint32_t low = u16(); return low | (static_cast<uint32_t>(u16()) << 16); }
+        String str() {
+            size_t length = u16();
+            if (!valid || offset + length > buffer.size()) {
+                valid = false;
+                return String();
+            }
+            String value;
+            value.reserve(length);
+            for (size_t i = 0; i < length; i++) {
+                value += static_cast<char>(buffer[offset + i]);
+            }
+            offset += length;
+            return value;
+        }
+
+        bool failed() const { return !valid; }
+        bool ok() const { return valid && offset == buffer.size(); }
+
+    private:
+        const std::vector<uint8_t>& buffer;
+        size_t offset;
+        bool valid;
+    };
+}
+
+ConfigCache::ConfigCache(ErrorHandler* err) : errorHandler(err), ready(false) {
+}
+
+ConfigCache::~ConfigCache() {
+    if (ready) {
+        preferences.end();
+    }
+}
+
+bool ConfigCache::begin() {
+    if (!ready) {
+        ready = preferences.begin(NVS_NAMESPACE, false);
+        if (!ready) {
+            errorHandler->logError(WARNING, "Config cache unavailable, booting from config file");
+        }
+    }
+    return ready;
+}
+
+uint32_t ConfigCache::crc32(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+bool ConfigCache::writeRecord(const char* key, uint32_t sourceCrc, const std::vector<uint8_t>& payload) {
+    if (!ready || payload.size() > MAX_RECORD_BYTES) {
+        return false;
+    }
+
+    RecordHeader header;
+    header.magic = RECORD_MAGIC;
+    header.version = RECORD_VERSION;
+    header.length = payload.size();
+    header.sourceCrc = sourceCrc;
+    header.payloadCrc = crc32(payload.data(), payload.size());
+
+    std::vector<uint8_t> record(sizeof(header) + payload.size());
+    memcpy(record.data(), &header, sizeof(header));
+    if (!payload.empty()) {
+        memcpy(record.data() + sizeof(header), payload.data(), payload.size());
+    }
+
+    if (preferences.putBytes(key, record.data(), record.size()) != record.size()) {
+        errorHandler->logError(WARNING, "Failed to write config cache record: " + String(key));
+        return false;
+    }
+    return true;
+}
+
+bool ConfigCache::readRecord(const char* key, uint32_t sourceCrc, std::vector<uint8_t>& payload) {
+    if (!ready || !preferences.isKey(key)) {
+        return false;
+    }
+
+    size_t size = preferences.getBytesLength(key);
+    if (size < sizeof(RecordHeader) || size > sizeof(RecordHeader) + MAX_RECORD_BYTES) {
+        return false;
+    }
+
+    std::vector<uint8_t> record(size);
+    if (preferences.getBytes(key, record.data(), size) != size) {
+        return false;
+    }
+
+    RecordHeader header;
+    memcpy(&header, record.data(), sizeof(header));
+    if (header.magic != RECORD_MAGIC || header.version != RECORD_VERSION ||
+        header.length != size - sizeof(header) || header.sourceCrc != sourceCrc) {
+        return false;
+    }
+
+    payload.assign(record.begin() + sizeof(header), record.end());
+    if (crc32(payload.data(), payload.size()) != header.payloadCrc) {
+        errorHandler->logError(WARNING, "Config cache record corrupt: " + String(key));
+        return false;
+    }
+    return true;
+}
+
+bool ConfigCache::loadConfig(uint32_t sourceCrc, String& boardId, String& additional,
+                             std::vector<SensorConfig>& configs, std::vector<uint32_t>& i2cClockLimits,
+                             TelemetryConfig& telemetry, TaskPlacementConfig& tasks) {
+    std::vector<uint8_t> payload;
+    if (!readRecord(CONFIG_KEY, sourceCrc, payload)) {
+        return false;
+    }
+
+    RecordReader reader(payload);
+    String cachedId = reader.str();
+    String cachedAdditional = reader.str();
+    size_t count = reader.u8();
+
+    std::vector<SensorConfig> cachedConfigs;
+    cachedConfigs.reserve(count);
+    for (size_t i = 0; i < count && !reader.failed(); i++) {
+        SensorConfig config;
+        config.name = reader.str();
+        config.type = reader.str();
+        config.communicationType = static_cast<CommunicationType>(reader.u8());
+        config.portNum = reader.u16();
+        config.address = static_cast<int16_t>(reader.u16());
+        config.pollingRate = reader.u32();
+        config.additional = reader.str();
+        cachedConfigs.push_back(config);
+    }
+    
+    std::vector<uint32_t> cachedLimits(reader.u8());
+    for (auto& limit : cachedLimits) {
+        limit = reader.u32();
+    }
+
+    TelemetryConfig cachedTelemetry;
+    cachedTelemetry.enabled = reader.u8() != 0;
+    cachedTelemetry.ssid = reader.str();
+    cachedTelemetry.password = reader.str();
+    cachedTelemetry.protocol = static_cast<TelemetryProtocol>(reader.u8());
+    cachedTelemetry.host = reader.str();
+    cachedTelemetry.port = reader.u16();
+    cachedTelemetry.topic = reader.str();
+    cachedTelemetry.intervalMs = reader.u32();
+
+    // Any-core is stored as 0xFF
+    TaskPlacementConfig cachedTasks;
+    size_t roles = reader.u8();
+    for (size_t i = 0; i < roles && !reader.failed(); i++) {
+        uint8_t core = reader.u8();
+        TaskPlacement placement;
+        placement.core = core == 0xFF ? tskNO_AFFINITY : core;
+        placement.priority = reader.u8();
+        placement.stackSize = reader.u32();
+        if (i < static_cast<size_t>(TaskRole::COUNT)) {
+            cachedTasks.tasks[i] = placement;
+        }
+    }
+
+    if (!reader.ok() || cachedConfigs.size() != count || roles != static_cast<size_t>(TaskRole::COUNT)) {
+        errorHandler->logError(WARNING, "Config cache record malformed, ignoring it");
+        return false;
+    }
+
+    boardId = cachedId;
+    additional = cachedAdditional;
+    configs.swap(cachedConfigs);
+    i2cClockLimits.swap(cachedLimits);
+    telemetry = cachedTelemetry;
+    tasks = cachedTasks;
+    return true;
+}
+
+bool ConfigCache::storeConfig(uint32_t sourceCrc, const String& boardId, const String& additional,
+                              const std::vector<SensorConfig>& configs, const std::vector<uint32_t>& i2cClockLimits,
+                              const TelemetryConfig& telemetry, const TaskPlacementConfig& tasks) {
+    if (configs.size() > 0xFF || i2cClockLimits.size() > 0xFF) {
+        return false;
+    }
+
+    std::vector<uint8_t> payload;
+    payload.reserve(256);
+    RecordWriter writer(payload);
+    writer.str(boardId);
+    writer.str(additional);
+    writer.u8(configs.size());
+    for (const auto& config : configs) {
+        writer.str(config.name);
+        writer.str(config.type);
+        writer.u8(static_cast<uint8_t>(config.communicationType));
+        writer.u16(config.portNum);
+        writer.u16(static_cast<uint16_t>(config.address));
+        writer.u32(config.pollingRate);
+        writer.str(config.additional);
+    }
+    writer.u8(i2cClockLimits.size());
+    for (uint32_t limit : i2cClockLimits) {
+        writer.u32(limit);
+    }
+    writer.u8(telemetry.enabled ? 1 : 0);
+    writer.str(telemetry.ssid);
+    writer.str(telemetry.password);
+    writer.u8(static_cast<uint8_t>(telemetry.protocol));
+    writer.str(telemetry.host);
+    writer.u16(telemetry.port);
+    writer.str(telemetry.topic);
+    writer.u32(telemetry.intervalMs);
+    writer.u8(static_cast<uint8_t>(TaskRole::COUNT));
+    for (const TaskPlacement& placement : tasks.tasks) {
+        writer.u8(placement.core == tskNO_AFFINITY ? 0xFF : static_cast<uint8_t>(placement.core));
+        writer.u8(static_cast<uint8_t>(placement.priority));
+        writer.u32(placement.stackSize);
+    }
+
+    return writeRecord(CONFIG_KEY, sourceCrc, payload);
+}
+
+const char* ConfigCache::topologyKey(I2CPort port) {
+    return port == I2CPort::I2C1 ? "topo1" : "topo0";
+}
+
+bool ConfigCache::loadTopology(I2CPort port, std::vector<int>& addresses) {
+    std::vector<uint8_t> payload;
+    if (!readRecord(topologyKey(port), 0, payload) || payload.size() != sizeof(TopologyRecord)) {
+        return false;
+    }
+
+    TopologyRecord topology;
+    memcpy(&topology, payload.data(), sizeof(topology));
+
+    addresses.clear();
+    for (int address = 0; address < 128; address++) {
+        if (topology.present[address / 32] & (1UL << (address % 32))) {
+            addresses.push_back(address);
+        }
+    }
+    return true;
+}
+
+bool ConfigCache::storeTopology(I2CPort port, const std::vector<int>& addresses) {
+    TopologyRecord topology = {};
+    for (int address : addresses) {
+        if (address >= 0 && address < 128) {
+            topology.present[address / 32] |= 1UL << (address % 32);
+        }
+    }
+
+    std::vector<uint8_t> payload(sizeof(topology));
+    memcpy(payload.data(), &topology, sizeof(topology));
+
+    std::vector<uint8_t> stored;
+    if (readRecord(topologyKey(port), 0, stored) && stored == payload) {
+        return true;
+    }
+    return writeRecord(topologyKey(port), 0, payload);
+}
+
+void ConfigCache::invalidate() {
+    if (ready) {
+        preferences.clear();
+    }
+}
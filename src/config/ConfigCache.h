@@ -0,0 +1,167 @@
+/**
+ * @file ConfigCache.h
+ * @brief Binary snapshot of the parsed configuration and bus topology in NVS
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup configuration
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <vector>
+ #include <Preferences.h>
+ #include "../error/ErrorHandler.h"
+ #include "../managers/I2CManager.h"
+
+ struct SensorConfig;
+ struct TelemetryConfig;
+ struct TaskPlacementConfig;
+
+ /**
+  * @brief Boot-time cache of everything that is slow to rediscover
+  * Holds the sensor configurations parsed from config.json, keyed by the
+  * CRC of the file they came from, and the I2C addresses that answered on
+  * each bus at the last full scan. Every record carries a magic, format
+  * version and CRC; anything that does not validate is ignored, so the
+  * caller always has the slow path to fall back on.
+  */
+ class ConfigCache {
+ public:
+     /**
+      * @brief Largest configuration record stored, in bytes
+      */
+     static const size_t MAX_RECORD_BYTES = 4096;
+
+     /**
+      * @brief Constructor
+      * @param err Pointer to error handler
+      */
+     ConfigCache(ErrorHandler* err);
+
+     /**
+      * @brief Destructor - closes the NVS namespace
+      */
+     ~ConfigCache();
+
+     ConfigCache(const ConfigCache&) = delete;
+     ConfigCache& operator=(const ConfigCache&) = delete;
+
+     /**
+      * @brief Open the NVS namespace
+      * @return true if the cache can be used
+      */
+     bool begin();
+
+     /**
+      * @brief Load the configuration cached for a given source file
+      * @param sourceCrc crc32() of the config.json contents
+      * @param boardId [out] Board identifier
+      * @param additional [out] Additional configuration string
+      * @param configs [out] Sensor configurations
+      * @param i2cClockLimits [out] Clock limit per I2C bus, in Hz
+      * @param telemetry [out] Network telemetry settings
+      * @param tasks [out] Task placement
+      * @return true if a valid record for exactly this file was found
+      */
+     bool loadConfig(uint32_t sourceCrc, String& boardId, String& additional,
+                     std::vector<SensorConfig>& configs, std::vector<uint32_t>& i2cClockLimits,
+                     TelemetryConfig& telemetry, TaskPlacementConfig& tasks);
+
+     /**
+      * @brief Store the configuration parsed from a source file
+      * @param sourceCrc crc32() of the config.json contents
+      * @param boardId Board identifier
+      * @param additional Additional configuration string
+      * @param configs Sensor configurations
+      * @param i2cClockLimits Clock limit per I2C bus, in Hz
+      * @param telemetry Network telemetry settings
+      * @param tasks Task placement
+      * @return true if the record was written
+      */
+     bool storeConfig(uint32_t sourceCrc, const String& boardId, const String& additional,
+                      const std::vector<SensorConfig>& configs, const std::vector<uint32_t>& i2cClockLimits,
+                      const TelemetryConfig& telemetry, const TaskPlacementConfig& tasks);
+
+     /**
+      * @brief Load the addresses found on a bus at the last full scan
+      * @param port I2C port
+      * @param addresses [out] Responding 7-bit addresses, ascending
+      * @return true if a valid record was found
+      */
+     bool loadTopology(I2CPort port, std::vector<int>& addresses);
+
+     /**
+      * @brief Store the addresses found by a full scan
+      * Skips the write when the record is unchanged, to save NVS wear.
+      * @param port I2C port
+      * @param addresses Responding 7-bit addresses
+      * @return true if the stored record matches
+      */
+     bool storeTopology(I2CPort port, const std::vector<int>& addresses);
+
+     /**
+      * @brief Drop every cached record
+      */
+     void invalidate();
+
+     /**
+      * @brief Compute a CRC-32 (IEEE 802.3, reflected)
+      * @param data Bytes to checksum
+      * @param length Number of bytes
+      * @param crc Running value from a previous call, or 0
+      * @return Updated CRC
+      */
+     static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+ private:
+     /**
+      * @brief Header in front of every record
+      */
+     struct RecordHeader {
+         uint32_t magic;        ///< RECORD_MAGIC
+         uint16_t version;      ///< RECORD_VERSION
+         uint16_t length;       ///< Payload bytes after the header
+         uint32_t sourceCrc;    ///< CRC of the data the record was derived from
+         uint32_t payloadCrc;   ///< CRC of the payload
+     };
+
+     /**
+      * @brief Bitmap of responding addresses on one bus
+      */
+     struct TopologyRecord {
+         uint32_t present[4];   ///< Bit n set if address n answered
+     };
+
+     static const uint32_t RECORD_MAGIC = 0x454D4331;  ///< "EMC1"
+     static const uint16_t RECORD_VERSION = 4;
+
+     ErrorHandler* errorHandler;   ///< Error handler for logging
+     Preferences preferences;      ///< NVS namespace handle
+     bool ready;                   ///< Whether begin() opened the namespace
+
+     /**
+      * @brief Write a record under a key
+      * @param key NVS key
+      * @param sourceCrc Value stored in the header
+      * @param payload Record payload
+      * @return true if written
+      */
+     bool writeRecord(const char* key, uint32_t sourceCrc, const std::vector<uint8_t>& payload);
+
+     /**
+      * @brief Read and validate a record
+      * @param key NVS key
+      * @param sourceCrc Required header value
+      * @param payload [out] Record payload
+      * @return true if the record exists and validates
+      */
+     bool readRecord(const char* key, uint32_t sourceCrc, std::vector<uint8_t>& payload);
+
+     /**
+      * @brief Get the NVS key of a bus's topology record
+      * @param port I2C port
+      * @return Key name
+      */
+     static const char* topologyKey(I2CPort port);
+ };
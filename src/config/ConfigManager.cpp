@@ -1,13 +1,95 @@
 #include "ConfigManager.h"
 #include <ArduinoJson.h>
+#include <algorithm>
 #include "../Constants.h"
 #include "../sensors/SensorTypes.h"
 
-ConfigManager::ConfigManager(ErrorHandler* err) : errorHandler(err), notifyingCallbacks(false) {
+ConfigManager::ConfigManager(ErrorHandler* err)
+    : errorHandler(err), i2cClockLimits(2, Constants::Sensors::DEFAULT_I2C_CLOCK_LIMIT),
+      documentLoaded(false), cache(err), dirty(false), firstChangeTime(0), lastChangeTime(0),
+      notifyingCallbacks(false) {
 }
 
 bool ConfigManager::begin() {
-    return loadConfigFromFile();
+    cache.begin();
+    
+    // Saves write the temp file and rename it over the config in one step, so a leftover
+    // temp file is an unfinished save and is dropped. Without a config it is the only copy
+    // left, e.g. by firmware that removed the config before renaming, and is kept
+    if (!LittleFS.exists(Constants::CONFIG_FILE_PATH) && LittleFS.exists(Constants::CONFIG_TEMP_FILE_PATH)) {
+        errorHandler->logError(WARNING, "Recovering config from interrupted write");
+        LittleFS.rename(Constants::CONFIG_TEMP_FILE_PATH, Constants::CONFIG_FILE_PATH);
+    } else if (LittleFS.exists(Constants::CONFIG_TEMP_FILE_PATH)) {
+        LittleFS.remove(Constants::CONFIG_TEMP_FILE_PATH);
+    }
+    
+    // Skip parsing entirely if the cache was built from this exact file
+    uint32_t fileCrc = 0;
+    if (readConfigFileCrc(fileCrc) && cache.loadConfig(fileCrc, boardId, additionalConfig, sensorConfigs, i2cClockLimits, telemetryConfig, taskConfig)) {
+        i2cClockLimits.resize(2, Constants::Sensors::DEFAULT_I2C_CLOCK_LIMIT);
+        document.clear();
+        documentLoaded = false;
+        dirty = false;
+        errorHandler->logError(INFO, "Configuration loaded from cache with " + String(sensorConfigs.size()) + " peripherals");
+        return true;
+    }
+    
+    if (!loadConfigFromFile()) {
+        return false;
+    }
+    
+    // The file may have just been created, so checksum it again
+    if (readConfigFileCrc(fileCrc)) {
+        cache.storeConfig(fileCrc, boardId, additionalConfig, sensorConfigs, i2cClockLimits, telemetryConfig, taskConfig);
+    }
+    return true;
+}
+
+bool ConfigManager::readConfigFileCrc(uint32_t& crc) {
+    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "r");
+    if (!configFile) {
+        return false;
+    }
+    
+    uint8_t chunk[256];
+    crc = 0;
+    size_t count;
+    while ((count = configFile.read(chunk, sizeof(chunk))) > 0) {
+        crc = ConfigCache::crc32(chunk, count, crc);
+    }
+    configFile.close();
+    return true;
+}
+
+void ConfigManager::ensureDocumentLoaded() {
+    if (documentLoaded) {
+        return;
+    }
+    documentLoaded = true;
+    
+    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "r");
+    if (configFile) {
+        DeserializationError error = deserializeJson(document, configFile);
+        configFile.close();
+        if (!error && !document.overflowed()) {
+            return;
+        }
+    }
+    
+    // Keep what was loaded; keys this class does not interpret are lost
+    errorHandler->logError(WARNING, "Config file unreadable, rebuilding it from the loaded configuration");
+    document.clear();
+    document["Environment Monitor ID"] = boardId;
+    writeSensorConfigsToDocument();
+    writeI2CClockLimitsToDocument();
+    writeTelemetryConfigToDocument();
+    writeTaskConfigToDocument();
+    document["Additional"] = additionalConfig;
+}
+
+JsonVariantConst ConfigManager::getConfig() {
+    ensureDocumentLoaded();
+    return document.as<JsonVariantConst>();
 }
 
 void ConfigManager::disableNotifications(bool disable) {
@@ -15,23 +97,18 @@ void ConfigManager::disableNotifications(bool disable) {
 }
 
 int ConfigManager::i2cPortStringToNumber(const String& portStr) {
-    if (portStr.startsWith("I2C")) {
-        String numStr = portStr.substring(3); // Extract number after "I2C"
-        int portNum = numStr.toInt();
-
-        // Validate port number (0, 1)
-        if (portNum == 0 || portNum == 1) {
-            return portNum;
-        }
+    I2CPort port;
+    if (I2CManager::parsePort(portStr, port)) {
+        return static_cast<int>(port);
     }
     
     errorHandler->logError(ERROR, "Invalid I2C port string: " + portStr + 
-                          " (valid: I2C0, I2C1)");
+                          " (valid: I2C0, I2C1, I2C0/mux:0-7, I2C1/mux:0-7)");
     return -1; // Invalid format
 }
 
 String ConfigManager::portNumberToI2CString(int portNum) {
-    return "I2C" + String(portNum);
+    return I2CManager::portToString(static_cast<I2CPort>(portNum));
 }
 
 void ConfigManager::registerChangeCallback(ConfigChangeCallback callback) {
@@ -42,7 +119,7 @@ void ConfigManager::registerChangeCallback(ConfigChangeCallback callback) {
 }
 
 // Notify all registered callbacks about a configuration change
-void ConfigManager::notifyConfigChanged(const String& newConfig) {
+void ConfigManager::notifyConfigChanged() {
     // Prevent recursive notifications
     if (notifyingCallbacks) {
         errorHandler->logError(INFO, "Preventing recursive notification of config changes");
@@ -54,13 +131,66 @@ void ConfigManager::notifyConfigChanged(const String& newConfig) {
     errorHandler->logError(INFO, "Notifying " + String(changeCallbacks.size()) + " callbacks about config change");
     for (auto callback : changeCallbacks) {
         errorHandler->logError(INFO, "Calling a callback...");
-        callback(newConfig);
+        callback(document.as<JsonVariantConst>());
     }
     
     notifyingCallbacks = false;
     errorHandler->logError(INFO, "All callbacks notified");
 }
 
+void ConfigManager::markDirty() {
+    unsigned long now = millis();
+    if (!dirty) {
+        firstChangeTime = now;
+    }
+    lastChangeTime = now;
+    dirty = true;
+}
+
+uint32_t ConfigManager::msUntilFlushDue() const {
+    if (!dirty) {
+        return UINT32_MAX;
+    }
+    
+    uint32_t now = millis();
+    uint32_t settled = now - lastChangeTime;
+    uint32_t waited = now - firstChangeTime;
+    if (settled >= Constants::Config::WRITE_DEBOUNCE_MS || waited >= Constants::Config::WRITE_MAX_DELAY_MS) {
+        return 0;
+    }
+    return std::min(Constants::Config::WRITE_DEBOUNCE_MS - settled, Constants::Config::WRITE_MAX_DELAY_MS - waited);
+}
+
+bool ConfigManager::flushIfDue() {
+    if (!dirty) {
+        return true;
+    }
+    
+    unsigned long now = millis();
+    if (now - lastChangeTime < Constants::Config::WRITE_DEBOUNCE_MS &&
+        now - firstChangeTime < Constants::Config::WRITE_MAX_DELAY_MS) {
+        return true;
+    }
+    
+    return flush();
+}
+
+bool ConfigManager::flush() {
+    if (!dirty) {
+        return true;
+    }
+    
+    if (!writeConfigToFile(document)) {
+        // Stay dirty and retry after another debounce interval
+        lastChangeTime = millis();
+        return false;
+    }
+    
+    dirty = false;
+    errorHandler->logError(INFO, "Configuration written to flash");
+    return true;
+}
+
 // Load configuration from the JSON file
 bool ConfigManager::loadConfigFromFile() {
     errorHandler->logError(INFO, "Loading config file");
@@ -86,8 +216,8 @@ bool ConfigManager::loadConfigFromFile() {
         return false;
     }
     
-    // Parse JSON
-    JsonDocument doc;
+    // Parse JSON; this document stays in memory as the authoritative copy
+    JsonDocument& doc = document;
     DeserializationError error = deserializeJson(doc, configFile);
     configFile.close();
     
@@ -101,6 +231,8 @@ bool ConfigManager::loadConfigFromFile() {
         errorHandler->logError(ERROR, "Config too large for available memory");
         return false;
     }
+    documentLoaded = true;
+    dirty = false;
     
     errorHandler->logError(INFO, "JSON parsed successfully");
     
@@ -244,6 +376,29 @@ bool ConfigManager::loadConfigFromFile() {
         }
     }
     
+    // Bus clock limits default to fast mode when absent
+    std::fill(i2cClockLimits.begin(), i2cClockLimits.end(), Constants::Sensors::DEFAULT_I2C_CLOCK_LIMIT);
+    if (doc[Constants::CONFIG_I2C_CLOCK_LIMITS].is<JsonObject>() &&
+        !readI2CClockLimits(doc[Constants::CONFIG_I2C_CLOCK_LIMITS].as<JsonObjectConst>())) {
+        errorHandler->logError(WARNING, "Ignoring out-of-range I2C clock limits");
+    }
+    
+    // Telemetry stays off unless a valid object enables it
+    telemetryConfig = TelemetryConfig();
+    if (doc[Constants::CONFIG_TELEMETRY].is<JsonObject>() &&
+        !readTelemetryConfig(doc[Constants::CONFIG_TELEMETRY].as<JsonObjectConst>(), telemetryConfig)) {
+        errorHandler->logError(WARNING, "Ignoring invalid telemetry settings");
+        telemetryConfig = TelemetryConfig();
+    }
+    
+    // Tasks keep the built-in placement unless the whole object is valid
+    taskConfig = TaskPlacementConfig();
+    if (doc[Constants::CONFIG_TASKS].is<JsonObject>() &&
+        !readTaskConfig(doc[Constants::CONFIG_TASKS].as<JsonObjectConst>(), taskConfig)) {
+        errorHandler->logError(WARNING, "Ignoring invalid task placement");
+        taskConfig = TaskPlacementConfig();
+    }
+    
     // Load Additional configuration if present
     if (doc["Additional"].is<String>()) {
         additionalConfig = doc["Additional"].as<String>();
@@ -256,27 +411,77 @@ bool ConfigManager::loadConfigFromFile() {
     return true;
 }
 
-bool ConfigManager::updateConfigFromJson(const String& jsonConfig) {
+bool ConfigManager::updateConfigFromJson(const char* jsonConfig) {
     // Log a shorter version of the config to avoid huge logs
-    errorHandler->logError(INFO, "Received config update: " + 
-                         jsonConfig.substring(0, std::min(50, (int)jsonConfig.length())) + 
-                         (jsonConfig.length() > 50 ? "..." : ""));
+    errorHandler->logError(INFO, "Received config update: %.50s%s", jsonConfig,
+                           strlen(jsonConfig) > 50 ? "..." : "");
     
-    // Extract clean JSON data by finding the opening brace
-    int jsonStart = jsonConfig.indexOf('{');
-    if (jsonStart < 0) {
+    JsonStreamReader reader(jsonConfig);
+    return updateConfigFromReader(reader);
+}
+
+bool ConfigManager::updateConfigFromJson(Stream& input) {
+    JsonStreamReader reader(input);
+    return updateConfigFromReader(reader);
+}
+
+bool ConfigManager::updateConfigFromReader(JsonStreamReader& reader) {
+    if (!reader.enterObject()) {
         errorHandler->logError(ERROR, "No JSON object found in config");
         return false;
     }
-    String cleanJson = jsonConfig.substring(jsonStart);
     
-    // Parse the JSON
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, cleanJson);
+    // Read every section before changing anything; each small section is kept
+    // as its own document and the peripherals are parsed entry by entry
+    String newBoardId;
+    bool hasBoardId = false;
+    bool boardIdFromMonitorKey = false;
+    std::vector<SensorConfig> i2cConfigs;
+    std::vector<SensorConfig> spiConfigs;
+    bool hasSensorConfigs = false;
+    JsonDocument clockLimits;
+    JsonDocument telemetry;
+    JsonDocument tasks;
+    JsonDocument additional;
+    JsonDocument value;
+    
+    bool allValid = true;
+    char key[JsonStreamReader::MAX_KEY_LENGTH + 1];
+    while (allValid && reader.nextMember(key)) {
+        if (strcmp(key, Constants::CONFIG_MONITOR_ID) == 0 || strcmp(key, "Board ID") == 0) {
+            // "Environment Monitor ID" wins over the legacy "Board ID" when both are present
+            bool monitorKey = strcmp(key, Constants::CONFIG_MONITOR_ID) == 0;
+            allValid = reader.readValue(value);
+            if (allValid && value.is<String>() && (monitorKey || !boardIdFromMonitorKey)) {
+                newBoardId = value.as<String>();
+                hasBoardId = true;
+                boardIdFromMonitorKey = monitorKey;
+            }
+        } else if (strcmp(key, Constants::CONFIG_I2C_SENSORS) == 0) {
+            hasSensorConfigs = true;
+            allValid = readPeripheralArray(reader, CommunicationType::I2C, i2cConfigs, spiConfigs.size());
+        } else if (strcmp(key, Constants::CONFIG_SPI_SENSORS) == 0) {
+            hasSensorConfigs = true;
+            allValid = readPeripheralArray(reader, CommunicationType::SPI, spiConfigs, i2cConfigs.size());
+        } else if (strcmp(key, Constants::CONFIG_I2C_CLOCK_LIMITS) == 0) {
+            allValid = reader.readValue(clockLimits);
+        } else if (strcmp(key, Constants::CONFIG_TELEMETRY) == 0) {
+            allValid = reader.readValue(telemetry);
+        } else if (strcmp(key, Constants::CONFIG_TASKS) == 0) {
+            allValid = reader.readValue(tasks);
+        } else if (strcmp(key, "Additional") == 0) {
+            allValid = reader.readValue(additional);
+        } else {
+            allValid = reader.skipValue();
+        }
+    }
     
-    if (error || doc.overflowed()) {
-        errorHandler->logError(ERROR, "Failed to parse JSON config: " + 
-                              (error ? String(error.c_str()) : "Document too large"));
+    if (reader.failed()) {
+        errorHandler->logError(ERROR, "Failed to parse JSON config: " + String(reader.errorMessage()));
+        return false;
+    }
+    if (!allValid) {
+        errorHandler->logError(ERROR, "Configuration rejected due to validation errors - no changes applied");
         return false;
     }
     
@@ -284,53 +489,78 @@ bool ConfigManager::updateConfigFromJson(const String& jsonConfig) {
     String originalBoardId = boardId;
     std::vector<SensorConfig> originalSensorConfigs = sensorConfigs;
     String originalAdditionalConfig = additionalConfig;
+    std::vector<uint32_t> originalClockLimits = i2cClockLimits;
+    TelemetryConfig originalTelemetryConfig = telemetryConfig;
+    TaskPlacementConfig originalTaskConfig = taskConfig;
     
     bool allUpdatesSuccessful = true;
     
     // Update board identifier if present (reuse existing function)
-    if (doc["Environment Monitor ID"].is<String>() || doc["Board ID"].is<String>()) {
-        String newBoardId;
-        if (doc["Environment Monitor ID"].is<String>()) {
-            newBoardId = doc["Environment Monitor ID"].as<String>();
-        } else {
-            newBoardId = doc["Board ID"].as<String>();
-        }
-        
-        if (!setBoardIdentifier(newBoardId)) {
-            errorHandler->logError(ERROR, "Failed to update board identifier");
+    if (hasBoardId && !setBoardIdentifier(newBoardId)) {
+        errorHandler->logError(ERROR, "Failed to update board identifier");
+        allUpdatesSuccessful = false;
+    }
+    
+    // Update sensor configuration if present, I2C peripherals first as in the file
+    if (allUpdatesSuccessful && hasSensorConfigs) {
+        i2cConfigs.insert(i2cConfigs.end(), spiConfigs.begin(), spiConfigs.end());
+        spiConfigs.clear();
+        if (!commitSensorConfigs(i2cConfigs)) {
+            errorHandler->logError(ERROR, "Failed to update sensor configuration");
             allUpdatesSuccessful = false;
         }
     }
     
-    // Update sensor configuration if present (reuse existing function)
-    if (allUpdatesSuccessful && (doc["I2C Peripherals"].is<JsonArray>() || doc["SPI Peripherals"].is<JsonArray>())) {
-        // Create a JSON string with just the sensor config parts
-        JsonDocument sensorDoc;
-        if (doc["I2C Peripherals"].is<JsonArray>()) {
-            sensorDoc["I2C Peripherals"] = doc["I2C Peripherals"];
+    // Update bus clock limits if present
+    if (allUpdatesSuccessful && clockLimits.is<JsonObject>()) {
+        ensureDocumentLoaded();
+        if (readI2CClockLimits(clockLimits.as<JsonObjectConst>())) {
+            writeI2CClockLimitsToDocument();
+            markDirty();
+        } else {
+            errorHandler->logError(ERROR, "I2C clock limits must be between " + 
+                                 String(Constants::Sensors::MIN_I2C_CLOCK_FREQ) + " and " + 
+                                 String(Constants::Sensors::MAX_I2C_CLOCK_FREQ) + " Hz");
+            allUpdatesSuccessful = false;
         }
-        if (doc["SPI Peripherals"].is<JsonArray>()) {
-            sensorDoc["SPI Peripherals"] = doc["SPI Peripherals"];
+    }
+    
+    // Update telemetry settings if present; the publisher picks them up at restart
+    if (allUpdatesSuccessful && telemetry.is<JsonObject>()) {
+        ensureDocumentLoaded();
+        TelemetryConfig newTelemetryConfig;
+        if (readTelemetryConfig(telemetry.as<JsonObjectConst>(), newTelemetryConfig)) {
+            telemetryConfig = newTelemetryConfig;
+            writeTelemetryConfigToDocument();
+            markDirty();
+        } else {
+            errorHandler->logError(ERROR, "Telemetry settings need Protocol UDP or MQTT, a non-zero Port and an Interval between " +
+                                 String(Constants::Telemetry::MIN_INTERVAL_MS) + " and " +
+                                 String(Constants::Telemetry::MAX_INTERVAL_MS) + " ms");
+            allUpdatesSuccessful = false;
         }
-        
-        String sensorConfigJson;
-        serializeJson(sensorDoc, sensorConfigJson);
-        
-        if (!updateSensorConfigFromJson(sensorConfigJson)) {
-            errorHandler->logError(ERROR, "Failed to update sensor configuration");
+    }
+    
+    // Update task placement if present; it is applied when the tasks are created at restart
+    if (allUpdatesSuccessful && tasks.is<JsonObject>()) {
+        ensureDocumentLoaded();
+        TaskPlacementConfig newTaskConfig;
+        if (readTaskConfig(tasks.as<JsonObjectConst>(), newTaskConfig)) {
+            taskConfig = newTaskConfig;
+            writeTaskConfigToDocument();
+            markDirty();
+        } else {
+            errorHandler->logError(ERROR, "Task settings need Core 0-" + String(portNUM_PROCESSORS - 1) +
+                                 " or ANY, Priority 1-" + String(Constants::Tasks::MAX_TASK_PRIORITY) +
+                                 " and Stack " + String(Constants::Tasks::MIN_STACK_SIZE) + "-" +
+                                 String(Constants::Tasks::MAX_STACK_SIZE));
             allUpdatesSuccessful = false;
         }
     }
     
     // Update additional configuration if present (reuse existing function)
-    if (allUpdatesSuccessful && doc["Additional"]) {
-        JsonDocument additionalDoc;
-        additionalDoc["Additional"] = doc["Additional"];
-        
-        String additionalConfigJson;
-        serializeJson(additionalDoc, additionalConfigJson);
-        
-        if (!updateAdditionalConfigFromJson(additionalConfigJson)) {
+    if (allUpdatesSuccessful && !additional.isNull()) {
+        if (!applyAdditionalConfig(additional.as<JsonVariantConst>())) {
             errorHandler->logError(ERROR, "Failed to update additional configuration");
             allUpdatesSuccessful = false;
         }
@@ -350,8 +580,14 @@ bool ConfigManager::updateConfigFromJson(const String& jsonConfig) {
         // Rollback sensor configs
         updateSensorConfigs(originalSensorConfigs);
         
-        // Rollback additional config
+        // Rollback additional config, clock limits, telemetry and task placement
         additionalConfig = originalAdditionalConfig;
+        i2cClockLimits = originalClockLimits;
+        writeI2CClockLimitsToDocument();
+        telemetryConfig = originalTelemetryConfig;
+        writeTelemetryConfigToDocument();
+        taskConfig = originalTaskConfig;
+        writeTaskConfigToDocument();
         
         // Re-enable notifications
         disableNotifications(false);
@@ -362,8 +598,7 @@ bool ConfigManager::updateConfigFromJson(const String& jsonConfig) {
     errorHandler->logError(INFO, "Complete configuration update successful");
     
     // Notify about the configuration change (this will be the final combined config)
-    String finalConfig = getConfigJson();
-    notifyConfigChanged(finalConfig);
+    notifyConfigChanged();
     
     return true;
 }
@@ -387,22 +622,18 @@ bool ConfigManager::createDefaultConfig() {
     i2cPeripheral["Additional"] = "";  // No additional settings by default
     
     doc["SPI Peripherals"] = JsonArray(); // Empty SPI peripherals by default
+    JsonObject clockLimits = doc[Constants::CONFIG_I2C_CLOCK_LIMITS].to<JsonObject>();
+    clockLimits["I2C0"] = Constants::Sensors::DEFAULT_I2C_CLOCK_LIMIT;
+    clockLimits["I2C1"] = Constants::Sensors::DEFAULT_I2C_CLOCK_LIMIT;
+    JsonObject telemetry = doc[Constants::CONFIG_TELEMETRY].to<JsonObject>();
+    telemetry["Enabled"] = false;  // Wi-Fi stays off until configured
     doc["Additional"] = "";  // Empty "Additional" by default   
     // Save to file
-    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "w");
-    if (!configFile) {
+    if (!writeConfigToFile(doc)) {
         errorHandler->logError(ERROR, "Failed to create config file");
         return false;
     }
     
-    if (serializeJson(doc, configFile) == 0) {
-        errorHandler->logError(ERROR, "Failed to write config");
-        configFile.close();
-        return false;
-    }
-    
-    configFile.close();
-    
     // Load the configurations we just created
     return loadConfigFromFile();
 }
@@ -412,51 +643,161 @@ String ConfigManager::getBoardIdentifier() {
     return boardId;
 }
 
+// Get the board's additional configuration
+String ConfigManager::getAdditionalConfig() {
+    return additionalConfig;
+}
+
 // Set the board identifier
 bool ConfigManager::setBoardIdentifier(String identifier) {
-    // Update Environment Monitor ID in memory
+    // Update Environment Monitor ID in memory; the file catches up on the next flush
+    ensureDocumentLoaded();
     boardId = identifier;
+    document["Environment Monitor ID"] = boardId;
+    markDirty();
     
-    // Update config file
-    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "r");
-    if (!configFile) {
-        errorHandler->logError(ERROR, "Failed to open config file for reading");
-        return false;
-    }
+    errorHandler->logError(INFO, "Updated Environment Monitor ID to: " + boardId);
     
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, configFile);
-    configFile.close();
+    // Notify about the configuration change
+    notifyConfigChanged();
     
-    if (error) {
-        errorHandler->logError(ERROR, "Failed to parse config when updating Environment Monitor ID");
+    return true;
+}
+
+uint32_t ConfigManager::getI2CClockLimit(int portNum) const {
+    if (portNum < 0 || portNum >= static_cast<int>(i2cClockLimits.size())) {
+        return Constants::Sensors::DEFAULT_I2C_CLOCK_FREQ;
+    }
+    return i2cClockLimits[portNum];
+}
+
+bool ConfigManager::setI2CClockLimit(int portNum, uint32_t clockFreq) {
+    if (portNum < 0 || portNum >= static_cast<int>(i2cClockLimits.size()) ||
+        clockFreq < Constants::Sensors::MIN_I2C_CLOCK_FREQ || clockFreq > Constants::Sensors::MAX_I2C_CLOCK_FREQ) {
+        errorHandler->logError(ERROR, "Invalid I2C clock limit " + String(clockFreq) + " Hz for port " + String(portNum));
         return false;
     }
     
-    doc["Environment Monitor ID"] = boardId;
+    ensureDocumentLoaded();
+    i2cClockLimits[portNum] = clockFreq;
+    writeI2CClockLimitsToDocument();
+    markDirty();
+    
+    errorHandler->logError(INFO, "Updated " + portNumberToI2CString(portNum) + " clock limit to " + String(clockFreq) + " Hz");
+    return true;
+}
+
+bool ConfigManager::readI2CClockLimits(JsonObjectConst limits) {
+    bool allValid = true;
+    for (size_t port = 0; port < i2cClockLimits.size(); port++) {
+        JsonVariantConst value = limits[portNumberToI2CString(port)];
+        if (!value.is<uint32_t>()) {
+            continue;
+        }
         
-    // Save the updated configuration
-    configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "w");
-    if (!configFile) {
-        errorHandler->logError(ERROR, "Failed to open config file for writing");
-        return false;
+        uint32_t clockFreq = value.as<uint32_t>();
+        if (clockFreq < Constants::Sensors::MIN_I2C_CLOCK_FREQ || clockFreq > Constants::Sensors::MAX_I2C_CLOCK_FREQ) {
+            allValid = false;
+            continue;
+        }
+        i2cClockLimits[port] = clockFreq;
     }
-    
-    if (serializeJson(doc, configFile) == 0) {
-        errorHandler->logError(ERROR, "Failed to write updated config");
-        configFile.close();
+    return allValid;
+}
+
+bool ConfigManager::readTelemetryConfig(JsonObjectConst telemetry, TelemetryConfig& config) {
+    config = TelemetryConfig();
+    config.enabled = telemetry["Enabled"] | false;
+    config.ssid = telemetry["SSID"] | "";
+    config.password = telemetry["Password"] | "";
+    config.host = telemetry["Host"] | "";
+    config.topic = telemetry["Topic"] | "";
+    
+    String protocol = telemetry["Protocol"] | "UDP";
+    if (protocol.equalsIgnoreCase("MQTT")) {
+        config.protocol = TelemetryProtocol::MQTT;
+        config.port = Constants::Telemetry::DEFAULT_MQTT_PORT;
+    } else if (protocol.equalsIgnoreCase("UDP")) {
+        config.protocol = TelemetryProtocol::UDP;
+    } else {
         return false;
     }
     
-    configFile.close();
-    errorHandler->logError(INFO, "Updated Environment Monitor ID to: " + boardId);
-    
-    // Notify about the configuration change
-    String configJson;
-    serializeJson(doc, configJson);
-    notifyConfigChanged(configJson);
-    
-    return true;
+    if (telemetry["Port"].is<uint16_t>()) {
+        config.port = telemetry["Port"].as<uint16_t>();
+    }
+    if (telemetry["Interval[ms]"].is<uint32_t>()) {
+        config.intervalMs = telemetry["Interval[ms]"].as<uint32_t>();
+    }
+    return config.port != 0 && config.intervalMs >= Constants::Telemetry::MIN_INTERVAL_MS &&
+           config.intervalMs <= Constants::Telemetry::MAX_INTERVAL_MS;
+}
+
+void ConfigManager::writeTelemetryConfigToDocument() {
+    JsonObject telemetry = document[Constants::CONFIG_TELEMETRY].to<JsonObject>();
+    telemetry["Enabled"] = telemetryConfig.enabled;
+    telemetry["SSID"] = telemetryConfig.ssid;
+    telemetry["Password"] = telemetryConfig.password;
+    telemetry["Protocol"] = telemetryConfig.protocol == TelemetryProtocol::MQTT ? "MQTT" : "UDP";
+    telemetry["Host"] = telemetryConfig.host;
+    telemetry["Port"] = telemetryConfig.port;
+    telemetry["Topic"] = telemetryConfig.topic;
+    telemetry["Interval[ms]"] = telemetryConfig.intervalMs;
+}
+
+bool ConfigManager::readTaskConfig(JsonObjectConst tasks, TaskPlacementConfig& config) {
+    config = TaskPlacementConfig();
+    bool valid = true;
+    for (JsonPairConst entry : tasks) {
+        TaskRole role;
+        if (!taskRoleFromString(entry.key().c_str(), role) || !entry.value().is<JsonObjectConst>()) {
+            errorHandler->logError(WARNING, "Unknown task in placement: " + String(entry.key().c_str()));
+            valid = false;
+            continue;
+        }
+        
+        JsonObjectConst settings = entry.value().as<JsonObjectConst>();
+        TaskPlacement& placement = config[role];
+        if (settings["Core"].is<const char*>()) {
+            if (strcasecmp(settings["Core"].as<const char*>(), "ANY") != 0) {
+                valid = false;
+            }
+            placement.core = tskNO_AFFINITY;
+        } else if (settings["Core"].is<int>()) {
+            placement.core = settings["Core"].as<int>();
+        }
+        if (settings["Priority"].is<int>()) {
+            placement.priority = settings["Priority"].as<int>();
+        }
+        if (settings["Stack"].is<uint32_t>()) {
+            placement.stackSize = settings["Stack"].as<uint32_t>();
+        }
+        valid &= placement.isValid();
+    }
+    return valid;
+}
+
+void ConfigManager::writeTaskConfigToDocument() {
+    JsonObject tasks = document[Constants::CONFIG_TASKS].to<JsonObject>();
+    for (size_t i = 0; i < static_cast<size_t>(TaskRole::COUNT); i++) {
+        TaskRole role = static_cast<TaskRole>(i);
+        const TaskPlacement& placement = taskConfig[role];
+        JsonObject settings = tasks[taskRoleToString(role)].to<JsonObject>();
+        if (placement.core == tskNO_AFFINITY) {
+            settings["Core"] = "ANY";
+        } else {
+            settings["Core"] = placement.core;
+        }
+        settings["Priority"] = placement.priority;
+        settings["Stack"] = placement.stackSize;
+    }
+}
+
+void ConfigManager::writeI2CClockLimitsToDocument() {
+    JsonObject limits = document[Constants::CONFIG_I2C_CLOCK_LIMITS].to<JsonObject>();
+    for (size_t port = 0; port < i2cClockLimits.size(); port++) {
+        limits[portNumberToI2CString(port)] = i2cClockLimits[port];
+    }
 }
 
 std::vector<SensorConfig> ConfigManager::getSensorConfigs() {
@@ -466,24 +807,24 @@ std::vector<SensorConfig> ConfigManager::getSensorConfigs() {
 // Sensors are called peripherals in the JSON file
 bool ConfigManager::updateSensorConfigs(const std::vector<SensorConfig>& configs) {
     // Update memory copy
+    ensureDocumentLoaded();
     sensorConfigs = configs;
+    writeSensorConfigsToDocument();
     
-    // Load existing config
-    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "r");
-    if (!configFile) {
-        errorHandler->logError(ERROR, "Failed to open config file for reading");
-        return false;
-    }
-    
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, configFile);
-    configFile.close();
+    markDirty();
+    errorHandler->logError(INFO, "Updated peripheral configurations");
     
-    if (error) {
-        errorHandler->logError(ERROR, "Failed to parse config when updating peripherals");
-        return false;
+    // Notify about the configuration change, but only if not already in a notification
+    if (!notifyingCallbacks) {
+        notifyConfigChanged();
     }
     
+    return true;
+}
+
+void ConfigManager::writeSensorConfigsToDocument() {
+    JsonDocument& doc = document;
+    
     // Clear existing peripherals
     doc["I2C Peripherals"] = JsonArray();
     doc["SPI Peripherals"] = JsonArray();
@@ -492,7 +833,7 @@ bool ConfigManager::updateSensorConfigs(const std::vector<SensorConfig>& configs
     JsonArray i2cPeripherals = doc["I2C Peripherals"].to<JsonArray>();
     JsonArray spiPeripherals = doc["SPI Peripherals"].to<JsonArray>();
     
-    for (const auto& config : configs) {
+    for (const auto& config : sensorConfigs) {
         if (config.communicationType == CommunicationType::SPI) {
             JsonObject peripheral = spiPeripherals.add<JsonObject>();
             peripheral["Peripheral Name"] = config.name;
@@ -510,55 +851,25 @@ bool ConfigManager::updateSensorConfigs(const std::vector<SensorConfig>& configs
             peripheral["Additional"] = config.additional;  // Always include
         }
     }
-    
-    // Save the updated configuration
-    configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "w");
-    if (!configFile) {
-        errorHandler->logError(ERROR, "Failed to open config file for writing");
-        return false;
-    }
-    
-    if (serializeJson(doc, configFile) == 0) {
-        errorHandler->logError(ERROR, "Failed to write updated config");
-        configFile.close();
-        return false;
-    }
-    
-    configFile.close();
-    errorHandler->logError(INFO, "Updated peripheral configurations");
-    
-    // Notify about the configuration change, but only if not already in a notification
-    if (!notifyingCallbacks) {
-        String configJson;
-        serializeJson(doc, configJson);
-        notifyConfigChanged(configJson);
-    }
-    
-    return true;
 }
 
 // Get the complete configuration as a JSON string
 String ConfigManager::getConfigJson() {
-    if (!LittleFS.exists(Constants::CONFIG_FILE_PATH)) {
-        errorHandler->logError(WARNING, "Config file not found for retrieval");
+    ensureDocumentLoaded();
+    if (document.isNull()) {
+        errorHandler->logError(WARNING, "No configuration loaded for retrieval");
         return "{}";
     }
     
-    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "r");
-    if (!configFile) {
-        errorHandler->logError(ERROR, "Failed to open config file for retrieval");
-        return "{}";
-    }
-    
-    String configStr = configFile.readString();
-    configFile.close();
-    
+    String configStr;
+    configStr.reserve(measureJson(document) + 1);
+    serializeJson(document, configStr);
     return configStr;
 }
 
-bool ConfigManager::updateSensorConfigFromJson(const String& jsonConfig) {
+bool ConfigManager::updateSensorConfigFromJson(const char* jsonConfig) {
     // Handle empty input - erase peripherals with warning
-    if (jsonConfig.length() == 0 || jsonConfig == "{}" || jsonConfig == "null") {
+    if (jsonConfig[0] == '\0' || strcmp(jsonConfig, "{}") == 0 || strcmp(jsonConfig, "null") == 0) {
         errorHandler->logError(WARNING, "Empty peripheral configuration received - clearing all peripherals");
         sensorConfigs.clear();
         
@@ -566,134 +877,142 @@ bool ConfigManager::updateSensorConfigFromJson(const String& jsonConfig) {
         return updateSensorConfigs(sensorConfigs);
     }
     
-    // Clean the input JSON and parse it
-    String cleanJson = jsonConfig;
-    int jsonStart = cleanJson.indexOf('{');
-    if (jsonStart > 0) {
-        cleanJson = cleanJson.substring(jsonStart);
+    JsonStreamReader reader(jsonConfig);
+    return updateSensorConfigFromReader(reader);
+}
+
+bool ConfigManager::updateSensorConfigFromJson(Stream& input) {
+    JsonStreamReader reader(input);
+    return updateSensorConfigFromReader(reader);
+}
+
+bool ConfigManager::updateSensorConfigFromReader(JsonStreamReader& reader) {
+    // Temporary storage for new configurations, kept per bus so I2C comes first
+    std::vector<SensorConfig> newSensorConfigs;
+    std::vector<SensorConfig> spiConfigs;
+    bool hasSensorConfigs = false;
+    bool allValid = reader.enterObject();
+    
+    char key[JsonStreamReader::MAX_KEY_LENGTH + 1];
+    while (allValid && reader.nextMember(key)) {
+        if (strcmp(key, Constants::CONFIG_I2C_SENSORS) == 0) {
+            hasSensorConfigs = true;
+            allValid = readPeripheralArray(reader, CommunicationType::I2C, newSensorConfigs, spiConfigs.size());
+        } else if (strcmp(key, Constants::CONFIG_SPI_SENSORS) == 0) {
+            hasSensorConfigs = true;
+            allValid = readPeripheralArray(reader, CommunicationType::SPI, spiConfigs, newSensorConfigs.size());
+        } else {
+            allValid = reader.skipValue();
+        }
     }
     
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, cleanJson);
+    if (reader.failed()) {
+        errorHandler->logError(ERROR, "Failed to parse peripheral configuration JSON: " + String(reader.errorMessage()));
+        return false;
+    }
     
-    if (error || doc.overflowed()) {
-        errorHandler->logError(ERROR, "Failed to parse peripheral configuration JSON: " + 
-                              (error ? String(error.c_str()) : "Document too large"));
+    // Only apply configuration if all peripherals are valid
+    if (!allValid) {
+        errorHandler->logError(ERROR, "Configuration rejected due to validation errors - no changes applied");
         return false;
     }
     
-    // Temporary storage for new configurations
-    std::vector<SensorConfig> newSensorConfigs;
-    bool allValid = true;
+    if (!hasSensorConfigs) {
+        errorHandler->logError(WARNING, "Empty peripheral configuration received - clearing all peripherals");
+    }
+    newSensorConfigs.insert(newSensorConfigs.end(), spiConfigs.begin(), spiConfigs.end());
+    return commitSensorConfigs(newSensorConfigs);
+}
+
+bool ConfigManager::readPeripheralArray(JsonStreamReader& reader, CommunicationType type,
+                                        std::vector<SensorConfig>& configs, size_t others) {
+    // Keep only the fields SensorConfig has; anything else in an entry is skipped while parsing
+    JsonDocument filter;
+    filter["Peripheral Name"] = true;
+    filter["Peripheral Type"] = true;
+    filter["I2C Port"] = true;
+    filter["Address (HEX)"] = true;
+    filter["SS Pin"] = true;
+    filter["Polling Rate[1000 ms]"] = true;
+    filter["Additional"] = true;
+    
+    configs.clear();
+    if (!reader.enterArray()) {
+        return false;
+    }
     
-    // Extract and validate I2C peripherals if present
-    if (doc["I2C Peripherals"].is<JsonArray>()) {
-        JsonArray i2cPeripherals = doc["I2C Peripherals"].as<JsonArray>();
+    JsonDocument entry;
+    while (reader.nextElement()) {
+        if (!reader.readValue(entry, filter.as<JsonVariantConst>())) {
+            return false;
+        }
+        if (configs.size() + others >= Constants::Sensors::MAX_SENSORS) {
+            errorHandler->logError(ERROR, "More than " + String(Constants::Sensors::MAX_SENSORS) + 
+                                 " peripherals configured");
+            return false;
+        }
         
-        for (JsonObject peripheral : i2cPeripherals) {
-            if (!peripheral["Peripheral Name"].is<String>() || !peripheral["Peripheral Type"].is<String>() || 
-                !peripheral["Address (HEX)"].is<int>()) {
-                errorHandler->logError(ERROR, "Missing required fields in I2C peripheral configuration");
-                allValid = false;
-                break;
-            }
-            
-            SensorConfig config;
-            config.name = peripheral["Peripheral Name"].as<String>();
-            config.type = peripheral["Peripheral Type"].as<String>();
-            config.address = peripheral["Address (HEX)"].as<int>();
-            config.communicationType = CommunicationType::I2C;
-            
-            // Handle I2C port with validation
-            if (peripheral["I2C Port"].is<String>()) {
-                String portStr = peripheral["I2C Port"].as<String>();
-                int portNum = i2cPortStringToNumber(portStr);
-                if (portNum == -1) {
-                    errorHandler->logError(ERROR, "Invalid I2C port for peripheral " + config.name + ": " + portStr);
-                    allValid = false;
-                    break;
-                }
-                config.portNum = portNum;
-            } else {
-                config.portNum = 0; // Default to port 0
-            }
-            
-            // Handle polling rate (reuse existing validation logic)
-            config.pollingRate = peripheral["Polling Rate[1000 ms]"].is<uint32_t>() ? 
-                peripheral["Polling Rate[1000 ms]"].as<uint32_t>() : Constants::System::DEFAULT_POLLING_RATE_MS;
-            config.pollingRate = constrain(config.pollingRate, 
-                                         Constants::System::MIN_POLLING_RATE_MS, 
-                                         Constants::System::MAX_POLLING_RATE_MS);
-            
-            config.additional = peripheral["Additional"].is<String>() ? 
-                peripheral["Additional"].as<String>() : "";
-            
-            // Validate configuration
-            String errorMessage;
-            if (!validateSensorConfig(config, errorMessage)) {
-                errorHandler->logError(ERROR, "Invalid I2C peripheral configuration for " + 
-                                     config.name + ": " + errorMessage);
-                allValid = false;
-                break;
-            }
-            
-            newSensorConfigs.push_back(config);
+        SensorConfig config;
+        if (!readSensorConfig(entry.as<JsonObjectConst>(), type, config)) {
+            return false;
         }
+        configs.push_back(config);
+    }
+    return !reader.failed();
+}
+
+bool ConfigManager::readSensorConfig(JsonObjectConst peripheral, CommunicationType type, SensorConfig& config) {
+    const char* bus = type == CommunicationType::SPI ? "SPI" : "I2C";
+    const char* addressKey = type == CommunicationType::SPI ? "SS Pin" : "Address (HEX)";
+    if (!peripheral["Peripheral Name"].is<String>() || !peripheral["Peripheral Type"].is<String>() || 
+        !peripheral[addressKey].is<int>()) {
+        errorHandler->logError(ERROR, "Missing required fields in " + String(bus) + " peripheral configuration");
+        return false;
     }
     
-    // Extract and validate SPI peripherals if present (only if I2C validation passed)
-    if (allValid && doc["SPI Peripherals"].is<JsonArray>()) {
-        JsonArray spiPeripherals = doc["SPI Peripherals"].as<JsonArray>();
-        
-        for (JsonObject peripheral : spiPeripherals) {
-            if (!peripheral["Peripheral Name"].is<String>() || !peripheral["Peripheral Type"].is<String>() || 
-                !peripheral["SS Pin"].is<int>()) {
-                errorHandler->logError(ERROR, "Missing required fields in SPI peripheral configuration");
-                allValid = false;
-                break;
-            }
-            
-            SensorConfig config;
-            config.name = peripheral["Peripheral Name"].as<String>();
-            config.type = peripheral["Peripheral Type"].as<String>();
-            config.address = peripheral["SS Pin"].as<int>();
-            config.communicationType = CommunicationType::SPI;
-            config.portNum = 0; // Default to port 0 for SPI
-            
-            // Handle polling rate (reuse existing validation logic)
-            config.pollingRate = peripheral["Polling Rate[1000 ms]"].is<uint32_t>() ? 
-                peripheral["Polling Rate[1000 ms]"].as<uint32_t>() : Constants::System::DEFAULT_POLLING_RATE_MS;
-            config.pollingRate = constrain(config.pollingRate, 
-                                         Constants::System::MIN_POLLING_RATE_MS, 
-                                         Constants::System::MAX_POLLING_RATE_MS);
-            
-            config.additional = peripheral["Additional"].is<String>() ? 
-                peripheral["Additional"].as<String>() : "";
-            
-            // Validate configuration
-            String errorMessage;
-            if (!validateSensorConfig(config, errorMessage)) {
-                errorHandler->logError(ERROR, "Invalid SPI peripheral configuration for " + 
-                                     config.name + ": " + errorMessage);
-                allValid = false;
-                break;
-            }
-            
-            newSensorConfigs.push_back(config);
+    config.name = peripheral["Peripheral Name"].as<String>();
+    config.type = peripheral["Peripheral Type"].as<String>();
+    config.address = peripheral[addressKey].as<int>();
+    config.communicationType = type;
+    config.portNum = 0; // Default to port 0, the only one for SPI
+    
+    // Handle I2C port with validation
+    if (type == CommunicationType::I2C && peripheral["I2C Port"].is<String>()) {
+        String portStr = peripheral["I2C Port"].as<String>();
+        int portNum = i2cPortStringToNumber(portStr);
+        if (portNum == -1) {
+            errorHandler->logError(ERROR, "Invalid I2C port for peripheral " + config.name + ": " + portStr);
+            return false;
         }
+        config.portNum = portNum;
     }
     
-    // Only apply configuration if all peripherals are valid
-    if (!allValid) {
-        errorHandler->logError(ERROR, "Configuration rejected due to validation errors - no changes applied");
+    // Handle polling rate (reuse existing validation logic)
+    config.pollingRate = peripheral["Polling Rate[1000 ms]"].is<uint32_t>() ? 
+        peripheral["Polling Rate[1000 ms]"].as<uint32_t>() : Constants::System::DEFAULT_POLLING_RATE_MS;
+    config.pollingRate = constrain(config.pollingRate, 
+                                 Constants::System::MIN_POLLING_RATE_MS, 
+                                 Constants::System::MAX_POLLING_RATE_MS);
+    
+    config.additional = peripheral["Additional"].is<String>() ? 
+        peripheral["Additional"].as<String>() : "";
+    
+    // Validate configuration
+    String errorMessage;
+    if (!validateSensorConfig(config, errorMessage)) {
+        errorHandler->logError(ERROR, "Invalid " + String(bus) + " peripheral configuration for " + 
+                             config.name + ": " + errorMessage);
         return false;
     }
-    
+    return true;
+}
+
+bool ConfigManager::commitSensorConfigs(const std::vector<SensorConfig>& configs) {
     // Check for duplicate sensor names
-    for (size_t i = 0; i < newSensorConfigs.size(); i++) {
-        for (size_t j = i + 1; j < newSensorConfigs.size(); j++) {
-            if (newSensorConfigs[i].name == newSensorConfigs[j].name) {
-                errorHandler->logError(ERROR, "Duplicate sensor name found: " + newSensorConfigs[i].name + 
+    for (size_t i = 0; i < configs.size(); i++) {
+        for (size_t j = i + 1; j < configs.size(); j++) {
+            if (configs[i].name == configs[j].name) {
+                errorHandler->logError(ERROR, "Duplicate sensor name found: " + configs[i].name + 
                                      " - configuration rejected");
                 return false;
             }
@@ -702,49 +1021,34 @@ bool ConfigManager::updateSensorConfigFromJson(const String& jsonConfig) {
     
     // All validation passed - apply the configuration
     errorHandler->logError(INFO, "Peripheral configuration validation passed with " + 
-                         String(newSensorConfigs.size()) + " peripherals");
+                         String(configs.size()) + " peripherals");
     
     // Update using existing function (this handles file I/O and notifications)
-    return updateSensorConfigs(newSensorConfigs);
+    return updateSensorConfigs(configs);
 }
 
-// Helper to write JSON document to file
+// Helper to write JSON document to file, replacing the old one in a single rename
 bool ConfigManager::writeConfigToFile(const JsonDocument& doc) {
-    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "w");
+    File configFile = LittleFS.open(Constants::CONFIG_TEMP_FILE_PATH, "w");
     if (!configFile) {
         errorHandler->logError(ERROR, "Failed to open config file for writing");
         return false;
     }
     
+    size_t expected = measureJson(doc);
     size_t written = serializeJson(doc, configFile);
     configFile.close();
     
-    if (written == 0) {
-        errorHandler->logError(ERROR, "Failed to write config - 0 bytes written");
+    if (written == 0 || written != expected) {
+        errorHandler->logError(ERROR, "Failed to write config - " + String(written) + " of " + 
+                              String(expected) + " bytes written");
+        LittleFS.remove(Constants::CONFIG_TEMP_FILE_PATH);
         return false;
     }
     
-    return true;
-}
-
-// Helper to read config from file
-bool ConfigManager::readConfigFromFile(JsonDocument& doc) {
-    if (!LittleFS.exists(Constants::CONFIG_FILE_PATH)) {
-        errorHandler->logError(ERROR, "Config file not found");
-        return false;
-    }
-    
-    File configFile = LittleFS.open(Constants::CONFIG_FILE_PATH, "r");
-    if (!configFile) {
-        errorHandler->logError(ERROR, "Failed to open config file for reading");
-        return false;
-    }
-    
-    DeserializationError error = deserializeJson(doc, configFile);
-    configFile.close();
-    
-    if (error) {
-        errorHandler->logError(ERROR, "Failed to parse config file: " + String(error.c_str()));
+    // LittleFS renames over an existing file atomically
+    if (!LittleFS.rename(Constants::CONFIG_TEMP_FILE_PATH, Constants::CONFIG_FILE_PATH)) {
+        errorHandler->logError(ERROR, "Failed to replace config file");
         return false;
     }
     
@@ -773,10 +1077,10 @@ bool ConfigManager::validateSensorConfig(const SensorConfig& config, String& err
     
     // Validate communication type specific settings
     if (config.communicationType == CommunicationType::I2C) {
-        // Validate I2C port number (valid ports: 0, 1, or 100+)
-        if (config.portNum < 0 || (config.portNum > 1 && config.portNum < 100)) {
+        // Validate I2C port number (valid ports: 0, 1, or a mux channel of either)
+        if (!I2CManager::isValidPort(config.portNum)) {
             errorMessage = "Invalid I2C port number: " + String(config.portNum) + 
-                         " (valid: 0, 1, or 100+)";
+                         " (valid: I2C0, I2C1 or a mux channel such as I2C0/mux:3)";
             return false;
         }
         
@@ -809,99 +1113,76 @@ bool ConfigManager::validateSensorConfig(const SensorConfig& config, String& err
 }
 
 // Update only the additional configuration
-bool ConfigManager::updateAdditionalConfigFromJson(const String& jsonConfig) {
+bool ConfigManager::updateAdditionalConfigFromJson(const char* jsonConfig) {
     // Handle empty input - erase additional config with warning
-    if (jsonConfig.length() == 0 || jsonConfig == "{}" || jsonConfig == "null") {
+    if (jsonConfig[0] == '\0' || strcmp(jsonConfig, "{}") == 0 || strcmp(jsonConfig, "null") == 0) {
         errorHandler->logError(WARNING, "Empty additional configuration received - clearing additional section");
+        ensureDocumentLoaded();
         additionalConfig = "";
-        
-        // Update the configuration file
-        JsonDocument doc;
-        if (!readConfigFromFile(doc)) {
-            errorHandler->logError(ERROR, "Failed to read existing configuration");
-            return false;
-        }
-        
-        // Remove Additional field if it exists
-        if (doc["Additional"].is<JsonObject>()) {
-            doc.remove("Additional");
-        }
-        
-        // Write updated configuration to file
-        return writeConfigToFile(doc);
+        document["Additional"] = "";
+        markDirty();
+        notifyConfigChanged();
+        return true;
     }
     
-    // Clean the input JSON and parse it
-    String cleanJson = jsonConfig;
-    int jsonStart = cleanJson.indexOf('{');
-    if (jsonStart > 0) {
-        cleanJson = cleanJson.substring(jsonStart);
+    JsonStreamReader reader(jsonConfig);
+    return updateAdditionalConfigFromReader(reader);
+}
+
+bool ConfigManager::updateAdditionalConfigFromReader(JsonStreamReader& reader) {
+    // Only the "Additional" member is kept; everything else is skipped unparsed
+    JsonDocument additional;
+    bool valid = reader.enterObject();
+    char key[JsonStreamReader::MAX_KEY_LENGTH + 1];
+    while (valid && reader.nextMember(key)) {
+        valid = strcmp(key, "Additional") == 0 ? reader.readValue(additional) : reader.skipValue();
     }
     
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, cleanJson);
-    
-    if (error || doc.overflowed()) {
-        errorHandler->logError(ERROR, "Failed to parse additional configuration JSON: " + 
-                              (error ? String(error.c_str()) : "Document too large"));
+    if (reader.failed()) {
+        errorHandler->logError(ERROR, "Failed to parse additional configuration JSON: " + String(reader.errorMessage()));
         return false;
     }
-    
+    return applyAdditionalConfig(additional.as<JsonVariantConst>());
+}
+
+bool ConfigManager::applyAdditionalConfig(JsonVariantConst additional) {
     // Extract Additional configuration if present
     String newAdditionalConfig = "";
-    if (doc["Additional"].is<JsonObject>()) {
+    if (additional.is<JsonObject>()) {
         // Serialize the Additional field to a string if it's an object
-        serializeJson(doc["Additional"], newAdditionalConfig);
-    } else if (doc["Additional"].is<String>()) {
+        serializeJson(additional, newAdditionalConfig);
+    } else if (additional.is<String>()) {
         // Use the string directly if it's a string
-        newAdditionalConfig = doc["Additional"].as<String>();
+        newAdditionalConfig = additional.as<String>();
     } else {
         // Convert to string if it's another type
-        newAdditionalConfig = doc["Additional"].as<String>();
+        newAdditionalConfig = additional.as<String>();
     }
     
-    // Backup existing additional config
-    String oldAdditionalConfig = additionalConfig;
-    
     // Update additional config
+    ensureDocumentLoaded();
     additionalConfig = newAdditionalConfig;
     
-    // Read current configuration file to get other parts
-    JsonDocument fullDoc;
-    if (!readConfigFromFile(fullDoc)) {
-        // Failed to read existing config, revert to old additional config
-        additionalConfig = oldAdditionalConfig;
-        return false;
-    }
-    
     // Update the Additional field
     if (additionalConfig.length() > 0) {
         // Parse the additionalConfig to a JSON object
         JsonDocument additionalDoc;
         DeserializationError additionalError = deserializeJson(additionalDoc, additionalConfig);
         
-    if (!additionalError && !additionalConfig.startsWith("\"")) {
-        // If it's a valid JSON object and not a JSON string, store as object
-        fullDoc["Additional"] = additionalDoc;
-    } else {
-        // If not a valid JSON object or it's a JSON string, store as raw string
-        fullDoc["Additional"] = additionalConfig;
-    }
-    }
-    // Write updated configuration to file
-    if (!writeConfigToFile(fullDoc)) {
-        // If writing fails, revert to old configuration
-        additionalConfig = oldAdditionalConfig;
-        errorHandler->logError(ERROR, "Failed to write updated additional configuration");
-        return false;
+        if (!additionalError && !additionalConfig.startsWith("\"")) {
+            // If it's a valid JSON object and not a JSON string, store as object
+            document["Additional"] = additionalDoc;
+        } else {
+            // If not a valid JSON object or it's a JSON string, store as raw string
+            document["Additional"] = additionalConfig;
+        }
     }
+    markDirty();
     
     errorHandler->logError(INFO, "Additional configuration updated successfully");
     
     // Notify about the configuration change
-    String configJson;
-    serializeJson(fullDoc, configJson);
-    notifyConfigChanged(configJson);
+    notifyConfigChanged();
     
     return true;
-}
\ No newline at end of file
+}
@@ -16,39 +16,11 @@
  #include <ArduinoJson.h>
  #include "../error/ErrorHandler.h"
  #include "../managers/I2CManager.h"
- 
- /**
-  * @brief Sensor communication protocols
-  * Defines the supported communication protocols for sensors
-  */
- enum class CommunicationType { 
-     I2C,  ///< I2C protocol
-     SPI   ///< SPI protocol
-     // Future protocols can be added here
- };
-
- /**
-  * @brief Convert communication type to string
-  * @param type The communication type
-  * @return String representation of the communication type
-  */
- inline String communicationTypeToString(CommunicationType type) {
-     switch (type) {
-         case CommunicationType::I2C: return "I2C";
-         case CommunicationType::SPI: return "SPI";
-         default: return "UNKNOWN";
-     }
- }
-
- /**
-  * @brief Convert string to communication type
-  * @param str The string representation
-  * @return The corresponding communication type
-  */
- inline CommunicationType stringToCommunicationType(const String& str) {
-     if (str.equalsIgnoreCase("SPI")) return CommunicationType::SPI;
-     return CommunicationType::I2C; // Default to I2C
- }
+ #include "../managers/TaskPlacement.h"
+ #include "ConfigCache.h"
+ #include "JsonStreamReader.h"
+ #include "CommunicationType.h"
+ #include "../Constants.h"
  
  /**
   * @brief Structure for sensor configurations
@@ -59,7 +31,7 @@
      String name;                          ///< Unique name identifier for the sensor
      String type;                          ///< Type/model of the sensor
      CommunicationType communicationType;  ///< Which communication type is used
-     int portNum;                          ///< Which communication bus to use (0-indexed)
+     int portNum;                          ///< Which communication bus to use (an I2CPort value for I2C)
      int address;                          ///< Address on the selected bus (0-indexed)
      uint32_t pollingRate;                 ///< Polling rate in milliseconds
      String additional;                    ///< Additional sensor-specific settings
@@ -88,18 +60,54 @@
          return !(*this == other);
      }
  };
+
+ /**
+  * @brief Transport used by the telemetry publisher
+  */
+ enum class TelemetryProtocol : uint8_t {
+     UDP,   ///< One datagram per batch
+     MQTT   ///< One QoS 0 PUBLISH per batch over a persistent broker connection
+ };
+ 
+ /**
+  * @brief Network telemetry settings
+  * Stored in config.json as a "Telemetry" object next to the board
+  * identifier. Changes take effect at the next restart.
+  */
+ struct TelemetryConfig {
+     bool enabled = false;                                         ///< Whether the publisher runs at all
+     String ssid;                                                  ///< Wi-Fi network name
+     String password;                                              ///< Wi-Fi passphrase, empty for an open network
+     TelemetryProtocol protocol = TelemetryProtocol::UDP;          ///< Transport
+     String host;                                                  ///< Collector or broker host name or address
+     uint16_t port = Constants::Telemetry::DEFAULT_UDP_PORT;       ///< Collector or broker port
+     String topic;                                                 ///< MQTT topic, empty for "<board id>/telemetry"
+     uint32_t intervalMs = Constants::Telemetry::DEFAULT_INTERVAL_MS; ///< Time between publishes
+ };
  
  /**
   * @brief Callback function type for configuration changes
-  * Used to notify interested parties when configuration changes.
+  * Used to notify interested parties when configuration changes. The
+  * view is of the in-memory configuration and is only valid during the call.
   */
- typedef void (*ConfigChangeCallback)(const String& newConfig);
+ typedef void (*ConfigChangeCallback)(JsonVariantConst config);
  
  /**
   * @brief Manages system configuration and persistence
   * This class handles loading, saving, and modifying the system configuration,
   * including sensors, identification, and general settings. It provides a 
   * JSON-based interface for configuration updates.
+  *
+  * The parsed document in memory is authoritative; the file is only read
+  * by begin(). Updates edit the document and mark it dirty, and
+  * flushIfDue() writes it back once changes have settled, so a burst of
+  * commands costs one flash write. Each write goes to a temporary file
+  * that is renamed over the old one, so a power cut never leaves a
+  * truncated configuration.
+  *
+  * At boot the parsed result is taken from a binary ConfigCache record
+  * when it was derived from a file with the same CRC, and the document is
+  * only parsed once something needs it.
   */
  class ConfigManager {
  private:
@@ -123,6 +131,52 @@
       */
      String additionalConfig;
      
+     /**
+      * @brief Fastest clock each physical I2C bus may negotiate, in Hz
+      */
+     std::vector<uint32_t> i2cClockLimits;
+     
+     /**
+      * @brief Network telemetry settings
+      */
+     TelemetryConfig telemetryConfig;
+     
+     /**
+      * @brief Core, priority and stack of each task
+      */
+     TaskPlacementConfig taskConfig;
+     
+     /**
+      * @brief Complete configuration, including keys this class does not interpret
+      */
+     JsonDocument document;
+     
+     /**
+      * @brief Whether document holds the file contents yet
+      * False after a boot served from the cache.
+      */
+     bool documentLoaded;
+     
+     /**
+      * @brief Binary snapshot of the parsed configuration and bus topology
+      */
+     ConfigCache cache;
+     
+     /**
+      * @brief Whether the document has changes not yet written to the file
+      */
+     bool dirty;
+     
+     /**
+      * @brief millis() of the first change since the last write
+      */
+     unsigned long firstChangeTime;
+     
+     /**
+      * @brief millis() of the most recent change
+      */
+     unsigned long lastChangeTime;
+     
      /**
       * @brief Vector of configuration change callbacks
       */
@@ -147,32 +201,140 @@
      
      /**
       * @brief Notify all registered callbacks about configuration changes
-      * @param newConfig The new configuration JSON
       */
-     void notifyConfigChanged(const String& newConfig);
+     void notifyConfigChanged();
+     
+     /**
+      * @brief Record that the document changed and needs writing back
+      */
+     void markDirty();
+     
+     /**
+      * @brief Parse the file into document if a cached boot skipped it
+      * Rebuilds the document from the cached fields if the file cannot be read.
+      */
+     void ensureDocumentLoaded();
+     
+     /**
+      * @brief Replace the peripheral arrays in document with sensorConfigs
+      */
+     void writeSensorConfigsToDocument();
+     
+     /**
+      * @brief Replace the I2C clock limits object in document with i2cClockLimits
+      */
+     void writeI2CClockLimitsToDocument();
+     
+     /**
+      * @brief Read I2C clock limits from a configuration object
+      * Ports that are absent or out of range keep their current limit.
+      * @param limits Object mapping port names ("I2C0", "I2C1") to Hz
+      * @return false if any present value was out of range
+      */
+     bool readI2CClockLimits(JsonObjectConst limits);
+     
+     /**
+      * @brief Read telemetry settings from a configuration object
+      * Absent keys take their defaults.
+      * @param telemetry The "Telemetry" object
+      * @param config [out] Parsed settings
+      * @return false if the protocol, port or interval is invalid
+      */
+     bool readTelemetryConfig(JsonObjectConst telemetry, TelemetryConfig& config);
+     
+     /**
+      * @brief Replace the telemetry object in document with telemetryConfig
+      */
+     void writeTelemetryConfigToDocument();
+     
+     /**
+      * @brief Read task placement from a configuration object
+      * Roles and fields that are absent keep their defaults.
+      * @param tasks The "Tasks" object
+      * @param config [out] Parsed placement
+      * @return true if every given setting is in range
+      */
+     bool readTaskConfig(JsonObjectConst tasks, TaskPlacementConfig& config);
+     
+     /**
+      * @brief Replace the tasks object in document with taskConfig
+      */
+     void writeTaskConfigToDocument();
+     
+     /**
+      * @brief Compute the CRC of the config file contents
+      * @param crc [out] ConfigCache::crc32() of the file
+      * @return true if the file could be read
+      */
+     bool readConfigFileCrc(uint32_t& crc);
      
      /**
       * @brief Helper methods for file operations
       * @{
       */
      bool writeConfigToFile(const JsonDocument& doc);
-     bool readConfigFromFile(JsonDocument& doc);
      /** @} */
 
      /**
       * @brief Convert I2C port string to port number
-      * @param portStr The I2C port string (e.g., "I2C0", "I2C1")
-      * @return The port number (0, 1, etc.)
+      * @param portStr The I2C port string (e.g., "I2C0", "I2C1", "I2C0/mux:3")
+      * @return The port number as an I2CPort value, or -1 if invalid
       */
      int i2cPortStringToNumber(const String& portStr);
 
      /**
       * @brief Convert port number to I2C port string
-      * @param portNum The port number (0, 1, etc.)
-      * @return The I2C port string (e.g., "I2C0", "I2C1")
+      * @param portNum The port number as an I2CPort value
+      * @return The I2C port string (e.g., "I2C0", "I2C1", "I2C0/mux:3")
       */
      String portNumberToI2CString(int portNum);
 
+     /**
+      * @brief Read and validate one peripheral entry
+      * @param peripheral Entry object from a peripheral array
+      * @param type Bus the array is for
+      * @param config [out] Parsed configuration
+      * @return false, having logged why, if the entry is incomplete or invalid
+      */
+     bool readSensorConfig(JsonObjectConst peripheral, CommunicationType type, SensorConfig& config);
+
+     /**
+      * @brief Read a peripheral array one entry at a time
+      * Only the fields of SensorConfig are kept from each entry, and only
+      * one entry is in memory as JSON at any time.
+      * @param reader Reader positioned at the array
+      * @param type Bus the array is for
+      * @param configs [out] Parsed entries, in order
+      * @param others Entries already read from the other array, counted
+      *               against Constants::Sensors::MAX_SENSORS
+      * @return false at the first invalid entry or malformed input
+      */
+     bool readPeripheralArray(JsonStreamReader& reader, CommunicationType type,
+                              std::vector<SensorConfig>& configs, size_t others);
+
+     /**
+      * @brief Reject duplicate names, then replace the sensor configurations
+      * @param configs Validated configurations
+      * @return true if they were applied
+      */
+     bool commitSensorConfigs(const std::vector<SensorConfig>& configs);
+
+     /**
+      * @brief Replace the additional configuration
+      * @param additional Object, string or other value of the "Additional" key
+      * @return true if update succeeded
+      */
+     bool applyAdditionalConfig(JsonVariantConst additional);
+
+     /**
+      * @brief Streaming implementations of the public update methods
+      * @{
+      */
+     bool updateConfigFromReader(JsonStreamReader& reader);
+     bool updateSensorConfigFromReader(JsonStreamReader& reader);
+     bool updateAdditionalConfigFromReader(JsonStreamReader& reader);
+     /** @} */
+
      /**
      * @brief Validate a sensor configuration
      * @param config The sensor configuration to validate
@@ -190,8 +352,9 @@
      
      /**
       * @brief Initialize the configuration manager
-      * Loads the configuration from file or creates a default one
-      * if none exists.
+      * Loads the configuration from the cache if it matches the file,
+      * otherwise from file (creating a default one if none exists) and
+      * refreshes the cache.
       * @return true if initialization succeeded
       */
      bool begin();
@@ -221,6 +384,13 @@
       * @return true if update succeeded
       */
      bool setBoardIdentifier(String identifier);
+     
+     /**
+      * @brief Get the board's additional configuration
+      * Board-wide options such as the power mode are read from it.
+      * @return The "Additional" field of the configuration
+      */
+     String getAdditionalConfig();
      /** @} */
      
      /**
@@ -249,16 +419,32 @@
      
      /**
       * @brief Get complete configuration as JSON
+      * Serialized from memory; includes changes not yet written to flash.
       * @return Configuration JSON string
       */
      String getConfigJson();
      
+     /**
+      * @brief Get a read-only view of the complete configuration
+      * @return View valid until the next configuration change
+      */
+     JsonVariantConst getConfig();
+     
      /**
       * @brief Update configuration from JSON
-      * @param jsonConfig Complete configuration JSON
+      * Parsed in place one section at a time; nothing changes unless the
+      * whole input parses and every peripheral is valid.
+      * @param jsonConfig Complete configuration JSON, e.g. a command line
       * @return true if update succeeded
       */
-     bool updateConfigFromJson(const String& jsonConfig);
+     bool updateConfigFromJson(const char* jsonConfig);
+     
+     /**
+      * @brief Update configuration from JSON read from a stream
+      * @param input Source such as a LittleFS file, read to the end of the object
+      * @return true if update succeeded
+      */
+     bool updateConfigFromJson(Stream& input);
      /** @} */
      
      /**
@@ -268,17 +454,64 @@
      
      /**
       * @brief Update only sensor configuration from JSON
-      * @param jsonConfig Sensor configuration JSON
+      * Peripherals are parsed and validated one at a time, so the memory
+      * used does not grow with the size of the input beyond the parsed
+      * configurations themselves.
+      * @param jsonConfig Sensor configuration JSON, e.g. a command line
       * @return true if update succeeded
       */
-     bool updateSensorConfigFromJson(const String& jsonConfig);
+     bool updateSensorConfigFromJson(const char* jsonConfig);
+     
+     /**
+      * @brief Update only sensor configuration from JSON read from a stream
+      * @param input Source such as a LittleFS file
+      * @return true if update succeeded
+      */
+     bool updateSensorConfigFromJson(Stream& input);
      
      /**
       * @brief Update only additional configuration
       * @param jsonConfig Additional configuration JSON
       * @return true if update succeeded
       */
-     bool updateAdditionalConfigFromJson(const String& jsonConfig);
+     bool updateAdditionalConfigFromJson(const char* jsonConfig);
+     /** @} */
+     
+     /**
+      * @brief Bus settings methods
+      * @{
+      */
+     
+     /**
+      * @brief Get the fastest clock an I2C bus may negotiate
+      * Stored in config.json as "I2C Clock Limits": {"I2C0": 400000, ...}.
+      * @param portNum I2C port number (0, 1)
+      * @return Clock limit in Hz
+      */
+     uint32_t getI2CClockLimit(int portNum) const;
+     
+     /**
+      * @brief Set the fastest clock an I2C bus may negotiate
+      * @param portNum I2C port number (0, 1)
+      * @param clockFreq Clock limit in Hz, within Constants::Sensors::MIN_I2C_CLOCK_FREQ
+      *                  and MAX_I2C_CLOCK_FREQ
+      * @return true if the limit was valid and stored
+      */
+     bool setI2CClockLimit(int portNum, uint32_t clockFreq);
+     
+     /**
+      * @brief Get the network telemetry settings
+      * @return Settings loaded at boot or by the last configuration update
+      */
+     const TelemetryConfig& getTelemetryConfig() const { return telemetryConfig; }
+     
+     /**
+      * @brief Get the configured task placement
+      * Applied when the tasks are created at boot; SYST:TASK:PRI and
+      * SYST:TASK:CORE change the running tasks without touching it.
+      * @return Core, priority and stack of each task role
+      */
+     const TaskPlacementConfig& getTaskConfig() const { return taskConfig; }
      /** @} */
      
      /**
@@ -292,6 +525,47 @@
       */
      void registerChangeCallback(ConfigChangeCallback callback);
      /** @} */
+     
+     /**
+      * @brief Get the boot cache
+      * Also holds the last-known-good I2C topology used by SensorManager.
+      * @return Reference to the cache
+      */
+     ConfigCache& getCache() { return cache; }
+     
+     /**
+      * @brief Write-back persistence
+      * @{
+      */
+     
+     /**
+      * @brief Check for changes not yet written to flash
+      * @return true if the file is behind the in-memory configuration
+      */
+     bool isDirty() const { return dirty; }
+     
+     /**
+      * @brief Get the time until flushIfDue() would write
+      * @return Milliseconds until the write is due, or UINT32_MAX if nothing is pending
+      */
+     uint32_t msUntilFlushDue() const;
+     
+     /**
+      * @brief Write pending changes if they have settled or waited too long
+      * Writes once no change has arrived for Constants::Config::WRITE_DEBOUNCE_MS,
+      * or Constants::Config::WRITE_MAX_DELAY_MS after the first unsaved change.
+      * Call periodically from the task that owns the configuration.
+      * @return false only if a write was attempted and failed
+      */
+     bool flushIfDue();
+     
+     /**
+      * @brief Write pending changes now
+      * Use before a restart.
+      * @return true if the file is up to date
+      */
+     bool flush();
+     /** @} */
  };
  
  /** @} */ // End of configuration group
\ No newline at end of file
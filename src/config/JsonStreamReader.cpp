@@ -0,0 +1,251 @@
+#include "JsonStreamReader.h"
+
+namespace {
+    // Numbers and literals; JSON has no longer scalar worth keeping
+    const size_t MAX_SCALAR_LENGTH = 32;
+
+    bool isJsonSpace(int c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+}
+
+JsonStreamReader::JsonStreamReader(const char* json)
+    : text(json ? json : ""), stream(nullptr), pending(-1), afterValue(false), error(nullptr) {
+}
+
+JsonStreamReader::JsonStreamReader(Stream& input)
+    : text(nullptr), stream(&input), pending(-1), afterValue(false), error(nullptr) {
+}
+
+int JsonStreamReader::read() {
+    if (pending >= 0) {
+        int c = pending;
+        pending = -1;
+        return c;
+    }
+    if (stream) {
+        return stream->read();
+    }
+    return *text ? static_cast<uint8_t>(*text++) : -1;
+}
+
+size_t JsonStreamReader::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+int JsonStreamReader::peek() {
+    if (pending < 0) {
+        pending = read();
+    }
+    return pending;
+}
+
+int JsonStreamReader::peekSignificant() {
+    while (isJsonSpace(peek())) {
+        read();
+    }
+    return peek();
+}
+
+bool JsonStreamReader::fail(const char* message) {
+    if (!error) {
+        error = message;
+    }
+    return false;
+}
+
+bool JsonStreamReader::enterObject() {
+    int c;
+    do {
+        c = read();
+        if (c < 0) {
+            return fail("No JSON object found");
+        }
+    } while (c != '{');
+    afterValue = false;
+    return true;
+}
+
+bool JsonStreamReader::nextItem(char close) {
+    if (failed()) {
+        return false;
+    }
+    int c = peekSignificant();
+    if (afterValue) {
+        if (c == close) {
+            read();
+            return false;
+        }
+        if (c != ',') {
+            return fail("Expected ',' between values");
+        }
+        read();
+        c = peekSignificant();
+        if (c == close) {
+            return fail("Trailing ',' before end of object or array");
+        }
+    } else if (c == close) {
+        // Empty object or array; the enclosing level continues after a value
+        read();
+        afterValue = true;
+        return false;
+    }
+    if (c < 0) {
+        return fail("Incomplete input");
+    }
+    return true;
+}
+
+bool JsonStreamReader::nextMember(char (&key)[MAX_KEY_LENGTH + 1]) {
+    key[0] = '\0';
+    if (!nextItem('}')) {
+        return false;
+    }
+    if (read() != '"') {
+        return fail("Expected a member name");
+    }
+    size_t length = 0;
+    bool truncated = false;
+    for (;;) {
+        int c = read();
+        if (c == '\\') {
+            c = read();
+        } else if (c == '"') {
+            break;
+        }
+        if (c < 0) {
+            return fail("Unterminated member name");
+        }
+        if (length < MAX_KEY_LENGTH) {
+            key[length++] = static_cast<char>(c);
+        } else {
+            truncated = true;
+        }
+    }
+    key[truncated ? 0 : length] = '\0';
+    if (peekSignificant() != ':') {
+        return fail("Expected ':' after member name");
+    }
+    read();
+    return true;
+}
+
+bool JsonStreamReader::enterArray() {
+    if (failed()) {
+        return false;
+    }
+    if (peekSignificant() != '[') {
+        return fail("Expected an array");
+    }
+    read();
+    afterValue = false;
+    return true;
+}
+
+bool JsonStreamReader::nextElement() {
+    return nextItem(']');
+}
+
+bool JsonStreamReader::readValue(JsonDocument& doc, JsonVariantConst filter) {
+    if (failed()) {
+        return false;
+    }
+    DeserializationError result;
+    int c = peekSignificant();
+    if (c == '{' || c == '[' || c == '"') {
+        // ArduinoJson stops at the closing character, leaving the reader on what follows
+        result = filter.isNull() ? deserializeJson(doc, *this)
+                                 : deserializeJson(doc, *this, DeserializationOption::Filter(filter));
+    } else {
+        char token[MAX_SCALAR_LENGTH + 1];
+        if (!scanScalar(token, sizeof(token))) {
+            return false;
+        }
+        result = deserializeJson(doc, static_cast<const char*>(token));
+    }
+    if (result) {
+        return fail(result.c_str());
+    }
+    if (doc.overflowed()) {
+        return fail("Value too large for available memory");
+    }
+    afterValue = true;
+    return true;
+}
+
+bool JsonStreamReader::skipValue() {
+    if (failed()) {
+        return false;
+    }
+    int c = peekSignificant();
+    if (c == '"') {
+        read();
+        if (!skipString()) {
+            return false;
+        }
+    } else if (c == '{' || c == '[') {
+        int depth = 0;
+        do {
+            c = read();
+            if (c < 0) {
+                return fail("Incomplete input");
+            }
+            if (c == '"') {
+                if (!skipString()) {
+                    return false;
+                }
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                depth--;
+            }
+        } while (depth > 0);
+    } else if (!scanScalar(nullptr, 0)) {
+        return false;
+    }
+    afterValue = true;
+    return true;
+}
+
+bool JsonStreamReader::skipString() {
+    for (;;) {
+        int c = read();
+        if (c == '\\') {
+            c = read();
+        } else if (c == '"') {
+            return true;
+        }
+        if (c < 0) {
+            return fail("Unterminated string");
+        }
+    }
+}
+
+bool JsonStreamReader::scanScalar(char* buffer, size_t size) {
+    size_t length = 0;
+    for (int c = peek(); c >= 0 && c != ',' && c != '}' && c != ']' && !isJsonSpace(c); c = peek()) {
+        if (buffer) {
+            if (length + 1 >= size) {
+                return fail("Value too long");
+            }
+            buffer[length] = static_cast<char>(c);
+        }
+        length++;
+        read();
+    }
+    if (length == 0) {
+        return fail("Expected a value");
+    }
+    if (buffer) {
+        buffer[length] = '\0';
+    }
+    return true;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file JsonStreamReader.h
+ * @brief Incremental walker over a JSON configuration object
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup configuration
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <ArduinoJson.h>
+
+ /**
+  * @brief Walks the members of a JSON object without holding it in memory
+  * Reads from a NUL-terminated buffer (a command line) or a Stream (a
+  * LittleFS file) one character at a time. The caller steps through the
+  * top-level members and array elements and hands each value it wants to
+  * ArduinoJson on its own, so only one member or one array element is
+  * ever parsed at a time; values it does not want are skipped without
+  * being stored.
+  *
+  * It also implements ArduinoJson's reader interface (read() and
+  * readBytes()), which is how values are handed over. ArduinoJson stops
+  * right after the closing character of an object, array or string, so
+  * the walk continues where the value ended; scalars, whose end is only
+  * known from the character after them, are scanned here instead.
+  */
+ class JsonStreamReader {
+ public:
+     /**
+      * @brief Longest member name matched, in characters
+      * Longer names are reported as empty so they match no known key.
+      */
+     static const size_t MAX_KEY_LENGTH = 31;
+
+     /**
+      * @brief Read from a NUL-terminated buffer
+      * @param json Buffer, which must outlive the reader
+      */
+     explicit JsonStreamReader(const char* json);
+
+     /**
+      * @brief Read from a stream until it reports no more data
+      * @param input Stream, which must outlive the reader
+      */
+     explicit JsonStreamReader(Stream& input);
+
+     /**
+      * @brief Enter the top-level object
+      * Anything before the first '{' is skipped, like the prefix of a
+      * command line.
+      * @return true if an object starts
+      */
+     bool enterObject();
+
+     /**
+      * @brief Advance to the next member of the current object
+      * @param key [out] Member name, NUL-terminated, "" if too long
+      * @return true positioned at the member's value, false at the end of
+      *         the object or on malformed input (see failed())
+      */
+     bool nextMember(char (&key)[MAX_KEY_LENGTH + 1]);
+
+     /**
+      * @brief Enter an array value
+      * @return true if the value is an array
+      */
+     bool enterArray();
+
+     /**
+      * @brief Advance to the next element of the current array
+      * @return true positioned at the element, false at the end of the
+      *         array or on malformed input (see failed())
+      */
+     bool nextElement();
+
+     /**
+      * @brief Parse the current value into a document
+      * @param doc [out] Document, cleared first
+      * @param filter Optional ArduinoJson filter; parts it rejects are
+      *               parsed but not stored
+      * @return true if the value parsed and fit in memory
+      */
+     bool readValue(JsonDocument& doc, JsonVariantConst filter = JsonVariantConst());
+
+     /**
+      * @brief Skip the current value without storing it
+      * @return true if the value was well-formed
+      */
+     bool skipValue();
+
+     /**
+      * @brief Whether the input was malformed
+      * @return true once any step has failed; every later step fails too
+      */
+     bool failed() const { return error != nullptr; }
+
+     /**
+      * @brief Describe the first failure
+      * @return Message, or "" if nothing has failed
+      */
+     const char* errorMessage() const { return error ? error : ""; }
+
+     /**
+      * @brief Read one character, for ArduinoJson
+      * @return Character, or -1 at the end of the input
+      */
+     int read();
+
+     /**
+      * @brief Read a block of characters, for ArduinoJson
+      * @param buffer [out] Destination
+      * @param length Most characters to read
+      * @return Characters read
+      */
+     size_t readBytes(char* buffer, size_t length);
+
+ private:
+     const char* text;        ///< Buffer source, or nullptr
+     Stream* stream;          ///< Stream source, or nullptr
+     int pending;             ///< Character peeked but not consumed, -1 if none
+     bool afterValue;         ///< A value ended at this level, so ',' or a close comes next
+     const char* error;       ///< First failure, or nullptr
+
+     int peek();
+     int peekSignificant();
+     bool fail(const char* message);
+     bool nextItem(char close);
+     bool skipString();
+     bool scanScalar(char* buffer, size_t size);
+ };
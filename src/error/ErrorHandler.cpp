@@ -1,5 +1,8 @@
 #include "ErrorHandler.h"
 #include "managers/LedManager.h"
+#include <esp_heap_caps.h>
+#include <algorithm>
+#include <cstring>
 
 ErrorHandler::ErrorHandler(Print* output, Print* debugOutput) 
   : defaultOutput(output),
@@ -13,6 +16,25 @@ ErrorHandler::ErrorHandler(Print* output, Print* debugOutput)
   // Initialize UART output configuration
   uartOutput.stream = debugOutput;
   uartOutput.minSeverity = INFO;   // Default: UART gets everything
+  
+  // Preallocate the history; PSRAM holds a long one, internal RAM a short one
+  historyDepth = Constants::Logging::HISTORY_DEPTH;
+  history = static_cast<LogHistoryEntry*>(heap_caps_malloc(historyDepth * sizeof(LogHistoryEntry),
+                                                           MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  historyInPsram = history != nullptr;
+  if (!history) {
+    historyDepth = Constants::Logging::HISTORY_DEPTH_INTERNAL;
+    history = static_cast<LogHistoryEntry*>(malloc(historyDepth * sizeof(LogHistoryEntry)));
+  }
+  if (!history) {
+    historyDepth = 0;
+  }
+}
+
+ErrorHandler::~ErrorHandler() {
+  if (history) {
+    heap_caps_free(history);
+  }
 }
 
 void ErrorHandler::setOutputSeverity(Print* output, ErrorSeverity minSeverity) {
@@ -33,21 +55,93 @@ void ErrorHandler::enableCustomRouting(bool enable) {
   useCustomRouting = enable;
 }
 
+bool ErrorHandler::isEnabled(ErrorSeverity severity) const {
+  if (severity >= WARNING) {
+    return true;
+  }
+  // The default output shows everything, directly or as the routing fallback
+  if (defaultOutput != nullptr) {
+    return true;
+  }
+  if (!useCustomRouting) {
+    return false;
+  }
+  return (usbOutput.stream != nullptr && severity >= usbOutput.minSeverity) ||
+         (uartOutput.stream != nullptr && severity >= uartOutput.minSeverity);
+}
+
 bool ErrorHandler::logError(ErrorSeverity severity, String message) {
-  // Create new error entry
-  ErrorEntry entry;
-  entry.severity = severity;
-  entry.message = message;
-  entry.timestamp = millis();
+  if (!isEnabled(severity)) {
+    return false;
+  }
+  
+  // Deferred: copy the text into a record for the log task
+  if (isAsync() && severity != FATAL) {
+    LogRecord record;
+    record.timestamp = millis();
+    record.severity = static_cast<uint8_t>(severity);
+    record.setMessage(std::string_view(message.c_str(), message.length()));
+    return submitRecord(record);
+  }
+  
+  unsigned long timestamp = millis();
+  rememberEntry(severity, message.c_str(), timestamp);
+  indicateSeverity(severity);
+  writeLine(severity, timestamp, message.c_str());
+  
+  // Return true if this was a FATAL error, allowing the caller to take action
+  return (severity == FATAL);
+}
+
+bool ErrorHandler::submitRecord(const LogRecord& record) {
+  ErrorSeverity severity = static_cast<ErrorSeverity>(record.severity);
+  indicateSeverity(severity);
   
-  // Manage log size
-  if (errorLog.size() >= MAX_LOG_SIZE) {
-    errorLog.erase(errorLog.begin());
+  TaskHandle_t task = logTask.load();
+  if (task == nullptr || severity == FATAL) {
+    emitRecord(record);
+  } else if (logQueue.tryPush(record)) {
+    xTaskNotifyGive(task);
+  } else {
+    // Never block the caller; the log task reports the gap
+    droppedRecords.fetch_add(1);
   }
   
-  // Add to log
-  errorLog.push_back(entry);
+  return (severity == FATAL);
+}
+
+void ErrorHandler::emitRecord(const LogRecord& record) {
+  char message[Constants::Logging::LINE_BUFFER_SIZE];
+  record.render(message, sizeof(message));
   
+  ErrorSeverity severity = static_cast<ErrorSeverity>(record.severity);
+  rememberEntry(severity, message, record.timestamp);
+  writeLine(severity, record.timestamp, message);
+}
+
+void ErrorHandler::setLogTask(TaskHandle_t task) {
+  logTask.store(task);
+}
+
+size_t ErrorHandler::processLogQueue(size_t maxRecords) {
+  size_t processed = 0;
+  LogRecord record;
+  while (processed < maxRecords && logQueue.tryPop(record)) {
+    emitRecord(record);
+    processed++;
+  }
+  
+  uint32_t dropped = droppedRecords.exchange(0);
+  if (dropped > 0) {
+    char message[48];
+    snprintf(message, sizeof(message), "%lu log messages dropped (queue full)", (unsigned long)dropped);
+    writeLine(WARNING, millis(), message);
+  }
+  
+  return processed;
+}
+
+void ErrorHandler::indicateSeverity(ErrorSeverity severity) {
   // Trigger LED indication if LED manager is available
   if (ledManager) {
     switch (severity) {
@@ -65,61 +159,135 @@ bool ErrorHandler::logError(ErrorSeverity severity, String message) {
         break;
     }
   }
+}
+
+void ErrorHandler::rememberEntry(ErrorSeverity severity, const char* message, unsigned long timestamp) {
+  if (historyDepth == 0) {
+    return;
+  }
+  
+  // Prepare outside the lock; the copy into the ring is a fixed-size memcpy
+  LogHistoryEntry entry;
+  entry.timestamp = timestamp;
+  entry.severity = static_cast<uint8_t>(severity);
+  strncpy(entry.message, message, sizeof(entry.message) - 1);
+  entry.message[sizeof(entry.message) - 1] = '\0';
+  
+  portENTER_CRITICAL(&historyMux);
+  entry.sequence = historyWritten + 1;
+  memcpy(&history[historyWritten % historyDepth], &entry, sizeof(entry));
+  historyWritten = entry.sequence;
+  portEXIT_CRITICAL(&historyMux);
+}
+
+bool ErrorHandler::copyLatestEntry(LogHistoryEntry& out) const {
+  bool found = false;
+  portENTER_CRITICAL(&historyMux);
+  if (historyWritten > 0 && historyDepth > 0) {
+    memcpy(&out, &history[(historyWritten - 1) % historyDepth], sizeof(out));
+    found = true;
+  }
+  portEXIT_CRITICAL(&historyMux);
+  return found;
+}
+
+uint32_t ErrorHandler::getLatestSequence() const {
+  portENTER_CRITICAL(&historyMux);
+  uint32_t latest = historyWritten;
+  portEXIT_CRITICAL(&historyMux);
+  return latest;
+}
+
+size_t ErrorHandler::fetchHistory(uint32_t afterSequence, size_t maxEntries, const HistoryVisitor& visitor) const {
+  size_t visited = 0;
+  uint32_t next = afterSequence + 1;
+  LogHistoryEntry entry;
+  
+  while (visited < maxEntries) {
+    // Copy one entry at a time so writers are never held up for long
+    bool available = false;
+    portENTER_CRITICAL(&historyMux);
+    if (historyDepth > 0 && next <= historyWritten) {
+      uint32_t oldest = historyWritten > historyDepth ? historyWritten - historyDepth + 1 : 1;
+      if (next < oldest) {
+        next = oldest; // Older entries were overwritten
+      }
+      memcpy(&entry, &history[(next - 1) % historyDepth], sizeof(entry));
+      available = true;
+    }
+    portEXIT_CRITICAL(&historyMux);
+    
+    if (!available) {
+      break;
+    }
+    visitor(entry);
+    visited++;
+    next = entry.sequence + 1;
+  }
   
-  // Format the message with severity and timestamp
-  unsigned long currentTime = millis();
-  float seconds = currentTime / 1000.0;
-  String severityStr = severityToString(severity);
-  String formattedMessage = "[" + String(seconds, 3) + "s][" + severityStr + "] " + message;
+  return visited;
+}
+
+void ErrorHandler::writeLine(ErrorSeverity severity, unsigned long timestamp, const char* message) {
+  // Format the prefix with timestamp and severity
+  char prefix[32];
+  snprintf(prefix, sizeof(prefix), "[%lu.%03lus][%s] ", timestamp / 1000, timestamp % 1000, severityName(severity));
+  
+  auto writeTo = [&](Print* stream) {
+    stream->print(prefix);
+    stream->println(message);
+  };
   
   // Route message based on severity and configuration
   if (!useCustomRouting) {
     // If custom routing is disabled, send all messages to default output
     if (defaultOutput != nullptr) {
-      defaultOutput->println(formattedMessage);
-    }
-  } else {
-    // Custom routing - check each configured output
-    bool messageSent = false;
-    
-    // Check USB output
-    if (usbOutput.stream != nullptr && severity >= usbOutput.minSeverity) {
-      try {
-        usbOutput.stream->println(formattedMessage);
-        messageSent = true;
-      } catch (...) {
-        // If writing fails, disable this output
-        usbOutput.stream = nullptr;
-      }
+      writeTo(defaultOutput);
     }
-    
-    // Check UART output
-    if (uartOutput.stream != nullptr && severity >= uartOutput.minSeverity) {
-      try {
-        uartOutput.stream->println(formattedMessage);
-        messageSent = true;
-      } catch (...) {
-        // If writing fails, disable this output
-        uartOutput.stream = nullptr;
-      }
+    return;
+  }
+  
+  // Custom routing - check each configured output
+  bool messageSent = false;
+  
+  // Check USB output
+  if (usbOutput.stream != nullptr && severity >= usbOutput.minSeverity) {
+    try {
+      writeTo(usbOutput.stream);
+      messageSent = true;
+    } catch (...) {
+      // If writing fails, disable this output
+      usbOutput.stream = nullptr;
     }
-    
-    // If no output received the message but defaultOutput exists, use it as fallback
-    if (!messageSent && defaultOutput != nullptr) {
-      try {
-        defaultOutput->println(formattedMessage);
-      } catch (...) {
-        // If even this fails, disable default output
-        defaultOutput = nullptr;
-      }
+  }
+  
+  // Check UART output
+  if (uartOutput.stream != nullptr && severity >= uartOutput.minSeverity) {
+    try {
+      writeTo(uartOutput.stream);
+      messageSent = true;
+    } catch (...) {
+      // If writing fails, disable this output
+      uartOutput.stream = nullptr;
     }
   }
   
-  // Return true if this was a FATAL error, allowing the caller to take action
-  return (severity == FATAL);
+  // If no output received the message but defaultOutput exists, use it as fallback
+  if (!messageSent && defaultOutput != nullptr) {
+    try {
+      writeTo(defaultOutput);
+    } catch (...) {
+      // If even this fails, disable default output
+      defaultOutput = nullptr;
+    }
+  }
 }
 
 String ErrorHandler::severityToString(ErrorSeverity severity) {
+  return severityName(severity);
+}
+
+const char* ErrorHandler::severityName(ErrorSeverity severity) {
   switch (severity) {
     case INFO: return "INFO";
     case WARNING: return "WARNING";
@@ -153,22 +321,29 @@ String ErrorHandler::getRoutingStatus() const {
             (uartOutput.stream ? "Enabled (min severity: " + severityToString(uartOutput.minSeverity) + ")" : "Disabled") + 
             "\n";
   
+  status += "Logging: " + String(isAsync() ? "Deferred" : "Synchronous") + "\n";
+  
   // Add statistics
-  status += "Log entries: " + String(errorLog.size()) + "\n";
+  uint32_t written = getLatestSequence();
+  status += "Log entries: " + String(std::min<size_t>(written, historyDepth)) + " of " + String(historyDepth) +
+            (historyInPsram ? " (PSRAM)" : " (internal RAM)") + ", latest sequence " + String(written) + "\n";
+  status += "Dropped messages: " + String(getDroppedCount()) + "\n";
   
   return status;
 }
 
 ErrorSeverity ErrorHandler::getLastSeverity() const {
-    if (errorLog.empty()) {
+    LogHistoryEntry entry;
+    if (!copyLatestEntry(entry)) {
         return INFO;  // Default to INFO if no errors
     }
-    return errorLog.back().severity;
+    return static_cast<ErrorSeverity>(entry.severity);
 }
 
 String ErrorHandler::getLastMessage() const {
-    if (errorLog.empty()) {
+    LogHistoryEntry entry;
+    if (!copyLatestEntry(entry)) {
         return "";  // Return empty string if no errors
     }
-    return errorLog.back().message;
+    return String(entry.message);
 }
\ No newline at end of file
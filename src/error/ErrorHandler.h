@@ -11,11 +11,27 @@
  #pragma once
 
  #include <Arduino.h>
- #include <vector>
+ #include <atomic>
+ #include <functional>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
+ #include "Constants.h"
+ #include "LogRecord.h"
+ #include "LogQueue.h"
  
  // Forward declaration to avoid circular dependency
  class LedManager;
  
+ /**
+  * @brief Lowest severity compiled into the image
+  * Log macro calls below this level are removed at compile time, including
+  * their arguments. Production images build with -DLOG_MIN_SEVERITY=1 to
+  * drop every INFO message.
+  */
+ #ifndef LOG_MIN_SEVERITY
+ #define LOG_MIN_SEVERITY 0
+ #endif
+ 
  /**
   * @brief Error severity levels
   * Defines the different severity levels for error messages,
@@ -39,6 +55,18 @@
    unsigned long timestamp;    ///< Timestamp when error occurred (millis)
  };
  
+ /**
+  * @brief Fixed-size entry of the log history
+  * The message is stored inline (truncated to fit), so the history never
+  * touches the heap after it is allocated.
+  */
+ struct LogHistoryEntry {
+   uint32_t sequence;          ///< Sequence number, starting at 1
+   uint32_t timestamp;         ///< Timestamp when the message was logged (millis)
+   uint8_t severity;           ///< ErrorSeverity of the message
+   char message[Constants::Logging::HISTORY_MESSAGE_SIZE];  ///< Null-terminated message text
+ };
+ 
  /**
   * @brief Structure to hold output configuration
   * Configures an output stream with the minimum severity level
@@ -56,18 +84,40 @@
   * - Multiple configurable output streams with severity filtering
   * - Visual indication of errors via LED
   * - Customizable error routing for different destinations
+  * - Deferred logging: once a log task is attached, callers only capture a
+  *   compact record into a lock-free queue and the log task formats and
+  *   writes it, so sensor and command paths never block on serial output
   */
  class ErrorHandler {
  private:
    /**
-    * @brief Vector of recent error entries
+    * @brief Ring of recent log messages
+    * Preallocated once, in PSRAM when available. Every message that is
+    * emitted gets an entry and a sequence number so a host can read the
+    * history incrementally.
+    * @{
+    */
+   LogHistoryEntry* history = nullptr;              ///< Ring storage
+   size_t historyDepth = 0;                         ///< Entries in the ring (0 if allocation failed)
+   bool historyInPsram = false;                     ///< Ring was allocated from PSRAM
+   uint32_t historyWritten = 0;                     ///< Entries ever appended (= latest sequence)
+   mutable portMUX_TYPE historyMux = portMUX_INITIALIZER_UNLOCKED;  ///< Guards history and historyWritten
+   /** @} */
+   
+   /**
+    * @brief Records waiting for the log task
+    */
+   MpscRing<LogRecord, Constants::Logging::QUEUE_DEPTH> logQueue;
+   
+   /**
+    * @brief Task draining logQueue; nullptr while logging synchronously
     */
-   std::vector<ErrorEntry> errorLog;
+   std::atomic<TaskHandle_t> logTask{nullptr};
    
    /**
-    * @brief Maximum number of log entries to store
+    * @brief Records discarded because logQueue was full
     */
-   const int MAX_LOG_SIZE = 20;
+   std::atomic<uint32_t> droppedRecords{0};
    
    /**
     * @brief Default output stream (backward compatibility)
@@ -97,6 +147,50 @@
     */
    bool useCustomRouting;
    
+   /**
+    * @brief Show the severity on the LED, if one is attached
+    * @param severity Severity of the message
+    */
+   void indicateSeverity(ErrorSeverity severity);
+   
+   /**
+    * @brief Append an entry to the recent error ring
+    * @param severity Severity of the message
+    * @param message Message text
+    * @param timestamp Capture time (millis)
+    */
+   void rememberEntry(ErrorSeverity severity, const char* message, unsigned long timestamp);
+   
+   /**
+    * @brief Copy the most recent history entry
+    * @param out [out] The entry
+    * @return false if nothing has been logged
+    */
+   bool copyLatestEntry(LogHistoryEntry& out) const;
+   
+   /**
+    * @brief Write one message to every output its severity is routed to
+    * @param severity Severity of the message
+    * @param timestamp Capture time (millis), shown as seconds
+    * @param message Message text
+    */
+   void writeLine(ErrorSeverity severity, unsigned long timestamp, const char* message);
+   
+   /**
+    * @brief Format, remember and write a captured record
+    * @param record Record to emit
+    */
+   void emitRecord(const LogRecord& record);
+   
+   /**
+    * @brief Hand a record to the log task, or emit it now if logging synchronously
+    * FATAL records are always emitted immediately so they are seen before
+    * the caller halts or resets.
+    * @param record Captured record
+    * @return true if the record was FATAL
+    */
+   bool submitRecord(const LogRecord& record);
+   
  public:
     /**
      * @brief Get the current message routing configuration status
@@ -116,6 +210,14 @@
     */
    ErrorHandler(Print* output = nullptr, Print* debugOutput = nullptr);
    
+   /**
+    * @brief Destructor - releases the log history
+    */
+   ~ErrorHandler();
+   
+   ErrorHandler(const ErrorHandler&) = delete;
+   ErrorHandler& operator=(const ErrorHandler&) = delete;
+   
    /**
     * @brief Set the minimum severity level for a specific output stream
     * @param output The output stream to configure
@@ -148,6 +250,77 @@
     */
    bool logError(ErrorSeverity severity, String message);
    
+   /**
+    * @brief Log a printf-style message without formatting it on the caller
+    * The format string must have static storage duration; it is kept by
+    * pointer and formatted later by the log task. Up to
+    * LogRecord::MAX_ARGS integer, floating point or string arguments are
+    * captured; strings are copied. Nothing is allocated, and if no output
+    * would show the message it is discarded before anything is captured.
+    * @param severity The severity level (INFO, WARNING, ERROR, FATAL)
+    * @param format Static printf-style format string
+    * @param args Format arguments
+    * @return true if a FATAL error was logged (for caller to take action)
+    */
+   /**
+    * @brief Log a printf-style message; same as logFormatted()
+    * Lets the LOG_* macros take either a single message or a format
+    * string followed by arguments.
+    */
+   template <typename First, typename... Rest>
+   bool logError(ErrorSeverity severity, const char* format, const First& first, const Rest&... rest) {
+     return logFormatted(severity, format, first, rest...);
+   }
+   
+   template <typename... Args>
+   bool logFormatted(ErrorSeverity severity, const char* format, const Args&... args) {
+     if (!isEnabled(severity)) {
+       return false;
+     }
+     LogRecord record;
+     record.timestamp = millis();
+     record.severity = static_cast<uint8_t>(severity);
+     record.format = format;
+     (record.addArg(args), ...);
+     return submitRecord(record);
+   }
+   
+   /**
+    * @brief Check whether a message of this severity has any effect
+    * WARNING and above are always kept for the LED and the recent error
+    * list; INFO is only worth capturing if some output would print it.
+    * @param severity Severity to check
+    * @return true if a message of this severity should be captured
+    */
+   bool isEnabled(ErrorSeverity severity) const;
+   
+   /**
+    * @brief Attach the task that drains the log queue
+    * While a task is attached, logError() and logFormatted() only queue
+    * records; pass nullptr to return to synchronous logging.
+    * @param task Log task handle, or nullptr
+    */
+   void setLogTask(TaskHandle_t task);
+   
+   /**
+    * @brief Check whether logging is deferred to a log task
+    * @return true if a log task is attached
+    */
+   bool isAsync() const { return logTask.load() != nullptr; }
+   
+   /**
+    * @brief Format and write queued records (log task only)
+    * @param maxRecords Maximum number of records to process
+    * @return Number of records processed
+    */
+   size_t processLogQueue(size_t maxRecords = Constants::Logging::QUEUE_DEPTH);
+   
+   /**
+    * @brief Get the number of records dropped because the queue was full
+    * @return Dropped record count since the last drop report
+    */
+   uint32_t getDroppedCount() const { return droppedRecords.load(); }
+   
    /**
     * @brief Convert severity level to string
     * @param severity The severity level
@@ -155,6 +328,13 @@
     */
    static String severityToString(ErrorSeverity severity);
    
+   /**
+    * @brief Get the name of a severity level without allocating
+    * @param severity The severity level
+    * @return Static name of the severity
+    */
+   static const char* severityName(ErrorSeverity severity);
+   
    /**
     * @brief Convert string to severity level
     * @param severityStr The severity string
@@ -173,6 +353,66 @@
    * @return The message of the last logged error, or empty string if no errors
    */
   String getLastMessage() const;
+  
+  /**
+   * @brief Callback invoked for each entry returned by fetchHistory()
+   */
+  typedef std::function<void(const LogHistoryEntry&)> HistoryVisitor;
+  
+  /**
+   * @brief Visit logged messages newer than a sequence number, oldest first
+   * Entries already overwritten by newer ones are skipped, which shows as
+   * a gap in the sequence numbers.
+   * @param afterSequence Only entries with a larger sequence are returned
+   * @param maxEntries Maximum number of entries to visit
+   * @param visitor Callback for each entry (called outside the lock)
+   * @return Number of entries visited
+   */
+  size_t fetchHistory(uint32_t afterSequence, size_t maxEntries, const HistoryVisitor& visitor) const;
+  
+  /**
+   * @brief Get the sequence number of the most recent history entry
+   * @return Latest sequence (0 if nothing has been logged)
+   */
+  uint32_t getLatestSequence() const;
+  
+  /**
+   * @brief Get the capacity of the log history
+   * @return Number of entries kept
+   */
+  size_t getHistoryDepth() const { return historyDepth; }
+  
+  /**
+   * @brief Get the size of the log history storage
+   * @return Bytes allocated for the ring
+   */
+  size_t getHistoryBytes() const { return historyDepth * sizeof(LogHistoryEntry); }
+  
+  /**
+   * @brief Check whether the log history lives in PSRAM
+   * @return true if PSRAM was used
+   */
+  bool isHistoryInPsram() const { return historyInPsram; }
  };
  
- /** @} */ // End of error_handling group
\ No newline at end of file
+  /**
+  * @name Logging macros
+  * Check the severity before the message is built: if the level is compiled
+  * out or no output would show it, the arguments are never evaluated, so a
+  * message like "Reading " + name costs nothing on an idle route. Accept a
+  * single message or a printf-style format with arguments.
+  * @{
+  */
+ #define LOG_AT(handler, severity, ...) \
+   do { \
+     if ((severity) >= LOG_MIN_SEVERITY && (handler) != nullptr && (handler)->isEnabled(severity)) { \
+       (handler)->logError((severity), __VA_ARGS__); \
+     } \
+   } while (0)
+ 
+ #define LOG_INFO(handler, ...) LOG_AT(handler, INFO, __VA_ARGS__)
+ #define LOG_WARNING(handler, ...) LOG_AT(handler, WARNING, __VA_ARGS__)
+ #define LOG_ERROR(handler, ...) LOG_AT(handler, ERROR, __VA_ARGS__)
+ /** @} */
+ 
+ /** @} */ // End of error_handling group
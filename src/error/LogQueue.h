@@ -0,0 +1,98 @@
+/**
+ * @file LogQueue.h
+ * @brief Lock-free bounded multi-producer single-consumer ring buffer
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup error_handling
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <stddef.h>
+ #include <stdint.h>
+
+ /**
+  * @brief Bounded MPSC queue of fixed-size records
+  * Each cell carries a sequence number that tells producers whether it is
+  * free and tells the consumer whether it has been published. Producers
+  * claim a position with one compare-and-swap and never wait: if the ring
+  * is full, tryPush() fails and the caller drops the record. Safe to use
+  * from tasks on both cores; not from interrupt handlers.
+  * @tparam T Record type (copied in and out)
+  * @tparam N Capacity, a power of two
+  */
+ template <typename T, size_t N>
+ class MpscRing {
+     static_assert(N >= 2 && (N & (N - 1)) == 0, "Capacity must be a power of two");
+
+ public:
+     MpscRing() : enqueuePos(0), dequeuePos(0) {
+         for (size_t i = 0; i < N; i++) {
+             cells[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+         }
+     }
+
+     MpscRing(const MpscRing&) = delete;
+     MpscRing& operator=(const MpscRing&) = delete;
+
+     /**
+      * @brief Append a record
+      * @param value Record to copy into the ring
+      * @return false if the ring is full
+      */
+     bool tryPush(const T& value) {
+         uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+         Cell* cell;
+         while (true) {
+             cell = &cells[pos & (N - 1)];
+             uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+             int32_t diff = static_cast<int32_t>(seq - pos);
+             if (diff == 0) {
+                 if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                     break;
+                 }
+             } else if (diff < 0) {
+                 return false; // Full
+             } else {
+                 pos = enqueuePos.load(std::memory_order_relaxed);
+             }
+         }
+         cell->value = value;
+         cell->sequence.store(pos + 1, std::memory_order_release);
+         return true;
+     }
+
+     /**
+      * @brief Remove the oldest record (consumer only)
+      * @param value [out] The record
+      * @return false if no published record is available
+      */
+     bool tryPop(T& value) {
+         Cell* cell = &cells[dequeuePos & (N - 1)];
+         uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+         if (static_cast<int32_t>(seq - (dequeuePos + 1)) < 0) {
+             return false;
+         }
+         value = cell->value;
+         cell->sequence.store(dequeuePos + N, std::memory_order_release);
+         dequeuePos++;
+         return true;
+     }
+
+     /**
+      * @brief Get the capacity
+      * @return Number of cells
+      */
+     static constexpr size_t capacity() { return N; }
+
+ private:
+     struct Cell {
+         std::atomic<uint32_t> sequence;   ///< Position this cell is ready for
+         T value;                          ///< Stored record
+     };
+
+     Cell cells[N];                        ///< Ring storage
+     std::atomic<uint32_t> enqueuePos;     ///< Next position producers claim
+     uint32_t dequeuePos;                  ///< Next position the consumer reads
+ };
@@ -0,0 +1,91 @@
+#include "LogRecord.h"
+#include <cstring>
+
+namespace {
+    bool isConversion(char c) {
+        return strchr("diuxXocsfFeEgG", c) != nullptr;
+    }
+
+    bool isLengthModifier(char c) {
+        return c == 'l' || c == 'h' || c == 'z' || c == 'j' || c == 't' || c == 'L';
+    }
+}
+
+size_t LogRecord::render(char* out, size_t size) const {
+    if (size == 0) {
+        return 0;
+    }
+    if (!format) {
+        size_t length = std::min(strlen(text), size - 1);
+        memcpy(out, text, length);
+        out[length] = '\0';
+        return length;
+    }
+
+    size_t used = 0;
+    size_t arg = 0;
+    auto append = [&](int written) {
+        if (written > 0) {
+            used = std::min(used + written, size - 1);
+        }
+    };
+
+    for (const char* p = format; *p && used < size - 1; p++) {
+        if (*p != '%') {
+            out[used++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[used++] = '%';
+            p++;
+            continue;
+        }
+
+        // Copy flags, width and precision; drop length modifiers
+        char spec[16] = "%";
+        size_t specLength = 1;
+        const char* q = p + 1;
+        while (*q && !isConversion(*q)) {
+            if (!isLengthModifier(*q) && specLength < sizeof(spec) - 2) {
+                spec[specLength++] = *q;
+            }
+            q++;
+        }
+        if (!*q) {
+            break; // Truncated specification
+        }
+        char conversion = *q;
+        spec[specLength++] = conversion;
+        spec[specLength] = '\0';
+        p = q;
+
+        char* dest = out + used;
+        size_t space = size - used;
+        if (arg >= argCount) {
+            append(snprintf(dest, space, "?"));
+            continue;
+        }
+
+        ArgKind kind = kinds[arg];
+        ArgValue value = values[arg++];
+        if (conversion == 's') {
+            if (kind == ARG_TEXT) {
+                append(snprintf(dest, space, spec, text + value.offset));
+            } else {
+                append(snprintf(dest, space, "?"));
+            }
+        } else if (strchr("fFeEgG", conversion)) {
+            double number = kind == ARG_FLOAT ? value.f : kind == ARG_INT ? value.i : kind == ARG_UINT ? value.u : 0;
+            append(snprintf(dest, space, spec, number));
+        } else if (conversion == 'd' || conversion == 'i' || conversion == 'c') {
+            int number = kind == ARG_FLOAT ? static_cast<int>(value.f) : kind == ARG_TEXT ? 0 : value.i;
+            append(snprintf(dest, space, spec, number));
+        } else {
+            unsigned int number = kind == ARG_FLOAT ? static_cast<unsigned int>(value.f) : kind == ARG_TEXT ? 0 : value.u;
+            append(snprintf(dest, space, spec, number));
+        }
+    }
+
+    out[used] = '\0';
+    return used;
+}
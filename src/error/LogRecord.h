@@ -0,0 +1,115 @@
+/**
+ * @file LogRecord.h
+ * @brief Compact log record with deferred formatting
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup error_handling
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <algorithm>
+ #include <string_view>
+ #include "Constants.h"
+
+ /**
+  * @brief One log message captured without formatting it
+  * Stores the severity, the capture time, a pointer to a static printf-style
+  * format string (which doubles as the message id) and up to MAX_ARGS typed
+  * arguments. String arguments are copied into a small inline text area, so
+  * the record is self-contained and can be formatted later on another task.
+  * A record without a format holds a complete preformatted message instead.
+  */
+ struct LogRecord {
+     static const size_t MAX_ARGS = Constants::Logging::MAX_RECORD_ARGS;    ///< Arguments per record
+     static const size_t TEXT_SIZE = Constants::Logging::RECORD_TEXT_SIZE;  ///< Inline text bytes
+
+     /**
+      * @brief Type of a stored argument
+      */
+     enum ArgKind : uint8_t {
+         ARG_INT,     ///< Signed integer
+         ARG_UINT,    ///< Unsigned integer
+         ARG_FLOAT,   ///< Floating point
+         ARG_TEXT     ///< String copied into text
+     };
+
+     /**
+      * @brief Storage for one argument
+      */
+     union ArgValue {
+         int32_t i;          ///< ARG_INT value
+         uint32_t u;         ///< ARG_UINT value
+         float f;            ///< ARG_FLOAT value
+         uint8_t offset;     ///< ARG_TEXT start within text
+     };
+
+     uint32_t timestamp = 0;        ///< Capture time (millis)
+     const char* format = nullptr;  ///< Static format string, or nullptr if text is the message
+     uint8_t severity = 0;          ///< ErrorSeverity of the message
+     uint8_t argCount = 0;          ///< Number of stored arguments
+     uint8_t textUsed = 0;          ///< Bytes of text in use, including terminators
+     ArgKind kinds[MAX_ARGS] = {};  ///< Type of each argument
+     ArgValue values[MAX_ARGS] = {};///< Value of each argument
+     char text[TEXT_SIZE];          ///< String arguments, null-terminated back to back
+
+     /**
+      * @name Argument capture
+      * Arguments past MAX_ARGS are dropped; strings are truncated to the
+      * remaining text space.
+      * @{
+      */
+     void addArg(int value) { ArgValue v; v.i = value; addNumber(ARG_INT, v); }
+     void addArg(long value) { ArgValue v; v.i = static_cast<int32_t>(value); addNumber(ARG_INT, v); }
+     void addArg(unsigned int value) { ArgValue v; v.u = value; addNumber(ARG_UINT, v); }
+     void addArg(unsigned long value) { ArgValue v; v.u = static_cast<uint32_t>(value); addNumber(ARG_UINT, v); }
+     void addArg(double value) { ArgValue v; v.f = static_cast<float>(value); addNumber(ARG_FLOAT, v); }
+     void addArg(const char* value) { addText(value ? std::string_view(value) : std::string_view("(null)")); }
+     void addArg(const String& value) { addText(std::string_view(value.c_str(), value.length())); }
+     void addArg(std::string_view value) { addText(value); }
+     /** @} */
+
+     /**
+      * @brief Store a complete message as the record's text
+      * @param message Message to copy (truncated to TEXT_SIZE - 1)
+      */
+     void setMessage(std::string_view message) {
+         format = nullptr;
+         argCount = 0;
+         textUsed = 0;
+         addText(message);
+         argCount = 0;
+     }
+
+     /**
+      * @brief Render the message
+      * Supports the printf conversions d, i, u, x, X, o, c, s, f, F, e, E,
+      * g, G with flags, width and precision; length modifiers are ignored
+      * since the stored type decides. Missing arguments render as "?".
+      * @param out [out] Destination buffer
+      * @param size Destination size in bytes
+      * @return Number of characters written, excluding the terminator
+      */
+     size_t render(char* out, size_t size) const;
+
+ private:
+     void addNumber(ArgKind kind, ArgValue value) {
+         if (argCount < MAX_ARGS) {
+             kinds[argCount] = kind;
+             values[argCount++] = value;
+         }
+     }
+
+     void addText(std::string_view value) {
+         if (argCount >= MAX_ARGS || textUsed >= TEXT_SIZE) {
+             return;
+         }
+         size_t length = std::min(value.size(), TEXT_SIZE - 1 - textUsed);
+         memcpy(text + textUsed, value.data(), length);
+         text[textUsed + length] = '\0';
+         kinds[argCount] = ARG_TEXT;
+         values[argCount++].offset = textUsed;
+         textUsed += length + 1;
+     }
+ };
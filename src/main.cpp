@@ -7,8 +7,10 @@
 #include "managers/SPIManager.h"
 #include "managers/SensorManager.h"
 #include "managers/LedManager.h"
+#include "managers/PowerManager.h"
 #include "managers/TaskManager.h"
 #include "communication/CommunicationManager.h"
+#include "communication/TelemetryPublisher.h"
 #include "Constants.h"
 
 // Define UART pins for debug output
@@ -24,7 +26,9 @@ SensorManager* sensorManager = nullptr;
 CommunicationManager* commManager = nullptr;
 HardwareSerial* debugSerial = nullptr;
 LedManager* ledManager = nullptr;
+PowerManager* powerManager = nullptr;
 TaskManager* taskManager = nullptr;
+TelemetryPublisher* telemetryPublisher = nullptr;
 
 // Global references to serial ports
 Print* usbSerial = nullptr;
@@ -121,6 +125,16 @@ void setup() {
     // Give the system time to stabilize
     delay(20);
     
+    // Power-managed mode: frequency scaling and light sleep, held off during bus transactions
+    powerManager = new PowerManager(errorHandler);
+    if (powerManager->begin(PowerManager::parseLowPower(configManager->getAdditionalConfig())) &&
+        powerManager->isLowPower()) {
+        i2cManager->getBusMutex(I2CPort::I2C0)->setPowerLock(powerManager->getBusLock());
+        i2cManager->getBusMutex(I2CPort::I2C1)->setPowerLock(powerManager->getBusLock());
+        spiManager->getBusMutex()->setPowerLock(powerManager->getBusLock());
+        ledManager->setPowerSave(true);
+    }
+    
     // Create sensor manager with both I2C and SPI support
     sensorManager = new SensorManager(configManager, i2cManager, errorHandler, spiManager);
     
@@ -150,12 +164,25 @@ void setup() {
 
     // Initialize TaskManager - core task management
     taskManager = new TaskManager(sensorManager, commManager, ledManager, errorHandler);
+    taskManager->setPowerManager(powerManager);
+    taskManager->setPlacement(configManager->getTaskConfig());
     
     if (!taskManager->begin()) {
         errorHandler->logError(FATAL, "Failed to initialize task manager");
     } else {
         errorHandler->logError(INFO, "Task manager initialized successfully");
         
+        // Defer log output to its own task before the others start
+        if (!taskManager->startLogTask()) {
+            errorHandler->logError(WARNING, "Failed to start log task, logging synchronously");
+        }
+        
+        // Stall detection and CPU accounting for everything started after it
+        commManager->setTaskManager(taskManager);
+        if (!taskManager->startSupervisorTask()) {
+            errorHandler->logError(WARNING, "Failed to start supervisor task");
+        }
+        
         // Start tasks one by one with delays in between
         if (taskManager->startLedTask()) {
             errorHandler->logError(INFO, "LED task started successfully");
@@ -168,6 +195,21 @@ void setup() {
                 if (taskManager->startSensorTask()) {
                     errorHandler->logError(INFO, "Sensor task started successfully");
                     delay(30); // Give time for task to stabilize
+                    
+                    if (!taskManager->startRecoveryTask()) {
+                        errorHandler->logError(WARNING, "Failed to start recovery task");
+                    }
+                    
+                    // Network telemetry publishes what the acquisition workers record
+                    const TelemetryConfig& telemetryConfig = configManager->getTelemetryConfig();
+                    if (telemetryConfig.enabled) {
+                        telemetryPublisher = new TelemetryPublisher(sensorManager, errorHandler, telemetryConfig,
+                                                                    configManager->getBoardIdentifier());
+                        taskManager->setTelemetryPublisher(telemetryPublisher);
+                        if (!telemetryPublisher->begin() || !taskManager->startTelemetryTask()) {
+                            errorHandler->logError(WARNING, "Failed to start telemetry task");
+                        }
+                    }
 
                 } else {
                     errorHandler->logError(WARNING, "Failed to start sensor task");
@@ -0,0 +1,123 @@
+/**
+ * @file BusLock.h
+ * @brief Mutual exclusion for a shared I2C or SPI bus
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup communication
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <atomic>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/semphr.h>
+ #include "Constants.h"
+ #include "PowerManager.h"
+
+ /**
+  * @brief Mutex owned by the manager of one physical bus
+  * A FreeRTOS recursive mutex, so a low-priority task holding the bus
+  * inherits the priority of a waiting acquisition worker, and code that
+  * already holds the bus (e.g. a batch of sensor reads) can call helpers
+  * that take it again. With a power lock attached, the chip is kept out
+  * of light sleep for as long as any task holds the bus.
+  */
+ class BusMutex {
+ public:
+     BusMutex() : handle(xSemaphoreCreateRecursiveMutex()), contended(0) {}
+
+     ~BusMutex() {
+         if (handle) {
+             vSemaphoreDelete(handle);
+         }
+     }
+
+     BusMutex(const BusMutex&) = delete;
+     BusMutex& operator=(const BusMutex&) = delete;
+
+     /**
+      * @brief Take the bus
+      * @param timeoutMs How long to wait for another task to release it
+      * @return true if the calling task now holds the bus
+      */
+     bool lock(uint32_t timeoutMs) {
+         if (!handle) {
+             return true;   // Never created; behave as before locking existed
+         }
+         if (xSemaphoreTakeRecursive(handle, 0) != pdTRUE) {
+             contended.fetch_add(1);
+             if (xSemaphoreTakeRecursive(handle, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+                 return false;
+             }
+         }
+         if (powerLock) {
+             powerLock->acquire();
+         }
+         return true;
+     }
+
+     /**
+      * @brief Release one level of the bus
+      */
+     void unlock() {
+         if (handle) {
+             if (powerLock) {
+                 powerLock->release();
+             }
+             xSemaphoreGiveRecursive(handle);
+         }
+     }
+
+     /**
+      * @brief Keep the chip awake while the bus is held
+      * Attach before any task uses the bus so acquire and release pair up.
+      * @param lock Power lock taken with every level of the mutex, or nullptr
+      */
+     void setPowerLock(PowerLock* lock) { powerLock = lock; }
+
+     /**
+      * @brief Get how often a task had to wait for the bus
+      * @return Contended lock attempts since boot
+      */
+     uint32_t getContendedCount() const { return contended.load(); }
+
+ private:
+     SemaphoreHandle_t handle;          ///< Recursive mutex, null if creation failed
+     std::atomic<uint32_t> contended;   ///< Lock attempts that found the bus busy
+     PowerLock* powerLock = nullptr;    ///< Held with the mutex in low-power mode
+ };
+
+ /**
+  * @brief Holds a bus for the enclosing scope
+  * Check owns() before touching the bus; a null mutex is always owned.
+  */
+ class BusLock {
+ public:
+     /**
+      * @brief Take the bus
+      * @param busMutex Mutex of the bus, or nullptr for no locking
+      * @param timeoutMs How long to wait for another task to release it
+      */
+     explicit BusLock(BusMutex* busMutex, uint32_t timeoutMs = Constants::Sensors::BUS_LOCK_TIMEOUT_MS)
+         : mutex(busMutex), held(!busMutex || busMutex->lock(timeoutMs)) {}
+
+     ~BusLock() {
+         if (mutex && held) {
+             mutex->unlock();
+         }
+     }
+
+     BusLock(const BusLock&) = delete;
+     BusLock& operator=(const BusLock&) = delete;
+
+     /**
+      * @brief Check whether the bus was taken
+      * @return true if the caller may use the bus
+      */
+     bool owns() const { return held; }
+
+ private:
+     BusMutex* mutex;   ///< Mutex taken, or nullptr
+     bool held;         ///< Whether lock() succeeded
+ };
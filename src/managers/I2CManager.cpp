@@ -1,6 +1,18 @@
 #include "I2CManager.h"
+#include "../Constants.h"
+#include <algorithm>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 
 I2CManager::I2CManager(ErrorHandler* err) : errorHandler(err) {
+    for (size_t index = 0; index < PRESENCE_PORTS; index++) {
+        for (size_t word = 0; word < 4; word++) {
+            probedMask[index][word].store(0);
+            presentMask[index][word].store(0);
+        }
+    }
+    
     // Register default Wire instances
     // Main I2C bus - traditional Arduino pins
     registerWire(I2CPort::I2C0, &Wire1, 7, 6);  // GPIO7 (SDA), GPIO6 (SCL)
@@ -39,6 +51,8 @@ bool I2CManager::begin() {
 }
 
 bool I2CManager::beginPort(I2CPort port) {
+    // A mux channel is usable once its physical bus is
+    port = physicalPort(port);
     auto it = wireBuses.find(port);
     if (it == wireBuses.end()) {
         errorHandler->logError(ERROR, "No Wire instance registered for port " + portToString(port));
@@ -67,7 +81,7 @@ bool I2CManager::beginPort(I2CPort port) {
 }
 
 bool I2CManager::isPortInitialized(I2CPort port) const {
-    auto it = wireBuses.find(port);
+    auto it = wireBuses.find(physicalPort(port));
     if (it == wireBuses.end()) {
         return false;
     }
@@ -76,7 +90,7 @@ bool I2CManager::isPortInitialized(I2CPort port) const {
 }
 
 TwoWire* I2CManager::getWire(I2CPort port) {
-    auto it = wireBuses.find(port);
+    auto it = wireBuses.find(physicalPort(port));
     if (it == wireBuses.end()) {
         errorHandler->logError(ERROR, "No Wire instance registered for port " + portToString(port));
         return nullptr;
@@ -86,7 +100,7 @@ TwoWire* I2CManager::getWire(I2CPort port) {
 }
 
 const WireConfig* I2CManager::getWireConfig(I2CPort port) const {
-    auto it = wireBuses.find(port);
+    auto it = wireBuses.find(physicalPort(port));
     if (it == wireBuses.end()) {
         return nullptr;
     }
@@ -129,33 +143,445 @@ bool I2CManager::devicePresent(I2CPort port, int address) {
         return false;
     }
     
-    wire->beginTransmission(address);
-    byte error = wire->endTransmission();
+    BusLock lock(getBusMutex(port));
+    if (!lock.owns()) {
+        errorHandler->logError(WARNING, "I2C port " + portToString(port) + " busy, probe of 0x" + 
+                             String(address, HEX) + " skipped");
+        return false;
+    }
+    
+    // An unreachable channel hides its devices just as an absent device would
+    byte error = 0xFF;
+    if (selectPort(port)) {
+        wire->beginTransmission(address);
+        error = wire->endTransmission();
+    }
     
+    recordPresence(port, address, error == 0);
     return (error == 0);
 }
 
-I2CPort I2CManager::stringToPort(const String& portName) {
-    // Handle existing port names
-    if (portName.equalsIgnoreCase("I2C0")) {
-        return I2CPort::I2C0;
-    } else if (portName.equalsIgnoreCase("I2C1")) {
-        return I2CPort::I2C1;
-    } 
-    // #TODO Handle multiplexed ports if format is like "I2C_MUX_0", "I2C_MUX_1", etc.
-    if (portName.startsWith("I2C_MUX_")) {
-        String channelStr = portName.substring(8);
-        int channel = channelStr.toInt();
-        return static_cast<I2CPort>(static_cast<int>(I2CPort::I2C_MULTIPLEXED_START) + channel);
+bool I2CManager::selectPort(I2CPort port) {
+    int channel = muxChannel(port);
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    if (bus >= PRESENCE_BUSES) {
+        return false;
+    }
+    
+    // The trunk sees the selected channel too, so a direct device only needs the
+    // multiplexer closed once one is known to be there; a bus without one is never touched
+    ClockState& state = clockStates[bus];
+    if (channel < 0 && !state.muxPresent.load()) {
+        return true;
+    }
+    int8_t wanted = channel < 0 ? MUX_CHANNEL_NONE : static_cast<int8_t>(channel);
+    if (state.muxChannel.load() == wanted) {
+        state.muxSkips.fetch_add(1);
+        return true;
+    }
+    
+    TwoWire* wire = getWire(port);
+    BusLock lock(getBusMutex(port));
+    if (!wire || !isPortInitialized(port) || !lock.owns()) {
+        return false;
+    }
+    
+    // One control byte with a bit per channel; at most one is connected at a time
+    uint8_t control = channel < 0 ? 0 : static_cast<uint8_t>(1U << channel);
+    bool selected = writeCommand(wire, Constants::Sensors::I2C_MUX_ADDRESS, control);
+    state.muxChannel.store(selected ? wanted : MUX_CHANNEL_UNKNOWN);
+    state.muxSwitches.fetch_add(1);
+    if (selected) {
+        state.muxPresent.store(true);
+    }
+    return selected;
+}
+
+void I2CManager::invalidateMuxChannel(I2CPort port) {
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    if (bus < PRESENCE_BUSES) {
+        clockStates[bus].muxChannel.store(MUX_CHANNEL_UNKNOWN);
+    }
+}
+
+bool I2CManager::recoverBus(I2CPort port) {
+    port = physicalPort(port);
+    auto it = wireBuses.find(port);
+    if (it == wireBuses.end() || !it->second.initialized) {
+        return false;
+    }
+    WireConfig& config = it->second;
+    
+    BusLock lock(getBusMutex(port));
+    if (!lock.owns()) {
+        return false;
+    }
+    
+    // Both lines pulled up means nobody is holding the bus
+    if (digitalRead(config.sdaPin) == HIGH && digitalRead(config.sclPin) == HIGH) {
+        return true;
+    }
+    
+    errorHandler->logError(WARNING, "I2C port " + portToString(port) + " held low, clocking SCL to release it");
+    config.wire->end();
+    
+    // Each pulse lets the device shift out one more bit until it reaches an ACK slot and releases SDA
+    pinMode(config.sdaPin, INPUT_PULLUP);
+    pinMode(config.sclPin, OUTPUT_OPEN_DRAIN);
+    digitalWrite(config.sclPin, HIGH);
+    delayMicroseconds(5);
+    for (int pulse = 0; pulse < Constants::Sensors::I2C_RECOVERY_CLOCKS && digitalRead(config.sdaPin) == LOW; pulse++) {
+        digitalWrite(config.sclPin, LOW);
+        delayMicroseconds(5);
+        digitalWrite(config.sclPin, HIGH);
+        delayMicroseconds(5);
+    }
+    
+    // STOP: SDA rising while SCL is high resets every device's bus state machine
+    pinMode(config.sdaPin, OUTPUT_OPEN_DRAIN);
+    digitalWrite(config.sdaPin, LOW);
+    delayMicroseconds(5);
+    digitalWrite(config.sdaPin, HIGH);
+    delayMicroseconds(5);
+    bool released = digitalRead(config.sdaPin) == HIGH;
+    
+    config.wire->begin(config.sdaPin, config.sclPin);
+    config.wire->setClock(config.clockFrequency);
+    
+    // The multiplexer may have been the device holding the bus; its selection is not to be trusted
+    invalidateMuxChannel(port);
+    
+    if (released) {
+        errorHandler->logError(INFO, "I2C port " + portToString(port) + " released");
+    } else {
+        errorHandler->logError(ERROR, "I2C port " + portToString(port) + " still held low after recovery");
+    }
+    return released;
+}
+
+size_t I2CManager::presenceIndex(I2CPort port) {
+    if (!isValidPort(static_cast<int>(port))) {
+        return PRESENCE_PORTS;
+    }
+    int channel = muxChannel(port);
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    return channel < 0 ? bus : PRESENCE_BUSES + bus * Constants::Sensors::I2C_MUX_CHANNELS + channel;
+}
+
+void I2CManager::recordPresence(I2CPort port, int address, bool present) {
+    size_t index = presenceIndex(port);
+    if (index >= PRESENCE_PORTS || address < 0 || address >= 128) {
+        return;
+    }
+    
+    uint32_t bit = 1UL << (address % 32);
+    probedMask[index][address / 32].fetch_or(bit);
+    if (present) {
+        presentMask[index][address / 32].fetch_or(bit);
+    } else {
+        presentMask[index][address / 32].fetch_and(~bit);
+    }
+}
+
+BusMutex* I2CManager::getBusMutex(I2CPort port) {
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    return bus < PRESENCE_BUSES ? &busMutexes[bus] : nullptr;
+}
+
+DevicePresence I2CManager::getCachedPresence(I2CPort port, int address) const {
+    size_t index = presenceIndex(port);
+    if (index >= PRESENCE_PORTS || address < 0 || address >= 128) {
+        return DevicePresence::UNKNOWN;
+    }
+    
+    uint32_t bit = 1UL << (address % 32);
+    if (!(probedMask[index][address / 32].load() & bit)) {
+        return DevicePresence::UNKNOWN;
+    }
+    return (presentMask[index][address / 32].load() & bit) ? DevicePresence::PRESENT : DevicePresence::ABSENT;
+}
+
+bool I2CManager::applyClock(I2CPort port, uint32_t clockFreq) {
+    auto it = wireBuses.find(physicalPort(port));
+    if (it == wireBuses.end() || !it->second.initialized) {
+        return false;
+    }
+    
+    BusLock lock(getBusMutex(port));
+    if (!lock.owns()) {
+        return false;
+    }
+    it->second.wire->setClock(clockFreq);
+    it->second.clockFrequency = clockFreq;
+    return true;
+}
+
+uint32_t I2CManager::nextSlowerClock(uint32_t clockFreq) {
+    static const uint32_t STANDARD_RATES[] = {1000000, 400000, 100000, 10000};
+    for (uint32_t rate : STANDARD_RATES) {
+        if (rate < clockFreq) {
+            return rate;
+        }
+    }
+    return clockFreq;
+}
+
+uint32_t I2CManager::negotiateClock(I2CPort port, uint32_t maxClockFreq, const std::vector<int>& addresses) {
+    if (!isPortInitialized(port)) {
+        return 0;
+    }
+    
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    if (bus < PRESENCE_BUSES) {
+        clockStates[bus].requestedClock.store(0);
     }
     
+    // No other task may see the bus between a clock change and its verification
+    BusLock lock(getBusMutex(port));
+    
+    // Nothing attached can vouch for a faster clock
+    if (addresses.empty()) {
+        uint32_t clockFreq = std::min(maxClockFreq, Constants::Sensors::DEFAULT_I2C_CLOCK_FREQ);
+        applyClock(port, clockFreq);
+        return clockFreq;
+    }
+    
+    uint32_t clockFreq = maxClockFreq;
+    while (true) {
+        applyClock(port, clockFreq);
+        bool allAnswered = std::all_of(addresses.begin(), addresses.end(),
+                                       [&](int address) { return devicePresent(port, address); });
+        if (allAnswered) {
+            errorHandler->logError(INFO, "I2C port " + portToString(port) + " clock set to " + 
+                                 String(clockFreq) + " Hz");
+            return clockFreq;
+        }
+        
+        uint32_t slower = nextSlowerClock(clockFreq);
+        if (slower == clockFreq) {
+            break;
+        }
+        clockFreq = slower;
+    }
+    
+    // Some device is missing at every rate; keep the standard rate so it is found if it appears
+    clockFreq = std::min(maxClockFreq, Constants::Sensors::DEFAULT_I2C_CLOCK_FREQ);
+    applyClock(port, clockFreq);
+    errorHandler->logError(WARNING, "I2C port " + portToString(port) + " devices missing at every clock, using " + 
+                         String(clockFreq) + " Hz");
+    return clockFreq;
+}
+
+void I2CManager::requestClock(I2CPort port, uint32_t clockFreq) {
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    if (bus < PRESENCE_BUSES && clockFreq > 0) {
+        clockStates[bus].requestedClock.store(clockFreq);
+    }
+}
+
+void I2CManager::recordTransaction(I2CPort port, bool success) {
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    if (bus >= PRESENCE_BUSES) {
+        return;
+    }
+    
+    ClockState& state = clockStates[bus];
+    state.transactions.fetch_add(1);
+    if (!success) {
+        // A glitch that upset the device may have upset the multiplexer too
+        state.errors.fetch_add(1);
+        state.muxChannel.store(MUX_CHANNEL_UNKNOWN);
+    }
+    
+    // A requested clock starts a fresh window
+    uint32_t requested = state.requestedClock.exchange(0);
+    if (requested > 0) {
+        if (applyClock(port, requested)) {
+            errorHandler->logError(INFO, "I2C port " + portToString(port) + " clock changed to " + 
+                                 String(requested) + " Hz");
+        }
+        state.windowTransactions = 0;
+        state.windowErrors = 0;
+        return;
+    }
+    
+    state.windowTransactions++;
+    if (!success) {
+        state.windowErrors++;
+    }
+    if (state.windowTransactions < Constants::Sensors::I2C_CLOCK_WINDOW) {
+        return;
+    }
+    
+    if (state.windowErrors >= Constants::Sensors::I2C_CLOCK_FALLBACK_ERRORS) {
+        const WireConfig* config = getWireConfig(port);
+        uint32_t current = config ? config->clockFrequency : 0;
+        uint32_t slower = nextSlowerClock(current);
+        if (config && slower != current && applyClock(port, slower)) {
+            state.fallbacks.fetch_add(1);
+            errorHandler->logError(WARNING, "I2C port " + portToString(port) + ": " + String(state.windowErrors) + 
+                                 " of " + String(state.windowTransactions) + " transactions failed, clock lowered to " + 
+                                 String(slower) + " Hz");
+        }
+    }
+    state.windowTransactions = 0;
+    state.windowErrors = 0;
+}
+
+BusClockStatus I2CManager::getClockStatus(I2CPort port) const {
+    BusClockStatus status;
+    const WireConfig* config = getWireConfig(port);
+    size_t bus = static_cast<size_t>(physicalPort(port));
+    if (!config || bus >= PRESENCE_BUSES) {
+        return status;
+    }
+    
+    status.clockFrequency = config->clockFrequency;
+    status.transactions = clockStates[bus].transactions.load();
+    status.errors = clockStates[bus].errors.load();
+    status.fallbacks = clockStates[bus].fallbacks.load();
+    status.muxSwitches = clockStates[bus].muxSwitches.load();
+    status.muxSkips = clockStates[bus].muxSkips.load();
+    return status;
+}
+
+namespace {
+    /**
+     * @brief Hand-off between probeConcurrently() and a probe task
+     */
+    struct ProbeContext {
+        I2CManager* owner;
+        std::vector<I2CManager::BusProbe*> probes;   ///< Every probe of one physical bus
+        SemaphoreHandle_t done;
+    };
+    
+    void runProbes(I2CManager* owner, const std::vector<I2CManager::BusProbe*>& probes) {
+        // One hold for the whole sweep rather than one per address; the ports
+        // of a bus come one after another so each mux channel is selected once
+        BusLock lock(owner->getBusMutex(probes.front()->port));
+        for (I2CManager::BusProbe* probe : probes) {
+            probe->found.clear();
+            for (int address : probe->candidates) {
+                if (owner->devicePresent(probe->port, address)) {
+                    probe->found.push_back(address);
+                }
+            }
+        }
+    }
+}
+
+void I2CManager::probeTaskFunction(void* pvParameters) {
+    ProbeContext* context = static_cast<ProbeContext*>(pvParameters);
+    runProbes(context->owner, context->probes);
+    xSemaphoreGive(context->done);
+    vTaskDelete(NULL);
+}
+
+void I2CManager::probeConcurrently(std::vector<BusProbe>& probes) {
+    // Group the probes by physical bus, keeping their order within a bus
+    std::vector<ProbeContext> contexts;
+    for (auto& probe : probes) {
+        I2CPort bus = physicalPort(probe.port);
+        auto context = std::find_if(contexts.begin(), contexts.end(), [&](const ProbeContext& candidate) {
+            return physicalPort(candidate.probes.front()->port) == bus;
+        });
+        if (context == contexts.end()) {
+            contexts.push_back({this, {}, nullptr});
+            context = contexts.end() - 1;
+        }
+        context->probes.push_back(&probe);
+    }
+    
+    // Every bus but the first gets a helper task; the caller takes the first
+    for (size_t i = 1; i < contexts.size(); i++) {
+        contexts[i].done = xSemaphoreCreateBinary();
+        I2CPort bus = physicalPort(contexts[i].probes.front()->port);
+        String taskName = "I2CProbe_" + portToString(bus);
+        if (!contexts[i].done ||
+            xTaskCreate(probeTaskFunction, taskName.c_str(), Constants::Tasks::STACK_SIZE_PROBE,
+                        &contexts[i], Constants::Tasks::PRIORITY_PROBE, nullptr) != pdPASS) {
+            // Fall back to probing this bus on the caller after the first
+            if (contexts[i].done) {
+                vSemaphoreDelete(contexts[i].done);
+                contexts[i].done = nullptr;
+            }
+            errorHandler->logError(WARNING, "Probing " + portToString(bus) + " without a helper task");
+        }
+    }
+    
+    for (size_t i = 0; i < contexts.size(); i++) {
+        if (i == 0 || !contexts[i].done) {
+            runProbes(this, contexts[i].probes);
+        }
+    }
+    
+    for (size_t i = 1; i < contexts.size(); i++) {
+        if (contexts[i].done) {
+            xSemaphoreTake(contexts[i].done, portMAX_DELAY);
+            vSemaphoreDelete(contexts[i].done);
+        }
+    }
+}
+
+bool I2CManager::writeBytes(TwoWire* wire, uint8_t address, const uint8_t* data, size_t length, bool sendStop) {
+    PerfScope timing(PerfSite::I2C_TRANSACTION);
+    wire->beginTransmission(address);
+    wire->write(data, length);
+    return wire->endTransmission(sendStop) == 0;
+}
+
+bool I2CManager::readBytes(TwoWire* wire, uint8_t address, uint8_t* buffer, size_t length) {
+    PerfScope timing(PerfSite::I2C_TRANSACTION);
+    if (wire->requestFrom(address, static_cast<uint8_t>(length)) != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = wire->read();
+    }
+    return true;
+}
+
+bool I2CManager::parsePort(const String& portName, I2CPort& port) {
+    String name = portName;
+    name.trim();
+    name.toUpperCase();
+    
+    // Physical bus first, then an optional "/MUX:<channel>"
+    if (!name.startsWith("I2C") || name.length() < 4 || (name[3] != '0' && name[3] != '1')) {
+        return false;
+    }
+    I2CPort bus = name[3] == '0' ? I2CPort::I2C0 : I2CPort::I2C1;
+    String rest = name.substring(4);
+    if (rest.length() == 0) {
+        port = bus;
+        return true;
+    }
+    
+    if (!rest.startsWith("/MUX:") || rest.length() < 6) {
+        return false;
+    }
+    String channelStr = rest.substring(5);
+    for (size_t i = 0; i < channelStr.length(); i++) {
+        if (!isDigit(channelStr[i])) {
+            return false;
+        }
+    }
+    int channel = channelStr.toInt();
+    if (channel >= Constants::Sensors::I2C_MUX_CHANNELS) {
+        return false;
+    }
+    port = muxPort(bus, static_cast<uint8_t>(channel));
+    return true;
+}
+
+I2CPort I2CManager::stringToPort(const String& portName) {
+    I2CPort port;
+    
     // Default to I2C0 if unrecognized
-    return I2CPort::I2C0;
+    return parsePort(portName, port) ? port : I2CPort::I2C0;
 }
 
 String I2CManager::portToString(I2CPort port) {
-    int portValue = static_cast<int>(port);
-    
     // Handle built-in ports
     switch (port) {
         case I2CPort::I2C0: return "I2C0";
@@ -165,10 +591,9 @@ String I2CManager::portToString(I2CPort port) {
     }
     
     // Handle multiplexed ports
-    if (portValue >= static_cast<int>(I2CPort::I2C_MULTIPLEXED_START)) {
-        int channel = portValue - static_cast<int>(I2CPort::I2C_MULTIPLEXED_START);
-        return "I2C_MUX_" + String(channel);
+    if (isValidPort(static_cast<int>(port))) {
+        return portToString(physicalPort(port)) + "/mux:" + String(muxChannel(port));
     }
     
     return "UNKNOWN";
-}
\ No newline at end of file
+}
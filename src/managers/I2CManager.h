@@ -15,19 +15,28 @@
  #include <Wire.h>
  #include <vector>
  #include <map>
+ #include <atomic>
  #include "../error/ErrorHandler.h"
+ #include "PerfCounters.h"
+ #include "BusLock.h"
+ #include "../Constants.h"
  
  /**
   * @brief I2C port identifiers for different buses
   * Defines the available I2C buses in the system, including
   * both physical buses and multiplexed channels.
+  *
+  * A channel of the TCA9548A on a physical bus is a virtual port with
+  * the value I2C_MULTIPLEXED_START + bus * I2C_MUX_CHANNELS + channel,
+  * written "I2C0/mux:3" in configurations. It shares the clock, mutex
+  * and error counters of its physical bus; only presence is tracked
+  * per channel, since the same address can sit behind every channel.
   */
  enum class I2CPort {
      I2C0 = 0,   ///< Default I2C bus (typically Arduino pins)
      I2C1 = 1,   ///< Secondary I2C bus (typically STEMMA QT)
      
-     I2C_MULTIPLEXED_START = 100,  ///< Range for multiplexed buses
-     // Multiplexed buses would be I2C_MULTIPLEXED_START + multiplexer_channel
+     I2C_MULTIPLEXED_START = 100,  ///< Range for multiplexed buses, see I2CManager::muxPort()
  };
  
  /**
@@ -40,7 +49,7 @@
      int sdaPin;               ///< SDA pin number
      int sclPin;               ///< SCL pin number
      bool initialized;         ///< Whether this bus has been initialized
-     uint32_t clockFrequency;  ///< I2C clock frequency in Hz
+     uint32_t clockFrequency;  ///< Current I2C clock frequency in Hz
      
      /**
       * @brief Default constructor with null initialization
@@ -59,6 +68,27 @@
          : wire(w), sdaPin(sda), sclPin(scl), initialized(false), clockFrequency(freq) {}
  };
  
+ /**
+  * @brief What the last probe of an address found
+  */
+ enum class DevicePresence : uint8_t {
+     UNKNOWN,   ///< Never probed
+     PRESENT,   ///< Acknowledged its address
+     ABSENT     ///< Did not acknowledge
+ };
+ 
+ /**
+  * @brief Clock and transaction health of one bus, as reported over SCPI
+  */
+ struct BusClockStatus {
+     uint32_t clockFrequency = 0;   ///< Clock in use, in Hz
+     uint32_t transactions = 0;     ///< Driver transactions recorded since boot
+     uint32_t errors = 0;           ///< Of which failed with a NACK or timeout
+     uint32_t fallbacks = 0;        ///< Times the error rate forced a slower clock
+     uint32_t muxSwitches = 0;      ///< Multiplexer channel selections written
+     uint32_t muxSkips = 0;         ///< Selections skipped because the channel was already active
+ };
+ 
  /**
   * @brief Manages I2C bus configurations and communication
   * This class provides a central management system for I2C buses,
@@ -77,7 +107,102 @@
       */
      ErrorHandler* errorHandler;
      
+     /**
+      * @brief Number of physical buses with a presence cache
+      */
+     static const size_t PRESENCE_BUSES = 2;
+     
+     /**
+      * @brief Number of ports with a presence cache: each physical bus and each of its mux channels
+      */
+     static const size_t PRESENCE_PORTS = PRESENCE_BUSES * (1 + Constants::Sensors::I2C_MUX_CHANNELS);
+     
+     /**
+      * @brief Bit per address: probed at least once, per port
+      */
+     std::atomic<uint32_t> probedMask[PRESENCE_PORTS][4];
+     
+     /**
+      * @brief Bit per address: acknowledged at the last probe, per port
+      */
+     std::atomic<uint32_t> presentMask[PRESENCE_PORTS][4];
+     
+     /**
+      * @brief Map a port to its presence cache entry
+      * @param port The I2C port
+      * @return Index into the presence masks, or PRESENCE_PORTS if the port has none
+      */
+     static size_t presenceIndex(I2CPort port);
+     
+     /**
+      * @brief Record the result of probing an address
+      * @param port The I2C port probed
+      * @param address The address probed
+      * @param present Whether it acknowledged
+      */
+     void recordPresence(I2CPort port, int address, bool present);
+     
+     /**
+      * @brief Cached multiplexer selection: not known, e.g. after a failed transaction
+      */
+     static constexpr int8_t MUX_CHANNEL_UNKNOWN = -1;
+     
+     /**
+      * @brief Cached multiplexer selection: every channel disconnected, only the trunk is seen
+      */
+     static constexpr int8_t MUX_CHANNEL_NONE = -2;
+     
+     /**
+      * @brief Transaction counters and pending clock change of one physical bus
+      */
+     struct ClockState {
+         std::atomic<uint32_t> transactions{0};        ///< Transactions since boot
+         std::atomic<uint32_t> errors{0};              ///< Failed transactions since boot
+         std::atomic<uint32_t> fallbacks{0};           ///< Error-rate step-downs since boot
+         std::atomic<uint32_t> requestedClock{0};      ///< Clock to switch to at the next transaction, 0 = none
+         std::atomic<int8_t> muxChannel{MUX_CHANNEL_UNKNOWN};  ///< Multiplexer channel last selected
+         std::atomic<bool> muxPresent{false};          ///< A multiplexer has acknowledged a selection
+         std::atomic<uint32_t> muxSwitches{0};         ///< Channel selections written since boot
+         std::atomic<uint32_t> muxSkips{0};            ///< Channel selections skipped since boot
+         uint32_t windowTransactions = 0;              ///< Transactions in the current error window
+         uint32_t windowErrors = 0;                    ///< Failures in the current error window
+     };
+     
+     /**
+      * @brief Clock state per physical bus
+      */
+     ClockState clockStates[PRESENCE_BUSES];
+     
+     /**
+      * @brief Arbitration between the tasks that use each physical bus
+      */
+     BusMutex busMutexes[PRESENCE_BUSES];
+     
+     /**
+      * @brief Switch a bus to a new clock
+      * @param port The I2C port
+      * @param clockFreq Clock frequency in Hz
+      * @return true if the bus is registered and initialized
+      */
+     bool applyClock(I2CPort port, uint32_t clockFreq);
+     
+     /**
+      * @brief Task entry point that runs one BusProbe
+      * @param pvParameters Pointer to the probe context
+      */
+     static void probeTaskFunction(void* pvParameters);
+     
  public:
+     /**
+      * @brief A list of addresses to probe on one bus, and the result
+      */
+     struct BusProbe {
+         I2CPort port;                  ///< Bus to probe
+         std::vector<int> candidates;   ///< Addresses to try
+         std::vector<int> found;        ///< [out] Addresses that acknowledged, in candidate order
+     };
+     
+
      /**
       * @brief Constructor for I2CManager
       * Initializes the manager and registers default I2C buses.
@@ -150,6 +275,38 @@
       */
      const WireConfig* getWireConfig(I2CPort port) const;
      
+     /**
+      * @brief Get the mutex that serializes access to a bus
+      * Hold it with a BusLock around every use of the bus's TwoWire,
+      * ideally once around a batch of transactions. Everything in this
+      * class that touches a bus takes it already.
+      * @param port The I2C port
+      * @return The bus mutex, or nullptr for a port without one
+      */
+     BusMutex* getBusMutex(I2CPort port);
+     
+     /**
+      * @brief Route a port's traffic through the bus multiplexer
+      * For a mux channel the TCA9548A is told to connect that channel, unless
+      * it was the last one selected on the bus and nothing has failed since,
+      * in which case no transaction is made. For a direct port every channel
+      * is disconnected, so a device behind the mux cannot answer in place of
+      * one on the trunk; on a bus where no multiplexer has been seen this is
+      * skipped entirely. Call with the bus mutex held, before the first
+      * transaction of a device on the port.
+      * @param port The I2C port
+      * @return true if the port's devices can now be addressed
+      */
+     bool selectPort(I2CPort port);
+     
+     /**
+      * @brief Forget which multiplexer channel is selected on a port's bus
+      * The next selectPort() on the bus then writes the channel again. Called
+      * whenever the multiplexer may have been reset behind the cache.
+      * @param port Any port of the bus
+      */
+     void invalidateMuxChannel(I2CPort port);
+     
      /**
       * @brief Check if a device is present at the specified address on a specific I2C port
       * @param port The I2C port to check
@@ -158,10 +315,176 @@
       */
      bool devicePresent(I2CPort port, int address);
      
+     /**
+      * @brief Free a bus that a device is holding
+      * A device reset or glitched mid-read can keep driving SDA low and
+      * block every transfer on the bus. If SDA is low, the bus is taken
+      * from the driver and SCL clocked up to I2C_RECOVERY_CLOCKS times
+      * until the device lets go, then a STOP is sent and the driver is
+      * restarted at its current clock. An idle bus is left untouched.
+      * @param port The I2C port
+      * @return true if SDA is released (or was never held), false otherwise
+      */
+     bool recoverBus(I2CPort port);
+     
+     /**
+      * @brief Get the result of the last probe of an address without touching the bus
+      * Updated by devicePresent(), scanBus() and probeConcurrently().
+      * @param port The I2C port
+      * @param address The I2C address
+      * @return What the last probe found, or UNKNOWN
+      */
+     DevicePresence getCachedPresence(I2CPort port, int address) const;
+     
+     /**
+      * @brief Probe several buses at the same time
+      * The first probe runs on the calling task and each other one on a
+      * short-lived task of its own, so the total time is that of the
+      * slowest bus. Probes of ports on the same physical bus, such as its
+      * mux channels, run one after another on that bus's task. Returns once
+      * every probe has finished.
+      * @param probes One entry per port; each port may appear only once
+      */
+     void probeConcurrently(std::vector<BusProbe>& probes);
+     
+     /**
+      * @brief Step a bus up to the fastest clock its devices still answer at
+      * Tries the limit first and then each standard rate below it, keeping
+      * the first at which every address acknowledges. A bus with nothing
+      * on it stays at the standard-mode rate. Must not run while another
+      * task uses the bus.
+      * @param port The I2C port
+      * @param maxClockFreq Fastest clock allowed by the configuration and the attached devices
+      * @param addresses Devices expected to answer
+      * @return The clock the bus was left at, or 0 if the port is not initialized
+      */
+     uint32_t negotiateClock(I2CPort port, uint32_t maxClockFreq, const std::vector<int>& addresses);
+     
+     /**
+      * @brief Ask for a bus clock change from any task
+      * The change is made by the next recordTransaction() for the bus,
+      * which runs on the task that owns the bus, so no transaction is cut
+      * short. If the new clock proves unreliable the error rate brings it
+      * back down.
+      * @param port The I2C port
+      * @param clockFreq Clock frequency in Hz
+      */
+     void requestClock(I2CPort port, uint32_t clockFreq);
+     
+     /**
+      * @brief Record the outcome of a driver transaction on a bus
+      * Once Constants::Sensors::I2C_CLOCK_WINDOW transactions have been
+      * seen, the bus steps down to the next slower standard rate if at
+      * least I2C_CLOCK_FALLBACK_ERRORS of them failed. Call from the task
+      * that owns the bus.
+      * @param port The I2C port
+      * @param success Whether the device acknowledged and returned data
+      */
+     void recordTransaction(I2CPort port, bool success);
+     
+     /**
+      * @brief Get the clock and error counters of a bus
+      * @param port The I2C port
+      * @return Current status; all zero for an unregistered port
+      */
+     BusClockStatus getClockStatus(I2CPort port) const;
+     
+     /**
+      * @brief Get the next standard I2C rate below a clock
+      * @param clockFreq Clock frequency in Hz
+      * @return The next slower of 1 MHz, 400 kHz, 100 kHz and 10 kHz, or clockFreq if none is slower
+      */
+     static uint32_t nextSlowerClock(uint32_t clockFreq);
+     
+     /**
+      * @brief Write a command to a device
+      * Every driver transaction goes through here or readBytes() so bus
+      * time is recorded under PerfSite::I2C_TRANSACTION.
+      * @param wire Bus to use
+      * @param address 7-bit device address
+      * @param data Bytes to send
+      * @param length Number of bytes
+      * @param sendStop false to keep the bus for a repeated-start read
+      * @return true if the device acknowledged
+      */
+     static bool writeBytes(TwoWire* wire, uint8_t address, const uint8_t* data, size_t length, bool sendStop = true);
+     
+     /**
+      * @brief Write a single command byte to a device
+      * @param wire Bus to use
+      * @param address 7-bit device address
+      * @param command Command byte
+      * @param sendStop false to keep the bus for a repeated-start read
+      * @return true if the device acknowledged
+      */
+     static bool writeCommand(TwoWire* wire, uint8_t address, uint8_t command, bool sendStop = true) {
+         return writeBytes(wire, address, &command, 1, sendStop);
+     }
+     
+     /**
+      * @brief Read a fixed number of bytes from a device
+      * @param wire Bus to use
+      * @param address 7-bit device address
+      * @param buffer [out] Received bytes
+      * @param length Number of bytes expected
+      * @return true if all bytes were received
+      */
+     static bool readBytes(TwoWire* wire, uint8_t address, uint8_t* buffer, size_t length);
+     
+     /**
+      * @brief Get the port of a multiplexer channel
+      * @param bus Physical bus the TCA9548A is attached to
+      * @param channel Channel, 0 to I2C_MUX_CHANNELS - 1
+      * @return The virtual port
+      */
+     static I2CPort muxPort(I2CPort bus, uint8_t channel) {
+         return static_cast<I2CPort>(static_cast<int>(I2CPort::I2C_MULTIPLEXED_START) +
+                                     static_cast<int>(bus) * Constants::Sensors::I2C_MUX_CHANNELS + channel);
+     }
+     
+     /**
+      * @brief Get the physical bus a port is on
+      * @param port The I2C port
+      * @return I2C0 or I2C1; the port itself for a direct port
+      */
+     static I2CPort physicalPort(I2CPort port) {
+         int channel = static_cast<int>(port) - static_cast<int>(I2CPort::I2C_MULTIPLEXED_START);
+         return channel < 0 ? port : static_cast<I2CPort>(channel / Constants::Sensors::I2C_MUX_CHANNELS);
+     }
+     
+     /**
+      * @brief Get the multiplexer channel of a port
+      * @param port The I2C port
+      * @return Channel number, or -1 for a direct port
+      */
+     static int muxChannel(I2CPort port) {
+         int channel = static_cast<int>(port) - static_cast<int>(I2CPort::I2C_MULTIPLEXED_START);
+         return channel < 0 ? -1 : channel % Constants::Sensors::I2C_MUX_CHANNELS;
+     }
+     
+     /**
+      * @brief Check whether a port number names a bus or mux channel that exists
+      * @param portNum Port as stored in SensorConfig::portNum
+      * @return true for I2C0, I2C1 and each of their mux channels
+      */
+     static bool isValidPort(int portNum) {
+         int channel = portNum - static_cast<int>(I2CPort::I2C_MULTIPLEXED_START);
+         return portNum == 0 || portNum == 1 ||
+                (channel >= 0 && channel < static_cast<int>(PRESENCE_BUSES * Constants::Sensors::I2C_MUX_CHANNELS));
+     }
+     
+     /**
+      * @brief Parse a port name
+      * @param portName "I2C0", "I2C1" or a mux channel such as "I2C0/mux:3", case-insensitive
+      * @param port [out] The parsed port
+      * @return true if the name is valid
+      */
+     static bool parsePort(const String& portName, I2CPort& port);
+     
      /**
       * @brief Convert a string port name to I2CPort enum
-      * @param portName The string port name (e.g., "I2C0", "I2C1")
-      * @return The corresponding I2CPort enum value
+      * @param portName The string port name (e.g., "I2C0", "I2C1", "I2C0/mux:3")
+      * @return The corresponding I2CPort enum value, I2C0 if unrecognized
       */
      static I2CPort stringToPort(const String& portName);
      
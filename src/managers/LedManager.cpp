@@ -1,17 +1,24 @@
 #include "LedManager.h"
+#include <algorithm>
+#include <climits>
 
 LedManager::LedManager(ErrorHandler* err, int pin, int powerPin, int numLeds)
     : errorHandler(err),
       neopixelPin(pin),
       neopixelPowerPin(powerPin),
       numPixels(numLeds),
-      pixel(numLeds, pin, NEO_GRB + NEO_KHZ800) {
+      pixel(numLeds, pin, NEO_GRB + NEO_KHZ800),
+      commandQueue(xQueueCreate(Constants::LED::COMMAND_QUEUE_DEPTH, sizeof(LedCommand))) {
 }
 
 LedManager::~LedManager() {
     // Turn off the LED
     setColor(COLOR_OFF, 0);
     
+    if (commandQueue) {
+        vQueueDelete(commandQueue);
+    }
+    
     // Disable power to NeoPixel if power pin is defined
     if (neopixelPowerPin >= 0) {
         digitalWrite(neopixelPowerPin, LOW);
@@ -35,165 +42,249 @@ bool LedManager::begin() {
         errorHandler->logError(INFO, "NeoPixel initialized on pin " + String(neopixelPin));
     }
     
-    // Set the setup color (yellow)
-    setSetupMode();
-    
+    // Show the setup color (yellow) now; the LED task takes over once it runs
     initialized = true;
+    setColor(COLOR_YELLOW, FULL_BRIGHTNESS);
     return true;
 }
 
 void LedManager::setColor(uint32_t color, uint8_t brightness) {
     if (!initialized) return;
+    if (color == shownColor && brightness == shownBrightness) return;
     
+    shownColor = color;
+    shownBrightness = brightness;
     pixel.setBrightness(brightness);
     pixel.setPixelColor(0, color);
     pixel.show();
 }
 
+bool LedManager::post(LedCommand command) {
+    if (!commandQueue) {
+        // No queue could be created; drive the pixel from the caller as before
+        apply(command, millis());
+        advance(millis());
+        return true;
+    }
+    
+    if (xQueueSend(commandQueue, &command, 0) == pdTRUE) {
+        return true;
+    }
+    
+    // Never lose a fatal error; it overrides everything still queued
+    if (command == LedCommand::FATAL) {
+        xQueueReset(commandQueue);
+        return xQueueSend(commandQueue, &command, 0) == pdTRUE;
+    }
+    return false;
+}
+
+void LedManager::setPixelPower(bool on) {
+    if (neopixelPowerPin < 0 || on == pixelPowered) return;
+    
+    if (!on) {
+        setColor(COLOR_OFF, 0);
+        digitalWrite(neopixelPowerPin, LOW);
+    } else {
+        digitalWrite(neopixelPowerPin, HIGH);
+    }
+    pixelPowered = on;
+    
+    // A freshly powered pixel shows nothing until it is written again
+    shownColor = UINT32_MAX;
+}
+
 void LedManager::setSetupMode() {
-    setColor(COLOR_YELLOW, FULL_BRIGHTNESS);
+    post(LedCommand::SETUP);
 }
 
 void LedManager::setNormalMode() {
-    // Only set normal mode if not in fatal error state
-    if (fatalErrorActive) return;
-    
-    setColor(COLOR_GREEN, DIM_BRIGHTNESS);
+    post(LedCommand::NORMAL);
 }
 
 void LedManager::indicateReading() {
-    // Don't override fatal errors or temporary error/warning indications
-    if (!initialized || fatalErrorActive || errorIndicationActive) return;
+    // One pulse in flight is enough; polls in between would only wake the LED task
+    if (readingPending.exchange(true)) return;
     
-    pulseActive = true;
-    pulseStartTime = millis();
-    
-    // Flash from dim green to bright green and back
-    setColor(COLOR_GREEN, FULL_BRIGHTNESS);
+    if (!post(LedCommand::READING)) {
+        readingPending = false;
+    }
 }
 
 void LedManager::startIdentify() {
-    // Don't override fatal errors
-    if (!initialized || fatalErrorActive) return;
-    
-    identifying = true;
-    identifyStartTime = millis();
-    
-    // Start with LED on
-    setColor(COLOR_BLUE, FULL_BRIGHTNESS);
+    post(LedCommand::IDENTIFY);
 }
 
 void LedManager::indicateWarning() {
-    if (!initialized || fatalErrorActive) return;  // Don't override fatal errors
-    
-    // Cancel any identification or pulse in progress
-    identifying = false;
-    pulseActive = false;
-    
-    // Set warning indication (orange)
-    errorIndicationActive = true;
-    errorIndicationStartTime = millis();
-    errorIndicationColor = COLOR_ORANGE;
-    setColor(COLOR_ORANGE, FULL_BRIGHTNESS);
+    post(LedCommand::WARNING);
 }
 
 void LedManager::indicateError() {
-    if (!initialized || fatalErrorActive) return;  // Don't override fatal errors
-    
-    // Cancel any identification or pulse in progress
-    identifying = false;
-    pulseActive = false;
-    
-    // Set error indication (red)
-    errorIndicationActive = true;
-    errorIndicationStartTime = millis();
-    errorIndicationColor = COLOR_RED;
-    setColor(COLOR_RED, FULL_BRIGHTNESS);
+    post(LedCommand::ERROR);
 }
 
 void LedManager::indicateFatalError() {
-    if (!initialized) return;
-    
-    // Cancel any other indications in progress
-    identifying = false;
-    pulseActive = false;
-    errorIndicationActive = false;
-    
-    // Set fatal error indication (permanent red)
-    fatalErrorActive = true;
-    setColor(COLOR_RED, FULL_BRIGHTNESS);
-    
-    if (errorHandler) {
-        errorHandler->logError(ERROR, "LED set to fatal error mode (permanently red)");
-    }
+    post(LedCommand::FATAL);
 }
 
 bool LedManager::isFatalError() const {
     return fatalErrorActive;
 }
 
-void LedManager::update() {
+bool LedManager::isIdentifying() const {
+    return identifying;
+}
+
+void LedManager::apply(LedCommand command, unsigned long now) {
+    switch (command) {
+        case LedCommand::SETUP:
+            setupMode = true;
+            break;
+            
+        case LedCommand::NORMAL:
+            setupMode = false;
+            break;
+            
+        case LedCommand::READING:
+            readingPending = false;
+            // Don't override fatal errors or temporary error/warning indications
+            if (fatalErrorActive || errorIndicationActive) break;
+            pulseActive = true;
+            pulseStartTime = now;
+            break;
+            
+        case LedCommand::IDENTIFY:
+            // Don't override fatal errors
+            if (fatalErrorActive) break;
+            identifying = true;
+            identifyStartTime = now;
+            break;
+            
+        case LedCommand::WARNING:
+        case LedCommand::ERROR:
+            if (fatalErrorActive) break;  // Don't override fatal errors
+            
+            // Cancel any identification or pulse in progress
+            identifying = false;
+            pulseActive = false;
+            
+            errorIndicationActive = true;
+            errorIndicationStartTime = now;
+            errorIndicationColor = (command == LedCommand::WARNING) ? COLOR_ORANGE : COLOR_RED;
+            break;
+            
+        case LedCommand::FATAL:
+            if (fatalErrorActive) break;
+            
+            // Cancel any other indications in progress
+            identifying = false;
+            pulseActive = false;
+            errorIndicationActive = false;
+            fatalErrorActive = true;
+            
+            if (errorHandler) {
+                errorHandler->logError(ERROR, "LED set to fatal error mode (permanently red)");
+            }
+            break;
+    }
+}
+
+void LedManager::advance(unsigned long now) {
     if (!initialized) return;
     
-    unsigned long currentTime = millis();
-    
-    // Don't do any other updates if we're in fatal error mode
+    // Fatal error overrides everything until restart
     if (fatalErrorActive) {
-        // Just ensure the LED stays red
+        setPixelPower(true);
         setColor(COLOR_RED, FULL_BRIGHTNESS);
         return;
     }
     
-    // Handle identification mode
+    // Expire finished indications
+    if (identifying && now - identifyStartTime >= Constants::LED::IDENTIFY_DURATION_MS) {
+        identifying = false;
+    }
+    if (errorIndicationActive && now - errorIndicationStartTime >= WARNING_ERROR_DURATION) {
+        errorIndicationActive = false;
+    }
+    if (pulseActive && now - pulseStartTime >= PULSE_DURATION) {
+        pulseActive = false;
+    }
+    
+    // Nothing but normal mode to show; in power save the pixel is simply off
+    bool idle = !identifying && !errorIndicationActive && !pulseActive && !setupMode;
+    setPixelPower(!(idle && powerSave));
+    if (idle && powerSave) {
+        return;
+    }
+    
+    // Identification takes precedence, then error indication, then the reading pulse
     if (identifying) {
-        unsigned long elapsed = currentTime - identifyStartTime;
-        int flashPhase = (elapsed / 250) % 2;  // 2Hz = 500ms period, 250ms per state
-        int flashCount = elapsed / 500;        // Complete cycles
-        
-        if (flashCount >= 10) {
-            // Identification complete after 10 flashes
-            identifying = false;
-            setNormalMode();  // Return to normal mode
+        unsigned long phase = (now - identifyStartTime) / Constants::LED::IDENTIFY_FLASH_RATE_MS;
+        if (phase % 2 == 0) {
+            setColor(COLOR_BLUE, FULL_BRIGHTNESS);
         } else {
-            // Set the LED based on flash phase
-            if (flashPhase == 0) {
-                setColor(COLOR_BLUE, FULL_BRIGHTNESS);
-            } else {
-                setColor(COLOR_OFF, 0);
-            }
+            setColor(COLOR_OFF, 0);
         }
-        
-        return;  // Exit early - identification takes precedence (except for fatal errors)
+    } else if (errorIndicationActive) {
+        setColor(errorIndicationColor, FULL_BRIGHTNESS);
+    } else if (pulseActive) {
+        setColor(COLOR_GREEN, FULL_BRIGHTNESS);
+    } else if (setupMode) {
+        setColor(COLOR_YELLOW, FULL_BRIGHTNESS);
+    } else {
+        setColor(COLOR_GREEN, DIM_BRIGHTNESS);
+    }
+}
+
+TickType_t LedManager::ticksUntilTransition(unsigned long now) const {
+    if (fatalErrorActive) {
+        return portMAX_DELAY;
     }
     
-    // Handle error/warning indication timeout
+    unsigned long waitMs = ULONG_MAX;
+    if (identifying) {
+        // Next flash edge; the sequence ends on one
+        unsigned long elapsed = now - identifyStartTime;
+        waitMs = std::min(waitMs, Constants::LED::IDENTIFY_FLASH_RATE_MS -
+                                  elapsed % Constants::LED::IDENTIFY_FLASH_RATE_MS);
+    }
     if (errorIndicationActive) {
-        unsigned long errorElapsed = currentTime - errorIndicationStartTime;
-        
-        if (errorElapsed >= WARNING_ERROR_DURATION) {
-            // Error indication complete, return to normal mode
-            errorIndicationActive = false;
-            setNormalMode();
-        } else {
-            // Ensure the error color is still showing
-            setColor(errorIndicationColor, FULL_BRIGHTNESS);
-        }
-        
-        return; // Exit early - error indication takes precedence over reading pulse
+        unsigned long elapsed = now - errorIndicationStartTime;
+        waitMs = std::min(waitMs, elapsed < WARNING_ERROR_DURATION ? WARNING_ERROR_DURATION - elapsed : 0UL);
     }
-    
-    // Handle reading pulse
     if (pulseActive) {
-        unsigned long pulseElapsed = currentTime - pulseStartTime;
-        
-        if (pulseElapsed >= PULSE_DURATION) {
-            // Pulse complete, return to dim green
-            pulseActive = false;
-            setColor(COLOR_GREEN, DIM_BRIGHTNESS);
-        }
+        unsigned long elapsed = now - pulseStartTime;
+        waitMs = std::min(waitMs, elapsed < PULSE_DURATION ? PULSE_DURATION - elapsed : 0UL);
     }
+    
+    if (waitMs == ULONG_MAX) {
+        return portMAX_DELAY;
+    }
+    // Round up so the task never wakes just before the transition and spins
+    return (waitMs * configTICK_RATE_HZ + 999) / 1000;
 }
 
-bool LedManager::isIdentifying() const {
-    return identifying;
-}
\ No newline at end of file
+void LedManager::process(TickType_t wait) {
+    LedCommand command;
+    
+    // Block for the first command, then take whatever else arrived meanwhile
+    while (commandQueue && xQueueReceive(commandQueue, &command, wait) == pdTRUE) {
+        apply(command, millis());
+        wait = 0;
+    }
+    advance(millis());
+}
+
+void LedManager::run() {
+    while (true) {
+        step(portMAX_DELAY);
+    }
+}
+
+void LedManager::step(TickType_t maxWait) {
+    process(std::min(ticksUntilTransition(millis()), maxWait));
+}
+
+void LedManager::update() {
+    process(0);
+}
@@ -12,6 +12,9 @@
 
  #include <Arduino.h>
  #include <Adafruit_NeoPixel.h>
+ #include <atomic>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/queue.h>
  #include "error/ErrorHandler.h"
  #include "Constants.h"
  
@@ -19,6 +22,9 @@
   * @brief Manager for controlling the onboard NeoPixel LED
   * This class provides a unified interface for controlling the system's LED
   * indicator, including state indication, error notification, and visual feedback.
+  * The state setters may be called from any task: they post a command to a
+  * queue drained by the LED task (run()), which also schedules the timed
+  * transitions itself and sleeps indefinitely while nothing changes.
   */
  class LedManager {
  private:
@@ -61,13 +67,36 @@
      const uint8_t FULL_BRIGHTNESS = Constants::LED::FULL_BRIGHTNESS;    ///< 100% brightness for active
      /** @} */
      
+     /**
+      * @brief Commands posted to the LED task
+      */
+     enum class LedCommand : uint8_t {
+         SETUP,      ///< Solid yellow
+         NORMAL,     ///< Dim green
+         READING,    ///< Short bright green pulse
+         IDENTIFY,   ///< Flash blue for IDENTIFY_DURATION_MS
+         WARNING,    ///< Orange for WARNING_ERROR_DURATION_MS
+         ERROR,      ///< Red for WARNING_ERROR_DURATION_MS
+         FATAL       ///< Permanent red
+     };
+     
+     /**
+      * @brief Commands from other tasks, drained by the LED task
+      * Only the task that drains the queue touches the NeoPixel, so RMT
+      * output never runs on two cores at once.
+      */
+     QueueHandle_t commandQueue = nullptr;
+     
      /**
       * @brief State tracking flags
+      * Owned by the draining task; the flags other tasks query are atomic.
       * @{
       */
-     bool initialized = false;           ///< Whether LED has been initialized
-     bool identifying = false;           ///< Whether identify mode is active
-     unsigned long identifyStartTime = 0; ///< When identify mode started
+     bool initialized = false;                       ///< Whether LED has been initialized
+     bool setupMode = true;                          ///< Whether the base color is setup yellow instead of normal green
+     std::atomic<bool> identifying{false};           ///< Whether identify mode is active
+     unsigned long identifyStartTime = 0;            ///< When identify mode started
+     std::atomic<bool> readingPending{false};        ///< A reading pulse is queued; further ones are dropped
      /** @} */
      
      /**
@@ -84,12 +113,22 @@
       * @{
       */
      bool errorIndicationActive = false;           ///< Whether error indication is active
-     bool fatalErrorActive = false;                ///< Whether in fatal error mode
+     std::atomic<bool> fatalErrorActive{false};    ///< Whether in fatal error mode
      unsigned long errorIndicationStartTime = 0;    ///< When error indication started
      const unsigned long WARNING_ERROR_DURATION = Constants::LED::WARNING_ERROR_DURATION_MS; ///< Duration of warning/error indication
      uint32_t errorIndicationColor = COLOR_OFF;    ///< Color of current error indication
      /** @} */
      
+     /**
+      * @brief Last output written, so unchanged states skip the RMT transfer
+      * @{
+      */
+     uint32_t shownColor = UINT32_MAX;   ///< Color on the pixel, UINT32_MAX before the first write
+     uint8_t shownBrightness = 0;        ///< Brightness on the pixel
+     bool powerSave = false;             ///< Switch the pixel off through its power pin when idle
+     bool pixelPowered = true;           ///< Whether the power pin is driven high
+     /** @} */
+     
      /**
       * @brief Set a solid color on the NeoPixel
       * @param color The color value (32-bit, format: 0x00RRGGBB)
@@ -97,6 +136,48 @@
       */
      void setColor(uint32_t color, uint8_t brightness = 255);
      
+     /**
+      * @brief Switch the NeoPixel supply on or off
+      * Does nothing without a power pin.
+      * @param on Whether the pixel should be powered
+      */
+     void setPixelPower(bool on);
+     
+     /**
+      * @brief Queue a command for the LED task
+      * A full queue drops the command, except FATAL, which replaces
+      * whatever is still queued since it overrides it anyway.
+      * @param command The command to post
+      * @return true if the command was queued
+      */
+     bool post(LedCommand command);
+     
+     /**
+      * @brief Apply a command to the state machine
+      * @param command The command to apply
+      * @param now Current millis()
+      */
+     void apply(LedCommand command, unsigned long now);
+     
+     /**
+      * @brief End expired indications and show the resulting state
+      * @param now Current millis()
+      */
+     void advance(unsigned long now);
+     
+     /**
+      * @brief Get the time until the state machine next changes on its own
+      * @param now Current millis()
+      * @return Ticks to wait, portMAX_DELAY if nothing is scheduled
+      */
+     TickType_t ticksUntilTransition(unsigned long now) const;
+     
+     /**
+      * @brief Wait for a command or the next transition, then process both
+      * @param wait Ticks to wait for the first command
+      */
+     void process(TickType_t wait);
+     
  public:
      /**
       * @brief Constructor for LedManager
@@ -120,6 +201,14 @@
       */
      bool begin();
      
+     /**
+      * @brief Power the pixel down while it would only show normal mode
+      * Used in low-power mode; the pixel is powered up again for every
+      * pulse, identify or error indication. Call before the LED task starts.
+      * @param enable Whether to power down when idle
+      */
+     void setPowerSave(bool enable) { powerSave = enable; }
+     
      /**
       * @brief Set LED to setup mode (solid yellow)
       * Used during system initialization to indicate setup in progress.
@@ -169,9 +258,25 @@
      void indicateFatalError();
      
      /**
-      * @brief Main update function for LED animations
-      * Must be called regularly from loop() or a task to update LED
-      * animations and state transitions.
+      * @brief Body of the LED task; never returns
+      * Blocks on the command queue with a timeout equal to the time until
+      * the next flash or indication expiry, so it only wakes when the
+      * output actually changes.
+      */
+     void run();
+     
+     /**
+      * @brief One iteration of the LED task
+      * Blocks like run(), but for at most maxWait ticks, so a supervised
+      * LED task can check in between iterations.
+      * @param maxWait Longest block in ticks
+      */
+     void step(TickType_t maxWait);
+     
+     /**
+      * @brief Process queued commands and due transitions without blocking
+      * For use only when no LED task is running; the LED must be driven
+      * from a single task.
       */
      void update();
      
@@ -0,0 +1,89 @@
+#include "PerfCounters.h"
+#include <algorithm>
+
+PerfHistogram PerfCounters::histograms[static_cast<size_t>(PerfSite::COUNT)];
+
+void PerfHistogram::record(uint32_t cycles) {
+    buckets[bucketOf(cycles)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t seen = minimum.load(std::memory_order_relaxed);
+    while (cycles < seen && !minimum.compare_exchange_weak(seen, cycles, std::memory_order_relaxed)) {
+    }
+    seen = maximum.load(std::memory_order_relaxed);
+    while (cycles > seen && !maximum.compare_exchange_weak(seen, cycles, std::memory_order_relaxed)) {
+    }
+}
+
+void PerfHistogram::reset() {
+    for (size_t i = 0; i < BUCKETS; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    minimum.store(UINT32_MAX, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+uint32_t PerfHistogram::percentile(uint32_t total, uint32_t permille) const {
+    // Rank of the sample at this percentile, counted from 1
+    uint32_t rank = static_cast<uint32_t>((static_cast<uint64_t>(total) * permille + 999) / 1000);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint32_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; b++) {
+        seen += buckets[b].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return b == BUCKETS - 1 ? UINT32_MAX : (uint32_t(2) << b) - 1;
+        }
+    }
+    return UINT32_MAX;
+}
+
+PerfHistogram::Summary PerfHistogram::summarize() const {
+    Summary summary = {};
+    summary.count = count.load(std::memory_order_relaxed);
+    if (summary.count == 0) {
+        return summary;
+    }
+
+    summary.min = minimum.load(std::memory_order_relaxed);
+    summary.max = maximum.load(std::memory_order_relaxed);
+    summary.p50 = std::min(percentile(summary.count, 500), summary.max);
+    summary.p99 = std::min(percentile(summary.count, 990), summary.max);
+    return summary;
+}
+
+void PerfCounters::record(PerfSite site, uint32_t cycles) {
+    histogram(site).record(cycles);
+}
+
+PerfHistogram& PerfCounters::histogram(PerfSite site) {
+    return histograms[static_cast<size_t>(site)];
+}
+
+void PerfCounters::resetAll() {
+    for (PerfHistogram& h : histograms) {
+        h.reset();
+    }
+}
+
+const char* PerfCounters::siteName(PerfSite site) {
+    switch (site) {
+        case PerfSite::SENSOR_UPDATE:   return "SENSOR_UPDATE";
+        case PerfSite::SHT41_READ:      return "SHT41_READ";
+        case PerfSite::SI7021_READ:     return "SI7021_READ";
+        case PerfSite::PT100_READ:      return "PT100_READ";
+        case PerfSite::I2C_TRANSACTION: return "I2C_TRANSACTION";
+        case PerfSite::SPI_TRANSACTION: return "SPI_TRANSACTION";
+        case PerfSite::COMMAND_LINE:    return "COMMAND_LINE";
+        case PerfSite::MEASURE:         return "MEASURE";
+        default:                        return "UNKNOWN";
+    }
+}
+
+float PerfCounters::cyclesToMicros(uint32_t cycles) {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    return mhz == 0 ? 0.0f : static_cast<float>(cycles) / mhz;
+}
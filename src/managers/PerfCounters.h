@@ -0,0 +1,157 @@
+/**
+ * @file PerfCounters.h
+ * @brief Cycle-counter latency histograms for hot code paths
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup managers
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <atomic>
+
+ /**
+  * @brief Instrumented code paths
+  */
+ enum class PerfSite : uint8_t {
+     SENSOR_UPDATE,     ///< One SensorManager acquisition cycle
+     SHT41_READ,        ///< SHT41 result fetch and conversion
+     SI7021_READ,       ///< Si7021 result fetch and conversion
+     PT100_READ,        ///< PT100 result fetch and conversion
+     I2C_TRANSACTION,   ///< One I2C write or read transaction
+     SPI_TRANSACTION,   ///< One batch of queued SPI DMA transfers
+     COMMAND_LINE,      ///< Reading and executing pending command lines
+     MEASURE,           ///< MEAS? handler
+     COUNT              ///< Number of sites
+ };
+
+ /**
+  * @brief Lock-free log2 histogram of cycle counts
+  * Bucket b holds samples in [2^b, 2^(b+1)), so recording costs one
+  * count-leading-zeros and a few relaxed atomic adds. Percentiles are
+  * resolved to the upper edge of the bucket they fall in, clamped to the
+  * observed maximum, so they are an upper bound within a factor of two.
+  */
+ class PerfHistogram {
+ public:
+     static const size_t BUCKETS = 32;   ///< One bucket per bit of a 32-bit cycle count
+
+     /**
+      * @brief Summary of the recorded samples, in cycles
+      */
+     struct Summary {
+         uint32_t count;   ///< Number of samples
+         uint32_t min;     ///< Smallest sample
+         uint32_t p50;     ///< Median (bucket upper bound)
+         uint32_t p99;     ///< 99th percentile (bucket upper bound)
+         uint32_t max;     ///< Largest sample
+     };
+
+     PerfHistogram() { reset(); }
+
+     PerfHistogram(const PerfHistogram&) = delete;
+     PerfHistogram& operator=(const PerfHistogram&) = delete;
+
+     /**
+      * @brief Add one sample
+      * @param cycles Duration in CPU cycles
+      */
+     void record(uint32_t cycles);
+
+     /**
+      * @brief Discard all samples
+      */
+     void reset();
+
+     /**
+      * @brief Compute count, extremes and percentiles
+      * Samples recorded concurrently may be partially included.
+      * @return Summary of the samples so far
+      */
+     Summary summarize() const;
+
+     /**
+      * @brief Get the bucket a sample falls in
+      * @param cycles Duration in CPU cycles
+      * @return Bucket index, floor(log2(cycles)), 0 for 0 and 1
+      */
+     static size_t bucketOf(uint32_t cycles) {
+         return cycles < 2 ? 0 : 31 - __builtin_clz(cycles);
+     }
+
+ private:
+     std::atomic<uint32_t> buckets[BUCKETS];   ///< Sample count per bucket
+     std::atomic<uint32_t> count;              ///< Total samples
+     std::atomic<uint32_t> minimum;            ///< Smallest sample
+     std::atomic<uint32_t> maximum;            ///< Largest sample
+
+     uint32_t percentile(uint32_t total, uint32_t permille) const;
+ };
+
+ /**
+  * @brief Per-site histograms shared by all tasks
+  */
+ class PerfCounters {
+ public:
+     /**
+      * @brief Read the CPU cycle counter of the calling core
+      * @return Current cycle count (wraps about every 18 s at 240 MHz)
+      */
+     static inline uint32_t now() { return ESP.getCycleCount(); }
+
+     /**
+      * @brief Record a duration for a site
+      * @param site Instrumented path
+      * @param cycles Duration in CPU cycles
+      */
+     static void record(PerfSite site, uint32_t cycles);
+
+     /**
+      * @brief Get the histogram of a site
+      * @param site Instrumented path
+      * @return The histogram
+      */
+     static PerfHistogram& histogram(PerfSite site);
+
+     /**
+      * @brief Discard the samples of every site
+      */
+     static void resetAll();
+
+     /**
+      * @brief Get the name reported for a site
+      * @param site Instrumented path
+      * @return Site name
+      */
+     static const char* siteName(PerfSite site);
+
+     /**
+      * @brief Convert a cycle count to microseconds at the current CPU clock
+      * @param cycles Duration in CPU cycles
+      * @return Duration in microseconds
+      */
+     static float cyclesToMicros(uint32_t cycles);
+
+ private:
+     static PerfHistogram histograms[static_cast<size_t>(PerfSite::COUNT)];
+ };
+
+ /**
+  * @brief Times the enclosing scope into a site's histogram
+  * Both ends read the same core's counter as long as the task is not
+  * migrated in between; the pinned tasks that run the instrumented paths
+  * never are.
+  */
+ class PerfScope {
+ public:
+     explicit PerfScope(PerfSite s) : site(s), start(PerfCounters::now()) {}
+     ~PerfScope() { PerfCounters::record(site, PerfCounters::now() - start); }
+
+     PerfScope(const PerfScope&) = delete;
+     PerfScope& operator=(const PerfScope&) = delete;
+
+ private:
+     PerfSite site;    ///< Site being timed
+     uint32_t start;   ///< Cycle count at entry
+ };
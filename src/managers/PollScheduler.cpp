@@ -0,0 +1,47 @@
+#include "PollScheduler.h"
+#include <algorithm>
+
+void PollScheduler::clear() {
+    heap.clear();
+}
+
+void PollScheduler::add(const SensorName& sensorName, uint32_t periodMs, TickType_t now) {
+    TickType_t period = pdMS_TO_TICKS(periodMs);
+    if (period == 0) {
+        period = 1;
+    }
+
+    heap.push_back({now, period, sensorName});
+    std::push_heap(heap.begin(), heap.end(), laterDeadline);
+}
+
+TickType_t PollScheduler::ticksUntilNextDue(TickType_t now) const {
+    if (heap.empty()) {
+        return portMAX_DELAY;
+    }
+
+    TickType_t next = heap.front().due;
+    return isAfter(next, now) ? next - now : 0;
+}
+
+size_t PollScheduler::collectDue(TickType_t now, std::vector<SensorName>& due) {
+    size_t count = 0;
+
+    while (!heap.empty() && !isAfter(heap.front().due, now)) {
+        std::pop_heap(heap.begin(), heap.end(), laterDeadline);
+        Entry& entry = heap.back();
+        due.push_back(entry.sensorName);
+        count++;
+
+        // Advance on the fixed grid to avoid drift; re-anchor if a whole period was missed
+        entry.due += entry.period;
+        if (!isAfter(entry.due, now)) {
+            entry.due = now + entry.period;
+            missedDeadlines++;
+        }
+
+        std::push_heap(heap.begin(), heap.end(), laterDeadline);
+    }
+
+    return count;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file PollScheduler.h
+ * @brief Deadline scheduler for per-sensor polling
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup task_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <vector>
+ #include <freertos/FreeRTOS.h>
+ #include "../sensors/SensorName.h"
+
+ /**
+  * @brief Min-heap of next-due times for sensor polling
+  * Each sensor is scheduled at its own configured polling rate. The
+  * acquisition task pops every sensor whose deadline has passed, reads
+  * them, and then sleeps until the earliest remaining deadline.
+  * Deadlines are kept in RTOS ticks and compared wrap-safely.
+  */
+ class PollScheduler {
+ public:
+     /**
+      * @brief Scheduled polling entry for a single sensor
+      */
+     struct Entry {
+         TickType_t due;        ///< Tick at which the sensor is next due
+         TickType_t period;     ///< Polling period in ticks
+         SensorName sensorName; ///< Name of the sensor to poll
+     };
+
+     /**
+      * @brief Remove all scheduled sensors
+      */
+     void clear();
+
+     /**
+      * @brief Schedule a sensor for periodic polling
+      * The first poll is due immediately.
+      * @param sensorName Name of the sensor
+      * @param periodMs Polling period in milliseconds
+      * @param now Current tick count
+      */
+     void add(const SensorName& sensorName, uint32_t periodMs, TickType_t now);
+
+     /**
+      * @brief Check if any sensors are scheduled
+      * @return true if the schedule is empty
+      */
+     bool empty() const { return heap.empty(); }
+
+     /**
+      * @brief Get the number of scheduled sensors
+      * @return Number of entries in the schedule
+      */
+     size_t size() const { return heap.size(); }
+
+     /**
+      * @brief Get the ticks remaining until the earliest deadline
+      * @param now Current tick count
+      * @return Ticks to wait (0 if a sensor is already due), or portMAX_DELAY if empty
+      */
+     TickType_t ticksUntilNextDue(TickType_t now) const;
+
+     /**
+      * @brief Pop all due sensors and reschedule them for their next period
+      * A sensor that has fallen more than a full period behind is
+      * re-anchored to now rather than being polled repeatedly to catch up.
+      * @param now Current tick count
+      * @param due [out] Names of the sensors that are due (appended); with
+      *            enough capacity reserved this never allocates
+      * @return Number of sensors that were due
+      */
+     size_t collectDue(TickType_t now, std::vector<SensorName>& due);
+
+     /**
+      * @brief Get the number of polls that fell a whole period behind
+      * Each re-anchored poll counts once; clear() keeps the count.
+      * @return Missed deadlines since construction
+      */
+     uint32_t getMissedDeadlines() const { return missedDeadlines; }
+
+ private:
+     std::vector<Entry> heap;        ///< Binary min-heap ordered by due tick
+     uint32_t missedDeadlines = 0;   ///< Re-anchored polls
+
+     /**
+      * @brief Wrap-safe check whether tick a is later than tick b
+      */
+     static bool isAfter(TickType_t a, TickType_t b) {
+         return static_cast<int32_t>(a - b) > 0;
+     }
+
+     /**
+      * @brief Heap comparator placing the earliest deadline at the front
+      */
+     static bool laterDeadline(const Entry& a, const Entry& b) {
+         return isAfter(a.due, b.due);
+     }
+ };
@@ -0,0 +1,71 @@
+#include "PowerManager.h"
+#include <algorithm>
+
+PowerManager::PowerManager(ErrorHandler* err)
+    : errorHandler(err) {
+}
+
+bool PowerManager::begin(bool lowPower) {
+    if (!lowPower) {
+        return true;
+    }
+
+    if (!busLock.create(ESP_PM_NO_LIGHT_SLEEP, "bus") || !hostLock.create(ESP_PM_NO_LIGHT_SLEEP, "usb_host")) {
+        errorHandler->logError(WARNING, "Power management not supported by this build, staying at full power");
+        return false;
+    }
+
+    esp_pm_config_esp32s3_t config = {};
+    config.max_freq_mhz = Constants::Power::MAX_CPU_FREQ_MHZ;
+    config.min_freq_mhz = Constants::Power::MIN_CPU_FREQ_MHZ;
+    config.light_sleep_enable = true;
+
+    // Light sleep needs tickless idle in the framework build; scale frequency regardless
+    esp_err_t result = esp_pm_configure(&config);
+    if (result == ESP_ERR_NOT_SUPPORTED) {
+        config.light_sleep_enable = false;
+        result = esp_pm_configure(&config);
+    }
+    if (result != ESP_OK) {
+        errorHandler->logFormatted(WARNING, "Power management configuration failed: %s", esp_err_to_name(result));
+        return false;
+    }
+
+    lowPowerActive = true;
+    lightSleepActive = config.light_sleep_enable;
+    LOG_INFO(errorHandler, "Low-power mode: %d-%d MHz, light sleep %s", config.min_freq_mhz,
+             config.max_freq_mhz, lightSleepActive ? "on" : "unavailable");
+    return true;
+}
+
+bool PowerManager::parseLowPower(const String& additional) {
+    String lower = additional;
+    lower.toLowerCase();
+
+    int pos = lower.indexOf("power:");
+    if (pos < 0) {
+        return false;
+    }
+    String value = lower.substring(pos + 6);
+    value.trim();
+    return value.startsWith("low");
+}
+
+void PowerManager::setHostConnected(bool connected) {
+    if (!lowPowerActive || hostHeld == connected) {
+        return;
+    }
+
+    hostHeld = connected;
+    if (connected) {
+        hostLock.acquire();
+    } else {
+        hostLock.release();
+    }
+    LOG_INFO(errorHandler, "USB host %s, light sleep %s", connected ? "connected" : "disconnected",
+             connected ? "held off" : "allowed");
+}
+
+uint32_t PowerManager::idleWakeMs(uint32_t awakeMs) const {
+    return lowPowerActive ? std::max(awakeMs, Constants::Power::IDLE_WAKE_MS) : awakeMs;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file PowerManager.h
+ * @brief Automatic light sleep and frequency scaling between polls
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup managers
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <atomic>
+ #include <esp_pm.h>
+ #include "error/ErrorHandler.h"
+ #include "Constants.h"
+
+ /**
+  * @brief Counted ESP-IDF power management lock
+  * Acquire and release nest, so a recursive bus mutex can pair them with
+  * each of its levels. A lock that was never created does nothing.
+  */
+ class PowerLock {
+ public:
+     PowerLock() = default;
+     PowerLock(const PowerLock&) = delete;
+     PowerLock& operator=(const PowerLock&) = delete;
+
+     /**
+      * @brief Create the underlying lock
+      * @param type What the lock prevents while held
+      * @param name Name shown by esp_pm_dump_locks()
+      * @return true if the lock exists
+      */
+     bool create(esp_pm_lock_type_t type, const char* name) {
+         return handle || esp_pm_lock_create(type, 0, name, &handle) == ESP_OK;
+     }
+
+     /**
+      * @brief Take one level of the lock
+      */
+     void acquire() {
+         if (handle) {
+             esp_pm_lock_acquire(handle);
+         }
+     }
+
+     /**
+      * @brief Release one level of the lock
+      */
+     void release() {
+         if (handle) {
+             esp_pm_lock_release(handle);
+         }
+     }
+
+ private:
+     esp_pm_lock_handle_t handle = nullptr;   ///< IDF lock, null until created
+ };
+
+ /**
+  * @brief Power-managed acquisition mode
+  * When enabled from the board configuration ("Power: low" in the
+  * "Additional" field), the CPU scales between MAX_CPU_FREQ_MHZ and
+  * MIN_CPU_FREQ_MHZ and, where the framework was built with tickless
+  * idle, the chip light-sleeps whenever every task is blocked. Sleep is
+  * held off only while a bus transaction is in progress (through the
+  * bus mutexes) and while a USB host is connected, since the USB
+  * Serial/JTAG link does not survive light sleep.
+  */
+ class PowerManager {
+ public:
+     /**
+      * @brief Constructor
+      * @param err Error handler for logging
+      */
+     explicit PowerManager(ErrorHandler* err);
+
+     /**
+      * @brief Configure power management
+      * With lowPower false nothing is changed and the CPU stays at full speed.
+      * @param lowPower Whether to enable frequency scaling and light sleep
+      * @return true if the requested mode is active
+      */
+     bool begin(bool lowPower);
+
+     /**
+      * @brief Parse the power mode from the board's "Additional" configuration
+      * @param additional Board additional configuration
+      * @return true for "Power: low"
+      */
+     static bool parseLowPower(const String& additional);
+
+     /**
+      * @brief Get the lock held around bus transactions
+      * @return Lock to hand to every BusMutex
+      */
+     PowerLock* getBusLock() { return &busLock; }
+
+     /**
+      * @brief Report whether a USB host is connected
+      * Light sleep is held off from connection until disconnection, so
+      * SCPI commands are answered immediately.
+      * @param connected Whether the host is present
+      */
+     void setHostConnected(bool connected);
+
+     /**
+      * @brief Stretch a backstop wake interval in low-power mode
+      * Tasks that are woken by events but also poll as a backstop pass
+      * their usual interval; in low-power mode it grows to
+      * Constants::Power::IDLE_WAKE_MS so the chip can stay asleep.
+      * @param awakeMs Interval used at full power
+      * @return Interval to sleep for
+      */
+     uint32_t idleWakeMs(uint32_t awakeMs) const;
+
+     /**
+      * @brief Check whether low-power mode is active
+      * @return true if frequency scaling is configured
+      */
+     bool isLowPower() const { return lowPowerActive; }
+
+     /**
+      * @brief Check whether automatic light sleep is active
+      * @return true if the chip sleeps when idle
+      */
+     bool isLightSleepEnabled() const { return lightSleepActive; }
+
+ private:
+     ErrorHandler* errorHandler;          ///< Error handler for logging
+     PowerLock busLock;                   ///< No light sleep during a bus transaction
+     PowerLock hostLock;                  ///< No light sleep while a USB host is connected
+     std::atomic<bool> hostHeld{false};   ///< Whether hostLock is taken
+     bool lowPowerActive = false;         ///< Frequency scaling configured
+     bool lightSleepActive = false;       ///< Automatic light sleep configured
+ };
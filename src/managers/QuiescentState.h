@@ -0,0 +1,96 @@
+/**
+ * @file QuiescentState.h
+ * @brief Grace-period tracking for read-copy-update of shared objects
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <stddef.h>
+ #include <stdint.h>
+
+ /**
+  * @brief Quiescent-state based reclamation domain
+  * Readers are long-running tasks that never take a lock. Each one calls
+  * quiescent() at a point in its loop where it holds no references to
+  * shared objects, and goes offline() around blocking waits so an idle
+  * reader never delays reclamation. A writer that unpublishes an object
+  * calls startGracePeriod() and may free the object once
+  * gracePeriodElapsed() returns true for the token, because every reader
+  * has since passed a quiescent point or been offline.
+  *
+  * All operations are sequentially consistent: a reader that reports
+  * after the writer's token was issued is guaranteed to load the newly
+  * published pointer on its next access.
+  * @tparam Readers Number of reader ids
+  */
+ template <size_t Readers>
+ class QuiescentState {
+ public:
+     static constexpr uint32_t OFFLINE = 0;   ///< Reader holds no references and is not reading
+
+     QuiescentState() : epoch(1) {
+         for (auto& seen : readerEpoch) {
+             seen.store(OFFLINE);
+         }
+     }
+
+     QuiescentState(const QuiescentState&) = delete;
+     QuiescentState& operator=(const QuiescentState&) = delete;
+
+     /**
+      * @brief Report that a reader holds no references
+      * Also brings an offline reader back online.
+      * @param reader Reader id
+      */
+     void quiescent(size_t reader) {
+         if (reader < Readers) {
+             readerEpoch[reader].store(epoch.load());
+         }
+     }
+
+     /**
+      * @brief Take a reader out of the domain, e.g. before it blocks
+      * Calling quiescent() again brings it back.
+      * @param reader Reader id
+      */
+     void offline(size_t reader) {
+         if (reader < Readers) {
+             readerEpoch[reader].store(OFFLINE);
+         }
+     }
+
+     /**
+      * @brief Begin a grace period after unpublishing an object
+      * @return Token to pass to gracePeriodElapsed()
+      */
+     uint32_t startGracePeriod() {
+         uint32_t token = epoch.fetch_add(1) + 1;
+         if (token == OFFLINE) {
+             token = epoch.fetch_add(1) + 1; // Skip the reserved value on wrap
+         }
+         return token;
+     }
+
+     /**
+      * @brief Check whether every reader has moved past a token
+      * @param token Value returned by startGracePeriod()
+      * @return true if objects retired before the token can be freed
+      */
+     bool gracePeriodElapsed(uint32_t token) const {
+         for (const auto& reader : readerEpoch) {
+             uint32_t seen = reader.load();
+             if (seen != OFFLINE && static_cast<int32_t>(seen - token) < 0) {
+                 return false;
+             }
+         }
+         return true;
+     }
+
+ private:
+     std::atomic<uint32_t> epoch;                  ///< Advanced by every grace period
+     std::atomic<uint32_t> readerEpoch[Readers];   ///< Epoch each reader last reported, or OFFLINE
+ };
@@ -0,0 +1,147 @@
+#include "ReadingHistory.h"
+#include <esp_heap_caps.h>
+#include <cstring>
+#include <memory>
+
+ReadingHistory::ReadingHistory(ErrorHandler* err)
+    : errorHandler(err),
+      records(nullptr),
+      depth(Constants::Sensors::HISTORY_DEPTH),
+      inPsram(true) {
+    for (auto& count : written) {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    size_t bytes = Constants::Sensors::MAX_SENSORS * depth * sizeof(HistoryRecord);
+    records = static_cast<HistoryRecord*>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+
+    if (!records) {
+        // No PSRAM: keep a short history in internal RAM
+        inPsram = false;
+        depth = Constants::Sensors::HISTORY_DEPTH_INTERNAL;
+        bytes = Constants::Sensors::MAX_SENSORS * depth * sizeof(HistoryRecord);
+        records = static_cast<HistoryRecord*>(malloc(bytes));
+    }
+
+    if (!records) {
+        depth = 0;
+        errorHandler->logError(ERROR, "Failed to allocate reading history");
+        return;
+    }
+
+    std::uninitialized_fill_n(records, Constants::Sensors::MAX_SENSORS * depth, HistoryRecord{});
+    errorHandler->logError(INFO, "Reading history: " + String(depth) + " records per sensor in " +
+                          (inPsram ? "PSRAM" : "internal RAM"));
+}
+
+ReadingHistory::~ReadingHistory() {
+    if (records) {
+        heap_caps_free(records);
+    }
+}
+
+void ReadingHistory::append(size_t slot, HistoryRecord record) {
+    if (depth == 0 || slot >= Constants::Sensors::MAX_SENSORS) {
+        return;
+    }
+
+    record.slot = static_cast<uint8_t>(slot);
+
+    // Sequence assignment and commit happen together so sequences become
+    // visible in order even when several bus workers append at once
+    portENTER_CRITICAL(&appendMux);
+    record.sequence = latestSequence.load(std::memory_order_relaxed) + 1;
+    uint32_t index = written[slot].load(std::memory_order_relaxed);
+    memcpy(&recordAt(slot, index), &record, sizeof(HistoryRecord));
+    written[slot].store(index + 1, std::memory_order_release);
+    latestSequence.store(record.sequence, std::memory_order_release);
+    portEXIT_CRITICAL(&appendMux);
+}
+
+void ReadingHistory::reset(size_t slot) {
+    if (slot >= Constants::Sensors::MAX_SENSORS) {
+        return;
+    }
+
+    portENTER_CRITICAL(&appendMux);
+    written[slot].store(0, std::memory_order_release);
+    portEXIT_CRITICAL(&appendMux);
+}
+
+bool ReadingHistory::readRecord(size_t slot, uint32_t index, HistoryRecord& out) const {
+    memcpy(&out, &recordAt(slot, index), sizeof(HistoryRecord));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // The writer overwrites this index while written == index + depth
+    return written[slot].load(std::memory_order_acquire) < index + depth;
+}
+
+size_t ReadingHistory::fetch(uint32_t afterSequence, uint32_t fromTimestamp, uint32_t slotMask,
+                             size_t maxRecords, const RecordVisitor& visitor) const {
+    if (depth == 0 || maxRecords == 0) {
+        return 0;
+    }
+
+    // Everything up to this sequence is fully committed in every ring
+    uint32_t limit = latestSequence.load(std::memory_order_acquire);
+
+    // Per-slot cursor [next, end) over logical indexes
+    uint32_t next[Constants::Sensors::MAX_SENSORS] = {};
+    uint32_t end[Constants::Sensors::MAX_SENSORS] = {};
+
+    for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+        if (!(slotMask & (1UL << slot))) {
+            continue;
+        }
+
+        end[slot] = written[slot].load(std::memory_order_acquire);
+        uint32_t low = end[slot] > depth ? end[slot] - depth : 0;
+
+        // Records are ordered within a ring, so binary search for the first match
+        uint32_t high = end[slot];
+        while (low < high) {
+            uint32_t mid = low + (high - low) / 2;
+            HistoryRecord record;
+            if (!readRecord(slot, mid, record) ||
+                record.sequence <= afterSequence || record.timestampMs() < fromTimestamp) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        next[slot] = low;
+    }
+
+    // Merge the rings in sequence order
+    size_t visited = 0;
+    while (visited < maxRecords) {
+        HistoryRecord best;
+        int bestSlot = -1;
+
+        for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+            while (next[slot] < end[slot]) {
+                HistoryRecord record;
+                if (!readRecord(slot, next[slot], record)) {
+                    next[slot]++; // Lapped by the writer, skip it
+                    continue;
+                }
+
+                if (record.sequence <= limit && (bestSlot < 0 || record.sequence < best.sequence)) {
+                    best = record;
+                    bestSlot = static_cast<int>(slot);
+                }
+                break;
+            }
+        }
+
+        if (bestSlot < 0) {
+            break;
+        }
+
+        visitor(best);
+        next[bestSlot]++;
+        visited++;
+    }
+
+    return visited;
+}
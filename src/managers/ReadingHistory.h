@@ -0,0 +1,204 @@
+/**
+ * @file ReadingHistory.h
+ * @brief PSRAM-backed circular history of sensor readings
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <atomic>
+ #include <functional>
+ #include <freertos/FreeRTOS.h>
+ #include "Constants.h"
+ #include "../error/ErrorHandler.h"
+ #include "../sensors/readings/SensorChannel.h"
+
+ /**
+  * @brief A single historical reading for one sensor
+  * Sequence numbers are global across all sensors and strictly increasing,
+  * so a host can resume a fetch from the last sequence it received.
+  *
+  * Only the sensor's own channels are stored, packed in InterfaceType
+  * order, so a record stays small however many quantities the system
+  * knows about; the channel mask makes each record self-describing.
+  */
+ struct HistoryRecord {
+     uint64_t timeUs = 0;                                     ///< Reading time in microseconds since boot
+     uint32_t sequence = 0;                                   ///< Global sequence number (0 = never written)
+     float values[Constants::Sensors::HISTORY_CHANNELS] = {}; ///< Values of the channels in the mask, in order
+     uint8_t slot = 0;                                        ///< Reading slot of the sensor
+     uint8_t channels = 0;                                    ///< channelBit() of each stored channel
+     uint8_t validMask = 0;                                   ///< channelBit() of each valid stored channel
+
+     /**
+      * @brief Pack the sensor's channels of a reading
+      * Channels beyond HISTORY_CHANNELS are not stored.
+      * @param reading Reading to store
+      * @param sensorChannels channelBit() of each channel the sensor provides
+      * @return Record with sequence and slot left unset
+      */
+     static HistoryRecord pack(const ChannelValues& reading, uint8_t sensorChannels) {
+         HistoryRecord record;
+         record.timeUs = reading.timeUs ? reading.timeUs : reading.timestamp * 1000ULL;
+         size_t index = 0;
+         forEachChannel(sensorChannels, [&](InterfaceType type) {
+             if (index < Constants::Sensors::HISTORY_CHANNELS) {
+                 record.values[index++] = reading.get(type);
+                 record.channels |= channelBit(type);
+             }
+         });
+         record.validMask = reading.validMask & record.channels;
+         return record;
+     }
+
+     /**
+      * @brief Get the reading time on the millis() scale
+      * @return Milliseconds since boot
+      */
+     uint32_t timestampMs() const {
+         return static_cast<uint32_t>(timeUs / 1000);
+     }
+
+     /**
+      * @brief Visit each stored channel, in InterfaceType order
+      * @param visit Callable taking (InterfaceType type, float value, bool valid)
+      */
+     template<typename Visitor>
+     void forEachValue(Visitor&& visit) const {
+         size_t index = 0;
+         forEachChannel(channels, [&](InterfaceType type) {
+             visit(type, values[index++], (validMask & channelBit(type)) != 0);
+         });
+     }
+
+     /**
+      * @brief Check whether a channel is stored and valid
+      * @param type Channel
+      * @return true if valid
+      */
+     bool isValid(InterfaceType type) const {
+         return (validMask & channelBit(type)) != 0;
+     }
+
+     /**
+      * @brief Get a stored channel's value
+      * @param type Channel
+      * @return The value, NaN if the channel is not stored
+      */
+     float get(InterfaceType type) const {
+         uint8_t bit = channelBit(type);
+         return (channels & bit) ? values[__builtin_popcount(channels & (bit - 1))] : NAN;
+     }
+ };
+
+
+ /**
+  * @brief Fixed-size time series of readings for every sensor slot
+  * Each slot owns a ring of Constants::Sensors::HISTORY_DEPTH records in
+  * PSRAM (falling back to a much smaller ring in internal RAM if PSRAM is
+  * unavailable). The acquisition workers append; the communication task
+  * reads without blocking them. A reader only reports records up to the
+  * global sequence it observed on entry, so a fetch never skips a record
+  * that is still being committed by another bus worker.
+  */
+ class ReadingHistory {
+ public:
+     /**
+      * @brief Callback invoked for each record returned by a fetch
+      */
+     typedef std::function<void(const HistoryRecord&)> RecordVisitor;
+
+     /**
+      * @brief Constructor - allocates the ring storage
+      * @param err Error handler for logging
+      */
+     explicit ReadingHistory(ErrorHandler* err);
+
+     /**
+      * @brief Destructor - releases the ring storage
+      */
+     ~ReadingHistory();
+
+     ReadingHistory(const ReadingHistory&) = delete;
+     ReadingHistory& operator=(const ReadingHistory&) = delete;
+
+     /**
+      * @brief Append a reading to a slot's ring
+      * The record's sequence and slot fields are assigned here.
+      * @param slot Reading slot of the sensor
+      * @param record Reading to store
+      */
+     void append(size_t slot, HistoryRecord record);
+
+     /**
+      * @brief Discard a slot's history
+      * Used when the slot is handed to a newly registered sensor.
+      * @param slot Reading slot
+      */
+     void reset(size_t slot);
+
+     /**
+      * @brief Visit records newer than a sequence number and timestamp, oldest first
+      * @param afterSequence Only records with a larger sequence are returned
+      * @param fromTimestamp Only records at or after this time are returned
+      * @param slotMask Bit mask of slots to include
+      * @param maxRecords Maximum number of records to visit
+      * @param visitor Callback for each record
+      * @return Number of records visited
+      */
+     size_t fetch(uint32_t afterSequence, uint32_t fromTimestamp, uint32_t slotMask,
+                  size_t maxRecords, const RecordVisitor& visitor) const;
+
+     /**
+      * @brief Get the sequence number of the most recent record
+      * @return Latest sequence (0 if nothing has been recorded)
+      */
+     uint32_t getLatestSequence() const { return latestSequence.load(std::memory_order_acquire); }
+
+     /**
+      * @brief Get the number of records kept per slot
+      * @return Ring depth (0 if allocation failed)
+      */
+     size_t getDepth() const { return depth; }
+
+     /**
+      * @brief Check whether the rings live in PSRAM
+      * @return true if PSRAM was used
+      */
+     bool isInPsram() const { return inPsram; }
+
+     /**
+      * @brief Get the size of the ring storage
+      * @return Bytes allocated for all slots
+      */
+     size_t getMemoryBytes() const { return depth * Constants::Sensors::MAX_SENSORS * sizeof(HistoryRecord); }
+
+ private:
+     ErrorHandler* errorHandler;     ///< Error reporting
+     HistoryRecord* records;         ///< MAX_SENSORS rings of depth records each
+     size_t depth;                   ///< Records per slot
+     bool inPsram;                   ///< Storage was allocated from PSRAM
+
+     std::atomic<uint32_t> written[Constants::Sensors::MAX_SENSORS];  ///< Records ever appended per slot
+     std::atomic<uint32_t> latestSequence{0};                          ///< Last committed sequence
+     portMUX_TYPE appendMux = portMUX_INITIALIZER_UNLOCKED;            ///< Orders appends across bus workers
+
+     /**
+      * @brief Get the storage for a record by slot and logical index
+      */
+     HistoryRecord& recordAt(size_t slot, uint32_t index) const {
+         return records[slot * depth + (index % depth)];
+     }
+
+     /**
+      * @brief Copy a record and check that it was not overwritten meanwhile
+      * @param slot Reading slot
+      * @param index Logical index of the record
+      * @param out [out] Copy of the record
+      * @return true if the copy is intact
+      */
+     bool readRecord(size_t slot, uint32_t index, HistoryRecord& out) const;
+ };
@@ -1,4 +1,15 @@
 #include "SPIManager.h"
+#include "PerfCounters.h"
+#include <esp_err.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+namespace {
+    /**
+     * @brief SPI peripheral driven by the manager; SPI1 is reserved for flash
+     */
+    const spi_host_device_t SPI_BUS_HOST = SPI2_HOST;
+}
 
 SPIManager::SPIManager(ErrorHandler* err) 
     : errorHandler(err),
@@ -6,11 +17,19 @@ SPIManager::SPIManager(ErrorHandler* err)
       mosiPin(DEFAULT_SPI_MOSI_PIN),
       misoPin(DEFAULT_SPI_MISO_PIN),
       sckPin(DEFAULT_SPI_SCK_PIN),
-      defaultSettings(1000000, MSBFIRST, SPI_MODE0) {
+      txBuffer(nullptr),
+      rxBuffer(nullptr) {
 }
 
 SPIManager::~SPIManager() {
-    // Nothing to clean up
+    for (auto& device : devices) {
+        spi_bus_remove_device(device.handle);
+    }
+    if (initialized) {
+        spi_bus_free(SPI_BUS_HOST);
+    }
+    heap_caps_free(txBuffer);
+    heap_caps_free(rxBuffer);
 }
 
 bool SPIManager::begin(int mosi, int miso, int sck) {
@@ -23,11 +42,31 @@ bool SPIManager::begin(int mosi, int miso, int sck) {
     misoPin = miso;
     sckPin = sck;
     
-    // Initialize SPI
-    SPI.begin(sckPin, misoPin, mosiPin);
+    // Staging buffers in internal RAM so the driver can DMA straight from and into them
+    const size_t stagingBytes = Constants::Sensors::SPI_MAX_BATCH * Constants::Sensors::SPI_MAX_TRANSFER_BYTES;
+    txBuffer = static_cast<uint8_t*>(heap_caps_malloc(stagingBytes, MALLOC_CAP_DMA));
+    rxBuffer = static_cast<uint8_t*>(heap_caps_malloc(stagingBytes, MALLOC_CAP_DMA));
+    if (!txBuffer || !rxBuffer) {
+        errorHandler->logError(ERROR, "Failed to allocate SPI DMA buffers");
+        return false;
+    }
+    
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = mosiPin;
+    bus.miso_io_num = misoPin;
+    bus.sclk_io_num = sckPin;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = Constants::Sensors::SPI_MAX_TRANSFER_BYTES;
+    
+    esp_err_t result = spi_bus_initialize(SPI_BUS_HOST, &bus, SPI_DMA_CH_AUTO);
+    if (result != ESP_OK) {
+        errorHandler->logError(ERROR, "SPI bus initialization failed: " + String(esp_err_to_name(result)));
+        return false;
+    }
     
     initialized = true;
-    errorHandler->logError(INFO, "SPI initialized with pins MOSI:" + String(mosiPin) + 
+    errorHandler->logError(INFO, "SPI initialized with DMA on pins MOSI:" + String(mosiPin) + 
                           " MISO:" + String(misoPin) + 
                           " SCK:" + String(sckPin));
     
@@ -61,51 +100,123 @@ bool SPIManager::registerSSPin(int ssPin) {
     return true;
 }
 
-bool SPIManager::beginTransaction(int ssPin, SPISettings settings) {
+SPIManager::Device* SPIManager::findDevice(int physicalPin) {
+    for (auto& device : devices) {
+        if (device.pin == physicalPin) {
+            return &device;
+        }
+    }
+    return nullptr;
+}
+
+bool SPIManager::addDevice(int ssPin, uint32_t clockHz, uint8_t mode) {
     if (!initialized) {
         errorHandler->logError(ERROR, "SPI not initialized");
         return false;
     }
     
-    // Map logical index to physical pin if needed
     int physicalPin = mapLogicalToPhysicalPin(ssPin);
-    
-    // Make sure the SS pin is registered
-    bool pinFound = false;
-    for (int pin : ssPins) {
-        if (pin == physicalPin) {
-            pinFound = true;
-            break;
-        }
+    BusLock lock(&busMutex);
+    if (!lock.owns()) {
+        errorHandler->logError(WARNING, "SPI bus busy, device on SS pin " + String(physicalPin) + " not attached");
+        return false;
     }
     
-    if (!pinFound) {
-        // Auto-register the pin if not found
-        registerSSPin(ssPin);
-        physicalPin = mapLogicalToPhysicalPin(ssPin);
+    Device* existing = findDevice(physicalPin);
+    if (existing && existing->clockHz == clockHz && existing->mode == mode) {
+        return true;
+    }
+    if (existing) {
+        spi_bus_remove_device(existing->handle);
+        devices.erase(devices.begin() + (existing - devices.data()));
     }
     
-    // Begin transaction
-    SPI.beginTransaction(settings);
-    digitalWrite(physicalPin, LOW); // Active state
+    spi_device_interface_config_t config = {};
+    config.mode = mode;
+    config.clock_speed_hz = clockHz;
+    config.spics_io_num = physicalPin;
+    config.queue_size = Constants::Sensors::SPI_MAX_BATCH;
+    
+    spi_device_handle_t handle = nullptr;
+    esp_err_t result = spi_bus_add_device(SPI_BUS_HOST, &config, &handle);
+    if (result != ESP_OK) {
+        errorHandler->logError(ERROR, "Failed to attach SPI device on SS pin " + String(physicalPin) + ": " + 
+                              String(esp_err_to_name(result)));
+        return false;
+    }
     
+    devices.push_back({physicalPin, clockHz, mode, handle});
+    errorHandler->logError(INFO, "Attached SPI device on SS pin " + String(physicalPin) + " at " + 
+                          String(clockHz) + " Hz, mode " + String(mode));
     return true;
 }
 
-void SPIManager::endTransaction(int ssPin) {
-    // Map logical index to physical pin if needed
-    int physicalPin = mapLogicalToPhysicalPin(ssPin);
-    
-    digitalWrite(physicalPin, HIGH); // Inactive state
-    SPI.endTransaction();
-}
-
-uint8_t SPIManager::transfer(uint8_t data) {
-    return SPI.transfer(data);
+bool SPIManager::transfer(int ssPin, uint8_t* data, size_t length) {
+    SPITransfer single = {ssPin, data, length};
+    return transferBatch(&single, 1);
 }
 
-void SPIManager::transfer(uint8_t* buffer, size_t size) {
-    SPI.transfer(buffer, size);
+bool SPIManager::transferBatch(SPITransfer* transfers, size_t count) {
+    if (!initialized) {
+        errorHandler->logError(ERROR, "SPI not initialized");
+        return false;
+    }
+    if (count == 0 || count > Constants::Sensors::SPI_MAX_BATCH) {
+        return false;
+    }
+    
+    PerfScope timing(PerfSite::SPI_TRANSACTION);
+    BusLock lock(&busMutex);
+    if (!lock.owns()) {
+        errorHandler->logError(WARNING, "SPI bus busy, " + String(count) + " transfers skipped");
+        return false;
+    }
+    
+    // Queue everything first; the driver runs the queue from its interrupt
+    spi_device_handle_t handles[Constants::Sensors::SPI_MAX_BATCH];
+    size_t queued = 0;
+    bool success = true;
+    for (; queued < count; queued++) {
+        const SPITransfer& request = transfers[queued];
+        Device* device = findDevice(mapLogicalToPhysicalPin(request.ssPin));
+        if (!device || request.length == 0 || request.length > Constants::Sensors::SPI_MAX_TRANSFER_BYTES) {
+            errorHandler->logError(ERROR, "Invalid SPI transfer on SS pin " + String(request.ssPin));
+            success = false;
+            break;
+        }
+        
+        uint8_t* tx = txBuffer + queued * Constants::Sensors::SPI_MAX_TRANSFER_BYTES;
+        memcpy(tx, request.data, request.length);
+        
+        spi_transaction_t& transaction = transactions[queued];
+        memset(&transaction, 0, sizeof(transaction));
+        transaction.length = request.length * 8;
+        transaction.tx_buffer = tx;
+        transaction.rx_buffer = rxBuffer + queued * Constants::Sensors::SPI_MAX_TRANSFER_BYTES;
+        transaction.user = reinterpret_cast<void*>(queued);
+        
+        if (spi_device_queue_trans(device->handle, &transaction,
+                                   pdMS_TO_TICKS(Constants::Sensors::BUS_LOCK_TIMEOUT_MS)) != ESP_OK) {
+            errorHandler->logError(ERROR, "Failed to queue SPI transfer on SS pin " + String(request.ssPin));
+            success = false;
+            break;
+        }
+        handles[queued] = device->handle;
+    }
+    
+    // Everything queued must be collected, even after a failure; each device returns its own in order
+    for (size_t i = 0; i < queued; i++) {
+        spi_transaction_t* done = nullptr;
+        if (spi_device_get_trans_result(handles[i], &done, portMAX_DELAY) != ESP_OK || !done) {
+            success = false;
+            continue;
+        }
+        size_t index = reinterpret_cast<size_t>(done->user);
+        memcpy(transfers[index].data, rxBuffer + index * Constants::Sensors::SPI_MAX_TRANSFER_BYTES,
+               transfers[index].length);
+    }
+    
+    return success;
 }
 
 bool SPIManager::testDevice(int ssPin) {
@@ -117,16 +228,18 @@ bool SPIManager::testDevice(int ssPin) {
         return false;
     }
     
-    bool success = beginTransaction(ssPin);
-    if (!success) {
-        return false;
+    // Nothing to clock until a sensor has attached its device with the settings it needs
+    if (!findDevice(mapLogicalToPhysicalPin(ssPin))) {
+        errorHandler->logError(INFO, "SPI test on SS pin " + String(ssPin) + " skipped, no device attached yet");
+        return true;
     }
     
     // Transfer a byte and check if we get something back
     // This may not be reliable for all devices, but it's a starting point
-    uint8_t response = transfer(0xFF); // Send dummy byte
-    
-    endTransaction(ssPin);
+    uint8_t response = 0xFF; // Send dummy byte
+    if (!transfer(ssPin, &response, 1)) {
+        return false;
+    }
     
     errorHandler->logError(INFO, "SPI test on SS pin " + String(ssPin) + 
                           " returned response: 0x" + String(response, HEX));
@@ -135,7 +248,3 @@ bool SPIManager::testDevice(int ssPin) {
     // For now, just return true as a placeholder
     return true;
 }
-
-SPIClass& SPIManager::getSPI() {
-    return SPI;
-}
\ No newline at end of file
@@ -12,10 +12,11 @@
  #pragma once
 
  #include <Arduino.h>
- #include <SPI.h>
+ #include <driver/spi_master.h>
  #include <vector>
  #include "../error/ErrorHandler.h"
  #include "Constants.h"
+ #include "BusLock.h"
  
  /**
   * @brief Default SPI pin definitions
@@ -27,10 +28,25 @@
  constexpr int DEFAULT_SPI_SS_PIN = -1;   ///< No default SS pin
  /** @} */
  
+ /**
+  * @brief One transfer of a batch
+  */
+ struct SPITransfer {
+     int ssPin;         ///< SS pin of the device (logical index or physical pin)
+     uint8_t* data;     ///< [in,out] Bytes to send, replaced by the bytes received
+     size_t length;     ///< Number of bytes
+ };
+ 
  /**
   * @brief Class for managing SPI communications with sensors
   * This class provides a centralized management system for SPI communications,
   * handling bus initialization, device selection, and transaction management.
+  *
+  * The bus is driven by the ESP-IDF SPI master driver with DMA rather
+  * than by Arduino's SPIClass, so a transfer costs the CPU only its
+  * setup: the calling task sleeps until the driver's interrupt reports
+  * completion. Each sensor attaches its chip select with addDevice() and
+  * the peripheral drives it during transfers.
   */
  class SPIManager {
  private:
@@ -55,9 +71,47 @@
      /** @} */
      
      /**
-      * @brief Default settings for SPI communications
+      * @brief A device attached with addDevice()
+      */
+     struct Device {
+         int pin;                      ///< Physical SS pin
+         uint32_t clockHz;             ///< SPI clock
+         uint8_t mode;                 ///< SPI mode
+         spi_device_handle_t handle;   ///< Driver handle
+     };
+     
+     /**
+      * @brief Attached devices
+      */
+     std::vector<Device> devices;
+     
+     /**
+      * @brief DMA-capable staging for outgoing bytes, one slot per batch entry
+      */
+     uint8_t* txBuffer;
+     
+     /**
+      * @brief DMA-capable staging for incoming bytes, one slot per batch entry
       */
-     SPISettings defaultSettings;
+     uint8_t* rxBuffer;
+     
+     /**
+      * @brief Driver descriptors of the batch in flight
+      */
+     spi_transaction_t transactions[Constants::Sensors::SPI_MAX_BATCH];
+     
+     /**
+      * @brief Find an attached device
+      * @param physicalPin Physical SS pin
+      * @return The device, or nullptr if none is attached there
+      */
+     Device* findDevice(int physicalPin);
+     
+     /**
+      * @brief Arbitration between the tasks that use the bus
+      * Held for each transfer batch; a worker may hold it across several.
+      */
+     BusMutex busMutex;
      
  public:
      /**
@@ -112,34 +166,35 @@
      bool registerSSPin(int ssPin);
      
      /**
-      * @brief Begin an SPI transaction
-      * Begins an SPI transaction with the specified SS pin and settings.
-      * @param ssPin The SS pin to use (logical index or physical pin)
-      * @param settings The SPI settings to use (default: SPISettings())
-      * @return true if transaction initialization succeeded, false otherwise
-      */
-     bool beginTransaction(int ssPin, SPISettings settings = SPISettings());
-     
-     /**
-      * @brief End an SPI transaction
-      * Ends the current SPI transaction and deselects the specified SS pin.
-      * @param ssPin The SS pin to deselect (logical index or physical pin)
+      * @brief Attach a device to the bus on one of the SS pins
+      * The pin is then driven by the SPI peripheral for every transfer to
+      * the device. Attaching again with other settings replaces the old ones.
+      * @param ssPin The SS pin of the device (logical index or physical pin)
+      * @param clockHz SPI clock for this device
+      * @param mode SPI mode 0-3
+      * @return true if the device can be used with transfer()
       */
-     void endTransaction(int ssPin);
+     bool addDevice(int ssPin, uint32_t clockHz = Constants::Sensors::SPI_DEFAULT_CLOCK_HZ, uint8_t mode = 0);
      
      /**
-      * @brief Transfer a single byte over SPI
-      * @param data The byte to send
-      * @return The byte received during the transfer
+      * @brief Perform one full-duplex transfer by DMA
+      * @param ssPin The SS pin of an attached device (logical index or physical pin)
+      * @param data [in,out] Bytes to send, replaced by the bytes received
+      * @param length Number of bytes, at most Constants::Sensors::SPI_MAX_TRANSFER_BYTES
+      * @return true if the transfer completed
       */
-     uint8_t transfer(uint8_t data);
+     bool transfer(int ssPin, uint8_t* data, size_t length);
      
      /**
-      * @brief Transfer multiple bytes over SPI
-      * @param buffer Pointer to the data buffer (in-place transfer)
-      * @param size Number of bytes to transfer
+      * @brief Queue several transfers and wait for all of them
+      * Everything is queued to the driver before the first result is
+      * collected, so the transfers run back-to-back by DMA while the
+      * calling task sleeps. Transfers may go to different devices.
+      * @param transfers [in,out] Transfers in bus order; data is replaced by the bytes received
+      * @param count Number of transfers, at most Constants::Sensors::SPI_MAX_BATCH
+      * @return true if every transfer completed
       */
-     void transfer(uint8_t* buffer, size_t size);
+     bool transferBatch(SPITransfer* transfers, size_t count);
      
      /**
       * @brief Test if an SPI device is present
@@ -151,10 +206,12 @@
      bool testDevice(int ssPin);
      
      /**
-      * @brief Get the SPI class instance
-      * @return Reference to the SPI instance
+      * @brief Get the mutex that serializes access to the bus
+      * Holding it with a BusLock around a batch of transactions keeps other
+      * tasks off the bus between them; each transfer takes it anyway.
+      * @return The bus mutex
       */
-     SPIClass& getSPI();
+     BusMutex* getBusMutex() { return &busMutex; }
      
      /**
       * @brief Get the MOSI pin
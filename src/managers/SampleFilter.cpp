@@ -0,0 +1,320 @@
+#include "SampleFilter.h"
+#include <algorithm>
+
+namespace {
+    /**
+     * @brief Find the text following a "Key:" label, ignoring case
+     * @param lower Lower-cased settings string
+     * @param key Lower-case label including the colon
+     * @return Text after the label with leading spaces removed, or empty if absent
+     */
+    String valueAfter(const String& lower, const char* key) {
+        int pos = lower.indexOf(key);
+        if (pos < 0) {
+            return String();
+        }
+        String value = lower.substring(pos + strlen(key));
+        value.trim();
+        return value;
+    }
+
+    /**
+     * @brief Find a setting given per channel or for every channel
+     * @param lower Lower-cased settings string
+     * @param name Lower-case setting name, e.g. "rate"
+     * @param keyword Channel keyword from SensorChannel.h
+     * @return Text after "<name> <keyword>:" if present, otherwise after "<name>:"
+     */
+    String channelValueAfter(const String& lower, const char* name, const char* keyword) {
+        String label = String(name) + " " + keyword + ":";
+        label.toLowerCase();
+        String own = valueAfter(lower, label.c_str());
+        return own.length() > 0 ? own : valueAfter(lower, (String(name) + ":").c_str());
+    }
+}
+
+FilterSettings FilterSettings::parse(const String& additional) {
+    FilterSettings settings;
+    if (additional.length() == 0) {
+        return settings;
+    }
+
+    String lower = additional;
+    lower.toLowerCase();
+
+    // "Filter: <kind> <parameter>"
+    String filter = valueAfter(lower, "filter:");
+    if (filter.length() > 0) {
+        int space = filter.indexOf(' ');
+        String kind = space > 0 ? filter.substring(0, space) : filter;
+        String parameter = space > 0 ? filter.substring(space + 1) : String();
+        parameter.trim();
+
+        if (kind.startsWith("boxcar") || kind.startsWith("median")) {
+            long window = parameter.toInt();
+            if (window >= 2 && window <= (long)Constants::Sensors::FILTER_MAX_WINDOW) {
+                settings.kind = kind.startsWith("boxcar") ? FilterKind::BOXCAR : FilterKind::MEDIAN;
+                settings.window = window;
+            }
+        } else if (kind.startsWith("ema")) {
+            float alpha = parameter.toFloat();
+            if (alpha > 0.0f && alpha <= 1.0f) {
+                settings.kind = FilterKind::EMA;
+                settings.alpha = alpha;
+            }
+        }
+    }
+
+    // "Decimate: <n>"
+    String decimate = valueAfter(lower, "decimate:");
+    if (decimate.length() > 0) {
+        long decimation = decimate.toInt();
+        if (decimation >= 1 && decimation <= Constants::Sensors::FILTER_MAX_DECIMATION) {
+            settings.decimation = decimation;
+        }
+    }
+
+    return settings;
+}
+
+ReportSettings ReportSettings::parse(const String& additional) {
+    ReportSettings settings;
+    if (additional.length() == 0) {
+        return settings;
+    }
+
+    String lower = additional;
+    lower.toLowerCase();
+
+    // "Deadband: <value>" covers every channel; "Deadband <keyword>:" overrides it
+    float shared = valueAfter(lower, "deadband:").toFloat();
+    for (const ChannelDescriptor& channel : CHANNEL_DESCRIPTORS) {
+        String label = String("deadband ") + channel.keyword + ":";
+        label.toLowerCase();
+        float own = valueAfter(lower, label.c_str()).toFloat();
+        settings.deadband[static_cast<size_t>(channel.quantity)] = std::max(own > 0.0f ? own : shared, 0.0f);
+    }
+
+    long heartbeat = valueAfter(lower, "heartbeat:").toInt();
+    if (heartbeat > 0) {
+        settings.heartbeatMs = heartbeat;
+    }
+    return settings;
+}
+
+QualitySettings::QualitySettings() {
+    for (const ChannelDescriptor& channel : CHANNEL_DESCRIPTORS) {
+        minimum[static_cast<size_t>(channel.quantity)] = channel.minimum;
+        maximum[static_cast<size_t>(channel.quantity)] = channel.maximum;
+    }
+}
+
+QualitySettings QualitySettings::parse(const String& additional) {
+    QualitySettings settings;
+    if (additional.length() == 0) {
+        return settings;
+    }
+
+    String lower = additional;
+    lower.toLowerCase();
+
+    if (valueAfter(lower, "quality:").startsWith("off")) {
+        settings.enabled = false;
+        return settings;
+    }
+
+    for (const ChannelDescriptor& channel : CHANNEL_DESCRIPTORS) {
+        size_t index = static_cast<size_t>(channel.quantity);
+
+        // "Range <keyword>: <min>..<max>"; an empty or inverted range keeps the plausible one
+        String label = String("range ") + channel.keyword + ":";
+        label.toLowerCase();
+        String range = valueAfter(lower, label.c_str());
+        int dots = range.indexOf("..");
+        if (dots > 0) {
+            float low = range.substring(0, dots).toFloat();
+            float high = range.substring(dots + 2).toFloat();
+            if (low < high) {
+                settings.minimum[index] = low;
+                settings.maximum[index] = high;
+            }
+        }
+
+        float rate = channelValueAfter(lower, "rate", channel.keyword).toFloat();
+        settings.maxRate[index] = std::max(rate, 0.0f);
+
+        long stuck = channelValueAfter(lower, "stuck", channel.keyword).toInt();
+        if (stuck >= 2 && stuck <= UINT16_MAX) {
+            settings.stuckSamples[index] = stuck;
+        }
+    }
+
+    float sigma = valueAfter(lower, "outlier:").toFloat();
+    settings.outlierSigma = std::max(sigma, 0.0f);
+    return settings;
+}
+
+void SampleQuality::Channel::reset() {
+    *this = Channel();
+}
+
+QualityCode SampleQuality::Channel::check(const QualitySettings& settings, size_t index, float value,
+                                          uint32_t timestamp) {
+    if (value < settings.minimum[index] || value > settings.maximum[index]) {
+        return QualityCode::OUT_OF_RANGE;
+    }
+
+    // Counted over every plausible sample, so a stuck value stays rejected until it moves
+    repeats = value == previous ? std::min<uint16_t>(repeats + 1, UINT16_MAX - 1) : 0;
+    previous = value;
+    if (settings.stuckSamples[index] > 0 && repeats + 1 >= settings.stuckSamples[index]) {
+        return QualityCode::STUCK;
+    }
+
+    QualityCode code = QualityCode::GOOD;
+    if (settings.maxRate[index] > 0.0f && !isnan(accepted) && timestamp != acceptedAt) {
+        float seconds = (timestamp - acceptedAt) / 1000.0f;
+        if (fabsf(value - accepted) > settings.maxRate[index] * seconds) {
+            code = QualityCode::RATE_OF_CHANGE;
+        }
+    }
+    if (code == QualityCode::GOOD && settings.outlierSigma > 0.0f && count >= Constants::Sensors::QUALITY_WARMUP) {
+        float floor = Constants::Sensors::QUALITY_SIGMA_FLOOR * (settings.maximum[index] - settings.minimum[index]);
+        float sigma = std::max(sqrtf(m2 / (count - 1)), floor);
+        if (fabsf(value - mean) > settings.outlierSigma * sigma) {
+            code = QualityCode::OUTLIER;
+        }
+    }
+
+    if (code != QualityCode::GOOD) {
+        if (++rejections < Constants::Sensors::QUALITY_RELOCK_SAMPLES) {
+            return code;
+        }
+        // Rejected too often in a row to be glitches: the signal has moved, so start over there
+        count = 0;
+        mean = 0.0f;
+        m2 = 0.0f;
+    }
+    rejections = 0;
+
+    // Welford's update; once the window is full the oldest share of m2 is forgotten first
+    if (count < Constants::Sensors::QUALITY_WINDOW) {
+        count++;
+    } else {
+        m2 -= m2 / count;
+    }
+    float delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+
+    accepted = value;
+    acceptedAt = timestamp;
+    return QualityCode::GOOD;
+}
+
+void SampleQuality::configure(const QualitySettings& newSettings) {
+    settings = newSettings;
+    reset();
+}
+
+void SampleQuality::reset() {
+    for (Channel& channel : channels) {
+        channel.reset();
+    }
+}
+
+uint8_t SampleQuality::process(SensorSample& sample) {
+    if (!settings.enabled) {
+        return 0;
+    }
+
+    uint8_t rejected = 0;
+    forEachChannel(sample.validMask, [&](InterfaceType type) {
+        size_t index = static_cast<size_t>(type);
+        float reported = sample.values[index] * channelDescriptor(type).scale;
+        QualityCode code = channels[index].check(settings, index, reported, sample.timestamp);
+        if (code != QualityCode::GOOD) {
+            sample.set(type, qualityNaN(code));
+            rejected |= channelBit(type);
+        }
+    });
+    return rejected;
+}
+
+void SampleFilter::Channel::reset() {
+    head = 0;
+    count = 0;
+    average = NAN;
+}
+
+float SampleFilter::Channel::apply(const FilterSettings& settings, float value) {
+    switch (settings.kind) {
+        case FilterKind::EMA:
+            average = isnan(average) ? value : average + settings.alpha * (value - average);
+            return average;
+
+        case FilterKind::BOXCAR:
+        case FilterKind::MEDIAN: {
+            window[head] = value;
+            head = (head + 1) % settings.window;
+            if (count < settings.window) {
+                count++;
+            }
+
+            if (settings.kind == FilterKind::BOXCAR) {
+                // Summed afresh each time so rounding errors never accumulate
+                float sum = 0.0f;
+                for (uint8_t i = 0; i < count; i++) {
+                    sum += window[i];
+                }
+                return sum / count;
+            }
+
+            // Insertion sort of a copy; the window is at most FILTER_MAX_WINDOW long
+            float sorted[Constants::Sensors::FILTER_MAX_WINDOW];
+            for (uint8_t i = 0; i < count; i++) {
+                float entry = window[i];
+                int j = i - 1;
+                while (j >= 0 && sorted[j] > entry) {
+                    sorted[j + 1] = sorted[j];
+                    j--;
+                }
+                sorted[j + 1] = entry;
+            }
+            return (count % 2) ? sorted[count / 2] : 0.5f * (sorted[count / 2 - 1] + sorted[count / 2]);
+        }
+
+        case FilterKind::NONE:
+        default:
+            return value;
+    }
+}
+
+void SampleFilter::configure(const FilterSettings& newSettings) {
+    settings = newSettings;
+    reset();
+}
+
+void SampleFilter::reset() {
+    for (Channel& channel : channels) {
+        channel.reset();
+    }
+    skipped = 0;
+}
+
+bool SampleFilter::process(SensorSample& sample) {
+    if (settings.isPassThrough() || !sample.anyValid()) {
+        return true;
+    }
+
+    forEachChannel(sample.validMask, [&](InterfaceType type) {
+        size_t index = static_cast<size_t>(type);
+        sample.values[index] = channels[index].apply(settings, sample.values[index]);
+    });
+
+    if (++skipped < settings.decimation) {
+        return false;
+    }
+    skipped = 0;
+    return true;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file SampleFilter.h
+ * @brief Per-sensor quality checks, smoothing, decimation and reporting settings
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include "Constants.h"
+ #include "../sensors/readings/SensorSample.h"
+
+ /**
+  * @brief Kind of smoothing applied to each channel
+  */
+ enum class FilterKind : uint8_t {
+     NONE,      ///< Pass samples through unchanged
+     BOXCAR,    ///< Mean of the last N samples
+     MEDIAN,    ///< Median of the last N samples, rejects isolated spikes
+     EMA        ///< Exponential moving average with smoothing factor alpha
+ };
+
+ /**
+  * @brief Filter settings of one sensor
+  * Parsed from SensorConfig::additional, in the same free-form style as
+  * the PT100 settings, e.g. "Filter: median 5, Decimate: 10" or
+  * "Filter: ema 0.2". Unknown or out-of-range values fall back to the
+  * defaults, which leave samples untouched.
+  */
+ struct FilterSettings {
+     FilterKind kind = FilterKind::NONE;   ///< Smoothing kernel
+     uint8_t window = 1;                   ///< Samples per boxcar or median window
+     float alpha = 1.0f;                   ///< EMA smoothing factor, 0 < alpha <= 1
+     uint16_t decimation = 1;              ///< Publish every Nth filtered sample
+
+     /**
+      * @brief Parse filter settings from a sensor's additional settings
+      * @param additional SensorConfig::additional string
+      * @return Parsed settings
+      */
+     static FilterSettings parse(const String& additional);
+
+     /**
+      * @brief Check whether the settings change samples at all
+      * @return true if samples are passed through as they are
+      */
+     bool isPassThrough() const {
+         return kind == FilterKind::NONE && decimation <= 1;
+     }
+ };
+
+ /**
+  * @brief Report-by-exception settings of one sensor's streamed channels
+  * Parsed from SensorConfig::additional, e.g. "Deadband: 0.1, Heartbeat: 60000"
+  * for every channel or "Deadband TEMP: 0.05, Deadband HUM: 0.5" per
+  * channel, using the channel keywords of SensorChannel.h. Deadbands are
+  * in the channel's reported unit. A channel is streamed when it moves more than its deadband
+  * from the value last streamed, changes validity, or has been silent
+  * for the heartbeat interval. A deadband of 0 streams every sample.
+  */
+ struct ReportSettings {
+     float deadband[CHANNEL_COUNT] = {};   ///< Per channel, indexed by InterfaceType; 0 = stream every sample
+     uint32_t heartbeatMs = 0;             ///< Longest silence per channel, 0 = none
+
+     /**
+      * @brief Get the deadband of a channel
+      * @param type Channel
+      * @return Deadband in the channel's reported unit
+      */
+     float deadbandFor(InterfaceType type) const {
+         return deadband[static_cast<size_t>(type)];
+     }
+
+     /**
+      * @brief Parse report settings from a sensor's additional settings
+      * @param additional SensorConfig::additional string
+      * @return Parsed settings
+      */
+     static ReportSettings parse(const String& additional);
+ };
+
+ /**
+  * @brief Quality checks of one sensor's channels
+  * Parsed from SensorConfig::additional, e.g. "Range TEMP: -40..125,
+  * Rate: 2, Stuck: 30, Outlier: 5". Ranges and rate limits are in the
+  * channel's reported unit, rate limits per second; Rate and Stuck also
+  * take a channel keyword, like Deadband. A channel without its own range
+  * is held to the plausible range in SensorChannel.h. The rate, stuck
+  * and outlier checks are off unless set, and "Quality: off" turns every
+  * check off.
+  */
+ struct QualitySettings {
+     bool enabled = true;                           ///< Whether samples are checked at all
+     float minimum[CHANNEL_COUNT];                  ///< Lowest accepted value, indexed by InterfaceType
+     float maximum[CHANNEL_COUNT];                  ///< Highest accepted value, indexed by InterfaceType
+     float maxRate[CHANNEL_COUNT] = {};             ///< Largest change per second, 0 = unlimited
+     uint16_t stuckSamples[CHANNEL_COUNT] = {};     ///< Identical consecutive samples that count as stuck, 0 = never
+     float outlierSigma = 0.0f;                     ///< Standard deviations from the running mean rejected, 0 = off
+
+     /**
+      * @brief Constructor - plausible ranges only
+      */
+     QualitySettings();
+
+     /**
+      * @brief Parse quality settings from a sensor's additional settings
+      * @param additional SensorConfig::additional string
+      * @return Parsed settings
+      */
+     static QualitySettings parse(const String& additional);
+ };
+
+ /**
+  * @brief Quality checks of one sensor, run in its bus's acquisition task
+  * Runs on the raw sample, before SampleFilter, so a rejected value never
+  * reaches the filter window, the reading table, the history or the host.
+  * Each valid channel is checked against its range, the stuck detector,
+  * its rate limit from the last accepted value and its distance from a
+  * running mean and variance (Welford's method, with a memory of
+  * Constants::Sensors::QUALITY_WINDOW samples). Rate and outlier
+  * rejections in a row are taken as a real step after
+  * Constants::Sensors::QUALITY_RELOCK_SAMPLES, and the statistics restart
+  * from the new level. O(1) per channel and sample; never allocates.
+  */
+ class SampleQuality {
+ public:
+     /**
+      * @brief Apply new settings and drop all history
+      * @param settings Quality settings
+      */
+     void configure(const QualitySettings& settings);
+
+     /**
+      * @brief Drop all history, keeping the settings
+      */
+     void reset();
+
+     /**
+      * @brief Check every valid channel of a sample
+      * @param sample [in,out] Raw sample; rejected channels are replaced by
+      *               the qualityNaN() of the reason
+      * @return channelBit() of each channel rejected
+      */
+     uint8_t process(SensorSample& sample);
+
+     /**
+      * @brief Get the active settings
+      * @return Quality settings
+      */
+     const QualitySettings& getSettings() const { return settings; }
+
+ private:
+     /**
+      * @brief Running state of one channel, in the reported unit
+      */
+     struct Channel {
+         uint16_t count = 0;           ///< Samples in the running statistics, at most QUALITY_WINDOW
+         float mean = 0.0f;            ///< Running mean of accepted values
+         float m2 = 0.0f;              ///< Running sum of squared deviations of accepted values
+         float accepted = NAN;         ///< Last accepted value, NaN before the first
+         uint32_t acceptedAt = 0;      ///< Timestamp of the last accepted value (millis)
+         float previous = NAN;         ///< Last in-range value, accepted or not
+         uint16_t repeats = 0;         ///< Consecutive samples equal to previous
+         uint8_t rejections = 0;       ///< Consecutive rate or outlier rejections
+
+         /**
+          * @brief Drop all history
+          */
+         void reset();
+
+         /**
+          * @brief Check one value and, if it passes, add it to the history
+          * @param settings Quality settings
+          * @param index Channel index
+          * @param value Value in the reported unit
+          * @param timestamp When the value was measured (millis)
+          * @return GOOD, or why the value is rejected
+          */
+         QualityCode check(const QualitySettings& settings, size_t index, float value, uint32_t timestamp);
+     };
+
+     QualitySettings settings;           ///< Active settings
+     Channel channels[CHANNEL_COUNT];    ///< State of each channel, indexed by InterfaceType
+ };
+
+ /**
+  * @brief Filter state of one sensor, run in its bus's acquisition task
+  * Holds a fixed window per channel, so filtering never allocates. Each
+  * valid channel of a sample is filtered independently; a sample with no
+  * valid channel is passed on at once so failures are not delayed.
+  */
+ class SampleFilter {
+ public:
+     /**
+      * @brief Apply new settings and drop all history
+      * @param settings Filter settings
+      */
+     void configure(const FilterSettings& settings);
+
+     /**
+      * @brief Drop all history, keeping the settings
+      */
+     void reset();
+
+     /**
+      * @brief Feed one sample through the filter
+      * @param sample [in,out] Raw sample; replaced by the filtered values
+      * @return true if the sample should be published, false if decimated away
+      */
+     bool process(SensorSample& sample);
+
+     /**
+      * @brief Get the active settings
+      * @return Filter settings
+      */
+     const FilterSettings& getSettings() const { return settings; }
+
+ private:
+     /**
+      * @brief Window and running state of one channel
+      */
+     struct Channel {
+         float window[Constants::Sensors::FILTER_MAX_WINDOW];   ///< Ring of recent inputs
+         uint8_t head = 0;       ///< Next ring position to write
+         uint8_t count = 0;      ///< Valid entries in the ring
+         float average = NAN;    ///< EMA state, NaN until the first input
+
+         /**
+          * @brief Drop all history
+          */
+         void reset();
+
+         /**
+          * @brief Add an input and compute the filtered value
+          * @param settings Filter settings
+          * @param value New input
+          * @return Filtered value
+          */
+         float apply(const FilterSettings& settings, float value);
+     };
+
+     FilterSettings settings;            ///< Active settings
+     Channel channels[CHANNEL_COUNT];    ///< State of each channel, indexed by InterfaceType
+     uint16_t skipped = 0;        ///< Filtered samples since the last published one
+ };
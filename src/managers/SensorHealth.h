@@ -0,0 +1,104 @@
+/**
+ * @file SensorHealth.h
+ * @brief Recovery state and backoff of a disconnected sensor
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <algorithm>
+ #include "Constants.h"
+
+ /**
+  * @brief Whether a sensor is being read or being recovered
+  */
+ enum class SensorHealth : uint8_t {
+     HEALTHY,      ///< Connected and polled by its bus's acquisition worker
+     RECOVERING    ///< Disconnected; the recovery worker retries it with backoff
+ };
+
+ /**
+  * @brief Convert a health state to its display name
+  * @param health The health state
+  * @return Upper-case name of the state
+  */
+ inline const char* sensorHealthToString(SensorHealth health) {
+     switch (health) {
+         case SensorHealth::HEALTHY: return "HEALTHY";
+         case SensorHealth::RECOVERING: return "RECOVERING";
+         default: return "UNKNOWN";
+     }
+ }
+
+ /**
+  * @brief Health of one sensor as published by the recovery worker
+  * The first attempt is made as soon as a sensor is seen disconnected;
+  * each failed attempt doubles the wait before the next one, from
+  * RECOVERY_BACKOFF_MIN_MS up to RECOVERY_BACKOFF_MAX_MS, so a sensor
+  * that has been unplugged for an hour costs almost nothing.
+  */
+ struct SensorHealthStatus {
+     SensorHealth state = SensorHealth::HEALTHY;   ///< Current state
+     uint32_t attempts = 0;                        ///< Failed recovery attempts since the sensor dropped out
+     uint32_t backoffMs = 0;                       ///< Wait after the next failed attempt
+     uint32_t nextAttempt = 0;                     ///< millis() at which the next attempt is due
+     uint32_t since = 0;                           ///< millis() at which the state last changed
+
+     /**
+      * @brief Note that the sensor has dropped out
+      * Has no effect if it is already recovering.
+      * @param now Current millis()
+      */
+     void markFailed(uint32_t now) {
+         if (state == SensorHealth::RECOVERING) {
+             return;
+         }
+         state = SensorHealth::RECOVERING;
+         attempts = 0;
+         backoffMs = Constants::Sensors::RECOVERY_BACKOFF_MIN_MS;
+         nextAttempt = now;
+         since = now;
+     }
+
+     /**
+      * @brief Note that the sensor is connected again
+      * @param now Current millis()
+      */
+     void markHealthy(uint32_t now) {
+         if (state != SensorHealth::HEALTHY) {
+             *this = SensorHealthStatus();
+             since = now;
+         }
+     }
+
+     /**
+      * @brief Record the outcome of a recovery attempt
+      * @param success Whether the sensor was brought back
+      * @param now Current millis()
+      */
+     void recordAttempt(bool success, uint32_t now) {
+         if (success) {
+             markHealthy(now);
+             return;
+         }
+         attempts++;
+         nextAttempt = now + backoffMs;
+         backoffMs = std::min(backoffMs * 2, Constants::Sensors::RECOVERY_BACKOFF_MAX_MS);
+     }
+
+     /**
+      * @brief Get the time until the next attempt is due
+      * @param now Current millis()
+      * @return Milliseconds to wait, 0 if due now, UINT32_MAX if healthy
+      */
+     uint32_t msUntilAttempt(uint32_t now) const {
+         if (state != SensorHealth::RECOVERING) {
+             return UINT32_MAX;
+         }
+         int32_t remaining = static_cast<int32_t>(nextAttempt - now);
+         return remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+     }
+ };
@@ -1,4 +1,8 @@
 #include "SensorManager.h"
+#include "Constants.h"
+#include "PerfCounters.h"
+#include <esp_timer.h>
+#include <algorithm>
 
 SensorManager::SensorManager(ConfigManager* configMgr, I2CManager* i2c, ErrorHandler* err, SPIManager* spi)
         : registry(err),
@@ -7,15 +11,24 @@ SensorManager::SensorManager(ConfigManager* configMgr, I2CManager* i2c, ErrorHan
         i2cManager(i2c),
         spiManager(spi),
         errorHandler(err),
+        history(err),
         maxCacheAge(5000) {  // Default 5-second cache age
-        readingCacheA.clear();
-        readingCacheB.clear();
+    std::fill(std::begin(slotBus), std::end(slotBus), AcquisitionBus::COUNT);
+    std::fill(std::begin(slotPort), std::end(slotPort), I2CPort::I2C0);
+    std::fill(std::begin(slotAddress), std::end(slotAddress), 0);
+    std::fill(std::begin(slotPollingRate), std::end(slotPollingRate), Constants::System::MAX_POLLING_RATE_MS);
 }
 
 SensorManager::~SensorManager() {
+    // The acquisition tasks are gone by now, so nothing can still hold a sensor
     auto sensors = registry.clear();
     for (auto sensor : sensors) {
-        delete sensor;
+        factory.destroySensor(sensor);
+    }
+    for (const auto& retired : retiredSensors) {
+        for (auto sensor : retired.sensors) {
+            factory.destroySensor(sensor);
+        }
     }
 }
 
@@ -25,7 +38,7 @@ bool SensorManager::initializeSensors() {
         if (!i2cManager->beginPort(I2CPort::I2C0)) {
             errorHandler->logError(ERROR, "Failed to initialize I2C0");
         } else {
-            errorHandler->logError(INFO, "Initialized I2C0 bus");
+            LOG_INFO(errorHandler, "Initialized I2C0 bus");
         }
     }
     
@@ -33,7 +46,7 @@ bool SensorManager::initializeSensors() {
         if (!i2cManager->beginPort(I2CPort::I2C1)) {
             errorHandler->logError(ERROR, "Failed to initialize I2C1");
         } else {
-            errorHandler->logError(INFO, "Initialized I2C1 bus");
+            LOG_INFO(errorHandler, "Initialized I2C1 bus");
         }
     }
     
@@ -42,39 +55,68 @@ bool SensorManager::initializeSensors() {
         if (!spiManager->begin()) {
             errorHandler->logError(ERROR, "Failed to initialize SPI");
         } else {
-            errorHandler->logError(INFO, "Initialized SPI bus");
+            LOG_INFO(errorHandler, "Initialized SPI bus");
         }
     }
     
-    // Scan I2C buses for devices
-    std::vector<int> foundAddressesI2C0;
-    std::vector<int> foundAddressesI2C1;
-    
-    errorHandler->logError(INFO, "Scanning I2C0 bus for devices...");
-    bool i2c0HasDevices = i2cManager->scanBus(I2CPort::I2C0, foundAddressesI2C0);
+    // Probe the configured I2C addresses on both buses at once; a full scan is on request only
+    std::vector<I2CManager::BusProbe> probes;
+    discoverI2CDevices(false, probes);
     
-    errorHandler->logError(INFO, "Scanning I2C1 bus for devices...");
-    bool i2c1HasDevices = i2cManager->scanBus(I2CPort::I2C1, foundAddressesI2C1);
-
-    if (!i2c0HasDevices && !i2c1HasDevices) {
+    bool anyFound = std::any_of(probes.begin(), probes.end(),
+                                [](const I2CManager::BusProbe& probe) { return !probe.found.empty(); });
+    if (!anyFound) {
         errorHandler->logError(WARNING, "No I2C devices found on any bus - check wiring if using I2C sensors!");
     }
     
-    auto sensorConfigs = configManager->getSensorConfigs();
-    bool atLeastOneInitialized = false;
+    // Sensors live in a pool sized from the configuration, not on the heap
+    factory.reservePool(configManager->getSensorConfigs().size());
+    applySensorConfigs(configManager->getSensorConfigs());
+    negotiateI2CClocks();
     
-    // Clear any existing sensors and update info
-    auto existingSensors = registry.clear();
-    for (auto sensor : existingSensors) {
-        delete sensor;
+    if (registry.count() == 0) {
+        errorHandler->logError(ERROR, "No sensors were initialized");
+        return false;
     }
     
-    // Create and initialize sensors
-    for (const auto& config : sensorConfigs) {
+    return true;
+}
+
+bool SensorManager::applySensorConfigs(const std::vector<SensorConfig>& configs) {
+    // Determine which sensors to add and remove
+    std::vector<SensorConfig> sensorsToAdd;
+    std::vector<String> sensorsToRemove;
+    compareConfigurations(activeConfigs, configs, sensorsToAdd, sensorsToRemove);
+    
+    std::vector<ISensor*> nextSensors;
+    std::vector<SensorConfig> nextConfigs;
+    std::vector<ISensor*> created;
+    bool allSuccess = true;
+    
+    for (const auto& config : configs) {
+        bool duplicate = std::any_of(nextConfigs.begin(), nextConfigs.end(),
+                                     [&](const SensorConfig& taken) { return taken.name == config.name; });
+        if (duplicate) {
+            errorHandler->logError(WARNING, "Ignoring duplicate sensor name in configuration: " + config.name);
+            allSuccess = false;
+            continue;
+        }
+        
+        // Unchanged sensors carry over as they are, mid-conversion or not
+        ISensor* existing = registry.getSensorByName(config.name);
+        bool changed = std::any_of(sensorsToAdd.begin(), sensorsToAdd.end(),
+                                   [&](const SensorConfig& added) { return added.name == config.name; });
+        if (existing && !changed) {
+            nextSensors.push_back(existing);
+            nextConfigs.push_back(config);
+            continue;
+        }
+        
         // Test communication before initializing sensor
         if (config.communicationType == CommunicationType::SPI) {
             if (!spiManager) {
                 errorHandler->logError(ERROR, "SPI manager not available for sensor: " + config.name);
+                allSuccess = false;
                 continue;
             }
             testSPICommunication(config.address);
@@ -83,34 +125,112 @@ bool SensorManager::initializeSensors() {
             testI2CCommunication(static_cast<I2CPort>(config.portNum), config.address);
         }
         
-        // Create the sensor
+        // Create and initialize the sensor off to the side; nothing can see it yet,
+        // but its bus is shared with the running workers
         ISensor* sensor = factory.createSensor(config);
-        if (!sensor) {
-            errorHandler->logError(ERROR, "Failed to create sensor: " + config.name);
-            continue;
+        bool initialized = false;
+        if (sensor) {
+            BusLock lock(getBusMutex(getAcquisitionBus(config)));
+            bool selected = config.communicationType != CommunicationType::I2C ||
+                            i2cManager->selectPort(static_cast<I2CPort>(config.portNum));
+            initialized = lock.owns() && selected && sensor->initialize();
         }
-        
-        // Initialize the sensor
-        if (!sensor->initialize()) {
-            errorHandler->logError(ERROR, "Failed to initialize sensor: " + config.name);
-            delete sensor;
+        if (!initialized) {
+            factory.destroySensor(sensor);
+            errorHandler->logError(ERROR, "Failed to create/initialize sensor: " + config.name);
+            allSuccess = false;
             continue;
         }
         
-        // Register the sensor
-        registry.registerSensor(sensor);
-        
-        errorHandler->logError(INFO, "Sensor added to system: " + config.name + " with polling rate: " + 
+        created.push_back(sensor);
+        nextSensors.push_back(sensor);
+        nextConfigs.push_back(config);
+        LOG_INFO(errorHandler, "Sensor added to system: " + config.name + " with polling rate: " + 
                            String(config.pollingRate) + "ms");
-        atLeastOneInitialized = true;
     }
     
-    if (!atLeastOneInitialized) {
-        errorHandler->logError(ERROR, "No sensors were initialized");
+    // Publish the whole set at once; a reused slot must not expose the previous occupant's readings
+    std::vector<ISensor*> removed;
+    bool swapped = registry.replaceSensors(nextSensors, removed, [&](int slot, ISensor* sensor) {
+        readings.reset(slot);
+        history.reset(slot);
+        health.reset(slot);
+        
+        auto config = std::find_if(nextConfigs.begin(), nextConfigs.end(),
+                                   [&](const SensorConfig& candidate) { return candidate.name == sensor->getName(); });
+        String additional = config != nextConfigs.end() ? config->additional : String();
+        qualityChecks[slot].configure(QualitySettings::parse(additional));
+        filters[slot].configure(FilterSettings::parse(additional));
+        reportSettings[slot] = ReportSettings::parse(additional);
+        slotBus[slot] = config != nextConfigs.end() ? getAcquisitionBus(*config) : AcquisitionBus::COUNT;
+        slotPort[slot] = config != nextConfigs.end() && config->communicationType == CommunicationType::I2C ?
+                         static_cast<I2CPort>(config->portNum) : I2CPort::I2C0;
+        slotAddress[slot] = config != nextConfigs.end() ? static_cast<uint8_t>(config->address) : 0;
+        slotPollingRate[slot] = config != nextConfigs.end() ? clampPollingRate(config->pollingRate) :
+                                Constants::System::MAX_POLLING_RATE_MS;
+    });
+    if (!swapped) {
+        for (auto sensor : created) {
+            factory.destroySensor(sensor);
+        }
+        errorHandler->logError(ERROR, "Failed to apply sensor configuration");
         return false;
     }
+    activeConfigs = nextConfigs;
+    applyI2CClockLimits();
     
-    return true;
+    // A changed polling rate keeps the sensor, so every slot's rate is refreshed
+    // before the generation bump below sends the workers to rebuild their schedules
+    for (const auto& config : nextConfigs) {
+        int slot = registry.getSlot(config.name);
+        if (slot >= 0) {
+            slotPollingRate[slot] = clampPollingRate(config.pollingRate);
+        }
+    }
+    
+    // The workers may still be reading the sensors that were swapped out
+    if (!removed.empty()) {
+        for (auto sensor : removed) {
+            LOG_INFO(errorHandler, "Removing sensor: " + sensor->getName());
+        }
+        retiredSensors.push_back({registry.startGracePeriod(), removed});
+    }
+    
+    // Polling rates may have changed even when no sensors were added or removed,
+    // and waking the workers brings them to their next quiescent point sooner
+    notifyTopologyChanged();
+    
+    size_t waiting = reclaimRetiredSensors(Constants::Sensors::RECLAIM_WAIT_MS);
+    if (waiting > 0) {
+        errorHandler->logError(WARNING, String(waiting) + " removed sensors still in use, deleting them later");
+    }
+    
+    return allSuccess;
+}
+
+size_t SensorManager::reclaimRetiredSensors(uint32_t waitMs) {
+    unsigned long startTime = millis();
+    
+    while (true) {
+        size_t waiting = 0;
+        for (auto it = retiredSensors.begin(); it != retiredSensors.end();) {
+            if (registry.gracePeriodElapsed(it->token)) {
+                for (auto sensor : it->sensors) {
+                    factory.destroySensor(sensor);
+                }
+                it = retiredSensors.erase(it);
+            } else {
+                waiting += it->sensors.size();
+                ++it;
+            }
+        }
+        
+        if (waiting == 0 || millis() - startTime >= waitMs) {
+            registry.reclaimSnapshots();
+            return waiting;
+        }
+        vTaskDelay(1);
+    }
 }
 
 bool SensorManager::reconfigureSensors(const String& configJson) {
@@ -125,7 +245,6 @@ bool SensorManager::reconfigureSensors(const String& configJson) {
     }
     
     // Extract configurations from JSON
-    std::vector<SensorConfig> oldConfigs = configManager->getSensorConfigs();
     std::vector<SensorConfig> newConfigs;
     
     // Extract I2C peripherals - UPDATED to use new naming scheme "Peripheral" in JSON
@@ -143,12 +262,8 @@ bool SensorManager::reconfigureSensors(const String& configJson) {
             // Optional fields with defaults
             if (peripheral["I2C Port"].is<String>()) {
                 String portStr = peripheral["I2C Port"].as<String>();
-                // Extract port number (I2C0 -> 0, I2C1 -> 1, etc.)
-                if (portStr.startsWith("I2C")) {
-                    config.portNum = portStr.substring(3).toInt();
-                } else {
-                    config.portNum = 0; // Default to I2C0
-                }
+                // I2C0 -> 0, I2C1 -> 1, a mux channel such as I2C0/mux:3 -> its I2CPort value
+                config.portNum = static_cast<int>(I2CManager::stringToPort(portStr));
             } else {
                 config.portNum = 0; // Default to I2C0
             }
@@ -191,11 +306,6 @@ bool SensorManager::reconfigureSensors(const String& configJson) {
         }
     }
     
-    // Determine which sensors to add and remove
-    std::vector<SensorConfig> sensorsToAdd;
-    std::vector<String> sensorsToRemove;
-    compareConfigurations(oldConfigs, newConfigs, sensorsToAdd, sensorsToRemove);
-    
     // Update the configuration in the ConfigManager
     configManager->disableNotifications(true);
     bool configUpdateSuccess = configManager->updateSensorConfigs(newConfigs);
@@ -206,35 +316,254 @@ bool SensorManager::reconfigureSensors(const String& configJson) {
         return false;
     }
     
-    // Remove and add sensors as determined
-    for (const auto& sensorName : sensorsToRemove) {
-        ISensor* sensor = registry.unregisterSensor(sensorName);
-        if (sensor) {
-            errorHandler->logError(INFO, "Removing sensor: " + sensorName);
-            delete sensor;
+    return applySensorConfigs(newConfigs);
+}
+
+bool SensorManager::discoverI2CDevices(bool fullScan, std::vector<I2CManager::BusProbe>& probes) {
+    ConfigCache& cache = configManager->getCache();
+    std::vector<SensorConfig> configs = configManager->getSensorConfigs();
+    
+    probes.clear();
+    for (I2CPort port : {I2CPort::I2C0, I2CPort::I2C1}) {
+        if (!i2cManager->isPortInitialized(port)) {
+            continue;
+        }
+        
+        I2CManager::BusProbe probe;
+        probe.port = port;
+        if (fullScan) {
+            for (int address = 1; address < 127; address++) {
+                probe.candidates.push_back(address);
+            }
+        } else {
+            // What answered last time plus every configured address on this bus
+            cache.loadTopology(port, probe.candidates);
+            for (const auto& config : configs) {
+                if (config.communicationType == CommunicationType::I2C && config.portNum == static_cast<int>(port) &&
+                    std::find(probe.candidates.begin(), probe.candidates.end(), config.address) == probe.candidates.end()) {
+                    probe.candidates.push_back(config.address);
+                }
+            }
+            std::sort(probe.candidates.begin(), probe.candidates.end());
+        }
+        probes.push_back(probe);
+        
+        // Then each mux channel in use, in channel order, with the addresses configured on it
+        // (a full scan sweeps those channels too, but never one nothing is configured on)
+        for (uint8_t channel = 0; channel < Constants::Sensors::I2C_MUX_CHANNELS; channel++) {
+            I2CManager::BusProbe muxProbe;
+            muxProbe.port = I2CManager::muxPort(port, channel);
+            for (const auto& config : configs) {
+                if (config.communicationType == CommunicationType::I2C &&
+                    config.portNum == static_cast<int>(muxProbe.port) &&
+                    std::find(muxProbe.candidates.begin(), muxProbe.candidates.end(), config.address) == muxProbe.candidates.end()) {
+                    muxProbe.candidates.push_back(config.address);
+                }
+            }
+            if (muxProbe.candidates.empty()) {
+                continue;
+            }
+            if (fullScan) {
+                muxProbe.candidates.clear();
+                for (int address = 1; address < 127; address++) {
+                    muxProbe.candidates.push_back(address);
+                }
+            }
+            std::sort(muxProbe.candidates.begin(), muxProbe.candidates.end());
+            probes.push_back(muxProbe);
         }
     }
     
-    bool allSuccess = true;
-    for (const auto& config : sensorsToAdd) {
-        errorHandler->logError(INFO, "Adding new sensor: " + config.name);
-        
-        // Create and initialize the sensor
-        ISensor* sensor = factory.createSensor(config);
-        if (!sensor || !sensor->initialize()) {
-            if (sensor) delete sensor;
-            errorHandler->logError(ERROR, "Failed to create/initialize sensor: " + config.name);
-            allSuccess = false;
+    i2cManager->probeConcurrently(probes);
+    
+    for (const auto& probe : probes) {
+        LOG_INFO(errorHandler, I2CManager::portToString(probe.port) + ": " + String(probe.found.size()) + 
+                           " of " + String(probe.candidates.size()) + " probed addresses responded");
+        if (I2CManager::muxChannel(probe.port) < 0) {
+            cache.storeTopology(probe.port, probe.found);
+        }
+    }
+    return !probes.empty();
+}
+
+uint32_t SensorManager::getI2CClockLimit(I2CPort port, const std::vector<SensorConfig>& configs) const {
+    uint32_t limit = configManager->getI2CClockLimit(static_cast<int>(port));
+    for (const auto& config : configs) {
+        if (config.communicationType != CommunicationType::I2C ||
+            I2CManager::physicalPort(static_cast<I2CPort>(config.portNum)) != port) {
             continue;
         }
+        limit = std::min(limit, maxI2CClockForType(sensorTypeFromString(config.type)));
         
-        // Register the successfully initialized sensor
-        registry.registerSensor(sensor);
-        errorHandler->logError(INFO, "Sensor added: " + config.name + 
-                            " with polling rate: " + String(config.pollingRate) + "ms");
+        // Everything behind the multiplexer is clocked through it
+        if (I2CManager::muxChannel(static_cast<I2CPort>(config.portNum)) >= 0) {
+            limit = std::min(limit, Constants::Sensors::I2C_MUX_MAX_CLOCK);
+        }
+    }
+    return limit;
+}
+
+void SensorManager::negotiateI2CClocks() {
+    for (I2CPort port : {I2CPort::I2C0, I2CPort::I2C1}) {
+        // Devices on the trunk, and the multiplexer standing in for the ones behind it
+        std::vector<int> addresses;
+        for (const auto& config : activeConfigs) {
+            if (config.communicationType != CommunicationType::I2C ||
+                I2CManager::physicalPort(static_cast<I2CPort>(config.portNum)) != port) {
+                continue;
+            }
+            int address = I2CManager::muxChannel(static_cast<I2CPort>(config.portNum)) < 0 ?
+                          config.address : Constants::Sensors::I2C_MUX_ADDRESS;
+            if (std::find(addresses.begin(), addresses.end(), address) == addresses.end()) {
+                addresses.push_back(address);
+            }
+        }
+        i2cManager->negotiateClock(port, getI2CClockLimit(port, activeConfigs), addresses);
+    }
+}
+
+bool SensorManager::setI2CClockLimit(I2CPort port, uint32_t clockFreq) {
+    if (!configManager->setI2CClockLimit(static_cast<int>(port), clockFreq)) {
+        return false;
+    }
+    applyI2CClockLimits();
+    return true;
+}
+
+void SensorManager::applyI2CClockLimits() {
+    for (I2CPort port : {I2CPort::I2C0, I2CPort::I2C1}) {
+        if (i2cManager->isPortInitialized(port)) {
+            i2cManager->requestClock(port, getI2CClockLimit(port, activeConfigs));
+        }
+    }
+}
+
+void SensorManager::notifyTopologyChanged() {
+    topologyGeneration.fetch_add(1);
+    for (auto& worker : acquisitionTasks) {
+        TaskHandle_t task = worker.load();
+        if (task) {
+            xTaskNotifyGive(task);
+        }
+    }
+}
+
+bool SensorManager::requestRead(int slot, SensorReadRequest& request) {
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return false;
+    }
+    AcquisitionBus owner = slotBus[slot];
+    if (owner == AcquisitionBus::COUNT) {
+        return false;
+    }
+    size_t bus = static_cast<size_t>(owner);
+    TaskHandle_t worker = acquisitionTasks[bus].load();
+    if (!worker) {
+        return false;
     }
     
-    return allSuccess;
+    // The pass count is read before the bit is posted, so the pass that takes it counts higher
+    request.slot = slot;
+    request.pass = requestPasses[bus].load() + 1;
+    uint32_t bit = 1UL << slot;
+    if ((readRequests[bus].fetch_or(bit) & bit) == 0) {
+        xTaskNotifyGive(worker);
+    }
+    return true;
+}
+
+bool SensorManager::isReadServed(const SensorReadRequest& request) const {
+    if (request.slot < 0 || request.slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return false;
+    }
+    return static_cast<int32_t>(servedPasses[request.slot].load() - request.pass) >= 0;
+}
+
+size_t SensorManager::awaitReads(const SensorReadRequest* requests, size_t count, uint32_t timeoutMs) {
+    auto countServed = [&]() {
+        return static_cast<size_t>(std::count_if(requests, requests + count,
+                                                 [&](const SensorReadRequest& request) { return isReadServed(request); }));
+    };
+    
+    // Registered before the first check, so a read completing in between still wakes the task
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    std::atomic<TaskHandle_t>* entry = nullptr;
+    for (auto& waiter : readWaiters) {
+        TaskHandle_t expected = nullptr;
+        if (waiter.compare_exchange_strong(expected, self)) {
+            entry = &waiter;
+            break;
+        }
+    }
+    
+    unsigned long start = millis();
+    bool notified = false;
+    size_t served = countServed();
+    while (served < count) {
+        unsigned long elapsed = millis() - start;
+        if (elapsed >= timeoutMs) {
+            break;
+        }
+        // Without a waiter entry nobody notifies this task, so check every tick
+        TickType_t wait = entry ? pdMS_TO_TICKS(timeoutMs - elapsed) : 1;
+        if (ulTaskNotifyTake(pdTRUE, wait > 0 ? wait : 1) > 0) {
+            notified = true;
+        }
+        served = countServed();
+    }
+    
+    if (entry) {
+        entry->store(nullptr);
+    }
+    // The notification may have been meant for the task's own loop, e.g. received input
+    if (notified) {
+        xTaskNotifyGive(self);
+    }
+    return served;
+}
+
+uint32_t SensorManager::takeReadRequests(AcquisitionBus bus, std::vector<SensorName>& sensorNames) {
+    size_t index = static_cast<size_t>(bus);
+    uint32_t slots = readRequests[index].exchange(0);
+    if (!slots) {
+        return 0;
+    }
+    // Counted after the take, see requestRead()
+    requestPasses[index].fetch_add(1);
+    
+    for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+        if (!(slots & (1UL << slot)) || slotBus[slot] != bus) {
+            continue;
+        }
+        ISensor* sensor = registry.getSensorBySlot(static_cast<int>(slot));
+        if (!sensor) {
+            continue;
+        }
+        SensorName name(sensor->getNameView());
+        // updateSensors() takes each sensor once per pass
+        if (std::find(sensorNames.begin(), sensorNames.end(), name) == sensorNames.end()) {
+            sensorNames.push_back(name);
+        }
+    }
+    return slots;
+}
+
+void SensorManager::completeReadRequests(AcquisitionBus bus, uint32_t slots) {
+    if (!slots) {
+        return;
+    }
+    uint32_t pass = requestPasses[static_cast<size_t>(bus)].load();
+    for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+        if (slots & (1UL << slot)) {
+            servedPasses[slot].store(pass);
+        }
+    }
+    for (auto& waiter : readWaiters) {
+        TaskHandle_t task = waiter.load();
+        if (task) {
+            xTaskNotifyGive(task);
+        }
+    }
 }
 
 void SensorManager::compareConfigurations(
@@ -271,8 +600,10 @@ void SensorManager::compareConfigurations(
                 if (newConfig.type != oldConfig.type ||
                     newConfig.communicationType != oldConfig.communicationType ||
                     newConfig.address != oldConfig.address ||
-                    newConfig.portNum != oldConfig.portNum) {
-                    // Configuration changed, remove and re-add
+                    newConfig.portNum != oldConfig.portNum ||
+                    newConfig.additional != oldConfig.additional) {
+                    // Configuration changed, remove and re-add; driver options and the
+                    // per-slot filter and report settings only take effect on a new sensor
                     toRemove.push_back(newConfig.name);
                     toAdd.push_back(newConfig);
                 }
@@ -288,23 +619,19 @@ void SensorManager::compareConfigurations(
 }
 
 bool SensorManager::testI2CCommunication(I2CPort port, int address) {
-    TwoWire* wire = i2cManager->getWire(port);
-    if (!wire) {
-        errorHandler->logError(ERROR, "Failed to get I2C bus for port " + I2CManager::portToString(port));
-        return false;
+    // Discovery has usually just probed this address; only go to the bus if it has not
+    DevicePresence presence = i2cManager->getCachedPresence(port, address);
+    if (presence == DevicePresence::UNKNOWN) {
+        presence = i2cManager->devicePresent(port, address) ? DevicePresence::PRESENT : DevicePresence::ABSENT;
     }
     
-    wire->beginTransmission(address);
-    byte error = wire->endTransmission();
-    
-    if (error == 0) {
-        errorHandler->logError(INFO, "Direct I2C communication with address 0x" + String(address, HEX) + 
+    if (presence == DevicePresence::PRESENT) {
+        LOG_INFO(errorHandler, "Direct I2C communication with address 0x" + String(address, HEX) + 
                           " on port " + I2CManager::portToString(port) + " successful");
         return true;
     } else {
         errorHandler->logError(ERROR, "Direct I2C communication with address 0x" + String(address, HEX) + 
-                           " on port " + I2CManager::portToString(port) + 
-                           " failed with error: " + String(error));
+                           " on port " + I2CManager::portToString(port) + " failed: no acknowledge");
         return false;
     }
 }
@@ -318,7 +645,7 @@ bool SensorManager::testSPICommunication(int ssPin) {
     bool success = spiManager->testDevice(ssPin);
     
     if (success) {
-        errorHandler->logError(INFO, "SPI communication test successful on SS pin: " + String(ssPin));
+        LOG_INFO(errorHandler, "SPI communication test successful on SS pin: " + String(ssPin));
     } else {
         errorHandler->logError(WARNING, "SPI communication test inconclusive on SS pin: " + String(ssPin) + 
                               " (may still work with specific device protocol)");
@@ -327,104 +654,256 @@ bool SensorManager::testSPICommunication(int ssPin) {
     return true; // Return true even if the test is inconclusive, as it might still work with specific device
 }
 
-bool SensorManager::updateSensorCache(const String& sensorName) {
-    ISensor* sensor = findSensor(sensorName);
-    if (!sensor || !sensor->isConnected()) {
-        return false;
+void SensorManager::fillSensorCache(uint8_t channels, const SensorSample& sample, SensorCache& cache) {
+    forEachChannel(channels, [&](InterfaceType type) {
+        cache.values[static_cast<size_t>(type)] = sample.get(type);
+    });
+    cache.validMask = sample.validMask & channels;
+    cache.timestamp = sample.timestamp;
+    cache.timeUs = sample.timeUs;
+}
+
+void SensorManager::publishReading(int slot, const SensorCache& cache) {
+    readings.write(slot, cache);
+    
+    HistoryRecord record = HistoryRecord::pack(cache, registry.getChannels(slot));
+    if (!cache.anyValid()) {
+        record.timeUs = esp_timer_get_time();
     }
+    history.append(slot, record);
+}
+
+int SensorManager::updateSensors(const std::vector<SensorName>& sensorNames) {
+    // Covers the whole cycle, conversion waits included
+    PerfScope timing(PerfSite::SENSOR_UPDATE);
     
-    // Get the active write buffer
-    std::map<String, SensorCache>& activeCache = getActiveCache();
-    SensorCache& cache = activeCache[sensorName];
+    struct PendingConversion {
+        int slot;
+        ISensor* sensor;
+        unsigned long startTime;
+        uint64_t startUs;
+        uint64_t readyUs;
+    };
     
-    unsigned long currentTime = millis();
-    bool updated = false;
+    // A slot can only be named once per pass, so MAX_SENSORS entries always suffice
+    PendingConversion conversions[Constants::Sensors::MAX_SENSORS];
+    PendingConversion* pendingEnd = conversions;
+    int successCount = 0;
     
-    // Update temperature if supported
-    if (sensor->supportsInterface(InterfaceType::TEMPERATURE)) {
-        ITemperatureSensor* tempSensor = 
-            static_cast<ITemperatureSensor*>(sensor->getInterface(InterfaceType::TEMPERATURE));
-        
-        float temp = tempSensor->readTemperature();
-        cache.temperature = temp;
-        cache.tempTimestamp = currentTime;
-        cache.tempValid = !isnan(temp);
-        
-        updated = true;
+    for (const auto& sensorName : sensorNames) {
+        int slot = registry.getSlot(sensorName);
+        ISensor* sensor = registry.getSensorBySlot(slot);
+        if (sensor && sensor->isConnected() && pendingEnd != std::end(conversions)) {
+            *pendingEnd++ = {slot, sensor, 0, 0, 0};
+        }
     }
     
-    // Update humidity if supported  
-    if (sensor->supportsInterface(InterfaceType::HUMIDITY)) {
-        IHumiditySensor* humSensor = 
-            static_cast<IHumiditySensor*>(sensor->getInterface(InterfaceType::HUMIDITY));
-        
-        float hum = humSensor->readHumidity();
-        cache.humidity = hum;
-        cache.humTimestamp = currentTime;
-        cache.humValid = !isnan(hum);
-        
-        updated = true;
+    // Each bus is held once per batch below, so group its sensors together, and
+    // within a bus by mux channel so each channel is selected once; the
+    // insertion sort is stable and, unlike std::stable_sort, needs no buffer
+    auto inOrder = [&](int first, int second) {
+        return slotBus[first] != slotBus[second] ? slotBus[first] < slotBus[second]
+                                                 : slotPort[first] <= slotPort[second];
+    };
+    for (PendingConversion* it = conversions + 1; it < pendingEnd; ++it) {
+        PendingConversion moving = *it;
+        PendingConversion* hole = it;
+        while (hole > conversions && !inOrder((hole - 1)->slot, moving.slot)) {
+            *hole = *(hole - 1);
+            --hole;
+        }
+        *hole = moving;
     }
     
-    return updated;
-}
-
-int SensorManager::updateReadings() {
-    int successCount = 0;
-    auto sensors = registry.getAllSensors();
-    
-    for (auto sensor : sensors) {
-        if (sensor->isConnected()) {
-            if (updateSensorCache(sensor->getName())) {
-                successCount++;
+    // Trigger every sensor first so their conversions overlap
+    for (PendingConversion* batch = conversions; batch != pendingEnd;) {
+        AcquisitionBus bus = slotBus[batch->slot];
+        PendingConversion* batchEnd = std::find_if(batch, pendingEnd,
+                                     [&](const PendingConversion& conversion) { return slotBus[conversion.slot] != bus; });
+        
+        BusLock lock(getBusMutex(bus));
+        for (PendingConversion* it = batch; it != batchEnd; ++it) {
+            if (lock.owns() && selectSlotPort(it->slot) && it->sensor->startConversion()) {
+                it->startTime = millis();
+                it->startUs = esp_timer_get_time();
+                continue;
             }
+            
+            // Failed reads are published too so consumers see the invalid state
+            recordI2CTransaction(it->slot, false);
+            publishReading(it->slot, SensorCache());
+            it->sensor = nullptr;
         }
+        if (!lock.owns()) {
+            errorHandler->logFormatted(WARNING, "Bus %u busy, skipped %u sensor reads",
+                                       static_cast<unsigned>(bus), static_cast<unsigned>(batchEnd - batch));
+        }
+        batch = batchEnd;
     }
+    pendingEnd = std::remove_if(conversions, pendingEnd,
+                                [](const PendingConversion& conversion) { return !conversion.sensor; });
     
-    // After updating all sensors, swap the buffers atomically
-    currentBufferIndex.store(!currentBufferIndex.load());
+    // Sleep until the earliest conversion is due, then collect whatever has completed
+    while (pendingEnd != conversions) {
+        uint32_t waitMs = Constants::Sensors::CONVERSION_TIMEOUT_MS;
+        for (const PendingConversion* conversion = conversions; conversion != pendingEnd; ++conversion) {
+            waitMs = std::min(waitMs, conversion->sensor->getConversionDelayMs());
+        }
+        if (waitMs > 0) {
+            TickType_t waitTicks = pdMS_TO_TICKS(waitMs);
+            vTaskDelay(waitTicks > 0 ? waitTicks : 1);
+        }
+        
+        for (PendingConversion* it = conversions; it != pendingEnd;) {
+            // The bus is held across the whole run of its sensors; erasing keeps the grouping
+            AcquisitionBus bus = slotBus[it->slot];
+            BusLock lock(getBusMutex(bus));
+            
+            while (it != pendingEnd && slotBus[it->slot] == bus) {
+                bool timedOut = millis() - it->startTime >= Constants::Sensors::CONVERSION_TIMEOUT_MS;
+                bool reachable = lock.owns() && selectSlotPort(it->slot);
+                ConversionStatus status = reachable ? it->sensor->pollConversion() : ConversionStatus::PENDING;
+                
+                if (status == ConversionStatus::PENDING && !timedOut) {
+                    ++it;
+                    continue;
+                }
+                
+                // Stamped before the fetch, so driver retries and delays do not skew it
+                it->readyUs = esp_timer_get_time();
+                SensorSample sample;
+                bool fetched = status == ConversionStatus::READY && it->sensor->fetchResult(sample);
+                sample.timeUs = it->startUs + (it->readyUs - it->startUs) / 2;
+                if (fetched) {
+                    successCount++;
+                } else if (status == ConversionStatus::PENDING) {
+                    errorHandler->logFormatted(WARNING, "Conversion timed out for sensor: %s",
+                                               SensorName(it->sensor->getNameView()));
+                }
+                recordI2CTransaction(it->slot, fetched);
+                
+                // Implausible values are replaced by their quality code before anything sees them
+                qualityChecks[it->slot].process(sample);
+                
+                // Smoothed and decimated samples only; a decimated-away sample is not published
+                if (!filters[it->slot].process(sample)) {
+                    pendingEnd = std::copy(it + 1, pendingEnd, it);
+                    continue;
+                }
+                
+                // Each slot is only written by the worker for its bus, so no lock is needed
+                SensorCache fresh;
+                fillSensorCache(registry.getChannels(it->slot), sample, fresh);
+                publishReading(it->slot, fresh);
+                pendingEnd = std::copy(it + 1, pendingEnd, it);
+            }
+        }
+    }
     
     return successCount;
 }
 
-TemperatureReading SensorManager::getTemperatureSafe(const String& sensorName) {
-    // Get the read buffer (not currently being written to)
-    const std::map<String, SensorCache>& readCache = getReadCache();
-    
-    // Look for the sensor in the read cache
-    auto it = readCache.find(sensorName);
-    if (it != readCache.end() && it->second.tempValid) {
-        return TemperatureReading(it->second.temperature, it->second.tempTimestamp);
+void SensorManager::recordI2CTransaction(int slot, bool success) {
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return;
+    }
+    if (slotBus[slot] == AcquisitionBus::I2C0 || slotBus[slot] == AcquisitionBus::I2C1) {
+        i2cManager->recordTransaction(slotPort[slot], success);
+    }
+}
+
+bool SensorManager::selectSlotPort(int slot) {
+    if (slotBus[slot] != AcquisitionBus::I2C0 && slotBus[slot] != AcquisitionBus::I2C1) {
+        return true;
+    }
+    return i2cManager->selectPort(slotPort[slot]);
+}
+
+BusMutex* SensorManager::getBusMutex(AcquisitionBus bus) {
+    switch (bus) {
+        case AcquisitionBus::I2C0: return i2cManager->getBusMutex(I2CPort::I2C0);
+        case AcquisitionBus::I2C1: return i2cManager->getBusMutex(I2CPort::I2C1);
+        case AcquisitionBus::SPI: return spiManager ? spiManager->getBusMutex() : nullptr;
+        default: return nullptr;
+    }
+}
+
+AcquisitionBus SensorManager::getAcquisitionBus(const SensorConfig& config) {
+    if (config.communicationType == CommunicationType::SPI) {
+        return AcquisitionBus::SPI;
     }
     
-    // No valid reading available
-    return TemperatureReading();
+    // A mux channel is polled by the worker of the bus the multiplexer sits on
+    I2CPort bus = I2CManager::physicalPort(static_cast<I2CPort>(config.portNum));
+    return bus == I2CPort::I2C1 ? AcquisitionBus::I2C1 : AcquisitionBus::I2C0;
 }
 
-HumidityReading SensorManager::getHumiditySafe(const String& sensorName) {
-    // Get the read buffer (not currently being written to)
-    const std::map<String, SensorCache>& readCache = getReadCache();
+std::vector<SensorConfig> SensorManager::getSensorConfigsForBus(AcquisitionBus bus) const {
+    std::vector<SensorConfig> busConfigs;
     
-    // Look for the sensor in the read cache
-    auto it = readCache.find(sensorName);
-    if (it != readCache.end() && it->second.humValid) {
-        return HumidityReading(it->second.humidity, it->second.humTimestamp);
+    // Only what applySensorConfigs() published; the configuration itself belongs to the comm task
+    registry.forEachSlot([&](int slot, ISensor* sensor) {
+        if (slotBus[slot] != bus) {
+            return;
+        }
+        SensorConfig config{};
+        config.name = sensor->getName();
+        config.pollingRate = slotPollingRate[slot];
+        busConfigs.push_back(config);
+    });
+    
+    return busConfigs;
+}
+
+uint32_t SensorManager::clampPollingRate(uint32_t pollingRate) {
+    return constrain(pollingRate, Constants::System::MIN_POLLING_RATE_MS, Constants::System::MAX_POLLING_RATE_MS);
+}
+
+ChannelReading SensorManager::getReadingSafe(const String& sensorName, InterfaceType type) {
+    SensorCache cache;
+    if (readings.read(registry.getSlot(sensorName), cache)) {
+        // An invalid channel keeps the NaN that says why, see ChannelReading::quality()
+        return ChannelReading(type, cache.isValid(type) ? cache.get(type) : qualityNaN(cache.quality(type)),
+                              cache.timestamp);
     }
     
     // No valid reading available
-    return HumidityReading();
+    return ChannelReading(type);
 }
 
-const SensorRegistry& SensorManager::getRegistry() const {
-    return registry;
+TemperatureReading SensorManager::getTemperatureSafe(const String& sensorName) {
+    ChannelReading reading = getReadingSafe(sensorName, InterfaceType::TEMPERATURE);
+    return reading.valid ? TemperatureReading(reading.value, reading.timestamp) : TemperatureReading();
 }
 
-ISensor* SensorManager::findSensor(const String& name) {
-    return registry.getSensorByName(name);
+HumidityReading SensorManager::getHumiditySafe(const String& sensorName) {
+    ChannelReading reading = getReadingSafe(sensorName, InterfaceType::HUMIDITY);
+    return reading.valid ? HumidityReading(reading.value, reading.timestamp) : HumidityReading();
+}
+
+const ReportSettings& SensorManager::getReportSettings(int slot) const {
+    static const ReportSettings defaults;
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return defaults;
+    }
+    return reportSettings[slot];
+}
+
+const FilterSettings& SensorManager::getFilterSettings(int slot) const {
+    static const FilterSettings defaults;
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return defaults;
+    }
+    return filters[slot].getSettings();
+}
+
+const SensorRegistry& SensorManager::getRegistry() const {
+    return registry;
 }
 
 bool SensorManager::reconnectSensor(const String& sensorName) {
-    ISensor* sensor = findSensor(sensorName);
+    int slot = registry.getSlot(sensorName);
+    ISensor* sensor = registry.getSensorBySlot(slot);
     if (!sensor) {
         if (errorHandler) {
             errorHandler->logError(WARNING, "Cannot reconnect - sensor not found: " + sensorName);
@@ -437,85 +916,152 @@ bool SensorManager::reconnectSensor(const String& sensorName) {
         return true;
     }
     
-    // Add timeout for reconnection attempt
-    const unsigned long timeout = 500; // 500ms timeout
-    unsigned long startTime = millis();
+    RecoveryAttempt attempt;
+    if (!postRecovery(slot, attempt)) {
+        errorHandler->logError(WARNING, "Cannot reconnect - recovery queue full for sensor: " + sensorName);
+        return false;
+    }
+    return awaitRecovery(attempt, Constants::Sensors::RECOVERY_REPLY_TIMEOUT_MS);
+}
+
+bool SensorManager::postRecovery(int slot, RecoveryAttempt& attempt) {
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return false;
+    }
+    attempt.slot = slot;
+    attempt.bus = slotBus[slot];
+    if (attempt.bus == AcquisitionBus::COUNT) {
+        return false;
+    }
+    size_t bus = static_cast<size_t>(attempt.bus);
+    return recoveryRequests[bus].post(acquisitionTasks[bus].load(), slot, attempt.ticket);
+}
+
+bool SensorManager::awaitRecovery(const RecoveryAttempt& attempt, uint32_t timeoutMs) {
+    if (attempt.bus == AcquisitionBus::COUNT) {
+        return false;
+    }
+    size_t bus = static_cast<size_t>(attempt.bus);
+    TaskHandle_t owner = acquisitionTasks[bus].load();
+    if (!owner || owner == xTaskGetCurrentTaskHandle()) {
+        serviceRecoveryRequests(attempt.bus);
+    }
     
-    if (errorHandler) {
-        errorHandler->logError(INFO, "Attempting to reconnect sensor: " + sensorName);
+    RecoveryMailbox& mailbox = recoveryRequests[bus];
+    return mailbox.wait(attempt.ticket, timeoutMs) && mailbox.succeeded(attempt.ticket);
+}
+
+size_t SensorManager::serviceRecoveryRequests(AcquisitionBus bus) {
+    RecoveryMailbox& mailbox = recoveryRequests[static_cast<size_t>(bus)];
+    RecoveryMailbox::Request request;
+    size_t attempts = 0;
+    while (mailbox.take(request)) {
+        // The slot may have changed hands since the request was posted
+        int slot = request.ticket.slot;
+        ISensor* sensor = slotBus[slot] == bus ? registry.getSensorBySlot(slot) : nullptr;
+        bool connected = sensor && sensor->isConnected();
+        if (sensor && !connected) {
+            connected = recoverSensor(slot, sensor);
+            attempts++;
+        }
+        mailbox.complete(request, connected);
     }
+    return attempts;
+}
+
+bool SensorManager::recoverSensor(int slot, ISensor* sensor) {
+    String sensorName = sensor->getName();
+    AcquisitionBus bus = slotBus[slot];
     
-    // Check if we've exceeded the timeout at every step
-    if (millis() - startTime >= timeout) {
-        errorHandler->logError(WARNING, "Reconnection attempt timed out for sensor: " + sensorName);
+    // The whole attempt runs as one batch on the sensor's bus
+    BusLock lock(getBusMutex(bus));
+    if (!lock.owns()) {
+        errorHandler->logError(WARNING, "Cannot reconnect - bus busy for sensor: " + sensorName);
         return false;
     }
     
-    // Special handling for Si7021 sensors based on type string
-    if (sensor->getTypeString().indexOf("Si7021") >= 0) {
-        if (errorHandler) {
-            errorHandler->logError(INFO, "Using specialized reconnection for Si7021 sensor");
-        }
-        
-        // First try regular initialize with timeout check
-        if (millis() - startTime < timeout - 100) {
-            if (sensor->initialize()) {
-                if (errorHandler) {
-                    errorHandler->logError(INFO, "Successfully reconnected Si7021 sensor via initialize: " + sensorName);
-                }
-                return true;
-            }
-        }
-        
-        // Check timeout before attempting self-test
-        if (millis() - startTime >= timeout) {
-            errorHandler->logError(WARNING, "Reconnection initialization timed out for sensor: " + sensorName);
+    // Free a bus left held by a half-finished transfer, then a single address
+    // probe is far cheaper than initialize() on a device that is not there
+    if (bus == AcquisitionBus::I2C0 || bus == AcquisitionBus::I2C1) {
+        I2CPort port = slotPort[slot];
+        uint8_t address = slotAddress[slot];
+        i2cManager->recoverBus(port);
+        if (!i2cManager->devicePresent(port, address)) {
+            errorHandler->logError(WARNING, "Cannot reconnect - no device at 0x" + String(address, HEX) + 
+                               " for sensor: " + sensorName);
             return false;
         }
+    }
+    
+    LOG_INFO(errorHandler, "Attempting to reconnect sensor: " + sensorName);
+    if (sensor->initialize()) {
+        LOG_INFO(errorHandler, "Successfully reconnected sensor: " + sensorName);
+        return true;
+    }
+    
+    // Some sensors (e.g. Si7021) answer a self-test after initialize has failed
+    if (sensor->performSelfTest()) {
+        LOG_INFO(errorHandler, "Sensor reconnected via self-test: " + sensorName);
+        return true;
+    }
+    
+    errorHandler->logError(ERROR, "Failed to reconnect sensor: " + sensorName);
+    return false;
+}
+
+uint32_t SensorManager::serviceRecovery(uint32_t checkMs) {
+    registry.readerQuiescent(RECOVERY_READER);
+    
+    uint32_t waitMs = checkMs;
+    RecoveryAttempt attempts[Constants::Sensors::MAX_SENSORS];
+    size_t attemptCount = 0;
+    registry.forEachSlot([&](int slot, ISensor* sensor) {
+        SensorHealthStatus status;
+        health.read(slot, status);
         
-        // If that didn't work, try a more aggressive approach with self-test
-        if (sensor->performSelfTest()) {
-            if (errorHandler) {
-                errorHandler->logError(INFO, "Successfully reconnected Si7021 sensor via self-test: " + sensorName);
+        if (sensor->isConnected()) {
+            if (status.state != SensorHealth::HEALTHY) {
+                status.markHealthy(millis());
+                health.write(slot, status);
             }
-            return true;
+            return;
         }
         
-        // Still failed - report and return
-        if (errorHandler) {
-            errorHandler->logError(ERROR, "Failed to reconnect Si7021 sensor: " + sensorName);
+        if (status.state == SensorHealth::HEALTHY) {
+            status.markFailed(millis());
+            errorHandler->logError(WARNING, "Sensor " + sensor->getName() + " disconnected, recovering in the background");
         }
-        return false;
-    }
-    
-    // Generic reconnection attempt for other sensors with timeout check
-    if (millis() - startTime < timeout - 200) {
-        if (sensor->initialize()) {
-            if (errorHandler) {
-                errorHandler->logError(INFO, "Successfully reconnected sensor: " + sensorName);
+        if (status.msUntilAttempt(millis()) == 0) {
+            // Made by the bus worker; every due attempt is posted before any is waited for
+            if (postRecovery(slot, attempts[attemptCount])) {
+                attemptCount++;
+            } else {
+                waitMs = 0; // Mailbox full, post again on the next pass
             }
-            return true;
         }
-    }
+        health.write(slot, status);
+        waitMs = std::min(waitMs, status.msUntilAttempt(millis()));
+    });
     
-    // Check timeout before attempting self-test
-    if (millis() - startTime >= timeout) {
-        errorHandler->logError(WARNING, "Reconnection initialization timed out for sensor: " + sensorName);
-        return false;
-    }
-    
-    // Try self-test if initialize didn't work
-    if (sensor->performSelfTest()) {
-        if (errorHandler) {
-            errorHandler->logError(INFO, "Sensor reconnected via self-test: " + sensorName);
+    for (size_t i = 0; i < attemptCount; i++) {
+        const RecoveryAttempt& attempt = attempts[i];
+        bool recovered = awaitRecovery(attempt, Constants::Sensors::RECOVERY_REPLY_TIMEOUT_MS);
+        SensorHealthStatus status;
+        health.read(attempt.slot, status);
+        status.recordAttempt(recovered, millis());
+        health.write(attempt.slot, status);
+        
+        ISensor* sensor = registry.getSensorBySlot(attempt.slot);
+        if (!recovered && sensor) {
+            LOG_INFO(errorHandler, "Next recovery attempt for %s in %u ms", sensor->getName(),
+                     static_cast<unsigned>(status.msUntilAttempt(millis())));
         }
-        return true;
+        waitMs = std::min(waitMs, status.msUntilAttempt(millis()));
     }
     
-    if (errorHandler) {
-        errorHandler->logError(ERROR, "Failed to reconnect sensor: " + sensorName);
-    }
-    return false;
+    // Sleeping with no sensor pointers held never delays a reconfiguration
+    registry.readerOffline(RECOVERY_READER);
+    return waitMs;
 }
 
 /**
@@ -525,19 +1071,21 @@ bool SensorManager::reconnectSensor(const String& sensorName) {
 int SensorManager::reconnectAllSensors() {
     int reconnectedCount = 0;
     
-    auto registry = getRegistry();
-    auto sensors = registry.getAllSensors();
-    
-    for (auto sensor : sensors) {
-        if (!sensor->isConnected()) {
-            if (reconnectSensor(sensor->getName())) {
-                reconnectedCount++;
-            }
+    RecoveryAttempt attempts[Constants::Sensors::MAX_SENSORS];
+    size_t attemptCount = 0;
+    registry.forEachSlot([&](int slot, ISensor* sensor) {
+        if (!sensor->isConnected() && postRecovery(slot, attempts[attemptCount])) {
+            attemptCount++;
+        }
+    });
+    for (size_t i = 0; i < attemptCount; i++) {
+        if (awaitRecovery(attempts[i], Constants::Sensors::RECOVERY_REPLY_TIMEOUT_MS)) {
+            reconnectedCount++;
         }
     }
     
     if (errorHandler && reconnectedCount > 0) {
-        errorHandler->logError(INFO, "Reconnected " + String(reconnectedCount) + " sensors");
+        LOG_INFO(errorHandler, "Reconnected " + String(reconnectedCount) + " sensors");
     }
     
     return reconnectedCount;
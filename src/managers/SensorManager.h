@@ -11,18 +11,26 @@
  #pragma once
 
  #include <vector>
- #include <map>
  #include <atomic>
  #include <ArduinoJson.h>
  #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
  
  #include "../sensors/interfaces/ISensor.h"
  #include "../sensors/readings/TemperatureReading.h"
  #include "../sensors/readings/HumidityReading.h"
+ #include "../sensors/readings/ChannelReading.h"
  #include "../sensors/interfaces/ITemperatureSensor.h"
  #include "../sensors/interfaces/IHumiditySensor.h"
  #include "../sensors/SensorFactory.h"
  #include "SensorRegistry.h"
+ #include "SeqlockTable.h"
+ #include "SlotMailbox.h"
+ #include "ReadingHistory.h"
+ #include "SampleFilter.h"
+ #include "SensorHealth.h"
+ #include "TimeSync.h"
+ #include "Constants.h"
  #include "I2CManager.h"
  #include "SPIManager.h"
  #include "../config/ConfigManager.h"
@@ -31,15 +39,47 @@
  /**
   * @brief Structure for caching sensor readings
   * Used to store the most recent readings from sensors to avoid
-  * frequent hardware reads and provide thread-safe access.
+  * frequent hardware reads and provide thread-safe access. Holds the
+  * channels the sensor provides, all from its latest sample.
   */
- struct SensorCache {
-     float temperature = NAN;          ///< Temperature value in Celsius
-     float humidity = NAN;             ///< Humidity value in percentage (0-100)
-     unsigned long tempTimestamp = 0;  ///< Timestamp of temperature reading
-     unsigned long humTimestamp = 0;   ///< Timestamp of humidity reading
-     bool tempValid = false;           ///< Validity flag for temperature reading
-     bool humValid = false;            ///< Validity flag for humidity reading
+ struct SensorCache : ChannelValues {
+ };
+ 
+ /**
+  * @brief Physical buses that get their own acquisition worker
+  * Sensors on different buses are read concurrently, so the poll cycle is
+  * bounded by the slowest bus rather than the sum of all of them.
+  */
+ enum class AcquisitionBus : uint8_t {
+     I2C0 = 0,  ///< Sensors on the I2C0 bus
+     I2C1,      ///< Sensors on the I2C1 (STEMMA QT) bus
+     SPI,       ///< Sensors on the SPI bus
+     COUNT      ///< Number of acquisition buses
+ };
+ 
+ static_assert(static_cast<size_t>(AcquisitionBus::COUNT) + 2 <= Constants::Sensors::MAX_REGISTRY_READERS,
+               "Each acquisition worker, the recovery worker and the telemetry publisher need their own registry reader id");
+ 
+ /**
+  * @brief Convert an acquisition bus to its display name
+  * @param bus The acquisition bus
+  * @return String name of the bus
+  */
+ inline String acquisitionBusToString(AcquisitionBus bus) {
+     switch (bus) {
+         case AcquisitionBus::I2C0: return "I2C0";
+         case AcquisitionBus::I2C1: return "I2C1";
+         case AcquisitionBus::SPI: return "SPI";
+         default: return "UNKNOWN";
+     }
+ }
+ 
+ /**
+  * @brief An on-demand read posted with SensorManager::requestRead()
+  */
+ struct SensorReadRequest {
+     int slot = -1;        ///< Reading slot to be read
+     uint32_t pass = 0;    ///< Earliest worker pass whose read answers the request
  };
  
  /**
@@ -48,8 +88,39 @@
   * - Initializes sensors based on configuration
   * - Provides thread-safe access to sensor readings
   * - Caches sensor data to minimize read operations
-  * - Handles reconnection for failed sensors
-  * - Implements a double-buffering strategy for thread safety
+  * - Recovers failed sensors with backoff, off the acquisition path
+  * - Publishes readings through a per-slot seqlock table for thread safety
+  * - Groups sensors by bus so each bus can be polled by its own worker
+  *
+  * Ownership: each sensor driver, and the bus it sits on, has a single
+  * writer at any time. The task that runs applySensorConfigs() creates
+  * and initializes a driver and sets up its slot (filter, quality checks,
+  * bus, port, address, polling rate) before the registry publishes it;
+  * from then on only the acquisition worker of its bus calls into it,
+  * until the driver is retired and deleted after a grace period. Every
+  * other task reads sensors through the published snapshots only: the
+  * registry for identity and isConnected(), the seqlock tables for
+  * readings and health, the history for time series. It asks for work
+  * on a driver by posting to the bus worker: requestRead() for a read,
+  * the recovery mailbox for a reconnection attempt.
+  *
+  * Memory ordering:
+  * - The registry publishes a snapshot with a sequentially consistent
+  *   store and readers load it the same way, so the driver setup and
+  *   slot setup done before the swap are visible to any task that finds
+  *   the sensor in it. New sensors get slots no reader of the old
+  *   snapshot uses, unless the registry is full.
+  * - Readings, history records and health states are seqlock-protected:
+  *   a reader either copies a complete value or retries.
+  * - The per-slot routing (slotBus, slotPort, slotAddress,
+  *   slotPollingRate) is atomic, so a worker scanning slots it does not
+  *   own never races the comm task setting them up.
+  * - A reply from a bus worker (servedPasses, the recovery mailbox) is
+  *   published after the work it reports, so whoever sees it also sees
+  *   the driver state and reading that work produced.
+  * - topologyGeneration is bumped after the new set and polling rates
+  *   are in place; a worker that sees the new generation rebuilds its
+  *   schedule from them.
   */
  class SensorManager {
  private:
@@ -60,42 +131,201 @@
      SPIManager* spiManager;                  ///< SPI bus management
      ErrorHandler* errorHandler;              ///< Error reporting and handling
      
-     /** @name Double Buffering for Thread Safety
-      * A double-buffering strategy to prevent race conditions between
-      * the sensor reading task and the communication task
-      * @{
+     /**
+      * @brief Slot-indexed reading table shared between cores
+      * Slots are assigned by SensorRegistry::registerSensor. Each slot is
+      * written only by the acquisition worker for its sensor's bus and read
+      * lock-free, allocation-free by the communication task.
+      */
+     SeqlockTable<SensorCache, Constants::Sensors::MAX_SENSORS> readings;
+     
+     /**
+      * @brief Time series of every published reading, per slot
+      */
+     ReadingHistory history;
+     
+     /**
+      * @brief Mapping of reading timestamps to wall-clock time
+      */
+     TimeSync timeSync;
+     
+     /**
+      * @brief Quality checks of each slot's raw samples, ahead of the filter
+      * Configured and run like the filters.
+      */
+     SampleQuality qualityChecks[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief Smoothing and decimation of each slot's samples before publishing
+      * Configured when a sensor is assigned its slot and run only by the
+      * acquisition worker for its sensor's bus.
+      */
+     SampleFilter filters[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief Deadband and heartbeat of each slot's streamed channels
+      * Set with the filter when a sensor is assigned its slot.
+      */
+     ReportSettings reportSettings[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief Bus of each slot's sensor, COUNT for an empty slot
+      * Set with the filter. Used to batch reads under one bus hold, to
+      * charge I2C transactions to their bus's error rate and to route
+      * requests to the slot's owner.
+      */
+     std::atomic<AcquisitionBus> slotBus[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief I2C port of each slot's sensor, mux channel included
+      * Set with slotBus; I2C0 for sensors on other buses. A bus's batch is
+      * ordered by port, so the multiplexer switches at most once per
+      * channel per pass.
+      */
+     std::atomic<I2CPort> slotPort[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief Address of each slot's I2C sensor, probed before a recovery attempt
+      * Set with slotBus.
+      */
+     std::atomic<uint8_t> slotAddress[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief Polling rate of each slot's sensor in milliseconds, clamped
+      * Set with slotBus and refreshed for every sensor on each
+      * reconfiguration, since a rate change keeps the sensor.
+      */
+     std::atomic<uint32_t> slotPollingRate[Constants::Sensors::MAX_SENSORS];
+     
+     /**
+      * @brief Recovery state of each slot's sensor
+      * Written only by the recovery worker, in serviceRecovery(), and
+      * reset when a slot is handed to a new sensor.
+      */
+     SeqlockTable<SensorHealthStatus, Constants::Sensors::MAX_SENSORS> health;
+     
+     /**
+      * @brief Registry reader id of the recovery worker, after the acquisition workers'
+      */
+     static constexpr size_t RECOVERY_READER = static_cast<size_t>(AcquisitionBus::COUNT);
+     
+     /**
+      * @brief Registry reader id of the telemetry publisher, after the recovery worker's
       */
-     std::atomic<bool> currentBufferIndex{false}; ///< false = buffer A, true = buffer B
-     std::map<String, SensorCache> readingCacheA; ///< First buffer for readings
-     std::map<String, SensorCache> readingCacheB; ///< Second buffer for readings
-     /** @} */
+     static constexpr size_t TELEMETRY_READER = RECOVERY_READER + 1;
      
      /** 
       * @brief Maximum age of cached readings in milliseconds
-      * Readings older than this value will trigger a sensor refresh
+      * Readings older than this are still answered from the cache, but
+      * the query that finds one asks for a fresh read in the background.
       */
      unsigned long maxCacheAge = 5000;
      
      /**
-      * @brief Get the active buffer being written to
-      * @return Reference to the active cache buffer
+      * @brief Counter bumped whenever the set of active sensors changes
+      * Lets the acquisition task know when to rebuild its poll schedule.
       */
-     std::map<String, SensorCache>& getActiveCache() {
-         return currentBufferIndex.load() ? readingCacheB : readingCacheA;
-     }
+     std::atomic<uint32_t> topologyGeneration{0};
      
      /**
-      * @brief Get the buffer for safe reading by other threads
-      * @return Const reference to the read cache buffer
+      * @brief Acquisition tasks to wake when the sensor set changes
+      * Each owns the drivers on its bus.
       */
-     const std::map<String, SensorCache>& getReadCache() const {
-         return currentBufferIndex.load() ? readingCacheA : readingCacheB;
-     }
+     std::atomic<TaskHandle_t> acquisitionTasks[static_cast<size_t>(AcquisitionBus::COUNT)] = {};
+     
+     /**
+      * @brief Mailbox of the recovery attempts asked of each bus's worker
+      */
+     typedef SlotMailbox<Constants::Sensors::MAX_SENSORS, Constants::Sensors::RECOVERY_QUEUE_DEPTH> RecoveryMailbox;
+     RecoveryMailbox recoveryRequests[static_cast<size_t>(AcquisitionBus::COUNT)];
+     
+     /**
+      * @brief A recovery attempt posted to a bus worker
+      */
+     struct RecoveryAttempt {
+         int slot = -1;                                  ///< Slot of the sensor
+         AcquisitionBus bus = AcquisitionBus::COUNT;     ///< Bus whose worker makes the attempt
+         RecoveryMailbox::Ticket ticket;                 ///< Reply to wait for
+     };
+     
+     /**
+      * @brief Ask a slot's bus worker to make one recovery attempt
+      * @param slot Reading slot of the sensor
+      * @param attempt [out] Handle for awaitRecovery()
+      * @return false if the slot is empty or the worker's mailbox is full
+      */
+     bool postRecovery(int slot, RecoveryAttempt& attempt);
+     
+     /**
+      * @brief Wait for a posted recovery attempt
+      * When the bus has no worker, or the caller is that worker, the
+      * attempt is made here instead: nobody else then calls into the
+      * bus's drivers.
+      * @param attempt Attempt filled by postRecovery()
+      * @param timeoutMs Longest wait
+      * @return true if the attempt was made and the sensor is connected
+      */
+     bool awaitRecovery(const RecoveryAttempt& attempt, uint32_t timeoutMs);
+     
+     /**
+      * @brief Slots each bus's worker has been asked to read outside its schedule
+      * Set by requestRead() and taken whole by the worker, so requests for
+      * a slot that is already pending share one read.
+      */
+     std::atomic<uint32_t> readRequests[static_cast<size_t>(AcquisitionBus::COUNT)] = {};
+     
+     /**
+      * @brief Number of each bus's worker passes that took read requests
+      */
+     std::atomic<uint32_t> requestPasses[static_cast<size_t>(AcquisitionBus::COUNT)] = {};
+     
+     /**
+      * @brief Pass of its bus's worker that last read each slot on request
+      */
+     std::atomic<uint32_t> servedPasses[Constants::Sensors::MAX_SENSORS] = {};
+     
+     /**
+      * @brief Tasks blocked in awaitReads(), notified after each requested read
+      */
+     std::atomic<TaskHandle_t> readWaiters[Constants::Sensors::MAX_READ_WAITERS] = {};
+     
+     /**
+      * @brief Record a change to the active sensor set and wake the acquisition tasks
+      */
+     void notifyTopologyChanged();
+     
+     /**
+      * @brief Configurations the registered sensor set was built from
+      * Compared against each new configuration so unchanged sensors are
+      * kept instead of re-created.
+      */
+     std::vector<SensorConfig> activeConfigs;
+     
+     /**
+      * @brief Sensors taken out of the registry that readers may still hold
+      */
+     struct RetiredSensors {
+         uint32_t token;                  ///< Registry grace period that must elapse first
+         std::vector<ISensor*> sensors;   ///< Sensors to delete
+     };
+     
+     /**
+      * @brief Retired sensors waiting for their grace period, oldest first
+      */
+     std::vector<RetiredSensors> retiredSensors;
+     
+     /**
+      * @brief Delete retired sensors whose grace period has elapsed
+      * @param waitMs How long to keep retrying while some are still held
+      * @return Number of sensors still waiting
+      */
+     size_t reclaimRetiredSensors(uint32_t waitMs);
      
      /**
       * @brief Compare old and new sensor configurations
       * Determines which sensors need to be added or removed when
-      * reconfiguring the system.
+      * reconfiguring the system. A sensor whose type, bus, address or
+      * additional settings changed is both removed and added.
       * @param oldConfigs Previous sensor configurations
       * @param newConfigs New sensor configurations
       * @param toAdd [out] Output vector of sensors to add
@@ -109,12 +339,72 @@
      
      /**
       * @brief Test communication with an I2C device
+      * Uses the I2C manager's presence cache when the address has already
+      * been probed, e.g. by discovery.
       * @param port I2C port to use
       * @param address I2C address to test
       * @return true if communication successful
       */
      bool testI2CCommunication(I2CPort port, int address);
      
+     /**
+      * @brief Get the fastest clock an I2C bus may run at
+      * The lower of the configured limit and the slowest attached sensor
+      * type's maxI2CClockForType().
+      * @param port I2C port
+      * @param configs Sensor configurations in use
+      * @return Clock limit in Hz
+      */
+     uint32_t getI2CClockLimit(I2CPort port, const std::vector<SensorConfig>& configs) const;
+     
+     /**
+      * @brief Clamp a configured polling rate to the allowed range
+      * @param pollingRate Configured rate in milliseconds
+      * @return Rate the acquisition workers use
+      */
+     static uint32_t clampPollingRate(uint32_t pollingRate);
+     
+     /**
+      * @brief Charge one sensor transaction to its I2C bus's error rate
+      * @param slot Reading slot of the sensor
+      * @param success Whether the transaction succeeded
+      */
+     void recordI2CTransaction(int slot, bool success);
+     
+     /**
+      * @brief Connect a slot's sensor through the bus multiplexer
+      * Call with the bus held, before the sensor's transactions. Costs
+      * nothing for a sensor off any mux or on the channel already selected.
+      * @param slot Reading slot of the sensor
+      * @return true if the sensor can be addressed
+      */
+     bool selectSlotPort(int slot);
+     
+     /**
+      * @brief Get the mutex of an acquisition bus
+      * @param bus Acquisition bus
+      * @return The owning manager's bus mutex, or nullptr if there is none
+      */
+     BusMutex* getBusMutex(AcquisitionBus bus);
+     
+     /**
+      * @brief Step each I2C bus up to the fastest clock its sensors answer at
+      * Run once at boot, before the acquisition workers start.
+      */
+     void negotiateI2CClocks();
+     
+     /**
+      * @brief Make one attempt to bring a disconnected sensor back
+      * For an I2C sensor the bus is freed if a device holds it, and the
+      * address probed before anything heavier is tried. The attempt holds
+      * the sensor's bus throughout. Only the sensor's owner may call it,
+      * see serviceRecoveryRequests().
+      * @param slot Reading slot of the sensor
+      * @param sensor The sensor
+      * @return true if the sensor is connected again
+      */
+     bool recoverSensor(int slot, ISensor* sensor);
+     
      /**
       * @brief Test communication with an SPI device
       * @param ssPin SPI slave select pin
@@ -123,11 +413,20 @@
      bool testSPICommunication(int ssPin);
      
      /**
-      * @brief Update readings for a single sensor
-      * @param sensorName Name of the sensor to update
-      * @return true if update successful
+      * @brief Publish a reading to the latest-value table and the history
+      * @param slot Reading slot of the sensor
+      * @param cache The reading to publish
       */
-     bool updateSensorCache(const String& sensorName);
+     void publishReading(int slot, const SensorCache& cache);
+     
+     /**
+      * @brief Fill a cache entry from a completed sample
+      * Only the channels the sensor supports are copied.
+      * @param channels channelBit() of each interface of the sensor, from SensorRegistry::getChannels()
+      * @param sample The completed sample
+      * @param cache [out] Entry updated with the sensor's channels
+      */
+     static void fillSensorCache(uint8_t channels, const SensorSample& sample, SensorCache& cache);
  
  public:
      /**
@@ -146,12 +445,46 @@
      
      /**
       * @brief Initialize all sensors from configuration
-      * Scans I2C and SPI buses for devices, then initializes sensors
-      * based on the current configuration.
+      * Probes the configured I2C addresses on all buses in parallel, then
+      * applies the current configuration with applySensorConfigs().
       * @return true if at least one sensor initialized successfully
       */
      bool initializeSensors();
      
+     /**
+      * @brief Bring the active sensor set in line with a configuration
+      * Sensors whose configuration is unchanged keep running untouched.
+      * New and changed ones are created and initialized off to the side,
+      * then the whole set is swapped into the registry at once, so the
+      * acquisition workers keep sampling throughout. Sensors dropped by
+      * the swap are deleted once every worker has passed a quiescent
+      * point; ones still held after Constants::Sensors::RECLAIM_WAIT_MS
+      * are deleted on a later call.
+      * Must only be called from one task at a time.
+      * @param configs The complete new sensor configuration
+      * @return true if every configured sensor is active
+      */
+     bool applySensorConfigs(const std::vector<SensorConfig>& configs);
+     
+     /**
+      * @brief Find the devices present on the initialized I2C buses
+      * The buses are probed in parallel. A targeted probe tries the
+      * configured addresses and those found last time; a full scan tries
+      * every address. Either way the responding addresses become the
+      * bus's cached topology.
+      * @param fullScan Probe every 7-bit address instead of the configured ones
+      * @param probes [out] One entry per initialized bus with the candidates and responders
+      * @return true if at least one bus was probed
+      */
+     bool discoverI2CDevices(bool fullScan, std::vector<I2CManager::BusProbe>& probes);
+     
+     /**
+      * @brief Ask each I2C bus to move to its current clock limit
+      * Applied by each bus's acquisition worker before its next transaction;
+      * call after the configured limits or the attached sensors change.
+      */
+     void applyI2CClockLimits();
+     
      /**
       * @brief Reconfigure sensors based on new configuration
       * Updates the sensor configuration based on new JSON settings,
@@ -162,12 +495,173 @@
      bool reconfigureSensors(const String& configJson);
      
      /**
-      * @brief Update readings from all sensors
-      * Iterates through all sensors and updates their readings
-      * in the active cache buffer, then atomically swaps buffers.
+      * @brief Update readings for a subset of sensors
+      * Starts a conversion on every named sensor first, then sleeps until
+      * the earliest one is due and collects results as they complete, so
+      * the pass takes as long as the slowest conversion rather than the
+      * sum of them. The sensors of each bus are triggered, and later
+      * collected, back-to-back under a single hold of that bus's mutex.
+      * Each result is published into the sensor's slot;
+      * sensors not read in this pass keep their latest values.
+      * Works in fixed storage and performs no heap allocation.
+      * @param sensorNames Names of the sensors to read
       * @return Number of sensors successfully updated
       */
-     int updateReadings();
+     int updateSensors(const std::vector<SensorName>& sensorNames);
+     
+     /**
+      * @brief Determine which acquisition bus a sensor configuration belongs to
+      * @param config The sensor configuration
+      * @return The bus whose worker should poll the sensor
+      */
+     static AcquisitionBus getAcquisitionBus(const SensorConfig& config);
+     
+     /**
+      * @brief Get the names and polling rates of the active sensors on one bus
+      * Built from the registry and the per-slot polling rates, never from
+      * the configuration another task may be rewriting. Polling rates are
+      * clamped to the allowed range; other fields are left at their defaults.
+      * @param bus The acquisition bus
+      * @return Configurations of registered sensors assigned to the bus
+      */
+     std::vector<SensorConfig> getSensorConfigsForBus(AcquisitionBus bus) const;
+     
+     /**
+      * @brief Get the current sensor topology generation
+      * @return Counter that changes whenever sensors are added or removed
+      */
+     uint32_t getTopologyGeneration() const { return topologyGeneration.load(); }
+     
+     /**
+      * @brief Get the clock and error counters of an I2C bus
+      * @param port I2C port
+      * @return Current status of the bus
+      */
+     BusClockStatus getI2CClockStatus(I2CPort port) const { return i2cManager->getClockStatus(port); }
+     
+     /**
+      * @brief Get the fastest clock an I2C bus may currently run at
+      * @param port I2C port
+      * @return The lower of the configured limit and the attached sensors' limits, in Hz
+      */
+     uint32_t getI2CClockLimit(I2CPort port) const { return getI2CClockLimit(port, activeConfigs); }
+     
+     /**
+      * @brief Change the configured clock limit of an I2C bus and apply it
+      * The limit is persisted in config.json; the bus moves to the new
+      * effective limit before its next transaction.
+      * @param port I2C port
+      * @param clockFreq Clock limit in Hz
+      * @return true if the limit was valid
+      */
+     bool setI2CClockLimit(I2CPort port, uint32_t clockFreq);
+     
+     /**
+      * @brief Set the task to notify when the sensor set changes
+      * @param bus The bus the task polls
+      * @param task Handle of the acquisition task
+      */
+     void setAcquisitionTask(AcquisitionBus bus, TaskHandle_t task) {
+         acquisitionTasks[static_cast<size_t>(bus)].store(task);
+         if (!task) {
+             markOffline(bus);
+         }
+     }
+     
+     /**
+      * @brief Report that a bus's worker holds no sensor pointers
+      * Called by the worker at the top of each loop; lets retired sensors
+      * be deleted. Also brings an offline worker back online.
+      * @param bus The bus the calling worker polls
+      */
+     void markQuiescent(AcquisitionBus bus) { registry.readerQuiescent(static_cast<size_t>(bus)); }
+     
+     /**
+      * @brief Report that a bus's worker is blocked and holds no sensor pointers
+      * Called before the worker sleeps so an idle bus never delays a
+      * reconfiguration.
+      * @param bus The bus the calling worker polls
+      */
+     void markOffline(AcquisitionBus bus) { registry.readerOffline(static_cast<size_t>(bus)); }
+     
+     /**
+      * @brief Report that the telemetry publisher holds no sensor pointers
+      * Called before it looks sensors up for a publish.
+      */
+     void markTelemetryQuiescent() { registry.readerQuiescent(TELEMETRY_READER); }
+     
+     /**
+      * @brief Report that the telemetry publisher is blocked and holds no sensor pointers
+      * Called before it sleeps or waits on the network.
+      */
+     void markTelemetryOffline() { registry.readerOffline(TELEMETRY_READER); }
+     
+     /**
+      * @brief Ask a slot's bus worker to read it now, outside its schedule
+      * Wakes the worker, which reads the slot in its next pass together
+      * with whatever else is due. Requests for a slot that is already
+      * pending share that one read. Never blocks.
+      * @param slot Reading slot
+      * @param request [out] Handle to check with isReadServed() or awaitReads()
+      * @return false if the slot is empty or its bus has no worker
+      */
+     bool requestRead(int slot, SensorReadRequest& request);
+     
+     /**
+      * @brief Whether a requested read has been made
+      * The result, valid or not, is in the slot's latest reading unless
+      * the slot's filter held the sample back.
+      * @param request Request filled by requestRead()
+      * @return true once a read started after the request has completed
+      */
+     bool isReadServed(const SensorReadRequest& request) const;
+     
+     /**
+      * @brief Wait for requested reads, up to a deadline
+      * Sleeps on the calling task's notification, which the workers give
+      * after each pass that served a request; a notification taken from
+      * someone else is given back before returning.
+      * @param requests Requests filled by requestRead()
+      * @param count Number of requests
+      * @param timeoutMs Longest wait for all of them
+      * @return Number of requests served
+      */
+     size_t awaitReads(const SensorReadRequest* requests, size_t count, uint32_t timeoutMs);
+     
+     /**
+      * @brief Take the read requests posted for a bus
+      * Called by the bus's worker before each pass. Names of the requested
+      * sensors not already in the list are appended to it.
+      * @param bus The bus the calling worker polls
+      * @param sensorNames [in,out] Sensors due in this pass
+      * @return Mask of the slots taken, for completeReadRequests()
+      */
+     uint32_t takeReadRequests(AcquisitionBus bus, std::vector<SensorName>& sensorNames);
+     
+     /**
+      * @brief Mark the reads taken by takeReadRequests() as served and wake the waiters
+      * @param bus The bus the calling worker polls
+      * @param slots Mask returned by takeReadRequests()
+      */
+     void completeReadRequests(AcquisitionBus bus, uint32_t slots);
+     
+     /**
+      * @brief Make the recovery attempts posted for a bus
+      * Called by the bus's worker between passes, so reconnecting a
+      * sensor never calls into a driver from outside its owner. Each
+      * attempt holds the bus, as the worker's own reads do.
+      * @param bus The bus the calling worker polls
+      * @return Number of attempts made
+      */
+     size_t serviceRecoveryRequests(AcquisitionBus bus);
+     
+     /**
+      * @brief Get the latest reading of any channel in a thread-safe manner
+      * @param sensorName Name of the sensor
+      * @param type Channel to read
+      * @return Reading with validity information; an invalid one still carries its quality()
+      */
+     ChannelReading getReadingSafe(const String& sensorName, InterfaceType type);
      
      /**
       * @brief Get temperature reading in a thread-safe manner
@@ -190,6 +684,40 @@
       */
      HumidityReading getHumiditySafe(const String& sensorName);
      
+     /**
+      * @brief Get the reading history
+      * @return Reference to the history of all published readings
+      */
+     const ReadingHistory& getHistory() const { return history; }
+     
+     /**
+      * @brief Get the device-to-wall-clock mapping
+      * Readings are stamped in esp_timer microseconds; report them through
+      * TimeSync::reportTimeUs().
+      * @return Reference to the time mapping
+      */
+     TimeSync& getTimeSync() { return timeSync; }
+     
+     /**
+      * @brief Get the pool the sensors are allocated from
+      * @return Reference to the sensor pool
+      */
+     const SensorPool& getSensorPool() const { return factory.getPool(); }
+     
+     /**
+      * @brief Get the report-by-exception settings of a slot
+      * @param slot Reading slot
+      * @return Settings of the sensor in the slot; defaults for an invalid slot
+      */
+     const ReportSettings& getReportSettings(int slot) const;
+     
+     /**
+      * @brief Get the filter settings of a slot
+      * @param slot Reading slot
+      * @return Settings of the sensor in the slot; defaults for an invalid slot
+      */
+     const FilterSettings& getFilterSettings(int slot) const;
+     
      /**
       * @brief Set maximum age for cached readings
       * @param maxAgeMs Maximum age in milliseconds
@@ -209,16 +737,30 @@
      const SensorRegistry& getRegistry() const;
      
      /**
-      * @brief Find a sensor by name
-      * @param name Sensor name
-      * @return Pointer to the sensor or nullptr if not found
+      * @brief Run the recovery worker's pass over all sensors
+      * Notes sensors that have dropped out or come back, retries each
+      * disconnected sensor whose backoff has expired and publishes the
+      * result to the health table. Runs in its own low-priority task,
+      * which owns the backoff policy and the health table; the attempts
+      * themselves are posted to the sensors' bus workers all at once and
+      * made there, under the bus hold they need anyway.
+      * @param checkMs Longest wait when no retry is due, i.e. how soon a new dropout is noticed
+      * @return Milliseconds until the next pass is due
+      */
+     uint32_t serviceRecovery(uint32_t checkMs = Constants::Sensors::RECOVERY_CHECK_MS);
+     
+     /**
+      * @brief Get the recovery state of a slot's sensor
+      * @param slot Reading slot
+      * @param out [out] Latest state published by the recovery worker
+      * @return false if the slot is out of range or has no state yet
       */
-     ISensor* findSensor(const String& name);
+     bool getSensorHealth(int slot, SensorHealthStatus& out) const { return health.read(slot, out); }
      
      /**
       * @brief Attempt to reconnect a disconnected sensor
-      * Tries to re-establish communication with a sensor that has
-      * been marked as disconnected.
+      * Asks the sensor's bus worker to re-establish communication right
+      * away, without backoff, and waits for the outcome. Safe from any task.
       * @param sensorName Name of the sensor
       * @return true if reconnection successful
       */
@@ -226,6 +768,8 @@
      
      /**
       * @brief Attempt to reconnect all disconnected sensors
+      * Every attempt is posted before any is waited for, so the buses
+      * work on them in parallel.
       * @return Number of sensors successfully reconnected
       */
      int reconnectAllSensors();
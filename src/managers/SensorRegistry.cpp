@@ -1,107 +1,295 @@
 #include "SensorRegistry.h"
 
-SensorRegistry::SensorRegistry(ErrorHandler* err) : errorHandler(err) {
+SensorRegistry::SensorRegistry(ErrorHandler* err) : errorHandler(err), lock(xSemaphoreCreateRecursiveMutex()) {
+    Snapshot* empty = new Snapshot();
+    empty->rebuildIndex();
+    current.store(empty);
 }
 
 SensorRegistry::~SensorRegistry() {
     // Note: We don't own the sensors, so we don't delete them
-    allSensors.clear();
+    for (const auto& retired : retiredSnapshots) {
+        delete retired.snapshot;
+    }
+    retiredSnapshots.clear();
+    delete current.load();
+    if (lock) {
+        vSemaphoreDelete(lock);
+    }
 }
 
-void SensorRegistry::registerSensor(ISensor* sensor) {
+bool SensorRegistry::registerSensor(ISensor* sensor) {
     if (!sensor) {
         errorHandler->logError(ERROR, "Attempted to register null sensor");
-        return;
+        return false;
     }
     
+    ScopedLock guard(lock);
+    reclaimSnapshotsLocked();
+    
     // Check if sensor already exists
-    if (hasSensor(sensor->getName())) {
+    if (hasSensor(SensorName(sensor->getNameView()))) {
         errorHandler->logError(WARNING, "Sensor with name " + sensor->getName() + " already exists in registry");
-        return;
+        return false;
+    }
+    
+    // Assign the lowest free reading slot
+    int slot = lowestFreeSlot(*snapshot(), nullptr);
+    if (slot < 0) {
+        errorHandler->logError(ERROR, "Sensor registry full, cannot register: " + sensor->getName());
+        return false;
     }
     
     // Add to the general sensor list
-    allSensors.push_back(sensor);
+    Snapshot* next = new Snapshot(*snapshot());
+    next->slotTable[slot] = sensor;
+    next->slotHash[slot] = hashName(SensorName(sensor->getNameView()));
+    next->allSensors.push_back(sensor);
+    publish(next);
     
-    errorHandler->logError(INFO, "Registered sensor: " + sensor->getName());
+    errorHandler->logError(INFO, "Registered sensor: " + sensor->getName() + " in slot " + String(slot));
+    return true;
 }
 
 ISensor* SensorRegistry::unregisterSensor(const String& sensorName) {
-    ISensor* sensorToRemove = nullptr;
+    ScopedLock guard(lock);
+    reclaimSnapshotsLocked();
     
     // Find the sensor
-    for (auto it = allSensors.begin(); it != allSensors.end(); ++it) {
-        if ((*it)->getName() == sensorName) {
-            sensorToRemove = *it;
-            allSensors.erase(it);
-            break;
-        }
-    }
-    
-    if (!sensorToRemove) {
+    int slot = getSlot(sensorName);
+    if (slot < 0) {
         errorHandler->logError(WARNING, "Attempted to unregister non-existent sensor: " + sensorName);
         return nullptr;
     }
     
+    // Release its reading slot
+    Snapshot* next = new Snapshot(*snapshot());
+    ISensor* sensorToRemove = next->slotTable[slot];
+    next->slotTable[slot] = nullptr;
+    next->allSensors.erase(std::find(next->allSensors.begin(), next->allSensors.end(), sensorToRemove));
+    publish(next);
+    
     errorHandler->logError(INFO, "Unregistered sensor: " + sensorName);
     return sensorToRemove;
 }
 
+bool SensorRegistry::replaceSensors(const std::vector<ISensor*>& sensors, std::vector<ISensor*>& removed,
+                                    const SlotPreparer& prepareSlot) {
+    removed.clear();
+    if (sensors.size() > Constants::Sensors::MAX_SENSORS) {
+        errorHandler->logError(ERROR, "Sensor registry full, cannot register " + String(sensors.size()) + " sensors");
+        return false;
+    }
+    
+    for (size_t i = 0; i < sensors.size(); i++) {
+        if (!sensors[i]) {
+            errorHandler->logError(ERROR, "Attempted to register null sensor");
+            return false;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (sensors[j]->getName() == sensors[i]->getName()) {
+                errorHandler->logError(WARNING, "Sensor with name " + sensors[i]->getName() + " already exists in registry");
+                return false;
+            }
+        }
+    }
+    
+    ScopedLock guard(lock);
+    reclaimSnapshotsLocked();
+    const Snapshot* old = snapshot();
+    Snapshot* next = new Snapshot();
+    next->allSensors = sensors;
+    
+    // Sensors that stay keep their slots
+    for (ISensor* sensor : sensors) {
+        int slot = old->slotOf(sensor);
+        if (slot >= 0) {
+            next->slotTable[slot] = sensor;
+            next->slotHash[slot] = old->slotHash[slot];
+        }
+    }
+    
+    // New sensors take slots nobody is reading, if there are any left
+    for (ISensor* sensor : sensors) {
+        if (old->slotOf(sensor) >= 0) {
+            continue;
+        }
+        int slot = lowestFreeSlot(*next, old);
+        if (slot < 0) {
+            slot = lowestFreeSlot(*next, nullptr);
+        }
+        next->slotTable[slot] = sensor;
+        next->slotHash[slot] = hashName(SensorName(sensor->getNameView()));
+        if (prepareSlot) {
+            prepareSlot(slot, sensor);
+        }
+    }
+    
+    for (ISensor* sensor : old->allSensors) {
+        if (next->slotOf(sensor) < 0) {
+            removed.push_back(sensor);
+        }
+    }
+    
+    publish(next);
+    
+    LOG_INFO(errorHandler, "Replaced sensor set: " + String(sensors.size()) + " registered, " + 
+                         String(removed.size()) + " removed");
+    return true;
+}
+
 std::vector<ISensor*> SensorRegistry::clear() {
-    std::vector<ISensor*> sensors = allSensors;
-    allSensors.clear();
+    ScopedLock guard(lock);
+    reclaimSnapshotsLocked();
+    std::vector<ISensor*> sensors = snapshot()->allSensors;
+    publish(new Snapshot());
     
     errorHandler->logError(INFO, "Cleared all sensors from registry");
     return sensors;
 }
 
+void SensorRegistry::publish(Snapshot* next) {
+    next->rebuildIndex();
+    const Snapshot* old = current.exchange(next);
+    retiredSnapshots.push_back({old, readers.startGracePeriod()});
+    reclaimSnapshotsLocked();
+}
+
+void SensorRegistry::reclaimSnapshotsLocked() {
+    for (auto it = retiredSnapshots.begin(); it != retiredSnapshots.end();) {
+        if (readers.gracePeriodElapsed(it->token)) {
+            delete it->snapshot;
+            it = retiredSnapshots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t SensorRegistry::reclaimSnapshots() {
+    ScopedLock guard(lock);
+    reclaimSnapshotsLocked();
+    return retiredSnapshots.size();
+}
+
+int SensorRegistry::lowestFreeSlot(const Snapshot& table, const Snapshot* avoid) {
+    for (size_t i = 0; i < Constants::Sensors::MAX_SENSORS; i++) {
+        if (!table.slotTable[i] && !(avoid && avoid->slotTable[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 std::vector<ISensor*> SensorRegistry::getAllSensors() const {
-    return allSensors;
+    return snapshot()->allSensors;
+}
+
+const std::vector<ITemperatureSensor*>& SensorRegistry::getTemperatureSensors() const {
+    return snapshot()->temperatureView;
+}
+
+const std::vector<IHumiditySensor*>& SensorRegistry::getHumiditySensors() const {
+    return snapshot()->humidityView;
+}
+
+uint32_t SensorRegistry::hashName(const SensorName& name) {
+    uint32_t hash = 2166136261UL;
+    for (char c : name.view()) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619UL;
+    }
+    return hash;
 }
 
-std::vector<ITemperatureSensor*> SensorRegistry::getTemperatureSensors() const {
-    std::vector<ITemperatureSensor*> result;
+void SensorRegistry::Snapshot::rebuildIndex() {
+    for (auto& bucket : nameIndex) {
+        bucket = -1;
+    }
+    temperatureView.clear();
+    humidityView.clear();
     
-    for (auto sensor : allSensors) {
-        ITemperatureSensor* tempSensor = getInterfaceFrom<ITemperatureSensor>(
-            sensor, InterfaceType::TEMPERATURE);
+    for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+        slotChannels[slot] = 0;
+        if (!slotTable[slot]) {
+            continue;
+        }
+        for (size_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+            InterfaceType type = static_cast<InterfaceType>(channel);
+            if (slotTable[slot]->supportsInterface(type)) {
+                slotChannels[slot] |= channelBit(type);
+            }
+        }
         
-        if (tempSensor) {
-            result.push_back(tempSensor);
+        size_t bucket = slotHash[slot] & (INDEX_SIZE - 1);
+        while (nameIndex[bucket] >= 0) {
+            bucket = (bucket + 1) & (INDEX_SIZE - 1);
         }
+        nameIndex[bucket] = static_cast<int8_t>(slot);
     }
     
-    return result;
+    // Views keep registration order, like allSensors
+    for (auto sensor : allSensors) {
+        if (auto tempSensor = getInterfaceFrom<ITemperatureSensor>(sensor, InterfaceType::TEMPERATURE)) {
+            temperatureView.push_back(tempSensor);
+        }
+        if (auto humSensor = getInterfaceFrom<IHumiditySensor>(sensor, InterfaceType::HUMIDITY)) {
+            humidityView.push_back(humSensor);
+        }
+    }
 }
 
-std::vector<IHumiditySensor*> SensorRegistry::getHumiditySensors() const {
-    std::vector<IHumiditySensor*> result;
-    
-    for (auto sensor : allSensors) {
-        IHumiditySensor* humSensor = getInterfaceFrom<IHumiditySensor>(
-            sensor, InterfaceType::HUMIDITY);
-        
-        if (humSensor) {
-            result.push_back(humSensor);
+int SensorRegistry::Snapshot::findSlot(std::string_view name, uint32_t hash) const {
+    for (size_t bucket = hash & (INDEX_SIZE - 1);; bucket = (bucket + 1) & (INDEX_SIZE - 1)) {
+        int slot = nameIndex[bucket];
+        if (slot < 0) {
+            return -1;
+        }
+        if (slotHash[slot] == hash && slotTable[slot]->getNameView() == name) {
+            return slot;
         }
     }
-    
-    return result;
 }
 
-ISensor* SensorRegistry::getSensorByName(const String& name) const {
-    for (auto sensor : allSensors) {
-        if (sensor->getName() == name) {
-            return sensor;
+int SensorRegistry::Snapshot::slotOf(const ISensor* sensor) const {
+    for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+        if (slotTable[slot] == sensor) {
+            return slot;
         }
     }
-    return nullptr;
+    return -1;
 }
 
-bool SensorRegistry::hasSensor(const String& name) const {
+ISensor* SensorRegistry::getSensorByName(const SensorName& name) const {
+    if (name.isTruncated()) {
+        return nullptr;
+    }
+    const Snapshot* table = snapshot();
+    int slot = table->findSlot(name.view(), hashName(name));
+    return slot >= 0 ? table->slotTable[slot] : nullptr;
+}
+
+bool SensorRegistry::hasSensor(const SensorName& name) const {
     return getSensorByName(name) != nullptr;
 }
 
+int SensorRegistry::getSlot(const SensorName& name) const {
+    return name.isTruncated() ? -1 : snapshot()->findSlot(name.view(), hashName(name));
+}
+
+ISensor* SensorRegistry::getSensorBySlot(int slot) const {
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return nullptr;
+    }
+    return snapshot()->slotTable[slot];
+}
+
+uint8_t SensorRegistry::getChannels(int slot) const {
+    if (slot < 0 || slot >= static_cast<int>(Constants::Sensors::MAX_SENSORS)) {
+        return 0;
+    }
+    return snapshot()->slotChannels[slot];
+}
+
 size_t SensorRegistry::count() const {
-    return allSensors.size();
-}
\ No newline at end of file
+    return snapshot()->allSensors.size();
+}
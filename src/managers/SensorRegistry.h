@@ -13,31 +13,216 @@
 
  #include <Arduino.h>
  #include <vector>
+ #include <atomic>
+ #include <functional>
  #include <algorithm>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/semphr.h>
  #include "../sensors/interfaces/ISensor.h"
  #include "../sensors/interfaces/ITemperatureSensor.h"
  #include "../sensors/interfaces/IHumiditySensor.h"
  #include "../sensors/interfaces/InterfaceTypes.h"
+ #include "../sensors/SensorName.h"
+ #include "../sensors/SensorTraits.h"
  #include "../error/ErrorHandler.h"
+ #include "QuiescentState.h"
+ #include "Constants.h"
  
  /**
   * @brief Registry for managing sensor instances
   * This class maintains collections of sensors organized by their capabilities,
   * allowing for efficient lookup by type or name. It serves as a central 
   * repository for all active sensors in the system.
+  *
+  * Each sensor's reading slot is its stable integer ID for as long as it
+  * is registered. Name lookups go through a hash index and the interface
+  * views are cached, so per-cycle lookups cost the same no matter how many
+  * sensors are registered.
+  *
+  * The lists and indexes live in an immutable snapshot published through
+  * an atomic pointer. Lookups and iteration never lock; every change
+  * copies the snapshot, edits the copy and swaps it in. A replaced
+  * snapshot is freed only once every registered reader has passed a
+  * quiescent point, so a reader may keep using what it looked up until it
+  * next calls readerQuiescent().
   */
  class SensorRegistry {
+ public:
+     /**
+      * @brief Number of name index buckets, a power of two
+      */
+     static constexpr size_t INDEX_SIZE = [] {
+         size_t size = 1;
+         while (size < Constants::Sensors::MAX_SENSORS * 2) {
+             size <<= 1;
+         }
+         return size;
+     }();
+     static_assert(Constants::Sensors::MAX_SENSORS < 128, "Name index stores slots as int8_t");
+     
+     /**
+      * @brief Grace-period domain of the tasks that read the registry lock-free
+      */
+     typedef QuiescentState<Constants::Sensors::MAX_REGISTRY_READERS> ReaderDomain;
+     
+     /**
+      * @brief Callback run for each newly assigned slot before it is published
+      */
+     typedef std::function<void(int slot, ISensor* sensor)> SlotPreparer;
+     
  private:
      /**
-      * @brief List of all sensor instances
+      * @brief One immutable version of the registry contents
       */
-     std::vector<ISensor*> allSensors;
+     struct Snapshot {
+         /**
+          * @brief List of all sensor instances, in registration order
+          */
+         std::vector<ISensor*> allSensors;
+         
+         /**
+          * @brief Sensor occupying each reading slot (nullptr if free)
+          * Slots are stable for the lifetime of a registration and index the
+          * SensorManager's reading table.
+          */
+         ISensor* slotTable[Constants::Sensors::MAX_SENSORS] = {};
+         
+         /**
+          * @brief Hash of the name of the sensor in each slot
+          */
+         uint32_t slotHash[Constants::Sensors::MAX_SENSORS] = {};
+         
+         /**
+          * @brief channelBit() of every interface of the sensor in each slot
+          * Resolved once per snapshot so the read path never asks a sensor.
+          */
+         uint8_t slotChannels[Constants::Sensors::MAX_SENSORS] = {};
+         
+         /**
+          * @brief Open-addressed name index: slot number per bucket, or -1
+          * Sized to at least twice the slot count so probe chains stay short.
+          * Rebuilt from the slot table for every new snapshot instead of
+          * tracking deletions, since changes are rare and lookups happen
+          * every cycle.
+          */
+         int8_t nameIndex[INDEX_SIZE];
+         
+         /**
+          * @brief Cached temperature interface of every sensor that has one
+          */
+         std::vector<ITemperatureSensor*> temperatureView;
+         
+         /**
+          * @brief Cached humidity interface of every sensor that has one
+          */
+         std::vector<IHumiditySensor*> humidityView;
+         
+         /**
+          * @brief Rebuild the name index and interface views from the slot table
+          */
+         void rebuildIndex();
+         
+         /**
+          * @brief Find the slot holding a name
+          * @param name Sensor name
+          * @param hash Precomputed hashName(name)
+          * @return Slot index, or -1 if not registered
+          */
+         int findSlot(std::string_view name, uint32_t hash) const;
+         
+         /**
+          * @brief Find the slot holding a sensor instance
+          * @param sensor Sensor to look for
+          * @return Slot index, or -1 if not registered
+          */
+         int slotOf(const ISensor* sensor) const;
+     };
+     
+     /**
+      * @brief A replaced snapshot waiting for its grace period
+      */
+     struct RetiredSnapshot {
+         const Snapshot* snapshot;  ///< Snapshot to free
+         uint32_t token;            ///< Grace period that must elapse first
+     };
+     
+     /**
+      * @brief The published snapshot
+      */
+     std::atomic<const Snapshot*> current;
+     
+     /**
+      * @brief Replaced snapshots not yet freed, only touched under the lock
+      */
+     std::vector<RetiredSnapshot> retiredSnapshots;
+     
+     /**
+      * @brief Quiescent-state tracking for the lock-free readers
+      */
+     ReaderDomain readers;
      
      /**
       * @brief Error handler for logging
       */
      ErrorHandler* errorHandler;
      
+     /**
+      * @brief Recursive mutex serializing changes
+      * Readers never take it. Recursive so a visitor may change the
+      * registry from the task that is iterating.
+      */
+     mutable SemaphoreHandle_t lock;
+     
+     /**
+      * @brief Holds the registry lock for the enclosing scope
+      */
+     class ScopedLock {
+     public:
+         explicit ScopedLock(SemaphoreHandle_t mutex) : held(mutex) {
+             if (held) {
+                 xSemaphoreTakeRecursive(held, portMAX_DELAY);
+             }
+         }
+         ~ScopedLock() {
+             if (held) {
+                 xSemaphoreGiveRecursive(held);
+             }
+         }
+         ScopedLock(const ScopedLock&) = delete;
+         ScopedLock& operator=(const ScopedLock&) = delete;
+     private:
+         SemaphoreHandle_t held;
+     };
+     
+     /**
+      * @brief Get the published snapshot
+      * @return Snapshot valid until the caller's next quiescent point
+      */
+     const Snapshot* snapshot() const {
+         return current.load(); // Sequentially consistent, paired with the reader's quiescent report
+     }
+     
+     /**
+      * @brief Swap in a new snapshot and retire the old one
+      * Must be called with the lock held.
+      * @param next Fully built snapshot; the registry takes ownership
+      */
+     void publish(Snapshot* next);
+     
+     /**
+      * @brief Free retired snapshots whose grace period has elapsed
+      * Must be called with the lock held.
+      */
+     void reclaimSnapshotsLocked();
+     
+     /**
+      * @brief Get the lowest slot free in a snapshot
+      * @param table Snapshot being built
+      * @param avoid Snapshot whose occupied slots are skipped if possible, or nullptr
+      * @return Slot index, or -1 if the snapshot is full
+      */
+     static int lowestFreeSlot(const Snapshot& table, const Snapshot* avoid);
+     
      /**
       * @brief Helper to get a specific interface from a sensor if supported
       * @tparam T The interface type to get
@@ -46,7 +231,7 @@
       * @return Pointer to the interface, or nullptr if not supported
       */
      template<typename T>
-     T* getInterfaceFrom(ISensor* sensor, InterfaceType type) const {
+     static T* getInterfaceFrom(ISensor* sensor, InterfaceType type) {
          if (sensor && sensor->supportsInterface(type)) {
              return static_cast<T*>(sensor->getInterface(type));
          }
@@ -62,25 +247,47 @@
      
      /**
       * @brief Destructor
+      * Frees every snapshot without waiting; no reader may still be running.
       * Note: This does not delete the sensor instances, as they are owned by SensorManager
       */
      ~SensorRegistry();
      
+     SensorRegistry(const SensorRegistry&) = delete;
+     SensorRegistry& operator=(const SensorRegistry&) = delete;
+     
      /**
       * @brief Register a sensor in the registry
-      * Adds a sensor to the registry, making it available for lookup by name or type.
+      * Adds a sensor to the registry, making it available for lookup by name or type,
+      * and assigns it the lowest free reading slot.
       * @param sensor Pointer to the sensor to register
+      * @return true if the sensor was registered, false if invalid, duplicate or the registry is full
       */
-     void registerSensor(ISensor* sensor);
+     bool registerSensor(ISensor* sensor);
      
      /**
       * @brief Unregister a sensor from the registry by name
-      * Removes a sensor from the registry, but does not delete it.
+      * Removes a sensor from the registry, but does not delete it. Readers
+      * may still hold it; free it only after a grace period.
       * @param sensorName The name of the sensor to unregister
       * @return The unregistered sensor pointer, or nullptr if not found
       */
      ISensor* unregisterSensor(const String& sensorName);
      
+     /**
+      * @brief Replace the whole sensor set in one swap
+      * Sensors present before and after keep their slots. New sensors get
+      * the lowest slot that neither set uses, so a reader of the old set
+      * never sees its slot change owner, and only fall back to a slot just
+      * vacated when the registry would otherwise be full. Nothing changes
+      * if the new set has a null entry, a duplicate name or too many sensors.
+      * @param sensors The complete new set, in registration order
+      * @param removed [out] Sensors that were registered and are not in the new set
+      * @param prepareSlot Called for each newly assigned slot before the swap, may be empty
+      * @return true if the new set was published
+      */
+     bool replaceSensors(const std::vector<ISensor*>& sensors, std::vector<ISensor*>& removed,
+                         const SlotPreparer& prepareSlot = SlotPreparer());
+     
      /**
       * @brief Clear all sensors from the registry
       * Removes all sensors from the registry, but does not delete them.
@@ -89,44 +296,140 @@
      std::vector<ISensor*> clear();
      
      /**
-      * @brief Get all sensors in the registry
-      * @return Vector of all sensor pointers
+      * @brief Visit every sensor in registration order without copying
+      * Walks the snapshot published when the call started, without
+      * locking, so a concurrent change is never half-seen and never waits
+      * for the walk.
+      * @tparam Visitor Callable taking ISensor*
+      * @param visit Called once per sensor
+      */
+     template<typename Visitor>
+     void forEachSensor(Visitor&& visit) const {
+         for (ISensor* sensor : snapshot()->allSensors) {
+             visit(sensor);
+         }
+     }
+     
+     /**
+      * @brief Visit every occupied reading slot in slot order
+      * Same snapshot semantics as forEachSensor().
+      * @tparam Visitor Callable taking (int slot, ISensor* sensor)
+      * @param visit Called once per occupied slot
+      */
+     template<typename Visitor>
+     void forEachSlot(Visitor&& visit) const {
+         const Snapshot* table = snapshot();
+         for (size_t slot = 0; slot < Constants::Sensors::MAX_SENSORS; slot++) {
+             if (table->slotTable[slot]) {
+                 visit(static_cast<int>(slot), table->slotTable[slot]);
+             }
+         }
+     }
+     
+     /**
+      * @brief Get a snapshot of all sensors in the registry
+      * Allocates; prefer forEachSensor() on polling and query paths.
+      * @return Copy of the sensor list
       */
      std::vector<ISensor*> getAllSensors() const;
      
      /**
       * @brief Get all temperature sensors
       * Returns all sensors that implement the ITemperatureSensor interface.
-      * @return Vector of temperature sensor pointers
+      * @return Cached vector of temperature sensor pointers, valid until the caller's next quiescent point
       */
-     std::vector<ITemperatureSensor*> getTemperatureSensors() const;
+     const std::vector<ITemperatureSensor*>& getTemperatureSensors() const;
      
      /**
       * @brief Get all humidity sensors
       * Returns all sensors that implement the IHumiditySensor interface.
-      * @return Vector of humidity sensor pointers
+      * @return Cached vector of humidity sensor pointers, valid until the caller's next quiescent point
       */
-     std::vector<IHumiditySensor*> getHumiditySensors() const;
+     const std::vector<IHumiditySensor*>& getHumiditySensors() const;
      
      /**
       * @brief Get a sensor by name
+      * Takes the name inline, so lookups never allocate.
       * @param name The name of the sensor to find
       * @return Pointer to the found sensor, or nullptr if not found
       */
-     ISensor* getSensorByName(const String& name) const;
+     ISensor* getSensorByName(const SensorName& name) const;
      
      /**
       * @brief Check if a sensor with the given name exists in the registry
       * @param name The sensor name to check for
       * @return true if the sensor exists, false otherwise
       */
-     bool hasSensor(const String& name) const;
+     bool hasSensor(const SensorName& name) const;
+     
+     /**
+      * @brief Get the reading slot assigned to a sensor
+      * @param name The sensor name
+      * @return Slot index, or -1 if the sensor is not registered
+      */
+     int getSlot(const SensorName& name) const;
+     
+     /**
+      * @brief Get the sensor registered in a reading slot
+      * @param slot Slot index
+      * @return Pointer to the sensor, or nullptr if the slot is free
+      */
+     ISensor* getSensorBySlot(int slot) const;
+     
+     /**
+      * @brief Get the measurement channels of the sensor in a reading slot
+      * @param slot Slot index
+      * @return channelBit() of each interface it provides; 0 if the slot is free
+      */
+     uint8_t getChannels(int slot) const;
      
      /**
       * @brief Get the number of sensors in the registry
       * @return The number of sensors
       */
      size_t count() const;
+     
+     /**
+      * @brief Report that a reader task holds nothing it looked up
+      * Call at the top of the reader's loop. Also brings an offline reader
+      * back online.
+      * @param reader Reader id, below Constants::Sensors::MAX_REGISTRY_READERS
+      */
+     void readerQuiescent(size_t reader) { readers.quiescent(reader); }
+     
+     /**
+      * @brief Take a reader task out of the grace-period domain
+      * Call before a blocking wait and when the task stops.
+      * @param reader Reader id
+      */
+     void readerOffline(size_t reader) { readers.offline(reader); }
+     
+     /**
+      * @brief Begin a grace period for objects unpublished before this call
+      * @return Token to pass to gracePeriodElapsed()
+      */
+     uint32_t startGracePeriod() { return readers.startGracePeriod(); }
+     
+     /**
+      * @brief Check whether every reader has passed a quiescent point since a token
+      * @param token Value returned by startGracePeriod()
+      * @return true if objects unpublished before the token may be freed
+      */
+     bool gracePeriodElapsed(uint32_t token) const { return readers.gracePeriodElapsed(token); }
+     
+     /**
+      * @brief Free replaced snapshots whose grace period has elapsed
+      * Changes do this too; call it to release memory after the last change.
+      * @return Number of snapshots still waiting
+      */
+     size_t reclaimSnapshots();
+     
+     /**
+      * @brief Hash a sensor name for the name index
+      * @param name Sensor name
+      * @return 32-bit FNV-1a hash of the name's bytes
+      */
+     static uint32_t hashName(const SensorName& name);
  };
  
  /** @} */ // End of sensor_registry group
@@ -0,0 +1,119 @@
+/**
+ * @file SeqlockTable.h
+ * @brief Fixed-capacity, slot-indexed table protected by per-slot seqlocks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <cstring>
+ #include <type_traits>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
+
+ /**
+  * @brief Slot-indexed storage for data shared between cores
+  * Each slot carries a sequence counter that is odd while a write is in
+  * progress. Readers copy the slot and retry if the sequence changed
+  * underneath them, so they never take a lock and never allocate. Each
+  * slot must have a single writer (the acquisition worker for its bus).
+  * The copy is done inside a short critical section so a writer cannot be
+  * preempted mid-update, which bounds any reader retry to the duration
+  * of one small memcpy.
+  * @tparam T Trivially copyable payload type
+  * @tparam Capacity Number of slots
+  */
+ template<typename T, size_t Capacity>
+ class SeqlockTable {
+     static_assert(std::is_trivially_copyable<T>::value, "SeqlockTable payload must be trivially copyable");
+
+ public:
+     /**
+      * @brief Get the number of slots in the table
+      * @return Table capacity
+      */
+     static constexpr size_t capacity() { return Capacity; }
+
+     /**
+      * @brief Publish a new value into a slot
+      * @param slot Slot index
+      * @param value Value to store
+      * @return false if the slot index is out of range
+      */
+     bool write(size_t slot, const T& value) {
+         if (slot >= Capacity) {
+             return false;
+         }
+
+         Slot& s = slots[slot];
+         portENTER_CRITICAL(&writeMux);
+         uint32_t seq = s.sequence.load(std::memory_order_relaxed);
+         s.sequence.store(seq + 1, std::memory_order_relaxed);
+         std::atomic_thread_fence(std::memory_order_release);
+         memcpy(&s.data, &value, sizeof(T));
+         s.sequence.store(seq + 2, std::memory_order_release);
+         portEXIT_CRITICAL(&writeMux);
+         return true;
+     }
+
+     /**
+      * @brief Read a consistent copy of a slot
+      * @param slot Slot index
+      * @param out [out] Copy of the slot's value
+      * @return false if the slot is out of range or has never been written
+      */
+     bool read(size_t slot, T& out) const {
+         if (slot >= Capacity) {
+             return false;
+         }
+
+         const Slot& s = slots[slot];
+         while (true) {
+             uint32_t before = s.sequence.load(std::memory_order_acquire);
+             if (before & 1) {
+                 continue; // Writer in progress on the other core
+             }
+
+             memcpy(&out, &s.data, sizeof(T));
+             std::atomic_thread_fence(std::memory_order_acquire);
+
+             if (s.sequence.load(std::memory_order_relaxed) == before) {
+                 return before != 0;
+             }
+         }
+     }
+
+     /**
+      * @brief Get the write sequence of a slot
+      * Changes every time the slot is written; 0 means never written.
+      * @param slot Slot index
+      * @return Current sequence value
+      */
+     uint32_t sequence(size_t slot) const {
+         return slot < Capacity ? slots[slot].sequence.load(std::memory_order_acquire) : 0;
+     }
+
+     /**
+      * @brief Reset a slot to a default-constructed value
+      * Used when a slot is handed to a newly registered sensor.
+      * @param slot Slot index
+      */
+     void reset(size_t slot) {
+         write(slot, T());
+     }
+
+ private:
+     /**
+      * @brief A single sequence-protected slot
+      */
+     struct Slot {
+         std::atomic<uint32_t> sequence{0};  ///< Odd while a write is in progress
+         T data{};                           ///< Payload
+     };
+
+     Slot slots[Capacity];                                 ///< Fixed slot storage
+     portMUX_TYPE writeMux = portMUX_INITIALIZER_UNLOCKED; ///< Keeps writers non-preemptible
+ };
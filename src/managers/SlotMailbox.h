@@ -0,0 +1,185 @@
+/**
+ * @file SlotMailbox.h
+ * @brief Requests to the task that owns a set of slots, answered per slot
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <stddef.h>
+ #include <stdint.h>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/queue.h>
+ #include <freertos/task.h>
+
+ /**
+  * @brief Request queue of a single-owner task, with a reply word per slot
+  * The owner is the only task that acts on the objects behind its slots.
+  * Any other task posts a request naming a slot and, if it needs the
+  * outcome, waits for that slot's reply; it never touches the object
+  * itself. The owner drains the queue between its own work with take()
+  * and answers each request with complete(). What a request asks for is
+  * up to the owner.
+  *
+  * Memory ordering: post() copies the request into a FreeRTOS queue,
+  * whose critical section orders everything the sender wrote before
+  * post() ahead of the owner's take(). complete() publishes the reply
+  * with a release store and isDone() reads it with an acquire load, so
+  * everything the owner did to the slot's object before complete() is
+  * visible to a task that has seen the reply. Nothing else is ordered:
+  * the object may change again right after.
+  *
+  * Tickets are 31 bits and compared wrap-safe. A later request for the
+  * same slot overwrites the reply, so succeeded() reports the outcome of
+  * the slot's latest completed request.
+  * @tparam Slots Number of slots with a reply word
+  * @tparam Depth Requests the queue holds
+  */
+ template <size_t Slots, size_t Depth>
+ class SlotMailbox {
+ public:
+     /**
+      * @brief Handle to a posted request
+      */
+     struct Ticket {
+         int slot = -1;     ///< Slot the request is about
+         uint32_t id = 0;   ///< Issued by post(), never 0
+     };
+
+     /**
+      * @brief One request as the owner takes it
+      */
+     struct Request {
+         Ticket ticket;                 ///< Echoed by complete()
+         TaskHandle_t sender = nullptr; ///< Task notified on completion
+     };
+
+     SlotMailbox() : queue(xQueueCreate(Depth, sizeof(Request))), nextId(1) {
+         for (auto& reply : replies) {
+             reply.store(0);
+         }
+     }
+
+     ~SlotMailbox() {
+         if (queue) {
+             vQueueDelete(queue);
+         }
+     }
+
+     SlotMailbox(const SlotMailbox&) = delete;
+     SlotMailbox& operator=(const SlotMailbox&) = delete;
+
+     /**
+      * @brief Post a request and wake the owner
+      * Never blocks.
+      * @param owner Task to notify, or nullptr to leave it to its next wake-up
+      * @param slot Slot the request is about
+      * @param ticket [out] Handle for isDone(), succeeded() and wait()
+      * @return false if the slot is out of range or the queue is full
+      */
+     bool post(TaskHandle_t owner, int slot, Ticket& ticket) {
+         if (!queue || slot < 0 || slot >= static_cast<int>(Slots)) {
+             return false;
+         }
+         uint32_t id = nextId.fetch_add(1) & ID_MASK;
+         if (id == 0) {
+             id = nextId.fetch_add(1) & ID_MASK; // 0 is the reply of a slot never answered
+         }
+
+         Request request;
+         request.ticket.slot = slot;
+         request.ticket.id = id;
+         request.sender = xTaskGetCurrentTaskHandle();
+         if (xQueueSend(queue, &request, 0) != pdTRUE) {
+             return false;
+         }
+         if (owner) {
+             xTaskNotifyGive(owner);
+         }
+         ticket = request.ticket;
+         return true;
+     }
+
+     /**
+      * @brief Take the oldest request, for the owner
+      * Never blocks.
+      * @param out [out] Request to act on
+      * @return false if the queue is empty
+      */
+     bool take(Request& out) {
+         return queue && xQueueReceive(queue, &out, 0) == pdTRUE;
+     }
+
+     /**
+      * @brief Answer a request and wake its sender, for the owner
+      * Call after the work on the slot's object is finished.
+      * @param request Request returned by take()
+      * @param success Outcome reported to the sender
+      */
+     void complete(const Request& request, bool success) {
+         replies[request.ticket.slot].store((request.ticket.id << 1) | (success ? 1 : 0), std::memory_order_release);
+         if (request.sender) {
+             xTaskNotifyGive(request.sender);
+         }
+     }
+
+     /**
+      * @brief Check whether a request has been answered
+      * @param ticket Ticket filled by post()
+      * @return true once the request, or a later one for its slot, is complete
+      */
+     bool isDone(const Ticket& ticket) const {
+         if (ticket.slot < 0 || ticket.slot >= static_cast<int>(Slots) || ticket.id == 0) {
+             return false;
+         }
+         uint32_t answered = replies[ticket.slot].load(std::memory_order_acquire) >> 1;
+         return answered != 0 && static_cast<int32_t>((answered - ticket.id) << 1) >= 0;
+     }
+
+     /**
+      * @brief Get the outcome of an answered request
+      * @param ticket Ticket filled by post()
+      * @return true if done and the slot's latest completed request succeeded
+      */
+     bool succeeded(const Ticket& ticket) const {
+         return isDone(ticket) && (replies[ticket.slot].load(std::memory_order_acquire) & 1) != 0;
+     }
+
+     /**
+      * @brief Wait for a request to be answered, up to a deadline
+      * Sleeps on the calling task's notification; one taken that was not
+      * the reply is given back before returning, so the caller's own loop
+      * still sees it.
+      * @param ticket Ticket filled by post()
+      * @param timeoutMs Longest wait
+      * @return true if the request is done
+      */
+     bool wait(const Ticket& ticket, uint32_t timeoutMs) const {
+         TickType_t start = xTaskGetTickCount();
+         TickType_t timeout = pdMS_TO_TICKS(timeoutMs);
+         bool notified = false;
+         while (!isDone(ticket)) {
+             TickType_t elapsed = xTaskGetTickCount() - start;
+             if (elapsed >= timeout) {
+                 break;
+             }
+             if (ulTaskNotifyTake(pdTRUE, timeout - elapsed) > 0) {
+                 notified = true;
+             }
+         }
+         if (notified) {
+             xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+         }
+         return isDone(ticket);
+     }
+
+ private:
+     static constexpr uint32_t ID_MASK = 0x7FFFFFFF;   ///< Ticket ids leave the low reply bit for the outcome
+
+     QueueHandle_t queue;                   ///< Pending requests, oldest first
+     std::atomic<uint32_t> nextId;          ///< Next ticket id
+     std::atomic<uint32_t> replies[Slots];  ///< Per slot: id of the latest completed request << 1, plus its outcome
+ };
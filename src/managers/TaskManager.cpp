@@ -1,7 +1,10 @@
 #include "managers/TaskManager.h"
 #include "managers/SensorManager.h"
+#include "managers/PollScheduler.h"
 #include "managers/LedManager.h"
+#include "managers/PowerManager.h"
 #include "communication/CommunicationManager.h"
+#include "communication/TelemetryPublisher.h"
 #include "error/ErrorHandler.h"
 #include <algorithm> // For std::max
 
@@ -10,9 +13,9 @@ void TaskManager::sensorTaskFunction(void* pvParameters) {
     // Add a delay before accessing parameters to ensure system is stable
     vTaskDelay(pdMS_TO_TICKS(50));
     
-    TaskManager* taskManager = static_cast<TaskManager*>(pvParameters);
-    if (taskManager) {
-        taskManager->sensorTask();
+    AcquisitionWorker* worker = static_cast<AcquisitionWorker*>(pvParameters);
+    if (worker && worker->owner) {
+        worker->owner->sensorTask(worker->bus);
     } else {
         // Safety check - this should never happen
         vTaskDelete(NULL);
@@ -45,16 +48,65 @@ void TaskManager::ledTaskFunction(void* pvParameters) {
     }
 }
 
+void TaskManager::recoveryTaskFunction(void* pvParameters) {
+    TaskManager* taskManager = static_cast<TaskManager*>(pvParameters);
+    if (taskManager) {
+        taskManager->recoveryTask();
+    } else {
+        // Safety check - this should never happen
+        vTaskDelete(NULL);
+    }
+}
+
+void TaskManager::telemetryTaskFunction(void* pvParameters) {
+    TaskManager* taskManager = static_cast<TaskManager*>(pvParameters);
+    if (taskManager) {
+        taskManager->telemetryTask();
+    } else {
+        // Safety check - this should never happen
+        vTaskDelete(NULL);
+    }
+}
+
+void TaskManager::supervisorTaskFunction(void* pvParameters) {
+    TaskManager* taskManager = static_cast<TaskManager*>(pvParameters);
+    if (taskManager) {
+        taskManager->supervisorTask();
+    } else {
+        // Safety check - this should never happen
+        vTaskDelete(NULL);
+    }
+}
+
+void TaskManager::logTaskFunction(void* pvParameters) {
+    TaskManager* taskManager = static_cast<TaskManager*>(pvParameters);
+    if (taskManager) {
+        taskManager->logTask();
+    } else {
+        // Safety check - this should never happen
+        vTaskDelete(NULL);
+    }
+}
+
 TaskManager::TaskManager(SensorManager* sensorMgr, CommunicationManager* commMgr, 
                         LedManager* ledMgr, ErrorHandler* errHandler)
     : sensorManager(sensorMgr),
       commManager(commMgr),
       ledManager(ledMgr),
-      errorHandler(errHandler) {
+      errorHandler(errHandler),
+      supervisor(errHandler) {
     // Initialize all task handles to nullptr
-    sensorTaskHandle = nullptr;
+    for (size_t i = 0; i < static_cast<size_t>(AcquisitionBus::COUNT); i++) {
+        sensorWorkers[i].owner = this;
+        sensorWorkers[i].bus = static_cast<AcquisitionBus>(i);
+        sensorWorkers[i].handle = nullptr;
+    }
     commTaskHandle = nullptr;
     ledTaskHandle = nullptr;
+    logTaskHandle = nullptr;
+    recoveryTaskHandle = nullptr;
+    telemetryTaskHandle = nullptr;
+    supervisorTaskHandle = nullptr;
 }
 
 TaskManager::~TaskManager() {
@@ -62,14 +114,12 @@ TaskManager::~TaskManager() {
 }
 
 bool TaskManager::begin() {
-    // Since we're using double buffering for thread safety, we don't need a mutex
-    // We're keeping this method for future initialization if needed
-    
     if (errorHandler) {
         errorHandler->logError(INFO, "Task manager initialization started");
     }
     
-    // Initialize any resources needed for tasks (but not the mutex)
+    // Tasks subscribe themselves to the watchdog as they start
+    supervisor.begin();
     
     if (errorHandler) {
         errorHandler->logError(INFO, "Task manager initialized successfully");
@@ -81,7 +131,13 @@ bool TaskManager::begin() {
 bool TaskManager::startAllTasks() {
     bool success = true;
     
-    // Start the LED task first - it's the simplest
+    // Start the log task first so everything after it logs without blocking
+    success &= startLogTask();
+    
+    // Supervision covers every task from its first check-in
+    success &= startSupervisorTask();
+    
+    // Start the LED task next - it's the simplest
     success &= startLedTask();
     
     // Give time for the LED task to initialize
@@ -96,6 +152,9 @@ bool TaskManager::startAllTasks() {
     // Start the sensor task last
     success &= startSensorTask();
     
+    // Recovery only matters once sensors are being read
+    success &= startRecoveryTask();
+    
     // Give time for all tasks to stabilize
     delay(100);
     
@@ -127,15 +186,15 @@ bool TaskManager::startLedTask() {
         return false;
     }
     
-    // Create the LED task on Core 0 with a larger stack
+    const TaskPlacement& config = placement[TaskRole::LED];
     BaseType_t result = xTaskCreatePinnedToCore(
         ledTaskFunction,          // Task function
         TASK_NAME_LED,            // Task name
-        STACK_SIZE_LED,           // Stack size
+        config.stackSize,        // Stack size
         this,                     // Task parameter (this pointer)
-        PRIORITY_LED,             // Priority
+        config.priority,         // Priority
         &ledTaskHandle,           // Task handle
-        CORE_LED                  // Core ID
+        config.core              // Core ID
     );
     
     if (result != pdPASS) {
@@ -146,18 +205,52 @@ bool TaskManager::startLedTask() {
     }
     
     if (errorHandler) {
-        errorHandler->logError(INFO, "LED task created successfully on Core " + String(CORE_LED));
+        errorHandler->logError(INFO, "LED task created successfully on Core " + taskCoreToString(config.core));
     }
     
     return true;
 }
 
-bool TaskManager::startSensorTask() {
-    if (sensorTaskHandle != nullptr) {
+bool TaskManager::startLogTask() {
+    if (logTaskHandle != nullptr) {
         // Task already running
         return true;
     }
     
+    if (!errorHandler) {
+        return false;
+    }
+    
+    const TaskPlacement& config = placement[TaskRole::LOG];
+    BaseType_t result = xTaskCreatePinnedToCore(
+        logTaskFunction,          // Task function
+        TASK_NAME_LOG,            // Task name
+        config.stackSize,        // Stack size
+        this,                     // Task parameter (this pointer)
+        config.priority,         // Priority
+        &logTaskHandle,           // Task handle
+        config.core              // Core ID
+    );
+    
+    if (result != pdPASS) {
+        errorHandler->logError(ERROR, "Failed to create log task");
+        logTaskHandle = nullptr;
+        return false;
+    }
+    
+    // From here on callers only queue records
+    errorHandler->setLogTask(logTaskHandle);
+    errorHandler->logError(INFO, "Log task created successfully on Core " + taskCoreToString(config.core));
+    
+    return true;
+}
+
+bool TaskManager::startSensorTask() {
+    if (areSensorWorkersRunning()) {
+        // Workers already running
+        return true;
+    }
+    
     if (!sensorManager) {
         if (errorHandler) {
             errorHandler->logError(ERROR, "Sensor manager not initialized for task creation");
@@ -165,31 +258,168 @@ bool TaskManager::startSensorTask() {
         return false;
     }
     
-    // Create the sensor task on Core 0 with a larger stack
+    // One worker per physical bus so conversions on different buses overlap
+    bool success = true;
+    for (auto& worker : sensorWorkers) {
+        if (worker.handle == nullptr) {
+            success &= startSensorWorker(worker);
+        }
+    }
+    
+    return success;
+}
+
+bool TaskManager::startSensorWorker(AcquisitionWorker& worker) {
+    const TaskPlacement& config = placement[TaskRole::SENSOR];
+    worker.taskName = String(TASK_NAME_SENSOR) + "-" + acquisitionBusToString(worker.bus);
+    
     BaseType_t result = xTaskCreatePinnedToCore(
         sensorTaskFunction,       // Task function
-        TASK_NAME_SENSOR,         // Task name
-        STACK_SIZE_SENSOR,        // Stack size
+        worker.taskName.c_str(),  // Task name
+        config.stackSize,        // Stack size
+        &worker,                  // Task parameter (worker context)
+        config.priority,         // Priority
+        &worker.handle,           // Task handle
+        config.core              // Core ID
+    );
+    
+    if (result != pdPASS) {
+        if (errorHandler) {
+            errorHandler->logError(ERROR, "Failed to create sensor task for " + acquisitionBusToString(worker.bus));
+        }
+        worker.handle = nullptr;
+        return false;
+    }
+    
+    // Let the sensor manager wake the worker when the sensor set changes
+    sensorManager->setAcquisitionTask(worker.bus, worker.handle);
+    
+    if (errorHandler) {
+        errorHandler->logError(INFO, "Sensor task for " + acquisitionBusToString(worker.bus) + 
+                              " created successfully on Core " + taskCoreToString(config.core));
+    }
+    return true;
+}
+
+bool TaskManager::startRecoveryTask() {
+    if (recoveryTaskHandle != nullptr) {
+        // Task already running
+        return true;
+    }
+    
+    if (!sensorManager) {
+        if (errorHandler) {
+            errorHandler->logError(ERROR, "Sensor manager not initialized for task creation");
+        }
+        return false;
+    }
+    
+    const TaskPlacement& config = placement[TaskRole::RECOVERY];
+    BaseType_t result = xTaskCreatePinnedToCore(
+        recoveryTaskFunction,     // Task function
+        TASK_NAME_RECOVERY,       // Task name
+        config.stackSize,        // Stack size
         this,                     // Task parameter (this pointer)
-        PRIORITY_SENSOR,          // Priority
-        &sensorTaskHandle,        // Task handle
-        CORE_SENSOR               // Core ID
+        config.priority,         // Priority
+        &recoveryTaskHandle,      // Task handle
+        config.core              // Core ID
     );
     
     if (result != pdPASS) {
         if (errorHandler) {
-            errorHandler->logError(ERROR, "Failed to create sensor task");
+            errorHandler->logError(ERROR, "Failed to create recovery task");
         }
+        recoveryTaskHandle = nullptr;
         return false;
     }
     
     if (errorHandler) {
-        errorHandler->logError(INFO, "Sensor task created successfully on Core " + String(CORE_SENSOR));
+        errorHandler->logError(INFO, "Recovery task created successfully on Core " + taskCoreToString(config.core));
     }
     
     return true;
 }
 
+bool TaskManager::startTelemetryTask() {
+    if (telemetryTaskHandle != nullptr) {
+        // Task already running
+        return true;
+    }
+    
+    if (!telemetryPublisher) {
+        if (errorHandler) {
+            errorHandler->logError(ERROR, "Telemetry publisher not initialized for task creation");
+        }
+        return false;
+    }
+    
+    const TaskPlacement& config = placement[TaskRole::TELEMETRY];
+    BaseType_t result = xTaskCreatePinnedToCore(
+        telemetryTaskFunction,    // Task function
+        TASK_NAME_TELEMETRY,      // Task name
+        config.stackSize,        // Stack size
+        this,                     // Task parameter (this pointer)
+        config.priority,         // Priority
+        &telemetryTaskHandle,     // Task handle
+        config.core              // Core ID
+    );
+    
+    if (result != pdPASS) {
+        if (errorHandler) {
+            errorHandler->logError(ERROR, "Failed to create telemetry task");
+        }
+        telemetryTaskHandle = nullptr;
+        return false;
+    }
+    
+    if (errorHandler) {
+        errorHandler->logError(INFO, "Telemetry task created successfully on Core " + taskCoreToString(config.core));
+    }
+    
+    return true;
+}
+
+bool TaskManager::startSupervisorTask() {
+    if (supervisorTaskHandle != nullptr) {
+        // Task already running
+        return true;
+    }
+    
+    const TaskPlacement& config = placement[TaskRole::SUPERVISOR];
+    BaseType_t result = xTaskCreatePinnedToCore(
+        supervisorTaskFunction,   // Task function
+        TASK_NAME_SUPERVISOR,     // Task name
+        config.stackSize,        // Stack size
+        this,                     // Task parameter (this pointer)
+        config.priority,         // Priority
+        &supervisorTaskHandle,    // Task handle
+        config.core              // Core ID
+    );
+    
+    if (result != pdPASS) {
+        if (errorHandler) {
+            errorHandler->logError(ERROR, "Failed to create supervisor task");
+        }
+        supervisorTaskHandle = nullptr;
+        return false;
+    }
+    
+    if (errorHandler) {
+        errorHandler->logError(INFO, "Supervisor task created successfully on Core " + taskCoreToString(config.core));
+    }
+    
+    return true;
+}
+
+bool TaskManager::areSensorWorkersRunning() const {
+    for (const auto& worker : sensorWorkers) {
+        if (worker.handle == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool TaskManager::startCommTask() {
     if (commTaskHandle != nullptr) {
         // Task already running
@@ -203,26 +433,30 @@ bool TaskManager::startCommTask() {
         return false;
     }
     
-    // Create the communication task on Core 1 with a larger stack
+    const TaskPlacement& config = placement[TaskRole::COMM];
     BaseType_t result = xTaskCreatePinnedToCore(
         commTaskFunction,         // Task function
         TASK_NAME_COMM,           // Task name
-        STACK_SIZE_COMM,          // Stack size
+        config.stackSize,        // Stack size
         this,                     // Task parameter (this pointer)
-        PRIORITY_COMM,            // Priority
+        config.priority,         // Priority
         &commTaskHandle,          // Task handle
-        CORE_COMM                 // Core ID
+        config.core              // Core ID
     );
     
     if (result != pdPASS) {
         if (errorHandler) {
             errorHandler->logError(ERROR, "Failed to create communication task");
         }
+        commTaskHandle = nullptr;
         return false;
     }
     
+    // Input wakes the new task even before it has run, e.g. after a relocation
+    commManager->setInputTask(commTaskHandle);
+    
     if (errorHandler) {
-        errorHandler->logError(INFO, "Communication task created successfully on Core " + String(CORE_COMM));
+        errorHandler->logError(INFO, "Communication task created successfully on Core " + taskCoreToString(config.core));
     }
     
     return true;
@@ -230,27 +464,142 @@ bool TaskManager::startCommTask() {
 
 bool TaskManager::areAllTasksRunning() const {
     return (ledTaskHandle != nullptr && 
-            sensorTaskHandle != nullptr &&
+            logTaskHandle != nullptr &&
+            areSensorWorkersRunning() &&
+            recoveryTaskHandle != nullptr &&
+            supervisorTaskHandle != nullptr &&
             commTaskHandle != nullptr);
 }
 
+bool TaskManager::setTaskPriority(TaskRole role, UBaseType_t priority) {
+    if (role >= TaskRole::COUNT || priority < 1 || priority > Constants::Tasks::MAX_TASK_PRIORITY) {
+        return false;
+    }
+    placement[role].priority = priority;
+    
+    TaskHandle_t handles[static_cast<size_t>(AcquisitionBus::COUNT)];
+    size_t count = getRoleHandles(role, handles);
+    for (size_t i = 0; i < count; i++) {
+        vTaskPrioritySet(handles[i], priority);
+    }
+    return true;
+}
+
+bool TaskManager::setTaskCore(TaskRole role, BaseType_t core) {
+    if (role >= TaskRole::COUNT || (core != tskNO_AFFINITY && (core < 0 || core >= portNUM_PROCESSORS))) {
+        return false;
+    }
+    if (placement[role].core == core) {
+        return true;
+    }
+    placement[role].core = core;
+    
+    // Raise the flags before waking anyone so no task misses its request
+    if (role == TaskRole::SENSOR) {
+        for (auto& worker : sensorWorkers) {
+            worker.relocate.store(worker.handle != nullptr);
+        }
+    } else {
+        relocate[static_cast<size_t>(role)].store(true);
+    }
+    
+    TaskHandle_t handles[static_cast<size_t>(AcquisitionBus::COUNT)];
+    size_t count = getRoleHandles(role, handles);
+    for (size_t i = 0; i < count; i++) {
+        xTaskNotifyGive(handles[i]);
+    }
+    return true;
+}
+
+size_t TaskManager::getRoleHandles(TaskRole role, TaskHandle_t* out) const {
+    TaskHandle_t handle = nullptr;
+    switch (role) {
+        case TaskRole::SENSOR: {
+            size_t count = 0;
+            for (const auto& worker : sensorWorkers) {
+                if (worker.handle != nullptr) {
+                    out[count++] = worker.handle;
+                }
+            }
+            return count;
+        }
+        case TaskRole::COMM: handle = commTaskHandle; break;
+        case TaskRole::LED: handle = ledTaskHandle; break;
+        case TaskRole::LOG: handle = logTaskHandle; break;
+        case TaskRole::RECOVERY: handle = recoveryTaskHandle; break;
+        case TaskRole::TELEMETRY: handle = telemetryTaskHandle; break;
+        case TaskRole::SUPERVISOR: handle = supervisorTaskHandle; break;
+        default: break;
+    }
+    if (handle == nullptr) {
+        return 0;
+    }
+    out[0] = handle;
+    return 1;
+}
+
+bool TaskManager::relocateSelf(TaskHandle_t& handle, const std::function<bool()>& start) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    handle = nullptr;
+    if (!start()) {
+        handle = self;
+        if (errorHandler) {
+            errorHandler->logFormatted(ERROR, "Could not move %s, it stays on Core %d", pcTaskGetName(self),
+                                       static_cast<int>(xPortGetCoreID()));
+        }
+        return false;
+    }
+    
+    // The replacement is running and wired up; only now retire this task
+    supervisor.remove(self);
+    vTaskDelete(NULL);
+    return true;
+}
+
+void TaskManager::deleteTask(TaskHandle_t& handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    // A deleted task that is still subscribed would trip the watchdog
+    supervisor.remove(handle);
+    vTaskDelete(handle);
+    handle = nullptr;
+}
+
 void TaskManager::cleanupTasks() {
     // Delete all tasks if they exist
-    if (ledTaskHandle != nullptr) {
-        vTaskDelete(ledTaskHandle);
-        ledTaskHandle = nullptr;
-    }
+    deleteTask(supervisorTaskHandle);
+    deleteTask(ledTaskHandle);
     
-    if (sensorTaskHandle != nullptr) {
-        vTaskDelete(sensorTaskHandle);
-        sensorTaskHandle = nullptr;
+    for (auto& worker : sensorWorkers) {
+        if (worker.handle != nullptr) {
+            if (sensorManager) {
+                sensorManager->setAcquisitionTask(worker.bus, nullptr);
+            }
+            deleteTask(worker.handle);
+        }
     }
     
+    deleteTask(recoveryTaskHandle);
+    deleteTask(telemetryTaskHandle);
+    
     if (commTaskHandle != nullptr) {
-        vTaskDelete(commTaskHandle);
-        commTaskHandle = nullptr;
+        if (commManager) {
+            commManager->setInputTask(nullptr);
+        }
+        deleteTask(commTaskHandle);
+    }
+    
+    // Return to synchronous logging, then write out whatever was still queued
+    if (logTaskHandle != nullptr) {
+        if (errorHandler) {
+            errorHandler->setLogTask(nullptr);
+        }
+        deleteTask(logTaskHandle);
+        if (errorHandler) {
+            errorHandler->processLogQueue();
+        }
     }
-
     
     tasksInitialized = false;
 }
@@ -260,22 +609,7 @@ String TaskManager::getTaskStateString(TaskHandle_t handle) {
         return "NOT_CREATED";
     }
     
-    eTaskState state = eTaskGetState(handle);
-    
-    switch (state) {
-        case eRunning:
-            return "RUNNING";
-        case eReady:
-            return "READY";
-        case eBlocked:
-            return "BLOCKED";
-        case eSuspended:
-            return "SUSPENDED";
-        case eDeleted:
-            return "DELETED";
-        default:
-            return "UNKNOWN";
-    }
+    return TaskSupervisor::stateName(eTaskGetState(handle));
 }
 
 String TaskManager::getTaskStatusString() const {
@@ -283,21 +617,53 @@ String TaskManager::getTaskStatusString() const {
     
     status += "LED Task: " + getTaskStateString(ledTaskHandle);
     if (ledTaskHandle) {
-        status += " (Core " + String(CORE_LED) + ")\n";
+        status += " (Core " + taskCoreToString(placement[TaskRole::LED].core) + ")\n";
     } else {
         status += "\n";
     }
     
-    status += "Sensor Task: " + getTaskStateString(sensorTaskHandle);
-    if (sensorTaskHandle) {
-        status += " (Core " + String(CORE_SENSOR) + ")\n";
+    for (const auto& worker : sensorWorkers) {
+        status += "Sensor Task " + acquisitionBusToString(worker.bus) + ": " + getTaskStateString(worker.handle);
+        if (worker.handle) {
+            status += " (Core " + taskCoreToString(placement[TaskRole::SENSOR].core) + ")\n";
+        } else {
+            status += "\n";
+        }
+    }
+    
+    status += "Recovery Task: " + getTaskStateString(recoveryTaskHandle);
+    if (recoveryTaskHandle) {
+        status += " (Core " + taskCoreToString(placement[TaskRole::RECOVERY].core) + ")\n";
     } else {
         status += "\n";
     }
     
+    if (telemetryPublisher) {
+        status += "Telemetry Task: " + getTaskStateString(telemetryTaskHandle);
+        if (telemetryTaskHandle) {
+            status += " (Core " + taskCoreToString(placement[TaskRole::TELEMETRY].core) + ")\n";
+        } else {
+            status += "\n";
+        }
+    }
+    
     status += "Communication Task: " + getTaskStateString(commTaskHandle);
     if (commTaskHandle) {
-        status += " (Core " + String(CORE_COMM) + ")\n";
+        status += " (Core " + taskCoreToString(placement[TaskRole::COMM].core) + ")\n";
+    } else {
+        status += "\n";
+    }
+    
+    status += "Log Task: " + getTaskStateString(logTaskHandle);
+    if (logTaskHandle) {
+        status += " (Core " + taskCoreToString(placement[TaskRole::LOG].core) + ")\n";
+    } else {
+        status += "\n";
+    }
+    
+    status += "Supervisor Task: " + getTaskStateString(supervisorTaskHandle);
+    if (supervisorTaskHandle) {
+        status += " (Core " + taskCoreToString(placement[TaskRole::SUPERVISOR].core) + ")\n";
     } else {
         status += "\n";
     }
@@ -313,8 +679,20 @@ String TaskManager::getTaskMemoryInfo() const {
                 " words remaining\n";
     }
     
-    if (sensorTaskHandle) {
-        info += "Sensor Task: " + String(uxTaskGetStackHighWaterMark(sensorTaskHandle)) + 
+    for (const auto& worker : sensorWorkers) {
+        if (worker.handle) {
+            info += "Sensor Task " + acquisitionBusToString(worker.bus) + ": " + 
+                    String(uxTaskGetStackHighWaterMark(worker.handle)) + " words remaining\n";
+        }
+    }
+    
+    if (recoveryTaskHandle) {
+        info += "Recovery Task: " + String(uxTaskGetStackHighWaterMark(recoveryTaskHandle)) + 
+                " words remaining\n";
+    }
+    
+    if (telemetryTaskHandle) {
+        info += "Telemetry Task: " + String(uxTaskGetStackHighWaterMark(telemetryTaskHandle)) + 
                 " words remaining\n";
     }
     
@@ -323,13 +701,23 @@ String TaskManager::getTaskMemoryInfo() const {
                 " words remaining\n";
     }
     
+    if (logTaskHandle) {
+        info += "Log Task: " + String(uxTaskGetStackHighWaterMark(logTaskHandle)) + 
+                " words remaining\n";
+    }
+    
+    if (supervisorTaskHandle) {
+        info += "Supervisor Task: " + String(uxTaskGetStackHighWaterMark(supervisorTaskHandle)) + 
+                " words remaining\n";
+    }
+    
     // Add overall free heap
     info += "Free heap: " + String(ESP.getFreeHeap()) + " bytes\n";
     
     return info;
 }
 
-void TaskManager::sensorTask() {
+void TaskManager::sensorTask(AcquisitionBus bus) {
     // Safety check for null pointers
     if (!sensorManager) {
         if (errorHandler) {
@@ -339,83 +727,134 @@ void TaskManager::sensorTask() {
         return;
     }
     
+    String busName = acquisitionBusToString(bus);
     if (errorHandler) {
-        errorHandler->logError(INFO, "Sensor polling task started on Core " + String(xPortGetCoreID()));
+        errorHandler->logError(INFO, "Sensor polling task for " + busName + " started on Core " + String(xPortGetCoreID()));
     }
     
-    uint32_t lastPollingTime = 0;
-    uint32_t lastI2CRecoveryTime = 0;
-    const uint32_t I2C_RECOVERY_INTERVAL = 5000;
-    const uint32_t MAX_RECONNECT_TIME = 1000; // Max 1 second for reconnection attempts
+    int supervisorId = supervisor.add();
+    PollScheduler scheduler;
+    std::vector<SensorName> dueSensors;
+    dueSensors.reserve(Constants::Sensors::MAX_SENSORS);   // Collecting due sensors never allocates
+    uint32_t scheduleGeneration = sensorManager->getTopologyGeneration() - 1; // Force initial build
     
     // Task loop
     while (true) {
         // Always feed the watchdog at the start of each loop iteration
         yield();
         
-        if (!sensorManager) {
-            vTaskDelay(pdMS_TO_TICKS(100));
-            continue;
-        }
-        
-        unsigned long currentTime = millis();
-        uint32_t pollingInterval = std::max((uint32_t)sensorManager->getMaxCacheAge(), (uint32_t)50);
+        // Nothing looked up from the registry is held across iterations
+        sensorManager->markQuiescent(bus);
         
-        // Check if it's time to poll
-        if (currentTime - lastPollingTime >= pollingInterval) {
-            // Check for disconnected sensors and reconnect if needed
-            if (currentTime - lastI2CRecoveryTime > I2C_RECOVERY_INTERVAL) {
-                bool needsRecovery = false;
-                auto registry = sensorManager->getRegistry();
-                auto sensors = registry.getAllSensors();
-                
-                for (auto sensor : sensors) {
-                    if (!sensor->isConnected()) {
-                        needsRecovery = true;
-                        break;
-                    }
-                }
-                
-                if (needsRecovery) {
-                    if (errorHandler) {
-                        errorHandler->logError(INFO, "Attempting sensor recovery");
-                    }
-                    
-                    // Try to reconnect sensors with timeout
-                    unsigned long reconnectStart = millis();
-                    
-                    // Only allow reconnection attempts for a limited time
-                    if (millis() - reconnectStart < MAX_RECONNECT_TIME) {
-                        sensorManager->reconnectAllSensors();
-                    } else {
-                        errorHandler->logError(WARNING, "Reconnection attempts timed out");
-                    }
-                    
-                    lastI2CRecoveryTime = currentTime;
-                }
+        // Rebuild the schedule whenever sensors are added, removed or reconfigured
+        uint32_t generation = sensorManager->getTopologyGeneration();
+        if (generation != scheduleGeneration) {
+            scheduler.clear();
+            TickType_t now = xTaskGetTickCount();
+            for (const auto& config : sensorManager->getSensorConfigsForBus(bus)) {
+                scheduler.add(config.name, config.pollingRate, now);
             }
+            scheduleGeneration = generation;
             
-            // Update all readings with error handling
+            if (errorHandler) {
+                errorHandler->logError(INFO, "Poll schedule for " + busName + " rebuilt with " + 
+                                      String(scheduler.size()) + " sensors");
+            }
+        }
+        
+        // Reconnection attempts the recovery task asked for; this worker owns the bus's drivers
+        sensorManager->serviceRecoveryRequests(bus);
+        
+        // Read every sensor on this bus whose deadline has passed
+        dueSensors.clear();
+        uint32_t missedBefore = scheduler.getMissedDeadlines();
+        scheduler.collectDue(xTaskGetTickCount(), dueSensors);
+        supervisor.addMissedDeadlines(supervisorId, scheduler.getMissedDeadlines() - missedBefore);
+        
+        // Reads requested by queries join the pass, sharing its bus hold
+        uint32_t requested = sensorManager->takeReadRequests(bus, dueSensors);
+        if (!dueSensors.empty()) {
             try {
-                sensorManager->updateReadings();
+                sensorManager->updateSensors(dueSensors);
             } catch (...) {
                 // Catch any exception during reading to prevent task crash
                 if (errorHandler) {
-                    errorHandler->logError(ERROR, "Exception during sensor reading update");
+                    errorHandler->logError(ERROR, "Exception during sensor reading update on " + busName);
                 }
             }
             
-            // Update timestamp
-            lastPollingTime = currentTime;
-            
             // Signal the LED
             if (ledManager && !ledManager->isIdentifying()) {
                 ledManager->indicateReading();
             }
         }
+        sensorManager->completeReadRequests(bus, requested);
+        
+        // Sleep until the next sensor is due, a read or recovery request or a topology change;
+        // disconnected sensors are not polled, the recovery task decides when they are retried
+        TickType_t wait = scheduler.ticksUntilNextDue(xTaskGetTickCount());
+        
+        // Always block at least one tick to prevent watchdog triggers; a sleeping
+        // worker never holds up the deletion of removed sensors. The check-in
+        // promises the next one within this wait plus the stall grace, so a
+        // driver that wedges is reported within one polling cycle
+        sensorManager->markOffline(bus);
+        ulTaskNotifyTake(pdTRUE, supervisor.checkIn(supervisorId, wait > 0 ? wait : 1));
         
-        // Always have a task delay to prevent watchdog triggers
-        vTaskDelay(pdMS_TO_TICKS(50));
+        // Still offline here, so the worker can be replaced without holding up anyone
+        AcquisitionWorker& worker = sensorWorkers[static_cast<size_t>(bus)];
+        if (worker.relocate.exchange(false)) {
+            relocateSelf(worker.handle, [&] { return startSensorWorker(worker); });
+        }
+    }
+}
+
+void TaskManager::recoveryTask() {
+    if (!sensorManager) {
+        vTaskDelete(NULL);
+        return;
+    }
+    
+    if (errorHandler) {
+        errorHandler->logError(INFO, "Recovery task started on Core " + String(xPortGetCoreID()));
+    }
+    
+    // Waits for the bus workers to re-run blocking initialization on reconnection attempts
+    int supervisorId = supervisor.add(Constants::Tasks::STALL_GRACE_SLOW_MS);
+    while (true) {
+        // Dropout checks are spaced out in low-power mode; retries keep their backoff
+        uint32_t checkMs = Constants::Sensors::RECOVERY_CHECK_MS;
+        if (powerManager) {
+            checkMs = powerManager->idleWakeMs(checkMs);
+        }
+        uint32_t waitMs = sensorManager->serviceRecovery(checkMs);
+        TickType_t wait = pdMS_TO_TICKS(waitMs);
+        ulTaskNotifyTake(pdTRUE, supervisor.checkIn(supervisorId, wait > 0 ? wait : 1));
+        if (takeRelocation(TaskRole::RECOVERY)) {
+            relocateSelf(recoveryTaskHandle, [this] { return startRecoveryTask(); });
+        }
+    }
+}
+
+void TaskManager::telemetryTask() {
+    if (!telemetryPublisher) {
+        vTaskDelete(NULL);
+        return;
+    }
+    
+    if (errorHandler) {
+        errorHandler->logError(INFO, "Telemetry task started on Core " + String(xPortGetCoreID()));
+    }
+    
+    // Connecting to Wi-Fi and the broker blocks for up to CONNECT_TIMEOUT_MS each
+    int supervisorId = supervisor.add(Constants::Tasks::STALL_GRACE_SLOW_MS);
+    while (true) {
+        uint32_t waitMs = telemetryPublisher->service();
+        TickType_t wait = pdMS_TO_TICKS(waitMs);
+        ulTaskNotifyTake(pdTRUE, supervisor.checkIn(supervisorId, wait > 0 ? wait : 1));
+        if (takeRelocation(TaskRole::TELEMETRY)) {
+            relocateSelf(telemetryTaskHandle, [this] { return startTelemetryTask(); });
+        }
     }
 }
 
@@ -434,6 +873,12 @@ void TaskManager::commTask() {
         errorHandler->logError(INFO, "Communication task started on Core " + String(xPortGetCoreID()));
     }
     
+    // Sleep until input arrives or streaming or write-back needs servicing
+    commManager->setInputTask(xTaskGetCurrentTaskHandle());
+    
+    // Bus scans and configuration writes run inline with the command
+    int supervisorId = supervisor.add(Constants::Tasks::STALL_GRACE_SLOW_MS);
+    
     // Task loop
     while (true) {
         // Check for serial data
@@ -454,8 +899,25 @@ void TaskManager::commTask() {
             }
         }
         
-        // Delay to reduce CPU usage
-        vTaskDelay(pdMS_TO_TICKS(5));
+        // Push binary measurement frames between commands
+        commManager->serviceStream();
+        
+        // Coalesced configuration write-back, off the command path
+        commManager->serviceConfig();
+        
+        // A connected host keeps the chip out of light sleep so commands are answered at once
+        if (powerManager) {
+            powerManager->setHostConnected(Serial);
+        }
+        
+        // Lines are assembled incrementally across wakeups; a notification that
+        // arrived while we were busy is still pending, so no input is missed
+        ulTaskNotifyTake(pdTRUE, supervisor.checkIn(supervisorId, pdMS_TO_TICKS(commManager->msUntilServiceDue())));
+        
+        // Partial input lines live in the communication manager and carry over
+        if (takeRelocation(TaskRole::COMM)) {
+            relocateSelf(commTaskHandle, [this] { return startCommTask(); });
+        }
     }
 }
 
@@ -474,14 +936,47 @@ void TaskManager::ledTask() {
         errorHandler->logError(INFO, "LED update task started on Core " + String(xPortGetCoreID()));
     }
     
-    // Task loop
+    // Sleeps on the LED command queue; wakes for commands, timed transitions
+    // and the watchdog check-in
+    int supervisorId = supervisor.add();
     while (true) {
-        // Update LED states - check ledManager is still valid
-        if (ledManager) {
-            ledManager->update();
+        ledManager->step(supervisor.checkIn(supervisorId, portMAX_DELAY));
+        if (takeRelocation(TaskRole::LED)) {
+            relocateSelf(ledTaskHandle, [this] { return startLedTask(); });
         }
+    }
+}
+
+void TaskManager::logTask() {
+    // Format and write queued log records; woken by each new record
+    int supervisorId = supervisor.add();
+    while (true) {
+        uint32_t backstopMs = Constants::Logging::DRAIN_INTERVAL_MS;
+        if (powerManager) {
+            backstopMs = powerManager->idleWakeMs(backstopMs);
+        }
+        ulTaskNotifyTake(pdTRUE, supervisor.checkIn(supervisorId, pdMS_TO_TICKS(backstopMs)));
+        errorHandler->processLogQueue();
         
-        // Use a slightly longer delay to reduce CPU usage
-        vTaskDelay(pdMS_TO_TICKS(50));
+        // The replacement takes over the queue; records logged meanwhile wait in it
+        if (takeRelocation(TaskRole::LOG)) {
+            relocateSelf(logTaskHandle, [this] { return startLogTask(); });
+        }
     }
-}
\ No newline at end of file
+}
+
+void TaskManager::supervisorTask() {
+    if (errorHandler) {
+        errorHandler->logError(INFO, "Supervisor task started on Core " + String(xPortGetCoreID()));
+    }
+    
+    int supervisorId = supervisor.add();
+    TickType_t period = pdMS_TO_TICKS(Constants::Tasks::SUPERVISOR_PERIOD_MS);
+    while (true) {
+        supervisor.service(xTaskGetTickCount());
+        ulTaskNotifyTake(pdTRUE, supervisor.checkIn(supervisorId, period));
+        if (takeRelocation(TaskRole::SUPERVISOR)) {
+            relocateSelf(supervisorTaskHandle, [this] { return startSupervisorTask(); });
+        }
+    }
+}
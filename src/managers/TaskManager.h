@@ -15,12 +15,18 @@
  #include <freertos/task.h>
  #include <freertos/semphr.h>
  #include "Constants.h"
+ #include "SensorManager.h"
+ #include "TaskSupervisor.h"
+ #include "TaskPlacement.h"
+ #include <atomic>
+ #include <functional>
  
  // Forward declarations of manager classes
- class SensorManager;
  class CommunicationManager;
  class LedManager;
  class ErrorHandler;
+ class PowerManager;
+ class TelemetryPublisher;
  
  /**
   * @brief Manages FreeRTOS tasks in a multi-core environment
@@ -34,38 +40,15 @@
       * @name Task names for identification
       * @{
       */
-     static constexpr const char* TASK_NAME_SENSOR = "SensorTask";
+     static constexpr const char* TASK_NAME_SENSOR = "SensorTask";   ///< Prefix; the bus name is appended
      static constexpr const char* TASK_NAME_COMM = "CommTask";
      static constexpr const char* TASK_NAME_LED = "LedTask";
+     static constexpr const char* TASK_NAME_LOG = "LogTask";
+     static constexpr const char* TASK_NAME_RECOVERY = "RecoveryTask";
+     static constexpr const char* TASK_NAME_TELEMETRY = "TelemetryTask";
+     static constexpr const char* TASK_NAME_SUPERVISOR = "SupervisorTask";
      /** @} */
      
-     /** 
-      * @name Task stack sizes (in words)
-      * @{
-      */
-     static constexpr uint32_t STACK_SIZE_SENSOR = Constants::Tasks::STACK_SIZE_SENSOR;
-     static constexpr uint32_t STACK_SIZE_COMM = Constants::Tasks::STACK_SIZE_COMM;
-     static constexpr uint32_t STACK_SIZE_LED = Constants::Tasks::STACK_SIZE_LED;
-     /** @} */
-     
-     /** 
-      * @name Task priorities (higher number = higher priority)
-      * @{
-      */
-     static constexpr UBaseType_t PRIORITY_SENSOR = Constants::Tasks::PRIORITY_SENSOR;
-     static constexpr UBaseType_t PRIORITY_COMM = Constants::Tasks::PRIORITY_COMM;
-     static constexpr UBaseType_t PRIORITY_LED = Constants::Tasks::PRIORITY_LED;
-     /** @} */
-     
-     /** 
-      * @name Core assignments for ESP32 dual-core operation
-      * @{
-      */
-     static constexpr BaseType_t CORE_SENSOR = Constants::Tasks::CORE_SENSOR;
-     static constexpr BaseType_t CORE_COMM = Constants::Tasks::CORE_COMM;
-     static constexpr BaseType_t CORE_LED = Constants::Tasks::CORE_LED;
-     /** @} */
- 
      /**
       * @brief Constructor for TaskManager
       * @param sensorMgr Pointer to the SensorManager
@@ -82,7 +65,58 @@
      ~TaskManager();
      
      /**
-      * @brief Initialize the task manager and create synchronization primitives
+      * @brief Attach the power manager for low-power mode
+      * Call before starting tasks. The comm task then reports USB host
+      * presence, and backstop wake-ups are stretched in low-power mode.
+      * @param powerMgr Pointer to the PowerManager, or nullptr
+      */
+     void setPowerManager(PowerManager* powerMgr) { powerManager = powerMgr; }
+     
+     /**
+      * @brief Attach the network telemetry publisher
+      * Call before startTelemetryTask(); without one no telemetry task runs.
+      * @param publisher Pointer to the TelemetryPublisher, or nullptr
+      */
+     void setTelemetryPublisher(TelemetryPublisher* publisher) { telemetryPublisher = publisher; }
+     
+     /**
+      * @brief Set the core, priority and stack of each task
+      * Call before starting tasks; tasks already running keep theirs.
+      * @param config Placement, normally ConfigManager::getTaskConfig()
+      */
+     void setPlacement(const TaskPlacementConfig& config) { placement = config; }
+     
+     /**
+      * @brief Get the placement tasks are running with
+      * @return Placement including changes made at runtime
+      */
+     const TaskPlacementConfig& getPlacement() const { return placement; }
+     
+     /**
+      * @brief Change the priority of the running tasks of a role
+      * Applies at once to every task of the role, all acquisition workers
+      * for SENSOR, and to tasks started later.
+      * @param role Task role
+      * @param priority New FreeRTOS priority, 1 to MAX_TASK_PRIORITY
+      * @return true if the priority is in range
+      */
+     bool setTaskPriority(TaskRole role, UBaseType_t priority);
+     
+     /**
+      * @brief Move the tasks of a role to another core
+      * FreeRTOS cannot re-pin a running task, so each task is asked to
+      * recreate itself on the new core and then delete itself. That
+      * happens at the task's next wake-up, between work items, so no
+      * transaction is cut short; at the latest one watchdog feed interval
+      * later. A task that cannot be recreated keeps running where it is.
+      * @param role Task role
+      * @param core Core index, or tskNO_AFFINITY
+      * @return true if the core is valid
+      */
+     bool setTaskCore(TaskRole role, BaseType_t core);
+     
+     /**
+      * @brief Initialize the task manager and configure the task watchdog
       * @return true on success, false on failure
       */
      bool begin();
@@ -100,17 +134,63 @@
      bool startLedTask();
      
      /**
-      * @brief Start only the sensor task
+      * @brief Start the log task and switch the error handler to deferred logging
+      * @return true on success, false on failure
+      */
+     bool startLogTask();
+     
+     /**
+      * @brief Start the sensor acquisition workers, one per physical bus
       * @return true on success, false on failure
       */
      bool startSensorTask();
      
+     /**
+      * @brief Start the low-priority worker that reconnects failed sensors
+      * @return true on success, false on failure
+      */
+     bool startRecoveryTask();
+     
+     /**
+      * @brief Start the network telemetry publisher on the communication core
+      * @return true on success, false on failure or without a publisher
+      */
+     bool startTelemetryTask();
+     
      /**
       * @brief Start only the communication task
       * @return true on success, false on failure
       */
      bool startCommTask();
      
+     /**
+      * @brief Start the task that checks for stalls and accounts CPU time
+      * Every task checks in with the supervisor whether or not this runs;
+      * without it stalls are caught by the task watchdog alone.
+      * @return true on success, false on failure
+      */
+     bool startSupervisorTask();
+     
+     /**
+      * @brief Get the task supervisor
+      * @return Reference to the supervisor, for SYST:TASK?
+      */
+     const TaskSupervisor& getSupervisor() const { return supervisor; }
+     
+     /**
+      * @brief Check in the calling task from inside a long command
+      * For handlers such as SYST:BENCH that keep the comm task busy for
+      * longer than its stall grace.
+      */
+     void keepAlive() { supervisor.keepAlive(); }
+     
+     /**
+      * @brief Stop supervising the calling task
+      * For a handler that parks the task for longer than the watchdog
+      * timeout on purpose, such as a FATAL halt; the task is not watched again.
+      */
+     void releaseSupervision() { supervisor.remove(xTaskGetCurrentTaskHandle()); }
+     
      /**
       * @brief Check if all tasks are running
       * @return true if all tasks are running, false otherwise
@@ -137,13 +217,28 @@
      static String getTaskStateString(TaskHandle_t handle);
  
  private:
+     /**
+      * @brief Context for a per-bus sensor acquisition worker
+      */
+     struct AcquisitionWorker {
+         TaskManager* owner = nullptr;           ///< Task manager that owns the worker
+         AcquisitionBus bus = AcquisitionBus::I2C0; ///< Bus polled by this worker
+         TaskHandle_t handle = nullptr;          ///< FreeRTOS task handle
+         String taskName;                        ///< Task name (kept alive for FreeRTOS)
+         std::atomic<bool> relocate{false};      ///< Recreate on the configured core at the next wake-up
+     };
+     
      /**
       * @brief Task handles
       * @{
       */
-     TaskHandle_t sensorTaskHandle = nullptr;
+     AcquisitionWorker sensorWorkers[static_cast<size_t>(AcquisitionBus::COUNT)];
      TaskHandle_t commTaskHandle = nullptr;
      TaskHandle_t ledTaskHandle = nullptr;
+     TaskHandle_t logTaskHandle = nullptr;
+     TaskHandle_t recoveryTaskHandle = nullptr;
+     TaskHandle_t telemetryTaskHandle = nullptr;
+     TaskHandle_t supervisorTaskHandle = nullptr;
      /** @} */
      
      /**
@@ -154,6 +249,8 @@
      CommunicationManager* commManager = nullptr;
      LedManager* ledManager = nullptr;
      ErrorHandler* errorHandler = nullptr;
+     PowerManager* powerManager = nullptr;
+     TelemetryPublisher* telemetryPublisher = nullptr;
      /** @} */
      
      /**
@@ -161,6 +258,22 @@
       */
      bool tasksInitialized = false;
      
+     /**
+      * @brief Core, priority and stack used when a task is created
+      */
+     TaskPlacementConfig placement;
+     
+     /**
+      * @brief Per-role request to recreate the task on its configured core
+      * Not used for SENSOR; each acquisition worker has its own flag.
+      */
+     std::atomic<bool> relocate[static_cast<size_t>(TaskRole::COUNT)] = {};
+     
+     /**
+      * @brief Watchdog registration and stall detection for every task
+      */
+     TaskSupervisor supervisor;
+     
      /**
       * @brief Static task functions that call the appropriate object method
       * @{
@@ -168,17 +281,72 @@
      static void sensorTaskFunction(void* pvParameters);
      static void commTaskFunction(void* pvParameters);
      static void ledTaskFunction(void* pvParameters);
+     static void logTaskFunction(void* pvParameters);
+     static void recoveryTaskFunction(void* pvParameters);
+     static void telemetryTaskFunction(void* pvParameters);
+     static void supervisorTaskFunction(void* pvParameters);
      /** @} */
      
      /**
       * @brief Instance task methods - actual implementations
       * @{
       */
-     void sensorTask();
+     void sensorTask(AcquisitionBus bus);
      void commTask();
      void ledTask();
+     void logTask();
+     void recoveryTask();
+     void telemetryTask();
+     void supervisorTask();
      /** @} */
      
+     /**
+      * @brief Check if every sensor acquisition worker is running
+      * @return true if all workers have been created
+      */
+     bool areSensorWorkersRunning() const;
+     
+     /**
+      * @brief Collect the handles of the running tasks of a role
+      * @param role Task role
+      * @param out Destination, room for one handle per acquisition bus
+      * @return Number of handles written
+      */
+     size_t getRoleHandles(TaskRole role, TaskHandle_t* out) const;
+     
+     /**
+      * @brief Take a pending relocation request of the calling task
+      * @param role Task role; not SENSOR
+      * @return true if the task should move
+      */
+     bool takeRelocation(TaskRole role) { return relocate[static_cast<size_t>(role)].exchange(false); }
+     
+     /**
+      * @brief Recreate the calling task on its configured core and delete it
+      * Called by the task itself at a point where it holds nothing. The
+      * start function creates the replacement and points the managers at
+      * it before this task is deleted.
+      * @param handle Handle slot of the calling task
+      * @param start Creates the replacement of this task only, into handle
+      * @return false if the replacement could not be created; the caller keeps running
+      */
+     bool relocateSelf(TaskHandle_t& handle, const std::function<bool()>& start);
+     
+     /**
+      * @brief Create the acquisition worker of one bus on the configured core
+      * Relocating workers call this for themselves only, so two workers
+      * moving at once never create a task for the same bus.
+      * @param worker Worker context; its handle is set on success
+      * @return true on success, false on failure
+      */
+     bool startSensorWorker(AcquisitionWorker& worker);
+     
+     /**
+      * @brief Unsubscribe a task from supervision and delete it
+      * @param handle Task handle, cleared on return
+      */
+     void deleteTask(TaskHandle_t& handle);
+     
      /**
       * @brief Helper method to clean up all tasks
       */
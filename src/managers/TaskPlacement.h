@@ -0,0 +1,127 @@
+/**
+ * @file TaskPlacement.h
+ * @brief Core, priority and stack settings of the firmware tasks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup task_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <freertos/FreeRTOS.h>
+ #include <strings.h>
+ #include "Constants.h"
+
+ /**
+  * @brief The firmware tasks whose placement can be configured
+  * SENSOR covers every acquisition worker.
+  */
+ enum class TaskRole : uint8_t {
+     SENSOR,
+     COMM,
+     LED,
+     LOG,
+     RECOVERY,
+     TELEMETRY,
+     SUPERVISOR,
+     COUNT   ///< Number of roles
+ };
+
+ /**
+  * @brief Where and how one task runs
+  */
+ struct TaskPlacement {
+     BaseType_t core;        ///< Pinned core, or tskNO_AFFINITY
+     UBaseType_t priority;   ///< FreeRTOS priority
+     uint32_t stackSize;     ///< Stack size, in the units of xTaskCreatePinnedToCore
+
+     bool operator==(const TaskPlacement& other) const {
+         return core == other.core && priority == other.priority && stackSize == other.stackSize;
+     }
+     bool operator!=(const TaskPlacement& other) const { return !(*this == other); }
+
+     /**
+      * @brief Check the settings against the supported ranges
+      * @return true if the task can be created with them
+      */
+     bool isValid() const {
+         return (core == tskNO_AFFINITY || (core >= 0 && core < portNUM_PROCESSORS)) &&
+                priority >= 1 && priority <= Constants::Tasks::MAX_TASK_PRIORITY &&
+                stackSize >= Constants::Tasks::MIN_STACK_SIZE && stackSize <= Constants::Tasks::MAX_STACK_SIZE;
+     }
+ };
+
+ /**
+  * @brief Placement of every task
+  * Stored in config.json as a "Tasks" object with one entry per role,
+  * e.g. "Sensor": {"Core": 1, "Priority": 3, "Stack": 6144}. Roles and
+  * fields left out keep the Constants::Tasks defaults.
+  */
+ struct TaskPlacementConfig {
+     TaskPlacement tasks[static_cast<size_t>(TaskRole::COUNT)] = {
+         {Constants::Tasks::CORE_SENSOR, Constants::Tasks::PRIORITY_SENSOR, Constants::Tasks::STACK_SIZE_SENSOR},
+         {Constants::Tasks::CORE_COMM, Constants::Tasks::PRIORITY_COMM, Constants::Tasks::STACK_SIZE_COMM},
+         {Constants::Tasks::CORE_LED, Constants::Tasks::PRIORITY_LED, Constants::Tasks::STACK_SIZE_LED},
+         {Constants::Tasks::CORE_LOG, Constants::Tasks::PRIORITY_LOG, Constants::Tasks::STACK_SIZE_LOG},
+         {Constants::Tasks::CORE_RECOVERY, Constants::Tasks::PRIORITY_RECOVERY, Constants::Tasks::STACK_SIZE_RECOVERY},
+         {Constants::Tasks::CORE_TELEMETRY, Constants::Tasks::PRIORITY_TELEMETRY, Constants::Tasks::STACK_SIZE_TELEMETRY},
+         {Constants::Tasks::CORE_SUPERVISOR, Constants::Tasks::PRIORITY_SUPERVISOR, Constants::Tasks::STACK_SIZE_SUPERVISOR},
+     };
+
+     TaskPlacement& operator[](TaskRole role) { return tasks[static_cast<size_t>(role)]; }
+     const TaskPlacement& operator[](TaskRole role) const { return tasks[static_cast<size_t>(role)]; }
+
+     bool operator==(const TaskPlacementConfig& other) const {
+         for (size_t i = 0; i < static_cast<size_t>(TaskRole::COUNT); i++) {
+             if (tasks[i] != other.tasks[i]) {
+                 return false;
+             }
+         }
+         return true;
+     }
+     bool operator!=(const TaskPlacementConfig& other) const { return !(*this == other); }
+ };
+
+ /**
+  * @brief Convert a task role to its configuration key
+  * @param role The task role
+  * @return Key used in config.json and SCPI commands
+  */
+ inline const char* taskRoleToString(TaskRole role) {
+     switch (role) {
+         case TaskRole::SENSOR: return "Sensor";
+         case TaskRole::COMM: return "Comm";
+         case TaskRole::LED: return "LED";
+         case TaskRole::LOG: return "Log";
+         case TaskRole::RECOVERY: return "Recovery";
+         case TaskRole::TELEMETRY: return "Telemetry";
+         case TaskRole::SUPERVISOR: return "Supervisor";
+         default: return "Unknown";
+     }
+ }
+
+ /**
+  * @brief Look up a task role by its configuration key, ignoring case
+  * @param name Key as returned by taskRoleToString()
+  * @param role [out] Matching role
+  * @return true if the name is known
+  */
+ inline bool taskRoleFromString(const char* name, TaskRole& role) {
+     for (size_t i = 0; i < static_cast<size_t>(TaskRole::COUNT); i++) {
+         if (strcasecmp(name, taskRoleToString(static_cast<TaskRole>(i))) == 0) {
+             role = static_cast<TaskRole>(i);
+             return true;
+         }
+     }
+     return false;
+ }
+
+ /**
+  * @brief Format a task core for logs and SCPI replies
+  * @param core Core index or tskNO_AFFINITY
+  * @return The core number, or "ANY"
+  */
+ inline String taskCoreToString(BaseType_t core) {
+     return core == tskNO_AFFINITY ? String("ANY") : String(static_cast<int>(core));
+ }
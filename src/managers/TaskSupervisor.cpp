@@ -0,0 +1,290 @@
+#include "TaskSupervisor.h"
+#include "../error/ErrorHandler.h"
+#include <esp_task_wdt.h>
+#include <algorithm>
+#include <cstring>
+
+TaskSupervisor::TaskSupervisor(ErrorHandler* err) : errorHandler(err) {
+    for (uint16_t& load : coreLoad) {
+        load = CPU_UNKNOWN;
+    }
+}
+
+void TaskSupervisor::begin() {
+    // Panic so a wedged task resets the chip instead of leaving it half-working
+    esp_err_t result = esp_task_wdt_init(Constants::Tasks::WATCHDOG_TIMEOUT_S, true);
+    if (result != ESP_OK && errorHandler) {
+        errorHandler->logFormatted(WARNING, "Task watchdog init failed (%d)", static_cast<int>(result));
+    }
+}
+
+int TaskSupervisor::add(uint32_t graceMs) {
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+    TickType_t now = xTaskGetTickCount();
+    int id = -1;
+
+    portENTER_CRITICAL(&mux);
+    for (size_t i = 0; i < Constants::Tasks::MAX_SUPERVISED_TASKS; i++) {
+        if (entries[i].handle == nullptr) {
+            entries[i] = Entry();
+            entries[i].handle = handle;
+            entries[i].graceTicks = pdMS_TO_TICKS(graceMs);
+            entries[i].lastCheckIn = now;
+            entries[i].deadline = now + pdMS_TO_TICKS(Constants::Tasks::WATCHDOG_FEED_MS) + entries[i].graceTicks;
+            id = static_cast<int>(i);
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&mux);
+
+    if (id < 0) {
+        if (errorHandler) {
+            errorHandler->logFormatted(ERROR, "No supervisor entry left for %s", pcTaskGetName(handle));
+        }
+        return -1;
+    }
+
+    esp_err_t result = esp_task_wdt_add(handle);
+    if (result != ESP_OK && errorHandler) {
+        errorHandler->logFormatted(WARNING, "Task watchdog rejected %s (%d)", pcTaskGetName(handle),
+                                   static_cast<int>(result));
+    }
+    return id;
+}
+
+void TaskSupervisor::remove(TaskHandle_t handle) {
+    if (handle == nullptr) {
+        return;
+    }
+
+    bool found = false;
+    portENTER_CRITICAL(&mux);
+    for (Entry& entry : entries) {
+        if (entry.handle == handle) {
+            entry = Entry();
+            found = true;
+        }
+    }
+    portEXIT_CRITICAL(&mux);
+
+    if (found) {
+        esp_task_wdt_delete(handle);
+    }
+}
+
+TickType_t TaskSupervisor::checkIn(int id, TickType_t wait) {
+    TickType_t bounded = std::min(wait, pdMS_TO_TICKS(Constants::Tasks::WATCHDOG_FEED_MS));
+    if (id < 0 || id >= static_cast<int>(Constants::Tasks::MAX_SUPERVISED_TASKS)) {
+        return bounded;
+    }
+
+    esp_task_wdt_reset();
+    TickType_t now = xTaskGetTickCount();
+    portENTER_CRITICAL(&mux);
+    Entry& entry = entries[id];
+    entry.lastCheckIn = now;
+    entry.deadline = now + bounded + entry.graceTicks;
+    portEXIT_CRITICAL(&mux);
+    return bounded;
+}
+
+void TaskSupervisor::keepAlive() {
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+    TickType_t now = xTaskGetTickCount();
+    bool found = false;
+
+    portENTER_CRITICAL(&mux);
+    for (Entry& entry : entries) {
+        if (entry.handle == handle) {
+            entry.lastCheckIn = now;
+            entry.deadline = now + pdMS_TO_TICKS(Constants::Tasks::WATCHDOG_FEED_MS) + entry.graceTicks;
+            found = true;
+        }
+    }
+    portEXIT_CRITICAL(&mux);
+
+    if (found) {
+        esp_task_wdt_reset();
+    }
+}
+
+void TaskSupervisor::addMissedDeadlines(int id, uint32_t count) {
+    if (id < 0 || id >= static_cast<int>(Constants::Tasks::MAX_SUPERVISED_TASKS) || count == 0) {
+        return;
+    }
+    portENTER_CRITICAL(&mux);
+    entries[id].missedDeadlines += count;
+    portEXIT_CRITICAL(&mux);
+}
+
+void TaskSupervisor::service(TickType_t now) {
+    checkStalls(now);
+    refreshReports(now);
+}
+
+void TaskSupervisor::checkStalls(TickType_t now) {
+    for (size_t i = 0; i < Constants::Tasks::MAX_SUPERVISED_TASKS; i++) {
+        // Decide under the lock, log outside it
+        TaskHandle_t handle;
+        bool newlyStalled = false;
+        bool recovered = false;
+        uint32_t silentMs = 0;
+        uint32_t missed = 0;
+
+        portENTER_CRITICAL(&mux);
+        Entry& entry = entries[i];
+        handle = entry.handle;
+        if (handle) {
+            bool overdue = isOverdue(entry.deadline, now);
+            if (overdue && !entry.stalled) {
+                entry.stalled = true;
+                entry.stalls++;
+                newlyStalled = true;
+            } else if (!overdue && entry.stalled) {
+                entry.stalled = false;
+                recovered = true;
+            }
+            silentMs = (now - entry.lastCheckIn) * portTICK_PERIOD_MS;
+            missed = entry.missedDeadlines - entry.reportedMissed;
+            entry.reportedMissed = entry.missedDeadlines;
+        }
+        portEXIT_CRITICAL(&mux);
+
+        if (!handle || !errorHandler) {
+            continue;
+        }
+        if (newlyStalled) {
+            errorHandler->logFormatted(ERROR, "Task %s stalled, no check-in for %lu ms", pcTaskGetName(handle),
+                                       static_cast<unsigned long>(silentMs));
+        } else if (recovered) {
+            errorHandler->logFormatted(WARNING, "Task %s running again", pcTaskGetName(handle));
+        }
+        if (missed > 0) {
+            errorHandler->logFormatted(WARNING, "Task %s missed %lu acquisition deadlines", pcTaskGetName(handle),
+                                       static_cast<unsigned long>(missed));
+        }
+    }
+}
+
+void TaskSupervisor::refreshReports(TickType_t now) {
+#if configUSE_TRACE_FACILITY
+    uint32_t total = 0;
+    size_t count = uxTaskGetSystemState(snapshot, Constants::Tasks::MAX_SYSTEM_TASKS, &total);
+    uint32_t window = total - previousTotal;
+
+    TaskReport building[Constants::Tasks::MAX_SYSTEM_TASKS];
+    uint32_t idleDelta[portNUM_PROCESSORS] = {};
+    bool idleSeen[portNUM_PROCESSORS] = {};
+
+    for (size_t i = 0; i < count; i++) {
+        const TaskStatus_t& task = snapshot[i];
+        TaskReport& report = building[i];
+        strncpy(report.name, task.pcTaskName, sizeof(report.name) - 1);
+        report.name[sizeof(report.name) - 1] = '\0';
+        report.core = xTaskGetAffinity(task.xHandle);
+        report.state = task.eCurrentState;
+        report.priority = task.uxCurrentPriority;
+        report.stackFree = task.usStackHighWaterMark;
+        report.cpuPermille = CPU_UNKNOWN;
+
+#if configGENERATE_RUN_TIME_STATS
+        // A task that was not in the previous snapshot has run only since it was created
+        uint32_t delta = task.ulRunTimeCounter;
+        for (size_t j = 0; j < previousCount; j++) {
+            if (previousHandles[j] == task.xHandle) {
+                delta = task.ulRunTimeCounter - previousCounters[j];
+                break;
+            }
+        }
+        if (previousTotal != 0) {
+            report.cpuPermille = toPermille(delta, window);
+        }
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+            if (task.xHandle == xTaskGetIdleTaskHandleForCPU(core)) {
+                idleDelta[core] = delta;
+                idleSeen[core] = true;
+            }
+        }
+#endif
+
+        report.supervised = false;
+        report.stalled = false;
+        report.sinceCheckInMs = 0;
+        report.missedDeadlines = 0;
+        report.stalls = 0;
+        portENTER_CRITICAL(&mux);
+        for (const Entry& entry : entries) {
+            if (entry.handle == task.xHandle) {
+                report.supervised = true;
+                report.stalled = entry.stalled;
+                report.sinceCheckInMs = (now - entry.lastCheckIn) * portTICK_PERIOD_MS;
+                report.missedDeadlines = entry.missedDeadlines;
+                report.stalls = entry.stalls;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&mux);
+    }
+
+#if configGENERATE_RUN_TIME_STATS
+    for (size_t i = 0; i < count; i++) {
+        previousHandles[i] = snapshot[i].xHandle;
+        previousCounters[i] = snapshot[i].ulRunTimeCounter;
+    }
+    previousCount = count;
+#endif
+
+    portENTER_CRITICAL(&mux);
+    memcpy(reports, building, count * sizeof(TaskReport));
+    reportCount = count;
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+        coreLoad[core] = (previousTotal != 0 && idleSeen[core]) ? 1000 - toPermille(idleDelta[core], window)
+                                                                : CPU_UNKNOWN;
+    }
+    portEXIT_CRITICAL(&mux);
+
+    // Zero from uxTaskGetSystemState means the snapshot array was too small
+    if (count == 0 && errorHandler) {
+        errorHandler->logFormatted(WARNING, "More than %u tasks, CPU accounting skipped",
+                                   static_cast<unsigned>(Constants::Tasks::MAX_SYSTEM_TASKS));
+    }
+    previousTotal = count > 0 ? total : 0;
+#endif
+}
+
+size_t TaskSupervisor::getReports(TaskReport* out, size_t max) const {
+    portENTER_CRITICAL(&mux);
+    size_t count = std::min(max, reportCount);
+    memcpy(out, reports, count * sizeof(TaskReport));
+    portEXIT_CRITICAL(&mux);
+    return count;
+}
+
+uint16_t TaskSupervisor::getCoreLoad(BaseType_t core) const {
+    if (core < 0 || core >= portNUM_PROCESSORS) {
+        return CPU_UNKNOWN;
+    }
+    portENTER_CRITICAL(&mux);
+    uint16_t load = coreLoad[core];
+    portEXIT_CRITICAL(&mux);
+    return load;
+}
+
+const char* TaskSupervisor::stateName(eTaskState state) {
+    switch (state) {
+        case eRunning: return "RUNNING";
+        case eReady: return "READY";
+        case eBlocked: return "BLOCKED";
+        case eSuspended: return "SUSPENDED";
+        case eDeleted: return "DELETED";
+        default: return "UNKNOWN";
+    }
+}
+
+uint16_t TaskSupervisor::toPermille(uint32_t delta, uint32_t window) {
+    if (window == 0) {
+        return 0;
+    }
+    uint64_t permille = static_cast<uint64_t>(delta) * 1000 / window;
+    return static_cast<uint16_t>(std::min<uint64_t>(permille, 1000));
+}
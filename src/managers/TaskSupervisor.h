@@ -0,0 +1,200 @@
+/**
+ * @file TaskSupervisor.h
+ * @brief Task watchdog registration, stall detection and CPU accounting
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup task_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
+ #include "Constants.h"
+
+ class ErrorHandler;
+
+ /**
+  * @brief Watches the firmware tasks and measures where the CPU time goes
+  * Every supervised task registers itself from its own context with add()
+  * and then passes each block through checkIn(), which feeds the ESP task
+  * watchdog, caps the block at Constants::Tasks::WATCHDOG_FEED_MS and
+  * records when the task will next check in:
+  *
+  *     ulTaskNotifyTake(pdTRUE, supervisor.checkIn(id, wait));
+  *
+  * The supervisor task calls service() every SUPERVISOR_PERIOD_MS. A task
+  * that is STALL_GRACE_MS past its promised check-in is logged as stalled;
+  * for an acquisition worker that is within one polling cycle of a driver
+  * wedging. If it stays silent the task watchdog resets the chip.
+  *
+  * service() also takes a uxTaskGetSystemState() snapshot of every task,
+  * including the system's, and turns the run-time counters into CPU use
+  * per task and per core over the last period. The counters need
+  * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS; without it CPU use is reported
+  * as unknown and everything else still works.
+  */
+ class TaskSupervisor {
+ public:
+     static const uint16_t CPU_UNKNOWN = 0xFFFF;   ///< cpuPermille when run-time stats are not compiled in
+
+     /**
+      * @brief State of one task over the last period
+      */
+     struct TaskReport {
+         char name[configMAX_TASK_NAME_LEN];   ///< FreeRTOS task name
+         BaseType_t core;                       ///< Pinned core, or tskNO_AFFINITY
+         eTaskState state;                      ///< Scheduler state at the snapshot
+         UBaseType_t priority;                  ///< Current priority
+         uint32_t stackFree;                    ///< Stack high water mark
+         uint16_t cpuPermille;                  ///< Share of one core, in tenths of a percent
+         bool supervised;                       ///< Whether the fields below apply
+         bool stalled;                          ///< Past its check-in deadline
+         uint32_t sinceCheckInMs;               ///< Time since the last check-in
+         uint32_t missedDeadlines;              ///< Acquisition polls that fell a whole period behind
+         uint32_t stalls;                       ///< Times the task has been reported stalled
+     };
+
+     /**
+      * @brief Constructor
+      * @param err Error handler for stall reports, or nullptr
+      */
+     explicit TaskSupervisor(ErrorHandler* err);
+
+     TaskSupervisor(const TaskSupervisor&) = delete;
+     TaskSupervisor& operator=(const TaskSupervisor&) = delete;
+
+     /**
+      * @brief Configure the task watchdog
+      * Call once before the tasks start.
+      */
+     void begin();
+
+     /**
+      * @brief Supervise the calling task and subscribe it to the task watchdog
+      * @param graceMs Work allowed between waking and the next check-in
+      * @return Id for checkIn(), or -1 if the table is full
+      */
+     int add(uint32_t graceMs = Constants::Tasks::STALL_GRACE_MS);
+
+     /**
+      * @brief Stop supervising a task and unsubscribe it from the task watchdog
+      * Call before deleting a supervised task, or the watchdog fires.
+      * @param handle Task handle
+      */
+     void remove(TaskHandle_t handle);
+
+     /**
+      * @brief Check in before blocking
+      * Feeds the task watchdog for the calling task.
+      * @param id Id returned by add(); -1 only bounds the wait
+      * @param wait Ticks the task wants to block
+      * @return Ticks to block, at most WATCHDOG_FEED_MS
+      */
+     TickType_t checkIn(int id, TickType_t wait);
+
+     /**
+      * @brief Check in the calling task from inside a long piece of work
+      * Feeds the task watchdog and moves the task's deadline as a
+      * check-in before a WATCHDOG_FEED_MS block would, so a command that
+      * runs for seconds on purpose is not reported stalled. Does nothing
+      * for a task that is not supervised.
+      */
+     void keepAlive();
+
+     /**
+      * @brief Count acquisition polls that fell a whole period behind
+      * @param id Id returned by add()
+      * @param count Newly missed deadlines
+      */
+     void addMissedDeadlines(int id, uint32_t count);
+
+     /**
+      * @brief Check for stalls and refresh the CPU accounting
+      * Called from the supervisor task.
+      * @param now Current tick count
+      */
+     void service(TickType_t now);
+
+     /**
+      * @brief Copy the task reports from the last service()
+      * @param out Destination
+      * @param max Reports that fit in out
+      * @return Number of reports copied
+      */
+     size_t getReports(TaskReport* out, size_t max) const;
+
+     /**
+      * @brief Get the CPU use of a core over the last period
+      * @param core Core index
+      * @return Busy share in tenths of a percent, or CPU_UNKNOWN
+      */
+     uint16_t getCoreLoad(BaseType_t core) const;
+
+     /**
+      * @brief Check whether a check-in deadline has passed
+      * @param deadline Tick by which the task promised to check in
+      * @param now Current tick count
+      * @return true if now is after deadline, wrap-safe
+      */
+     static bool isOverdue(TickType_t deadline, TickType_t now) {
+         return static_cast<int32_t>(now - deadline) > 0;
+     }
+
+     /**
+      * @brief Convert a scheduler state to its display name
+      * @param state FreeRTOS task state
+      * @return Upper-case name of the state
+      */
+     static const char* stateName(eTaskState state);
+
+     /**
+      * @brief Convert a run-time counter delta to a share of one core
+      * @param delta Counter increase of the task
+      * @param window Counter increase of the whole system over the same time
+      * @return Tenths of a percent, clamped to 1000
+      */
+     static uint16_t toPermille(uint32_t delta, uint32_t window);
+
+ private:
+     /**
+      * @brief Check-in state of one supervised task
+      */
+     struct Entry {
+         TaskHandle_t handle = nullptr;   ///< Supervised task, nullptr for a free entry
+         TickType_t graceTicks = 0;       ///< Work allowed after a block
+         TickType_t lastCheckIn = 0;      ///< Tick of the last check-in
+         TickType_t deadline = 0;         ///< Tick by which the next check-in is due
+         uint32_t missedDeadlines = 0;    ///< Acquisition polls a whole period late
+         uint32_t reportedMissed = 0;     ///< missedDeadlines at the last log line
+         uint32_t stalls = 0;             ///< Stall episodes
+         bool stalled = false;            ///< In a stall episode
+     };
+
+     ErrorHandler* errorHandler;                                      ///< Error handler for logging
+     Entry entries[Constants::Tasks::MAX_SUPERVISED_TASKS];           ///< Supervised tasks
+     mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;         ///< Guards entries and the reports
+
+     TaskStatus_t snapshot[Constants::Tasks::MAX_SYSTEM_TASKS];       ///< Scratch for uxTaskGetSystemState
+     TaskHandle_t previousHandles[Constants::Tasks::MAX_SYSTEM_TASKS]; ///< Tasks at the previous snapshot
+     uint32_t previousCounters[Constants::Tasks::MAX_SYSTEM_TASKS];  ///< Their run-time counters
+     size_t previousCount = 0;                                        ///< Entries in previousHandles
+     uint32_t previousTotal = 0;                                      ///< Total run time at the previous snapshot
+
+     TaskReport reports[Constants::Tasks::MAX_SYSTEM_TASKS];          ///< Output of the last service()
+     size_t reportCount = 0;                                          ///< Valid entries in reports
+     uint16_t coreLoad[portNUM_PROCESSORS];                          ///< Busy share per core
+
+     /**
+      * @brief Take a system snapshot and rebuild the reports
+      * @param now Current tick count
+      */
+     void refreshReports(TickType_t now);
+
+     /**
+      * @brief Log stall transitions and newly missed deadlines
+      * @param now Current tick count
+      */
+     void checkStalls(TickType_t now);
+ };
@@ -0,0 +1,63 @@
+#include "TimeSync.h"
+#include <cstdlib>
+
+void TimeSync::synchronize(uint64_t epochUs, TimeSource source, uint64_t deviceUs) {
+    Status next = getStatus();
+
+    int64_t deviceDelta = static_cast<int64_t>(deviceUs - next.deviceUs);
+    if (next.source == source && deviceDelta >= static_cast<int64_t>(Constants::Time::MIN_DRIFT_INTERVAL_US)) {
+        // Reference time elapsed against device time elapsed since the last sync
+        int64_t epochDelta = static_cast<int64_t>(epochUs - next.epochUs);
+        int64_t offset = epochDelta - deviceDelta;
+
+        // Clock steps are rejected before scaling, which would overflow for steps of hours
+        const int64_t PPB = 1000000000LL;
+        int64_t maxOffset = deviceDelta / PPB * Constants::Time::MAX_DRIFT_PPB +
+                            deviceDelta % PPB * Constants::Time::MAX_DRIFT_PPB / PPB;
+        if (llabs(offset) <= maxOffset) {
+            // offset * PPB only overflows once the syncs are over a year apart
+            int32_t observed = static_cast<int32_t>(llabs(offset) <= INT64_MAX / PPB ? offset * PPB / deviceDelta
+                                                                                     : offset / (deviceDelta / PPB));
+            next.driftPpb = next.driftKnown ? next.driftPpb + (observed - next.driftPpb) / Constants::Time::DRIFT_SMOOTHING
+                                            : observed;
+            next.driftKnown = true;
+        }
+    }
+
+    next.source = source;
+    next.deviceUs = deviceUs;
+    next.epochUs = epochUs;
+    next.syncs++;
+
+    portENTER_CRITICAL(&mux);
+    state = next;
+    portEXIT_CRITICAL(&mux);
+}
+
+bool TimeSync::isSynchronized() const {
+    return getStatus().source != TimeSource::NONE;
+}
+
+uint64_t TimeSync::toEpochUs(uint64_t deviceUs) const {
+    Status status = getStatus();
+    return status.source == TimeSource::NONE ? 0 : mapToEpoch(status, deviceUs);
+}
+
+uint64_t TimeSync::reportTimeUs(uint64_t deviceUs) const {
+    Status status = getStatus();
+    return status.source == TimeSource::NONE ? deviceUs : mapToEpoch(status, deviceUs);
+}
+
+TimeSync::Status TimeSync::getStatus() const {
+    portENTER_CRITICAL(&mux);
+    Status copy = state;
+    portEXIT_CRITICAL(&mux);
+    return copy;
+}
+
+uint64_t TimeSync::mapToEpoch(const Status& status, uint64_t deviceUs) {
+    // Readings taken before the sync map backwards with the same rate
+    int64_t elapsed = static_cast<int64_t>(deviceUs - status.deviceUs);
+    int64_t correction = status.driftKnown ? elapsed * status.driftPpb / 1000000000LL : 0;
+    return status.epochUs + elapsed + correction;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file TimeSync.h
+ * @brief Mapping from device time to wall-clock time with drift estimation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_management
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <esp_timer.h>
+ #include <freertos/FreeRTOS.h>
+ #include "Constants.h"
+
+ /**
+  * @brief Where the wall-clock reference came from
+  */
+ enum class TimeSource : uint8_t {
+     NONE,   ///< Never synchronized; times are microseconds since boot
+     HOST,   ///< SYST:TIME from the host
+     SNTP    ///< Network time server
+ };
+
+ /**
+  * @brief Convert a time source to its display name
+  * @param source The time source
+  * @return Upper-case name of the source
+  */
+ inline const char* timeSourceToString(TimeSource source) {
+     switch (source) {
+         case TimeSource::HOST: return "HOST";
+         case TimeSource::SNTP: return "SNTP";
+         default: return "NONE";
+     }
+ }
+
+ /**
+  * @brief Maps esp_timer microseconds to Unix epoch microseconds
+  * Readings are stamped with esp_timer_get_time(), which is monotonic
+  * and unaffected by synchronization; they are converted to wall-clock
+  * time only when reported, so a later sync also places readings taken
+  * before it.
+  *
+  * Each sync sets the reference point. Two syncs from the same source at
+  * least Constants::Time::MIN_DRIFT_INTERVAL_US apart give the rate of
+  * the device crystal against the reference, which is smoothed and used
+  * to extrapolate between syncs. Apparent rates beyond MAX_DRIFT_PPB are
+  * taken as a step of the reference clock and do not touch the estimate.
+  *
+  * Syncs may come from the communication task and the SNTP callback; the
+  * state is copied in and out under a spinlock.
+  */
+ class TimeSync {
+ public:
+     /**
+      * @brief Snapshot of the current mapping
+      */
+     struct Status {
+         TimeSource source = TimeSource::NONE;   ///< Source of the last sync
+         uint64_t deviceUs = 0;                  ///< Device time of the last sync
+         uint64_t epochUs = 0;                   ///< Wall-clock time of the last sync
+         int32_t driftPpb = 0;                   ///< Device clock rate error in parts per billion, positive if it runs slow
+         bool driftKnown = false;                ///< Whether driftPpb has been estimated
+         uint32_t syncs = 0;                     ///< Syncs since boot
+     };
+
+     /**
+      * @brief Record that the device time corresponds to a wall-clock time
+      * @param epochUs Microseconds since the Unix epoch
+      * @param source Where the time came from
+      * @param deviceUs esp_timer time at which epochUs was valid
+      */
+     void synchronize(uint64_t epochUs, TimeSource source, uint64_t deviceUs);
+
+     /**
+      * @brief Record that the current device time corresponds to a wall-clock time
+      * @param epochUs Microseconds since the Unix epoch
+      * @param source Where the time came from
+      */
+     void synchronize(uint64_t epochUs, TimeSource source) {
+         synchronize(epochUs, source, static_cast<uint64_t>(esp_timer_get_time()));
+     }
+
+     /**
+      * @brief Check whether any sync has happened
+      * @return true if toEpochUs() gives wall-clock times
+      */
+     bool isSynchronized() const;
+
+     /**
+      * @brief Convert a device time to wall-clock time
+      * @param deviceUs esp_timer time
+      * @return Microseconds since the Unix epoch, or 0 if never synchronized
+      */
+     uint64_t toEpochUs(uint64_t deviceUs) const;
+
+     /**
+      * @brief Convert a device time to the time reported to hosts
+      * @param deviceUs esp_timer time
+      * @return Epoch microseconds once synchronized, otherwise deviceUs unchanged
+      */
+     uint64_t reportTimeUs(uint64_t deviceUs) const;
+
+     /**
+      * @brief Get the current mapping
+      * @return Copy of the mapping state
+      */
+     Status getStatus() const;
+
+     /**
+      * @brief Apply a mapping to a device time
+      * @param status Mapping
+      * @param deviceUs esp_timer time
+      * @return Microseconds since the Unix epoch
+      */
+     static uint64_t mapToEpoch(const Status& status, uint64_t deviceUs);
+
+ private:
+     Status state;                                       ///< Current mapping
+     mutable portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED; ///< Guards state
+ };
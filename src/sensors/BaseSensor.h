@@ -13,8 +13,16 @@
  #include <Arduino.h>
  #include "interfaces/ISensor.h"
  #include "interfaces/InterfaceTypes.h"
+ #include "interfaces/ITemperatureSensor.h"
+ #include "interfaces/IHumiditySensor.h"
+ #include "readings/SensorSample.h"
  #include "../error/ErrorHandler.h"
  #include "SensorTypes.h"
+ #include "SensorName.h"
+ #include "Constants.h"
+ #include <atomic>
+ #include <freertos/FreeRTOS.h>
+ #include <freertos/task.h>
  
  /**
   * @brief Base class for all sensor implementations
@@ -24,10 +32,61 @@
   */
  class BaseSensor : public ISensor {
  protected:
-     String name;                   ///< Unique identifier for this sensor
+     SensorName name;               ///< Unique identifier for this sensor, stored inline
      SensorType type;               ///< Type of sensor
-     bool connected;                ///< Connection status
+     std::atomic<bool> connected;   ///< Connection status; written by the owner only, read from any task
      ErrorHandler* errorHandler;    ///< Error reporting mechanism
+     int consecutiveFailures = 0;   ///< Failed conversions since the last success
+     
+     /**
+      * @brief Track consecutive conversion failures
+      * A single failed conversion leaves the sensor connected so the next
+      * poll can retry; after Constants::Sensors::MAX_RETRIES failures in a
+      * row the sensor is marked disconnected and left to the recovery path.
+      * @param success Whether the conversion succeeded
+      */
+     void recordConversionResult(bool success) {
+         if (success) {
+             consecutiveFailures = 0;
+             return;
+         }
+         
+         if (++consecutiveFailures >= Constants::Sensors::MAX_RETRIES) {
+             errorHandler->logError(ERROR, "Sensor " + getName() + " failed " + String(consecutiveFailures) +
+                                   " consecutive conversions, marking disconnected");
+             connected = false;
+             consecutiveFailures = 0;
+         }
+     }
+     
+     /**
+      * @brief Run one conversion through the asynchronous lifecycle and wait for it
+      * Sleeps (rather than spins) between polls so other tasks can run.
+      * Drivers that implement the lifecycle use this for their blocking sample().
+      * @param out [out] Sample to fill
+      * @param timeoutMs Maximum time to wait for the conversion
+      * @return true if at least one channel was read successfully
+      */
+     bool runConversion(SensorSample& out, uint32_t timeoutMs = Constants::Sensors::CONVERSION_TIMEOUT_MS) {
+         out = SensorSample();
+         if (!startConversion()) {
+             return false;
+         }
+         
+         unsigned long start = millis();
+         while (true) {
+             TickType_t waitTicks = pdMS_TO_TICKS(getConversionDelayMs());
+             vTaskDelay(waitTicks > 0 ? waitTicks : 1);
+             
+             ConversionStatus status = pollConversion();
+             if (status == ConversionStatus::READY) {
+                 return fetchResult(out);
+             }
+             if (status == ConversionStatus::FAILED || millis() - start >= timeoutMs) {
+                 return false;
+             }
+         }
+     }
  
  public:
      /**
@@ -49,7 +108,15 @@
       * @return The sensor's name/identifier
       */
      String getName() const override {
-         return name;
+         return String(name.c_str());
+     }
+     
+     /**
+      * @brief Get the name of the sensor without copying it
+      * @return View of the inline name, valid as long as the sensor
+      */
+     std::string_view getNameView() const override {
+         return name.view();
      }
      
      /**
@@ -95,6 +162,85 @@
      void* getInterface(InterfaceType type) const override {
          return nullptr;
      }
+     
+     /**
+      * @brief Read one channel on its own
+      * Used by the default sample(). Covers the channels that have a read
+      * interface of their own; a driver for any other channel overrides
+      * this or sample().
+      * @param type Channel to read, one the sensor supports
+      * @return The value, NaN if the channel cannot be read
+      */
+     virtual float readChannel(InterfaceType type) {
+         switch (type) {
+             case InterfaceType::TEMPERATURE: {
+                 ITemperatureSensor* tempSensor = static_cast<ITemperatureSensor*>(getInterface(type));
+                 return tempSensor ? tempSensor->readTemperature() : NAN;
+             }
+             case InterfaceType::HUMIDITY: {
+                 IHumiditySensor* humSensor = static_cast<IHumiditySensor*>(getInterface(type));
+                 return humSensor ? humSensor->readHumidity() : NAN;
+             }
+             default:
+                 return NAN;
+         }
+     }
+     
+     /**
+      * @brief Default implementation of sample that reads each channel separately
+      * Reads every channel the sensor supports with readChannel(). Sensors
+      * that can produce all channels from one conversion should override
+      * this to avoid a bus transaction per channel.
+      * @param out [out] Sample to fill
+      * @return true if at least one channel was read successfully
+      */
+     bool sample(SensorSample& out) override {
+         out = SensorSample();
+         
+         for (const ChannelDescriptor& channel : CHANNEL_DESCRIPTORS) {
+             if (supportsInterface(channel.quantity)) {
+                 out.set(channel.quantity, readChannel(channel.quantity));
+             }
+         }
+         
+         out.timestamp = millis();
+         return out.anyValid();
+     }
+     
+     /**
+      * @brief Default startConversion for synchronous sensors
+      * The whole read happens in fetchResult().
+      * @return true if the sensor is connected
+      */
+     bool startConversion() override {
+         return connected;
+     }
+     
+     /**
+      * @brief Default pollConversion for synchronous sensors
+      * @return Always READY
+      */
+     ConversionStatus pollConversion() override {
+         return ConversionStatus::READY;
+     }
+     
+     /**
+      * @brief Default conversion delay for synchronous sensors
+      * @return Always 0
+      */
+     uint32_t getConversionDelayMs() const override {
+         return 0;
+     }
+     
+     /**
+      * @brief Default fetchResult for synchronous sensors
+      * Performs a blocking sample().
+      * @param out [out] Sample to fill
+      * @return true if at least one channel was read successfully
+      */
+     bool fetchResult(SensorSample& out) override {
+         return sample(out);
+     }
  };
  
  /** @} */ // End of sensors group
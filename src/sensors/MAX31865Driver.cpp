@@ -0,0 +1,166 @@
+#include "MAX31865Driver.h"
+#include <math.h>
+#include <string.h>
+
+namespace {
+    // Callendar-Van Dusen coefficients of IEC 60751 platinum RTDs
+    const float RTD_A = 3.9083e-3;
+    const float RTD_B = -5.775e-7;
+
+    const uint32_t MAX31865_SPI_CLOCK_HZ = 1000000;
+    const uint8_t MAX31865_SPI_MODE = 1;
+}
+
+MAX31865Driver::MAX31865Driver(SPIManager* spiMgr, int ssPinNum)
+    : spiManager(spiMgr),
+      ssPin(ssPinNum) {
+}
+
+bool MAX31865Driver::begin(int wires, bool filter50Hz) {
+    if (!spiManager || !spiManager->addDevice(ssPin, MAX31865_SPI_CLOCK_HZ, MAX31865_SPI_MODE)) {
+        return false;
+    }
+
+    // Bias and conversions off until a conversion is requested
+    uint8_t config = (wires == 3) ? MAX31865_CONFIG_3WIRE : 0;
+    if (filter50Hz) {
+        config |= MAX31865_CONFIG_FILT50HZ;
+    }
+    if (!writeRegister(MAX31865_REG_CONFIG, config)) {
+        return false;
+    }
+
+    // Open thresholds so only wiring faults are reported
+    uint8_t thresholds[5] = {MAX31865_REG_HFAULT_MSB | MAX31865_WRITE_FLAG, 0xFF, 0xFF, 0x00, 0x00};
+    if (!spiManager->transfer(ssPin, thresholds, sizeof(thresholds))) {
+        return false;
+    }
+
+    clearFault();
+    return true;
+}
+
+bool MAX31865Driver::readRegisters(uint8_t address, uint8_t* buffer, size_t length) {
+    if (length == 0 || length > MAX_REGISTERS) {
+        return false;
+    }
+
+    // Address byte followed by one clocking byte per register read
+    uint8_t frame[MAX_REGISTERS + 1];
+    frame[0] = address & ~MAX31865_WRITE_FLAG;
+    memset(frame + 1, 0xFF, length);
+    if (!spiManager->transfer(ssPin, frame, length + 1)) {
+        return false;
+    }
+
+    memcpy(buffer, frame + 1, length);
+    return true;
+}
+
+bool MAX31865Driver::writeRegister(uint8_t address, uint8_t value) {
+    uint8_t frame[2] = {static_cast<uint8_t>(address | MAX31865_WRITE_FLAG), value};
+    return spiManager->transfer(ssPin, frame, sizeof(frame));
+}
+
+bool MAX31865Driver::setAutoConvert(bool enable) {
+    uint8_t config;
+    if (!readRegisters(MAX31865_REG_CONFIG, &config, 1)) {
+        return false;
+    }
+
+    config &= ~MAX31865_CONFIG_1SHOT;
+    if (enable) {
+        config |= MAX31865_CONFIG_BIAS | MAX31865_CONFIG_AUTO;
+    } else {
+        config &= ~(MAX31865_CONFIG_BIAS | MAX31865_CONFIG_AUTO);
+    }
+    return writeRegister(MAX31865_REG_CONFIG, config);
+}
+
+uint8_t MAX31865Driver::readFault() {
+    uint8_t fault = 0;
+    return readRegisters(MAX31865_REG_FAULT, &fault, 1) ? fault : 0;
+}
+
+void MAX31865Driver::clearFault() {
+    uint8_t config;
+    if (!readRegisters(MAX31865_REG_CONFIG, &config, 1)) {
+        return;
+    }
+    // The fault cycle bits must be written as zero alongside the clear bit
+    config &= ~(MAX31865_CONFIG_1SHOT | 0x0C);
+    writeRegister(MAX31865_REG_CONFIG, config | MAX31865_CONFIG_FAULTSTAT);
+}
+
+uint16_t MAX31865Driver::readRTD() {
+    clearFault();
+
+    uint8_t config;
+    if (!readRegisters(MAX31865_REG_CONFIG, &config, 1) ||
+        !writeRegister(MAX31865_REG_CONFIG, config | MAX31865_CONFIG_BIAS)) {
+        return 0;
+    }
+    delay(Constants::Sensors::MAX31865_BIAS_SETTLE_MS);
+
+    config |= MAX31865_CONFIG_BIAS;
+    if (!writeRegister(MAX31865_REG_CONFIG, config | MAX31865_CONFIG_1SHOT)) {
+        return 0;
+    }
+    delay(Constants::Sensors::MAX31865_CONVERSION_MS);
+
+    uint8_t data[2];
+    bool read = readRegisters(MAX31865_REG_RTD_MSB, data, 2);
+
+    // Bias off between conversions to limit self-heating
+    writeRegister(MAX31865_REG_CONFIG, config & ~MAX31865_CONFIG_BIAS);
+    if (!read) {
+        return 0;
+    }
+
+    uint16_t rtd = (data[0] << 8) | data[1];
+    return rtd >> 1;
+}
+
+uint16_t MAX31865Driver::readLatestRTD() {
+    uint8_t data[2];
+    if (!readRegisters(MAX31865_REG_RTD_MSB, data, 2)) {
+        return 0;
+    }
+
+    uint16_t rtd = (data[0] << 8) | data[1];
+    return rtd >> 1;
+}
+
+float MAX31865Driver::temperature(float rtdNominal, float refResistor) {
+    return calculateTemperature(readRTD(), rtdNominal, refResistor);
+}
+
+float MAX31865Driver::calculateTemperature(uint16_t rtdRaw, float rtdNominal, float refResistor) {
+    float rt = rtdRaw / 32768.0f * refResistor;
+
+    // Closed-form inverse of the quadratic, valid at and above 0 °C
+    float z1 = -RTD_A;
+    float z2 = RTD_A * RTD_A - 4 * RTD_B;
+    float z3 = (4 * RTD_B) / rtdNominal;
+    float z4 = 2 * RTD_B;
+
+    float temp = (sqrtf(z2 + z3 * rt) + z1) / z4;
+    if (temp >= 0) {
+        return temp;
+    }
+
+    // Below 0 °C the C coefficient matters; use a fit of the full equation
+    rt = rt / rtdNominal * 100;
+    float rpoly = rt;
+    temp = -242.02f;
+    temp += 2.2228f * rpoly;
+    rpoly *= rt;
+    temp += 2.5859e-3f * rpoly;
+    rpoly *= rt;
+    temp -= 4.8260e-6f * rpoly;
+    rpoly *= rt;
+    temp -= 2.8183e-8f * rpoly;
+    rpoly *= rt;
+    temp += 1.5243e-10f * rpoly;
+    return temp;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../managers/SPIManager.h"
+
+/** @name MAX31865 registers */
+/** @{ */
+#define MAX31865_REG_CONFIG      0x00   ///< Configuration register
+#define MAX31865_REG_RTD_MSB     0x01   ///< RTD resistance MSB; LSB follows
+#define MAX31865_REG_HFAULT_MSB  0x03   ///< High fault threshold MSB
+#define MAX31865_REG_LFAULT_MSB  0x05   ///< Low fault threshold MSB
+#define MAX31865_REG_FAULT       0x07   ///< Fault status register
+#define MAX31865_WRITE_FLAG      0x80   ///< Set on a register address to write it
+/** @} */
+
+/** @name MAX31865 configuration bits */
+/** @{ */
+#define MAX31865_CONFIG_BIAS         0x80   ///< V_BIAS on
+#define MAX31865_CONFIG_AUTO         0x40   ///< Continuous conversions
+#define MAX31865_CONFIG_1SHOT        0x20   ///< Start a single conversion
+#define MAX31865_CONFIG_3WIRE        0x10   ///< Three-wire RTD
+#define MAX31865_CONFIG_FAULTSTAT    0x02   ///< Clear the fault status
+#define MAX31865_CONFIG_FILT50HZ     0x01   ///< 50 Hz mains rejection
+/** @} */
+
+/** @name MAX31865 fault status bits */
+/** @{ */
+#define MAX31865_FAULT_HIGHTHRESH    0x80   ///< RTD above the high threshold
+#define MAX31865_FAULT_LOWTHRESH     0x40   ///< RTD below the low threshold
+#define MAX31865_FAULT_REFINLOW      0x20   ///< REFIN- > 0.85 x V_BIAS
+#define MAX31865_FAULT_REFINHIGH     0x10   ///< REFIN- < 0.85 x V_BIAS, FORCE- open
+#define MAX31865_FAULT_RTDINLOW      0x08   ///< RTDIN- < 0.85 x V_BIAS, FORCE- open
+#define MAX31865_FAULT_OVUV          0x04   ///< Over or under voltage
+/** @} */
+
+/**
+ * @brief Minimal MAX31865 RTD-to-digital converter driver.
+ * Talks to the chip through SPIManager's DMA transport instead of
+ * Arduino SPIClass, so register accesses of several converters can be
+ * queued together with SPIManager::transferBatch(). The temperature
+ * conversion is the Callendar-Van Dusen equation used by the Adafruit
+ * library this driver replaces, so readings are unchanged.
+ */
+class MAX31865Driver {
+public:
+    /**
+     * @brief Constructor.
+     * @param spiMgr SPI manager the converter is attached to.
+     * @param ssPinNum Logical or physical slave select pin.
+     */
+    MAX31865Driver(SPIManager* spiMgr, int ssPinNum);
+
+    /**
+     * @brief Attach the converter to the bus and write the base configuration.
+     * Bias and conversions are left off and the fault thresholds are opened.
+     * @param wires Number of RTD wires (2, 3 or 4).
+     * @param filter50Hz Reject 50 Hz mains instead of 60 Hz.
+     * @return true if the converter was attached and configured, false otherwise.
+     */
+    bool begin(int wires, bool filter50Hz = false);
+
+    /**
+     * @brief Switch continuous conversions on or off.
+     * Continuous conversions keep the bias on; the latest result is then
+     * always available in the RTD registers and DRDY falls each time a
+     * new one is ready.
+     * @param enable true to convert continuously, false to stop and turn the bias off.
+     * @return true if the configuration was written, false otherwise.
+     */
+    bool setAutoConvert(bool enable);
+
+    /**
+     * @brief Read consecutive registers.
+     * @param address First register address.
+     * @param buffer [out] Destination for the register values.
+     * @param length Number of registers to read, at most MAX_REGISTERS.
+     * @return true if the SPI transfer was performed, false otherwise.
+     */
+    bool readRegisters(uint8_t address, uint8_t* buffer, size_t length);
+
+    /**
+     * @brief Write a single register.
+     * @param address Register address.
+     * @param value Value to write.
+     * @return true if the SPI transfer was performed, false otherwise.
+     */
+    bool writeRegister(uint8_t address, uint8_t value);
+
+    /**
+     * @brief Read the fault status register.
+     * @return Fault bits, or 0 if the read failed.
+     */
+    uint8_t readFault();
+
+    /**
+     * @brief Clear the fault status, keeping the rest of the configuration.
+     */
+    void clearFault();
+
+    /**
+     * @brief Run a blocking one-shot conversion.
+     * Only meant for initialization and diagnostics; the acquisition path
+     * uses the non-blocking conversion lifecycle of PT100Sensor.
+     * @return Raw 15-bit RTD value, or 0 if a transfer failed.
+     */
+    uint16_t readRTD();
+
+    /**
+     * @brief Read the latest result without starting a conversion.
+     * Meant for continuous mode, where the registers always hold a recent result.
+     * @return Raw 15-bit RTD value, or 0 if the read failed.
+     */
+    uint16_t readLatestRTD();
+
+    /**
+     * @brief Run a blocking one-shot conversion and convert it to temperature.
+     * @param rtdNominal RTD resistance at 0 °C in ohms.
+     * @param refResistor Reference resistor in ohms.
+     * @return Temperature in degrees Celsius.
+     */
+    float temperature(float rtdNominal, float refResistor);
+
+    /**
+     * @brief Convert a raw RTD value to temperature.
+     * @param rtdRaw Raw 15-bit RTD value.
+     * @param rtdNominal RTD resistance at 0 °C in ohms.
+     * @param refResistor Reference resistor in ohms.
+     * @return Temperature in degrees Celsius.
+     */
+    static float calculateTemperature(uint16_t rtdRaw, float rtdNominal, float refResistor);
+
+    /**
+     * @brief Get the slave select pin the converter was created with.
+     * @return Slave select pin.
+     */
+    int getSSPin() const { return ssPin; }
+
+    static const size_t MAX_REGISTERS = 8;   ///< Register file size, one burst covers all of it
+
+private:
+    SPIManager* spiManager;   ///< SPI manager for communication
+    int ssPin;                ///< SPI slave select pin
+};
@@ -1,31 +1,84 @@
 #include "PT100Sensor.h"
+#include "../managers/PerfCounters.h"
+
+PT100ConversionMode PT100ConversionMode::parse(const String& additional) {
+    PT100ConversionMode mode;
+    String lower = additional;
+    lower.toLowerCase();
+    
+    int pos = lower.indexOf("mode:");
+    if (pos >= 0) {
+        String value = lower.substring(pos + 5);
+        value.trim();
+        mode.continuous = value.startsWith("continuous") || value.startsWith("auto");
+    }
+    
+    pos = lower.indexOf("mains:");
+    if (pos >= 0) {
+        String value = lower.substring(pos + 6);
+        value.trim();
+        long hz = value.toInt();
+        if (hz == 50 || hz == 60) {
+            mode.mainsHz = hz;
+        }
+    }
+    
+    pos = lower.indexOf("drdy:");
+    if (pos >= 0) {
+        String value = lower.substring(pos + 5);
+        value.trim();
+        if (value.length() > 0 && isDigit(value.charAt(0))) {
+            mode.drdyPin = value.toInt();
+        }
+    }
+    return mode;
+}
 
 PT100Sensor::PT100Sensor(const String& sensorName, int ssPinNum, SPIManager* spiMgr, ErrorHandler* err,
-                        float referenceResistor, int wireCount)
+                        float referenceResistor, int wireCount, const PT100ConversionMode& conversionMode)
     : BaseSensor(sensorName, SensorType::PT100_RTD, err),
-    max31865(spiMgr->mapLogicalToPhysicalPin(ssPinNum)), // Use the mapping function
+    max31865(spiMgr, ssPinNum),
     spiManager(spiMgr),
     ssPin(ssPinNum),    // Store the logical pin
     rRef(referenceResistor),
     numWires(wireCount),
+    mode(conversionMode),
     lastTemperature(NAN),
-    tempTimestamp(0) {
+    tempTimestamp(0),
+    lastRtd(0),
+    dataReady(false),
+    dataReadyTime(0),
+    conversionState(ConversionState::IDLE),
+    stateStartTime(0),
+    conversionConfig(0) {
 
     // Log the physical pin being used
     int physicalPin = spiMgr->mapLogicalToPhysicalPin(ssPinNum);
-    errorHandler->logError(INFO, "PT100 sensor using physical SS pin: " + String(physicalPin) + 
+    LOG_INFO(errorHandler, "PT100 sensor using physical SS pin: " + String(physicalPin) + 
         " (logical pin: " + String(ssPinNum) + ")");
     }
     PT100Sensor::~PT100Sensor() {
-        // Nothing to clean up
+        if (mode.drdyPin >= 0) {
+            detachInterrupt(digitalPinToInterrupt(mode.drdyPin));
+        }
+        // Don't leave the RTD biased and self-heating once nothing reads it
+        if (mode.continuous && connected) {
+            max31865.setAutoConvert(false);
+        }
     }
 
+void IRAM_ATTR PT100Sensor::onDataReady(void* arg) {
+    PT100Sensor* sensor = static_cast<PT100Sensor*>(arg);
+    sensor->dataReadyTime = millis();
+    sensor->dataReady = true;
+}
+
 bool PT100Sensor::initialize() {
-    errorHandler->logError(INFO, "Initializing PT100 RTD sensor: " + name + " on SS pin " + String(ssPin));
+    LOG_INFO(errorHandler, "Initializing PT100 RTD sensor: " + getName() + " on SS pin " + String(ssPin));
     
     // Make sure SPI is initialized
     if (!spiManager || !spiManager->isInitialized()) {
-        errorHandler->logError(ERROR, "SPI not initialized for PT100 sensor: " + name);
+        errorHandler->logFormatted(ERROR, "SPI not initialized for PT100 sensor: %s", name);
         connected = false;
         return false;
     }
@@ -33,28 +86,17 @@ bool PT100Sensor::initialize() {
     // Register the SS pin with the SPI manager
     spiManager->registerSSPin(ssPin);
     
-    // Begin the MAX31865 with the appropriate wiring config
-    max31865_numwires_t wiringMode;
-    switch (numWires) {
-        case 2:
-            wiringMode = MAX31865_2WIRE;
-            break;
-        case 3:
-            wiringMode = MAX31865_3WIRE;
-            break;
-        case 4:
-        default:
-            wiringMode = MAX31865_4WIRE;
-            break;
+    // Attach the MAX31865 to the DMA transport with the appropriate wiring config
+    if (!max31865.begin(numWires, mode.mainsHz == 50)) {
+        errorHandler->logFormatted(ERROR, "Failed to configure MAX31865 for PT100 sensor: %s", name);
+        connected = false;
+        return false;
     }
     
-    // Initialize the MAX31865
-    max31865.begin(wiringMode);
-    
     // Check for any faults
     uint8_t fault = max31865.readFault();
     if (fault) {
-        errorHandler->logError(ERROR, "MAX31865 fault detected during initialization: " + getFaultStatus());
+        errorHandler->logFormatted(ERROR, "MAX31865 fault detected during initialization: %s", getFaultStatus());
         max31865.clearFault();
         // Only fail initialization for critical faults
         if (fault & (MAX31865_FAULT_OVUV | MAX31865_FAULT_REFINHIGH | MAX31865_FAULT_REFINLOW)) {
@@ -65,12 +107,33 @@ bool PT100Sensor::initialize() {
     }
     
     // Read the RTD value directly for diagnostics
-    uint16_t rtd = max31865.readRTD();
+    uint16_t rtd;
+    if (mode.continuous) {
+        // Start converting and wait out the bias settling and first, longer conversion
+        if (!max31865.setAutoConvert(true)) {
+            errorHandler->logFormatted(ERROR, "Failed to start continuous conversions for PT100 sensor: %s", name);
+            connected = false;
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(Constants::Sensors::MAX31865_BIAS_SETTLE_MS + Constants::Sensors::MAX31865_CONVERSION_MS));
+        rtd = max31865.readLatestRTD();
+        
+        if (mode.drdyPin >= 0) {
+            pinMode(mode.drdyPin, INPUT);
+            dataReady = false;
+            attachInterruptArg(digitalPinToInterrupt(mode.drdyPin), onDataReady, this, FALLING);
+        }
+        LOG_INFO(errorHandler, "PT100 converting continuously at " + String(mode.mainsHz) + " Hz rejection" +
+                 (mode.drdyPin >= 0 ? ", DRDY on GPIO" + String(mode.drdyPin) : String(", no DRDY")));
+    } else {
+        rtd = max31865.readRTD();
+    }
+    lastRtd = rtd;
     float ratio = rtd / 32768.0;
     float resistance = ratio * rRef;
     
-    errorHandler->logError(INFO, "Initial PT100 RTD value: " + String(rtd));
-    errorHandler->logError(INFO, "Initial PT100 resistance: " + String(resistance) + " ohms (ratio: " + String(ratio, 8) + ")");
+    LOG_INFO(errorHandler, "Initial PT100 RTD value: " + String(rtd));
+    LOG_INFO(errorHandler, "Initial PT100 resistance: " + String(resistance) + " ohms (ratio: " + String(ratio, 8) + ")");
     
     // Check if RTD value is zero, which indicates a likely connection issue
     if (rtd == 0) {
@@ -78,9 +141,9 @@ bool PT100Sensor::initialize() {
         // Let's not mark it as disconnected yet, to allow for diagnostics
     }
     
-    // Get initial temperature reading
-    float temp = max31865.temperature(PT100_RTD_VALUE, rRef);
-    errorHandler->logError(INFO, "Initial PT100 temperature: " + String(temp) + "°C");
+    // Get initial temperature reading from the same conversion
+    float temp = MAX31865Driver::calculateTemperature(rtd, PT100_RTD_VALUE, rRef);
+    LOG_INFO(errorHandler, "Initial PT100 temperature: " + String(temp) + "°C");
     
     // Still mark as connected even with suspicious values for diagnostic purposes
     connected = true;
@@ -92,53 +155,177 @@ bool PT100Sensor::initialize() {
     return true;
 }
 
-bool PT100Sensor::updateReading() const {
+bool PT100Sensor::updateReading() {
+    SensorSample result;
+    return sample(result);
+}
+
+float PT100Sensor::readTemperature() {
+    updateReading(); // Always update to get fresh readings
+    return lastTemperature;
+}
+
+bool PT100Sensor::sample(SensorSample& out) {
     if (!connected) {
-        errorHandler->logError(ERROR, "Attempted to read from disconnected PT100 sensor: " + name);
+        out = SensorSample();
+        errorHandler->logFormatted(ERROR, "Attempted to read from disconnected PT100 sensor: %s", name);
         return false;
     }
     
-    // Read the RTD value directly first for diagnostics
-    uint16_t rtd = max31865.readRTD();
-    float ratio = rtd / 32768.0;
-    float resistance = ratio * rRef;
+    return runConversion(out);
+}
+
+bool PT100Sensor::readRegisters(uint8_t address, uint8_t* buffer, size_t length) {
+    return max31865.readRegisters(address, buffer, length);
+}
+
+bool PT100Sensor::writeRegister(uint8_t address, uint8_t value) {
+    return max31865.writeRegister(address, value);
+}
+
+bool PT100Sensor::continuousResultReady() const {
+    if (mode.drdyPin < 0 || dataReady || digitalRead(mode.drdyPin) == LOW) {
+        return true;
+    }
+    return millis() - stateStartTime >= Constants::Sensors::MAX31865_DRDY_MISSED_PERIODS * mode.periodMs();
+}
+
+bool PT100Sensor::startConversion() {
+    if (!connected) {
+        return false;
+    }
     
-    // Only warn if RTD is zero, but don't disconnect
-    if (rtd == 0) {
-        errorHandler->logError(ERROR, "WARNING: PT100 RTD value is 0, suggesting a connection problem");
+    // The converter is already running; wait for its next result
+    if (mode.continuous) {
+        conversionState = ConversionState::CONVERTING;
+        stateStartTime = millis();
+        return true;
     }
     
-    // Read the temperature
-    float temp;
-    try {
-        // Calculate temperature using the RTD-to-temperature conversion
-        temp = max31865.temperature(PT100_RTD_VALUE, rRef);
-        
-        // Check for any faults
-        uint8_t fault = max31865.readFault();
-        if (fault) {
-            errorHandler->logError(ERROR, "MAX31865 fault detected during reading: " + getFaultStatus());
-            max31865.clearFault();
-            // Don't immediately disconnect for non-critical faults
-        }
-    } catch (...) {
-        // Catch any exceptions that might occur during reading
-        errorHandler->logError(ERROR, "Exception occurred while reading PT100 sensor: " + name);
+    // Keep the wiring and filter bits set up by begin(), enable bias for a one-shot
+    uint8_t config;
+    if (!readRegisters(MAX31865_REG_CONFIG, &config, 1)) {
+        recordConversionResult(false);
+        return false;
+    }
+    config = (config | MAX31865_CONFIG_BIAS) & ~(MAX31865_CONFIG_AUTO | MAX31865_CONFIG_1SHOT);
+    if (!writeRegister(MAX31865_REG_CONFIG, config)) {
+        recordConversionResult(false);
         return false;
     }
     
-    // Update our stored values regardless of validity
-    lastTemperature = temp;
-    tempTimestamp = millis();
+    conversionConfig = config;
+    conversionState = ConversionState::BIAS_SETTLING;
+    stateStartTime = millis();
+    return true;
+}
+
+ConversionStatus PT100Sensor::pollConversion() {
+    switch (conversionState) {
+        case ConversionState::BIAS_SETTLING: {
+            if (getConversionDelayMs() > 0) {
+                return ConversionStatus::PENDING;
+            }
+            
+            if (!writeRegister(MAX31865_REG_CONFIG, conversionConfig | MAX31865_CONFIG_1SHOT)) {
+                conversionState = ConversionState::IDLE;
+                recordConversionResult(false);
+                return ConversionStatus::FAILED;
+            }
+            
+            conversionState = ConversionState::CONVERTING;
+            stateStartTime = millis();
+            return ConversionStatus::PENDING;
+        }
+        
+        case ConversionState::CONVERTING:
+            if (mode.continuous) {
+                return continuousResultReady() ? ConversionStatus::READY : ConversionStatus::PENDING;
+            }
+            return getConversionDelayMs() == 0 ? ConversionStatus::READY : ConversionStatus::PENDING;
+        
+        case ConversionState::IDLE:
+        default:
+            return ConversionStatus::FAILED;
+    }
+}
+
+uint32_t PT100Sensor::getConversionDelayMs() const {
+    if (mode.continuous && conversionState == ConversionState::CONVERTING) {
+        if (continuousResultReady()) {
+            return 0;
+        }
+        // Sleep until the next result is due; never 0 while waiting so the caller doesn't spin
+        unsigned long sinceLast = millis() - tempTimestamp;
+        return sinceLast < mode.periodMs() ? mode.periodMs() - sinceLast : 1;
+    }
     
-    // No verbose logging here
+    uint32_t stageMs;
+    switch (conversionState) {
+        case ConversionState::BIAS_SETTLING:
+            stageMs = Constants::Sensors::MAX31865_BIAS_SETTLE_MS;
+            break;
+        case ConversionState::CONVERTING:
+            stageMs = Constants::Sensors::MAX31865_CONVERSION_MS;
+            break;
+        default:
+            return 0;
+    }
     
-    return true;
+    unsigned long elapsed = millis() - stateStartTime;
+    return elapsed >= stageMs ? 0 : stageMs - elapsed;
 }
 
-float PT100Sensor::readTemperature() {
-    updateReading(); // Always update to get fresh readings
-    return lastTemperature;
+bool PT100Sensor::fetchResult(SensorSample& out) {
+    out = SensorSample();
+    if (conversionState != ConversionState::CONVERTING) {
+        return false;
+    }
+    conversionState = ConversionState::IDLE;
+    PerfScope timing(PerfSite::PT100_READ);
+    
+    // Read the RTD registers and, for one-shots, turn the bias off between conversions to limit self-heating
+    uint8_t data[3] = {MAX31865_REG_RTD_MSB, 0xFF, 0xFF};
+    uint8_t biasOff[2] = {MAX31865_REG_CONFIG | MAX31865_WRITE_FLAG,
+                          static_cast<uint8_t>(conversionConfig & ~MAX31865_CONFIG_BIAS)};
+    SPITransfer transfers[2] = {
+        {ssPin, data, sizeof(data)},
+        {ssPin, biasOff, sizeof(biasOff)}
+    };
+    bool signalled = dataReady;
+    unsigned long signalledAt = dataReadyTime;
+    dataReady = false;
+    if (!spiManager->transferBatch(transfers, mode.continuous ? 1 : 2)) {
+        errorHandler->logFormatted(ERROR, "SPI transaction failed while reading PT100 sensor: %s", name);
+        recordConversionResult(false);
+        return false;
+    }
+    
+    uint16_t rtd = (data[1] << 8) | data[2];
+    
+    // Bit 0 of the RTD LSB flags a fault; only query the fault register then
+    if (rtd & 0x01) {
+        errorHandler->logFormatted(ERROR, "MAX31865 fault detected during reading: %s", getFaultStatus());
+        max31865.clearFault();
+        // Don't immediately disconnect for non-critical faults
+    }
+    rtd >>= 1;
+    
+    // Only warn if RTD is zero, but don't disconnect
+    if (rtd == 0) {
+        errorHandler->logError(ERROR, "WARNING: PT100 RTD value is 0, suggesting a connection problem");
+    }
+    
+    // Update our stored values regardless of validity
+    lastRtd = rtd;
+    lastTemperature = max31865.calculateTemperature(rtd, PT100_RTD_VALUE, rRef);
+    // DRDY marks when the conversion finished, which may be well before this read
+    tempTimestamp = signalled ? signalledAt : millis();
+    recordConversionResult(true);
+    
+    out.setTemperature(lastTemperature);
+    out.timestamp = tempTimestamp;
+    return out.isValid(InterfaceType::TEMPERATURE);
 }
 
 unsigned long PT100Sensor::getTemperatureTimestamp() const {
@@ -146,21 +333,21 @@ unsigned long PT100Sensor::getTemperatureTimestamp() const {
 }
 
 bool PT100Sensor::performSelfTest() {
-    errorHandler->logError(INFO, "Performing self-test on PT100 sensor: " + name);
+    LOG_INFO(errorHandler, "Performing self-test on PT100 sensor: %s", name);
     
     // Read the RTD value directly to check if the sensor is connected
-    uint16_t rtd = max31865.readRTD();
+    uint16_t rtd = mode.continuous ? max31865.readLatestRTD() : max31865.readRTD();
     float ratio = rtd / 32768.0;
     float resistance = ratio * rRef;
     
-    errorHandler->logError(INFO, "PT100 RTD value: " + String(rtd) + 
+    LOG_INFO(errorHandler, "PT100 RTD value: " + String(rtd) + 
            ", Ratio: " + String(ratio, 8) + 
            ", Resistance: " + String(resistance, 3) + " ohms");
     
     // Check for any faults
     uint8_t fault = max31865.readFault();
     if (fault) {
-        errorHandler->logError(ERROR, "MAX31865 fault detected during self-test: " + getFaultStatus());
+        errorHandler->logFormatted(ERROR, "MAX31865 fault detected during self-test: %s", getFaultStatus());
         max31865.clearFault();
     }
     
@@ -171,27 +358,32 @@ bool PT100Sensor::performSelfTest() {
         return false;
     }
     
-    // Try to read temperature to complete the test
-    float temp = max31865.temperature(PT100_RTD_VALUE, rRef);
-    errorHandler->logError(INFO, "PT100 temperature reading: " + String(temp) + "°C");
+    // Convert the same reading to complete the test
+    float temp = MAX31865Driver::calculateTemperature(rtd, PT100_RTD_VALUE, rRef);
+    LOG_INFO(errorHandler, "PT100 temperature reading: " + String(temp) + "°C");
     
     // Keep connected true for diagnostics
     connected = true;
-    errorHandler->logError(INFO, "Self-test passed for PT100 sensor: " + name);
+    LOG_INFO(errorHandler, "Self-test passed for PT100 sensor: %s", name);
     
     return true;
 }
 
 String PT100Sensor::getSensorInfo() const {
-    String info = "Sensor Name: " + name + "\n";
-    info += "Type: Adafruit PT100 RTD (MAX31865)\n";
+    String info = "Sensor Name: " + getName() + "\n";
+    info += "Type: PT100 RTD (MAX31865)\n";
     info += "SPI SS Pin: " + String(ssPin) + "\n";
     info += "Connected: " + String(connected ? "Yes" : "No") + "\n";
     info += "Wiring: " + String(numWires) + "-wire\n";
     info += "Reference Resistor: " + String(rRef) + " ohms\n";
+    info += "Conversion: " + String(mode.continuous ? "Continuous" : "One-shot") + ", " +
+            String(mode.mainsHz) + " Hz rejection\n";
+    if (mode.drdyPin >= 0) {
+        info += "DRDY Pin: " + String(mode.drdyPin) + "\n";
+    }
     
-    // Read live values for the info request
-    uint16_t rtd = max31865.readRTD();
+    // Report the last acquired values rather than running another conversion
+    uint16_t rtd = lastRtd;
     float ratio = rtd / 32768.0;
     float resistance = ratio * rRef;
     
@@ -213,12 +405,7 @@ String PT100Sensor::getSensorInfo() const {
 }
 
 bool PT100Sensor::supportsInterface(InterfaceType type) const {
-    switch (type) {
-        case InterfaceType::TEMPERATURE:
-            return true;
-        default:
-            return false;
-    }
+    return SensorTraits<PT100Sensor>::info.hasChannel(type);
 }
 
 void* PT100Sensor::getInterface(InterfaceType type) const {
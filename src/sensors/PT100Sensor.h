@@ -1,8 +1,8 @@
 #pragma once
 
-#include <Adafruit_MAX31865.h>
-#include <SPI.h>
 #include "BaseSensor.h"
+#include "SensorTraits.h"
+#include "MAX31865Driver.h"
 #include "interfaces/ITemperatureSensor.h"
 #include "readings/TemperatureReading.h"
 #include "../managers/SPIManager.h"
@@ -10,27 +10,105 @@
 // Define PT100 RTD value constant (100 ohms at 0°C)
 #define PT100_RTD_VALUE 100
 
+/**
+ * @brief How a PT100 channel converts.
+ * Parsed from SensorConfig::additional alongside the wiring and reference
+ * settings, e.g. "Mode: continuous, Mains: 50, DRDY: 4". The default is a
+ * one-shot conversion per read with 60 Hz rejection, as before.
+ */
+struct PT100ConversionMode {
+    bool continuous = false;   ///< Keep the bias on and let the MAX31865 convert continuously
+    int mainsHz = 60;          ///< Mains frequency to reject, 50 or 60
+    int drdyPin = -1;          ///< GPIO wired to DRDY, or -1 to read the latest result on demand
+
+    /**
+     * @brief Parse the conversion mode from a sensor's additional settings.
+     * @param additional SensorConfig::additional string.
+     * @return Parsed mode; unknown values keep the defaults.
+     */
+    static PT100ConversionMode parse(const String& additional);
+
+    /**
+     * @brief Get the time between results in continuous mode.
+     * @return Conversion period in milliseconds.
+     */
+    uint32_t periodMs() const {
+        return mainsHz == 50 ? Constants::Sensors::MAX31865_AUTO_PERIOD_50HZ_MS
+                             : Constants::Sensors::MAX31865_AUTO_PERIOD_60HZ_MS;
+    }
+};
+
 /**
  * @brief Implementation of the PT100 RTD temperature sensor with MAX31865 ADC.
  * This class provides access to the PT100 RTD temperature sensor,
  * using the MAX31865 ADC to convert resistance to temperature.
  */
-class PT100Sensor : public BaseSensor, 
+class PT100Sensor final : public BaseSensor, 
                     public ITemperatureSensor {
 private:
-    mutable Adafruit_MAX31865 max31865;   ///< Underlying Adafruit driver
+    mutable MAX31865Driver max31865;      ///< Register-level MAX31865 driver
     SPIManager* spiManager;               ///< SPI manager for communication
     int ssPin;                            ///< SPI slave select pin
     float rRef;                           ///< Reference resistor value (430.0 ohms by default)
     int numWires;                         ///< Number of wires (2, 3, or 4)
+    PT100ConversionMode mode;             ///< One-shot or continuous conversion settings
     mutable float lastTemperature;        ///< Last temperature reading
     mutable unsigned long tempTimestamp;  ///< Timestamp of last temperature reading
+    mutable uint16_t lastRtd;             ///< Raw RTD value of the last reading
+    volatile bool dataReady;              ///< Set by the DRDY interrupt, cleared when the result is read
+    volatile unsigned long dataReadyTime; ///< millis() at the last DRDY falling edge
+    
+    /**
+     * @brief Stages of a one-shot MAX31865 conversion
+     */
+    enum class ConversionState {
+        IDLE,           ///< No conversion in progress
+        BIAS_SETTLING,  ///< Bias enabled, waiting for the input filter to settle
+        CONVERTING      ///< One-shot conversion triggered
+    };
+    
+    ConversionState conversionState;      ///< Current conversion stage
+    unsigned long stateStartTime;         ///< When the current stage was entered
+    uint8_t conversionConfig;             ///< Configuration written for the conversion, bias on
     
     /**
      * @brief Update temperature reading from the sensor.
      * @return True if the reading was successfully updated, false otherwise.
      */
-    bool updateReading() const;
+    bool updateReading();
+    
+    /**
+     * @brief Read consecutive MAX31865 registers.
+     * @param address First register address.
+     * @param buffer [out] Destination for the register values.
+     * @param length Number of registers to read.
+     * @return true if the SPI transaction was performed, false otherwise.
+     */
+    bool readRegisters(uint8_t address, uint8_t* buffer, size_t length);
+    
+    /**
+     * @brief Write a single MAX31865 register.
+     * @param address Register address.
+     * @param value Value to write.
+     * @return true if the SPI transaction was performed, false otherwise.
+     */
+    bool writeRegister(uint8_t address, uint8_t value);
+    
+    /**
+     * @brief DRDY falling-edge interrupt handler.
+     * @param arg The sensor whose converter signalled.
+     */
+    static void IRAM_ATTR onDataReady(void* arg);
+    
+    /**
+     * @brief Check whether a continuous-mode result is ready to read.
+     * Without a DRDY pin the registers always hold a recent result. With
+     * one, a result is ready once DRDY has fallen, or regardless after
+     * MAX31865_DRDY_MISSED_PERIODS silent periods so a broken DRDY line
+     * only costs latency.
+     * @return true if fetchResult() may read the registers.
+     */
+    bool continuousResultReady() const;
 
 public:
     /**
@@ -41,9 +119,11 @@ public:
      * @param err Pointer to the error handler for logging.
      * @param referenceResistor Value of the reference resistor in ohms (default: 430.0 for Adafruit board).
      * @param wireCount Number of wires in the PT100 connection (default: 3 for three-wire).
+     * @param conversionMode One-shot or continuous conversion settings.
      */
     PT100Sensor(const String& sensorName, int ssPinNum, SPIManager* spiMgr, ErrorHandler* err,
-                float referenceResistor = 430.0, int wireCount = 3);
+                float referenceResistor = 430.0, int wireCount = 3,
+                const PT100ConversionMode& conversionMode = PT100ConversionMode());
     
     /**
      * @brief Destructor.
@@ -93,6 +173,42 @@ public:
      * @return Pointer to the interface, or nullptr if not supported.
      */
     void* getInterface(InterfaceType type) const override;
+    
+    /**
+     * @brief Acquire the temperature channel from a single RTD conversion.
+     * @param out [out] Sample filled with the temperature channel.
+     * @return true if the conversion succeeded, false otherwise.
+     */
+    bool sample(SensorSample& out) override;
+
+    /**
+     * @brief Enable the RTD bias so a one-shot conversion can follow.
+     * In continuous mode the converter is already running and nothing is written.
+     * @return true if the bias was enabled, false otherwise.
+     */
+    bool startConversion() override;
+    
+    /**
+     * @brief Advance the conversion, triggering the one-shot once the bias has settled.
+     * In continuous mode this waits for DRDY, if wired.
+     * @return READY once the RTD result can be read, FAILED if nothing was started.
+     */
+    ConversionStatus pollConversion() override;
+    
+    /**
+     * @brief Get the time remaining in the current conversion stage.
+     * @return Milliseconds until pollConversion() should be called.
+     */
+    uint32_t getConversionDelayMs() const override;
+    
+    /**
+     * @brief Read the RTD result, turn the bias off and convert to temperature.
+     * The RTD read and the bias-off write are queued as one DMA batch; in
+     * continuous mode the bias stays on and only the RTD registers are read.
+     * @param out [out] Sample filled with the temperature channel.
+     * @return true if the result was read successfully, false otherwise.
+     */
+    bool fetchResult(SensorSample& out) override;
 
     /**
      * @brief Get the MAX31865 fault status and description.
@@ -100,3 +216,16 @@ public:
      */
     String getFaultStatus() const;
 };
+
+/**
+ * @brief Compile-time description of the PT100 driver.
+ */
+template<>
+struct SensorTraits<PT100Sensor> {
+    static constexpr SensorTypeInfo info = {
+        SensorType::PT100_RTD, "Adafruit PT100 RTD", "PT100_RTD", CommunicationType::SPI,
+        channelBit(InterfaceType::TEMPERATURE),
+        Constants::Sensors::MAX31865_BIAS_SETTLE_MS + Constants::Sensors::MAX31865_CONVERSION_MS,
+        0
+    };
+};
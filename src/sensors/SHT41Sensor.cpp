@@ -1,5 +1,21 @@
 #include "SHT41Sensor.h"
 
+namespace {
+    const uint8_t SHT41_CMD_MEASURE_HIGH_PRECISION = 0xFD;
+    
+    // Sensirion CRC-8: polynomial 0x31, init 0xFF
+    uint8_t sensirionCrc8(const uint8_t* data, size_t len) {
+        uint8_t crc = 0xFF;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+            }
+        }
+        return crc;
+    }
+}
+
 SHT41Sensor::SHT41Sensor(const String& sensorName, int address, TwoWire* i2cBus, 
                         I2CManager* i2cMgr, I2CPort port, ErrorHandler* err)
     : BaseSensor(sensorName, SensorType::SHT41, err),
@@ -10,7 +26,9 @@ SHT41Sensor::SHT41Sensor(const String& sensorName, int address, TwoWire* i2cBus,
       lastTemperature(NAN),
       lastHumidity(NAN),
       tempTimestamp(0),
-      humidityTimestamp(0) {
+      humidityTimestamp(0),
+      conversionPending(false),
+      conversionStartTime(0) {
 }
 
 SHT41Sensor::~SHT41Sensor() {
@@ -18,7 +36,7 @@ SHT41Sensor::~SHT41Sensor() {
 }
 
 bool SHT41Sensor::initialize() {
-    errorHandler->logError(INFO, "Initializing SHT41 sensor: " + name);
+    LOG_INFO(errorHandler, "Initializing SHT41 sensor: %s", name);
     
     // Add timeout for sensor initialization
     const unsigned long timeout = 1000; // 1 second timeout
@@ -40,7 +58,7 @@ bool SHT41Sensor::initialize() {
     }
     
     if (!initResult) {
-        errorHandler->logError(ERROR, "Failed to initialize SHT41 sensor: " + name + " (timed out)");
+        errorHandler->logError(ERROR, "Failed to initialize SHT41 sensor: " + getName() + " (timed out)");
         connected = false;
         return false;
     }
@@ -50,7 +68,7 @@ bool SHT41Sensor::initialize() {
     sht4.setHeater(SHT4X_NO_HEATER);
     
     connected = true;
-    errorHandler->logError(INFO, "SHT41 sensor initialized successfully: " + name);
+    LOG_INFO(errorHandler, "SHT41 sensor initialized successfully: %s", name);
     
     // Only try to get initial readings if we have time left
     if (millis() - startTime < timeout - 200) {
@@ -60,48 +78,91 @@ bool SHT41Sensor::initialize() {
     return true;
 }
 
-bool SHT41Sensor::updateReadings() const {
+bool SHT41Sensor::updateReadings() {
+    SensorSample result;
+    return sample(result);
+}
+
+bool SHT41Sensor::sample(SensorSample& out) {
     if (!connected) {
-        errorHandler->logError(ERROR, "Attempted to read from disconnected sensor: " + name);
+        out = SensorSample();
+        errorHandler->logFormatted(ERROR, "Attempted to read from disconnected sensor: %s", name);
         return false;
     }
     
-    sensors_event_t humidity, temp;
+    return runConversion(out);
+}
+
+bool SHT41Sensor::startConversion() {
+    if (!connected) {
+        return false;
+    }
     
-    // Add timeout for sensor reading
-    const unsigned long timeout = 500; // 500ms timeout
-    unsigned long startTime = millis();
+    if (!I2CManager::writeCommand(wire, i2cAddress, SHT41_CMD_MEASURE_HIGH_PRECISION)) {
+        errorHandler->logFormatted(ERROR, "SHT41 sensor did not acknowledge measurement command: %s", name);
+        conversionPending = false;
+        recordConversionResult(false);
+        return false;
+    }
     
-    bool readResult = false;
+    conversionPending = true;
+    conversionStartTime = millis();
+    return true;
+}
+
+ConversionStatus SHT41Sensor::pollConversion() {
+    if (!conversionPending) {
+        return ConversionStatus::FAILED;
+    }
+    return getConversionDelayMs() == 0 ? ConversionStatus::READY : ConversionStatus::PENDING;
+}
+
+uint32_t SHT41Sensor::getConversionDelayMs() const {
+    if (!conversionPending) {
+        return 0;
+    }
     
-    // Try to read with timeout
-    while (millis() - startTime < timeout) {
-        // Non-const Adafruit API, we use mutable member and const_cast for internal state
-        readResult = sht4.getEvent(&humidity, &temp);
-        if (readResult) {
-            break;
-        }
-        // Short delay before retry
-        delay(5);
-        // Feed the watchdog
-        yield();
+    unsigned long elapsed = millis() - conversionStartTime;
+    return elapsed >= Constants::Sensors::SHT41_CONVERSION_MS ? 0 : Constants::Sensors::SHT41_CONVERSION_MS - elapsed;
+}
+
+bool SHT41Sensor::fetchResult(SensorSample& out) {
+    out = SensorSample();
+    if (!conversionPending) {
+        return false;
+    }
+    conversionPending = false;
+    PerfScope timing(PerfSite::SHT41_READ);
+    
+    // Response: T msb, T lsb, T crc, RH msb, RH lsb, RH crc
+    uint8_t data[6];
+    if (!I2CManager::readBytes(wire, i2cAddress, data, sizeof(data))) {
+        errorHandler->logFormatted(ERROR, "Failed to read from SHT41 sensor: %s", name);
+        recordConversionResult(false);
+        return false;
     }
     
-    if (!readResult) {
-        errorHandler->logError(ERROR, "Failed to read from SHT41 sensor: " + name + " (timed out)");
-        const_cast<SHT41Sensor*>(this)->connected = false;
+    if (sensirionCrc8(data, 2) != data[2] || sensirionCrc8(data + 3, 2) != data[5]) {
+        errorHandler->logFormatted(ERROR, "CRC mismatch reading SHT41 sensor: %s", name);
+        recordConversionResult(false);
         return false;
     }
     
-    // Update temperature
-    lastTemperature = temp.temperature;
-    tempTimestamp = millis();
+    uint16_t rawTemp = (data[0] << 8) | data[1];
+    uint16_t rawHum = (data[3] << 8) | data[4];
+    float humidity = -6.0f + 125.0f * rawHum / 65535.0f;
     
-    // Update humidity
-    lastHumidity = humidity.relative_humidity;
-    humidityTimestamp = tempTimestamp; // Same timestamp for both since they're read together
+    // Both channels come from the same conversion
+    lastTemperature = -45.0f + 175.0f * rawTemp / 65535.0f;
+    lastHumidity = constrain(humidity, 0.0f, 100.0f);
+    tempTimestamp = millis();
+    humidityTimestamp = tempTimestamp;
+    recordConversionResult(true);
     
-    return true;
+    out.setTemperature(lastTemperature);
+    out.setHumidity(lastHumidity);
+    out.timestamp = tempTimestamp;
+    return out.anyValid();
 }
 
 float SHT41Sensor::readTemperature() {
@@ -131,18 +192,18 @@ bool SHT41Sensor::performSelfTest() {
     bool success = sht4.getEvent(&humidity, &temp);
     
     if (!success) {
-        errorHandler->logError(ERROR, "Self-test failed for SHT41 sensor: " + name);
+        errorHandler->logFormatted(ERROR, "Self-test failed for SHT41 sensor: %s", name);
         connected = false;
     } else {
         connected = true;
-        errorHandler->logError(INFO, "Self-test passed for SHT41 sensor: " + name);
+        LOG_INFO(errorHandler, "Self-test passed for SHT41 sensor: %s", name);
     }
     
     return success;
 }
 
 String SHT41Sensor::getSensorInfo() const {
-    String info = "Sensor Name: " + name + "\n";
+    String info = "Sensor Name: " + getName() + "\n";
     info += "Type: SHT41\n";
     info += "I2C Address: 0x" + String(i2cAddress, HEX) + "\n";
     info += "I2C Port: " + I2CManager::portToString(i2cPort) + "\n";
@@ -162,13 +223,7 @@ String SHT41Sensor::getSensorInfo() const {
 }
 
 bool SHT41Sensor::supportsInterface(InterfaceType type) const {
-    switch (type) {
-        case InterfaceType::TEMPERATURE:
-        case InterfaceType::HUMIDITY:
-            return true;
-        default:
-            return false;
-    }
+    return SensorTraits<SHT41Sensor>::info.hasChannel(type);
 }
 
 void* SHT41Sensor::getInterface(InterfaceType type) const {
@@ -3,6 +3,7 @@
 #include <Adafruit_SHT4x.h>
 #include <Wire.h>
 #include "BaseSensor.h"
+#include "SensorTraits.h"
 #include "../managers/I2CManager.h"
 #include "interfaces/ITemperatureSensor.h"
 #include "interfaces/IHumiditySensor.h"
@@ -14,7 +15,7 @@
  * This class provides access to the SHT41 sensor, which can measure
  * both temperature and humidity.
  */
-class SHT41Sensor : public BaseSensor, 
+class SHT41Sensor final : public BaseSensor, 
                    public ITemperatureSensor,
                    public IHumiditySensor {
 private:
@@ -27,12 +28,14 @@ private:
     mutable float lastHumidity;          ///< Last humidity reading
     mutable unsigned long tempTimestamp;      ///< Timestamp of last temperature reading
     mutable unsigned long humidityTimestamp;  ///< Timestamp of last humidity reading
+    bool conversionPending;              ///< A measurement command has been issued
+    unsigned long conversionStartTime;   ///< When the measurement command was issued
     
     /**
      * @brief Update both temperature and humidity readings from the sensor.
      * @return True if the readings were successfully updated, false otherwise.
      */
-    bool updateReadings() const;
+    bool updateReadings();
 
 public:
     /**
@@ -107,4 +110,49 @@ public:
      * @return Pointer to the interface, or nullptr if not supported.
      */
     void* getInterface(InterfaceType type) const override;
+    
+    /**
+     * @brief Acquire temperature and humidity from a single conversion.
+     * @param out [out] Sample filled with both channels and a shared timestamp.
+     * @return true if the conversion succeeded, false otherwise.
+     */
+    bool sample(SensorSample& out) override;
+    
+    /**
+     * @brief Issue a high-precision measurement command without waiting.
+     * @return true if the sensor acknowledged the command, false otherwise.
+     */
+    bool startConversion() override;
+    
+    /**
+     * @brief Check whether the measurement time has elapsed.
+     * @return READY once the result can be read, FAILED if nothing was started.
+     */
+    ConversionStatus pollConversion() override;
+    
+    /**
+     * @brief Get the time remaining until the measurement completes.
+     * @return Milliseconds until the result is ready.
+     */
+    uint32_t getConversionDelayMs() const override;
+    
+    /**
+     * @brief Read and CRC-check the completed measurement.
+     * @param out [out] Sample filled with both channels.
+     * @return true if the result was read successfully, false otherwise.
+     */
+    bool fetchResult(SensorSample& out) override;
+};
+
+/**
+ * @brief Compile-time description of the SHT41 driver.
+ */
+template<>
+struct SensorTraits<SHT41Sensor> {
+    static constexpr SensorTypeInfo info = {
+        SensorType::SHT41, "SHT41", nullptr, CommunicationType::I2C,
+        channelBit(InterfaceType::TEMPERATURE) | channelBit(InterfaceType::HUMIDITY),
+        Constants::Sensors::SHT41_CONVERSION_MS,
+        1000000   // Fast-mode Plus
+    };
 };
@@ -0,0 +1,22 @@
+/**
+ * @file SensorDrivers.h
+ * @brief The list of compiled-in sensor drivers
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_types
+ */
+
+ #pragma once
+
+ #include "SensorTraits.h"
+ #include "SHT41Sensor.h"
+ #include "Si7021Sensor.h"
+ #include "PT100Sensor.h"
+
+ /**
+  * @brief Every supported driver
+  * Adding a driver means giving it a SensorType value and a
+  * SensorTraits specialization, then listing it here; the factory and
+  * the type string conversions pick it up from this list.
+  */
+ using SensorDrivers = SensorDriverList<SHT41Sensor, Si7021Sensor, PT100Sensor>;
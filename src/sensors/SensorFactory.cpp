@@ -1,24 +1,35 @@
 #include "SensorFactory.h"
-#include "SHT41Sensor.h"
-#include "Si7021Sensor.h"
-#include "PT100Sensor.h"
+#include "SensorDrivers.h"
+
+static_assert(SensorDrivers::MAX_ALIGN <= alignof(std::max_align_t), "Sensor pool blocks are only max_align_t aligned");
 
 SensorFactory::SensorFactory(ErrorHandler* err, I2CManager* i2c, SPIManager* spi) 
-    : errorHandler(err), i2cManager(i2c), spiManager(spi) {
+    : errorHandler(err), i2cManager(i2c), spiManager(spi), pool(err) {
+}
+
+bool SensorFactory::reservePool(size_t sensorCount) {
+    return pool.reserve(sensorCount + Constants::Sensors::POOL_SPARE_BLOCKS, SensorDrivers::MAX_SIZE);
+}
+
+void SensorFactory::destroySensor(ISensor* sensor) {
+    pool.destroy(sensor);
 }
 
 void SensorFactory::setSPIManager(SPIManager* spi) {
     spiManager = spi;
 }
 
-// Template method for I2C sensor creation
-template<typename SensorType>
-ISensor* SensorFactory::createI2CSensor(const SensorConfig& config) {
-    if (config.communicationType != CommunicationType::I2C) {
-        errorHandler->logError(ERROR, "Sensor type does not support I2C interface");
-        return nullptr;
+template<typename Driver>
+ISensor* SensorFactory::createDriver(const SensorConfig& config) {
+    if constexpr (SensorTraits<Driver>::info.bus == CommunicationType::I2C) {
+        return createI2CSensor<Driver>(config);
+    } else {
+        return createSPISensor<Driver>(config);
     }
-    
+}
+
+template<typename Driver>
+ISensor* SensorFactory::createI2CSensor(const SensorConfig& config) {
     // Initialize the appropriate I2C bus if not already done
     I2CPort i2cPort = static_cast<I2CPort>(config.portNum);
     if (!i2cManager->isPortInitialized(i2cPort)) {
@@ -39,57 +50,58 @@ ISensor* SensorFactory::createI2CSensor(const SensorConfig& config) {
     }
     
     // Create sensor with the specified configuration
-    return new SensorType(config.name, config.address, wire, i2cManager, i2cPort, errorHandler);
+    return pool.create<Driver>(config.name, config.address, wire, i2cManager, i2cPort, errorHandler);
 }
 
-// Explicit template instantiations for supported sensor types
-template ISensor* SensorFactory::createI2CSensor<SHT41Sensor>(const SensorConfig& config);
-template ISensor* SensorFactory::createI2CSensor<Si7021Sensor>(const SensorConfig& config);
+template<>
+ISensor* SensorFactory::createSPISensor<PT100Sensor>(const SensorConfig& config);
 
 ISensor* SensorFactory::createSensor(const SensorConfig& config) {
-    SensorType type = sensorTypeFromString(config.type);
+    const SensorTypeInfo* info = SensorDrivers::find(config.type);
+    if (!info) {
+        errorHandler->logError(ERROR, "Unsupported sensor type: " + config.type);
+        return nullptr;
+    }
     
     // Get a communication type string for logging
     String commTypeStr = communicationTypeToString(config.communicationType);
     
     // Log sensor creation
-    errorHandler->logError(INFO, "Creating sensor: " + config.name + " of type " + config.type + 
+    LOG_INFO(errorHandler, "Creating sensor: " + config.name + " of type " + config.type + 
                      " using " + commTypeStr + 
                      (config.communicationType == CommunicationType::SPI ? 
                       " (SS Pin: " + String(config.address) + ")" : 
                       " (Port: " + String(config.portNum) + 
                       ", Address: 0x" + String(config.address, HEX) + ")"));
     
-    // Check SPI manager for SPI sensors
-    if (config.communicationType == CommunicationType::SPI && !spiManager) {
-        errorHandler->logError(ERROR, "SPI manager not provided for SPI sensor: " + config.name);
+    // Names are stored inline in each sensor; never truncate one silently
+    if (SensorName(config.name).isTruncated()) {
+        errorHandler->logError(ERROR, "Sensor name longer than " + String(Constants::Sensors::MAX_NAME_LENGTH) +
+                              " characters: " + config.name);
         return nullptr;
     }
     
-    // Create sensor based on type
-    switch (type) {
-        case SensorType::SHT41:
-            return createI2CSensor<SHT41Sensor>(config);
-            
-        case SensorType::SI7021:
-            return createI2CSensor<Si7021Sensor>(config);
-            
-        case SensorType::PT100_RTD:
-            return createPT100Sensor(config);  // Special case for PT100
-  
-        default:
-            errorHandler->logError(ERROR, "Unsupported sensor type: " + config.type);
-            return nullptr;
+    if (config.communicationType != info->bus) {
+        errorHandler->logError(ERROR, String(info->name) + " requires " + communicationTypeToString(info->bus) +
+                              " interface: " + config.name);
+        return nullptr;
     }
+    
+    // A poll period shorter than a conversion just re-reads the previous result
+    if (config.pollingRate < info->conversionMs) {
+        errorHandler->logFormatted(WARNING, "Polling rate of %s (%lu ms) is shorter than its conversion time (%lu ms)",
+                                   config.name.c_str(), (unsigned long)config.pollingRate,
+                                   (unsigned long)info->conversionMs);
+    }
+    
+    return SensorDrivers::visit(info->type, [&](auto tag) {
+        return createDriver<typename decltype(tag)::type>(config);
+    });
 }
 
 // PT100 needs special handling due to additional parameters
-ISensor* SensorFactory::createPT100Sensor(const SensorConfig& config) {
-    if (config.communicationType != CommunicationType::SPI) {
-        errorHandler->logError(ERROR, "PT100 RTD requires SPI interface");
-        return nullptr;
-    }
-    
+template<>
+ISensor* SensorFactory::createSPISensor<PT100Sensor>(const SensorConfig& config) {
     // Check SPI initialization
     if (!spiManager || !spiManager->isInitialized()) {
         errorHandler->logError(ERROR, "SPI not initialized for PT100 sensor: " + config.name);
@@ -112,17 +124,18 @@ ISensor* SensorFactory::createPT100Sensor(const SensorConfig& config) {
     }
     
     // Create the sensor with hardware SPI
-    errorHandler->logError(INFO, "Creating PT100 sensor with physical SS pin: " + String(physicalSsPin) + 
+    LOG_INFO(errorHandler, "Creating PT100 sensor with physical SS pin: " + String(physicalSsPin) + 
                          ", Ref: " + String(referenceResistor) + 
                          ", Wire mode: " + String(wireMode));
     
-    return new PT100Sensor(
+    return pool.create<PT100Sensor>(
         config.name,
         physicalSsPin,
         spiManager,
         errorHandler,
         referenceResistor,
-        wireMode
+        wireMode,
+        PT100ConversionMode::parse(config.additional)
     );
 }
 
@@ -19,11 +19,7 @@
  #include "../managers/I2CManager.h"
  #include "../managers/SPIManager.h"
  #include "SensorTypes.h"
- 
- // Forward declarations
- class SHT41Sensor;
- class Si7021Sensor;
- class PT100Sensor;
+ #include "SensorPool.h"
  
  /**
   * @brief Factory class for creating sensors based on configuration
@@ -49,21 +45,38 @@
      SPIManager* spiManager;
      
      /**
-      * @brief Create a sensor using the template method pattern
-      * @tparam SensorType The type of sensor to create
+      * @brief Arena the sensors are constructed in
+      */
+     SensorPool pool;
+     
+     /**
+      * @brief Create a driver from its traits
+      * Dispatches on SensorTraits<Driver>::info.bus at compile time.
+      * @tparam Driver The concrete sensor class
+      * @param config The sensor configuration
+      * @return Pointer to the created sensor, or nullptr if creation failed
+      */
+     template<typename Driver>
+     ISensor* createDriver(const SensorConfig& config);
+     
+     /**
+      * @brief Create an I2C sensor; shared by every I2C driver
+      * @tparam Driver The concrete sensor class
       * @param config The sensor configuration
       * @return Pointer to the created sensor, or nullptr if creation failed
       */
-     template<typename SensorType>
+     template<typename Driver>
      ISensor* createI2CSensor(const SensorConfig& config);
      
      /**
-      * @brief Create a PT100 RTD sensor instance
-      * Special case for PT100 sensors that need additional parameters.
+      * @brief Create an SPI sensor
+      * SPI drivers take driver-specific settings, so each one specializes this.
+      * @tparam Driver The concrete sensor class
       * @param config The sensor configuration
       * @return Pointer to the created sensor, or nullptr if creation failed
       */
-     ISensor* createPT100Sensor(const SensorConfig& config);
+     template<typename Driver>
+     ISensor* createSPISensor(const SensorConfig& config);
      
      /**
       * @brief Parse additional settings for PT100 sensors
@@ -92,12 +105,33 @@
     
     /**
      * @brief Create a sensor instance based on the provided configuration
-     * Factory method that creates and returns an appropriate sensor instance
-     * based on the configuration type and parameters.
+     * Looks the configured type up in SensorDrivers and creates that
+     * driver, after checking the bus it is configured on.
      * @param config The sensor configuration
      * @return Pointer to the created sensor, or nullptr if creation failed
      */
     ISensor* createSensor(const SensorConfig& config);
+    
+    /**
+     * @brief Size the sensor pool from the configuration
+     * Call once before the first createSensor(); blocks fit the largest
+     * supported sensor class.
+     * @param sensorCount Number of configured sensors
+     * @return true if the pool was allocated
+     */
+    bool reservePool(size_t sensorCount);
+    
+    /**
+     * @brief Destroy a sensor made by createSensor()
+     * @param sensor Sensor to destroy, may be nullptr
+     */
+    void destroySensor(ISensor* sensor);
+    
+    /**
+     * @brief Get the sensor pool, for memory reporting
+     * @return The pool
+     */
+    const SensorPool& getPool() const { return pool; }
 };
 
 /** @} */ // End of sensor_factory group
\ No newline at end of file
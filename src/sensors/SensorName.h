@@ -0,0 +1,76 @@
+/**
+ * @file SensorName.h
+ * @brief Fixed-capacity inline sensor name
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensors
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <string.h>
+ #include <algorithm>
+ #include <string_view>
+ #include "Constants.h"
+
+ /**
+  * @brief Sensor name stored inline, without a heap allocation
+  * Holds up to Constants::Sensors::MAX_NAME_LENGTH characters. Longer
+  * names are truncated and flagged, and a truncated name never matches
+  * a registered one. Converts implicitly to const char* so it can be
+  * passed to logFormatted() and String concatenation like a C string.
+  */
+ class SensorName {
+ public:
+     static constexpr size_t CAPACITY = Constants::Sensors::MAX_NAME_LENGTH;   ///< Longest storable name
+
+     SensorName() { text[0] = '\0'; }
+     SensorName(const char* value) { assign(value ? std::string_view(value) : std::string_view()); }
+     SensorName(const String& value) { assign(std::string_view(value.c_str(), value.length())); }
+     explicit SensorName(std::string_view value) { assign(value); }
+
+     /**
+      * @brief Check whether the name was too long to store
+      * @return true if characters beyond CAPACITY were dropped
+      */
+     bool isTruncated() const { return truncated; }
+
+     /**
+      * @brief Get the name as a NUL-terminated string
+      * @return Pointer to the inline characters
+      */
+     const char* c_str() const { return text; }
+
+     /**
+      * @brief Get the name as a view
+      * @return View of the inline characters
+      */
+     std::string_view view() const { return std::string_view(text, size); }
+
+     /**
+      * @brief Get the name length
+      * @return Number of characters
+      */
+     size_t length() const { return size; }
+
+     operator const char*() const { return text; }
+
+     bool operator==(const SensorName& other) const { return view() == other.view(); }
+     bool operator==(std::string_view other) const { return view() == other; }
+     bool operator==(const char* other) const { return other && view() == std::string_view(other); }
+     bool operator==(const String& other) const { return view() == std::string_view(other.c_str(), other.length()); }
+     bool operator!=(const SensorName& other) const { return !(*this == other); }
+
+ private:
+     void assign(std::string_view value) {
+         truncated = value.size() > CAPACITY;
+         size = static_cast<uint8_t>(std::min(value.size(), CAPACITY));
+         memcpy(text, value.data(), size);
+         text[size] = '\0';
+     }
+
+     char text[CAPACITY + 1];   ///< Characters and terminator
+     uint8_t size = 0;          ///< Characters in use
+     bool truncated = false;    ///< Whether the assigned name was longer than CAPACITY
+ };
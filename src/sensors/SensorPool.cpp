@@ -0,0 +1,58 @@
+#include "SensorPool.h"
+#include <algorithm>
+#include <esp_heap_caps.h>
+
+SensorPool::~SensorPool() {
+    heap_caps_free(arena);
+}
+
+bool SensorPool::reserve(size_t blocks, size_t size) {
+    if (arena) {
+        return true;
+    }
+
+    // Round blocks up so every one is suitably aligned for any sensor class
+    const size_t align = alignof(std::max_align_t);
+    blockSize = (size + align - 1) / align * align;
+    capacity = std::min(blocks, MAX_BLOCKS);
+    arena = static_cast<uint8_t*>(heap_caps_aligned_alloc(align, capacity * blockSize,
+                                                          MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    if (!arena) {
+        errorHandler->logError(ERROR, "Failed to allocate sensor pool");
+        capacity = 0;
+        return false;
+    }
+
+    LOG_INFO(errorHandler, "Sensor pool: %u blocks of %u bytes", static_cast<unsigned>(capacity),
+             static_cast<unsigned>(blockSize));
+    return true;
+}
+
+void* SensorPool::acquireBlock() {
+    uint32_t freeMask = ~usedMask & (capacity >= 32 ? UINT32_MAX : (1UL << capacity) - 1);
+    if (!arena || freeMask == 0) {
+        return nullptr;
+    }
+
+    size_t block = __builtin_ctz(freeMask);
+    usedMask |= 1UL << block;
+    highWater = std::max(highWater, getInUse());
+    return arena + block * blockSize;
+}
+
+void SensorPool::destroy(ISensor* sensor) {
+    if (!sensor) {
+        return;
+    }
+
+    // The interface may sit at an offset inside the object, so locate its block by address
+    uint8_t* address = reinterpret_cast<uint8_t*>(sensor);
+    if (!arena || address < arena || address >= arena + capacity * blockSize) {
+        delete sensor;
+        return;
+    }
+
+    size_t block = (address - arena) / blockSize;
+    sensor->~ISensor();
+    usedMask &= ~(1UL << block);
+}
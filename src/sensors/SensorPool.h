@@ -0,0 +1,126 @@
+/**
+ * @file SensorPool.h
+ * @brief Fixed-block arena for sensor instances
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_factory
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <algorithm>
+ #include <new>
+ #include <utility>
+ #include "interfaces/ISensor.h"
+ #include "../error/ErrorHandler.h"
+ #include "Constants.h"
+
+ /**
+  * @brief Arena of equal-sized blocks that sensor objects are built in
+  * Allocated once, when the configuration is first applied, with room
+  * for the configured sensors plus Constants::Sensors::POOL_SPARE_BLOCKS
+  * for the overlap of old and new sensors during a reconfiguration.
+  * Since sensors are no longer created and freed on the heap, repeated
+  * reconfigurations do not fragment it. If the arena is full, a sensor
+  * is heap-allocated as before and the fallback is counted.
+  *
+  * Not thread-safe: sensors are created and destroyed only on the
+  * configuration path.
+  */
+ class SensorPool {
+ public:
+     static constexpr size_t MAX_BLOCKS = std::min<size_t>(2 * Constants::Sensors::MAX_SENSORS, 32);   ///< Arena limit, a full set swapped for another
+     static_assert(MAX_BLOCKS <= 32, "Block usage is tracked in a 32-bit mask");
+
+     /**
+      * @brief Constructor
+      * @param err Error handler for logging
+      */
+     explicit SensorPool(ErrorHandler* err) : errorHandler(err) {}
+
+     /**
+      * @brief Destructor; frees the arena, every sensor must have been destroyed
+      */
+     ~SensorPool();
+
+     SensorPool(const SensorPool&) = delete;
+     SensorPool& operator=(const SensorPool&) = delete;
+
+     /**
+      * @brief Allocate the arena
+      * Only the first call allocates; later ones keep the existing arena.
+      * @param blocks Number of blocks, clamped to MAX_BLOCKS
+      * @param size Size of each block, at least that of the largest sensor class
+      * @return true if the arena exists
+      */
+     bool reserve(size_t blocks, size_t size);
+
+     /**
+      * @brief Construct a sensor in a free block
+      * @tparam T Concrete sensor class
+      * @param args Constructor arguments
+      * @return The new sensor; heap-allocated if no block fits
+      */
+     template<typename T, typename... Args>
+     T* create(Args&&... args) {
+         void* block = (sizeof(T) <= blockSize && alignof(T) <= alignof(std::max_align_t)) ? acquireBlock() : nullptr;
+         if (!block) {
+             heapFallbacks++;
+             errorHandler->logError(WARNING, "Sensor pool full, allocating sensor on the heap");
+             return new T(std::forward<Args>(args)...);
+         }
+         return new (block) T(std::forward<Args>(args)...);
+     }
+
+     /**
+      * @brief Destroy a sensor made by create()
+      * @param sensor Sensor to destroy, may be nullptr
+      */
+     void destroy(ISensor* sensor);
+
+     /**
+      * @brief Get the number of blocks in the arena
+      * @return Arena capacity
+      */
+     size_t getCapacity() const { return capacity; }
+
+     /**
+      * @brief Get the size of each block
+      * @return Block size in bytes
+      */
+     size_t getBlockSize() const { return blockSize; }
+
+     /**
+      * @brief Get the number of blocks holding a sensor
+      * @return Blocks in use
+      */
+     size_t getInUse() const { return __builtin_popcount(usedMask); }
+
+     /**
+      * @brief Get the most blocks ever in use at once
+      * @return High-water mark
+      */
+     size_t getHighWater() const { return highWater; }
+
+     /**
+      * @brief Get how many sensors did not fit in the arena
+      * @return Heap allocations since boot
+      */
+     uint32_t getHeapFallbacks() const { return heapFallbacks; }
+
+ private:
+     /**
+      * @brief Claim the lowest free block
+      * @return Block address, or nullptr if the arena is full or missing
+      */
+     void* acquireBlock();
+
+     ErrorHandler* errorHandler;    ///< Error handler for logging
+     uint8_t* arena = nullptr;      ///< capacity * blockSize bytes
+     size_t capacity = 0;           ///< Blocks in the arena
+     size_t blockSize = 0;          ///< Bytes per block, a multiple of the maximum alignment
+     uint32_t usedMask = 0;         ///< Bit per block, set while it holds a sensor
+     size_t highWater = 0;          ///< Most blocks in use at once
+     uint32_t heapFallbacks = 0;    ///< Sensors allocated on the heap instead
+ };
@@ -0,0 +1,123 @@
+/**
+ * @file SensorTraits.h
+ * @brief Compile-time description of each sensor driver
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_types
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include <algorithm>
+ #include <type_traits>
+ #include "SensorTypes.h"
+ #include "interfaces/InterfaceTypes.h"
+ #include "../config/CommunicationType.h"
+
+ /**
+  * @brief Static properties of a sensor driver
+  */
+ struct SensorTypeInfo {
+     SensorType type;           ///< Enum value of the driver
+     const char* name;          ///< Type string reported for the sensor and accepted in configurations
+     const char* alias;         ///< Alternative type string accepted in configurations, may be nullptr
+     CommunicationType bus;     ///< Bus the driver is attached to
+     uint8_t channels;          ///< channelBit() of every interface the driver provides
+     uint32_t conversionMs;     ///< Nominal time of one conversion
+     uint32_t maxI2CClockHz;    ///< Fastest specified I2C clock, 0 for other buses
+
+     /**
+      * @brief Check whether the driver provides an interface
+      * @param interfaceType Interface type
+      * @return true if the channel is provided
+      */
+     constexpr bool hasChannel(InterfaceType interfaceType) const {
+         return (channels & channelBit(interfaceType)) != 0;
+     }
+
+     /**
+      * @brief Check whether a configured type string selects this driver
+      * @param typeStr Type string, case-insensitive
+      * @return true for the name or the alias
+      */
+     bool matches(const String& typeStr) const {
+         return typeStr.equalsIgnoreCase(name) || (alias && typeStr.equalsIgnoreCase(alias));
+     }
+ };
+
+ /**
+  * @brief Traits of a sensor driver
+  * Every driver specializes this next to its class with a
+  * `static constexpr SensorTypeInfo info`, and is listed once in
+  * SensorDrivers (SensorDrivers.h). The factory, the type string
+  * conversions and the capability flags are generated from that.
+  * @tparam Driver Concrete sensor class
+  */
+ template<typename Driver>
+ struct SensorTraits;
+
+ /**
+  * @brief Empty value carrying a driver type to a generic visitor
+  * @tparam Driver Concrete sensor class
+  */
+ template<typename Driver>
+ struct SensorTag {
+     using type = Driver;   ///< The driver
+ };
+
+ /**
+  * @brief Compile-time list of sensor drivers
+  * @tparam Drivers Concrete sensor classes, each with SensorTraits
+  */
+ template<typename... Drivers>
+ struct SensorDriverList {
+     static constexpr size_t COUNT = sizeof...(Drivers);                         ///< Number of drivers
+     static constexpr SensorTypeInfo TABLE[] = {SensorTraits<Drivers>::info...};  ///< Traits of every driver, in list order
+     static constexpr size_t MAX_SIZE = std::max({sizeof(Drivers)...});          ///< Largest driver object
+     static constexpr size_t MAX_ALIGN = std::max({alignof(Drivers)...});        ///< Strictest driver alignment
+
+     /**
+      * @brief Find a driver by configured type string
+      * @param typeStr Type string, case-insensitive
+      * @return Traits of the driver, or nullptr if none matches
+      */
+     static const SensorTypeInfo* find(const String& typeStr) {
+         for (const SensorTypeInfo& info : TABLE) {
+             if (info.matches(typeStr)) {
+                 return &info;
+             }
+         }
+         return nullptr;
+     }
+
+     /**
+      * @brief Find a driver by enum value
+      * @param type Sensor type
+      * @return Traits of the driver, or nullptr for UNKNOWN
+      */
+     static constexpr const SensorTypeInfo* find(SensorType type) {
+         for (const SensorTypeInfo& info : TABLE) {
+             if (info.type == type) {
+                 return &info;
+             }
+         }
+         return nullptr;
+     }
+
+     /**
+      * @brief Call a generic visitor with the tag of the driver for a type
+      * The dispatch is a chain of compile-time comparisons, so the visitor
+      * is instantiated, and can be inlined, once per driver.
+      * @param type Sensor type
+      * @param visitor Callable taking a SensorTag<Driver>
+      * @return The visitor's result, or a value-initialized one for UNKNOWN
+      */
+     template<typename Visitor>
+     static auto visit(SensorType type, Visitor&& visitor) {
+         using Result = std::common_type_t<decltype(visitor(SensorTag<Drivers>{}))...>;
+         Result result{};
+         ((SensorTraits<Drivers>::info.type == type ? (result = visitor(SensorTag<Drivers>{}), true) : false) || ...);
+         return result;
+     }
+ };
@@ -0,0 +1,17 @@
+#include "SensorTypes.h"
+#include "SensorDrivers.h"
+
+SensorType sensorTypeFromString(const String& typeStr) {
+    const SensorTypeInfo* info = SensorDrivers::find(typeStr);
+    return info ? info->type : SensorType::UNKNOWN;
+}
+
+String sensorTypeToString(SensorType type) {
+    const SensorTypeInfo* info = SensorDrivers::find(type);
+    return info ? info->name : "UNKNOWN";
+}
+
+uint32_t maxI2CClockForType(SensorType type) {
+    const SensorTypeInfo* info = SensorDrivers::find(type);
+    return info && info->maxI2CClockHz ? info->maxI2CClockHz : 100000;
+}
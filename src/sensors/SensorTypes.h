@@ -11,10 +11,13 @@
 
  #pragma once
 
+ #include <Arduino.h>
+
  /**
   * @brief Enumeration of supported sensor types
   * This enum defines the sensor models that the system can work with.
-  * When adding support for a new sensor model, add it here.
+  * When adding support for a new sensor model, add it here and list its
+  * driver in SensorDrivers.
   */
  enum class SensorType {
      UNKNOWN,    ///< Unknown or unsupported sensor type
@@ -25,34 +28,25 @@
  
  /**
   * @brief Convert a string sensor type to the enum representation
+  * Accepts the name or alias of any driver in SensorDrivers.
   * @param typeStr The string representation of the sensor type
   * @return The corresponding SensorType enum value, or UNKNOWN if not recognized
   */
- inline SensorType sensorTypeFromString(const String& typeStr) {
-     if (typeStr.equalsIgnoreCase("SHT41")) return SensorType::SHT41;
-     
-     // New sensor types
-     if (typeStr.equalsIgnoreCase("SI7021") || 
-         typeStr.equalsIgnoreCase("Adafruit SI7021")) return SensorType::SI7021;
-     
-     if (typeStr.equalsIgnoreCase("PT100_RTD") || 
-         typeStr.equalsIgnoreCase("Adafruit PT100 RTD")) return SensorType::PT100_RTD;
-     
-     return SensorType::UNKNOWN;
- }
+ SensorType sensorTypeFromString(const String& typeStr);
  
  /**
   * @brief Convert a SensorType enum to its string representation
   * @param type The SensorType enum value
   * @return The string representation of the sensor type
   */
- inline String sensorTypeToString(SensorType type) {
-     switch (type) {
-         case SensorType::SHT41: return "SHT41";
-         case SensorType::SI7021: return "Adafruit SI7021";
-         case SensorType::PT100_RTD: return "Adafruit PT100 RTD";
-         default: return "UNKNOWN";
-     }
- }
+ String sensorTypeToString(SensorType type);
+ 
+ /**
+  * @brief Get the fastest I2C clock a sensor type is specified for
+  * Used to cap a bus clock at the slowest device attached to it.
+  * @param type The SensorType enum value
+  * @return Clock frequency in Hz; standard mode for unknown types
+  */
+ uint32_t maxI2CClockForType(SensorType type);
  
  /** @} */ // End of sensor_types group
@@ -1,5 +1,22 @@
 #include "Si7021Sensor.h"
 
+namespace {
+    const uint8_t SI7021_CMD_MEASURE_RH_NO_HOLD = 0xF5;
+    const uint8_t SI7021_CMD_READ_PREV_TEMP = 0xE0;
+    
+    // Si7021 CRC-8: polynomial 0x31, init 0x00
+    uint8_t si7021Crc8(const uint8_t* data, size_t len) {
+        uint8_t crc = 0x00;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : (crc << 1);
+            }
+        }
+        return crc;
+    }
+}
+
 Si7021Sensor::Si7021Sensor(const String& sensorName, int address, TwoWire* i2cBus,
                           I2CManager* i2cMgr, I2CPort port, ErrorHandler* err)
     : BaseSensor(sensorName, SensorType::SI7021, err),
@@ -11,7 +28,9 @@ Si7021Sensor::Si7021Sensor(const String& sensorName, int address, TwoWire* i2cBu
       lastTemperature(NAN),
       lastHumidity(NAN),
       tempTimestamp(0),
-      humTimestamp(0) {
+      humTimestamp(0),
+      conversionPending(false),
+      conversionStartTime(0) {
 }
 
 Si7021Sensor::~Si7021Sensor() {
@@ -19,20 +38,20 @@ Si7021Sensor::~Si7021Sensor() {
 }
 
 bool Si7021Sensor::initialize() {
-    errorHandler->logError(INFO, "Initializing Si7021 sensor: " + name);
+    LOG_INFO(errorHandler, "Initializing Si7021 sensor: %s", name);
     
     if (!si7021.begin()) {
-        errorHandler->logError(ERROR, "Failed to initialize Si7021 sensor: " + name);
+        errorHandler->logFormatted(ERROR, "Failed to initialize Si7021 sensor: %s", name);
         connected = false;
         return false;
     }
     
     connected = true;
-    errorHandler->logError(INFO, "Si7021 sensor initialized successfully: " + name);
+    LOG_INFO(errorHandler, "Si7021 sensor initialized successfully: %s", name);
     
     // Read and log serial number for identification
     uint32_t serialNumber = si7021.sernum_a;
-    errorHandler->logError(INFO, "Si7021 serial number: 0x" + String(serialNumber, HEX));
+    LOG_INFO(errorHandler, "Si7021 serial number: 0x" + String(serialNumber, HEX));
     
     // Get initial readings
     updateReadings();
@@ -40,54 +59,101 @@ bool Si7021Sensor::initialize() {
     return true;
 }
 
-bool Si7021Sensor::updateReadings() const {
+bool Si7021Sensor::updateReadings() {
+    SensorSample result;
+    return sample(result);
+}
+
+bool Si7021Sensor::sample(SensorSample& out) {
     if (!connected) {
-        errorHandler->logError(ERROR, "Attempted to read from disconnected sensor: " + name);
+        out = SensorSample();
+        errorHandler->logFormatted(ERROR, "Attempted to read from disconnected sensor: %s", name);
         return false;
     }
     
-    // Adding retries for more robustness
-    const int MAX_RETRIES = 3;
-    float temp = NAN;
-    float humidity = NAN;
-    bool success = false;
+    return runConversion(out);
+}
+
+bool Si7021Sensor::startConversion() {
+    if (!connected) {
+        return false;
+    }
     
-    for (int attempt = 0; attempt < MAX_RETRIES && !success; attempt++) {
-        if (attempt > 0) {
-            delay(50);
-            errorHandler->logError(INFO, "Retrying Si7021 reading, attempt " + String(attempt+1) + " of " + String(MAX_RETRIES));
-        }
-        
-        try {
-            temp = si7021.readTemperature();
-            
-            if (!isnan(temp)) {
-                delay(5);
-                humidity = si7021.readHumidity();
-                
-                if (!isnan(humidity)) {
-                    success = true;
-                }
-            }
-        } catch (...) {
-            errorHandler->logError(ERROR, "Exception during Si7021 reading for sensor: " + name);
-            delay(20);
-        }
+    if (!I2CManager::writeCommand(wire, i2cAddress, SI7021_CMD_MEASURE_RH_NO_HOLD)) {
+        errorHandler->logFormatted(ERROR, "Si7021 sensor did not acknowledge measurement command: %s", name);
+        conversionPending = false;
+        recordConversionResult(false);
+        return false;
+    }
+    
+    conversionPending = true;
+    conversionStartTime = millis();
+    return true;
+}
+
+ConversionStatus Si7021Sensor::pollConversion() {
+    if (!conversionPending) {
+        return ConversionStatus::FAILED;
+    }
+    return getConversionDelayMs() == 0 ? ConversionStatus::READY : ConversionStatus::PENDING;
+}
+
+uint32_t Si7021Sensor::getConversionDelayMs() const {
+    if (!conversionPending) {
+        return 0;
+    }
+    
+    unsigned long elapsed = millis() - conversionStartTime;
+    return elapsed >= Constants::Sensors::SI7021_CONVERSION_MS ? 0 : Constants::Sensors::SI7021_CONVERSION_MS - elapsed;
+}
+
+bool Si7021Sensor::fetchResult(SensorSample& out) {
+    out = SensorSample();
+    if (!conversionPending) {
+        return false;
     }
+    conversionPending = false;
+    PerfScope timing(PerfSite::SI7021_READ);
     
-    if (!success) {
-        errorHandler->logError(ERROR, "Failed to read from Si7021 sensor: " + name + " after " + String(MAX_RETRIES) + " retries");
-        const_cast<Si7021Sensor*>(this)->connected = false;
+    // Humidity response: msb, lsb, crc
+    uint8_t data[3];
+    if (!I2CManager::readBytes(wire, i2cAddress, data, sizeof(data))) {
+        errorHandler->logFormatted(ERROR, "Failed to read humidity from Si7021 sensor: %s", name);
+        recordConversionResult(false);
         return false;
     }
     
-    lastTemperature = temp;
-    lastHumidity = humidity;
+    if (si7021Crc8(data, 2) != data[2]) {
+        errorHandler->logFormatted(ERROR, "CRC mismatch reading Si7021 sensor: %s", name);
+        recordConversionResult(false);
+        return false;
+    }
+    uint16_t rawHum = (data[0] << 8) | data[1];
+    
+    // Temperature measured during the humidity conversion, no new conversion needed
+    uint8_t tempData[2];
+    if (!I2CManager::writeCommand(wire, i2cAddress, SI7021_CMD_READ_PREV_TEMP, false) ||
+        !I2CManager::readBytes(wire, i2cAddress, tempData, sizeof(tempData))) {
+        errorHandler->logFormatted(ERROR, "Failed to read temperature from Si7021 sensor: %s", name);
+        recordConversionResult(false);
+        return false;
+    }
+    uint16_t rawTemp = (tempData[0] << 8) | tempData[1];
+    
+    float humidity = 125.0f * rawHum / 65536.0f - 6.0f;
+    
+    lastTemperature = 175.72f * rawTemp / 65536.0f - 46.85f;
+    lastHumidity = constrain(humidity, 0.0f, 100.0f);
     unsigned long now = millis();
     tempTimestamp = now;
     humTimestamp = now;
+    recordConversionResult(true);
     
-    return true;
+    // Both channels come from the same conversion
+    out.setTemperature(lastTemperature);
+    out.setHumidity(lastHumidity);
+    out.timestamp = now;
+    return out.anyValid();
 }
 
 float Si7021Sensor::readTemperature() {
@@ -121,18 +187,18 @@ bool Si7021Sensor::performSelfTest() {
     
     if (success) {
         connected = true;
-        errorHandler->logError(INFO, "Self-test passed for Si7021 sensor: " + name + 
+        LOG_INFO(errorHandler, "Self-test passed for Si7021 sensor: " + getName() + 
                 " (Temperature: " + String(lastTemperature) + "°C, Humidity: " + 
                 String(lastHumidity) + "%)");
     } else {
-        errorHandler->logError(ERROR, "Self-test failed for Si7021 sensor: " + name);
+        errorHandler->logFormatted(ERROR, "Self-test failed for Si7021 sensor: %s", name);
     }
     
     return success;
 }
 
 String Si7021Sensor::getSensorInfo() const {
-    String info = "Sensor Name: " + name + "\n";
+    String info = "Sensor Name: " + getName() + "\n";
     info += "Type: Adafruit Si7021\n";
     info += "I2C Address: 0x" + String(i2cAddress, HEX) + "\n";
     info += "I2C Port: " + I2CManager::portToString(i2cPort) + "\n";
@@ -160,13 +226,7 @@ String Si7021Sensor::getSensorInfo() const {
 }
 
 bool Si7021Sensor::supportsInterface(InterfaceType type) const {
-    switch (type) {
-        case InterfaceType::TEMPERATURE:
-        case InterfaceType::HUMIDITY:
-            return true;
-        default:
-            return false;
-    }
+    return SensorTraits<Si7021Sensor>::info.hasChannel(type);
 }
 
 void* Si7021Sensor::getInterface(InterfaceType type) const {
@@ -181,7 +241,7 @@ void* Si7021Sensor::getInterface(InterfaceType type) const {
 }
 
 bool Si7021Sensor::reinitialize() {
-    errorHandler->logError(INFO, "Attempting to reinitialize Si7021 sensor: " + name);
+    LOG_INFO(errorHandler, "Attempting to reinitialize Si7021 sensor: %s", name);
     
     // Reset the connection state
     connected = false;
@@ -194,10 +254,10 @@ bool Si7021Sensor::reinitialize() {
     
     if (success) {
         connected = true;
-        errorHandler->logError(INFO, "Successfully reinitialized Si7021 sensor: " + name);
+        LOG_INFO(errorHandler, "Successfully reinitialized Si7021 sensor: %s", name);
         updateReadings();
     } else {
-        errorHandler->logError(ERROR, "Failed to reinitialize Si7021 sensor: " + name);
+        errorHandler->logFormatted(ERROR, "Failed to reinitialize Si7021 sensor: %s", name);
     }
     
     return success;
@@ -3,6 +3,7 @@
 #include <Adafruit_Si7021.h>
 #include <Wire.h>
 #include "BaseSensor.h"
+#include "SensorTraits.h"
 #include "../managers/I2CManager.h"
 #include "interfaces/ITemperatureSensor.h"
 #include "interfaces/IHumiditySensor.h"
@@ -14,7 +15,7 @@
  * This class provides access to the Si7021 sensor, which can measure
  * both temperature and humidity.
  */
-class Si7021Sensor : public BaseSensor, 
+class Si7021Sensor final : public BaseSensor, 
                      public ITemperatureSensor,
                      public IHumiditySensor {
 private:
@@ -27,12 +28,14 @@ private:
     mutable float lastHumidity;           ///< Last humidity reading
     mutable unsigned long tempTimestamp;  ///< Timestamp of last temperature reading
     mutable unsigned long humTimestamp;   ///< Timestamp of last humidity reading
+    bool conversionPending;               ///< A measurement command has been issued
+    unsigned long conversionStartTime;    ///< When the measurement command was issued
     
     /**
      * @brief Update both temperature and humidity readings from the sensor.
      * @return True if the readings were successfully updated, false otherwise.
      */
-    bool updateReadings() const;
+    bool updateReadings();
 
 public:
     /**
@@ -108,9 +111,55 @@ public:
      */
     void* getInterface(InterfaceType type) const override;
     
+    /**
+     * @brief Acquire temperature and humidity from a single conversion.
+     * @param out [out] Sample filled with both channels and a shared timestamp.
+     * @return true if the conversion succeeded, false otherwise.
+     */
+    bool sample(SensorSample& out) override;
+    
     /**
      * @brief Re-initialize the sensor after a communication failure
      * @return true if re-initialization was successful
      */
     bool reinitialize();
+    
+    /**
+     * @brief Issue a no-hold humidity measurement without waiting.
+     * The sensor measures temperature as part of every humidity conversion.
+     * @return true if the sensor acknowledged the command, false otherwise.
+     */
+    bool startConversion() override;
+    
+    /**
+     * @brief Check whether the measurement time has elapsed.
+     * @return READY once the result can be read, FAILED if nothing was started.
+     */
+    ConversionStatus pollConversion() override;
+    
+    /**
+     * @brief Get the time remaining until the measurement completes.
+     * @return Milliseconds until the result is ready.
+     */
+    uint32_t getConversionDelayMs() const override;
+    
+    /**
+     * @brief Read the humidity result and the temperature from the same conversion.
+     * @param out [out] Sample filled with both channels.
+     * @return true if the result was read successfully, false otherwise.
+     */
+    bool fetchResult(SensorSample& out) override;
+};
+
+/**
+ * @brief Compile-time description of the Si7021 driver.
+ */
+template<>
+struct SensorTraits<Si7021Sensor> {
+    static constexpr SensorTypeInfo info = {
+        SensorType::SI7021, "Adafruit SI7021", "SI7021", CommunicationType::I2C,
+        channelBit(InterfaceType::TEMPERATURE) | channelBit(InterfaceType::HUMIDITY),
+        Constants::Sensors::SI7021_CONVERSION_MS,
+        400000    // Fast mode
+    };
 };
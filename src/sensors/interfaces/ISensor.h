@@ -9,7 +9,18 @@
   #pragma once
  
   #include <Arduino.h>
+  #include <string_view>
   #include "InterfaceTypes.h"
+  #include "../readings/SensorSample.h"
+  
+  /**
+   * @brief State of an asynchronous sensor conversion
+   */
+  enum class ConversionStatus {
+      PENDING,  ///< Conversion still in progress
+      READY,    ///< Result can be fetched
+      FAILED    ///< Conversion failed; no result will be produced
+  };
   
   /**
    * @brief Base interface for all sensors
@@ -29,6 +40,13 @@
        */
       virtual String getName() const = 0;
       
+      /**
+       * @brief Get the sensor's name without allocating
+       * Used by lookups on the acquisition path.
+       * @return View of the name, valid as long as the sensor
+       */
+      virtual std::string_view getNameView() const = 0;
+      
       /**
        * @brief Check if sensor is connected and working
        * @return true if operational, false otherwise
@@ -72,4 +90,47 @@
        * @return void pointer to interface or nullptr if not supported
        */
       virtual void* getInterface(InterfaceType type) const = 0;
+      
+      /**
+       * @brief Acquire every supported channel from a single conversion
+       * Multi-quantity sensors read all of their channels in one bus
+       * transaction so the values in the sample share one timestamp.
+       * @param out [out] Sample to fill; unsupported channels stay invalid
+       * @return true if at least one channel was read successfully
+       */
+      virtual bool sample(SensorSample& out) = 0;
+      
+      /**
+       * @name Asynchronous conversion lifecycle
+       * Lets the acquisition loop trigger conversions on every sensor,
+       * sleep, and collect results once their conversion times expire.
+       * @{
+       */
+      
+      /**
+       * @brief Trigger a new conversion without waiting for it
+       * @return true if the conversion was started
+       */
+      virtual bool startConversion() = 0;
+      
+      /**
+       * @brief Advance and query the conversion in progress
+       * Multi-stage conversions may issue their next bus command here.
+       * @return Current conversion status
+       */
+      virtual ConversionStatus pollConversion() = 0;
+      
+      /**
+       * @brief Get the time until pollConversion() is next worth calling
+       * @return Delay in milliseconds (0 if the result may already be ready)
+       */
+      virtual uint32_t getConversionDelayMs() const = 0;
+      
+      /**
+       * @brief Read back the result of a completed conversion
+       * @param out [out] Sample to fill; unsupported channels stay invalid
+       * @return true if at least one channel was read successfully
+       */
+      virtual bool fetchResult(SensorSample& out) = 0;
+      /** @} */
   };
@@ -11,16 +11,32 @@
 
  #pragma once
 
+ #include <stdint.h>
+
  /**
   * @brief Enumeration of interface types that sensors can implement
   * Defines the different measurement capabilities that sensors
-  * may support. Used for runtime interface discovery.
+  * may support. Each one is also a measurement channel; see
+  * SensorChannel.h for its keyword, unit and scale.
   */
- enum class InterfaceType {
+ enum class InterfaceType : uint8_t {
      TEMPERATURE,  ///< Temperature measurement capability
      HUMIDITY,     ///< Humidity measurement capability
-     CO2           ///< CO2 measurement to be added in future versions
+     PRESSURE,     ///< Barometric pressure measurement capability
+     CO2,          ///< CO2 concentration measurement capability
+     VOC,          ///< Volatile organic compound index capability
+     LIGHT,        ///< Illuminance measurement capability
+     COUNT         ///< Number of interface types
  };
+
+ /**
+  * @brief Get the capability flag of a measurement interface
+  * @param type Interface type
+  * @return Bit for the interface in a channel mask
+  */
+ constexpr uint8_t channelBit(InterfaceType type) {
+     return static_cast<uint8_t>(1u << static_cast<uint8_t>(type));
+ }
  
  /** @} */ // End of sensor_interfaces group
  
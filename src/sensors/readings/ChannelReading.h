@@ -0,0 +1,56 @@
+/**
+ * @file ChannelReading.h
+ * @brief Structure for a reading of any measurement channel
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_readings
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include "SensorChannel.h"
+
+ /**
+  * @brief Structure to hold one channel's reading data
+  * The generic counterpart of TemperatureReading and HumidityReading,
+  * used where code handles every channel the same way.
+  */
+ struct ChannelReading {
+     InterfaceType quantity;   ///< Measured quantity
+     float value;              ///< Value in the channel's stored unit
+     unsigned long timestamp;  ///< Timestamp when reading was taken (millis)
+     bool valid;               ///< Whether the reading is valid
+
+     /**
+      * @brief Create an invalid reading
+      * @param type Measured quantity
+      */
+     explicit ChannelReading(InterfaceType type)
+         : quantity(type), value(NAN), timestamp(0), valid(false) {}
+
+     /**
+      * @brief Create a new reading
+      * @param type Measured quantity
+      * @param measured Value in the channel's stored unit
+      * @param time Timestamp when reading was taken
+      */
+     ChannelReading(InterfaceType type, float measured, unsigned long time)
+         : quantity(type), value(measured), timestamp(time), valid(!isnan(measured)) {}
+
+     /**
+      * @brief Get the value in the channel's reported unit
+      * @return value scaled by the channel descriptor
+      */
+     float reported() const {
+         return value * channelDescriptor(quantity).scale;
+     }
+
+     /**
+      * @brief Get the quality of the reading
+      * @return GOOD if valid, otherwise why not
+      */
+     QualityCode quality() const {
+         return qualityOf(value);
+     }
+ };
@@ -0,0 +1,192 @@
+/**
+ * @file SensorChannel.h
+ * @brief Generic description and storage of measurement channels
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_readings
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include "../interfaces/InterfaceTypes.h"
+
+ /**
+  * @brief Number of measurement channels a sample can carry
+  */
+ static constexpr size_t CHANNEL_COUNT = static_cast<size_t>(InterfaceType::COUNT);
+
+ static_assert(CHANNEL_COUNT <= 8, "Channel masks are 8 bits wide");
+
+ /**
+  * @brief How one measured quantity is named and reported
+  */
+ struct ChannelDescriptor {
+     InterfaceType quantity;   ///< Measured quantity
+     const char* keyword;      ///< SCPI keyword selecting the channel in MEAS? and SYST:CONF
+     const char* unit;         ///< Unit of the reported value
+     float scale;              ///< Reported value = stored value * scale
+     float minimum;            ///< Lowest plausible reported value
+     float maximum;            ///< Highest plausible reported value
+ };
+
+ /**
+  * @brief Descriptor of every channel, indexed by InterfaceType
+  * Drivers store values in the unit the sensor reports natively; the
+  * scale converts them to the reported unit. Values outside the plausible
+  * range are rejected by the quality checks unless the sensor's
+  * configuration sets a range of its own.
+  */
+ static constexpr ChannelDescriptor CHANNEL_DESCRIPTORS[CHANNEL_COUNT] = {
+     {InterfaceType::TEMPERATURE, "TEMP", "C", 1.0f, -200.0f, 850.0f},      // PT100 span; an open RTD reads -242
+     {InterfaceType::HUMIDITY, "HUM", "%RH", 1.0f, 0.0f, 100.0f},
+     {InterfaceType::PRESSURE, "PRES", "hPa", 0.01f, 300.0f, 1100.0f},   // stored in Pa
+     {InterfaceType::CO2, "CO2", "ppm", 1.0f, 0.0f, 40000.0f},
+     {InterfaceType::VOC, "VOC", "index", 1.0f, 0.0f, 500.0f},
+     {InterfaceType::LIGHT, "LIGHT", "lx", 1.0f, 0.0f, 200000.0f},
+ };
+
+ /**
+  * @brief Get the descriptor of a channel
+  * @param type Measured quantity
+  * @return Its descriptor
+  */
+ constexpr const ChannelDescriptor& channelDescriptor(InterfaceType type) {
+     return CHANNEL_DESCRIPTORS[static_cast<size_t>(type)];
+ }
+
+ /**
+  * @brief Why a channel holds no valid value
+  * Carried in the payload of the channel's NaN, so the reading table, the
+  * history and stream frames report it without storing anything extra.
+  * The numbers are the ones MEAS:QUAL? answers with.
+  */
+ enum class QualityCode : uint8_t {
+     GOOD = 0,         ///< Valid value
+     NO_DATA,          ///< The sensor delivered no value
+     OUT_OF_RANGE,     ///< Outside the plausible or configured range
+     RATE_OF_CHANGE,   ///< Moved faster than the configured rate limit
+     STUCK,            ///< Identical for too many consecutive samples
+     OUTLIER           ///< Too many standard deviations from the running mean
+ };
+
+ /**
+  * @brief Quiet NaN whose payload's low byte holds a quality code
+  */
+ static constexpr uint32_t QUALITY_NAN_BITS = 0x7FC00000UL;
+
+ /**
+  * @brief Make the invalid value that records why a sample was rejected
+  * @param code Reason, anything but GOOD
+  * @return NaN carrying the code
+  */
+ inline float qualityNaN(QualityCode code) {
+     uint32_t bits = QUALITY_NAN_BITS | static_cast<uint8_t>(code);
+     float value;
+     memcpy(&value, &bits, sizeof(value));
+     return value;
+ }
+
+ /**
+  * @brief Get the quality of a stored value
+  * @param value Channel value
+  * @return GOOD for a number, the code a qualityNaN() carries, NO_DATA for any other NaN
+  */
+ inline QualityCode qualityOf(float value) {
+     if (!isnan(value)) {
+         return QualityCode::GOOD;
+     }
+     uint32_t bits;
+     memcpy(&bits, &value, sizeof(bits));
+     uint8_t code = bits & 0xFF;
+     bool tagged = (bits & ~0xFFUL) == QUALITY_NAN_BITS && code > static_cast<uint8_t>(QualityCode::NO_DATA) &&
+                   code <= static_cast<uint8_t>(QualityCode::OUTLIER);
+     return tagged ? static_cast<QualityCode>(code) : QualityCode::NO_DATA;
+ }
+
+ /**
+  * @brief Call a visitor for each channel set in a mask, in InterfaceType order
+  * @param mask channelBit() of each channel to visit
+  * @param visit Callable taking an InterfaceType
+  */
+ template<typename Visitor>
+ inline void forEachChannel(uint8_t mask, Visitor&& visit) {
+     while (mask) {
+         uint8_t index = __builtin_ctz(mask);
+         mask &= mask - 1;
+         visit(static_cast<InterfaceType>(index));
+     }
+ }
+
+ /**
+  * @brief One value per channel with a shared timestamp
+  * Indexed by InterfaceType, so setting or reading a channel is a single
+  * array access; channels that were not measured stay invalid.
+  */
+ struct ChannelValues {
+     float values[CHANNEL_COUNT];   ///< Value of each channel
+     uint32_t timestamp = 0;        ///< When the values were measured (millis)
+     uint64_t timeUs = 0;           ///< esp_timer time at the middle of the conversion, 0 if not captured
+     uint8_t validMask = 0;         ///< channelBit() of each valid channel
+
+     /**
+      * @brief Constructor - no channel valid
+      */
+     ChannelValues() {
+         for (float& value : values) {
+             value = NAN;
+         }
+     }
+
+     /**
+      * @brief Set a channel; NaN marks it invalid
+      * @param type Channel
+      * @param value Measured value
+      */
+     void set(InterfaceType type, float value) {
+         values[static_cast<size_t>(type)] = value;
+         if (isnan(value)) {
+             validMask &= ~channelBit(type);
+         } else {
+             validMask |= channelBit(type);
+         }
+     }
+
+     /**
+      * @brief Get a channel's value
+      * @param type Channel
+      * @return The value, NaN if never set
+      */
+     float get(InterfaceType type) const {
+         return values[static_cast<size_t>(type)];
+     }
+
+     /**
+      * @brief Check whether a channel holds a valid value
+      * @param type Channel
+      * @return true if valid
+      */
+     bool isValid(InterfaceType type) const {
+         return (validMask & channelBit(type)) != 0;
+     }
+
+     /**
+      * @brief Get the quality of a channel's value
+      * @param type Channel
+      * @return GOOD if valid, otherwise why not
+      */
+     QualityCode quality(InterfaceType type) const {
+         return qualityOf(get(type));
+     }
+
+     /**
+      * @brief Check whether any channel holds a valid value
+      * @return true if at least one channel is valid
+      */
+     bool anyValid() const {
+         return validMask != 0;
+     }
+ };
+
+ static_assert(sizeof(CHANNEL_DESCRIPTORS) / sizeof(CHANNEL_DESCRIPTORS[0]) == CHANNEL_COUNT,
+               "Every channel needs a descriptor");
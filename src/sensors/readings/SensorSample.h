@@ -0,0 +1,37 @@
+/**
+ * @file SensorSample.h
+ * @brief Structure for a combined multi-quantity sensor sample
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_readings
+ */
+
+ #pragma once
+
+ #include <Arduino.h>
+ #include "SensorChannel.h"
+
+ /**
+  * @brief Structure to hold every channel produced by one sensor conversion
+  * Sensors that measure several quantities in a single bus transaction
+  * (e.g. SHT41, Si7021) fill all of their channels at once so that the
+  * values share one timestamp. Channels a sensor does not provide are
+  * left invalid.
+  */
+ struct SensorSample : ChannelValues {
+     /**
+      * @brief Set the temperature channel
+      * @param temp Temperature value in degrees Celsius
+      */
+     void setTemperature(float temp) {
+         set(InterfaceType::TEMPERATURE, temp);
+     }
+
+     /**
+      * @brief Set the humidity channel
+      * @param hum Relative humidity in percent
+      */
+     void setHumidity(float hum) {
+         set(InterfaceType::HUMIDITY, hum);
+     }
+ };
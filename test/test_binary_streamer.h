@@ -0,0 +1,81 @@
+/**
+ * @file test_binary_streamer.h
+ * @brief Test suite for binary stream framing
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup binary_streamer_tests Binary Streamer Tests
+ * @brief Tests for frame encoding and CRC protection
+ * @{
+ */
+
+#ifndef TEST_BINARY_STREAMER_H
+#define TEST_BINARY_STREAMER_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include <cstring>
+#include "../src/communication/BinaryStreamer.h"
+
+/**
+ * @brief Test the CRC against the standard check value
+ * @details CRC-16/CCITT-FALSE of "123456789" is 0x29B1.
+ */
+void test_binary_streamer_crc16() {
+    const char* check = "123456789";
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, BinaryStreamer::crc16(reinterpret_cast<const uint8_t*>(check), strlen(check)));
+}
+
+/**
+ * @brief Test the layout of an encoded frame
+ * @details Verifies sync bytes, little-endian fields, the float payload
+ *          and that the trailing CRC covers the length and payload.
+ */
+void test_binary_streamer_frame_layout() {
+    uint8_t frame[BinaryStreamer::FRAME_SIZE];
+    float value = 23.5f;
+    
+    TEST_ASSERT_EQUAL(BinaryStreamer::FRAME_SIZE,
+                      BinaryStreamer::encodeFrame(frame, 0x01020304, 0x0A0B0C0D0E0F1011ULL, 5, value));
+    TEST_ASSERT_EQUAL_HEX8(BinaryStreamer::SYNC_0, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(BinaryStreamer::SYNC_1, frame[1]);
+    TEST_ASSERT_EQUAL(BinaryStreamer::PAYLOAD_SIZE, frame[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x04, frame[3]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, frame[6]);
+    TEST_ASSERT_EQUAL_HEX8(0x11, frame[7]);
+    TEST_ASSERT_EQUAL_HEX8(0x0A, frame[14]);
+    TEST_ASSERT_EQUAL(5, frame[15]);
+    
+    float decoded;
+    memcpy(&decoded, frame + 16, sizeof(decoded));
+    TEST_ASSERT_EQUAL_FLOAT(value, decoded);
+    
+    uint16_t crc = BinaryStreamer::crc16(frame + 2, 1 + BinaryStreamer::PAYLOAD_SIZE);
+    TEST_ASSERT_EQUAL_HEX8(crc & 0xFF, frame[20]);
+    TEST_ASSERT_EQUAL_HEX8(crc >> 8, frame[21]);
+    
+    // Channel ids interleave temperature and humidity per slot
+    TEST_ASSERT_EQUAL(3 * CHANNEL_COUNT, BinaryStreamer::channelId(3, InterfaceType::TEMPERATURE));
+    TEST_ASSERT_EQUAL(3 * CHANNEL_COUNT + 1, BinaryStreamer::channelId(3, InterfaceType::HUMIDITY));
+}
+
+/**
+ * @brief Test that an idle streamer never asks for a wakeup
+ */
+void test_binary_streamer_idle_wake() {
+    BinaryStreamer streamer(nullptr, nullptr);
+    TEST_ASSERT_FALSE(streamer.isActive());
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, streamer.msUntilDue());
+}
+
+/**
+ * @brief Run all binary streamer tests
+ */
+void run_binary_streamer_tests() {
+    RUN_TEST(test_binary_streamer_crc16);
+    RUN_TEST(test_binary_streamer_frame_layout);
+    RUN_TEST(test_binary_streamer_idle_wake);
+}
+
+#endif // TEST_BINARY_STREAMER_H
+
+/** @} */ // End of binary_streamer_tests group
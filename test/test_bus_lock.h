@@ -0,0 +1,97 @@
+/**
+ * @file test_bus_lock.h
+ * @brief Test suite for bus arbitration between tasks
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup i2c_tests
+ */
+
+#ifndef TEST_BUS_LOCK_H
+#define TEST_BUS_LOCK_H
+
+#include <unity.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "../src/managers/BusLock.h"
+
+/**
+ * @brief Hand-off between a test and the task contending for its bus
+ */
+struct BusLockContender {
+    BusMutex* mutex;
+    SemaphoreHandle_t done;
+    bool acquired;
+};
+
+/**
+ * @brief Task that tries to take the bus once with a short timeout
+ * @param pvParameters Pointer to a BusLockContender
+ */
+void bus_lock_contender_task(void* pvParameters) {
+    BusLockContender* contender = static_cast<BusLockContender*>(pvParameters);
+    {
+        BusLock lock(contender->mutex, 20);
+        contender->acquired = lock.owns();
+    }
+    xSemaphoreGive(contender->done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Run the contender task to completion
+ * @param contender Contender state
+ */
+void run_bus_lock_contender(BusLockContender& contender) {
+    contender.acquired = false;
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(bus_lock_contender_task, "BusLockTest", 2048, &contender, 1, nullptr));
+    TEST_ASSERT_TRUE(xSemaphoreTake(contender.done, pdMS_TO_TICKS(1000)) == pdTRUE);
+}
+
+/**
+ * @brief Test that the holder can take its bus again, e.g. from a helper inside a batch
+ */
+void test_bus_lock_recursive() {
+    BusMutex mutex;
+    {
+        BusLock batch(&mutex);
+        TEST_ASSERT_TRUE(batch.owns());
+        BusLock helper(&mutex);
+        TEST_ASSERT_TRUE(helper.owns());
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, mutex.getContendedCount());
+
+    // A bus without a mutex is never contended
+    BusLock unlocked(nullptr);
+    TEST_ASSERT_TRUE(unlocked.owns());
+}
+
+/**
+ * @brief Test that another task waits for the holder and gives up after its timeout
+ */
+void test_bus_lock_contention() {
+    BusMutex mutex;
+    BusLockContender contender = {&mutex, xSemaphoreCreateBinary(), false};
+    TEST_ASSERT_NOT_NULL(contender.done);
+
+    {
+        BusLock held(&mutex);
+        run_bus_lock_contender(contender);
+        TEST_ASSERT_FALSE(contender.acquired);
+        TEST_ASSERT_EQUAL_UINT32(1, mutex.getContendedCount());
+    }
+
+    run_bus_lock_contender(contender);
+    TEST_ASSERT_TRUE(contender.acquired);
+    vSemaphoreDelete(contender.done);
+}
+
+/**
+ * @brief Run all bus lock tests
+ */
+void run_bus_lock_tests() {
+    RUN_TEST(test_bus_lock_recursive);
+    RUN_TEST(test_bus_lock_contention);
+}
+
+#endif // TEST_BUS_LOCK_H
@@ -0,0 +1,154 @@
+/**
+ * @file test_command_params.h
+ * @brief Test suite for the command parameter tokenizer
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup command_params_tests Command Parameter Tests
+ * @brief Tests for allocation-free command parsing
+ * @{
+ */
+
+#ifndef TEST_COMMAND_PARAMS_H
+#define TEST_COMMAND_PARAMS_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include "../src/communication/CommandParams.h"
+#include "../src/communication/ResponseBuffer.h"
+
+/**
+ * @brief Test splitting parameters into views
+ * @details Verifies tokens point into the original line and that
+ *          repeated whitespace is skipped.
+ */
+void test_command_params_tokenize() {
+    const char* line = "SHT41_1:TEMP   PT100_1 \tSi7021";
+    CommandParams params(line);
+    
+    TEST_ASSERT_EQUAL(3, params.size());
+    TEST_ASSERT_TRUE(params[0] == "SHT41_1:TEMP");
+    TEST_ASSERT_TRUE(params[1] == "PT100_1");
+    TEST_ASSERT_TRUE(params[2] == "Si7021");
+    TEST_ASSERT_TRUE(params[0].data() == line);
+    TEST_ASSERT_TRUE(params[3].empty());
+    
+    CommandParams none("   ");
+    TEST_ASSERT_TRUE(none.empty());
+    TEST_ASSERT_EQUAL_STRING("", none.restCStr());
+}
+
+/**
+ * @brief Test access to the remainder of the line
+ * @details Free-form payloads keep their original spacing.
+ */
+void test_command_params_rest() {
+    const char* line = "  {\"Board ID\":  \"Lab A\"}";
+    CommandParams params(line);
+    
+    TEST_ASSERT_EQUAL_STRING("{\"Board ID\":  \"Lab A\"}", params.restCStr());
+    TEST_ASSERT_TRUE(params.rest(2) == "\"Lab A\"}");
+}
+
+/**
+ * @brief Test numeric parsing and case-insensitive comparison
+ */
+void test_command_params_helpers() {
+    long value = 0;
+    TEST_ASSERT_TRUE(CommandParams::parseInt("-250", value));
+    TEST_ASSERT_EQUAL(-250, value);
+    TEST_ASSERT_FALSE(CommandParams::parseInt("12ab", value));
+    TEST_ASSERT_FALSE(CommandParams::parseInt("", value));
+    
+    uint32_t sequence = 0;
+    TEST_ASSERT_TRUE(CommandParams::parseUnsigned("4000000000", sequence));
+    TEST_ASSERT_EQUAL_UINT32(4000000000UL, sequence);
+    TEST_ASSERT_FALSE(CommandParams::parseUnsigned("-1", sequence));
+    
+    TEST_ASSERT_TRUE(CommandParams::equalsIgnoreCase("on", "ON"));
+    TEST_ASSERT_FALSE(CommandParams::equalsIgnoreCase("ONCE", "ON"));
+    TEST_ASSERT_FALSE(CommandParams::equalsIgnoreCase("O", "ON"));
+}
+
+/**
+ * @brief Test splitting compound command lines
+ * @details Separators inside quotes and JSON payloads are not command boundaries.
+ */
+void test_command_params_compound() {
+    TEST_ASSERT_EQUAL(5, CommandParams::findCommandSeparator("*IDN?;MEAS?"));
+    TEST_ASSERT_EQUAL(4, CommandParams::findCommandSeparator("MEAS"));
+    TEST_ASSERT_EQUAL(0, CommandParams::findCommandSeparator(";MEAS?"));
+    
+    std::string_view json = "SYST:CONF:UPD {\"a\":\"x;y\",\"b\":[1;2]};*IDN?";
+    size_t end = CommandParams::findCommandSeparator(json);
+    TEST_ASSERT_TRUE(json.substr(end + 1) == "*IDN?");
+    
+    // An escaped quote does not end the string
+    TEST_ASSERT_EQUAL(11, CommandParams::findCommandSeparator("ECHO \"a\\\";\";X"));
+}
+
+/**
+ * @brief Print sink recording what reaches the port
+ */
+class CapturePrint : public Print {
+public:
+    String data;
+    size_t writes = 0;
+    size_t write(uint8_t value) override { return write(&value, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        writes++;
+        for (size_t i = 0; i < size; i++) {
+            data += static_cast<char>(buffer[i]);
+        }
+        return size;
+    }
+};
+
+/**
+ * @brief Test that responses are held until sent and overflow in order
+ */
+void test_response_buffer_coalesce() {
+    CapturePrint port;
+    ResponseBuffer response(&port);
+    
+    response.println("A");
+    response.println("B");
+    TEST_ASSERT_EQUAL(0, port.writes);
+    response.send();
+    TEST_ASSERT_EQUAL(1, port.writes);
+    TEST_ASSERT_EQUAL_STRING("A\r\nB\r\n", port.data.c_str());
+    
+    // More than a buffer's worth goes out in buffer-sized writes
+    port.data = "";
+    port.writes = 0;
+    for (size_t i = 0; i < Constants::Communication::MAX_RESPONSE_SIZE + 10; i++) {
+        response.write('x');
+    }
+    TEST_ASSERT_EQUAL(1, port.writes);
+    response.send();
+    TEST_ASSERT_EQUAL(2, port.writes);
+    TEST_ASSERT_EQUAL(Constants::Communication::MAX_RESPONSE_SIZE + 10, port.data.length());
+    TEST_ASSERT_EQUAL(0, response.pending());
+    
+    // A new destination takes what is buffered from then on
+    CapturePrint other;
+    response.print("held");
+    TEST_ASSERT_TRUE(response.setOutput(&other) == &port);
+    response.send();
+    TEST_ASSERT_EQUAL_STRING("held", other.data.c_str());
+    TEST_ASSERT_EQUAL(2, port.writes);
+}
+
+/**
+ * @brief Run all command parameter tests
+ */
+void run_command_params_tests() {
+    RUN_TEST(test_command_params_tokenize);
+    RUN_TEST(test_command_params_rest);
+    RUN_TEST(test_command_params_helpers);
+    RUN_TEST(test_command_params_compound);
+    RUN_TEST(test_response_buffer_coalesce);
+}
+
+#endif // TEST_COMMAND_PARAMS_H
+
+/** @} */ // End of command_params_tests group
@@ -105,6 +105,98 @@ void test_communication_type_conversion() {
     TEST_ASSERT_EQUAL_STRING("SPI", communicationTypeToString(CommunicationType::SPI).c_str());
 }
 
+/**
+ * @brief Board ID seen by the last change callback
+ */
+static String lastNotifiedBoardId;
+
+/**
+ * @brief Change callback recording the parsed view it was given
+ */
+static void recordConfigChange(JsonVariantConst config) {
+    lastNotifiedBoardId = config["Environment Monitor ID"].as<String>();
+}
+
+/**
+ * @brief Test that updates stay in memory until flushed
+ * @details Edits the configuration without a mounted filesystem and checks
+ *          that the change is visible, marked dirty and passed to callbacks
+ *          as a parsed view without any file access.
+ */
+void test_config_in_memory_update() {
+    ErrorHandler errorHandler(nullptr);
+    ConfigManager configManager(&errorHandler);
+    configManager.registerChangeCallback(recordConfigChange);
+    TEST_ASSERT_FALSE(configManager.isDirty());
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, configManager.msUntilFlushDue());
+    
+    TEST_ASSERT_TRUE(configManager.setBoardIdentifier("Bench EM-1"));
+    TEST_ASSERT_TRUE(configManager.isDirty());
+    TEST_ASSERT_EQUAL_STRING("Bench EM-1", configManager.getBoardIdentifier().c_str());
+    TEST_ASSERT_EQUAL_STRING("Bench EM-1", lastNotifiedBoardId.c_str());
+    TEST_ASSERT_TRUE(configManager.getConfigJson().indexOf("Bench EM-1") >= 0);
+    
+    SensorConfig config;
+    config.name = "I2C01";
+    config.type = "SHT41";
+    config.communicationType = CommunicationType::I2C;
+    config.portNum = 1;
+    config.address = 0x44;
+    config.pollingRate = 1000;
+    config.additional = "";
+    TEST_ASSERT_TRUE(configManager.updateSensorConfigs({config}));
+    
+    JsonVariantConst peripheral = configManager.getConfig()["I2C Peripherals"].as<JsonArrayConst>()[0];
+    TEST_ASSERT_EQUAL_STRING("I2C01", peripheral["Peripheral Name"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("I2C1", peripheral["I2C Port"].as<const char*>());
+    
+    // Changes settle for the debounce interval before being written back
+    TEST_ASSERT_TRUE(configManager.flushIfDue());
+    TEST_ASSERT_TRUE(configManager.isDirty());
+    TEST_ASSERT_TRUE(configManager.msUntilFlushDue() <= Constants::Config::WRITE_DEBOUNCE_MS);
+    TEST_ASSERT_TRUE(configManager.msUntilFlushDue() > 0);
+}
+
+/**
+ * @brief Test that sensor updates are parsed entry by entry and validated as a whole
+ * @details Unknown members and entry fields are skipped, I2C entries come
+ *          first whatever the input order, and an invalid entry or
+ *          truncated input leaves the configuration untouched.
+ */
+void test_config_streamed_sensor_update() {
+    ErrorHandler errorHandler(nullptr);
+    ConfigManager configManager(&errorHandler);
+    
+    const char* json =
+        "{\"Notes\":{\"list\":[1,{\"text\":\"]}\"}]},"
+        "\"SPI Peripherals\":[{\"Peripheral Name\":\"RTD\",\"Peripheral Type\":\"Adafruit PT100 RTD\","
+        "\"SS Pin\":1,\"Comment\":\"not kept\"}],"
+        "\"I2C Peripherals\":[{\"Peripheral Name\":\"I2C01\",\"Peripheral Type\":\"SHT41\","
+        "\"I2C Port\":\"I2C1\",\"Address (HEX)\":68,\"Polling Rate[1000 ms]\":20}]}";
+    TEST_ASSERT_TRUE(configManager.updateSensorConfigFromJson(json));
+    
+    std::vector<SensorConfig> configs = configManager.getSensorConfigs();
+    TEST_ASSERT_EQUAL(2, configs.size());
+    TEST_ASSERT_EQUAL_STRING("I2C01", configs[0].name.c_str());
+    TEST_ASSERT_EQUAL(1, configs[0].portNum);
+    TEST_ASSERT_EQUAL(0x44, configs[0].address);
+    TEST_ASSERT_EQUAL_UINT32(Constants::System::MIN_POLLING_RATE_MS, configs[0].pollingRate);
+    TEST_ASSERT_EQUAL_STRING("RTD", configs[1].name.c_str());
+    TEST_ASSERT_TRUE(configs[1].communicationType == CommunicationType::SPI);
+    TEST_ASSERT_EQUAL(1, configs[1].address);
+    
+    // An invalid address in the second entry rejects the first as well
+    const char* invalid =
+        "{\"I2C Peripherals\":[{\"Peripheral Name\":\"I2C02\",\"Peripheral Type\":\"SHT41\",\"Address (HEX)\":68},"
+        "{\"Peripheral Name\":\"I2C03\",\"Peripheral Type\":\"SHT41\",\"Address (HEX)\":200}]}";
+    TEST_ASSERT_FALSE(configManager.updateSensorConfigFromJson(invalid));
+    TEST_ASSERT_FALSE(configManager.updateSensorConfigFromJson("{\"I2C Peripherals\":[{\"Peripheral Name\":\"I2C04\""));
+    
+    configs = configManager.getSensorConfigs();
+    TEST_ASSERT_EQUAL(2, configs.size());
+    TEST_ASSERT_EQUAL_STRING("I2C01", configs[0].name.c_str());
+}
+
 /**
  * @brief Run all configuration component tests
  */
@@ -112,6 +204,8 @@ void run_config_tests() {
     RUN_TEST(test_sensor_config_equality);
     RUN_TEST(test_sensor_config_inequality);
     RUN_TEST(test_communication_type_conversion);
+    RUN_TEST(test_config_in_memory_update);
+    RUN_TEST(test_config_streamed_sensor_update);
 }
 
 #endif // TEST_CONFIG_H
@@ -0,0 +1,100 @@
+/**
+ * @file test_config_cache.h
+ * @brief Test suite for the binary configuration and topology cache
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup config_tests
+ */
+
+#ifndef TEST_CONFIG_CACHE_H
+#define TEST_CONFIG_CACHE_H
+
+#include <unity.h>
+#include <string.h>
+#include "../src/config/ConfigManager.h"
+#include "../src/config/ConfigCache.h"
+
+/**
+ * @brief Test the CRC against the standard check value
+ */
+void test_config_cache_crc() {
+    const char* check = "123456789";
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, ConfigCache::crc32(reinterpret_cast<const uint8_t*>(check), 9));
+
+    // Chunked computation matches one pass
+    uint32_t crc = ConfigCache::crc32(reinterpret_cast<const uint8_t*>(check), 4);
+    crc = ConfigCache::crc32(reinterpret_cast<const uint8_t*>(check) + 4, 5, crc);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc);
+}
+
+/**
+ * @brief Test that cached configurations round-trip and are keyed by source CRC
+ */
+void test_config_cache_round_trip() {
+    ErrorHandler errorHandler(nullptr);
+    ConfigCache cache(&errorHandler);
+    TEST_ASSERT_TRUE(cache.begin());
+
+    SensorConfig config;
+    config.name = "SPI01";
+    config.type = "PT100_RTD";
+    config.communicationType = CommunicationType::SPI;
+    config.portNum = 0;
+    config.address = 2;
+    config.pollingRate = 250;
+    config.additional = "wires=3";
+    TelemetryConfig telemetry;
+    telemetry.enabled = true;
+    telemetry.ssid = "lab";
+    telemetry.protocol = TelemetryProtocol::MQTT;
+    telemetry.host = "collector.local";
+    telemetry.port = 1883;
+    telemetry.intervalMs = 5000;
+    TaskPlacementConfig tasks;
+    tasks[TaskRole::SENSOR].priority = 5;
+    tasks[TaskRole::COMM].core = tskNO_AFFINITY;
+    TEST_ASSERT_TRUE(cache.storeConfig(0x1234, "Unit 7", "", {config}, {400000, 100000}, telemetry, tasks));
+
+    String boardId;
+    String additional;
+    std::vector<SensorConfig> configs;
+    std::vector<uint32_t> clockLimits;
+    TelemetryConfig loadedTelemetry;
+    TaskPlacementConfig loadedTasks;
+    TEST_ASSERT_TRUE(cache.loadConfig(0x1234, boardId, additional, configs, clockLimits, loadedTelemetry, loadedTasks));
+    TEST_ASSERT_EQUAL_STRING("Unit 7", boardId.c_str());
+    TEST_ASSERT_EQUAL(1, configs.size());
+    TEST_ASSERT_TRUE(configs[0] == config);
+    TEST_ASSERT_EQUAL(2, clockLimits.size());
+    TEST_ASSERT_EQUAL_UINT32(400000, clockLimits[0]);
+    TEST_ASSERT_EQUAL_UINT32(100000, clockLimits[1]);
+    TEST_ASSERT_TRUE(loadedTelemetry.enabled);
+    TEST_ASSERT_TRUE(loadedTelemetry.protocol == TelemetryProtocol::MQTT);
+    TEST_ASSERT_EQUAL_STRING("collector.local", loadedTelemetry.host.c_str());
+    TEST_ASSERT_EQUAL_UINT32(5000, loadedTelemetry.intervalMs);
+    TEST_ASSERT_TRUE(loadedTasks == tasks);
+
+    // A different file invalidates the record
+    TEST_ASSERT_FALSE(cache.loadConfig(0x1235, boardId, additional, configs, clockLimits, loadedTelemetry, loadedTasks));
+
+    std::vector<int> addresses;
+    TEST_ASSERT_TRUE(cache.storeTopology(I2CPort::I2C1, {0x40, 0x44, 0x77}));
+    TEST_ASSERT_TRUE(cache.loadTopology(I2CPort::I2C1, addresses));
+    TEST_ASSERT_EQUAL(3, addresses.size());
+    TEST_ASSERT_EQUAL(0x40, addresses[0]);
+    TEST_ASSERT_EQUAL(0x77, addresses[2]);
+
+    cache.invalidate();
+    TEST_ASSERT_FALSE(cache.loadConfig(0x1234, boardId, additional, configs, clockLimits, loadedTelemetry, loadedTasks));
+    TEST_ASSERT_FALSE(cache.loadTopology(I2CPort::I2C1, addresses));
+}
+
+/**
+ * @brief Run all configuration cache tests
+ */
+void run_config_cache_tests() {
+    RUN_TEST(test_config_cache_crc);
+    RUN_TEST(test_config_cache_round_trip);
+}
+
+#endif // TEST_CONFIG_CACHE_H
@@ -0,0 +1,113 @@
+/**
+ * @file test_deferred_logging.h
+ * @brief Test suite for the deferred logging pipeline
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup deferred_logging_tests Deferred Logging Tests
+ * @brief Tests for log records, the MPSC queue and deferred output
+ * @{
+ */
+
+#ifndef TEST_DEFERRED_LOGGING_H
+#define TEST_DEFERRED_LOGGING_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include "../src/error/LogRecord.h"
+#include "../src/error/LogQueue.h"
+#include "../src/error/ErrorHandler.h"
+
+/**
+ * @brief Test rendering a captured record
+ * @details Verifies typed arguments, flags, precision, %% escapes, copied
+ *          strings and missing arguments.
+ */
+void test_log_record_render() {
+    char text[16] = "SHT41_1";
+    LogRecord record;
+    record.format = "%s read %d/%u in %.2f ms, 0x%04x %%ok %s";
+    record.addArg(text);
+    record.addArg(-3);
+    record.addArg(7u);
+    record.addArg(1.5f);
+    text[0] = 'X'; // The record kept its own copy
+    
+    char out[96];
+    record.render(out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("SHT41_1 read -3/7 in 1.50 ms, 0x? %ok ?", out);
+    
+    // Output is truncated to the buffer
+    TEST_ASSERT_EQUAL(7, record.render(out, 8));
+    TEST_ASSERT_EQUAL_STRING("SHT41_1", out);
+    
+    LogRecord message;
+    message.setMessage("Preformatted message");
+    message.render(out, sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("Preformatted message", out);
+}
+
+/**
+ * @brief Test the bounded MPSC ring
+ * @details Verifies FIFO order, that a full ring rejects records
+ *          instead of blocking, and that cells are reused after a pop.
+ */
+void test_log_queue_bounded() {
+    MpscRing<int, 4> ring;
+    int value = 0;
+    
+    TEST_ASSERT_FALSE(ring.tryPop(value));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.tryPush(i));
+    }
+    TEST_ASSERT_FALSE(ring.tryPush(99));
+    
+    TEST_ASSERT_TRUE(ring.tryPop(value));
+    TEST_ASSERT_EQUAL(0, value);
+    TEST_ASSERT_TRUE(ring.tryPush(4));
+    
+    for (int expected = 1; expected <= 4; expected++) {
+        TEST_ASSERT_TRUE(ring.tryPop(value));
+        TEST_ASSERT_EQUAL(expected, value);
+    }
+    TEST_ASSERT_FALSE(ring.tryPop(value));
+}
+
+/**
+ * @brief Test that messages are only written by the log task
+ * @details Attaches the test task as the log task and verifies messages
+ *          are queued until processLogQueue() runs, and that INFO is
+ *          discarded when no output would show it.
+ */
+void test_error_handler_deferred() {
+    ErrorHandler errorHandler(nullptr);
+    errorHandler.setLogTask(xTaskGetCurrentTaskHandle());
+    TEST_ASSERT_TRUE(errorHandler.isAsync());
+    TEST_ASSERT_FALSE(errorHandler.isEnabled(INFO));
+    
+    errorHandler.logFormatted(WARNING, "Sensor %s timed out after %d ms", String("PT100_1"), 65);
+    errorHandler.logError(ERROR, "Plain message");
+    errorHandler.logFormatted(INFO, "Never captured %d", 1);
+    TEST_ASSERT_EQUAL_STRING("", errorHandler.getLastMessage().c_str());
+    
+    TEST_ASSERT_EQUAL(1, errorHandler.processLogQueue(1));
+    TEST_ASSERT_EQUAL_STRING("Sensor PT100_1 timed out after 65 ms", errorHandler.getLastMessage().c_str());
+    TEST_ASSERT_EQUAL(1, errorHandler.processLogQueue());
+    TEST_ASSERT_EQUAL(ERROR, errorHandler.getLastSeverity());
+    TEST_ASSERT_EQUAL(0, errorHandler.processLogQueue());
+    
+    errorHandler.setLogTask(nullptr);
+    ulTaskNotifyTake(pdTRUE, 0); // Clear the notifications sent to this task
+}
+
+/**
+ * @brief Run all deferred logging tests
+ */
+void run_deferred_logging_tests() {
+    RUN_TEST(test_log_record_render);
+    RUN_TEST(test_log_queue_bounded);
+    RUN_TEST(test_error_handler_deferred);
+}
+
+#endif // TEST_DEFERRED_LOGGING_H
+
+/** @} */ // End of deferred_logging_tests group
@@ -15,6 +15,9 @@
 #include <atomic>
 #include <map>
 #include <string>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../src/managers/SeqlockTable.h"
 
 /**
  * @brief Simplified cache structure for testing double buffering
@@ -206,6 +209,140 @@ void test_double_buffering_updates() {
     TEST_ASSERT_EQUAL(12350, timestamp);
 }
 
+/**
+ * @brief Payload for seqlock tests; every word must match for a read to be consistent
+ */
+struct SeqlockTestPayload {
+    uint32_t words[8];  ///< All words hold the same value when written
+};
+
+/**
+ * @brief Number of writes performed by the concurrent seqlock writer
+ */
+static const uint32_t SEQLOCK_TEST_WRITES = 20000;
+
+/**
+ * @brief Shared state for the concurrent seqlock test
+ */
+static SeqlockTable<SeqlockTestPayload, 4> seqlockTestTable;
+static volatile bool seqlockWriterDone = false;
+
+/**
+ * @brief Writer task for the concurrent seqlock test
+ * @param pvParameters Unused
+ */
+static void seqlockWriterTask([[maybe_unused]] void* pvParameters) {
+    SeqlockTestPayload payload;
+    for (uint32_t value = 1; value <= SEQLOCK_TEST_WRITES; value++) {
+        for (auto& word : payload.words) {
+            word = value;
+        }
+        seqlockTestTable.write(1, payload);
+    }
+    seqlockWriterDone = true;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Test basic seqlock table operation
+ * @details Verifies that unwritten slots report no data, written slots
+ *          return the latest value and slots are independent.
+ */
+void test_seqlock_table_basic_operation() {
+    SeqlockTable<TestCache, 4> table;
+    TestCache out;
+    
+    // Never-written and out-of-range slots report no data
+    TEST_ASSERT_FALSE(table.read(0, out));
+    TEST_ASSERT_FALSE(table.read(4, out));
+    TEST_ASSERT_FALSE(table.write(4, TestCache(1.0, 1)));
+    
+    TEST_ASSERT_TRUE(table.write(0, TestCache(25.5, 12345)));
+    TEST_ASSERT_TRUE(table.read(0, out));
+    TEST_ASSERT_EQUAL_FLOAT(25.5, out.value);
+    TEST_ASSERT_EQUAL(12345, out.timestamp);
+    
+    // Writes to one slot don't affect another, and the latest write wins
+    table.write(1, TestCache(60.0, 12346));
+    table.write(0, TestCache(26.0, 12350));
+    TEST_ASSERT_TRUE(table.read(0, out));
+    TEST_ASSERT_EQUAL_FLOAT(26.0, out.value);
+    TEST_ASSERT_TRUE(table.read(1, out));
+    TEST_ASSERT_EQUAL_FLOAT(60.0, out.value);
+    
+    // Sequence numbers are even and advance on every write
+    uint32_t seq = table.sequence(0);
+    TEST_ASSERT_EQUAL(0, seq & 1);
+    table.reset(0);
+    TEST_ASSERT_EQUAL(seq + 2, table.sequence(0));
+    TEST_ASSERT_TRUE(table.read(0, out));
+    TEST_ASSERT_EQUAL_FLOAT(0.0, out.value);
+}
+
+/**
+ * @brief Test that concurrent readers never observe a torn write
+ * @details A writer task on the other core continuously rewrites a slot
+ *          while this task reads it; every word of each copy must match.
+ */
+void test_seqlock_table_concurrent_reads() {
+    seqlockWriterDone = false;
+#if portNUM_PROCESSORS > 1
+    BaseType_t writerCore = xPortGetCoreID() == 0 ? 1 : 0;
+#else
+    BaseType_t writerCore = 0;  // Same core: exercises preemption instead of true parallelism
+#endif
+    
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(
+        seqlockWriterTask, "SeqlockWriter", 2048, nullptr, uxTaskPriorityGet(NULL), nullptr, writerCore));
+    
+    uint32_t reads = 0;
+    uint32_t torn = 0;
+    uint32_t lastValue = 0;
+    bool monotonic = true;
+    SeqlockTestPayload out;
+    
+    while (!seqlockWriterDone) {
+        if (seqlockTestTable.read(1, out)) {
+            for (auto word : out.words) {
+                if (word != out.words[0]) {
+                    torn++;
+                    break;
+                }
+            }
+            if (out.words[0] < lastValue) {
+                monotonic = false;
+            }
+            lastValue = out.words[0];
+            reads++;
+        }
+    }
+    
+    TEST_ASSERT_EQUAL(0, torn);
+    TEST_ASSERT_TRUE(monotonic);
+    TEST_ASSERT_TRUE(reads > 0);
+    
+    TEST_ASSERT_TRUE(seqlockTestTable.read(1, out));
+    TEST_ASSERT_EQUAL(SEQLOCK_TEST_WRITES, out.words[0]);
+}
+
+/**
+ * @brief Test that seqlock reads and writes never allocate
+ * @details Compares free heap before and after a burst of operations.
+ */
+void test_seqlock_table_no_allocation() {
+    static SeqlockTable<TestCache, 8> table;
+    TestCache out;
+    
+    uint32_t heapBefore = ESP.getFreeHeap();
+    for (int i = 0; i < 1000; i++) {
+        table.write(i % 8, TestCache(i, i));
+        table.read((i + 3) % 8, out);
+    }
+    uint32_t heapAfter = ESP.getFreeHeap();
+    
+    TEST_ASSERT_EQUAL(heapBefore, heapAfter);
+}
+
 /**
  * @brief Run all double buffering tests
  */
@@ -213,6 +350,9 @@ void run_double_buffering_tests() {
     RUN_TEST(test_double_buffering_basic_operation);
     RUN_TEST(test_double_buffering_multiple_keys);
     RUN_TEST(test_double_buffering_updates);
+    RUN_TEST(test_seqlock_table_basic_operation);
+    RUN_TEST(test_seqlock_table_concurrent_reads);
+    RUN_TEST(test_seqlock_table_no_allocation);
 }
 
 #endif // TEST_DOUBLE_BUFFERING_H
@@ -70,6 +70,81 @@ void test_error_severity_conversion() {
     TEST_ASSERT_EQUAL(INFO, ErrorHandler::stringToSeverity("UNKNOWN"));
 }
 
+/**
+ * @brief Helper that counts how often a log message is built
+ */
+static int logMessagesBuilt = 0;
+static String buildLogMessage(const char* text) {
+    logMessagesBuilt++;
+    return String(text);
+}
+
+/**
+ * @brief Test that log macros only build messages that will be kept
+ * @details With no outputs attached INFO is filtered before its arguments
+ *          are evaluated, while WARNING is still recorded.
+ */
+void test_log_macros_lazy() {
+    ErrorHandler errorHandler(nullptr);
+    logMessagesBuilt = 0;
+    
+    LOG_INFO(&errorHandler, buildLogMessage("idle route"));
+    LOG_INFO(&errorHandler, "Formatted %s", buildLogMessage("idle route"));
+    TEST_ASSERT_EQUAL(0, logMessagesBuilt);
+    
+    LOG_WARNING(&errorHandler, buildLogMessage("kept"));
+    TEST_ASSERT_EQUAL(1, logMessagesBuilt);
+    TEST_ASSERT_EQUAL(WARNING, errorHandler.getLastSeverity());
+    
+    LOG_ERROR(&errorHandler, "Sensor %s failed %d times", "SHT41_1", 3);
+    TEST_ASSERT_EQUAL_STRING("Sensor SHT41_1 failed 3 times", errorHandler.getLastMessage().c_str());
+}
+
+/**
+ * @brief Test the fixed-size log history ring
+ * @details Overfills the history and verifies only the newest entries are
+ *          returned, in order, that a fetch can resume from a sequence
+ *          number, and that long messages are truncated in place.
+ */
+void test_error_history_ring() {
+    ErrorHandler errorHandler(nullptr);
+    size_t depth = errorHandler.getHistoryDepth();
+    TEST_ASSERT_TRUE(depth > 0);
+    
+    for (size_t i = 1; i <= depth + 5; i++) {
+        errorHandler.logFormatted(WARNING, "Message %u", (unsigned)i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(depth + 5, errorHandler.getLatestSequence());
+    
+    uint32_t first = 0;
+    uint32_t last = 0;
+    size_t count = errorHandler.fetchHistory(0, depth * 2, [&](const LogHistoryEntry& entry) {
+        if (first == 0) {
+            first = entry.sequence;
+        }
+        last = entry.sequence;
+    });
+    TEST_ASSERT_EQUAL(depth, count);
+    TEST_ASSERT_EQUAL_UINT32(6, first);
+    TEST_ASSERT_EQUAL_UINT32(depth + 5, last);
+    
+    // Resume from a sequence number with a limit
+    String newest;
+    TEST_ASSERT_EQUAL(2, errorHandler.fetchHistory(depth + 2, 2, [&](const LogHistoryEntry& entry) {
+        newest = entry.message;
+    }));
+    TEST_ASSERT_EQUAL_STRING(("Message " + String((unsigned)(depth + 4))).c_str(), newest.c_str());
+    TEST_ASSERT_EQUAL(0, errorHandler.fetchHistory(depth + 5, 10, [](const LogHistoryEntry&) {}));
+    
+    // Messages longer than an entry are truncated
+    String longMessage;
+    for (int i = 0; i < 30; i++) {
+        longMessage += "0123456789";
+    }
+    errorHandler.logError(ERROR, longMessage);
+    TEST_ASSERT_EQUAL(sizeof(LogHistoryEntry::message) - 1, errorHandler.getLastMessage().length());
+}
+
 /**
  * @brief Run all error handler tests
  */
@@ -77,6 +152,8 @@ void run_error_handler_tests() {
     RUN_TEST(test_error_severity_enum);
     RUN_TEST(test_error_entry);
     RUN_TEST(test_error_severity_conversion);
+    RUN_TEST(test_log_macros_lazy);
+    RUN_TEST(test_error_history_ring);
 }
 
 #endif // TEST_ERROR_HANDLER_H
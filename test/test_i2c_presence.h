@@ -0,0 +1,156 @@
+/**
+ * @file test_i2c_presence.h
+ * @brief Test suite for the I2C presence cache, parallel probing and clock negotiation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup i2c_tests
+ */
+
+#ifndef TEST_I2C_PRESENCE_H
+#define TEST_I2C_PRESENCE_H
+
+#include <unity.h>
+#include "../src/managers/I2CManager.h"
+#include "../src/Constants.h"
+#include "../src/sensors/SensorTypes.h"
+
+/**
+ * @brief Test that nothing is cached before an address is probed
+ */
+void test_i2c_presence_unknown_by_default() {
+    ErrorHandler errorHandler(nullptr);
+    I2CManager manager(&errorHandler);
+
+    TEST_ASSERT_TRUE(manager.getCachedPresence(I2CPort::I2C0, 0x40) == DevicePresence::UNKNOWN);
+    TEST_ASSERT_TRUE(manager.getCachedPresence(I2CPort::I2C1, 0x77) == DevicePresence::UNKNOWN);
+
+    // Out-of-range buses and addresses are never cached
+    TEST_ASSERT_TRUE(manager.getCachedPresence(I2CPort::I2C0, 200) == DevicePresence::UNKNOWN);
+}
+
+/**
+ * @brief Test that probing uninitialized buses finds nothing and caches nothing
+ */
+void test_i2c_probe_uninitialized_buses() {
+    ErrorHandler errorHandler(nullptr);
+    I2CManager manager(&errorHandler);
+
+    std::vector<I2CManager::BusProbe> probes(2);
+    probes[0].port = I2CPort::I2C0;
+    probes[0].candidates = {0x40, 0x44};
+    probes[1].port = I2CPort::I2C1;
+    probes[1].candidates = {0x77};
+    manager.probeConcurrently(probes);
+
+    TEST_ASSERT_EQUAL(0, probes[0].found.size());
+    TEST_ASSERT_EQUAL(0, probes[1].found.size());
+    TEST_ASSERT_TRUE(manager.getCachedPresence(I2CPort::I2C1, 0x77) == DevicePresence::UNKNOWN);
+}
+
+/**
+ * @brief Test that a bus with missing devices settles at the standard rate
+ */
+void test_i2c_clock_negotiation() {
+    ErrorHandler errorHandler(nullptr);
+    I2CManager manager(&errorHandler);
+
+    TEST_ASSERT_EQUAL_UINT32(0, manager.negotiateClock(I2CPort::I2C0, 400000, {0x44}));
+    TEST_ASSERT_TRUE(manager.beginPort(I2CPort::I2C0));
+
+    // Nothing attached, or nothing answering, never earns a faster clock
+    TEST_ASSERT_EQUAL_UINT32(100000, manager.negotiateClock(I2CPort::I2C0, 400000, {}));
+    TEST_ASSERT_EQUAL_UINT32(100000, manager.negotiateClock(I2CPort::I2C0, 400000, {0x44}));
+    TEST_ASSERT_EQUAL_UINT32(50000, manager.negotiateClock(I2CPort::I2C0, 50000, {}));
+
+    TEST_ASSERT_EQUAL_UINT32(400000, I2CManager::nextSlowerClock(1000000));
+    TEST_ASSERT_EQUAL_UINT32(100000, I2CManager::nextSlowerClock(400000));
+    TEST_ASSERT_EQUAL_UINT32(100000, I2CManager::nextSlowerClock(200000));
+    TEST_ASSERT_EQUAL_UINT32(10000, I2CManager::nextSlowerClock(10000));
+
+    TEST_ASSERT_EQUAL_UINT32(1000000, maxI2CClockForType(SensorType::SHT41));
+    TEST_ASSERT_EQUAL_UINT32(400000, maxI2CClockForType(SensorType::SI7021));
+    TEST_ASSERT_EQUAL_UINT32(100000, maxI2CClockForType(SensorType::UNKNOWN));
+}
+
+/**
+ * @brief Test that requested clocks apply at the next transaction and errors step them down
+ */
+void test_i2c_clock_fallback() {
+    ErrorHandler errorHandler(nullptr);
+    I2CManager manager(&errorHandler);
+    TEST_ASSERT_TRUE(manager.beginPort(I2CPort::I2C1));
+
+    manager.requestClock(I2CPort::I2C1, 400000);
+    TEST_ASSERT_EQUAL_UINT32(100000, manager.getClockStatus(I2CPort::I2C1).clockFrequency);
+    manager.recordTransaction(I2CPort::I2C1, true);
+    TEST_ASSERT_EQUAL_UINT32(400000, manager.getClockStatus(I2CPort::I2C1).clockFrequency);
+
+    // A window with too few failures keeps the clock
+    for (uint32_t i = 0; i < Constants::Sensors::I2C_CLOCK_WINDOW; i++) {
+        manager.recordTransaction(I2CPort::I2C1, i >= Constants::Sensors::I2C_CLOCK_FALLBACK_ERRORS - 1);
+    }
+    TEST_ASSERT_EQUAL_UINT32(400000, manager.getClockStatus(I2CPort::I2C1).clockFrequency);
+
+    // One with enough steps down one standard rate
+    for (uint32_t i = 0; i < Constants::Sensors::I2C_CLOCK_WINDOW; i++) {
+        manager.recordTransaction(I2CPort::I2C1, i >= Constants::Sensors::I2C_CLOCK_FALLBACK_ERRORS);
+    }
+    BusClockStatus status = manager.getClockStatus(I2CPort::I2C1);
+    TEST_ASSERT_EQUAL_UINT32(100000, status.clockFrequency);
+    TEST_ASSERT_EQUAL_UINT32(1, status.fallbacks);
+    TEST_ASSERT_EQUAL_UINT32(2 * Constants::Sensors::I2C_CLOCK_WINDOW + 1, status.transactions);
+    TEST_ASSERT_EQUAL_UINT32(2 * Constants::Sensors::I2C_CLOCK_FALLBACK_ERRORS - 1, status.errors);
+
+    // The other bus is unaffected
+    TEST_ASSERT_EQUAL_UINT32(0, manager.getClockStatus(I2CPort::I2C0).transactions);
+}
+
+/**
+ * @brief Test multiplexer channel ports: naming, mapping to their bus and shared counters
+ */
+void test_i2c_mux_ports() {
+    I2CPort port = I2CPort::I2C0;
+    TEST_ASSERT_TRUE(I2CManager::parsePort("I2C1/mux:3", port));
+    TEST_ASSERT_TRUE(port == I2CManager::muxPort(I2CPort::I2C1, 3));
+    TEST_ASSERT_TRUE(I2CManager::physicalPort(port) == I2CPort::I2C1);
+    TEST_ASSERT_EQUAL(3, I2CManager::muxChannel(port));
+    TEST_ASSERT_EQUAL_STRING("I2C1/mux:3", I2CManager::portToString(port).c_str());
+    TEST_ASSERT_TRUE(I2CManager::parsePort("i2c0/MUX:7", port));
+    TEST_ASSERT_TRUE(I2CManager::parsePort("I2C0", port));
+    TEST_ASSERT_EQUAL(-1, I2CManager::muxChannel(port));
+
+    // Only channels a TCA9548A has on buses that exist
+    TEST_ASSERT_FALSE(I2CManager::parsePort("I2C0/mux:8", port));
+    TEST_ASSERT_FALSE(I2CManager::parsePort("I2C2/mux:0", port));
+    TEST_ASSERT_FALSE(I2CManager::parsePort("I2C0/mux:", port));
+    TEST_ASSERT_FALSE(I2CManager::isValidPort(static_cast<int>(I2CManager::muxPort(I2CPort::I2C1, 7)) + 1));
+    TEST_ASSERT_FALSE(I2CManager::isValidPort(2));
+
+    // Channels share their bus's mutex and transaction counters
+    ErrorHandler errorHandler(nullptr);
+    I2CManager manager(&errorHandler);
+    I2CPort channel = I2CManager::muxPort(I2CPort::I2C0, 5);
+    TEST_ASSERT_EQUAL_PTR(manager.getBusMutex(I2CPort::I2C0), manager.getBusMutex(channel));
+    TEST_ASSERT_TRUE(manager.beginPort(channel));
+    TEST_ASSERT_TRUE(manager.isPortInitialized(I2CPort::I2C0));
+    manager.recordTransaction(channel, true);
+    TEST_ASSERT_EQUAL_UINT32(1, manager.getClockStatus(I2CPort::I2C0).transactions);
+
+    // A direct port on a bus where no multiplexer was ever seen needs no selection
+    TEST_ASSERT_TRUE(manager.selectPort(I2CPort::I2C0));
+    TEST_ASSERT_EQUAL_UINT32(0, manager.getClockStatus(I2CPort::I2C0).muxSwitches);
+    TEST_ASSERT_TRUE(manager.getCachedPresence(channel, 0x44) == DevicePresence::UNKNOWN);
+}
+
+/**
+ * @brief Run all I2C presence tests
+ */
+void run_i2c_presence_tests() {
+    RUN_TEST(test_i2c_presence_unknown_by_default);
+    RUN_TEST(test_i2c_probe_uninitialized_buses);
+    RUN_TEST(test_i2c_clock_negotiation);
+    RUN_TEST(test_i2c_clock_fallback);
+    RUN_TEST(test_i2c_mux_ports);
+}
+
+#endif // TEST_I2C_PRESENCE_H
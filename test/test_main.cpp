@@ -13,21 +13,59 @@
 
 // Include all test headers
 #include "test_config.h"
+#include "test_config_cache.h"
+#include "test_i2c_presence.h"
+#include "test_bus_lock.h"
+#include "test_max31865.h"
+#include "test_sample_filter.h"
 #include "test_error_handler.h"
 #include "test_readings.h"
 #include "test_mock_sensor.h"
 #include "test_sensor_registry.h"
 #include "test_double_buffering.h"
+#include "test_slot_mailbox.h"
 #include "test_sensor_types.h"
+#include "test_poll_scheduler.h"
+#include "test_sensor_health.h"
+#include "test_power.h"
+#include "test_memory_budget.h"
+#include "test_reading_history.h"
+#include "test_binary_streamer.h"
+#include "test_telemetry.h"
+#include "test_time_sync.h"
+#include "test_task_supervisor.h"
+#include "test_command_params.h"
+#include "test_scpi_command_table.h"
+#include "test_deferred_logging.h"
+#include "test_perf_counters.h"
 
 // Function declarations for the test groups
 void run_config_tests();
+void run_config_cache_tests();
+void run_i2c_presence_tests();
+void run_bus_lock_tests();
+void run_max31865_tests();
+void run_sample_filter_tests();
 void run_error_handler_tests();
 void run_reading_tests();
 void run_mock_sensor_tests();
 void run_sensor_registry_tests();
 void run_double_buffering_tests();
+void run_slot_mailbox_tests();
 void run_sensor_type_tests();
+void run_poll_scheduler_tests();
+void run_sensor_health_tests();
+void run_power_tests();
+void run_memory_budget_tests();
+void run_reading_history_tests();
+void run_binary_streamer_tests();
+void run_telemetry_tests();
+void run_time_sync_tests();
+void run_task_supervisor_tests();
+void run_command_params_tests();
+void run_scpi_command_table_tests();
+void run_deferred_logging_tests();
+void run_perf_counter_tests();
 
 /**
  * @brief Setup function runs before each test
@@ -55,12 +93,31 @@ void setup() {
     
     // Run all test groups
     run_config_tests();
+    run_config_cache_tests();
+    run_i2c_presence_tests();
+    run_bus_lock_tests();
+    run_max31865_tests();
+    run_sample_filter_tests();
     run_error_handler_tests();
     run_reading_tests();
     run_mock_sensor_tests();
     run_sensor_registry_tests();
     run_double_buffering_tests();
+    run_slot_mailbox_tests();
     run_sensor_type_tests();
+    run_poll_scheduler_tests();
+    run_sensor_health_tests();
+    run_power_tests();
+    run_memory_budget_tests();
+    run_reading_history_tests();
+    run_binary_streamer_tests();
+    run_telemetry_tests();
+    run_time_sync_tests();
+    run_task_supervisor_tests();
+    run_command_params_tests();
+    run_scpi_command_table_tests();
+    run_deferred_logging_tests();
+    run_perf_counter_tests();
     
     UNITY_END();
 }
@@ -72,4 +129,18 @@ void loop() {
     // Tests complete, nothing to do here
 }
 
+#ifdef NATIVE_SIM
+#include <ArduinoSim.h>
+
+/**
+ * @brief Host entry point for pio test -e native
+ * setup() runs on the main thread, which the simulation treats as the
+ * Arduino loop task.
+ */
+int main(int argc, char** argv) {
+    setup();
+    Sim::shutdown(Unity.TestFailures == 0 ? 0 : 1);
+}
+#endif
+
 /** @} */ // End of test_main group
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * @file test_max31865.h
+ * @brief Test suite for the MAX31865 RTD conversion and PT100 settings
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_tests
+ */
+
+#ifndef TEST_MAX31865_H
+#define TEST_MAX31865_H
+
+#include <unity.h>
+#include "../src/sensors/MAX31865Driver.h"
+#include "../src/sensors/PT100Sensor.h"
+
+/**
+ * @brief Raw 15-bit RTD code of a resistance measured against a reference
+ * @param ohms RTD resistance
+ * @param refResistor Reference resistor in ohms
+ * @return Raw RTD value as read from the converter
+ */
+static uint16_t max31865RawFor(float ohms, float refResistor) {
+    return static_cast<uint16_t>(ohms / refResistor * 32768.0f + 0.5f);
+}
+
+/**
+ * @brief Test the conversion against IEC 60751 table values above 0 °C
+ */
+void test_max31865_positive_temperature() {
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 0.0, MAX31865Driver::calculateTemperature(max31865RawFor(100.0f, 430.0f), 100.0f, 430.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.05, 100.0, MAX31865Driver::calculateTemperature(max31865RawFor(138.51f, 430.0f), 100.0f, 430.0f));
+}
+
+/**
+ * @brief Test the polynomial branch below 0 °C
+ */
+void test_max31865_negative_temperature() {
+    TEST_ASSERT_FLOAT_WITHIN(0.1, -50.0, MAX31865Driver::calculateTemperature(max31865RawFor(80.31f, 430.0f), 100.0f, 430.0f));
+}
+
+/**
+ * @brief Test parsing of the PT100 conversion mode settings
+ */
+void test_pt100_conversion_mode_parse() {
+    PT100ConversionMode mode = PT100ConversionMode::parse("Wire mode: 3-wire, Ref: 430");
+    TEST_ASSERT_FALSE(mode.continuous);
+    TEST_ASSERT_EQUAL(60, mode.mainsHz);
+    TEST_ASSERT_EQUAL(-1, mode.drdyPin);
+
+    mode = PT100ConversionMode::parse("Mode: continuous, Mains: 50, DRDY: 4");
+    TEST_ASSERT_TRUE(mode.continuous);
+    TEST_ASSERT_EQUAL(50, mode.mainsHz);
+    TEST_ASSERT_EQUAL(4, mode.drdyPin);
+    TEST_ASSERT_EQUAL_UINT32(Constants::Sensors::MAX31865_AUTO_PERIOD_50HZ_MS, mode.periodMs());
+
+    // Unsupported mains frequencies keep the default
+    mode = PT100ConversionMode::parse("mode: auto, mains: 55");
+    TEST_ASSERT_TRUE(mode.continuous);
+    TEST_ASSERT_EQUAL(60, mode.mainsHz);
+}
+
+/**
+ * @brief Run all MAX31865 tests
+ */
+void run_max31865_tests() {
+    RUN_TEST(test_max31865_positive_temperature);
+    RUN_TEST(test_max31865_negative_temperature);
+    RUN_TEST(test_pt100_conversion_mode_parse);
+}
+
+#endif // TEST_MAX31865_H
@@ -0,0 +1,173 @@
+/**
+ * @file test_memory_budget.h
+ * @brief Test suite for the static memory budget
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup system_tests
+ */
+
+#ifndef TEST_MEMORY_BUDGET_H
+#define TEST_MEMORY_BUDGET_H
+
+#include <unity.h>
+#include <vector>
+#include "test_mock_sensor.h"
+#include "../src/sensors/SensorPool.h"
+#include "../src/managers/SensorRegistry.h"
+#include "../src/managers/PollScheduler.h"
+#include "../src/managers/SeqlockTable.h"
+
+#ifdef HEAP_ALLOCATION_COUNTING
+// The test environment links with -Wl,--wrap for each allocator entry point,
+// so every heap allocation in the firmware passes through here
+namespace {
+    volatile TaskHandle_t countingTask = nullptr;   ///< Task whose allocations are counted
+    volatile uint32_t allocationCount = 0;          ///< Allocations made by countingTask
+
+    inline void countAllocation() {
+        if (countingTask && xTaskGetCurrentTaskHandle() == countingTask) {
+            allocationCount = allocationCount + 1;
+        }
+    }
+}
+
+extern "C" {
+    void* __real_malloc(size_t size);
+    void* __real_calloc(size_t count, size_t size);
+    void* __real_realloc(void* ptr, size_t size);
+
+    void* __wrap_malloc(size_t size) {
+        countAllocation();
+        return __real_malloc(size);
+    }
+
+    void* __wrap_calloc(size_t count, size_t size) {
+        countAllocation();
+        return __real_calloc(count, size);
+    }
+
+    void* __wrap_realloc(void* ptr, size_t size) {
+        countAllocation();
+        return __real_realloc(ptr, size);
+    }
+}
+#endif
+
+/**
+ * @brief Test that pooled sensors reuse their blocks and overflow to the heap
+ */
+void test_sensor_pool_blocks() {
+    ErrorHandler errorHandler(nullptr);
+    SensorPool pool(&errorHandler);
+    TEST_ASSERT_TRUE(pool.reserve(2, sizeof(MockSensor)));
+    TEST_ASSERT_EQUAL(2, pool.getCapacity());
+    TEST_ASSERT_TRUE(pool.getBlockSize() >= sizeof(MockSensor));
+
+    MockSensor* first = pool.create<MockSensor>("First", &errorHandler);
+    MockSensor* second = pool.create<MockSensor>("Second", &errorHandler);
+    TEST_ASSERT_EQUAL(2, pool.getInUse());
+    TEST_ASSERT_EQUAL(0, pool.getHeapFallbacks());
+
+    // A full pool still produces a working sensor, from the heap
+    MockSensor* third = pool.create<MockSensor>("Third", &errorHandler);
+    TEST_ASSERT_NOT_NULL(third);
+    TEST_ASSERT_EQUAL(1, pool.getHeapFallbacks());
+    TEST_ASSERT_EQUAL_STRING("Third", third->getName().c_str());
+    pool.destroy(third);
+
+    // A freed block is handed to the next sensor
+    void* freed = first;
+    pool.destroy(first);
+    TEST_ASSERT_EQUAL(1, pool.getInUse());
+    MockSensor* reused = pool.create<MockSensor>("Reused", &errorHandler);
+    TEST_ASSERT_EQUAL_PTR(freed, reused);
+    TEST_ASSERT_EQUAL(2, pool.getHighWater());
+
+    pool.destroy(reused);
+    pool.destroy(second);
+    TEST_ASSERT_EQUAL(0, pool.getInUse());
+}
+
+/**
+ * @brief Test that names are stored inline and overlong names are flagged
+ */
+void test_sensor_name_inline() {
+    SensorName name("Chamber");
+    TEST_ASSERT_EQUAL(7, name.length());
+    TEST_ASSERT_FALSE(name.isTruncated());
+    TEST_ASSERT_TRUE(name == "Chamber");
+
+    String longName;
+    for (size_t i = 0; i <= Constants::Sensors::MAX_NAME_LENGTH; i++) {
+        longName += 'x';
+    }
+    SensorName truncated(longName);
+    TEST_ASSERT_TRUE(truncated.isTruncated());
+    TEST_ASSERT_EQUAL(Constants::Sensors::MAX_NAME_LENGTH, truncated.length());
+}
+
+/**
+ * @brief Test that a steady-state acquisition cycle makes no heap allocation
+ * @details Runs the scheduler, registry lookup, sensor read and reading
+ *          publication of the acquisition path with allocation counting
+ *          on. Ignored unless the build wraps the allocator.
+ */
+void test_steady_state_no_allocation() {
+#ifndef HEAP_ALLOCATION_COUNTING
+    TEST_IGNORE_MESSAGE("Allocation counting needs -DHEAP_ALLOCATION_COUNTING and -Wl,--wrap=malloc");
+#else
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    PollScheduler scheduler;
+    SeqlockTable<SensorSample, Constants::Sensors::MAX_SENSORS> table;
+
+    MockSensor* sensor = new MockSensor("Steady", &errorHandler);
+    sensor->initialize();
+    registry.registerSensor(sensor);
+
+    TickType_t now = 0;
+    scheduler.add("Steady", 100, now);
+    std::vector<SensorName> due;
+    due.reserve(Constants::Sensors::MAX_SENSORS);
+
+    allocationCount = 0;
+    countingTask = xTaskGetCurrentTaskHandle();
+    size_t cycles = 0;
+    for (int i = 0; i < 50; i++) {
+        now += pdMS_TO_TICKS(100);
+        due.clear();
+        scheduler.collectDue(now, due);
+        for (const SensorName& name : due) {
+            int slot = registry.getSlot(name);
+            ISensor* found = registry.getSensorByName(name);
+            SensorSample sample;
+            if (slot < 0 || !found || !found->sample(sample)) {
+                continue;
+            }
+            table.write(slot, sample);
+            SensorSample copy;
+            if (table.read(slot, copy) && copy.isValid(InterfaceType::TEMPERATURE)) {
+                cycles++;
+            }
+        }
+    }
+    countingTask = nullptr;
+
+    TEST_ASSERT_EQUAL(50, cycles);
+    TEST_ASSERT_EQUAL_UINT32(0, allocationCount);
+
+    registry.clear();
+    delete sensor;
+#endif
+}
+
+/**
+ * @brief Run all memory budget tests
+ */
+void run_memory_budget_tests() {
+    RUN_TEST(test_sensor_pool_blocks);
+    RUN_TEST(test_sensor_name_inline);
+    RUN_TEST(test_steady_state_no_allocation);
+}
+
+#endif // TEST_MEMORY_BUDGET_H
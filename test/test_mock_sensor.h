@@ -167,6 +167,44 @@ public:
     }
 };
 
+/**
+ * @brief Mock sensor with a pressure channel on top of the MockSensor ones
+ * @details Reads pressure through readChannel(), as a driver for a channel
+ *          without an interface of its own would.
+ */
+class MockPressureSensor : public MockSensor {
+public:
+    float mockPressure = 101325.0f;   ///< Mock pressure in Pa
+
+    /**
+     * @brief Constructor
+     * @param name Sensor name/identifier
+     * @param err Error handler pointer
+     */
+    MockPressureSensor(const String& name, ErrorHandler* err) : MockSensor(name, err) {}
+
+    /**
+     * @brief Check if this sensor supports the specified interface
+     * @param type The interface type to check
+     * @return true for temperature, humidity and pressure
+     */
+    bool supportsInterface(InterfaceType type) const override {
+        return type == InterfaceType::PRESSURE || MockSensor::supportsInterface(type);
+    }
+
+    /**
+     * @brief Read one channel on its own
+     * @param type Channel to read
+     * @return The value, NaN if disconnected
+     */
+    float readChannel(InterfaceType type) override {
+        if (type == InterfaceType::PRESSURE) {
+            return isConnected() ? mockPressure : NAN;
+        }
+        return MockSensor::readChannel(type);
+    }
+};
+
 /**
  * @brief Test basic mock sensor creation and initialization
  * @details Verifies that the MockSensor correctly handles
@@ -238,6 +276,77 @@ void test_mock_sensor_interfaces() {
     TEST_ASSERT_NULL(co2Interface);
 }
 
+/**
+ * @brief Test combined sampling from mock sensor
+ * @details Verifies that sample() returns every supported channel
+ *          with a shared timestamp and reports failure when disconnected.
+ */
+void test_mock_sensor_sample() {
+    ErrorHandler errorHandler(nullptr);
+    MockSensor sensor("TestMockSensor", &errorHandler);
+    sensor.initialize();
+    sensor.setMockTemperature(21.5);
+    sensor.setMockHumidity(40.0);
+    
+    SensorSample sample;
+    TEST_ASSERT_TRUE(sensor.sample(sample));
+    TEST_ASSERT_TRUE(sample.isValid(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_TRUE(sample.isValid(InterfaceType::HUMIDITY));
+    TEST_ASSERT_EQUAL_FLOAT(21.5, sample.get(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_EQUAL_FLOAT(40.0, sample.get(InterfaceType::HUMIDITY));
+    TEST_ASSERT_TRUE(sample.timestamp <= millis());
+    
+    // Disconnected sensor yields no valid channels
+    sensor.setConnected(false);
+    TEST_ASSERT_FALSE(sensor.sample(sample));
+    TEST_ASSERT_FALSE(sample.isValid(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_FALSE(sample.isValid(InterfaceType::HUMIDITY));
+}
+
+/**
+ * @brief Test that the default sample() covers every supported channel
+ * @details Verifies that a channel beyond temperature and humidity is
+ *          read through readChannel() into the same sample.
+ */
+void test_mock_sensor_sample_extra_channel() {
+    ErrorHandler errorHandler(nullptr);
+    MockPressureSensor sensor("TestPressureSensor", &errorHandler);
+    sensor.initialize();
+    sensor.mockPressure = 98000.0f;
+    
+    SensorSample sample;
+    TEST_ASSERT_TRUE(sensor.sample(sample));
+    TEST_ASSERT_TRUE(sample.isValid(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_TRUE(sample.isValid(InterfaceType::PRESSURE));
+    TEST_ASSERT_FALSE(sample.isValid(InterfaceType::CO2));
+    TEST_ASSERT_EQUAL_FLOAT(98000.0f, sample.get(InterfaceType::PRESSURE));
+}
+
+/**
+ * @brief Test the default conversion lifecycle for synchronous sensors
+ * @details Verifies that a sensor without its own lifecycle is ready
+ *          immediately and that start fails once it is disconnected.
+ */
+void test_mock_sensor_conversion_lifecycle() {
+    ErrorHandler errorHandler(nullptr);
+    MockSensor sensor("TestMockSensor", &errorHandler);
+    sensor.initialize();
+    sensor.setMockTemperature(19.0);
+    sensor.setMockHumidity(55.0);
+    
+    TEST_ASSERT_TRUE(sensor.startConversion());
+    TEST_ASSERT_EQUAL_UINT32(0, sensor.getConversionDelayMs());
+    TEST_ASSERT_TRUE(sensor.pollConversion() == ConversionStatus::READY);
+    
+    SensorSample sample;
+    TEST_ASSERT_TRUE(sensor.fetchResult(sample));
+    TEST_ASSERT_EQUAL_FLOAT(19.0, sample.get(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_EQUAL_FLOAT(55.0, sample.get(InterfaceType::HUMIDITY));
+    
+    sensor.setConnected(false);
+    TEST_ASSERT_FALSE(sensor.startConversion());
+}
+
 /**
  * @brief Run all mock sensor tests
  */
@@ -245,6 +354,9 @@ void run_mock_sensor_tests() {
     RUN_TEST(test_mock_sensor_creation);
     RUN_TEST(test_mock_sensor_readings);
     RUN_TEST(test_mock_sensor_interfaces);
+    RUN_TEST(test_mock_sensor_sample);
+    RUN_TEST(test_mock_sensor_sample_extra_channel);
+    RUN_TEST(test_mock_sensor_conversion_lifecycle);
 }
 
 #endif // TEST_MOCK_SENSOR_H
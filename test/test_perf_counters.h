@@ -0,0 +1,84 @@
+/**
+ * @file test_perf_counters.h
+ * @brief Test suite for the latency histograms
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup perf_counter_tests Performance Counter Tests
+ * @brief Tests for log2 bucketing, percentiles and scoped timing
+ * @{
+ */
+
+#ifndef TEST_PERF_COUNTERS_H
+#define TEST_PERF_COUNTERS_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include "../src/managers/PerfCounters.h"
+
+/**
+ * @brief Test bucketing and summary statistics
+ * @details Records a known distribution and verifies the count, extremes
+ *          and that percentiles land on the upper edge of their bucket.
+ */
+void test_perf_histogram_summary() {
+    TEST_ASSERT_EQUAL(0, PerfHistogram::bucketOf(0));
+    TEST_ASSERT_EQUAL(0, PerfHistogram::bucketOf(1));
+    TEST_ASSERT_EQUAL(1, PerfHistogram::bucketOf(3));
+    TEST_ASSERT_EQUAL(10, PerfHistogram::bucketOf(1024));
+    TEST_ASSERT_EQUAL(31, PerfHistogram::bucketOf(UINT32_MAX));
+
+    static PerfHistogram histogram;
+    histogram.reset();
+    TEST_ASSERT_EQUAL(0, histogram.summarize().count);
+
+    // 98 fast samples, two slow outliers
+    for (int i = 0; i < 98; i++) {
+        histogram.record(100 + i);
+    }
+    histogram.record(5000);
+    histogram.record(70000);
+
+    PerfHistogram::Summary summary = histogram.summarize();
+    TEST_ASSERT_EQUAL(100, summary.count);
+    TEST_ASSERT_EQUAL(100, summary.min);
+    TEST_ASSERT_EQUAL(70000, summary.max);
+    TEST_ASSERT_EQUAL(255, summary.p50);     // [128, 256) bucket
+    TEST_ASSERT_EQUAL(8191, summary.p99);    // 99th sample is 5000
+
+    histogram.reset();
+    TEST_ASSERT_EQUAL(0, histogram.summarize().count);
+}
+
+/**
+ * @brief Test scoped timing of a site
+ * @details Verifies a PerfScope adds one sample to its site and that
+ *          resetAll clears it.
+ */
+void test_perf_scope_records_site() {
+    PerfCounters::resetAll();
+    {
+        PerfScope timing(PerfSite::MEASURE);
+        delayMicroseconds(50);
+    }
+
+    PerfHistogram::Summary summary = PerfCounters::histogram(PerfSite::MEASURE).summarize();
+    TEST_ASSERT_EQUAL(1, summary.count);
+    TEST_ASSERT_TRUE(PerfCounters::cyclesToMicros(summary.max) >= 40.0f);
+    TEST_ASSERT_EQUAL(0, PerfCounters::histogram(PerfSite::SENSOR_UPDATE).summarize().count);
+    TEST_ASSERT_EQUAL_STRING("MEASURE", PerfCounters::siteName(PerfSite::MEASURE));
+
+    PerfCounters::resetAll();
+    TEST_ASSERT_EQUAL(0, PerfCounters::histogram(PerfSite::MEASURE).summarize().count);
+}
+
+/**
+ * @brief Run all performance counter tests
+ */
+void run_perf_counter_tests() {
+    RUN_TEST(test_perf_histogram_summary);
+    RUN_TEST(test_perf_scope_records_site);
+}
+
+#endif // TEST_PERF_COUNTERS_H
+
+/** @} */ // End of perf_counter_tests group
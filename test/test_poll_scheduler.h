@@ -0,0 +1,119 @@
+/**
+ * @file test_poll_scheduler.h
+ * @brief Test suite for the per-sensor deadline scheduler
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup poll_scheduler_tests Poll Scheduler Tests
+ * @brief Tests for per-sensor polling deadlines
+ * @{
+ */
+
+#ifndef TEST_POLL_SCHEDULER_H
+#define TEST_POLL_SCHEDULER_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include "../src/managers/PollScheduler.h"
+
+/**
+ * @brief Test that sensors are polled at their own rates
+ * @details Schedules a fast and a slow sensor and verifies each becomes
+ *          due only at its own period.
+ */
+void test_poll_scheduler_independent_rates() {
+    PollScheduler scheduler;
+    TickType_t start = 1000;
+    std::vector<SensorName> due;
+    
+    scheduler.add("Fast", 100, start);
+    scheduler.add("Slow", 300, start);
+    TEST_ASSERT_EQUAL(2, scheduler.size());
+    
+    // Both sensors are due immediately after being scheduled
+    TEST_ASSERT_EQUAL(2, scheduler.collectDue(start, due));
+    
+    // Only the fast sensor is due after one fast period
+    due.clear();
+    TEST_ASSERT_EQUAL(1, scheduler.collectDue(start + pdMS_TO_TICKS(100), due));
+    TEST_ASSERT_EQUAL_STRING("Fast", due[0].c_str());
+    
+    // Both are due again at the slow period
+    due.clear();
+    scheduler.collectDue(start + pdMS_TO_TICKS(200), due);
+    due.clear();
+    TEST_ASSERT_EQUAL(2, scheduler.collectDue(start + pdMS_TO_TICKS(300), due));
+}
+
+/**
+ * @brief Test the wait time until the next deadline
+ * @details Verifies that the scheduler reports the remaining ticks to the
+ *          earliest deadline and an infinite wait when empty.
+ */
+void test_poll_scheduler_wait_time() {
+    PollScheduler scheduler;
+    std::vector<SensorName> due;
+    
+    TEST_ASSERT_EQUAL(portMAX_DELAY, scheduler.ticksUntilNextDue(0));
+    
+    scheduler.add("Sensor", 200, 0);
+    TEST_ASSERT_EQUAL(0, scheduler.ticksUntilNextDue(0));
+    
+    scheduler.collectDue(0, due);
+    TEST_ASSERT_EQUAL(pdMS_TO_TICKS(200), scheduler.ticksUntilNextDue(0));
+    TEST_ASSERT_EQUAL(pdMS_TO_TICKS(150), scheduler.ticksUntilNextDue(pdMS_TO_TICKS(50)));
+}
+
+/**
+ * @brief Test that missed deadlines do not cause catch-up bursts
+ * @details A sensor that falls several periods behind is polled once,
+ *          re-anchored to the current time and counted as a missed deadline.
+ */
+void test_poll_scheduler_missed_deadlines() {
+    PollScheduler scheduler;
+    std::vector<SensorName> due;
+    
+    scheduler.add("Sensor", 100, 0);
+    scheduler.collectDue(0, due);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getMissedDeadlines());
+    
+    due.clear();
+    TickType_t late = pdMS_TO_TICKS(1000);
+    TEST_ASSERT_EQUAL(1, scheduler.collectDue(late, due));
+    TEST_ASSERT_EQUAL(pdMS_TO_TICKS(100), scheduler.ticksUntilNextDue(late));
+    
+    // The re-anchored poll is reported once, and survives a rebuild
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getMissedDeadlines());
+    scheduler.clear();
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getMissedDeadlines());
+}
+
+/**
+ * @brief Test deadline ordering across tick counter wrap-around
+ */
+void test_poll_scheduler_tick_wrap() {
+    PollScheduler scheduler;
+    std::vector<SensorName> due;
+    TickType_t nearWrap = static_cast<TickType_t>(0xFFFFFFFF - 10);
+    
+    scheduler.add("Sensor", 100, nearWrap);
+    scheduler.collectDue(nearWrap, due);
+    
+    // Just past the wrap the sensor is not yet due
+    due.clear();
+    TEST_ASSERT_EQUAL(0, scheduler.collectDue(nearWrap + 20, due));
+    TEST_ASSERT_EQUAL(1, scheduler.collectDue(nearWrap + pdMS_TO_TICKS(100), due));
+}
+
+/**
+ * @brief Run all poll scheduler tests
+ */
+void run_poll_scheduler_tests() {
+    RUN_TEST(test_poll_scheduler_independent_rates);
+    RUN_TEST(test_poll_scheduler_wait_time);
+    RUN_TEST(test_poll_scheduler_missed_deadlines);
+    RUN_TEST(test_poll_scheduler_tick_wrap);
+}
+
+#endif // TEST_POLL_SCHEDULER_H
+
+/** @} */ // End of poll_scheduler_tests group
@@ -0,0 +1,54 @@
+/**
+ * @file test_power.h
+ * @brief Test suite for the power-managed acquisition mode
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup system_tests
+ */
+
+#ifndef TEST_POWER_H
+#define TEST_POWER_H
+
+#include <unity.h>
+#include "../src/managers/PowerManager.h"
+#include "../src/managers/BusLock.h"
+
+/**
+ * @brief Test parsing the power mode from the board configuration
+ */
+void test_power_parse_mode() {
+    TEST_ASSERT_FALSE(PowerManager::parseLowPower(""));
+    TEST_ASSERT_FALSE(PowerManager::parseLowPower("This is a fully configurable field"));
+    TEST_ASSERT_FALSE(PowerManager::parseLowPower("Power: full"));
+    TEST_ASSERT_TRUE(PowerManager::parseLowPower("Power: low"));
+    TEST_ASSERT_TRUE(PowerManager::parseLowPower("Site B, POWER:LOW"));
+}
+
+/**
+ * @brief Test that backstop wake-ups are only stretched in low-power mode
+ */
+void test_power_idle_wake() {
+    ErrorHandler errorHandler(nullptr);
+    PowerManager power(&errorHandler);
+    TEST_ASSERT_TRUE(power.begin(false));
+    TEST_ASSERT_FALSE(power.isLowPower());
+    TEST_ASSERT_EQUAL_UINT32(100, power.idleWakeMs(100));
+
+    // Locks are no-ops until low-power mode creates them
+    BusMutex mutex;
+    mutex.setPowerLock(power.getBusLock());
+    {
+        BusLock lock(&mutex);
+        TEST_ASSERT_TRUE(lock.owns());
+    }
+}
+
+/**
+ * @brief Run all power management tests
+ */
+void run_power_tests() {
+    RUN_TEST(test_power_parse_mode);
+    RUN_TEST(test_power_idle_wake);
+}
+
+#endif // TEST_POWER_H
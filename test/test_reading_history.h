@@ -0,0 +1,152 @@
+/**
+ * @file test_reading_history.h
+ * @brief Test suite for the per-sensor reading history
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup reading_history_tests Reading History Tests
+ * @brief Tests for history storage and bulk fetch
+ * @{
+ */
+
+#ifndef TEST_READING_HISTORY_H
+#define TEST_READING_HISTORY_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+#include "../src/managers/ReadingHistory.h"
+
+/**
+ * @brief Helper to append a valid temperature record
+ */
+static void appendTemperature(ReadingHistory& history, size_t slot, float value, uint32_t timestamp) {
+    ChannelValues reading;
+    reading.set(InterfaceType::TEMPERATURE, value);
+    reading.timestamp = timestamp;
+    history.append(slot, HistoryRecord::pack(reading, channelBit(InterfaceType::TEMPERATURE)));
+}
+
+/**
+ * @brief Test that records from all slots are returned in sequence order
+ * @details Interleaves appends on two slots and verifies the fetch merges
+ *          them oldest first and resumes from a sequence number.
+ */
+void test_reading_history_fetch_in_order() {
+    ErrorHandler errorHandler(nullptr);
+    ReadingHistory history(&errorHandler);
+    TEST_ASSERT_TRUE(history.getDepth() > 0);
+
+    appendTemperature(history, 0, 20.0, 100);
+    appendTemperature(history, 3, 30.0, 110);
+    appendTemperature(history, 0, 21.0, 200);
+    appendTemperature(history, 3, 31.0, 210);
+    TEST_ASSERT_EQUAL_UINT32(4, history.getLatestSequence());
+
+    std::vector<HistoryRecord> fetched;
+    auto collect = [&](const HistoryRecord& record) { fetched.push_back(record); };
+
+    TEST_ASSERT_EQUAL(4, history.fetch(0, 0, 0xFFFFFFFF, 100, collect));
+    for (size_t i = 0; i < fetched.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(i + 1, fetched[i].sequence);
+    }
+    TEST_ASSERT_EQUAL(3, fetched[1].slot);
+    TEST_ASSERT_EQUAL_FLOAT(30.0, fetched[1].get(InterfaceType::TEMPERATURE));
+
+    // Resume after the second record
+    fetched.clear();
+    TEST_ASSERT_EQUAL(2, history.fetch(2, 0, 0xFFFFFFFF, 100, collect));
+    TEST_ASSERT_EQUAL_UINT32(3, fetched[0].sequence);
+
+    // Filter by timestamp and slot
+    fetched.clear();
+    TEST_ASSERT_EQUAL(1, history.fetch(0, 150, 1UL << 3, 100, collect));
+    TEST_ASSERT_EQUAL_FLOAT(31.0, fetched[0].get(InterfaceType::TEMPERATURE));
+
+    // Limit the number of records returned
+    fetched.clear();
+    TEST_ASSERT_EQUAL(3, history.fetch(0, 0, 0xFFFFFFFF, 3, collect));
+    TEST_ASSERT_EQUAL_UINT32(3, fetched.back().sequence);
+}
+
+/**
+ * @brief Test ring wrap-around and slot reset
+ * @details Overfills one slot and verifies only the newest records are
+ *          kept, then resets the slot and verifies its history is gone.
+ */
+void test_reading_history_wraparound() {
+    ErrorHandler errorHandler(nullptr);
+    ReadingHistory history(&errorHandler);
+    size_t depth = history.getDepth();
+    TEST_ASSERT_TRUE(depth > 0);
+
+    for (size_t i = 0; i < depth + 10; i++) {
+        appendTemperature(history, 1, (float)i, i);
+    }
+
+    size_t count = 0;
+    uint32_t firstSequence = 0;
+    history.fetch(0, 0, 1UL << 1, depth * 2, [&](const HistoryRecord& record) {
+        if (count++ == 0) {
+            firstSequence = record.sequence;
+        }
+    });
+
+    // The oldest records were overwritten; at most one slot is skipped as possibly torn
+    TEST_ASSERT_TRUE(count >= depth - 1 && count <= depth);
+    TEST_ASSERT_TRUE(firstSequence > 10);
+
+    history.reset(1);
+    count = 0;
+    history.fetch(0, 0, 1UL << 1, depth, [&](const HistoryRecord&) { count++; });
+    TEST_ASSERT_EQUAL(0, count);
+}
+
+/**
+ * @brief Test that records store only the sensor's channels, packed
+ * @details Packs a reading with pressure and CO2 and verifies the values
+ *          are found by channel, an invalid channel is kept as such and
+ *          channels the sensor does not provide are dropped.
+ */
+void test_history_record_packing() {
+    ChannelValues reading;
+    reading.set(InterfaceType::TEMPERATURE, 22.0f);
+    reading.set(InterfaceType::PRESSURE, 101325.0f);
+    reading.set(InterfaceType::CO2, NAN);
+    reading.set(InterfaceType::LIGHT, 300.0f);
+    reading.timestamp = 500;
+
+    uint8_t sensorChannels = channelBit(InterfaceType::PRESSURE) | channelBit(InterfaceType::CO2) |
+                             channelBit(InterfaceType::TEMPERATURE);
+    HistoryRecord record = HistoryRecord::pack(reading, sensorChannels);
+    TEST_ASSERT_EQUAL(sensorChannels, record.channels);
+    TEST_ASSERT_EQUAL_UINT32(500, record.timestampMs());
+    TEST_ASSERT_TRUE(record.timeUs == 500000ULL);
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, record.get(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_EQUAL_FLOAT(101325.0f, record.get(InterfaceType::PRESSURE));
+    TEST_ASSERT_TRUE(record.isValid(InterfaceType::PRESSURE));
+    TEST_ASSERT_FALSE(record.isValid(InterfaceType::CO2));
+    TEST_ASSERT_FALSE(record.isValid(InterfaceType::LIGHT));
+    TEST_ASSERT_TRUE(isnan(record.get(InterfaceType::LIGHT)));
+
+    // Visited in InterfaceType order
+    InterfaceType visited[Constants::Sensors::HISTORY_CHANNELS];
+    size_t count = 0;
+    record.forEachValue([&](InterfaceType type, float, bool) { visited[count++] = type; });
+    TEST_ASSERT_EQUAL(3, count);
+    TEST_ASSERT_TRUE(visited[0] == InterfaceType::TEMPERATURE);
+    TEST_ASSERT_TRUE(visited[1] == InterfaceType::PRESSURE);
+    TEST_ASSERT_TRUE(visited[2] == InterfaceType::CO2);
+}
+
+/**
+ * @brief Run all reading history tests
+ */
+void run_reading_history_tests() {
+    RUN_TEST(test_reading_history_fetch_in_order);
+    RUN_TEST(test_reading_history_wraparound);
+    RUN_TEST(test_history_record_packing);
+}
+
+#endif // TEST_READING_HISTORY_H
+
+/** @} */ // End of reading_history_tests group
@@ -0,0 +1,270 @@
+/**
+ * @file test_sample_filter.h
+ * @brief Test suite for per-sensor quality checks, sample filtering and decimation
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_tests
+ */
+
+#ifndef TEST_SAMPLE_FILTER_H
+#define TEST_SAMPLE_FILTER_H
+
+#include <unity.h>
+#include "../src/managers/SampleFilter.h"
+#ifdef NATIVE_SIM
+#include <SimDevices.h>
+#include "../src/config/ConfigManager.h"
+#include "../src/managers/I2CManager.h"
+#include "../src/managers/SensorManager.h"
+#endif
+
+/**
+ * @brief Build a temperature-only sample
+ */
+static SensorSample temperatureSample(float value) {
+    SensorSample sample;
+    sample.setTemperature(value);
+    return sample;
+}
+
+/**
+ * @brief Test parsing filter settings from the additional string
+ */
+void test_sample_filter_parse() {
+    FilterSettings settings = FilterSettings::parse("Wire mode: 3-wire, Filter: Median 5, Decimate: 10");
+    TEST_ASSERT_TRUE(settings.kind == FilterKind::MEDIAN);
+    TEST_ASSERT_EQUAL(5, settings.window);
+    TEST_ASSERT_EQUAL(10, settings.decimation);
+
+    settings = FilterSettings::parse("filter: ema 0.25");
+    TEST_ASSERT_TRUE(settings.kind == FilterKind::EMA);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, settings.alpha);
+    TEST_ASSERT_EQUAL(1, settings.decimation);
+
+    // Out-of-range values leave samples untouched
+    TEST_ASSERT_TRUE(FilterSettings::parse("Filter: boxcar 99").isPassThrough());
+    TEST_ASSERT_TRUE(FilterSettings::parse("Filter: ema 3").isPassThrough());
+    TEST_ASSERT_TRUE(FilterSettings::parse("").isPassThrough());
+}
+
+/**
+ * @brief Test the boxcar and median kernels
+ */
+void test_sample_filter_kernels() {
+    FilterSettings settings;
+    settings.kind = FilterKind::BOXCAR;
+    settings.window = 4;
+    SampleFilter boxcar;
+    boxcar.configure(settings);
+
+    SensorSample sample = temperatureSample(1.0f);
+    TEST_ASSERT_TRUE(boxcar.process(sample));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, sample.get(InterfaceType::TEMPERATURE));
+    for (float value : {2.0f, 3.0f, 4.0f, 5.0f}) {
+        sample = temperatureSample(value);
+        boxcar.process(sample);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, sample.get(InterfaceType::TEMPERATURE));  // mean of 2..5
+
+    // A single spike does not get through a median of three
+    settings.kind = FilterKind::MEDIAN;
+    settings.window = 3;
+    SampleFilter median;
+    median.configure(settings);
+    for (float value : {20.0f, 20.5f, 99.0f}) {
+        sample = temperatureSample(value);
+        median.process(sample);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(20.5f, sample.get(InterfaceType::TEMPERATURE));
+
+    // Humidity is untouched when the sample does not carry it
+    TEST_ASSERT_FALSE(sample.isValid(InterfaceType::HUMIDITY));
+}
+
+/**
+ * @brief Test EMA smoothing with decimation
+ */
+void test_sample_filter_decimation() {
+    FilterSettings settings;
+    settings.kind = FilterKind::EMA;
+    settings.alpha = 0.5f;
+    settings.decimation = 3;
+    SampleFilter filter;
+    filter.configure(settings);
+
+    SensorSample sample = temperatureSample(10.0f);
+    TEST_ASSERT_FALSE(filter.process(sample));
+    sample = temperatureSample(20.0f);
+    TEST_ASSERT_FALSE(filter.process(sample));
+    sample = temperatureSample(20.0f);
+    TEST_ASSERT_TRUE(filter.process(sample));
+    TEST_ASSERT_EQUAL_FLOAT(17.5f, sample.get(InterfaceType::TEMPERATURE));  // 10 -> 15 -> 17.5
+
+    // Failed reads are passed on at once and do not count towards decimation
+    SensorSample failed;
+    TEST_ASSERT_TRUE(filter.process(failed));
+    TEST_ASSERT_FALSE(failed.anyValid());
+}
+
+/**
+ * @brief Test parsing deadband and heartbeat settings
+ */
+void test_report_settings_parse() {
+    ReportSettings settings = ReportSettings::parse("Deadband: 0.2, Deadband HUM: 1.5, Heartbeat: 60000");
+    TEST_ASSERT_EQUAL_FLOAT(0.2f, settings.deadbandFor(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, settings.deadbandFor(InterfaceType::HUMIDITY));
+    TEST_ASSERT_EQUAL_UINT32(60000, settings.heartbeatMs);
+
+    // Nothing configured streams every sample
+    settings = ReportSettings::parse("Filter: median 5");
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, settings.deadbandFor(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, settings.deadbandFor(InterfaceType::HUMIDITY));
+    TEST_ASSERT_EQUAL_UINT32(0, settings.heartbeatMs);
+}
+
+/**
+ * @brief Build a temperature-only sample at a time
+ */
+static SensorSample temperatureSampleAt(float value, uint32_t timestamp) {
+    SensorSample sample = temperatureSample(value);
+    sample.timestamp = timestamp;
+    return sample;
+}
+
+/**
+ * @brief Test parsing quality settings from the additional string
+ */
+void test_quality_settings_parse() {
+    QualitySettings settings = QualitySettings::parse("Range TEMP: -40..125, Rate: 2, Rate HUM: 10, Stuck: 20, Outlier: 5");
+    TEST_ASSERT_TRUE(settings.enabled);
+    TEST_ASSERT_EQUAL_FLOAT(-40.0f, settings.minimum[static_cast<size_t>(InterfaceType::TEMPERATURE)]);
+    TEST_ASSERT_EQUAL_FLOAT(125.0f, settings.maximum[static_cast<size_t>(InterfaceType::TEMPERATURE)]);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, settings.maxRate[static_cast<size_t>(InterfaceType::TEMPERATURE)]);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, settings.maxRate[static_cast<size_t>(InterfaceType::HUMIDITY)]);
+    TEST_ASSERT_EQUAL(20, settings.stuckSamples[static_cast<size_t>(InterfaceType::HUMIDITY)]);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, settings.outlierSigma);
+
+    // Channels without a range of their own keep the plausible one; the other checks are off by default
+    settings = QualitySettings::parse("Filter: median 5");
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, settings.minimum[static_cast<size_t>(InterfaceType::HUMIDITY)]);
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, settings.maximum[static_cast<size_t>(InterfaceType::HUMIDITY)]);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, settings.maxRate[static_cast<size_t>(InterfaceType::TEMPERATURE)]);
+    TEST_ASSERT_EQUAL(0, settings.stuckSamples[static_cast<size_t>(InterfaceType::TEMPERATURE)]);
+
+    TEST_ASSERT_FALSE(QualitySettings::parse("Quality: off").enabled);
+}
+
+/**
+ * @brief Test the range, stuck, rate and outlier checks
+ */
+void test_sample_quality_checks() {
+    SampleQuality quality;
+    quality.configure(QualitySettings::parse("Rate: 1, Stuck: 3"));
+
+    // An open PT100 converts to -242 C, below the plausible range
+    SensorSample sample = temperatureSampleAt(-242.0f, 0);
+    TEST_ASSERT_EQUAL(channelBit(InterfaceType::TEMPERATURE), quality.process(sample));
+    TEST_ASSERT_FALSE(sample.anyValid());
+    TEST_ASSERT_TRUE(sample.quality(InterfaceType::TEMPERATURE) == QualityCode::OUT_OF_RANGE);
+
+    // A jump faster than 1 C/s is held back until it persists
+    sample = temperatureSampleAt(20.0f, 1000);
+    TEST_ASSERT_EQUAL(0, quality.process(sample));
+    sample = temperatureSampleAt(25.0f, 2000);
+    quality.process(sample);
+    TEST_ASSERT_TRUE(sample.quality(InterfaceType::TEMPERATURE) == QualityCode::RATE_OF_CHANGE);
+    sample = temperatureSampleAt(25.5f, 3000);
+    quality.process(sample);
+    TEST_ASSERT_FALSE(sample.anyValid());
+    sample = temperatureSampleAt(25.2f, 4000);
+    TEST_ASSERT_EQUAL(0, quality.process(sample));
+    TEST_ASSERT_EQUAL_FLOAT(25.2f, sample.get(InterfaceType::TEMPERATURE));
+
+    // The third identical sample in a row is stuck, until the value moves
+    sample = temperatureSampleAt(25.2f, 5000);
+    TEST_ASSERT_EQUAL(0, quality.process(sample));
+    sample = temperatureSampleAt(25.2f, 6000);
+    quality.process(sample);
+    TEST_ASSERT_TRUE(sample.quality(InterfaceType::TEMPERATURE) == QualityCode::STUCK);
+    sample = temperatureSampleAt(25.3f, 7000);
+    TEST_ASSERT_EQUAL(0, quality.process(sample));
+
+    // A spike far outside the running spread is an outlier; failed reads are left alone
+    SampleQuality outliers;
+    outliers.configure(QualitySettings::parse("Outlier: 5"));
+    for (uint32_t i = 0; i < 16; i++) {
+        sample = temperatureSampleAt(20.0f + (i % 2) * 0.1f, i * 1000);
+        TEST_ASSERT_EQUAL(0, outliers.process(sample));
+    }
+    sample = temperatureSampleAt(35.0f, 16000);
+    outliers.process(sample);
+    TEST_ASSERT_TRUE(sample.quality(InterfaceType::TEMPERATURE) == QualityCode::OUTLIER);
+    SensorSample failed;
+    TEST_ASSERT_EQUAL(0, outliers.process(failed));
+    TEST_ASSERT_TRUE(failed.quality(InterfaceType::TEMPERATURE) == QualityCode::NO_DATA);
+}
+
+#ifdef NATIVE_SIM
+/**
+ * @brief Test that editing a live sensor's additional settings takes effect
+ * @details The sensor is recreated on a new slot, so its filter, quality
+ *          and report settings are those of the new configuration.
+ */
+void test_sample_filter_reconfigure_live() {
+    Sim::Sht4x probe(Sim::Sht4x::DEFAULT_ADDRESS);
+    Sim::attachI2C(1, &probe);
+    ErrorHandler errorHandler(nullptr);
+    ConfigManager configManager(&errorHandler);
+    I2CManager i2cManager(&errorHandler);
+    TEST_ASSERT_TRUE(i2cManager.begin());
+    SensorManager sensorManager(&configManager, &i2cManager, &errorHandler);
+
+    SensorConfig config;
+    config.name = "Probe";
+    config.type = "SHT41";
+    config.communicationType = CommunicationType::I2C;
+    config.portNum = static_cast<int>(I2CPort::I2C0);
+    config.address = Sim::Sht4x::DEFAULT_ADDRESS;
+    config.pollingRate = 1000;
+    config.additional = "";
+    TEST_ASSERT_TRUE(sensorManager.applySensorConfigs({config}));
+    int slot = sensorManager.getRegistry().getSlot(SensorName("Probe"));
+    TEST_ASSERT_TRUE(slot >= 0);
+    TEST_ASSERT_TRUE(sensorManager.getFilterSettings(slot).isPassThrough());
+
+    config.additional = "Filter: median 5, Decimate: 4, Deadband: 0.5";
+    TEST_ASSERT_TRUE(sensorManager.applySensorConfigs({config}));
+    slot = sensorManager.getRegistry().getSlot(SensorName("Probe"));
+    TEST_ASSERT_TRUE(slot >= 0);
+    const FilterSettings& filter = sensorManager.getFilterSettings(slot);
+    TEST_ASSERT_TRUE(filter.kind == FilterKind::MEDIAN);
+    TEST_ASSERT_EQUAL(5, filter.window);
+    TEST_ASSERT_EQUAL(4, filter.decimation);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, sensorManager.getReportSettings(slot).deadbandFor(InterfaceType::TEMPERATURE));
+
+    // Back to defaults
+    config.additional = "";
+    TEST_ASSERT_TRUE(sensorManager.applySensorConfigs({config}));
+    slot = sensorManager.getRegistry().getSlot(SensorName("Probe"));
+    TEST_ASSERT_TRUE(sensorManager.getFilterSettings(slot).isPassThrough());
+
+    Sim::detach(&probe);
+}
+#endif
+
+/**
+ * @brief Run all sample filter tests
+ */
+void run_sample_filter_tests() {
+    RUN_TEST(test_sample_filter_parse);
+    RUN_TEST(test_sample_filter_kernels);
+    RUN_TEST(test_sample_filter_decimation);
+    RUN_TEST(test_report_settings_parse);
+    RUN_TEST(test_quality_settings_parse);
+    RUN_TEST(test_sample_quality_checks);
+#ifdef NATIVE_SIM
+    RUN_TEST(test_sample_filter_reconfigure_live);
+#endif
+}
+
+#endif // TEST_SAMPLE_FILTER_H
@@ -0,0 +1,89 @@
+/**
+ * @file test_scpi_command_table.h
+ * @brief Test suite for the compile-time SCPI command table
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup scpi_command_table_tests SCPI Command Table Tests
+ * @brief Tests for SCPI mnemonic matching and hashed dispatch
+ * @{
+ */
+
+#ifndef TEST_SCPI_COMMAND_TABLE_H
+#define TEST_SCPI_COMMAND_TABLE_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include "../src/Constants.h"
+#include "../src/communication/ScpiCommandTable.h"
+
+// Hashes are computed by the compiler
+static_assert(ScpiMnemonic::hash("MEASure:HISTory?") == ScpiMnemonic::hash("meas:history?"),
+              "Long and short spellings must hash identically");
+static_assert(ScpiMnemonic::isWellFormed(Constants::SCPI::UPDATE_CONFIG), "Pattern must be usable");
+static_assert(!ScpiMnemonic::isWellFormed("SYSTem:BOArd"), "Short form must derive the same hash");
+
+/**
+ * @brief Test short and long form matching
+ * @details Verifies case-insensitive short and long forms are accepted and
+ *          that partial spellings and a missing query suffix are rejected.
+ */
+void test_scpi_mnemonic_matching() {
+    const char* pattern = Constants::SCPI::MEASURE_STREAM_QUERY;
+    
+    TEST_ASSERT_TRUE(ScpiMnemonic::matches("MEAS:STR?", pattern));
+    TEST_ASSERT_TRUE(ScpiMnemonic::matches("measure:stream?", pattern));
+    TEST_ASSERT_TRUE(ScpiMnemonic::matches("Meas:Stream?", pattern));
+    TEST_ASSERT_TRUE(ScpiMnemonic::matches(":MEAS:STREAM?", pattern));
+    
+    TEST_ASSERT_FALSE(ScpiMnemonic::matches("MEAS:STRE?", pattern));
+    TEST_ASSERT_FALSE(ScpiMnemonic::matches("MEAS:STREAM", pattern));
+    TEST_ASSERT_FALSE(ScpiMnemonic::matches("MEAS:STREAM:MAP?", pattern));
+    TEST_ASSERT_FALSE(ScpiMnemonic::matches("MEAS?", pattern));
+}
+
+/**
+ * @brief Test lookup through the perfect-hash table
+ * @details Builds a small table of integer handlers and verifies every
+ *          spelling resolves to the same entry and unknown commands miss.
+ */
+void test_scpi_command_table_lookup() {
+    static constexpr ScpiCommand<int> commands[] = {
+        {Constants::SCPI::IDN, 1},
+        {Constants::SCPI::LOG_ROUTE, 2},
+        {Constants::SCPI::LOG_STATUS, 3},
+        {Constants::SCPI::UPDATE_ADDITIONAL_CONFIG, 4},
+        {Constants::SCPI::TEST, 5},
+        {Constants::SCPI::TEST_INFO, 6},
+    };
+    static constexpr ScpiCommandTable<int, 6> table(commands);
+    static_assert(table.isValid(), "Table must build");
+    
+    TEST_ASSERT_EQUAL(1, table.find("*idn?")->handler);
+    TEST_ASSERT_EQUAL(2, table.find("SYST:LOG")->handler);
+    TEST_ASSERT_EQUAL(3, table.find("system:log?")->handler);
+    TEST_ASSERT_EQUAL(4, table.find("SYST:CONF:ADD:UPDATE")->handler);
+    TEST_ASSERT_EQUAL(4, table.find("SYSTEM:CONFIGURE:ADDITIONAL:UPD")->handler);
+    TEST_ASSERT_EQUAL(5, table.find("test")->handler);
+    TEST_ASSERT_EQUAL(6, table.find("TEST:INFO")->handler);
+    
+    TEST_ASSERT_NULL(table.find("TEST:INF"));
+    TEST_ASSERT_NULL(table.find("SYST:LOGS"));
+    TEST_ASSERT_NULL(table.find("MEAS?"));
+    TEST_ASSERT_NULL(table.find(""));
+    
+    // Duplicate commands can never get a bucket each
+    static constexpr ScpiCommand<int> duplicates[] = {{"MEASure?", 1}, {"MEAS?", 2}};
+    static_assert(!ScpiCommandTable<int, 2>(duplicates).isValid(), "Duplicates must be rejected");
+}
+
+/**
+ * @brief Run all SCPI command table tests
+ */
+void run_scpi_command_table_tests() {
+    RUN_TEST(test_scpi_mnemonic_matching);
+    RUN_TEST(test_scpi_command_table_lookup);
+}
+
+#endif // TEST_SCPI_COMMAND_TABLE_H
+
+/** @} */ // End of scpi_command_table_tests group
@@ -0,0 +1,70 @@
+/**
+ * @file test_sensor_health.h
+ * @brief Test suite for the recovery backoff of disconnected sensors
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup sensor_tests
+ */
+
+#ifndef TEST_SENSOR_HEALTH_H
+#define TEST_SENSOR_HEALTH_H
+
+#include <unity.h>
+#include "../src/managers/SensorHealth.h"
+
+/**
+ * @brief Test that a dropout is retried at once, then with doubling backoff
+ */
+void test_sensor_health_backoff() {
+    SensorHealthStatus status;
+    TEST_ASSERT_EQUAL(UINT32_MAX, status.msUntilAttempt(1000));
+
+    status.markFailed(1000);
+    TEST_ASSERT_TRUE(status.state == SensorHealth::RECOVERING);
+    TEST_ASSERT_EQUAL_UINT32(0, status.msUntilAttempt(1000));
+
+    // Seeing the sensor still down again does not restart the backoff
+    status.recordAttempt(false, 1000);
+    status.markFailed(1500);
+    TEST_ASSERT_EQUAL_UINT32(1, status.attempts);
+    TEST_ASSERT_EQUAL_UINT32(Constants::Sensors::RECOVERY_BACKOFF_MIN_MS - 500, status.msUntilAttempt(1500));
+
+    status.recordAttempt(false, 2000);
+    TEST_ASSERT_EQUAL_UINT32(2 * Constants::Sensors::RECOVERY_BACKOFF_MIN_MS, status.msUntilAttempt(2000));
+
+    // The wait is capped
+    for (int i = 0; i < 32; i++) {
+        status.recordAttempt(false, 5000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(Constants::Sensors::RECOVERY_BACKOFF_MAX_MS, status.msUntilAttempt(5000));
+}
+
+/**
+ * @brief Test that a successful attempt clears the recovery state
+ */
+void test_sensor_health_recovered() {
+    SensorHealthStatus status;
+    status.markFailed(0);
+    status.recordAttempt(false, 0);
+    status.recordAttempt(true, 4000);
+
+    TEST_ASSERT_TRUE(status.state == SensorHealth::HEALTHY);
+    TEST_ASSERT_EQUAL_UINT32(0, status.attempts);
+    TEST_ASSERT_EQUAL_UINT32(4000, status.since);
+    TEST_ASSERT_EQUAL_STRING("HEALTHY", sensorHealthToString(status.state));
+
+    // The next dropout starts from the shortest backoff again
+    status.markFailed(9000);
+    status.recordAttempt(false, 9000);
+    TEST_ASSERT_EQUAL_UINT32(Constants::Sensors::RECOVERY_BACKOFF_MIN_MS, status.msUntilAttempt(9000));
+}
+
+/**
+ * @brief Run all sensor health tests
+ */
+void run_sensor_health_tests() {
+    RUN_TEST(test_sensor_health_backoff);
+    RUN_TEST(test_sensor_health_recovered);
+}
+
+#endif // TEST_SENSOR_HEALTH_H
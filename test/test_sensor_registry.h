@@ -170,6 +170,218 @@ void test_sensor_registry_unregistration() {
     delete sensor2;
 }
 
+/**
+ * @brief Test reading slot assignment
+ * @details Verifies that sensors get stable slots, freed slots are reused
+ *          and registration fails once all slots are taken.
+ */
+void test_sensor_registry_slots() {
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    std::vector<MockSensor*> sensors;
+    
+    for (size_t i = 0; i < Constants::Sensors::MAX_SENSORS; i++) {
+        MockSensor* sensor = new MockSensor("Sensor" + String(i), &errorHandler);
+        sensors.push_back(sensor);
+        TEST_ASSERT_TRUE(registry.registerSensor(sensor));
+        TEST_ASSERT_EQUAL(i, registry.getSlot(sensor->getName()));
+        TEST_ASSERT_EQUAL(sensor, registry.getSensorBySlot(i));
+    }
+    
+    // Registry is full
+    MockSensor extra("Extra", &errorHandler);
+    TEST_ASSERT_FALSE(registry.registerSensor(&extra));
+    TEST_ASSERT_EQUAL(-1, registry.getSlot("Extra"));
+    
+    // A freed slot is handed to the next registration
+    registry.unregisterSensor("Sensor3");
+    TEST_ASSERT_NULL(registry.getSensorBySlot(3));
+    TEST_ASSERT_TRUE(registry.registerSensor(&extra));
+    TEST_ASSERT_EQUAL(3, registry.getSlot("Extra"));
+    
+    // Out-of-range slots are rejected
+    TEST_ASSERT_NULL(registry.getSensorBySlot(-1));
+    TEST_ASSERT_NULL(registry.getSensorBySlot(Constants::Sensors::MAX_SENSORS));
+    
+    registry.clear();
+    for (auto sensor : sensors) {
+        delete sensor;
+    }
+}
+
+/**
+ * @brief Test the name index and cached interface views
+ * @details Verifies every name still resolves after removals reshape the
+ *          probe chains and that the views follow register and unregister.
+ */
+void test_sensor_registry_index() {
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    std::vector<MockSensor*> sensors;
+    
+    TEST_ASSERT_EQUAL(SensorRegistry::hashName("SHT41_1"), SensorRegistry::hashName(String("SHT41_") + "1"));
+    TEST_ASSERT_TRUE(SensorRegistry::hashName("SHT41_1") != SensorRegistry::hashName("SHT41_2"));
+    
+    for (size_t i = 0; i < Constants::Sensors::MAX_SENSORS; i++) {
+        sensors.push_back(new MockSensor("Sensor" + String(i), &errorHandler));
+        registry.registerSensor(sensors.back());
+    }
+    TEST_ASSERT_EQUAL(Constants::Sensors::MAX_SENSORS, registry.getTemperatureSensors().size());
+    
+    // Remove every other sensor
+    for (size_t i = 0; i < sensors.size(); i += 2) {
+        registry.unregisterSensor(sensors[i]->getName());
+    }
+    for (size_t i = 0; i < sensors.size(); i++) {
+        ISensor* expected = (i % 2) ? sensors[i] : nullptr;
+        TEST_ASSERT_EQUAL(expected, registry.getSensorByName(sensors[i]->getName()));
+    }
+    TEST_ASSERT_EQUAL(sensors.size() / 2, registry.getTemperatureSensors().size());
+    TEST_ASSERT_EQUAL(sensors.size() / 2, registry.getHumiditySensors().size());
+    TEST_ASSERT_EQUAL(static_cast<ITemperatureSensor*>(sensors[1]), registry.getTemperatureSensors()[0]);
+    
+    registry.clear();
+    TEST_ASSERT_EQUAL(0, registry.getTemperatureSensors().size());
+    TEST_ASSERT_NULL(registry.getSensorByName("Sensor1"));
+    for (auto sensor : sensors) {
+        delete sensor;
+    }
+}
+
+/**
+ * @brief Test the per-slot channel masks
+ * @details Verifies every channel a sensor supports is in its slot's
+ *          mask, not only temperature and humidity.
+ */
+void test_sensor_registry_channels() {
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    MockSensor climate("Climate", &errorHandler);
+    MockPressureSensor baro("Baro", &errorHandler);
+    TEST_ASSERT_TRUE(registry.registerSensor(&climate));
+    TEST_ASSERT_TRUE(registry.registerSensor(&baro));
+    
+    uint8_t climateChannels = channelBit(InterfaceType::TEMPERATURE) | channelBit(InterfaceType::HUMIDITY);
+    TEST_ASSERT_EQUAL_UINT8(climateChannels, registry.getChannels(registry.getSlot("Climate")));
+    TEST_ASSERT_EQUAL_UINT8(climateChannels | channelBit(InterfaceType::PRESSURE),
+                            registry.getChannels(registry.getSlot("Baro")));
+    TEST_ASSERT_EQUAL_UINT8(0, registry.getChannels(-1));
+    
+    registry.clear();
+}
+
+/**
+ * @brief Test non-copying iteration
+ * @details Verifies forEachSensor visits in registration order,
+ *          forEachSlot visits in slot order, and a visitor may look
+ *          sensors up during the walk. Walks read the published snapshot
+ *          without locking; reclaiming old snapshots is covered by
+ *          test_sensor_registry_grace_period.
+ */
+void test_sensor_registry_iteration() {
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    MockSensor first("First", &errorHandler);
+    MockSensor second("Second", &errorHandler);
+    MockSensor third("Third", &errorHandler);
+    registry.registerSensor(&first);
+    registry.registerSensor(&second);
+    registry.registerSensor(&third);
+    
+    // Free slot 0 and refill it so slot order differs from registration order
+    registry.unregisterSensor("First");
+    registry.registerSensor(&first);
+    
+    std::vector<ISensor*> visited;
+    registry.forEachSensor([&](ISensor* sensor) {
+        TEST_ASSERT_EQUAL(sensor, registry.getSensorByName(sensor->getName()));
+        visited.push_back(sensor);
+    });
+    TEST_ASSERT_EQUAL(3, visited.size());
+    TEST_ASSERT_EQUAL(&second, visited[0]);
+    TEST_ASSERT_EQUAL(&third, visited[1]);
+    TEST_ASSERT_EQUAL(&first, visited[2]);
+    
+    std::vector<int> slots;
+    registry.forEachSlot([&](int slot, ISensor* sensor) {
+        TEST_ASSERT_EQUAL(sensor, registry.getSensorBySlot(slot));
+        slots.push_back(slot);
+    });
+    TEST_ASSERT_EQUAL(3, slots.size());
+    TEST_ASSERT_EQUAL(0, slots[0]);
+    TEST_ASSERT_EQUAL(&first, registry.getSensorBySlot(0));
+    
+    registry.clear();
+}
+
+/**
+ * @brief Test swapping in a whole sensor set at once
+ */
+void test_sensor_registry_replace() {
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    MockSensor kept("Kept", &errorHandler);
+    MockSensor dropped("Dropped", &errorHandler);
+    MockSensor added("Added", &errorHandler);
+    registry.registerSensor(&dropped);
+    registry.registerSensor(&kept);
+    
+    // Kept stays in slot 1; Added skips the slot Dropped just vacated
+    std::vector<int> prepared;
+    std::vector<ISensor*> removed;
+    TEST_ASSERT_TRUE(registry.replaceSensors({&kept, &added}, removed, [&](int slot, ISensor* sensor) {
+        TEST_ASSERT_TRUE(sensor == &added);
+        prepared.push_back(slot);
+    }));
+    TEST_ASSERT_EQUAL(2, registry.count());
+    TEST_ASSERT_EQUAL(1, registry.getSlot("Kept"));
+    TEST_ASSERT_EQUAL(2, registry.getSlot("Added"));
+    TEST_ASSERT_FALSE(registry.hasSensor("Dropped"));
+    TEST_ASSERT_EQUAL(1, removed.size());
+    TEST_ASSERT_EQUAL(&dropped, removed[0]);
+    TEST_ASSERT_EQUAL(1, prepared.size());
+    TEST_ASSERT_EQUAL(2, prepared[0]);
+    
+    // A duplicate name leaves the published set untouched
+    MockSensor twin("Kept", &errorHandler);
+    TEST_ASSERT_FALSE(registry.replaceSensors({&kept, &twin}, removed));
+    TEST_ASSERT_EQUAL(2, registry.count());
+    TEST_ASSERT_EQUAL(&kept, registry.getSensorByName("Kept"));
+    
+    registry.clear();
+}
+
+/**
+ * @brief Test that replaced snapshots wait for every online reader
+ */
+void test_sensor_registry_grace_period() {
+    ErrorHandler errorHandler(nullptr);
+    SensorRegistry registry(&errorHandler);
+    MockSensor sensor("Sensor", &errorHandler);
+    
+    // With no reader online, replaced snapshots are freed straight away
+    registry.registerSensor(&sensor);
+    TEST_ASSERT_EQUAL(0, registry.reclaimSnapshots());
+    
+    registry.readerQuiescent(0);
+    registry.readerQuiescent(1);
+    registry.unregisterSensor("Sensor");
+    uint32_t token = registry.startGracePeriod();
+    TEST_ASSERT_FALSE(registry.gracePeriodElapsed(token));
+    TEST_ASSERT_EQUAL(1, registry.reclaimSnapshots());
+    
+    // One reader passing a quiescent point is not enough
+    registry.readerQuiescent(0);
+    TEST_ASSERT_FALSE(registry.gracePeriodElapsed(token));
+    
+    // Going offline counts, as for a worker blocked waiting for work
+    registry.readerOffline(1);
+    TEST_ASSERT_TRUE(registry.gracePeriodElapsed(token));
+    TEST_ASSERT_EQUAL(0, registry.reclaimSnapshots());
+    
+    registry.readerOffline(0);
+}
+
 /**
  * @brief Run all sensor registry tests
  */
@@ -178,6 +390,12 @@ void run_sensor_registry_tests() {
     RUN_TEST(test_sensor_registry_interface_lookup);
     RUN_TEST(test_sensor_registry_duplicates);
     RUN_TEST(test_sensor_registry_unregistration);
+    RUN_TEST(test_sensor_registry_slots);
+    RUN_TEST(test_sensor_registry_index);
+    RUN_TEST(test_sensor_registry_channels);
+    RUN_TEST(test_sensor_registry_iteration);
+    RUN_TEST(test_sensor_registry_replace);
+    RUN_TEST(test_sensor_registry_grace_period);
 }
 
 #endif // TEST_SENSOR_REGISTRY_H
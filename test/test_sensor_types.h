@@ -14,6 +14,7 @@
 #include <Arduino.h>
 #include <unity.h>
 #include "../src/sensors/SensorTypes.h"
+#include "../src/sensors/SensorDrivers.h"
 
 /**
  * @brief Test conversion from string to SensorType enum
@@ -74,6 +75,33 @@ void test_sensor_type_roundtrip_conversion() {
     TEST_ASSERT_EQUAL_STRING("Adafruit PT100 RTD", str3.c_str());
 }
 
+/**
+ * @brief Test the traits generated for every driver
+ * @details Verifies the per-driver traits table, the capability flags the
+ *          drivers report from it and the compile-time dispatch.
+ */
+void test_sensor_driver_traits() {
+    static_assert(SensorDrivers::COUNT == 3, "Every driver is listed once");
+    static_assert(SensorDrivers::find(SensorType::UNKNOWN) == nullptr, "UNKNOWN has no driver");
+    static_assert(SensorTraits<PT100Sensor>::info.bus == CommunicationType::SPI, "PT100 is on SPI");
+    static_assert(!SensorTraits<PT100Sensor>::info.hasChannel(InterfaceType::HUMIDITY), "PT100 has no humidity");
+    TEST_ASSERT_TRUE(SensorDrivers::MAX_SIZE >= sizeof(Si7021Sensor));
+    
+    const SensorTypeInfo* info = SensorDrivers::find(String("si7021"));
+    TEST_ASSERT_NOT_NULL(info);
+    TEST_ASSERT_EQUAL(SensorType::SI7021, info->type);
+    TEST_ASSERT_TRUE(info->hasChannel(InterfaceType::TEMPERATURE));
+    TEST_ASSERT_TRUE(info->hasChannel(InterfaceType::HUMIDITY));
+    TEST_ASSERT_EQUAL_UINT32(400000, maxI2CClockForType(SensorType::SI7021));
+    TEST_ASSERT_EQUAL_UINT32(100000, maxI2CClockForType(SensorType::PT100_RTD));
+    
+    // Dispatch reaches the driver class for each type and nothing for UNKNOWN
+    auto sizeOf = [](auto tag) { return sizeof(typename decltype(tag)::type); };
+    TEST_ASSERT_EQUAL(sizeof(SHT41Sensor), SensorDrivers::visit(SensorType::SHT41, sizeOf));
+    TEST_ASSERT_EQUAL(sizeof(PT100Sensor), SensorDrivers::visit(SensorType::PT100_RTD, sizeOf));
+    TEST_ASSERT_EQUAL(0, SensorDrivers::visit(SensorType::UNKNOWN, sizeOf));
+}
+
 /**
  * @brief Run all sensor type tests
  */
@@ -81,6 +109,7 @@ void run_sensor_type_tests() {
     RUN_TEST(test_sensor_type_from_string);
     RUN_TEST(test_sensor_type_to_string);
     RUN_TEST(test_sensor_type_roundtrip_conversion);
+    RUN_TEST(test_sensor_driver_traits);
 }
 
 #endif // TEST_SENSOR_TYPES_H
@@ -0,0 +1,160 @@
+/**
+ * @file test_slot_mailbox.h
+ * @brief Test suite for requests to a single-owner task
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup slot_mailbox_tests Slot Mailbox Tests
+ * @brief Tests for the request queue and per-slot replies of SlotMailbox
+ * @{
+ */
+
+#ifndef TEST_SLOT_MAILBOX_H
+#define TEST_SLOT_MAILBOX_H
+
+#include <unity.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../src/managers/SlotMailbox.h"
+
+typedef SlotMailbox<4, 4> TestMailbox;
+
+/**
+ * @brief Shared state of the owner task in the cross-task test
+ */
+struct MailboxOwner {
+    TestMailbox* mailbox = nullptr;      ///< Mailbox the owner drains
+    uint32_t objects[4] = {};            ///< Owned per-slot state, deliberately not atomic
+    volatile bool stop = false;          ///< Set by the test when done
+    volatile bool stopped = false;       ///< Set by the owner on exit
+    TaskHandle_t handle = nullptr;       ///< Owner task
+};
+
+/**
+ * @brief Owner task: writes the slot's object, then answers
+ * @param pvParameters MailboxOwner
+ */
+static void mailbox_owner_task(void* pvParameters) {
+    MailboxOwner* owner = static_cast<MailboxOwner*>(pvParameters);
+    TestMailbox::Request request;
+    while (!owner->stop) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+        while (owner->mailbox->take(request)) {
+            owner->objects[request.ticket.slot] = request.ticket.id;
+            owner->mailbox->complete(request, (request.ticket.id & 1) != 0);
+        }
+    }
+    owner->stopped = true;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Test posting, taking and answering without a second task
+ * @details Out-of-range slots and a full queue are refused, replies are
+ *          per slot and a later reply for the same slot answers earlier
+ *          tickets with its own outcome.
+ */
+void test_slot_mailbox_replies() {
+    TestMailbox mailbox;
+    TestMailbox::Ticket first;
+    TestMailbox::Ticket second;
+    TestMailbox::Ticket other;
+
+    TEST_ASSERT_FALSE(mailbox.post(nullptr, -1, first));
+    TEST_ASSERT_FALSE(mailbox.post(nullptr, 4, first));
+    TEST_ASSERT_FALSE(mailbox.isDone(first));
+
+    TEST_ASSERT_TRUE(mailbox.post(nullptr, 1, first));
+    TEST_ASSERT_TRUE(mailbox.post(nullptr, 1, second));
+    TEST_ASSERT_TRUE(mailbox.post(nullptr, 2, other));
+    TEST_ASSERT_TRUE(second.id != first.id);
+    TEST_ASSERT_FALSE(mailbox.isDone(first));
+
+    // Not answered yet: the wait times out
+    TEST_ASSERT_FALSE(mailbox.wait(first, 10));
+
+    // Queue holds 4
+    TestMailbox::Ticket extra;
+    TEST_ASSERT_TRUE(mailbox.post(nullptr, 3, extra));
+    TEST_ASSERT_FALSE(mailbox.post(nullptr, 3, extra));
+
+    TestMailbox::Request request;
+    TEST_ASSERT_TRUE(mailbox.take(request));
+    TEST_ASSERT_EQUAL(first.id, request.ticket.id);
+    TEST_ASSERT_TRUE(request.sender == xTaskGetCurrentTaskHandle());
+    mailbox.complete(request, false);
+    TEST_ASSERT_TRUE(mailbox.isDone(first));
+    TEST_ASSERT_FALSE(mailbox.succeeded(first));
+    TEST_ASSERT_FALSE(mailbox.isDone(second));
+    TEST_ASSERT_FALSE(mailbox.isDone(other));
+
+    TEST_ASSERT_TRUE(mailbox.take(request));
+    mailbox.complete(request, true);
+    TEST_ASSERT_TRUE(mailbox.wait(second, 10));
+    TEST_ASSERT_TRUE(mailbox.succeeded(second));
+    TEST_ASSERT_TRUE(mailbox.succeeded(first));
+
+    // Each complete() notified this task; an answered wait() leaves them pending
+    TEST_ASSERT_TRUE(ulTaskNotifyTake(pdTRUE, 0) > 0);
+
+    while (mailbox.take(request)) {
+        mailbox.complete(request, true);
+    }
+    TEST_ASSERT_TRUE(mailbox.succeeded(other));
+    TEST_ASSERT_FALSE(mailbox.take(request));
+    ulTaskNotifyTake(pdTRUE, 0);
+}
+
+/**
+ * @brief Test that a reply publishes the owner's work to the sender
+ * @details The owner task, on the other core where there is one, writes
+ *          a plain per-slot value before each reply; every sender that
+ *          has seen its reply must read the value written for it.
+ */
+void test_slot_mailbox_cross_task() {
+    TestMailbox mailbox;
+    MailboxOwner owner;
+    owner.mailbox = &mailbox;
+#if portNUM_PROCESSORS > 1
+    BaseType_t ownerCore = xPortGetCoreID() == 0 ? 1 : 0;
+#else
+    BaseType_t ownerCore = 0;
+#endif
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(
+        mailbox_owner_task, "MailboxOwner", 2048, &owner, uxTaskPriorityGet(NULL), &owner.handle, ownerCore));
+
+    uint32_t stale = 0;
+    uint32_t wrongOutcome = 0;
+    for (int i = 0; i < 200; i++) {
+        int slot = i % 4;
+        TestMailbox::Ticket ticket;
+        TEST_ASSERT_TRUE(mailbox.post(owner.handle, slot, ticket));
+        TEST_ASSERT_TRUE(mailbox.wait(ticket, 1000));
+        if (owner.objects[slot] != ticket.id) {
+            stale++;
+        }
+        if (mailbox.succeeded(ticket) != ((ticket.id & 1) != 0)) {
+            wrongOutcome++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, stale);
+    TEST_ASSERT_EQUAL_UINT32(0, wrongOutcome);
+
+    owner.stop = true;
+    for (int i = 0; i < 100 && !owner.stopped; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    TEST_ASSERT_TRUE(owner.stopped);
+    ulTaskNotifyTake(pdTRUE, 0);
+}
+
+/**
+ * @brief Run all slot mailbox tests
+ */
+void run_slot_mailbox_tests() {
+    RUN_TEST(test_slot_mailbox_replies);
+    RUN_TEST(test_slot_mailbox_cross_task);
+}
+
+#endif // TEST_SLOT_MAILBOX_H
+
+/** @} */ // End of slot_mailbox_tests group
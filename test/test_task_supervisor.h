@@ -0,0 +1,130 @@
+/**
+ * @file test_task_supervisor.h
+ * @brief Test suite for task supervision, CPU accounting and placement
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @ingroup system_tests
+ */
+
+#ifndef TEST_TASK_SUPERVISOR_H
+#define TEST_TASK_SUPERVISOR_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include <cstring>
+#include "../src/managers/TaskSupervisor.h"
+#include "../src/managers/TaskPlacement.h"
+
+/**
+ * @brief Test the CPU share and deadline arithmetic
+ */
+void test_task_supervisor_arithmetic() {
+    TEST_ASSERT_EQUAL_UINT16(250, TaskSupervisor::toPermille(250, 1000));
+    TEST_ASSERT_EQUAL_UINT16(1000, TaskSupervisor::toPermille(1200, 1000));
+    TEST_ASSERT_EQUAL_UINT16(0, TaskSupervisor::toPermille(5, 0));
+    // Large counters do not overflow the intermediate product
+    TEST_ASSERT_EQUAL_UINT16(500, TaskSupervisor::toPermille(0x7FFFFFFF, 0xFFFFFFFE));
+
+    TEST_ASSERT_FALSE(TaskSupervisor::isOverdue(100, 100));
+    TEST_ASSERT_TRUE(TaskSupervisor::isOverdue(100, 101));
+    TEST_ASSERT_FALSE(TaskSupervisor::isOverdue(5, static_cast<TickType_t>(0xFFFFFFF0)));
+}
+
+/**
+ * @brief Test that a task missing its check-in is reported stalled
+ * @details Waits are capped at the feed interval, a task past its promise
+ *          plus grace is stalled, and a check-in clears it again. A
+ *          keep-alive from inside a long command extends the promise to
+ *          a whole feed interval.
+ */
+void test_task_supervisor_stall() {
+    TaskSupervisor supervisor(nullptr);
+    int id = supervisor.add(100);
+    TEST_ASSERT_TRUE(id >= 0);
+
+    TickType_t feed = pdMS_TO_TICKS(Constants::Tasks::WATCHDOG_FEED_MS);
+    TEST_ASSERT_EQUAL(feed, supervisor.checkIn(id, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(5, supervisor.checkIn(id, 5));
+    supervisor.addMissedDeadlines(id, 2);
+
+    auto findSelf = [&](TaskSupervisor::TaskReport& out) {
+        TaskSupervisor::TaskReport reports[Constants::Tasks::MAX_SYSTEM_TASKS];
+        size_t count = supervisor.getReports(reports, Constants::Tasks::MAX_SYSTEM_TASKS);
+        for (size_t i = 0; i < count; i++) {
+            if (reports[i].supervised && strcmp(reports[i].name, pcTaskGetName(nullptr)) == 0) {
+                out = reports[i];
+                return true;
+            }
+        }
+        return false;
+    };
+
+    TaskSupervisor::TaskReport self;
+    supervisor.service(xTaskGetTickCount());
+    TEST_ASSERT_TRUE(findSelf(self));
+    TEST_ASSERT_FALSE(self.stalled);
+    TEST_ASSERT_EQUAL_UINT32(2, self.missedDeadlines);
+
+    // Well past the 5 tick promise and the 100 ms grace
+    supervisor.service(xTaskGetTickCount() + pdMS_TO_TICKS(1000));
+    TEST_ASSERT_TRUE(findSelf(self));
+    TEST_ASSERT_TRUE(self.stalled);
+    TEST_ASSERT_EQUAL_UINT32(1, self.stalls);
+
+    supervisor.checkIn(id, 5);
+    supervisor.service(xTaskGetTickCount());
+    TEST_ASSERT_TRUE(findSelf(self));
+    TEST_ASSERT_FALSE(self.stalled);
+
+    supervisor.keepAlive();
+    supervisor.service(xTaskGetTickCount() + pdMS_TO_TICKS(1000));
+    TEST_ASSERT_TRUE(findSelf(self));
+    TEST_ASSERT_FALSE(self.stalled);
+
+    // Leave the test task off the task watchdog
+    supervisor.remove(xTaskGetCurrentTaskHandle());
+    supervisor.service(xTaskGetTickCount());
+    TEST_ASSERT_FALSE(findSelf(self));
+}
+
+/**
+ * @brief Test task role names and placement limits
+ */
+void test_task_placement() {
+    TaskRole role;
+    TEST_ASSERT_TRUE(taskRoleFromString("sensor", role));
+    TEST_ASSERT_TRUE(role == TaskRole::SENSOR);
+    TEST_ASSERT_TRUE(taskRoleFromString("TELEMETRY", role));
+    TEST_ASSERT_TRUE(role == TaskRole::TELEMETRY);
+    TEST_ASSERT_FALSE(taskRoleFromString("Probe", role));
+
+    // The defaults are what the firmware has always used, and are valid
+    TaskPlacementConfig config;
+    TEST_ASSERT_EQUAL(Constants::Tasks::CORE_COMM, config[TaskRole::COMM].core);
+    for (const TaskPlacement& placement : config.tasks) {
+        TEST_ASSERT_TRUE(placement.isValid());
+    }
+
+    TaskPlacement placement = config[TaskRole::LED];
+    placement.core = tskNO_AFFINITY;
+    TEST_ASSERT_TRUE(placement.isValid());
+    placement.core = portNUM_PROCESSORS;
+    TEST_ASSERT_FALSE(placement.isValid());
+    placement = config[TaskRole::LED];
+    placement.priority = 0;
+    TEST_ASSERT_FALSE(placement.isValid());
+    placement = config[TaskRole::LED];
+    placement.stackSize = Constants::Tasks::MIN_STACK_SIZE - 1;
+    TEST_ASSERT_FALSE(placement.isValid());
+}
+
+/**
+ * @brief Run all task supervisor tests
+ */
+void run_task_supervisor_tests() {
+    RUN_TEST(test_task_supervisor_arithmetic);
+    RUN_TEST(test_task_supervisor_stall);
+    RUN_TEST(test_task_placement);
+}
+
+#endif // TEST_TASK_SUPERVISOR_H
@@ -0,0 +1,79 @@
+/**
+ * @file test_telemetry.h
+ * @brief Test suite for network telemetry encoding
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup telemetry_tests Telemetry Tests
+ * @brief Tests for line-protocol batching and the MQTT packets
+ * @{
+ */
+
+#ifndef TEST_TELEMETRY_H
+#define TEST_TELEMETRY_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include <cstring>
+#include "../src/communication/TelemetryPublisher.h"
+
+/**
+ * @brief Test the line-protocol form of a reading
+ * @details Tag values are escaped, invalid channels are left out and a
+ *          line that does not fit is rejected whole.
+ */
+void test_telemetry_line_protocol() {
+    ChannelValues reading;
+    reading.timestamp = 81234;
+    reading.set(InterfaceType::TEMPERATURE, 23.514f);
+    reading.set(InterfaceType::HUMIDITY, NAN);
+    HistoryRecord record = HistoryRecord::pack(reading, channelBit(InterfaceType::TEMPERATURE) |
+                                                        channelBit(InterfaceType::HUMIDITY));
+    record.sequence = 1042;
+    
+    char line[128];
+    size_t length = TelemetryPublisher::formatRecord(line, sizeof(line), "GPower EM-1", "I2C01", record);
+    const char* expected = "environment,board=GPower\\ EM-1,sensor=I2C01 TEMP=23.51,seq=1042i,uptime_ms=81234i\n";
+    TEST_ASSERT_EQUAL(strlen(expected), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, line, length);
+    
+    TEST_ASSERT_EQUAL(0, TelemetryPublisher::formatRecord(line, length - 1, "GPower EM-1", "I2C01", record));
+    
+    // Once the clock is set the line carries the reading time in nanoseconds
+    length = TelemetryPublisher::formatRecord(line, sizeof(line), "EM1", "I2C01", record, 1747300000123456ULL);
+    const char* stamped = "environment,board=EM1,sensor=I2C01 TEMP=23.51,seq=1042i,uptime_ms=81234i 1747300000123456000\n";
+    TEST_ASSERT_EQUAL(strlen(stamped), length);
+    TEST_ASSERT_EQUAL_MEMORY(stamped, line, length);
+}
+
+/**
+ * @brief Test the MQTT CONNECT and PUBLISH headers
+ * @details Checks the protocol name, level, clean-session flag and keep
+ *          alive, and the multi-byte remaining length of a large PUBLISH.
+ */
+void test_telemetry_mqtt_packets() {
+    uint8_t packet[64];
+    size_t length = TelemetryPublisher::encodeMqttConnect(packet, sizeof(packet), "EM1", 60);
+    const uint8_t connect[] = {0x10, 15, 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02, 0, 60, 0, 3, 'E', 'M', '1'};
+    TEST_ASSERT_EQUAL(sizeof(connect), length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(connect, packet, length);
+    
+    // 2 + 5 + 1393 = 1400 bytes remaining: 0xF8 0x0A
+    length = TelemetryPublisher::encodeMqttPublishHeader(packet, sizeof(packet), "em/t1", 1393);
+    const uint8_t publish[] = {0x30, 0xF8, 0x0A, 0, 5, 'e', 'm', '/', 't', '1'};
+    TEST_ASSERT_EQUAL(sizeof(publish), length);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(publish, packet, length);
+    
+    TEST_ASSERT_EQUAL(0, TelemetryPublisher::encodeMqttConnect(packet, 8, "EM1", 60));
+}
+
+/**
+ * @brief Run all telemetry tests
+ */
+void run_telemetry_tests() {
+    RUN_TEST(test_telemetry_line_protocol);
+    RUN_TEST(test_telemetry_mqtt_packets);
+}
+
+#endif // TEST_TELEMETRY_H
+
+/** @} */ // End of telemetry_tests group
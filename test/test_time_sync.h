@@ -0,0 +1,93 @@
+/**
+ * @file test_time_sync.h
+ * @brief Test suite for the device-to-wall-clock mapping
+ * @author Gabriel Avenia
+ * @date May 2025
+ * @defgroup time_sync_tests Time Sync Tests
+ * @brief Tests for epoch mapping and drift estimation
+ * @{
+ */
+
+#ifndef TEST_TIME_SYNC_H
+#define TEST_TIME_SYNC_H
+
+#include <Arduino.h>
+#include <unity.h>
+#include "../src/managers/TimeSync.h"
+
+namespace {
+    const uint64_t TEST_EPOCH_US = 1747300000000000ULL;   ///< 2025-05-15 09:06:40 UTC
+}
+
+/**
+ * @brief Test the mapping before and after the first sync
+ * @details Device times are reported unchanged until a sync, then map
+ *          onto the epoch in both directions from the sync point.
+ */
+void test_time_sync_mapping() {
+    TimeSync timeSync;
+    TEST_ASSERT_FALSE(timeSync.isSynchronized());
+    TEST_ASSERT_TRUE(timeSync.reportTimeUs(1234) == 1234);
+    TEST_ASSERT_TRUE(timeSync.toEpochUs(1234) == 0);
+
+    timeSync.synchronize(TEST_EPOCH_US, TimeSource::HOST, 5000000);
+    TEST_ASSERT_TRUE(timeSync.isSynchronized());
+    TEST_ASSERT_TRUE(timeSync.toEpochUs(5500000) == TEST_EPOCH_US + 500000);
+    // Readings taken before the sync are placed too
+    TEST_ASSERT_TRUE(timeSync.reportTimeUs(4000000) == TEST_EPOCH_US - 1000000);
+
+    TimeSync::Status status = timeSync.getStatus();
+    TEST_ASSERT_EQUAL(TimeSource::HOST, status.source);
+    TEST_ASSERT_FALSE(status.driftKnown);
+    TEST_ASSERT_EQUAL_UINT32(1, status.syncs);
+}
+
+/**
+ * @brief Test drift estimation between syncs
+ * @details A reference running 10 ppm ahead of the device gives +10000
+ *          ppb, which is then used to extrapolate. Syncs too close
+ *          together, from another source or implying an implausible rate
+ *          leave the estimate alone.
+ */
+void test_time_sync_drift() {
+    TimeSync timeSync;
+    timeSync.synchronize(TEST_EPOCH_US, TimeSource::HOST, 0);
+
+    // Too soon after the last sync to measure a rate
+    timeSync.synchronize(TEST_EPOCH_US + 1000010, TimeSource::HOST, 1000000);
+    TEST_ASSERT_FALSE(timeSync.getStatus().driftKnown);
+
+    // 100 s of device time against 100.001 s of reference time
+    timeSync.synchronize(TEST_EPOCH_US + 101001010, TimeSource::HOST, 101000000);
+    TimeSync::Status status = timeSync.getStatus();
+    TEST_ASSERT_TRUE(status.driftKnown);
+    TEST_ASSERT_EQUAL_INT32(10000, status.driftPpb);
+    TEST_ASSERT_TRUE(timeSync.toEpochUs(201000000) == TEST_EPOCH_US + 201002010);
+
+    // A step of the reference clock is not taken for drift
+    timeSync.synchronize(TEST_EPOCH_US + 300000000000ULL, TimeSource::HOST, 301000000);
+    TEST_ASSERT_EQUAL_INT32(10000, timeSync.getStatus().driftPpb);
+
+    // Nor is a host correcting a clock that was a day off, whose offset would overflow once scaled
+    timeSync.synchronize(TEST_EPOCH_US + 300000000000ULL - 86400000000ULL + 200000000, TimeSource::HOST, 501000000);
+    TEST_ASSERT_EQUAL_INT32(10000, timeSync.getStatus().driftPpb);
+
+    // The first sync from a new source only re-anchors
+    timeSync.synchronize(TEST_EPOCH_US + 600000000ULL, TimeSource::SNTP, 601000000);
+    status = timeSync.getStatus();
+    TEST_ASSERT_EQUAL(TimeSource::SNTP, status.source);
+    TEST_ASSERT_EQUAL_INT32(10000, status.driftPpb);
+    TEST_ASSERT_EQUAL_UINT32(6, status.syncs);
+}
+
+/**
+ * @brief Run all time sync tests
+ */
+void run_time_sync_tests() {
+    RUN_TEST(test_time_sync_mapping);
+    RUN_TEST(test_time_sync_drift);
+}
+
+#endif // TEST_TIME_SYNC_H
+
+/** @} */